@@ -169,6 +169,46 @@ target_include_directories(audio_player_cleanup_tests PRIVATE
 add_test(NAME audio_player_cleanup COMMAND audio_player_cleanup_tests)
 set_tests_properties(audio_player_cleanup PROPERTIES TIMEOUT 5)
 
+# miniaudio's null backend stands in for a sound card so the deadline to
+# first sample latency can be measured on any machine
+add_executable(audio_player_latency_tests
+    tests/audio_player_latency_tests.c
+    src/audio_player.c
+    src/audio_player_cleanup.c
+    src/audio_player_controls.c
+    src/audio_player_decoder.c
+    src/audio_player_mixer.c
+    src/audio_player_mixer_render.c
+    src/audio_player_pcm_cache.c
+    src/audio_player_state.c
+    src/audio_player_timer.c
+    src/audio_player_warm.c
+    src/config/config_published.c
+    src/utils/pcm_mix.c
+)
+target_include_directories(audio_player_latency_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+    "${CMAKE_CURRENT_SOURCE_DIR}/libs/miniaudio"
+    "${CMAKE_CURRENT_BINARY_DIR}/generated"
+)
+target_compile_definitions(audio_player_latency_tests PRIVATE
+    MINIAUDIO_IMPLEMENTATION
+    MA_NO_GENERATION
+    MA_NO_ENCODING
+    MA_NO_VORBIS
+    MA_NO_OPUS
+    MA_NO_FLAC
+    MA_NO_RESOURCE_MANAGER
+    MA_NO_NODE_GRAPH
+    MA_NO_ENGINE
+    MA_ENABLE_ONLY_SPECIFIC_BACKENDS
+    MA_ENABLE_NULL
+)
+target_link_libraries(audio_player_latency_tests PRIVATE user32 winmm)
+add_test(NAME audio_player_latency COMMAND audio_player_latency_tests)
+set_tests_properties(audio_player_latency PROPERTIES TIMEOUT 15)
+
 add_executable(tray_menu_pagination_tests
     tests/tray_menu_pagination_tests.c
     src/tray/tray_menu_pagination.c
@@ -189,6 +229,15 @@ target_include_directories(timer_render_cache_tests PRIVATE
 target_link_libraries(timer_render_cache_tests PRIVATE user32)
 add_test(NAME timer_render_cache COMMAND timer_render_cache_tests)
 
+add_executable(drawing_plugin_template_tests
+    tests/drawing_plugin_template_tests.c
+    src/drawing/drawing_plugin_template.c
+)
+target_include_directories(drawing_plugin_template_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME drawing_plugin_template COMMAND drawing_plugin_template_tests)
+
 add_executable(render_retry_tests
     tests/render_retry_tests.c
     src/utils/render_retry.c
@@ -207,6 +256,7 @@ add_executable(system_monitor_snapshot_tests
     src/system_monitor_network_sample.c
     src/system_monitor_network_worker.c
     src/system_monitor_state.c
+    src/utils/metric_history.c
 )
 target_include_directories(system_monitor_snapshot_tests PRIVATE
     "${CMAKE_CURRENT_SOURCE_DIR}/include"
@@ -227,9 +277,12 @@ add_test(NAME tray_metric_sync COMMAND tray_metric_sync_tests)
 
 add_executable(taskbar_monitor_compositor_tests
     tests/taskbar_monitor_compositor_tests.c
+    src/drawing/drawing_dib_pool.c
     src/drawing/system_ui_font.c
+    src/drawing/drawing_sparkline.c
     src/taskbar_monitor/taskbar_monitor_compositor.c
     src/taskbar_monitor/taskbar_monitor_layout.c
+    src/taskbar_monitor/taskbar_monitor_sparkline.c
 )
 target_include_directories(taskbar_monitor_compositor_tests PRIVATE
     "${CMAKE_CURRENT_SOURCE_DIR}/include"
@@ -288,8 +341,10 @@ add_test(NAME taskbar_monitor_placement
 
 add_executable(tray_percent_font_tests
     tests/tray_percent_font_tests.c
+    src/drawing/drawing_dib_pool.c
     src/drawing/system_ui_font.c
     src/tray/tray_animation_percent.c
+    src/tray/tray_animation_percent_atlas.c
     src/tray/tray_animation_percent_font.c
     src/tray/tray_animation_percent_icons.c
     src/tray/tray_animation_percent_text.c
@@ -301,6 +356,156 @@ target_include_directories(tray_percent_font_tests PRIVATE
 target_link_libraries(tray_percent_font_tests PRIVATE gdi32 user32)
 add_test(NAME tray_percent_font COMMAND tray_percent_font_tests)
 
+add_executable(tray_percent_atlas_tests
+    tests/tray_percent_atlas_tests.c
+    src/drawing/drawing_dib_pool.c
+    src/drawing/system_ui_font.c
+    src/tray/tray_animation_percent.c
+    src/tray/tray_animation_percent_atlas.c
+    src/tray/tray_animation_percent_font.c
+    src/tray/tray_animation_percent_icons.c
+    src/tray/tray_animation_percent_text.c
+)
+target_include_directories(tray_percent_atlas_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+target_link_libraries(tray_percent_atlas_tests PRIVATE gdi32 user32)
+add_test(NAME tray_percent_atlas COMMAND tray_percent_atlas_tests)
+
+add_executable(directory_index_tests
+    tests/directory_index_tests.c
+    src/utils/directory_index.c
+    src/utils/directory_index_lookup.c
+    src/utils/directory_index_scan.c
+)
+target_include_directories(directory_index_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME directory_index COMMAND directory_index_tests)
+
+add_executable(plugin_channel_tests
+    tests/plugin_channel_tests.c
+    src/plugin/plugin_channel.c
+)
+target_include_directories(plugin_channel_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME plugin_channel COMMAND plugin_channel_tests)
+
+add_executable(plugin_log_frame_tests
+    tests/plugin_log_frame_tests.c
+    src/plugin/plugin_log_frame.c
+)
+target_include_directories(plugin_log_frame_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+add_test(NAME plugin_log_frame COMMAND plugin_log_frame_tests)
+
+add_executable(log_trace_tests
+    tests/log_trace_tests.c
+    src/log/log_trace.c
+)
+target_include_directories(log_trace_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME log_trace COMMAND log_trace_tests)
+
+add_executable(hdr_histogram_tests
+    tests/hdr_histogram_tests.c
+    src/utils/hdr_histogram.c
+)
+target_include_directories(hdr_histogram_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME hdr_histogram COMMAND hdr_histogram_tests)
+
+add_executable(metric_history_tests
+    tests/metric_history_tests.c
+    src/utils/metric_history.c
+    src/drawing/drawing_sparkline.c
+)
+target_include_directories(metric_history_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME metric_history COMMAND metric_history_tests)
+
+add_executable(pcm_mix_tests
+    tests/pcm_mix_tests.c
+    src/utils/pcm_mix.c
+)
+target_include_directories(pcm_mix_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+)
+add_test(NAME pcm_mix COMMAND pcm_mix_tests)
+
+add_executable(config_published_tests
+    tests/config_published_tests.c
+    src/config/config_published.c
+)
+target_include_directories(config_published_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_BINARY_DIR}/generated"
+)
+add_test(NAME config_published COMMAND config_published_tests)
+set_tests_properties(config_published PROPERTIES TIMEOUT 15)
+
+add_executable(font_coverage_tests
+    tests/font_coverage_tests.c
+    src/drawing/drawing_text_stb_coverage.c
+    src/drawing/drawing_text_stb_stb.c
+)
+target_include_directories(font_coverage_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+    "${CMAKE_CURRENT_BINARY_DIR}/generated"
+)
+target_compile_definitions(font_coverage_tests PRIVATE
+    "CATIME_TEST_FONT_PATH=\"${CMAKE_CURRENT_SOURCE_DIR}/asset/font/SIL/Rec Mono Casual Essence.ttf\""
+)
+add_test(NAME font_coverage COMMAND font_coverage_tests)
+
+add_executable(markdown_interactive_index_tests
+    tests/markdown_interactive_index_tests.c
+    src/markdown/markdown_interactive_index.c
+)
+target_include_directories(markdown_interactive_index_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+add_test(NAME markdown_interactive_index COMMAND markdown_interactive_index_tests)
+
+add_executable(render_present_damage_tests
+    tests/render_present_damage_tests.c
+    src/drawing/drawing_render_present_damage.c
+)
+target_include_directories(render_present_damage_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+add_test(NAME render_present_damage COMMAND render_present_damage_tests)
+
+add_executable(dib_pool_tests
+    tests/dib_pool_tests.c
+    src/drawing/drawing_dib_pool.c
+)
+target_include_directories(dib_pool_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+target_link_libraries(dib_pool_tests PRIVATE gdi32 user32)
+add_test(NAME dib_pool COMMAND dib_pool_tests)
+
+add_executable(drawing_blend_tests
+    tests/drawing_blend_tests.c
+    src/drawing/drawing_blend.c
+)
+target_include_directories(drawing_blend_tests PRIVATE
+    "${CMAKE_CURRENT_SOURCE_DIR}/include"
+    "${CMAKE_CURRENT_SOURCE_DIR}/src"
+)
+add_test(NAME drawing_blend COMMAND drawing_blend_tests)
+
 set(_catime_test_targets
     window_placement_tests
     startup_policy_tests
@@ -320,8 +525,10 @@ set(_catime_test_targets
     tray_update_policy_tests
     tray_menu_tracking_tests
     audio_player_cleanup_tests
+    audio_player_latency_tests
     tray_menu_pagination_tests
     timer_render_cache_tests
+    drawing_plugin_template_tests
     render_retry_tests
     system_monitor_snapshot_tests
     tray_metric_sync_tests
@@ -331,6 +538,20 @@ set(_catime_test_targets
     taskbar_monitor_recovery_tests
     taskbar_monitor_placement_tests
     tray_percent_font_tests
+    tray_percent_atlas_tests
+    directory_index_tests
+    plugin_channel_tests
+    plugin_log_frame_tests
+    log_trace_tests
+    hdr_histogram_tests
+    metric_history_tests
+    pcm_mix_tests
+    config_published_tests
+    font_coverage_tests
+    markdown_interactive_index_tests
+    render_present_damage_tests
+    dib_pool_tests
+    drawing_blend_tests
 )
 
 if(MSVC)
@@ -2,7 +2,7 @@
  * @file audio_player.h
  * @brief Audio notification system with three-tier fallback for reliability
  * 
- * 1. miniaudio (MP3/WAV support)
+ * 1. miniaudio (MP3/WAV support), mixed so overlapping sounds all play
  * 2. PlaySound (WAV fallback)
  * 3. System beep (guaranteed notification)
  * 
@@ -70,6 +70,20 @@ BOOL PlayNotificationSoundFile(HWND hwnd, const char* soundFile);
  */
 BOOL PreviewNotificationSoundFile(HWND hwnd, const char* soundFile);
 
+/**
+ * @brief Prepares the configured notification sound ahead of a deadline
+ * @param hwnd Window that will own the alert
+ * @param leadMs Expected time until PlayNotificationSound() is called
+ * @return TRUE if the warm-up was queued, FALSE if it could not be queued
+ *
+ * @details
+ * A background worker decodes the sound into the in-memory PCM cache and
+ * opens the shared playback device, so the notification starts without
+ * file probing or device initialization. The idle device is closed again
+ * if nothing plays on it shortly after the deadline.
+ */
+BOOL PrewarmNotificationSound(HWND hwnd, DWORD leadMs);
+
 /**
  * @brief Pauses audio playback without losing position
  * @return TRUE if paused, FALSE if not playing or backend unsupported
@@ -90,15 +104,31 @@ BOOL ResumeNotificationSound(void);
  * @brief Cancels audio playback without blocking the UI thread
  * 
  * @details
- * Stops all backends (miniaudio, PlaySound, timers) to prevent leaks and
- * artifacts. If a background request is currently opening the audio device,
- * the request observes the cancellation and performs cleanup before exiting.
- * Must be called before application exit.
+ * Fades out every mixer voice and stops PlaySound so nothing clicks or
+ * leaks. If a background request is currently loading a sound, the request
+ * observes the cancellation and performs cleanup before exiting. The shared
+ * device stays open; ShutdownAudioPlayer() closes it at exit.
  * 
  * @note Safe to call when nothing is playing
  */
 void StopNotificationSound(void);
 
+/**
+ * @brief Stops preview sounds and leaves notification alerts playing
+ *
+ * @note Never blocks; a request still loading observes the cancellation
+ */
+void StopPreviewNotificationSound(void);
+
+/**
+ * @brief Stops everything and closes the shared playback device
+ *
+ * @details
+ * StopNotificationSound() keeps the device open so the next sound starts
+ * without reinitializing it. Call this once at application exit instead.
+ */
+void ShutdownAudioPlayer(void);
+
 /**
  * @brief Sets audio volume with immediate effect (clamped to 0-100)
  * @param volume Volume level (0=mute, 100=max)
@@ -0,0 +1,87 @@
+/**
+ * @file config_published.h
+ * @brief Immutable, versioned configuration snapshots for lock-free readers
+ *
+ * The applied configuration is published as a read-only ConfigSnapshot
+ * that any thread can pin without taking g_IniCriticalSection or racing
+ * the globals that config handlers mutate. Publishing copies into one of
+ * a few preallocated slots and swaps the current index, so neither side
+ * allocates; a slot is only rewritten once no reader still pins it
+ * (RCU-style grace period).
+ *
+ * Readers must keep the pin short and never block while holding it.
+ */
+
+#ifndef CONFIG_PUBLISHED_H
+#define CONFIG_PUBLISHED_H
+
+#include <windows.h>
+#include "config/config_loader.h"
+
+typedef struct {
+    /** Increments on every publish; 0 until the first one */
+    LONG64 version;
+    /** notificationSoundFile is stored expanded, as applied */
+    ConfigSnapshot config;
+} PublishedConfig;
+
+/** @brief Adjusts a copy of the configuration before it is published */
+typedef void (*PublishedConfigEdit)(ConfigSnapshot* config, const void* context);
+
+/**
+ * @brief Pins the current snapshot
+ * @return Never NULL; pair with PublishedConfig_Release()
+ */
+const PublishedConfig* PublishedConfig_Acquire(void);
+
+void PublishedConfig_Release(const PublishedConfig* published);
+
+/**
+ * @brief Publishes a new snapshot
+ * @param base Configuration to copy, or NULL to start from the current one
+ * @param edit Optional adjustment applied to the copy before it is visible
+ * @return Version of the new snapshot
+ *
+ * @details
+ * Writers are serialized with each other but never wait on the INI lock.
+ * If every spare slot is still pinned, the writer yields until a reader
+ * lets go.
+ */
+LONG64 PublishedConfig_Publish(const ConfigSnapshot* base,
+                               PublishedConfigEdit edit, const void* context);
+
+LONG64 PublishedConfig_GetVersion(void);
+
+/**
+ * @brief Publishes a snapshot that ApplyConfigSnapshot just applied
+ */
+void PublishAppliedConfig(const ConfigSnapshot* snapshot);
+
+/**
+ * @brief Loads, validates and publishes config.ini on the calling thread
+ * @return TRUE if a new snapshot was published
+ *
+ * @details
+ * Used by the config watcher so the snapshot is rebuilt off the UI thread
+ * before the reload message is posted.
+ */
+BOOL PublishConfigFromFile(const char* configPath);
+
+/**
+ * @brief Republishes after a runtime notification sound change
+ * @param soundFile New expanded path, or NULL to keep the current one
+ * @param volume New volume, or negative to keep the current one
+ */
+void PublishNotificationSound(const char* soundFile, int volume);
+
+/**
+ * @brief Republishes after the timeout message is changed from the UI
+ */
+void PublishTimeoutMessage(const char* timeoutMessage);
+
+/**
+ * @brief Republishes after the tray wheel opacity steps are changed
+ */
+void PublishOpacitySteps(int normalStep, int fastStep);
+
+#endif /* CONFIG_PUBLISHED_H */
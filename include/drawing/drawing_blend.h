@@ -0,0 +1,135 @@
+/**
+ * @file drawing_blend.h
+ * @brief Shared fixed-point blend kernels for 32bpp premultiplied canvases.
+ *
+ * Pixels are 0xAARRGGBB with color premultiplied by alpha, as the layered
+ * window expects. Every kernel reproduces the integer division by 255 its
+ * call sites used before, bit for bit, so rendering output is unchanged.
+ * Division is a multiply-shift, applied to all four channels at once where
+ * they share a formula. Color channels must be in 0..255.
+ */
+
+#ifndef DRAWING_BLEND_H
+#define DRAWING_BLEND_H
+
+#include <windows.h>
+
+/** @brief v / 255 truncated; exact for v <= 65534 */
+static inline DWORD DrawingBlend_Div255(DWORD v) {
+    return ((v + 1u) * 257u) >> 16;
+}
+
+/** @brief (fg * alpha + bg * (255 - alpha)) / 255 */
+static inline BYTE DrawingBlend_MixByte(int fg, int bg, BYTE alpha) {
+    return (BYTE)DrawingBlend_Div255((DWORD)(fg * alpha + bg * (255 - alpha)));
+}
+
+/*
+ * Four-channel kernels spread a pixel into 16-bit lanes, 0x00AA00RR00GG00BB,
+ * so one 64-bit multiply scales every channel. Lane sums stay below 65536,
+ * which keeps lanes from carrying into each other.
+ */
+#define DRAWING_BLEND_LANE_MASK 0x00FF00FF00FF00FFull
+#define DRAWING_BLEND_LANE_ONE 0x0001000100010001ull
+
+static inline ULONGLONG DrawingBlend_Expand(DWORD pixel) {
+    ULONGLONG x = pixel;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+    return (x | (x << 8)) & DRAWING_BLEND_LANE_MASK;
+}
+
+static inline DWORD DrawingBlend_Pack(ULONGLONG lanes) {
+    lanes = (lanes | (lanes >> 8)) & 0x0000FFFF0000FFFFull;
+    return (DWORD)(lanes | (lanes >> 16));
+}
+
+/** @brief DrawingBlend_Div255 in every lane; exact for lanes <= 255 * 255 */
+static inline ULONGLONG DrawingBlend_Div255Lanes(ULONGLONG v) {
+    return ((v + DRAWING_BLEND_LANE_ONE + ((v >> 8) & DRAWING_BLEND_LANE_MASK)) >> 8) &
+           DRAWING_BLEND_LANE_MASK;
+}
+
+/** @brief Opaque color in lanes, the source operand of the kernels below */
+static inline ULONGLONG DrawingBlend_ColorLanes(int r, int g, int b) {
+    return DrawingBlend_Expand(0xFF000000u | ((DWORD)r << 16) | ((DWORD)g << 8) | (DWORD)b);
+}
+
+/** @brief Color at coverage alpha, premultiplied, with alpha as its A */
+static inline DWORD DrawingBlend_Premultiply(ULONGLONG color, BYTE alpha) {
+    return DrawingBlend_Pack(DrawingBlend_Div255Lanes(color * alpha));
+}
+
+/**
+ * @brief Color channels scaled by alpha / 255 rounded to nearest; A becomes alpha
+ * @details The bias keeps lanes at most 255 * 255 + 127, still exact.
+ */
+static inline DWORD DrawingBlend_PremultiplyRounded(DWORD pixel, BYTE alpha) {
+    ULONGLONG lanes = DrawingBlend_Expand(pixel | 0xFF000000u) * alpha +
+                      127u * DRAWING_BLEND_LANE_ONE;
+    return DrawingBlend_Pack(DrawingBlend_Div255Lanes(lanes));
+}
+
+/** @brief Source-over: each channel, A included, is (src * a + dst * (255 - a)) / 255 */
+static inline DWORD DrawingBlend_Over(DWORD dest, ULONGLONG color, BYTE alpha) {
+    return DrawingBlend_Pack(DrawingBlend_Div255Lanes(
+        color * alpha + DrawingBlend_Expand(dest) * (ULONGLONG)(255 - alpha)));
+}
+
+/*
+ * Add and lerp touch channels with different rules, so they stay per
+ * channel; lanes measured no faster for them in blend_bench.
+ */
+
+/** @brief Saturating add of color * alpha / 255; A becomes max(A, alpha) */
+static inline DWORD DrawingBlend_Add(DWORD dest, int r, int g, int b, BYTE alpha) {
+    int outR = (int)((dest >> 16) & 0xFF) + (r * alpha) / 255;
+    int outG = (int)((dest >> 8) & 0xFF) + (g * alpha) / 255;
+    int outB = (int)(dest & 0xFF) + (b * alpha) / 255;
+    int outA = (int)(dest >> 24);
+    if (outR > 255) outR = 255;
+    if (outG > 255) outG = 255;
+    if (outB > 255) outB = 255;
+    if (outA < alpha) outA = alpha;
+    return ((DWORD)outA << 24) | ((DWORD)outR << 16) | ((DWORD)outG << 8) | (DWORD)outB;
+}
+
+/**
+ * @brief e + (t - e) * alpha / 255 per channel, truncating toward e
+ * @details Signed division by the constant 255 compiles to a multiply-shift
+ *          with a sign fix-up, which beat an explicit absolute-value form.
+ */
+static inline DWORD DrawingBlend_LerpChannel(DWORD e, int t, BYTE alpha) {
+    return (DWORD)((int)e + ((t - (int)e) * alpha) / 255);
+}
+
+/** @brief Moves each channel toward the color and A toward 255 by alpha */
+static inline DWORD DrawingBlend_Lerp(DWORD dest, int r, int g, int b, BYTE alpha) {
+    return (DrawingBlend_LerpChannel(dest >> 24, 255, alpha) << 24) |
+           (DrawingBlend_LerpChannel((dest >> 16) & 0xFF, r, alpha) << 16) |
+           (DrawingBlend_LerpChannel((dest >> 8) & 0xFF, g, alpha) << 8) |
+           DrawingBlend_LerpChannel(dest & 0xFF, b, alpha);
+}
+
+/*
+ * Row kernels: coverage[i] is the glyph alpha for dest[i]; zero coverage
+ * leaves the pixel untouched.
+ */
+
+/** @brief Writes the premultiplied color where coverage exceeds dest alpha */
+void DrawingBlend_PremultiplyMaxRow(DWORD* dest, const BYTE* coverage, int count,
+                                    int r, int g, int b);
+
+/** @brief As DrawingBlend_PremultiplyMaxRow with one color per pixel */
+void DrawingBlend_PremultiplyMaxColorsRow(DWORD* dest, const BYTE* coverage,
+                                          const COLORREF* colors, int count);
+
+void DrawingBlend_OverRow(DWORD* dest, const BYTE* coverage, int count,
+                          int r, int g, int b);
+
+void DrawingBlend_AddRow(DWORD* dest, const BYTE* coverage, int count,
+                         int r, int g, int b);
+
+void DrawingBlend_LerpRow(DWORD* dest, const BYTE* coverage, int count,
+                          int r, int g, int b);
+
+#endif /* DRAWING_BLEND_H */
@@ -0,0 +1,96 @@
+/**
+ * @file drawing_dib_pool.h
+ * @brief Shared pool of 32bpp DIB sections with their memory DCs.
+ *
+ * Paint paths lease a surface instead of creating a DIB and DC per paint.
+ * Released surfaces stay pooled by size class under one byte budget and are
+ * destroyed after sitting idle, so bursts of repaints reuse GDI objects
+ * without every window keeping its own reuse and shrink heuristics.
+ */
+
+#ifndef DRAWING_DIB_POOL_H
+#define DRAWING_DIB_POOL_H
+
+#include <windows.h>
+
+/** Leased plus idle bytes above which released surfaces are not kept */
+#define DIB_POOL_BUDGET_BYTES (48u * 1024u * 1024u)
+#define DIB_POOL_MAX_IDLE_SURFACES 16
+#define DIB_POOL_IDLE_TRIM_MS 30000u
+/** A pooled surface is reused only if it is at most this many times larger */
+#define DIB_POOL_SHRINK_THRESHOLD_MULTIPLIER 4u
+/** Non-exact dimensions are rounded up so nearby sizes share a surface */
+#define DIB_POOL_GRANULARITY 32
+/** Size classes are powers of two from 4 KB upwards */
+#define DIB_POOL_BUCKET_COUNT 16
+
+#define DIB_POOL_EXACT_WIDTH 0x1u   /**< Pixel math uses width as the stride */
+#define DIB_POOL_EXACT_HEIGHT 0x2u
+#define DIB_POOL_EXACT (DIB_POOL_EXACT_WIDTH | DIB_POOL_EXACT_HEIGHT)
+
+typedef struct DibPoolEntry DibPoolEntry;
+
+typedef struct {
+    HDC dc;                 /**< Memory DC with the bitmap selected */
+    HBITMAP bitmap;
+    void* bits;             /**< Top-down 32bpp pixels, stride width * 4 */
+    int width;              /**< At least the requested size unless exact */
+    int height;
+    DibPoolEntry* entry;
+} DibSurface;
+
+typedef struct {
+    size_t leasedSurfaces;
+    size_t leasedBytes;
+    size_t idleSurfaces;
+    size_t idleBytes;
+    size_t idleByBucket[DIB_POOL_BUCKET_COUNT];
+    ULONGLONG created;
+    ULONGLONG reused;
+    ULONGLONG destroyed;
+    DWORD gdiObjects;       /**< Process-wide GDI handle count */
+} DibPoolStats;
+
+/**
+ * @brief Lease a surface of at least width x height
+ * @param flags DIB_POOL_EXACT_* bits for dimensions that must match
+ * @return FALSE if no surface could be created
+ *
+ * @details Pixel contents are undefined. DC state such as selected fonts,
+ * modes and clipping is reset when the surface is released.
+ */
+BOOL DibPool_Acquire(int width, int height, UINT flags, DibSurface* surface);
+
+/** @brief Return a leased surface to the pool and clear the handle */
+void DibPool_Release(DibSurface* surface);
+
+/** @brief Destroy idle surfaces unused for at least maxIdleMs (0: all) */
+void DibPool_Trim(DWORD maxIdleMs);
+
+void DibPool_GetStats(DibPoolStats* stats);
+
+/** @brief Destroy idle surfaces; later releases destroy instead of pooling */
+void DibPool_Shutdown(void);
+
+/** Double buffer for one paint, blitted to its target when ended */
+typedef struct {
+    HDC target;
+    int x;
+    int y;
+    int width;
+    int height;
+    DibSurface surface;
+} DibPaintBuffer;
+
+/**
+ * @brief Lease a buffer for a width x height area of target at (x, y)
+ * @return DC to draw into with the area at its origin, or target itself
+ *         (drawing unbuffered at x, y) if no buffer is available
+ */
+HDC DibPool_BeginPaintBuffer(HDC target, int x, int y, int width, int height,
+                             DibPaintBuffer* paint);
+
+/** @brief Blit a buffered paint to its target and release the buffer */
+void DibPool_EndPaintBuffer(DibPaintBuffer* paint);
+
+#endif /* DRAWING_DIB_POOL_H */
@@ -3,12 +3,22 @@
 
 #include <windows.h>
 
-int AquaClampByte(int value);
-int AquaClampInt(int value, int minValue, int maxValue);
-int AquaLerpByte256(int a, int b, int t256);
+/* Noise lattice period; 56 rows keep the 7-cells-per-14s flow speed looping */
+#define AQUA_TEXTURE_CELLS_X 16
+#define AQUA_TEXTURE_CELLS_Y 56
+#define AQUA_TEXELS_PER_CELL 16
+#define AQUA_TEXTURE_WIDTH (AQUA_TEXTURE_CELLS_X * AQUA_TEXELS_PER_CELL)
+#define AQUA_TEXTURE_HEIGHT (AQUA_TEXTURE_CELLS_Y * AQUA_TEXELS_PER_CELL)
+
+/* Inline: the composite loops call these several times per pixel */
+static inline int AquaClampByte(int value) { return value < 0 ? 0 : value > 255 ? 255 : value; }
+static inline int AquaClampInt(int value, int minValue, int maxValue) {
+    return value < minValue ? minValue : value > maxValue ? maxValue : value;
+}
+static inline int AquaLerpByte256(int a, int b, int t256) { return a + (((b - a) * t256) >> 8); }
 int AquaFloorFixed8(int value);
-int AquaFractalNoise(int screenX, int screenY, int freqXPpm, int freqYPpm,
-                     int flowQ8, unsigned int seed);
+int AquaTileableValueNoiseQ8(int xQ8, int yQ8, int periodX, int periodY,
+                             unsigned int seed);
 int AquaNoiseAt(const unsigned char* noiseMap, int width, int height,
                 int x, int y);
 int AquaNoiseAtUnchecked(const unsigned char* noiseMap, int width, int x, int y);
@@ -16,4 +26,35 @@ int AquaSampleAlphaBilinear(const unsigned char* alphaMap, int width, int height
                             int xQ8, int yQ8);
 int AquaErodedAlpha(int alpha, int poreNoise, int displacementNoise);
 
+/** @brief Returns the shared noise texture, building it on first use */
+const unsigned char* AquaNoiseTexture_Acquire(void);
+void AquaNoiseTexture_Free(void);
+/**
+ * @brief Samples count pixels of one screen row, flowQ8 in Q8 texel rows
+ */
+void AquaNoiseTexture_SampleRow(const unsigned char* texture, unsigned char* out,
+                                int count, long long screenX, long long screenY,
+                                int freqXPpm, int freqYPpm, int flowQ8);
+
+typedef struct {
+    ULONGLONG bitmapHash;
+    long long startX;
+    long long startY;
+    int width;
+    int height;
+    int flowPhase;
+} AquaGlyphKey;
+
+ULONGLONG AquaGlyphCache_HashBitmap(const unsigned char* bitmap, int w, int h);
+/**
+ * @brief Finds cached maps for a glyph
+ * @return gw*gh eroded body bytes followed by gw*gh glow bytes, or NULL
+ */
+const unsigned char* AquaGlyphCache_Find(const AquaGlyphKey* key, int gw, int gh);
+/** @brief Copies both maps into the cache; NULL if the glyph is too large */
+const unsigned char* AquaGlyphCache_Store(const AquaGlyphKey* key, int gw, int gh,
+                                         const unsigned char* displaced,
+                                         const unsigned char* glow);
+void AquaGlyphCache_Free(void);
+
 #endif
@@ -0,0 +1,53 @@
+/**
+ * @file drawing_effect_tiles.h
+ * @brief Banded, multi-threaded replay of glyph effect passes
+ *
+ * While a batch is open on a thread, glyph blends aimed at its frame are
+ * recorded instead of drawn. Flushing splits the frame into horizontal
+ * bands and replays every recorded glyph once per band, each band on its
+ * own worker with its own scratch buffers and with writes clipped to the
+ * band. Every pixel therefore sees the same blends in the same order as a
+ * serial render, so the output is identical.
+ *
+ * Anything that draws into the frame without going through a batch must
+ * call DrawingEffectTiles_Flush() first to keep that order.
+ */
+
+#ifndef DRAWING_EFFECT_TILES_H
+#define DRAWING_EFFECT_TILES_H
+
+#include <windows.h>
+
+/** @brief Draws one recorded glyph; args is the block given to Submit */
+typedef void (*DrawingEffectTileReplay)(DWORD* pixels, int width, int height,
+                                        const unsigned char* bitmap,
+                                        const void* args);
+
+/**
+ * @brief Opens a batch for a frame on the calling thread
+ * @return FALSE when the frame is too small, only one core is available or
+ *         another batch is open; callers then draw directly
+ */
+BOOL DrawingEffectTiles_Begin(DWORD* pixels, int width, int height);
+
+/**
+ * @brief Records a glyph blend
+ * @param top First frame row the glyph bitmap covers
+ * @return FALSE when the calling thread has no batch for pixels; the
+ *         caller then draws directly, after any recorded work was flushed
+ */
+BOOL DrawingEffectTiles_Submit(DWORD* pixels, DrawingEffectTileReplay replay,
+                               const void* args, size_t argsSize,
+                               const unsigned char* bitmap, int w, int h,
+                               int top);
+
+/** @brief Draws everything recorded so far; no-op without an open batch */
+void DrawingEffectTiles_Flush(void);
+
+/** @brief Flushes and closes the calling thread's batch */
+void DrawingEffectTiles_End(void);
+
+/** @brief Stops the workers; caller holds the effect buffer lock */
+void DrawingEffectTiles_Shutdown(void);
+
+#endif /* DRAWING_EFFECT_TILES_H */
@@ -23,6 +23,11 @@ BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
                               const MarkdownFontTag* fontTags, int fontTagCount,
                               int fontSize, float fontScale,
                               int* width, int* height);
+
+/**
+ * @brief Drop cached Markdown layouts and per-frame gradient rows
+ */
+void ClearMarkdownLayoutCacheSTB(void);
 
 /**
  * @brief Render multi-line Markdown text
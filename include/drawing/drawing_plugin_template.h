@@ -0,0 +1,36 @@
+/**
+ * @file drawing_plugin_template.h
+ * @brief Splice arithmetic for compiled plugin text templates.
+ *
+ * A template is plugin text with every <catime></catime> placeholder
+ * removed and its offset recorded as a slot. These helpers have no
+ * rendering dependencies so the offsets can be tested on their own.
+ */
+
+#ifndef DRAWING_PLUGIN_TEMPLATE_H
+#define DRAWING_PLUGIN_TEMPLATE_H
+
+#include <stddef.h>
+#include <wchar.h>
+
+/**
+ * Copy templateText into out with timerText inserted at each slot offset.
+ * Output is truncated to outCount - 1 characters and always terminated.
+ * @return Length of the text written to out
+ */
+size_t PluginTemplate_Splice(const wchar_t* templateText, size_t templateLen,
+                             const int* slotOffsets, int slotCount,
+                             const wchar_t* timerText,
+                             wchar_t* out, size_t outCount);
+
+/**
+ * Position in the spliced text of image imageIndex, recorded at templatePos.
+ * slotImagesBefore[k] is the number of images extracted ahead of slot k, so
+ * every slot with a count at or below imageIndex precedes the image.
+ * The result is clamped to outLen when truncation cut the image off.
+ */
+int PluginTemplate_ImagePosition(int templatePos, int imageIndex,
+                                 const int* slotImagesBefore, int slotCount,
+                                 size_t timerLen, size_t outLen);
+
+#endif /* DRAWING_PLUGIN_TEMPLATE_H */
@@ -29,6 +29,15 @@ void StopDrawingRenderAnimationTimer(HWND hwnd);
 /** Handle the one-shot main-window presentation retry timer. */
 BOOL HandleDrawingRenderRetryTimer(HWND hwnd);
 
+/**
+ * Force the next main-window present to upload the whole surface.
+ *
+ * Call after anything that replaces the layered window's contents outside
+ * the renderer, such as SetLayeredWindowAttributes; otherwise an unchanged
+ * frame would be skipped and the stale surface left on screen.
+ */
+void InvalidateDrawingRenderPresentCache(void);
+
 /**
  * Release cached markdown render data used across paint calls.
  */
@@ -0,0 +1,78 @@
+/**
+ * @file drawing_render_metrics.h
+ * @brief Always-on per-stage timing for the main window paint pipeline
+ *
+ * Each paint is one frame. Stages are timed with QueryPerformanceCounter and
+ * summed per frame, then folded into one HDR histogram per stage when the
+ * frame ends. Stages nest (markdown parse and measure run inside prepare,
+ * glyph rasterization and effects inside render), so stage times are
+ * inclusive and do not add up to the frame total.
+ *
+ * Timing only happens on the thread that owns the current frame; glyph or
+ * effect work done elsewhere (tray previews, dialogs) is not attributed.
+ * Statistics cover the current summary interval and are logged and reset
+ * once per RENDER_METRICS_SUMMARY_INTERVAL_MS.
+ */
+
+#ifndef DRAWING_RENDER_METRICS_H
+#define DRAWING_RENDER_METRICS_H
+
+#include <windows.h>
+
+#define RENDER_METRICS_SUMMARY_INTERVAL_MS 60000
+
+/** @brief INI key in [Options] that shows the statistics over the clock */
+#define RENDER_METRICS_OVERLAY_KEY "RENDER_METRICS_OVERLAY"
+
+typedef enum {
+    RENDER_STAGE_FRAME = 0,
+    RENDER_STAGE_PREPARE,
+    RENDER_STAGE_MARKDOWN_PARSE,
+    RENDER_STAGE_MEASURE,
+    RENDER_STAGE_RENDER,
+    RENDER_STAGE_GLYPH_RASTERIZE,
+    RENDER_STAGE_EFFECT,
+    RENDER_STAGE_IMAGE,
+    RENDER_STAGE_PRESENT,
+    RENDER_STAGE_COUNT
+} RenderMetricStage;
+
+typedef enum {
+    RENDER_COUNTER_GLYPH_CACHE_HIT = 0,
+    RENDER_COUNTER_GLYPH_CACHE_MISS,
+    RENDER_COUNTER_DIB_REALLOC,
+    RENDER_COUNTER_PRESENT_SKIPPED,
+    RENDER_COUNTER_COUNT
+} RenderMetricCounter;
+
+/** @brief Start timing a paint on the calling thread */
+void RenderMetrics_BeginFrame(void);
+
+/** @brief Fold the frame into the histograms; logs a summary when due */
+void RenderMetrics_EndFrame(void);
+
+/**
+ * @brief Timestamp for a stage
+ * @return QPC ticks, or 0 when the calling thread is not inside a frame
+ */
+LONGLONG RenderMetrics_StageBegin(void);
+
+/** @brief Add the time since begin to a stage; ignores begin == 0 */
+void RenderMetrics_StageEnd(RenderMetricStage stage, LONGLONG begin);
+
+/** @brief Bump a counter for the current frame */
+void RenderMetrics_Count(RenderMetricCounter counter);
+
+/** @brief Re-read the overlay toggle from config.ini */
+void RenderMetrics_LoadConfig(void);
+
+BOOL RenderMetrics_IsOverlayEnabled(void);
+
+/**
+ * @brief Draw the current interval statistics into the top-left corner
+ * @param memDC DC with the frame DIB selected
+ * @param pixels Top-down premultiplied ARGB frame bits
+ */
+void RenderMetrics_DrawOverlay(HDC memDC, DWORD* pixels, int width, int height);
+
+#endif /* DRAWING_RENDER_METRICS_H */
@@ -0,0 +1,43 @@
+/**
+ * @file drawing_sparkline.h
+ * @brief Compact graphs of MetricHistory columns
+ *
+ * Two forms: an 8-bit coverage raster for surfaces that are colorized later
+ * (the taskbar monitor mask), and a row of Unicode block elements for plain
+ * text such as the tray tooltip. Both scale against scaleMax, or against
+ * the largest sample in the columns when scaleMax is 0 or less.
+ */
+
+#ifndef DRAWING_SPARKLINE_H
+#define DRAWING_SPARKLINE_H
+
+#include <windows.h>
+
+#include "utils/metric_history.h"
+
+/** @brief Coverage of the area under the average line */
+#define SPARKLINE_FILL_COVERAGE 96
+/** @brief Coverage of the min..max band above the fill */
+#define SPARKLINE_BAND_COVERAGE 48
+
+/**
+ * @brief Rasterize columns bottom-up into a width x height coverage buffer
+ *
+ * Each pixel column samples one history column. The buffer is cleared first;
+ * columns without samples stay empty. The top pixel of the average is full
+ * coverage so the trend stays legible at two or three pixels tall.
+ */
+void Sparkline_RasterizeCoverage(BYTE* coverage, int width, int height,
+                                 const MetricHistoryPoint* points, int pointCount,
+                                 float scaleMax);
+
+/**
+ * @brief Format averages as U+2581..U+2588, one character per column
+ * @return Characters written, excluding the terminator
+ *
+ * Columns without samples become spaces. Output is truncated to fit.
+ */
+int Sparkline_FormatText(const MetricHistoryPoint* points, int pointCount,
+                         float scaleMax, wchar_t* output, size_t outputCount);
+
+#endif /* DRAWING_SPARKLINE_H */
@@ -13,6 +13,24 @@
 
 #define GRADIENT_LUT_SIZE 512
 
+/**
+ * @brief Gradient colors of one text run for one frame, one per column.
+ *
+ * Built by AcquireGradientScanlineSTB; glyph blends, effect callbacks and
+ * tile replays all index the same row.
+ */
+typedef struct {
+    BOOL valid;
+    GradientInfo info;      /* Colors and flags only; names and palette cleared */
+    DWORD signature;
+    int startX;
+    int totalWidth;
+    int timeOffset;
+    int width;
+    COLORREF* colors;
+    int capacity;
+} GradientScanline;
+
 /**
  * @brief Initialize STB Truetype with a font file
  * @param fontFilePath Absolute path to the .ttf/.ttc file
@@ -103,6 +121,7 @@ void RenderTextSTB(void* bits, int width, int height, const wchar_t* text,
 typedef struct {
     int index;
     BOOL isFallback;
+    int fallbackSlot;   /* Fallback chain link when isFallback is set */
     int advance;
     int kern;
 } GlyphMetrics;
@@ -122,6 +141,15 @@ BOOL IsFallbackFontLoadedSTB(void);
 stbtt_fontinfo* GetMainFontInfoSTB(void);
 stbtt_fontinfo* GetFallbackFontInfoSTB(void);
 
+/**
+ * @brief Face and scale a glyph from GetCharMetricsSTB must be drawn with.
+ * @note Main font when the glyph is not a fallback; caller holds BeginFontUseSTB().
+ */
+const stbtt_fontinfo* GetGlyphFontInfoSTB(const GlyphMetrics* metrics,
+                                          float scale,
+                                          float fallbackScale,
+                                          float* glyphScale);
+
 /* Shared Helper Functions */
 void GetCharMetricsSTB(wchar_t c, wchar_t nextC, float scale, float fallbackScale, GlyphMetrics* out);
 
@@ -180,4 +208,23 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
                                         const GradientInfo* gradientInfo,
                                         int timeOffset, EffectType effect);
 
+/**
+ * @brief Gradient row for a run spanning [startX, startX + totalWidth)
+ * @return Shared row covering destination columns [0, destWidth), rebuilt
+ *         only when the gradient, geometry or animation offset changes;
+ *         NULL when out of memory
+ * @note Valid until the next acquire with different parameters
+ */
+const GradientScanline* AcquireGradientScanlineSTB(const GradientInfo* info,
+                                                   int startX, int totalWidth,
+                                                   int timeOffset, int destWidth);
+
+void ReleaseGradientScanlineSTB(void);
+
+void BlendCharBitmapGradientScanlineSTB(void* destBits, int destWidth, int destHeight,
+                                        int x_pos, int y_pos,
+                                        const unsigned char* bitmap, int w, int h,
+                                        const GradientScanline* scanline,
+                                        int timeOffset, EffectType effect);
+
 #endif // DRAWING_TEXT_STB_H
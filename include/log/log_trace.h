@@ -0,0 +1,73 @@
+/**
+ * @file log_trace.h
+ * @brief Lightweight span tracer exported as Chrome trace_event JSON
+ *
+ * Disabled by default; a disabled TRACE_SPAN_BEGIN costs one load. When
+ * enabled each thread records into its own fixed buffer without locks, and
+ * buffers outlive their threads so short-lived scan workers still show up
+ * in the exported trace (chrome://tracing, Perfetto).
+ */
+
+#ifndef LOG_TRACE_H
+#define LOG_TRACE_H
+
+#include <windows.h>
+
+/** @brief Spans kept per thread; later spans are counted as dropped */
+#define TRACE_SPAN_MAX_EVENTS_PER_THREAD 1024
+
+/** @brief Threads that can record; later threads are ignored */
+#define TRACE_SPAN_MAX_THREADS 64
+
+/**
+ * @brief Open a span on the calling thread
+ * @param token Local variable declared to hold the span handle
+ * @param name String literal; the pointer is stored, not copied
+ */
+#define TRACE_SPAN_BEGIN(token, name) int token = TraceSpan_Begin(name)
+
+/** @brief Close a span opened with TRACE_SPAN_BEGIN on the same thread */
+#define TRACE_SPAN_END(token) TraceSpan_End(token)
+
+/**
+ * @brief Start recording; call on the main thread before workers start
+ * @return TRUE when tracing is active; FALSE after TraceSpan_Shutdown
+ */
+BOOL TraceSpan_Enable(void);
+
+/** @return TRUE when spans are being recorded */
+BOOL TraceSpan_IsEnabled(void);
+
+/**
+ * @brief Label the calling thread in the exported trace
+ * @param name String literal; the pointer is stored, not copied
+ */
+void TraceSpan_NameThread(const char* name);
+
+/**
+ * @brief Open a span
+ * @return Token for TraceSpan_End, or -1 when not recorded
+ */
+int TraceSpan_Begin(const char* name);
+
+/** @brief Close a span; ignores -1 and tokens from other threads */
+void TraceSpan_End(int token);
+
+/** @brief Record a zero-length marker such as the first presented frame */
+void TraceSpan_Instant(const char* name);
+
+/**
+ * @brief Write every completed span as Chrome trace_event JSON
+ * @param path Destination file, replaced if it exists
+ * @return TRUE on success
+ * @note Safe while other threads keep recording; open spans are skipped
+ */
+BOOL TraceSpan_WriteChromeTrace(const wchar_t* path);
+
+/**
+ * @brief Stop recording for the rest of the process
+ * @note Safe while workers still record; their buffers are kept until exit
+ */
+void TraceSpan_Shutdown(void);
+
+#endif /* LOG_TRACE_H */
@@ -57,6 +57,15 @@ void AddLinkRegion(const RECT* rect, const wchar_t* url);
  */
 void AddCheckboxRegion(const RECT* rect, int index, BOOL isChecked);
 
+/**
+ * @brief Publish the regions added since the last clear for hit testing
+ *
+ * @details Called once a frame's text is rendered. Hover and click tests
+ * read the published grid index without taking the region lock; an
+ * unchanged layout keeps its existing index.
+ */
+void PublishClickableRegions(void);
+
 /**
  * @brief Update window position offset for all regions
  * @param windowX Window X position
@@ -0,0 +1,101 @@
+/**
+ * @file plugin_channel.h
+ * @brief Shared-memory channel plugins can use instead of rewriting output.txt
+ *
+ * Catime creates one named file mapping per process and exports its name to
+ * plugins through the CATIME_PLUGIN_CHANNEL environment variable. A producer
+ * opens the mapping and the "<name>-Ready" event, writes each display update
+ * into the next ring slot and signals the event. The host only ever shows the
+ * newest record, so the ring exists to let the producer keep writing while the
+ * host copies an older slot, not to queue history.
+ *
+ * Each slot is a seqlock: sequence is odd while the producer writes it and
+ * becomes 2 * record number once the payload is complete. Readers copy the
+ * payload and accept it only if the sequence was even and unchanged around
+ * the copy. One producer per channel is supported.
+ */
+
+#ifndef PLUGIN_CHANNEL_H
+#define PLUGIN_CHANNEL_H
+
+#include <windows.h>
+
+#define PLUGIN_CHANNEL_ENV_NAME L"CATIME_PLUGIN_CHANNEL"
+#define PLUGIN_CHANNEL_NAME_PREFIX L"Local\\CatimePluginOutput-"
+#define PLUGIN_CHANNEL_EVENT_SUFFIX L"-Ready"
+#define PLUGIN_CHANNEL_NAME_CHARS 96
+
+#define PLUGIN_CHANNEL_MAGIC 0x42525443u /* "CTRB" */
+#define PLUGIN_CHANNEL_VERSION 1u
+#define PLUGIN_CHANNEL_SLOT_COUNT 8u
+/** Matches the display input limit applied to output.txt */
+#define PLUGIN_CHANNEL_SLOT_BYTES 4096u
+#define PLUGIN_CHANNEL_READ_RETRIES 4
+
+typedef struct {
+    volatile LONG sequence;
+    DWORD length;
+    char data[PLUGIN_CHANNEL_SLOT_BYTES];
+} PluginChannelSlot;
+
+typedef struct {
+    DWORD magic;
+    DWORD version;
+    DWORD slotCount;
+    DWORD slotBytes;
+    /** Record number of the newest complete slot; 0 before the first publish */
+    volatile LONG publishedSequence;
+    volatile LONG producerPid;
+    DWORD reserved[2];
+    PluginChannelSlot slots[PLUGIN_CHANNEL_SLOT_COUNT];
+} PluginChannelBuffer;
+
+typedef enum {
+    PLUGIN_CHANNEL_READ_NONE = 0,
+    PLUGIN_CHANNEL_READ_OK,
+    PLUGIN_CHANNEL_READ_BUSY
+} PluginChannelReadResult;
+
+/** @brief Stamp the header of a freshly created mapping */
+void PluginChannel_InitBuffer(PluginChannelBuffer* buffer);
+
+/** @return TRUE if the mapping carries a layout this build understands */
+BOOL PluginChannel_IsCompatible(const PluginChannelBuffer* buffer);
+
+/**
+ * @brief Copy the newest record if it is newer than lastSequence
+ * @param data Receives up to PLUGIN_CHANNEL_SLOT_BYTES bytes, not terminated
+ * @param sequenceOut Record number that was copied
+ * @return READ_BUSY if the producer kept overwriting the slot being copied
+ */
+PluginChannelReadResult PluginChannel_ReadLatest(const PluginChannelBuffer* buffer,
+                                                 ULONG lastSequence,
+                                                 char* data, DWORD* lengthOut,
+                                                 ULONG* sequenceOut);
+
+/**
+ * @brief Write one record into the next slot
+ * @return Record number published, or 0 if length exceeds a slot
+ */
+ULONG PluginChannel_Write(PluginChannelBuffer* buffer,
+                          const char* data, DWORD length);
+
+/**
+ * @brief Reference producer for native plugins and tests
+ * @details Scripted plugins can follow the same steps with their own
+ * OpenFileMapping/OpenEvent bindings.
+ */
+typedef struct {
+    HANDLE mapping;
+    HANDLE readyEvent;
+    PluginChannelBuffer* buffer;
+} PluginChannelProducer;
+
+/** @param channelName NULL to read CATIME_PLUGIN_CHANNEL */
+BOOL PluginChannelProducer_Open(PluginChannelProducer* producer,
+                                const wchar_t* channelName);
+BOOL PluginChannelProducer_Publish(PluginChannelProducer* producer,
+                                   const char* utf8, DWORD length);
+void PluginChannelProducer_Close(PluginChannelProducer* producer);
+
+#endif /* PLUGIN_CHANNEL_H */
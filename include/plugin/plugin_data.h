@@ -129,6 +129,28 @@ void PluginData_ProcessPendingNotification(HWND hwnd);
  */
 void PluginData_HandleRedrawRequest(HWND hwnd);
 
+/** @brief Launch-to-first-output latency for one kind of plugin start */
+typedef struct {
+    DWORD count;
+    ULONGLONG minMicros;
+    ULONGLONG maxMicros;
+    ULONGLONG lastMicros;
+    ULONGLONG totalMicros;
+} PluginLaunchLatencyStats;
+
+/**
+ * @brief Time the next applied plugin output against a launch
+ * @param startCounter QueryPerformanceCounter value taken when the launch began
+ * @param warm TRUE when the plugin ran in a pre-spawned interpreter
+ */
+void PluginData_BeginLaunchMeasurement(LONGLONG startCounter, BOOL warm);
+
+/**
+ * @brief Copy launch latency totals for warm or cold starts
+ * @return TRUE if at least one launch of that kind has been measured
+ */
+BOOL PluginData_GetLaunchLatencyStats(BOOL warm, PluginLaunchLatencyStats* stats);
+
 /** @brief Custom message ID for plugin notifications */
 #define WM_PLUGIN_NOTIFY (WM_APP + 200)
 
@@ -12,11 +12,21 @@
 
 #include <windows.h>
 
+#include "utils/metric_history.h"
+
 typedef enum {
     SYSTEM_MONITOR_SNAPSHOT_CPU_MEMORY = 1u << 0,
     SYSTEM_MONITOR_SNAPSHOT_NETWORK = 1u << 1
 } SystemMonitorSnapshotFields;
 
+typedef enum {
+    SYSTEM_MONITOR_METRIC_CPU = 0,
+    SYSTEM_MONITOR_METRIC_MEMORY,
+    SYSTEM_MONITOR_METRIC_UPLOAD,
+    SYSTEM_MONITOR_METRIC_DOWNLOAD,
+    SYSTEM_MONITOR_METRIC_COUNT
+} SystemMonitorMetric;
+
 typedef struct {
     float cpuPercent;
     float memoryPercent;
@@ -119,6 +129,23 @@ BOOL SystemMonitor_GetUsage(float* outCpuPercent, float* outMemPercent);
 BOOL SystemMonitor_GetSnapshot(DWORD fields,
                                SystemMonitorSnapshot* outSnapshot);
 
+/**
+ * @brief Resample a metric's recorded history into columns
+ * @param metric Series to read
+ * @param fromTick Start of the range (GetTickCount64 milliseconds)
+ * @param toTick End of the range, exclusive
+ * @param points Receives pointCount columns, oldest first
+ * @return Number of columns that hold at least one sample
+ *
+ * @details Every successful sample is recorded while the monitor is
+ * initialized: 1 s resolution for 5 minutes, 10 s for an hour and 1 min for
+ * 24 hours. History starts over after SystemMonitor_Shutdown. Does not
+ * trigger a refresh.
+ */
+int SystemMonitor_QueryHistory(SystemMonitorMetric metric,
+                               ULONGLONG fromTick, ULONGLONG toTick,
+                               MetricHistoryPoint* points, int pointCount);
+
 /**
  * @brief Get network speed (active interfaces, excludes loopback)
  * @param outUpBytesPerSec Upload speed output (bytes/sec)
@@ -0,0 +1,74 @@
+/**
+ * @file tray_menu_cache.h
+ * @brief Retained right-click submenus with generation-based invalidation.
+ *
+ * The font, animation and plugin submenus hold the scan-driven lists and are
+ * the expensive part of the right-click menu. They are kept between popups
+ * and only rebuilt after their generation is bumped by a scan completion,
+ * configuration reload or language switch. A current submenu only has its
+ * check marks patched when it opens.
+ */
+
+#ifndef CATIME_TRAY_MENU_CACHE_H
+#define CATIME_TRAY_MENU_CACHE_H
+
+#include <windows.h>
+
+typedef enum {
+    TRAY_MENU_CACHE_FONT = 0,
+    TRAY_MENU_CACHE_PLUGINS,
+    TRAY_MENU_CACHE_ANIMATION,
+    TRAY_MENU_CACHE_SLOT_COUNT
+} TrayMenuCacheSlot;
+
+/**
+ * @brief Check state for a command ID: 1 checked, 0 unchecked, -1 untouched
+ */
+typedef int (*TrayMenuCheckQuery)(UINT id);
+
+/**
+ * @brief Mark one retained submenu stale; safe from any thread
+ */
+void TrayMenuCache_Invalidate(TrayMenuCacheSlot slot);
+
+/**
+ * @brief Mark every retained submenu stale (config reload, language switch)
+ */
+void TrayMenuCache_InvalidateAll(void);
+
+/**
+ * @brief Attach a retained submenu to a freshly built parent menu
+ * @param parent Menu being built for this popup
+ * @param slot Retained submenu to attach
+ * @param label Localized parent item text
+ * @return TRUE when the submenu was attached
+ * @note Stale content is rebuilt when the submenu opens, not here
+ */
+BOOL TrayMenuCache_AppendSubmenu(HMENU parent, TrayMenuCacheSlot slot,
+                                 const wchar_t* label);
+
+/**
+ * @brief Detach retained submenus so DestroyMenu(parent) leaves them alive
+ */
+void TrayMenuCache_DetachSubmenus(HMENU parent);
+
+/**
+ * @brief Rebuild or patch a retained submenu from WM_INITMENUPOPUP
+ * @return TRUE when the menu was a retained submenu
+ */
+BOOL TrayMenuCache_OnInitMenuPopup(HMENU menu);
+
+/**
+ * @brief Apply check marks from a query across a submenu tree
+ * @param checkFolders Also check folder popups that contain the selection
+ * @note Continuation "More" popups always mirror their contents
+ */
+void TrayMenuCache_PatchChecks(HMENU menu, TrayMenuCheckQuery query,
+                               BOOL checkFolders);
+
+/**
+ * @brief Destroy retained submenus; called during final tray cleanup
+ */
+void TrayMenuCache_Cleanup(void);
+
+#endif /* CATIME_TRAY_MENU_CACHE_H */
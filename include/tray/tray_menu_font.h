@@ -6,10 +6,17 @@
 #define FONT_MENU_MAX_ENTRIES 200
 
 /**
- * @brief Build font submenu from cached recursive folder scan
- * @param hMenu Parent menu handle
+ * @brief Fill the font popup from the cached recursive folder scan
+ * @param hFontSubMenu Empty popup menu to fill
  */
-void BuildFontSubmenu(HMENU hMenu);
+void FillFontSubmenu(HMENU hFontSubMenu);
+
+/**
+ * @brief Refresh check marks of a retained font popup
+ * @param hFontSubMenu Popup previously filled by FillFontSubmenu
+ * @return FALSE when the popup must be rebuilt instead
+ */
+BOOL PatchFontSubmenu(HMENU hFontSubMenu);
 
 /**
  * @brief Reset shutdown state before using the font menu cache
@@ -13,6 +13,9 @@ typedef struct {
     int itemCount;
 } TrayMenuPaginationRange;
 
+/** @brief dwItemData of every continuation popup item created here */
+#define TRAY_MENU_PAGINATION_CONTINUATION_TAG ((ULONG_PTR)0x4D4F5245u)
+
 /**
  * @brief Estimate how many native menu rows fit in two thirds of the monitor.
  */
@@ -54,4 +57,9 @@ BOOL TrayMenuPagination_ApplyRangeForCurrentMonitor(
     HMENU menu, const TrayMenuPaginationRange* range,
     const wchar_t* moreLabel);
 
+/**
+ * @brief Whether an item is a continuation popup, independent of its label.
+ */
+BOOL TrayMenuPagination_IsContinuationItem(const MENUITEMINFOW* item);
+
 #endif /* CATIME_TRAY_MENU_PAGINATION_H */
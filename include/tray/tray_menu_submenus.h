@@ -44,16 +44,28 @@ BOOL GetColorMenuColorFromId(UINT id, char* outColor, size_t outSize);
 void BuildStyleSubmenu(HMENU hMenu);
 
 /**
- * @brief Build animation/tray icon submenu
- * @param hMenu Parent menu handle
+ * @brief Fill animation/tray icon popup
+ * @param hAnimMenu Empty popup menu to fill
  */
-void BuildAnimationSubmenu(HMENU hMenu);
+void FillAnimationSubmenu(HMENU hAnimMenu);
 
 /**
- * @brief Build plugins submenu
- * @param hMenu Parent menu handle
+ * @brief Refresh check marks of a retained animation popup
+ * @return FALSE when the popup must be rebuilt instead
+ */
+BOOL PatchAnimationSubmenu(HMENU hAnimMenu);
+
+/**
+ * @brief Fill plugins popup
+ * @param hPluginsMenu Empty popup menu to fill
+ */
+void FillPluginsSubmenu(HMENU hPluginsMenu);
+
+/**
+ * @brief Refresh check marks of a retained plugins popup
+ * @return FALSE when the popup must be rebuilt instead
  */
-void BuildPluginsSubmenu(HMENU hMenu);
+BOOL PatchPluginsSubmenu(HMENU hPluginsMenu);
 
 /**
  * @brief Build help/about submenu
@@ -0,0 +1,145 @@
+/**
+ * @file directory_index.h
+ * @brief Incremental per-root file index with add/change/remove deltas
+ *
+ * Keeps the files and folders found under one root between scans. A refresh
+ * stats every known folder but only enumerates folders whose write time
+ * changed, so rescanning a large, mostly unchanged tree costs one attribute
+ * query per folder instead of one FindFirstFileW walk per file.
+ */
+
+#ifndef UTILS_DIRECTORY_INDEX_H
+#define UTILS_DIRECTORY_INDEX_H
+
+#include <windows.h>
+
+#define DIRECTORY_INDEX_FAILED (-1)
+#define DIRECTORY_INDEX_METADATA_BYTES 16
+
+typedef enum {
+    DIRECTORY_INDEX_ADDED = 0,
+    DIRECTORY_INDEX_CHANGED,
+    DIRECTORY_INDEX_REMOVED
+} DirectoryIndexChange;
+
+/**
+ * @brief One indexed file
+ * @details relativePath is relative to the root; nameOffset locates the name.
+ * metadata is filled by the accept callback and kept until the file changes.
+ */
+typedef struct {
+    wchar_t relativePath[MAX_PATH];
+    ULONGLONG pathHash;
+    WORD nameOffset;
+    int folder;
+    ULONGLONG size;
+    FILETIME lastWriteTime;
+    BYTE metadata[DIRECTORY_INDEX_METADATA_BYTES];
+    BOOL seen;
+    BOOL changed;
+    BOOL reported;
+    int nextInBucket;
+    int nextInFolder;
+} DirectoryIndexEntry;
+
+typedef struct {
+    wchar_t relativePath[MAX_PATH];
+    ULONGLONG pathHash;
+    FILETIME lastWriteTime;
+    int parent;
+    int depth;
+    BOOL seen;
+    int nextInBucket;
+    int firstChild;
+    int lastChild;
+    int nextSibling;
+    int firstFile;
+} DirectoryIndexFolder;
+
+/** @return FALSE to leave the file out of the index */
+typedef BOOL (*DirectoryIndexAcceptCallback)(const WIN32_FIND_DATAW* data,
+                                             BYTE* metadata,
+                                             void* context);
+typedef BOOL (*DirectoryIndexCancelCallback)(void* context);
+typedef void (*DirectoryIndexDeltaCallback)(DirectoryIndexChange change,
+                                            const DirectoryIndexEntry* entry,
+                                            void* context);
+/** @return FALSE to stop visiting the remaining entries */
+typedef BOOL (*DirectoryIndexVisitCallback)(const DirectoryIndexEntry* entry,
+                                            void* context);
+
+typedef struct {
+    DirectoryIndexCancelCallback isCanceled;
+    DirectoryIndexDeltaCallback onDelta;
+    DirectoryIndexVisitCallback onEntry;
+    void* context;
+} DirectoryIndexCallbacks;
+
+/**
+ * @brief Index state; zero-initialized storage plus DirectoryIndex_Init is valid
+ * @details maxDepth 0 indexes only the root folder itself.
+ */
+typedef struct {
+    SRWLOCK lock;
+    wchar_t root[MAX_PATH];
+    int maxDepth;
+    int maxEntries;
+    int maxScanEntries;
+    DirectoryIndexAcceptCallback accept;
+    void* acceptContext;
+    DirectoryIndexEntry* entries;
+    int entryCount;
+    int entryCapacity;
+    DirectoryIndexFolder* folders;
+    int folderCount;
+    int folderCapacity;
+    int* entryBuckets;
+    int entryBucketCount;
+    int* folderBuckets;
+    int folderBucketCount;
+    BOOL needsFullScan;
+    BOOL truncated;
+    int scannedEntries;
+    DWORD enumeratedFolders;
+    DWORD reusedFolders;
+} DirectoryIndex;
+
+/** @brief Outcome of the most recent refresh */
+typedef struct {
+    int entryCount;
+    BOOL truncated;
+    DWORD enumeratedFolders;
+    DWORD reusedFolders;
+} DirectoryIndexStats;
+
+void DirectoryIndex_Init(DirectoryIndex* index, int maxDepth,
+                         int maxEntries, int maxScanEntries,
+                         DirectoryIndexAcceptCallback accept,
+                         void* acceptContext);
+
+/**
+ * @brief Bring the index up to date with the tree under root
+ * @param root Absolute folder path; a different root discards the index
+ * @param callbacks Optional cancel, delta and visit callbacks
+ * @return Indexed file count or DIRECTORY_INDEX_FAILED
+ *
+ * @details
+ * Deltas are reported only after a complete pass, so a failed or canceled
+ * refresh reports nothing and the next refresh re-enumerates every folder.
+ * onEntry then visits every indexed file under the index lock, which is the
+ * only safe way for callers to copy entries out.
+ */
+int DirectoryIndex_Refresh(DirectoryIndex* index, const wchar_t* root,
+                           const DirectoryIndexCallbacks* callbacks);
+
+/** @brief Copy the last refresh's counters under the index lock */
+void DirectoryIndex_GetStats(DirectoryIndex* index, DirectoryIndexStats* stats);
+
+/** @brief Force the next refresh to enumerate every folder */
+void DirectoryIndex_Invalidate(DirectoryIndex* index);
+
+void DirectoryIndex_Free(DirectoryIndex* index);
+
+const wchar_t* DirectoryIndex_EntryFileName(const DirectoryIndexEntry* entry);
+
+#endif /* UTILS_DIRECTORY_INDEX_H */
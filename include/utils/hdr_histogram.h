@@ -0,0 +1,51 @@
+/**
+ * @file hdr_histogram.h
+ * @brief Fixed-size log-linear latency histogram
+ *
+ * Values below 32 get exact slots; above that every power of two is split
+ * into 16 linear slots, in the style of HdrHistogram. Any value up to
+ * 2^32-1 is reported back within 6.25% from a flat array that needs no
+ * allocation, and recording is a bit scan and an increment.
+ */
+
+#ifndef UTILS_HDR_HISTOGRAM_H
+#define UTILS_HDR_HISTOGRAM_H
+
+#include <windows.h>
+
+#define HDR_HISTOGRAM_SUB_BUCKET_BITS 5
+#define HDR_HISTOGRAM_SUB_BUCKETS (1 << HDR_HISTOGRAM_SUB_BUCKET_BITS)
+#define HDR_HISTOGRAM_HALF_BUCKETS (HDR_HISTOGRAM_SUB_BUCKETS / 2)
+/** @brief Shifts 0..27 cover 32-bit values: (27 + 2) * 16 slots */
+#define HDR_HISTOGRAM_BUCKETS ((32 - HDR_HISTOGRAM_SUB_BUCKET_BITS + 2) * HDR_HISTOGRAM_HALF_BUCKETS)
+
+typedef struct {
+    DWORD counts[HDR_HISTOGRAM_BUCKETS];
+    ULONGLONG totalCount;
+    ULONGLONG sum;
+    DWORD min;
+    DWORD max;
+} HdrHistogram;
+
+void HdrHistogram_Reset(HdrHistogram* histogram);
+
+void HdrHistogram_Record(HdrHistogram* histogram, DWORD value);
+
+/**
+ * @brief Value at or below which the given share of samples fall
+ * @param percentile 0.0 to 100.0
+ * @return Highest value equivalent to the matching bucket, clamped to max;
+ *         0 when the histogram is empty
+ */
+DWORD HdrHistogram_ValueAtPercentile(const HdrHistogram* histogram, double percentile);
+
+/** @return Exact mean of the recorded values, 0 when empty */
+DWORD HdrHistogram_Mean(const HdrHistogram* histogram);
+
+/** @brief Bucket index for a value; exposed for tests */
+int HdrHistogram_BucketIndex(DWORD value);
+
+/** @brief Largest value that lands in the same bucket as index */
+DWORD HdrHistogram_BucketHighestValue(int index);
+
+#endif /* UTILS_HDR_HISTOGRAM_H */
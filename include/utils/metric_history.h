@@ -0,0 +1,77 @@
+/**
+ * @file metric_history.h
+ * @brief Fixed-memory multi-resolution history for one sampled metric
+ *
+ * Every sample is folded into three rings at once: 1 s buckets for five
+ * minutes, 10 s buckets for an hour and 1 min buckets for a day. Buckets
+ * keep min, max, sum and count, so downsampling happens on insert and a
+ * query never revisits raw samples. Each slot remembers which bucket it
+ * holds; a slot left over from an earlier lap of the ring is recognized as
+ * stale and overwritten, so an insert touches exactly one slot per tier no
+ * matter how long the gap since the previous sample.
+ */
+
+#ifndef UTILS_METRIC_HISTORY_H
+#define UTILS_METRIC_HISTORY_H
+
+#include <windows.h>
+
+#define METRIC_HISTORY_TIER_COUNT 3
+/** @brief 300 + 360 + 1440 slots across the three tiers */
+#define METRIC_HISTORY_SLOT_COUNT 2100
+/** @brief Longest range any tier retains (24 h) */
+#define METRIC_HISTORY_MAX_SPAN_MS (24ULL * 60ULL * 60ULL * 1000ULL)
+
+typedef struct {
+    DWORD epoch;
+    DWORD count;
+    float min;
+    float max;
+    float sum;
+} MetricHistoryBucket;
+
+typedef struct {
+    MetricHistoryBucket slots[METRIC_HISTORY_SLOT_COUNT];
+    ULONGLONG latestTick;
+    BOOL hasSamples;
+} MetricHistory;
+
+/** @brief One query column; count is 0 when no sample fell into it */
+typedef struct {
+    float min;
+    float max;
+    float average;
+    DWORD count;
+} MetricHistoryPoint;
+
+void MetricHistory_Reset(MetricHistory* history);
+
+/**
+ * @brief Fold one sample into every tier
+ * @param tickMs GetTickCount64-style timestamp
+ *
+ * Non-finite values are dropped. Samples older than a tier's retention, or
+ * older than the slot they map to, are ignored by that tier.
+ */
+void MetricHistory_Insert(MetricHistory* history, ULONGLONG tickMs, float value);
+
+/**
+ * @brief Resample [fromTickMs, toTickMs) into evenly spaced columns
+ * @param points Receives pointCount columns, oldest first
+ * @return Number of columns that received at least one sample
+ *
+ * Reads the finest tier that still retains fromTickMs, merging its buckets
+ * into columns by min, max and count-weighted average. Cost is bounded by
+ * the slots in the range, never by the number of raw samples.
+ */
+int MetricHistory_Query(const MetricHistory* history,
+                        ULONGLONG fromTickMs, ULONGLONG toTickMs,
+                        MetricHistoryPoint* points, int pointCount);
+
+/** @brief Bucket width in milliseconds of a tier; exposed for tests */
+DWORD MetricHistory_TierResolutionMs(int tier);
+
+/** @brief Index of the tier a query starting at fromTickMs reads */
+int MetricHistory_SelectTier(const MetricHistory* history, ULONGLONG fromTickMs);
+
+#endif /* UTILS_METRIC_HISTORY_H */
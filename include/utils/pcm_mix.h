@@ -0,0 +1,45 @@
+/**
+ * @file pcm_mix.h
+ * @brief Fixed-point mixing of interleaved 16-bit PCM
+ *
+ * Voices are summed into 32-bit accumulators with Q15 gains, where
+ * PCM_MIX_UNITY_GAIN leaves a sample unchanged, and the sum is saturated
+ * back to 16 bits once per buffer. Gains ramp linearly across a buffer so
+ * fades and gain changes never step mid-waveform. Everything is integer
+ * arithmetic, which keeps the real-time callback free of float rounding
+ * and denormals.
+ */
+
+#ifndef UTILS_PCM_MIX_H
+#define UTILS_PCM_MIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCM_MIX_UNITY_GAIN 32768
+
+/**
+ * @brief Moves a gain toward its target by at most maxDelta
+ */
+int32_t PcmMix_StepGain(int32_t gain, int32_t target, int32_t maxDelta);
+
+/**
+ * @brief Gain change covering frames of a full-scale fade lasting fadeFrames
+ * @return At least 1, so every fade eventually completes
+ */
+int32_t PcmMix_FadeDelta(uint32_t frames, uint32_t fadeFrames);
+
+/**
+ * @brief Adds source to accum with a gain ramp from gainFrom to gainTo
+ * @param frames Frame count; accum and source hold frames * channels samples
+ */
+void PcmMix_Accumulate(int32_t* accum, const int16_t* source,
+                       size_t frames, int channels,
+                       int32_t gainFrom, int32_t gainTo);
+
+/**
+ * @brief Saturates accumulated samples into 16-bit output
+ */
+void PcmMix_Resolve(int16_t* output, const int32_t* accum, size_t samples);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <windows.h>
 #include <ole2.h>
+#include "window_procedure/window_drop_target.h"
 
 /**
  * @brief Initialize OLE and register drag drop for window
@@ -14,4 +15,9 @@ void InitializeOleDropTarget(HWND hwnd);
  */
 void CleanupOleDropTarget(HWND hwnd);
 
+/**
+ * @brief Settle the preview a drop left pending once its import finished
+ */
+void OleDropTarget_CompleteImport(const DropImportResult* result);
+
 #endif // OLE_DROP_TARGET_H
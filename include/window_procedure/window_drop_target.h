@@ -2,6 +2,15 @@
 #define WINDOW_DROP_TARGET_H
 
 #include <windows.h>
+#include <shellapi.h>
+
+/* Posted by the import worker; wParam carries the job generation */
+#ifndef WM_APP_DROP_IMPORT_PROGRESS
+#define WM_APP_DROP_IMPORT_PROGRESS (WM_APP + 60)
+#endif
+#ifndef WM_APP_DROP_IMPORT_COMPLETE
+#define WM_APP_DROP_IMPORT_COMPLETE (WM_APP + 61)
+#endif
 
 typedef enum {
     RESOURCE_TYPE_UNKNOWN = 0,
@@ -16,6 +25,48 @@ typedef struct {
     int movedCount;
 } DropImportResult;
 
-DropImportResult HandleDropFiles(HWND hwnd, HDROP hDrop);
+/**
+ * @brief Copy the dropped paths and import them on a worker thread
+ * @return TRUE if a job was started; its result arrives as
+ *         WM_APP_DROP_IMPORT_COMPLETE
+ *
+ * @details A running job is canceled first. Each resource is moved into
+ * place atomically as soon as it is copied, so the font and animation
+ * folder watchers pick it up while the rest of the drop is still landing.
+ */
+BOOL StartDropImportJob(HWND hwnd, HDROP hDrop);
+
+/**
+ * @brief Cancel the running import job without waiting for its worker
+ * @return TRUE if a job was running
+ *
+ * @details The worker stops after its current copy chunk and frees the job
+ * itself; a completion that was already queued is ignored.
+ */
+BOOL CancelDropImportJob(void);
+
+/**
+ * @brief Cancel the running job and briefly wait for every worker to exit
+ *
+ * @details Used when the main window is destroyed, so a canceled copy can
+ * remove its temporary file before the process ends.
+ */
+void ShutdownDropImportJobs(void);
+
+/**
+ * @brief Check whether an import job is still running
+ */
+BOOL IsDropImportJobRunning(void);
+
+/**
+ * @brief Read the latest progress of the running import job
+ * @param imported Resources imported so far, may be NULL
+ * @param scanned Entries scanned so far, may be NULL
+ * @return FALSE if no job is running
+ */
+BOOL GetDropImportProgress(int* imported, DWORD* scanned);
+
+LRESULT HandleDropImportProgress(HWND hwnd, WPARAM wp, LPARAM lp);
+LRESULT HandleDropImportComplete(HWND hwnd, WPARAM wp, LPARAM lp);
 
 #endif // WINDOW_DROP_TARGET_H
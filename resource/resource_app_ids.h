@@ -189,6 +189,7 @@
 /** @brief Basic menu identifiers */
 #define CLOCK_IDM_CUSTOM_COUNTDOWN 101       /**< Custom countdown input */
 #define CLOCK_IDM_EXIT 109                   /**< Exit application */
+#define CLOCK_IDM_CANCEL_DROP_IMPORT 143     /**< Cancel a running drop import */
 
 /** @brief Reset menu identifiers */
 #define CLOCK_IDM_RESET_POSITION 199         /**< Reset window position and size */
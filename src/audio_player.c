@@ -6,25 +6,23 @@
 #include "audio_player_internal.h"
 
 ma_device g_device;
-ma_bool32 g_decoderInitialized = MA_FALSE;
 ma_bool32 g_deviceInitialized = MA_FALSE;
-volatile LONG g_decoderAtEnd = 0;
-volatile LONG g_decoderDrainDeadline = 0;
-volatile LONG g_decoderDrainRemainingMs = 0;
-volatile LONG g_decoderPaused = 0;
-ma_bool32 g_isPlaying = MA_FALSE;
 ma_bool32 g_isPaused = MA_FALSE;
 AudioPlaybackCompleteCallback g_audioCompleteCallback = NULL;
 HWND g_audioCallbackHwnd = NULL;
 UINT_PTR g_audioTimerId = 0;
-AudioTimerKind g_audioTimerKind = AUDIO_TIMER_NONE;
 HWND g_audioTimerHwnd = NULL;
+AudioFallbackKind g_audioFallbackKind = AUDIO_FALLBACK_NONE;
+HWND g_audioFallbackOwner = NULL;
+DWORD g_audioFallbackEndTick = 0;
 volatile LONG g_audioTimerSerial = 0;
 volatile LONG g_audioPlaybackGeneration = 0;
+volatile LONG g_audioPreviewGeneration = 0;
 volatile LONG g_audioDesiredVolume = -1;
 volatile LONG g_audioDesiredPaused = 0;
 SRWLOCK g_audioStateLock = SRWLOCK_INIT;
 SRWLOCK g_audioCallbackLock = SRWLOCK_INIT;
+volatile LONG g_audioLastStartLatencyUs = -1;
 
 void SetAudioVolume(int volume) {
     if (volume < 0) volume = 0;
@@ -52,19 +50,43 @@ void SetAudioPlaybackCompleteCallback(
     ReleaseSRWLockExclusive(&g_audioStateLock);
 }
 
+/* Voices fade out on the shared device, which stays open for the next
+ * sound; a paused mixer cuts them at once since nothing is audible */
 void CleanupAudioResourcesLocked(void) {
     PlaySoundW(NULL, NULL, SND_PURGE);
-    CleanupMiniaudioObjects();
-    if (g_audioTimerId != 0 &&
-        IsCurrentProcessAudioWindow(g_audioTimerHwnd)) {
-        KillTimer(g_audioTimerHwnd, g_audioTimerId);
-    }
+    AudioMixer_StopVoices(FALSE, g_isPaused);
     ResetPlaybackState();
 }
 
+void StopPreviewVoicesLocked(void) {
+    AudioMixer_StopVoices(TRUE, g_isPaused);
+}
+
+BOOL PlayAudioWithMiniaudio(
+    HWND hwnd, const AudioFileInfo* fileInfo,
+    AudioVoicePriority priority, LONGLONG queuedAt) {
+    if (!fileInfo || fileInfo->path[0] == L'\0') return FALSE;
+    if (!EnsureAudioPollTimer(hwnd, priority == AUDIO_VOICE_ALERT)) {
+        return FALSE;
+    }
+    ma_result result = AudioMixer_StartVoice(hwnd, priority, fileInfo, queuedAt);
+    if (result != MA_SUCCESS) {
+        LOG_WARNING(
+            "miniaudio could not play audio file (error: %d), falling back to PlaySound",
+            result);
+        return FallbackToPlaySound(hwnd, fileInfo->path);
+    }
+    return TRUE;
+}
+
 static BOOL PlayNotificationSoundFileInternalLocked(
-    HWND hwnd, const char* soundFile, BOOL allowFinalBeepFallback) {
-    CleanupAudioResourcesLocked();
+    HWND hwnd, const char* soundFile,
+    AudioVoicePriority priority, LONGLONG queuedAt) {
+    BOOL allowFinalBeepFallback = priority == AUDIO_VOICE_ALERT;
+    /* Alerts overlap each other; a new preview replaces the previous one.
+     * Like before voices existed, a new request also lifts a pause. */
+    if (priority == AUDIO_VOICE_PREVIEW) StopPreviewVoicesLocked();
+    ResumeNotificationSoundLocked();
     if (!soundFile || soundFile[0] == '\0') return TRUE;
     if (strcmp(soundFile, "SYSTEM_BEEP") == 0) {
         return FallbackToSystemBeep(hwnd);
@@ -85,54 +107,62 @@ static BOOL PlayNotificationSoundFileInternalLocked(
     if (!IsAudioFileSizeAllowed(soundFile, fileInfo.sizeBytes)) {
         return allowFinalBeepFallback ? FallbackToSystemBeep(hwnd) : FALSE;
     }
-    if (PlayAudioWithMiniaudio(hwnd, soundFile, fileInfo.path)) return TRUE;
+    if (PlayAudioWithMiniaudio(hwnd, &fileInfo, priority, queuedAt)) return TRUE;
     LOG_WARNING("All audio playback methods failed%s",
                 allowFinalBeepFallback ?
                     ", using system beep as final fallback" : "");
     return allowFinalBeepFallback ? FallbackToSystemBeep(hwnd) : FALSE;
 }
 
+static BOOL IsRequestCurrent(const AudioPlaybackRequest* request) {
+    return InterlockedCompareExchange(
+               &g_audioPlaybackGeneration, 0, 0) == request->generation &&
+           (request->priority != AUDIO_VOICE_PREVIEW ||
+            InterlockedCompareExchange(
+                &g_audioPreviewGeneration, 0, 0) == request->previewGeneration);
+}
+
 static DWORD WINAPI AudioPlaybackThreadProc(LPVOID parameter) {
     AudioPlaybackRequest* request = parameter;
     if (!request) return 0;
-    HWND hwnd = request->hwnd;
-    LONG generation = request->generation;
-    BOOL allowFinalBeepFallback = request->allowFinalBeepFallback;
-    char soundFile[MAX_PATH] = {0};
-    strncpy(soundFile, request->soundFile, sizeof(soundFile) - 1);
-    soundFile[sizeof(soundFile) - 1] = '\0';
+    AudioPlaybackRequest local = *request;
+    local.soundFile[sizeof(local.soundFile) - 1] = '\0';
     free(request);
-    if (InterlockedCompareExchange(
-            &g_audioPlaybackGeneration, 0, 0) != generation) return 0;
+    if (!IsRequestCurrent(&local)) return 0;
     AcquireSRWLockExclusive(&g_audioStateLock);
     BOOL ownedPlaybackAttempt = FALSE;
     BOOL playbackResult = FALSE;
-    if (InterlockedCompareExchange(
-            &g_audioPlaybackGeneration, 0, 0) == generation) {
+    if (IsRequestCurrent(&local)) {
         ownedPlaybackAttempt = TRUE;
         playbackResult = PlayNotificationSoundFileInternalLocked(
-            hwnd, soundFile, allowFinalBeepFallback);
+            local.hwnd, local.soundFile, local.priority, local.queuedAt);
         if (InterlockedCompareExchange(&g_audioDesiredPaused, 0, 0)) {
             PauseNotificationSoundLocked();
         }
     }
-    if (ownedPlaybackAttempt && InterlockedCompareExchange(
-            &g_audioPlaybackGeneration, 0, 0) != generation) {
-        CleanupAudioResourcesLocked();
+    /* A stop that arrived while the sound was loading wins */
+    if (ownedPlaybackAttempt && !IsRequestCurrent(&local)) {
+        if (InterlockedCompareExchange(
+                &g_audioPlaybackGeneration, 0, 0) != local.generation) {
+            CleanupAudioResourcesLocked();
+        } else {
+            StopPreviewVoicesLocked();
+        }
     }
     ReleaseSRWLockExclusive(&g_audioStateLock);
-    if (ownedPlaybackAttempt && !playbackResult && !allowFinalBeepFallback) {
+    if (ownedPlaybackAttempt && !playbackResult &&
+        local.priority == AUDIO_VOICE_PREVIEW) {
         AudioPlaybackCompleteCallback callback = NULL;
         AcquireSRWLockShared(&g_audioCallbackLock);
         callback = g_audioCompleteCallback;
         ReleaseSRWLockShared(&g_audioCallbackLock);
-        if (callback) callback(hwnd);
+        if (callback) callback(local.hwnd);
     }
     return 0;
 }
 
 static BOOL QueueAudioPlayback(
-    HWND hwnd, const char* soundFile, BOOL allowFinalBeepFallback) {
+    HWND hwnd, const char* soundFile, AudioVoicePriority priority) {
     if (!soundFile) return FALSE;
     InterlockedExchange(&g_audioDesiredPaused, 0);
     AudioPlaybackRequest* request = calloc(1, sizeof(*request));
@@ -141,8 +171,13 @@ static BOOL QueueAudioPlayback(
         return FALSE;
     }
     request->hwnd = hwnd;
-    request->generation = InterlockedIncrement(&g_audioPlaybackGeneration);
-    request->allowFinalBeepFallback = allowFinalBeepFallback;
+    request->queuedAt = GetAudioTimestampUs();
+    /* Requests no longer cancel each other; only a stop bumps these */
+    request->generation = InterlockedCompareExchange(
+        &g_audioPlaybackGeneration, 0, 0);
+    request->previewGeneration = InterlockedCompareExchange(
+        &g_audioPreviewGeneration, 0, 0);
+    request->priority = priority;
     strncpy(request->soundFile, soundFile,
             sizeof(request->soundFile) - 1);
     request->soundFile[sizeof(request->soundFile) - 1] = '\0';
@@ -160,16 +195,27 @@ static BOOL QueueAudioPlayback(
 }
 
 BOOL PlayNotificationSoundFile(HWND hwnd, const char* soundFile) {
-    return QueueAudioPlayback(hwnd, soundFile, TRUE);
+    return QueueAudioPlayback(hwnd, soundFile, AUDIO_VOICE_ALERT);
 }
 
 BOOL PreviewNotificationSoundFile(HWND hwnd, const char* soundFile) {
-    return QueueAudioPlayback(hwnd, soundFile, FALSE);
+    return QueueAudioPlayback(hwnd, soundFile, AUDIO_VOICE_PREVIEW);
 }
 
 BOOL PlayNotificationSound(HWND hwnd) {
-    const char* configuredFile =
-        g_AppConfig.notification.sound.sound_file;
-    if (configuredFile[0] == '\0') return TRUE;
-    return QueueAudioPlayback(hwnd, configuredFile, TRUE);
+    char configuredFile[MAX_PATH];
+    if (!GetConfiguredSoundFile(configuredFile, sizeof(configuredFile))) {
+        return TRUE;
+    }
+    return QueueAudioPlayback(hwnd, configuredFile, AUDIO_VOICE_ALERT);
+}
+
+void ShutdownAudioPlayer(void) {
+    InterlockedIncrement(&g_audioPlaybackGeneration);
+    AcquireSRWLockExclusive(&g_audioStateLock);
+    CleanupAudioResourcesLocked();
+    AudioMixer_CloseDevice();
+    StopAudioPollTimer();
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+    AudioPcmCache_Clear();
 }
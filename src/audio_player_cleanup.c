@@ -16,6 +16,31 @@ static DWORD WINAPI AudioCleanupThreadProc(LPVOID parameter) {
     return 0;
 }
 
+static DWORD WINAPI AudioPreviewCleanupThreadProc(LPVOID parameter) {
+    LONG generation = (LONG)(LONG_PTR)parameter;
+    AcquireSRWLockExclusive(&g_audioStateLock);
+    if (InterlockedCompareExchange(
+            &g_audioPreviewGeneration, 0, 0) == generation) {
+        StopPreviewVoicesLocked();
+    }
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+    return 0;
+}
+
+static BOOL QueueDeferredCleanup(
+    LPTHREAD_START_ROUTINE cleanup, LONG generation) {
+    HANDLE thread = CreateThread(
+        NULL, 0, cleanup, (LPVOID)(LONG_PTR)generation, 0, NULL);
+    if (!thread) {
+        LOG_WARNING(
+            "Failed to queue deferred audio cleanup (error=%lu)",
+            GetLastError());
+        return FALSE;
+    }
+    CloseHandle(thread);
+    return TRUE;
+}
+
 void CleanupAudioResources(void) {
     /* A tray click must remain responsive while a background worker is
      * opening an audio device. The generation change makes that worker clean
@@ -23,16 +48,7 @@ void CleanupAudioResources(void) {
     LONG generation = InterlockedIncrement(&g_audioPlaybackGeneration);
     InterlockedExchange(&g_audioDesiredPaused, 0);
     if (!TryAcquireSRWLockExclusive(&g_audioStateLock)) {
-        HANDLE thread = CreateThread(
-            NULL, 0, AudioCleanupThreadProc,
-            (LPVOID)(LONG_PTR)generation, 0, NULL);
-        if (thread) {
-            CloseHandle(thread);
-        } else {
-            LOG_WARNING(
-                "Failed to queue deferred audio cleanup (error=%lu)",
-                GetLastError());
-        }
+        QueueDeferredCleanup(AudioCleanupThreadProc, generation);
         return;
     }
     CleanupAudioResourcesLocked();
@@ -42,3 +58,13 @@ void CleanupAudioResources(void) {
 void StopNotificationSound(void) {
     CleanupAudioResources();
 }
+
+void StopPreviewNotificationSound(void) {
+    LONG generation = InterlockedIncrement(&g_audioPreviewGeneration);
+    if (!TryAcquireSRWLockExclusive(&g_audioStateLock)) {
+        QueueDeferredCleanup(AudioPreviewCleanupThreadProc, generation);
+        return;
+    }
+    StopPreviewVoicesLocked();
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+}
@@ -26,74 +26,139 @@
 #include <string.h>
 #include <strsafe.h>
 
-#define TIMER_INTERVAL_AUDIO_CHECK 500
+#define TIMER_INTERVAL_AUDIO_CHECK 250
 #define TIMER_INTERVAL_FALLBACK 3000
 #define TIMER_INTERVAL_BEEP 500
 #define AUDIO_TIMER_ID_BASE ((UINT_PTR)0xA7000000u)
 #define AUDIO_TIMER_ID_MASK 0xFFFFu
 #define MAX_NOTIFICATION_AUDIO_BYTES (64ull * 1024ull * 1024ull)
+#define AUDIO_PCM_CACHE_SLOTS 4
+/* A prewarmed device stays open until the deadline plus this grace */
+#define AUDIO_WARM_DEVICE_GRACE_MS 5000u
 
+/* Every sound is converted to the mixer format once, when it is decoded,
+ * so the callback only sums 16-bit stereo frames */
+#define AUDIO_MIXER_VOICES 4
+#define AUDIO_MIXER_CHANNELS 2
+#define AUDIO_MIXER_SAMPLE_RATE 48000u
+#define AUDIO_MIXER_CHUNK_FRAMES 256u
+#define AUDIO_MIXER_FADE_IN_MS 5u
+#define AUDIO_MIXER_FADE_OUT_MS 30u
+/* The shared device stays open this long after the last voice ends */
+#define AUDIO_MIXER_IDLE_CLOSE_MS 30000u
+
+typedef enum {
+    AUDIO_FALLBACK_NONE = 0,
+    AUDIO_FALLBACK_PLAYSOUND,
+    AUDIO_FALLBACK_BEEP
+} AudioFallbackKind;
+
+/** @brief Alerts outrank previews when voices run out */
 typedef enum {
-    AUDIO_TIMER_NONE = 0,
-    AUDIO_TIMER_MINIAUDIO,
-    AUDIO_TIMER_PLAYSOUND,
-    AUDIO_TIMER_BEEP
-} AudioTimerKind;
+    AUDIO_VOICE_PREVIEW = 0,
+    AUDIO_VOICE_ALERT
+} AudioVoicePriority;
 
 typedef struct {
     wchar_t path[MAX_PATH * 2];
     ULONGLONG sizeBytes;
+    FILETIME lastWriteTime;
 } AudioFileInfo;
 
+/* Concrete WAV/MP3 decoders only exist in the miniaudio implementation
+ * unit, so everything else sees an opaque handle */
+typedef struct AudioTypedDecoder AudioTypedDecoder;
+
+/** @brief Fully decoded sound in the mixer format, shared by refcount */
+typedef struct {
+    volatile LONG refCount;
+    wchar_t path[MAX_PATH * 2];
+    ULONGLONG sizeBytes;
+    FILETIME lastWriteTime;
+    ma_uint64 frameCount;
+    size_t byteCount;
+    ma_int16* frames;
+} AudioPcmClip;
+
 typedef struct {
     HWND hwnd;
     char soundFile[MAX_PATH];
     LONG generation;
-    BOOL allowFinalBeepFallback;
+    LONG previewGeneration;
+    AudioVoicePriority priority;
+    LONGLONG queuedAt;
 } AudioPlaybackRequest;
 
 extern ma_device g_device;
-extern ma_bool32 g_decoderInitialized;
 extern ma_bool32 g_deviceInitialized;
-extern volatile LONG g_decoderAtEnd;
-extern volatile LONG g_decoderDrainDeadline;
-extern volatile LONG g_decoderDrainRemainingMs;
-extern volatile LONG g_decoderPaused;
-extern ma_bool32 g_isPlaying;
 extern ma_bool32 g_isPaused;
 extern AudioPlaybackCompleteCallback g_audioCompleteCallback;
 extern HWND g_audioCallbackHwnd;
 extern UINT_PTR g_audioTimerId;
-extern AudioTimerKind g_audioTimerKind;
 extern HWND g_audioTimerHwnd;
+extern AudioFallbackKind g_audioFallbackKind;
+extern HWND g_audioFallbackOwner;
+extern DWORD g_audioFallbackEndTick;
 extern volatile LONG g_audioTimerSerial;
 extern volatile LONG g_audioPlaybackGeneration;
+extern volatile LONG g_audioPreviewGeneration;
 extern volatile LONG g_audioDesiredVolume;
 extern volatile LONG g_audioDesiredPaused;
 extern SRWLOCK g_audioStateLock;
 extern SRWLOCK g_audioCallbackLock;
+extern volatile LONG g_audioLastStartLatencyUs;
 
 BOOL IsCurrentProcessAudioWindow(HWND hwnd);
+BOOL GetConfiguredSoundFile(char* soundFile, size_t soundFileSize);
+int GetConfiguredSoundVolume(void);
 BOOL GetWideCharPath(
     const char* utf8Path, wchar_t* widePath, size_t widePathSize);
 BOOL GetAudioFileInfo(const char* filePath, AudioFileInfo* info);
 BOOL IsAudioFileSizeAllowed(const char* filePath, ULONGLONG fileSize);
 BOOL IsValidFilePath(const char* filePath);
 void ResetPlaybackState(void);
-BOOL StartPlaybackTimer(HWND hwnd, AudioTimerKind timerKind, UINT interval);
+BOOL EnsureAudioPollTimer(HWND hwnd, BOOL preferThisWindow);
+void StopAudioPollTimer(void);
 BOOL FallbackToPlaySound(HWND hwnd, const wchar_t* wideFilePath);
 BOOL FallbackToSystemBeep(HWND hwnd);
-void CleanupMiniaudioObjects(void);
-void CleanupMiniaudioAttempt(void);
-ma_result LoadAudioFileWide(const wchar_t* wideFilePath);
 DWORD CalculateAudioDrainDelayMs(
     const ma_device* device, ma_uint32 callbackFrameCount);
-ma_result StartAudioPlayback(void);
 BOOL PlayAudioWithMiniaudio(
-    HWND hwnd, const char* filePath, const wchar_t* wideFilePath);
+    HWND hwnd, const AudioFileInfo* fileInfo,
+    AudioVoicePriority priority, LONGLONG queuedAt);
+LONGLONG GetAudioTimestampUs(void);
+
+AudioTypedDecoder* AudioTypedDecoder_OpenFileWide(
+    const wchar_t* path, ma_format format, ma_uint32 channels,
+    ma_uint32 sampleRate, ma_result* result);
+ma_result AudioTypedDecoder_Read(
+    AudioTypedDecoder* decoder, void* output,
+    ma_uint64 frameCount, ma_uint64* framesRead);
+ma_uint64 AudioTypedDecoder_GetLength(AudioTypedDecoder* decoder);
+void AudioTypedDecoder_Close(AudioTypedDecoder* decoder);
+
+AudioPcmClip* AudioPcmCache_Acquire(const AudioFileInfo* fileInfo);
+void AudioPcmCache_Release(AudioPcmClip* clip);
+void AudioPcmCache_Clear(void);
+size_t AudioPcmCache_GetTotalBytes(void);
+
+/* Mixer calls require g_audioStateLock */
+ma_result AudioMixer_OpenDevice(void);
+void AudioMixer_CloseDevice(void);
+ma_result AudioMixer_StartVoice(
+    HWND owner, AudioVoicePriority priority,
+    const AudioFileInfo* fileInfo, LONGLONG queuedAt);
+void AudioMixer_StopVoices(BOOL previewsOnly, BOOL immediate);
+int AudioMixer_ReapVoices(HWND* finishedOwners, int capacity);
+int AudioMixer_GetActiveVoiceCount(void);
+void AudioMixer_SetPaused(BOOL paused);
+void AudioMixer_KeepDeviceOpen(DWORD durationMs);
+BOOL AudioMixer_IsIdleExpired(void);
+
 void CALLBACK AudioTimerCallback(
     HWND hwnd, UINT message, UINT_PTR idEvent, DWORD time);
 void CleanupAudioResourcesLocked(void);
+void StopPreviewVoicesLocked(void);
 BOOL PauseNotificationSoundLocked(void);
 BOOL ResumeNotificationSoundLocked(void);
 
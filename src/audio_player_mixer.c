@@ -0,0 +1,242 @@
+/**
+ * @file audio_player_mixer.c
+ * @brief Voices summed into one shared playback device
+ *
+ * The device is opened once and kept running while any voice plays and
+ * for AUDIO_MIXER_IDLE_CLOSE_MS afterwards, so starting or stopping a
+ * sound never reinitializes it. Control code changes voices under a short
+ * exclusive g_mixLock that only moves fields: clips and decoders of retired
+ * voices are freed after the lock drops, and read-only queries take the
+ * shared side, so the callback never waits behind file or cache work.
+ */
+
+#include "audio_player_mixer_internal.h"
+
+AudioMixerVoice g_voices[AUDIO_MIXER_VOICES];
+SRWLOCK g_mixLock = SRWLOCK_INIT;
+volatile LONG g_mixerPaused = 0;
+static LONG g_voiceSerial = 0;
+static DWORD g_mixerIdleDeadline = 0;
+
+/* Detaches the voice's clip and decoder so they are freed outside the lock */
+static void RetireVoiceLocked(AudioMixerVoice* voice,
+                              AudioMixerVoice* retired, int* retiredCount) {
+    retired[(*retiredCount)++] = *voice;
+    ZeroMemory(voice, sizeof(*voice));
+}
+
+static void FreeRetiredVoices(AudioMixerVoice* retired, int retiredCount) {
+    for (int i = 0; i < retiredCount; ++i) {
+        AudioPcmCache_Release(retired[i].clip);
+        AudioTypedDecoder_Close(retired[i].stream);
+    }
+}
+
+static BOOL IsReapableVoice(const AudioMixerVoice* voice, DWORD now) {
+    return voice->state == AUDIO_VOICE_FINISHED &&
+           (voice->drainDeadline == 0 ||
+            (LONG)(now - voice->drainDeadline) >= 0);
+}
+
+static void ApplyDesiredVolume(void) {
+    LONG desiredVolume = InterlockedCompareExchange(
+        &g_audioDesiredVolume, 0, 0);
+    if (desiredVolume < 0 || desiredVolume > 100) {
+        desiredVolume = GetConfiguredSoundVolume();
+    }
+    ma_device_set_master_volume(
+        &g_device, (float)desiredVolume / 100.0f);
+}
+
+ma_result AudioMixer_OpenDevice(void) {
+    if (g_deviceInitialized) return MA_SUCCESS;
+    ma_device_config deviceConfig =
+        ma_device_config_init(ma_device_type_playback);
+    deviceConfig.playback.format = ma_format_s16;
+    deviceConfig.playback.channels = AUDIO_MIXER_CHANNELS;
+    deviceConfig.sampleRate = AUDIO_MIXER_SAMPLE_RATE;
+    deviceConfig.dataCallback = AudioMixerCallback;
+    ma_result result = ma_device_init(NULL, &deviceConfig, &g_device);
+    if (result != MA_SUCCESS) return result;
+    g_deviceInitialized = MA_TRUE;
+    ApplyDesiredVolume();
+    result = ma_device_start(&g_device);
+    if (result != MA_SUCCESS) {
+        ma_device_uninit(&g_device);
+        g_deviceInitialized = MA_FALSE;
+        return result;
+    }
+    AudioMixer_KeepDeviceOpen(AUDIO_MIXER_IDLE_CLOSE_MS);
+    return MA_SUCCESS;
+}
+
+void AudioMixer_CloseDevice(void) {
+    if (g_deviceInitialized) {
+        ma_device_uninit(&g_device);
+        g_deviceInitialized = MA_FALSE;
+    }
+    AudioMixerVoice retired[AUDIO_MIXER_VOICES];
+    int retiredCount = 0;
+    AcquireSRWLockExclusive(&g_mixLock);
+    for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+        RetireVoiceLocked(&g_voices[i], retired, &retiredCount);
+    }
+    ReleaseSRWLockExclusive(&g_mixLock);
+    FreeRetiredVoices(retired, retiredCount);
+    g_mixerIdleDeadline = 0;
+    InterlockedExchange(&g_mixerPaused, 0);
+}
+
+/* Free slots first, then voices that already ended, then the
+ * lowest-priority, oldest voice that does not outrank the newcomer */
+static AudioMixerVoice* ClaimVoiceLocked(AudioVoicePriority priority,
+                                         AudioMixerVoice* retired,
+                                         int* retiredCount) {
+    AudioMixerVoice* victim = NULL;
+    for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+        AudioMixerVoice* voice = &g_voices[i];
+        if (voice->state == AUDIO_VOICE_FREE) return voice;
+        if (voice->state == AUDIO_VOICE_FINISHED) {
+            RetireVoiceLocked(voice, retired, retiredCount);
+            return voice;
+        }
+        if (voice->priority > priority) continue;
+        if (!victim || voice->priority < victim->priority ||
+            (voice->priority == victim->priority &&
+             voice->startSerial - victim->startSerial < 0)) {
+            victim = voice;
+        }
+    }
+    if (victim) RetireVoiceLocked(victim, retired, retiredCount);
+    return victim;
+}
+
+ma_result AudioMixer_StartVoice(
+    HWND owner, AudioVoicePriority priority,
+    const AudioFileInfo* fileInfo, LONGLONG queuedAt) {
+    if (!fileInfo) return MA_INVALID_ARGS;
+    /* Sounds the cache declines stream through a converting decoder */
+    AudioPcmClip* clip = AudioPcmCache_Acquire(fileInfo);
+    AudioTypedDecoder* stream = NULL;
+    ma_result result = MA_SUCCESS;
+    if (!clip) {
+        stream = AudioTypedDecoder_OpenFileWide(
+            fileInfo->path, ma_format_s16, AUDIO_MIXER_CHANNELS,
+            AUDIO_MIXER_SAMPLE_RATE, &result);
+        if (!stream) return result;
+    }
+    result = AudioMixer_OpenDevice();
+    AudioMixerVoice retired[1];
+    int retiredCount = 0;
+    AcquireSRWLockExclusive(&g_mixLock);
+    AudioMixerVoice* voice = result == MA_SUCCESS ?
+        ClaimVoiceLocked(priority, retired, &retiredCount) : NULL;
+    if (voice) {
+        voice->priority = priority;
+        voice->owner = owner;
+        voice->notifyOwner = TRUE;
+        voice->startSerial = ++g_voiceSerial;
+        voice->queuedAt = queuedAt;
+        voice->clip = clip;
+        voice->stream = stream;
+        voice->targetGain = PCM_MIX_UNITY_GAIN;
+        voice->state = AUDIO_VOICE_PLAYING;
+    } else if (result == MA_SUCCESS) {
+        LOG_INFO("All notification voices are busy with higher-priority sounds");
+        result = MA_NO_SPACE;
+    }
+    ReleaseSRWLockExclusive(&g_mixLock);
+    FreeRetiredVoices(retired, retiredCount);
+    if (!voice) {
+        AudioPcmCache_Release(clip);
+        AudioTypedDecoder_Close(stream);
+    }
+    return result;
+}
+
+void AudioMixer_StopVoices(BOOL previewsOnly, BOOL immediate) {
+    AudioMixerVoice retired[AUDIO_MIXER_VOICES];
+    int retiredCount = 0;
+    AcquireSRWLockExclusive(&g_mixLock);
+    for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+        AudioMixerVoice* voice = &g_voices[i];
+        if (voice->state == AUDIO_VOICE_FREE ||
+            (previewsOnly && voice->priority != AUDIO_VOICE_PREVIEW)) {
+            continue;
+        }
+        if (immediate || voice->state == AUDIO_VOICE_FINISHED) {
+            RetireVoiceLocked(voice, retired, &retiredCount);
+            continue;
+        }
+        voice->notifyOwner = FALSE;
+        voice->targetGain = 0;
+        voice->state = AUDIO_VOICE_STOPPING;
+    }
+    ReleaseSRWLockExclusive(&g_mixLock);
+    FreeRetiredVoices(retired, retiredCount);
+}
+
+/* Polled while sounds play: the shared side suffices to see that nothing
+ * has drained yet, so the exclusive lock is taken only to retire voices */
+static BOOL HasReapableVoice(DWORD now) {
+    BOOL found = FALSE;
+    AcquireSRWLockShared(&g_mixLock);
+    for (int i = 0; i < AUDIO_MIXER_VOICES && !found; ++i) {
+        found = IsReapableVoice(&g_voices[i], now);
+    }
+    ReleaseSRWLockShared(&g_mixLock);
+    return found;
+}
+
+int AudioMixer_ReapVoices(HWND* finishedOwners, int capacity) {
+    int count = 0;
+    DWORD now = GetTickCount();
+    if (HasReapableVoice(now)) {
+        AudioMixerVoice retired[AUDIO_MIXER_VOICES];
+        int retiredCount = 0;
+        AcquireSRWLockExclusive(&g_mixLock);
+        for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+            AudioMixerVoice* voice = &g_voices[i];
+            if (!IsReapableVoice(voice, now)) continue;
+            if (voice->notifyOwner && count < capacity) {
+                finishedOwners[count++] = voice->owner;
+            }
+            RetireVoiceLocked(voice, retired, &retiredCount);
+        }
+        ReleaseSRWLockExclusive(&g_mixLock);
+        FreeRetiredVoices(retired, retiredCount);
+    }
+    if (AudioMixer_GetActiveVoiceCount() > 0) {
+        AudioMixer_KeepDeviceOpen(AUDIO_MIXER_IDLE_CLOSE_MS);
+    }
+    return count;
+}
+
+int AudioMixer_GetActiveVoiceCount(void) {
+    int count = 0;
+    /* Only exclusive holders free a voice, so FREE is stable here */
+    AcquireSRWLockShared(&g_mixLock);
+    for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+        if (g_voices[i].state != AUDIO_VOICE_FREE) count++;
+    }
+    ReleaseSRWLockShared(&g_mixLock);
+    return count;
+}
+
+void AudioMixer_SetPaused(BOOL paused) {
+    InterlockedExchange(&g_mixerPaused, paused ? 1 : 0);
+}
+
+void AudioMixer_KeepDeviceOpen(DWORD durationMs) {
+    DWORD deadline = GetTickCount() + durationMs;
+    if (deadline == 0) deadline = 1;
+    if (g_mixerIdleDeadline == 0 ||
+        (LONG)(deadline - g_mixerIdleDeadline) > 0) {
+        g_mixerIdleDeadline = deadline;
+    }
+}
+
+BOOL AudioMixer_IsIdleExpired(void) {
+    return g_mixerIdleDeadline == 0 ||
+           (LONG)(GetTickCount() - g_mixerIdleDeadline) >= 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file audio_player_mixer_internal.h
+ * @brief Voice table shared by the mixer control code and its callback
+ */
+
+#ifndef AUDIO_PLAYER_MIXER_INTERNAL_H
+#define AUDIO_PLAYER_MIXER_INTERNAL_H
+
+#include "audio_player_internal.h"
+#include "utils/pcm_mix.h"
+
+typedef enum {
+    AUDIO_VOICE_FREE = 0,
+    AUDIO_VOICE_PLAYING,
+    AUDIO_VOICE_STOPPING,
+    AUDIO_VOICE_FINISHED
+} AudioVoiceState;
+
+/* The callback only reads voices that are PLAYING or STOPPING and is the
+ * only writer of cursor, gain, queuedAt and the transition to FINISHED */
+typedef struct {
+    AudioVoiceState state;
+    AudioVoicePriority priority;
+    HWND owner;
+    BOOL notifyOwner;
+    LONG startSerial;
+    LONGLONG queuedAt;
+    AudioPcmClip* clip;
+    AudioTypedDecoder* stream;
+    ma_uint64 cursor;
+    int32_t gain;
+    int32_t targetGain;
+    DWORD drainDeadline;
+} AudioMixerVoice;
+
+extern AudioMixerVoice g_voices[AUDIO_MIXER_VOICES];
+extern SRWLOCK g_mixLock;
+extern volatile LONG g_mixerPaused;
+
+void AudioMixerCallback(
+    ma_device* device, void* output, const void* input, ma_uint32 frameCount);
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file audio_player_mixer_render.c
+ * @brief Real-time mixing of active voices into the device buffer
+ */
+
+#include "audio_player_mixer_internal.h"
+
+static int32_t g_mixAccum[AUDIO_MIXER_CHUNK_FRAMES * AUDIO_MIXER_CHANNELS];
+static ma_int16 g_mixScratch[AUDIO_MIXER_CHUNK_FRAMES * AUDIO_MIXER_CHANNELS];
+
+DWORD CalculateAudioDrainDelayMs(
+    const ma_device* device, ma_uint32 callbackFrameCount) {
+    if (!device) return 500;
+    ma_uint64 internalFrames =
+        (ma_uint64)device->playback.internalPeriodSizeInFrames *
+        device->playback.internalPeriods;
+    if (internalFrames > INT_MAX) internalFrames = INT_MAX;
+    DWORD delay = 50;
+    if (device->playback.internalSampleRate > 0) {
+        delay += (DWORD)MulDiv(
+            (int)internalFrames, 1000,
+            (int)device->playback.internalSampleRate);
+    }
+    if (device->sampleRate > 0 && callbackFrameCount <= INT_MAX) {
+        delay += (DWORD)MulDiv(
+            (int)callbackFrameCount, 1000,
+            (int)device->sampleRate);
+    }
+    if (delay < 100) delay = 100;
+    if (delay > 2000) delay = 2000;
+    return delay;
+}
+
+static void RecordStartLatency(AudioMixerVoice* voice) {
+    if (voice->queuedAt <= 0) return;
+    LONGLONG latency = GetAudioTimestampUs() - voice->queuedAt;
+    voice->queuedAt = 0;
+    if (latency < 0) latency = 0;
+    if (latency > LONG_MAX) latency = LONG_MAX;
+    InterlockedExchange(&g_audioLastStartLatencyUs, (LONG)latency);
+}
+
+/* Cached clips are mixed in place; streams decode into the scratch buffer */
+static const ma_int16* ReadVoiceFrames(
+    AudioMixerVoice* voice, ma_uint32 frameCount, ma_uint64* framesRead) {
+    if (voice->clip) {
+        ma_uint64 available = voice->clip->frameCount - voice->cursor;
+        *framesRead = frameCount < available ? frameCount : available;
+        const ma_int16* frames =
+            voice->clip->frames + voice->cursor * AUDIO_MIXER_CHANNELS;
+        voice->cursor += *framesRead;
+        return frames;
+    }
+    if (AudioTypedDecoder_Read(voice->stream, g_mixScratch, frameCount,
+                               framesRead) != MA_SUCCESS) {
+        *framesRead = 0;
+    }
+    return g_mixScratch;
+}
+
+static void MixVoice(AudioMixerVoice* voice, ma_uint32 frameCount,
+                     DWORD drainDelayMs) {
+    RecordStartLatency(voice);
+    ma_uint64 framesRead = 0;
+    const ma_int16* frames = ReadVoiceFrames(voice, frameCount, &framesRead);
+    uint32_t fadeMs = voice->targetGain > voice->gain ?
+        AUDIO_MIXER_FADE_IN_MS : AUDIO_MIXER_FADE_OUT_MS;
+    int32_t to = PcmMix_StepGain(
+        voice->gain, voice->targetGain,
+        PcmMix_FadeDelta(frameCount, AUDIO_MIXER_SAMPLE_RATE * fadeMs / 1000u));
+    PcmMix_Accumulate(g_mixAccum, frames, (size_t)framesRead,
+                      AUDIO_MIXER_CHANNELS, voice->gain, to);
+    voice->gain = to;
+    if (framesRead < frameCount) {
+        DWORD deadline = GetTickCount() + drainDelayMs;
+        voice->drainDeadline = deadline ? deadline : 1;
+        voice->state = AUDIO_VOICE_FINISHED;
+    } else if (voice->state == AUDIO_VOICE_STOPPING && to == 0) {
+        voice->drainDeadline = 0;
+        voice->state = AUDIO_VOICE_FINISHED;
+    }
+}
+
+void AudioMixerCallback(
+    ma_device* device, void* output, const void* input, ma_uint32 frameCount) {
+    (void)input;
+    ma_int16* out = output;
+    if (InterlockedCompareExchange(&g_mixerPaused, 0, 0)) {
+        ma_silence_pcm_frames(output, frameCount, ma_format_s16,
+                              AUDIO_MIXER_CHANNELS);
+        return;
+    }
+    /* Exclusive holders only move voice fields and free nothing inside the
+     * lock, so waiting here is bounded; dropping the period instead would cut
+     * an unfaded gap into every voice that is playing */
+    AcquireSRWLockShared(&g_mixLock);
+    DWORD drainDelayMs = CalculateAudioDrainDelayMs(device, frameCount);
+    while (frameCount > 0) {
+        ma_uint32 chunk = frameCount < AUDIO_MIXER_CHUNK_FRAMES ?
+            frameCount : AUDIO_MIXER_CHUNK_FRAMES;
+        ZeroMemory(g_mixAccum, sizeof(g_mixAccum));
+        for (int i = 0; i < AUDIO_MIXER_VOICES; ++i) {
+            AudioMixerVoice* voice = &g_voices[i];
+            if (voice->state == AUDIO_VOICE_PLAYING ||
+                voice->state == AUDIO_VOICE_STOPPING) {
+                MixVoice(voice, chunk, drainDelayMs);
+            }
+        }
+        PcmMix_Resolve(out, g_mixAccum, (size_t)chunk * AUDIO_MIXER_CHANNELS);
+        out += (size_t)chunk * AUDIO_MIXER_CHANNELS;
+        frameCount -= chunk;
+    }
+    ReleaseSRWLockShared(&g_mixLock);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file audio_player_pcm_cache.c
+ * @brief Decoded notification sounds kept in memory for instant playback
+ *
+ * Clips are keyed by path and validated against file size and last-write
+ * time, so editing or replacing a sound file invalidates its entry on the
+ * next lookup. Decoded bytes across all entries stay within
+ * MAX_NOTIFICATION_AUDIO_BYTES; least recently used clips are dropped to
+ * make room. A single clip is capped at AUDIO_PCM_MAX_CLIP_BYTES, and a
+ * file that exceeds it is remembered as stream-only until it changes, so
+ * the decode is not attempted again on every play. Clips are stored already converted to the mixer format and
+ * are refcounted because a voice may still be reading one that the cache
+ * has already evicted.
+ */
+
+#include "audio_player_internal.h"
+
+#define AUDIO_PCM_DECODE_CHUNK_FRAMES 4096u
+/* About 87 seconds of mixer-format audio; longer sounds stream */
+#define AUDIO_PCM_MAX_CLIP_BYTES (MAX_NOTIFICATION_AUDIO_BYTES / 4u)
+#define AUDIO_PCM_STREAM_ONLY_ENTRIES 8
+
+typedef struct {
+    AudioPcmClip* clip;
+    ULONGLONG lastUse;
+} AudioPcmCacheSlot;
+
+static AudioPcmCacheSlot g_pcmCacheSlots[AUDIO_PCM_CACHE_SLOTS];
+static size_t g_pcmCacheBytes = 0;
+static ULONGLONG g_pcmCacheClock = 0;
+static SRWLOCK g_pcmCacheLock = SRWLOCK_INIT;
+static AudioFileInfo g_pcmStreamOnly[AUDIO_PCM_STREAM_ONLY_ENTRIES];
+static int g_pcmStreamOnlyNext = 0;
+
+static void FreeClip(AudioPcmClip* clip) {
+    if (!clip) return;
+    free(clip->frames);
+    free(clip);
+}
+
+void AudioPcmCache_Release(AudioPcmClip* clip) {
+    if (clip && InterlockedDecrement(&clip->refCount) == 0) FreeClip(clip);
+}
+
+static BOOL ClipMatchesFile(const AudioPcmClip* clip, const AudioFileInfo* info) {
+    return clip->sizeBytes == info->sizeBytes &&
+           CompareFileTime(&clip->lastWriteTime, &info->lastWriteTime) == 0;
+}
+
+/* A stale entry for the same path is forgotten as a side effect */
+static BOOL IsStreamOnlyLocked(const AudioFileInfo* info) {
+    for (int i = 0; i < AUDIO_PCM_STREAM_ONLY_ENTRIES; ++i) {
+        AudioFileInfo* entry = &g_pcmStreamOnly[i];
+        if (entry->path[0] == L'\0' || _wcsicmp(entry->path, info->path) != 0) continue;
+        if (entry->sizeBytes == info->sizeBytes &&
+            CompareFileTime(&entry->lastWriteTime, &info->lastWriteTime) == 0) {
+            return TRUE;
+        }
+        entry->path[0] = L'\0';
+        return FALSE;
+    }
+    return FALSE;
+}
+
+static void MarkStreamOnlyLocked(const AudioFileInfo* info) {
+    if (IsStreamOnlyLocked(info)) return;
+    g_pcmStreamOnly[g_pcmStreamOnlyNext] = *info;
+    g_pcmStreamOnlyNext = (g_pcmStreamOnlyNext + 1) % AUDIO_PCM_STREAM_ONLY_ENTRIES;
+}
+
+static void EvictSlotLocked(AudioPcmCacheSlot* slot) {
+    if (!slot->clip) return;
+    g_pcmCacheBytes -= slot->clip->byteCount;
+    AudioPcmCache_Release(slot->clip);
+    slot->clip = NULL;
+    slot->lastUse = 0;
+}
+
+/* Stale entries for the same path are evicted as a side effect */
+static AudioPcmClip* FindClipLocked(const AudioFileInfo* info) {
+    for (int i = 0; i < AUDIO_PCM_CACHE_SLOTS; ++i) {
+        AudioPcmCacheSlot* slot = &g_pcmCacheSlots[i];
+        if (!slot->clip || _wcsicmp(slot->clip->path, info->path) != 0) continue;
+        if (!ClipMatchesFile(slot->clip, info)) {
+            EvictSlotLocked(slot);
+            return NULL;
+        }
+        slot->lastUse = ++g_pcmCacheClock;
+        InterlockedIncrement(&slot->clip->refCount);
+        return slot->clip;
+    }
+    return NULL;
+}
+
+#define AUDIO_PCM_BYTES_PER_FRAME (AUDIO_MIXER_CHANNELS * sizeof(ma_int16))
+#define AUDIO_PCM_MAX_CLIP_FRAMES (AUDIO_PCM_MAX_CLIP_BYTES / AUDIO_PCM_BYTES_PER_FRAME)
+
+static BOOL GrowFrames(AudioPcmClip* clip, ma_uint64 frameCapacity) {
+    ma_uint64 bytes = frameCapacity * AUDIO_PCM_BYTES_PER_FRAME;
+    if (bytes > AUDIO_PCM_MAX_CLIP_BYTES) return FALSE;
+    ma_int16* frames = realloc(clip->frames, (size_t)bytes);
+    if (!frames) return FALSE;
+    clip->frames = frames;
+    return TRUE;
+}
+
+/* *outTooLarge is set when the sound exceeds the per-clip cap */
+static AudioPcmClip* DecodeClip(const AudioFileInfo* info, BOOL* outTooLarge) {
+    *outTooLarge = FALSE;
+    AudioTypedDecoder* decoder = AudioTypedDecoder_OpenFileWide(
+        info->path, ma_format_s16, AUDIO_MIXER_CHANNELS,
+        AUDIO_MIXER_SAMPLE_RATE, NULL);
+    if (!decoder) return NULL;
+
+    /* MP3 lengths may be unknown up front; grow by chunks in that case */
+    ma_uint64 capacity = AudioTypedDecoder_GetLength(decoder);
+    if (capacity > AUDIO_PCM_MAX_CLIP_FRAMES) {
+        AudioTypedDecoder_Close(decoder);
+        *outTooLarge = TRUE;
+        LOG_INFO("Notification sound exceeds the PCM clip limit; it will stream");
+        return NULL;
+    }
+    if (capacity == 0) capacity = AUDIO_PCM_DECODE_CHUNK_FRAMES;
+    AudioPcmClip* clip = calloc(1, sizeof(*clip));
+    BOOL ok = clip && GrowFrames(clip, capacity);
+    while (ok) {
+        if (clip->frameCount == capacity) {
+            if (capacity >= AUDIO_PCM_MAX_CLIP_FRAMES) {
+                *outTooLarge = TRUE;
+                ok = FALSE;
+                break;
+            }
+            capacity += capacity / 2 + AUDIO_PCM_DECODE_CHUNK_FRAMES;
+            if (capacity > AUDIO_PCM_MAX_CLIP_FRAMES) capacity = AUDIO_PCM_MAX_CLIP_FRAMES;
+            ok = GrowFrames(clip, capacity);
+            if (!ok) break;
+        }
+        ma_uint64 framesRead = 0;
+        ma_result result = AudioTypedDecoder_Read(
+            decoder, clip->frames + clip->frameCount * AUDIO_MIXER_CHANNELS,
+            capacity - clip->frameCount, &framesRead);
+        clip->frameCount += framesRead;
+        if (result != MA_SUCCESS || framesRead == 0) break;
+    }
+    AudioTypedDecoder_Close(decoder);
+
+    if (!ok || !clip || clip->frameCount == 0) {
+        if (*outTooLarge) {
+            LOG_INFO("Notification sound exceeds the PCM clip limit; it will stream");
+        }
+        FreeClip(clip);
+        return NULL;
+    }
+    clip->byteCount = (size_t)(clip->frameCount * AUDIO_PCM_BYTES_PER_FRAME);
+    clip->refCount = 1;
+    clip->sizeBytes = info->sizeBytes;
+    clip->lastWriteTime = info->lastWriteTime;
+    wcsncpy_s(clip->path, _countof(clip->path), info->path, _TRUNCATE);
+    return clip;
+}
+
+static AudioPcmCacheSlot* MakeRoomLocked(size_t bytes) {
+    for (;;) {
+        AudioPcmCacheSlot* empty = NULL;
+        AudioPcmCacheSlot* oldest = NULL;
+        for (int i = 0; i < AUDIO_PCM_CACHE_SLOTS; ++i) {
+            AudioPcmCacheSlot* slot = &g_pcmCacheSlots[i];
+            if (!slot->clip) {
+                if (!empty) empty = slot;
+            } else if (!oldest || slot->lastUse < oldest->lastUse) {
+                oldest = slot;
+            }
+        }
+        if (empty && g_pcmCacheBytes + bytes <= MAX_NOTIFICATION_AUDIO_BYTES) {
+            return empty;
+        }
+        if (!oldest) return NULL;
+        EvictSlotLocked(oldest);
+    }
+}
+
+AudioPcmClip* AudioPcmCache_Acquire(const AudioFileInfo* fileInfo) {
+    if (!fileInfo || fileInfo->path[0] == L'\0') return NULL;
+    AcquireSRWLockExclusive(&g_pcmCacheLock);
+    AudioPcmClip* clip = FindClipLocked(fileInfo);
+    BOOL streamOnly = !clip && IsStreamOnlyLocked(fileInfo);
+    ReleaseSRWLockExclusive(&g_pcmCacheLock);
+    if (clip || streamOnly) return clip;
+
+    /* Decode outside the lock; a concurrent decode of the same file wins
+     * the slot and the loser's copy is dropped */
+    BOOL tooLarge = FALSE;
+    AudioPcmClip* decoded = DecodeClip(fileInfo, &tooLarge);
+    if (!decoded) {
+        if (tooLarge) {
+            AcquireSRWLockExclusive(&g_pcmCacheLock);
+            MarkStreamOnlyLocked(fileInfo);
+            ReleaseSRWLockExclusive(&g_pcmCacheLock);
+        }
+        return NULL;
+    }
+
+    AcquireSRWLockExclusive(&g_pcmCacheLock);
+    clip = FindClipLocked(fileInfo);
+    if (!clip) {
+        AudioPcmCacheSlot* slot = MakeRoomLocked(decoded->byteCount);
+        if (slot) {
+            slot->clip = decoded;
+            slot->lastUse = ++g_pcmCacheClock;
+            g_pcmCacheBytes += decoded->byteCount;
+            InterlockedIncrement(&decoded->refCount);
+        }
+        clip = decoded;
+        decoded = NULL;
+    }
+    ReleaseSRWLockExclusive(&g_pcmCacheLock);
+    AudioPcmCache_Release(decoded);
+    return clip;
+}
+
+void AudioPcmCache_Clear(void) {
+    AcquireSRWLockExclusive(&g_pcmCacheLock);
+    for (int i = 0; i < AUDIO_PCM_CACHE_SLOTS; ++i) {
+        EvictSlotLocked(&g_pcmCacheSlots[i]);
+    }
+    ZeroMemory(g_pcmStreamOnly, sizeof(g_pcmStreamOnly));
+    g_pcmStreamOnlyNext = 0;
+    ReleaseSRWLockExclusive(&g_pcmCacheLock);
+}
+
+size_t AudioPcmCache_GetTotalBytes(void) {
+    AcquireSRWLockShared(&g_pcmCacheLock);
+    size_t bytes = g_pcmCacheBytes;
+    ReleaseSRWLockShared(&g_pcmCacheLock);
+    return bytes;
+}
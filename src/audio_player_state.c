@@ -1,4 +1,5 @@
 #include "audio_player_internal.h"
+#include "config/config_published.h"
 
 BOOL IsCurrentProcessAudioWindow(HWND hwnd) {
     if (!hwnd || !IsWindow(hwnd)) return FALSE;
@@ -7,6 +8,34 @@ BOOL IsCurrentProcessAudioWindow(HWND hwnd) {
     return processId == GetCurrentProcessId();
 }
 
+LONGLONG GetAudioTimestampUs(void) {
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    if (frequency.QuadPart == 0) return (LONGLONG)GetTickCount64() * 1000;
+    return (LONGLONG)((double)counter.QuadPart * 1000000.0 /
+                      (double)frequency.QuadPart);
+}
+
+/* Read from the published snapshot so worker threads never see a sound
+ * path that a config handler is halfway through rewriting */
+BOOL GetConfiguredSoundFile(char* soundFile, size_t soundFileSize) {
+    if (!soundFile || soundFileSize == 0) return FALSE;
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    strncpy_s(soundFile, soundFileSize,
+              published->config.notificationSoundFile, _TRUNCATE);
+    PublishedConfig_Release(published);
+    return soundFile[0] != '\0';
+}
+
+int GetConfiguredSoundVolume(void) {
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    int volume = published->config.notificationSoundVolume;
+    PublishedConfig_Release(published);
+    return volume;
+}
+
 BOOL GetWideCharPath(
     const char* utf8Path, wchar_t* widePath, size_t widePathSize) {
     if (!widePath || widePathSize == 0 || widePathSize > INT_MAX) return FALSE;
@@ -24,6 +53,7 @@ BOOL GetAudioFileInfo(const char* filePath, AudioFileInfo* info) {
     if (!filePath || filePath[0] == '\0' || !info) return FALSE;
     info->path[0] = L'\0';
     info->sizeBytes = 0;
+    ZeroMemory(&info->lastWriteTime, sizeof(info->lastWriteTime));
     if (!GetWideCharPath(filePath, info->path, _countof(info->path))) return FALSE;
     WIN32_FILE_ATTRIBUTE_DATA attributes;
     if (!GetFileAttributesExW(
@@ -31,6 +61,7 @@ BOOL GetAudioFileInfo(const char* filePath, AudioFileInfo* info) {
         (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) return FALSE;
     info->sizeBytes = ((ULONGLONG)attributes.nFileSizeHigh << 32) |
                       attributes.nFileSizeLow;
+    info->lastWriteTime = attributes.ftLastWriteTime;
     return TRUE;
 }
 
@@ -50,15 +81,11 @@ BOOL IsValidFilePath(const char* filePath) {
 }
 
 void ResetPlaybackState(void) {
-    g_isPlaying = MA_FALSE;
     g_isPaused = MA_FALSE;
-    g_audioTimerId = 0;
-    g_audioTimerKind = AUDIO_TIMER_NONE;
-    g_audioTimerHwnd = NULL;
-    InterlockedExchange(&g_decoderAtEnd, 0);
-    InterlockedExchange(&g_decoderDrainDeadline, 0);
-    InterlockedExchange(&g_decoderDrainRemainingMs, 0);
-    InterlockedExchange(&g_decoderPaused, 0);
+    g_audioFallbackKind = AUDIO_FALLBACK_NONE;
+    g_audioFallbackOwner = NULL;
+    g_audioFallbackEndTick = 0;
+    AudioMixer_SetPaused(FALSE);
 }
 
 static UINT_PTR NextAudioTimerId(void) {
@@ -66,56 +93,61 @@ static UINT_PTR NextAudioTimerId(void) {
     return AUDIO_TIMER_ID_BASE + ((UINT_PTR)serial & AUDIO_TIMER_ID_MASK);
 }
 
-BOOL StartPlaybackTimer(
-    HWND hwnd, AudioTimerKind timerKind, UINT interval) {
+void StopAudioPollTimer(void) {
+    if (g_audioTimerId != 0 && IsCurrentProcessAudioWindow(g_audioTimerHwnd)) {
+        KillTimer(g_audioTimerHwnd, g_audioTimerId);
+    }
+    g_audioTimerId = 0;
+    g_audioTimerHwnd = NULL;
+}
+
+/* One poll timer serves every voice and fallback. It follows the newest
+ * alert window, which outlives the settings dialogs that own previews. */
+BOOL EnsureAudioPollTimer(HWND hwnd, BOOL preferThisWindow) {
+    if (g_audioTimerId != 0 &&
+        IsCurrentProcessAudioWindow(g_audioTimerHwnd) &&
+        (!preferThisWindow || g_audioTimerHwnd == hwnd)) {
+        return TRUE;
+    }
     if (!IsCurrentProcessAudioWindow(hwnd)) {
         LOG_WARNING(
             "Cannot start audio completion timer without a window handle");
-        return FALSE;
-    }
-    if (g_audioTimerId != 0) {
-        HWND timerWindow = g_audioTimerHwnd ? g_audioTimerHwnd : hwnd;
-        if (IsCurrentProcessAudioWindow(timerWindow)) {
-            KillTimer(timerWindow, g_audioTimerId);
-        }
-        g_audioTimerId = 0;
-        g_audioTimerKind = AUDIO_TIMER_NONE;
-        g_audioTimerHwnd = NULL;
+        return g_audioTimerId != 0 && IsCurrentProcessAudioWindow(g_audioTimerHwnd);
     }
+    StopAudioPollTimer();
     UINT_PTR timerId = NextAudioTimerId();
     if (!SetTimer(
-            hwnd, timerId, interval, (TIMERPROC)AudioTimerCallback)) {
-        LOG_WARNING(
-            "Failed to start audio completion timer (kind: %d, error: %lu)",
-            (int)timerKind, GetLastError());
+            hwnd, timerId, TIMER_INTERVAL_AUDIO_CHECK,
+            (TIMERPROC)AudioTimerCallback)) {
+        LOG_WARNING("Failed to start audio completion timer (error: %lu)",
+                    GetLastError());
         return FALSE;
     }
     g_audioTimerId = timerId;
-    g_audioTimerKind = timerKind;
     g_audioTimerHwnd = hwnd;
     return TRUE;
 }
 
+static BOOL StartFallback(HWND hwnd, AudioFallbackKind kind, DWORD durationMs) {
+    if (!EnsureAudioPollTimer(hwnd, FALSE)) return FALSE;
+    DWORD endTick = GetTickCount() + durationMs;
+    g_audioFallbackKind = kind;
+    g_audioFallbackOwner = hwnd;
+    g_audioFallbackEndTick = endTick ? endTick : 1;
+    return TRUE;
+}
+
 BOOL FallbackToPlaySound(HWND hwnd, const wchar_t* wideFilePath) {
     if (!PlaySoundW(
             wideFilePath, NULL, SND_FILENAME | SND_ASYNC)) return FALSE;
-    if (!StartPlaybackTimer(
-            hwnd, AUDIO_TIMER_PLAYSOUND, TIMER_INTERVAL_FALLBACK)) {
+    if (!StartFallback(hwnd, AUDIO_FALLBACK_PLAYSOUND, TIMER_INTERVAL_FALLBACK)) {
         PlaySoundW(NULL, NULL, SND_PURGE);
-        ResetPlaybackState();
         return FALSE;
     }
-    g_isPlaying = MA_TRUE;
     return TRUE;
 }
 
 BOOL FallbackToSystemBeep(HWND hwnd) {
     MessageBeep(MB_OK);
-    if (!StartPlaybackTimer(
-            hwnd, AUDIO_TIMER_BEEP, TIMER_INTERVAL_BEEP)) {
-        ResetPlaybackState();
-        return FALSE;
-    }
-    g_isPlaying = MA_TRUE;
-    return TRUE;
+    return StartFallback(hwnd, AUDIO_FALLBACK_BEEP, TIMER_INTERVAL_BEEP);
 }
@@ -1,63 +1,67 @@
 #include "audio_player_internal.h"
 
+/* Fallback sounds cannot report their end; they count as finished after
+ * a fixed interval */
+static BOOL ReapFallbackLocked(HWND* owner) {
+    if (g_audioFallbackKind == AUDIO_FALLBACK_NONE ||
+        (LONG)(GetTickCount() - g_audioFallbackEndTick) < 0) {
+        return FALSE;
+    }
+    if (g_audioFallbackKind == AUDIO_FALLBACK_PLAYSOUND) {
+        PlaySoundW(NULL, NULL, SND_PURGE);
+    }
+    *owner = g_audioFallbackOwner;
+    g_audioFallbackKind = AUDIO_FALLBACK_NONE;
+    g_audioFallbackOwner = NULL;
+    g_audioFallbackEndTick = 0;
+    return TRUE;
+}
+
 void CALLBACK AudioTimerCallback(
     HWND hwnd, UINT message, UINT_PTR idEvent, DWORD time) {
     (void)time;
-    AudioPlaybackCompleteCallback callback = NULL;
-    HWND callbackHwnd = NULL;
+    HWND finished[AUDIO_MIXER_VOICES + 1];
+    int finishedCount = 0;
     /* This callback runs on the main window thread. A background playback
-     * request may briefly own the lock while opening or closing the device;
+     * request may briefly own the lock while decoding or opening the device;
      * defer completion polling instead of blocking all window messages. */
     if (!TryAcquireSRWLockExclusive(&g_audioStateLock)) {
         return;
     }
     if (message != WM_TIMER || idEvent != g_audioTimerId ||
-        g_audioTimerKind == AUDIO_TIMER_NONE ||
         hwnd != g_audioTimerHwnd || !IsCurrentProcessAudioWindow(hwnd)) {
         ReleaseSRWLockExclusive(&g_audioStateLock);
         return;
     }
-    BOOL shouldStop = FALSE;
-    AudioTimerKind timerKind = g_audioTimerKind;
-    if (timerKind == AUDIO_TIMER_MINIAUDIO) {
-        if (g_deviceInitialized && g_decoderInitialized) {
-            BOOL atEnd = InterlockedCompareExchange(
-                &g_decoderAtEnd, 0, 0) != 0;
-            DWORD deadline = (DWORD)InterlockedCompareExchange(
-                &g_decoderDrainDeadline, 0, 0);
-            BOOL drained = atEnd && deadline != 0 &&
-                (LONG)(GetTickCount() - deadline) >= 0;
-            if ((drained || !ma_device_is_started(&g_device)) && !g_isPaused) {
-                CleanupMiniaudioObjects();
-                shouldStop = TRUE;
-            }
-        } else {
-            shouldStop = TRUE;
-        }
-    } else if (timerKind == AUDIO_TIMER_PLAYSOUND) {
-        PlaySoundW(NULL, NULL, SND_PURGE);
-        shouldStop = TRUE;
-    } else if (timerKind == AUDIO_TIMER_BEEP) {
-        shouldStop = TRUE;
-    }
-    if (shouldStop) {
-        HWND timerWindow = g_audioTimerHwnd ? g_audioTimerHwnd : hwnd;
-        AcquireSRWLockShared(&g_audioCallbackLock);
-        callbackHwnd = g_audioCallbackHwnd;
-        callback = g_audioCompleteCallback;
-        ReleaseSRWLockShared(&g_audioCallbackLock);
-        BOOL notify = callback && callbackHwnd &&
-            callbackHwnd == timerWindow &&
-            IsCurrentProcessAudioWindow(callbackHwnd);
-        if (IsCurrentProcessAudioWindow(timerWindow)) {
-            KillTimer(timerWindow, g_audioTimerId);
+    finishedCount = AudioMixer_ReapVoices(finished, AUDIO_MIXER_VOICES);
+    if (ReapFallbackLocked(&finished[finishedCount])) finishedCount++;
+
+    if (AudioMixer_GetActiveVoiceCount() == 0) {
+        LONG latencyUs = InterlockedExchange(&g_audioLastStartLatencyUs, -1);
+        if (latencyUs >= 0) {
+            LOG_INFO("Notification sound reached the device %ld us after the request",
+                     latencyUs);
         }
-        ResetPlaybackState();
-        if (!notify) {
-            callback = NULL;
-            callbackHwnd = NULL;
+        if (g_audioFallbackKind == AUDIO_FALLBACK_NONE &&
+            AudioMixer_IsIdleExpired()) {
+            AudioMixer_CloseDevice();
+            StopAudioPollTimer();
+            g_isPaused = MA_FALSE;
         }
     }
+
+    AudioPlaybackCompleteCallback callback = NULL;
+    HWND callbackHwnd = NULL;
+    AcquireSRWLockShared(&g_audioCallbackLock);
+    callbackHwnd = g_audioCallbackHwnd;
+    callback = g_audioCompleteCallback;
+    ReleaseSRWLockShared(&g_audioCallbackLock);
+    BOOL notify = FALSE;
+    for (int i = 0; i < finishedCount; ++i) {
+        if (finished[i] && finished[i] == callbackHwnd) notify = TRUE;
+    }
     ReleaseSRWLockExclusive(&g_audioStateLock);
-    if (callback) callback(callbackHwnd);
+    if (notify && callback && IsCurrentProcessAudioWindow(callbackHwnd)) {
+        callback(callbackHwnd);
+    }
 }
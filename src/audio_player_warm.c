@@ -0,0 +1,61 @@
+/**
+ * @file audio_player_warm.c
+ * @brief Decode and device warm-up ahead of a countdown deadline
+ */
+
+#include "audio_player_internal.h"
+
+typedef struct {
+    HWND hwnd;
+    char soundFile[MAX_PATH];
+    DWORD leadMs;
+} AudioPrewarmRequest;
+
+static DWORD WINAPI AudioPrewarmThreadProc(LPVOID parameter) {
+    AudioPrewarmRequest* request = parameter;
+    if (!request) return 0;
+    AudioPrewarmRequest local = *request;
+    free(request);
+
+    AudioFileInfo fileInfo;
+    if (!IsValidFilePath(local.soundFile) ||
+        !GetAudioFileInfo(local.soundFile, &fileInfo) ||
+        !IsAudioFileSizeAllowed(local.soundFile, fileInfo.sizeBytes)) {
+        return 0;
+    }
+    /* Sounds the cache declines still stream; only the decode is skipped */
+    AudioPcmCache_Release(AudioPcmCache_Acquire(&fileInfo));
+
+    /* The poll timer closes the idle device once this window has passed */
+    AcquireSRWLockExclusive(&g_audioStateLock);
+    ma_result result = AudioMixer_OpenDevice();
+    if (result == MA_SUCCESS && EnsureAudioPollTimer(local.hwnd, FALSE)) {
+        AudioMixer_KeepDeviceOpen(local.leadMs + AUDIO_WARM_DEVICE_GRACE_MS);
+    } else if (result != MA_SUCCESS) {
+        LOG_INFO("Notification sound prewarm skipped (device error: %d)", result);
+    }
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+    return 0;
+}
+
+BOOL PrewarmNotificationSound(HWND hwnd, DWORD leadMs) {
+    char configuredFile[MAX_PATH];
+    if (!GetConfiguredSoundFile(configuredFile, sizeof(configuredFile)) ||
+        strcmp(configuredFile, "SYSTEM_BEEP") == 0) {
+        return TRUE;
+    }
+    AudioPrewarmRequest* request = calloc(1, sizeof(*request));
+    if (!request) return FALSE;
+    request->hwnd = hwnd;
+    strncpy(request->soundFile, configuredFile,
+            sizeof(request->soundFile) - 1);
+    request->leadMs = leadMs;
+    HANDLE thread = CreateThread(
+        NULL, 0, AudioPrewarmThreadProc, request, 0, NULL);
+    if (!thread) {
+        free(request);
+        return FALSE;
+    }
+    CloseHandle(thread);
+    return TRUE;
+}
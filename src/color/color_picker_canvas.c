@@ -4,6 +4,7 @@
  */
 
 #include "color/color_picker_internal.h"
+#include "drawing/drawing_dib_pool.h"
 #include "../resource/resource.h"
 
 #include <stdlib.h>
@@ -11,50 +12,27 @@
 #define COLOR_PICKER_MAX_CANVAS_DIMENSION 2048
 
 typedef struct {
-    HDC target;
     HDC dc;
-    HBITMAP bitmap;
-    HGDIOBJ oldBitmap;
     RECT rect;
-    POINT targetOrigin;
-    int width;
-    int height;
+    DibPaintBuffer buffer;
 } PickerPaintBuffer;
 
 static void PickerBeginPaintBuffer(const DRAWITEMSTRUCT* item,
                                    PickerPaintBuffer* paint) {
     ZeroMemory(paint, sizeof(*paint));
-    paint->target = item->hDC;
-    paint->dc = item->hDC;
     paint->rect = item->rcItem;
-    paint->targetOrigin.x = item->rcItem.left;
-    paint->targetOrigin.y = item->rcItem.top;
-    paint->width = item->rcItem.right - item->rcItem.left;
-    paint->height = item->rcItem.bottom - item->rcItem.top;
-    if (paint->width <= 0 || paint->height <= 0) return;
-    HDC buffer = CreateCompatibleDC(item->hDC);
-    HBITMAP bitmap = buffer
-        ? CreateCompatibleBitmap(item->hDC, paint->width, paint->height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap ? SelectObject(buffer, bitmap) : NULL;
-    if (!buffer || !bitmap || !oldBitmap || oldBitmap == HGDI_ERROR) {
-        if (bitmap) DeleteObject(bitmap);
-        if (buffer) DeleteDC(buffer);
-        return;
+    paint->dc = DibPool_BeginPaintBuffer(
+        item->hDC, item->rcItem.left, item->rcItem.top,
+        item->rcItem.right - item->rcItem.left,
+        item->rcItem.bottom - item->rcItem.top, &paint->buffer);
+    if (paint->dc != item->hDC) {
+        SetRect(&paint->rect, 0, 0, paint->buffer.width, paint->buffer.height);
     }
-    paint->dc = buffer;
-    paint->bitmap = bitmap;
-    paint->oldBitmap = oldBitmap;
-    SetRect(&paint->rect, 0, 0, paint->width, paint->height);
 }
 
 static void PickerEndPaintBuffer(PickerPaintBuffer* paint) {
-    if (!paint || !paint->bitmap) return;
-    BitBlt(paint->target, paint->targetOrigin.x, paint->targetOrigin.y,
-           paint->width, paint->height,
-           paint->dc, 0, 0, SRCCOPY);
-    SelectObject(paint->dc, paint->oldBitmap);
-    DeleteObject(paint->bitmap);
-    DeleteDC(paint->dc);
+    if (!paint) return;
+    DibPool_EndPaintBuffer(&paint->buffer);
 }
 
 static DWORD PickerColorToDibPixel(COLORREF color) {
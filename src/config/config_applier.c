@@ -2,11 +2,13 @@
 #include "config.h"
 #include "config/config_defaults.h"
 #include "config/config_plugin_security.h"
+#include "config/config_published.h"
 #include "language.h"
 #include "window.h"
 #include "font.h"
 #include "color/color.h"
 #include "drawing/drawing_effect.h"
+#include "drawing/drawing_render.h"
 #include "text_effect.h"
 #include "log.h"
 #include "taskbar_monitor.h"
@@ -16,7 +18,6 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
-#include <ctype.h>
 extern TextEffectType CLOCK_TEXT_EFFECT;
 BOOL g_ForceApplyConfig = FALSE;
 static int LanguageNameToEnum(const char* langName) {
@@ -158,6 +159,7 @@ void ApplyDisplaySettings(const ConfigSnapshot* snapshot) {
         }
         BYTE alphaValue = (BYTE)((CLOCK_WINDOW_OPACITY * 255) / 100);
         SetLayeredWindowAttributes(hwnd, RGB(0, 0, 0), alphaValue, LWA_COLORKEY | LWA_ALPHA);
+        InvalidateDrawingRenderPresentCache();
         if (!CLOCK_IS_DRAGGING) {
             RefreshWindowTopmostState(hwnd);
         }
@@ -296,4 +298,5 @@ void ApplyConfigSnapshot(const ConfigSnapshot* snapshot) { if (!snapshot) {
     TaskbarMonitor_ApplyConfig(snapshot->taskbarMonitorEnabled,
         snapshot->taskbarMonitorCpuMemory, snapshot->taskbarMonitorNetwork);
     g_AppConfig.last_config_time = time(NULL);
+    PublishAppliedConfig(snapshot);
 }
@@ -125,6 +125,10 @@ const ConfigItemMeta CONFIG_METADATA[] = {
     /* Colors */
     {INI_SECTION_COLORS, "COLOR_OPTIONS", DEFAULT_COLOR_OPTIONS_INI, CONFIG_TYPE_STRING, CFG_OFFSET(colorOptions), CFG_SIZE(colorOptions)},
 
+    /* Options - not mapped to ConfigSnapshot, read by their own modules */
+    {INI_SECTION_OPTIONS, "PLUGIN_WARM_POOL", "FALSE", CONFIG_TYPE_BOOL, CFG_NO_OFFSET, CFG_NO_SIZE},
+    {INI_SECTION_OPTIONS, "RENDER_METRICS_OVERLAY", "FALSE", CONFIG_TYPE_BOOL, CFG_NO_OFFSET, CFG_NO_SIZE},
+
     /* Recent files - handled separately via custom logic */
 };
 
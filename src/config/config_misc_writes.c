@@ -1,4 +1,5 @@
 #include "config_misc_internal.h"
+#include "config/config_published.h"
 
 static void UpdateStartupModeBuffer(const char* mode) {
     strncpy(CLOCK_STARTUP_MODE, mode, sizeof(CLOCK_STARTUP_MODE) - 1);
@@ -123,4 +124,5 @@ void WriteConfigOpacitySteps(int normalStep, int fastStep) {
             configPath, updates, sizeof(updates) / sizeof(updates[0]))) return;
     g_AppConfig.display.opacity_step_normal = normalStep;
     g_AppConfig.display.opacity_step_fast = fastStep;
+    PublishOpacitySteps(normalStep, fastStep);
 }
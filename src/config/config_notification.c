@@ -1,5 +1,6 @@
 #include "config.h"
 #include "config/config_defaults.h"
+#include "config/config_published.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -86,6 +87,7 @@ BOOL WriteConfigNotificationMessages(const char* timeoutMessage) {
     }
     strncpy(g_AppConfig.notification.messages.timeout_message, timeoutMessage, sizeof(g_AppConfig.notification.messages.timeout_message) - 1);
     g_AppConfig.notification.messages.timeout_message[sizeof(g_AppConfig.notification.messages.timeout_message) - 1] = '\0';
+    PublishTimeoutMessage(timeoutMessage);
     return TRUE;
 }
 BOOL WriteConfigNotificationTimeout(int timeoutMs) {
@@ -189,6 +191,7 @@ void WriteConfigNotificationSound(const char* soundFile) {
     }
     strncpy(g_AppConfig.notification.sound.sound_file, clean_path, sizeof(g_AppConfig.notification.sound.sound_file) - 1);
     g_AppConfig.notification.sound.sound_file[sizeof(g_AppConfig.notification.sound.sound_file) - 1] = '\0';
+    PublishNotificationSound(clean_path, -1);
 }
 BOOL WriteConfigNotificationSettings(const char* timeoutMessage, int timeoutMs,
                                      int opacity, NotificationType type,
@@ -285,5 +288,7 @@ BOOL WriteConfigNotificationSettings(const char* timeoutMessage, int timeoutMs,
             sizeof(g_AppConfig.notification.sound.sound_file) - 1);
     g_AppConfig.notification.sound.sound_file[sizeof(g_AppConfig.notification.sound.sound_file) - 1] = '\0';
     g_AppConfig.notification.sound.volume = volume;
+    PublishTimeoutMessage(timeoutMessage);
+    PublishNotificationSound(cleanSoundPath, volume);
     return TRUE;
 }
@@ -1,5 +1,6 @@
 #include "config.h"
 #include "config/config_defaults.h"
+#include "config/config_published.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,6 +32,7 @@ void WriteConfigNotificationVolume(int volume) {
         return;
     }
     g_AppConfig.notification.sound.volume = volume;
+    PublishNotificationSound(NULL, volume);
 }
 BOOL WriteConfigNotificationWindow(int x, int y, int width, int height) {
     char xStr[32];
@@ -0,0 +1,84 @@
+/**
+ * @file config_published.c
+ * @brief Slot-based RCU publication of the applied configuration.
+ *
+ * Readers bump the reader count of the current slot and then confirm it is
+ * still current; if a writer swapped in the meantime they back off and
+ * retry, so they never see a slot that is being rewritten. Writers only
+ * reuse a slot that is not current and has no readers, which is the grace
+ * period. Three slots let one writer proceed while readers finish with the
+ * previous snapshot.
+ */
+
+#include "config/config_published.h"
+
+#define PUBLISHED_CONFIG_SLOTS 3
+#define PUBLISHED_CONFIG_YIELD_SPINS 64
+
+typedef struct {
+    volatile LONG readers;
+    PublishedConfig published;
+} PublishedConfigSlot;
+
+static PublishedConfigSlot g_publishedSlots[PUBLISHED_CONFIG_SLOTS];
+static volatile LONG g_publishedCurrent = 0;
+static SRWLOCK g_publishedWriteLock = SRWLOCK_INIT;
+
+const PublishedConfig* PublishedConfig_Acquire(void) {
+    for (;;) {
+        LONG index = InterlockedCompareExchange(&g_publishedCurrent, 0, 0);
+        PublishedConfigSlot* slot = &g_publishedSlots[index];
+        InterlockedIncrement(&slot->readers);
+        if (InterlockedCompareExchange(&g_publishedCurrent, 0, 0) == index) {
+            return &slot->published;
+        }
+        InterlockedDecrement(&slot->readers);
+    }
+}
+
+void PublishedConfig_Release(const PublishedConfig* published) {
+    if (!published) return;
+    PublishedConfigSlot* slot = CONTAINING_RECORD(
+        (PublishedConfig*)published, PublishedConfigSlot, published);
+    InterlockedDecrement(&slot->readers);
+}
+
+/* Caller holds the write lock, so the current index cannot move */
+static PublishedConfigSlot* WaitForSpareSlot(LONG current) {
+    for (int spins = 0;; ++spins) {
+        for (LONG i = 0; i < PUBLISHED_CONFIG_SLOTS; ++i) {
+            if (i == current) continue;
+            if (InterlockedCompareExchange(&g_publishedSlots[i].readers, 0, 0) == 0) {
+                return &g_publishedSlots[i];
+            }
+        }
+        if (spins < PUBLISHED_CONFIG_YIELD_SPINS) {
+            SwitchToThread();
+        } else {
+            Sleep(1);
+        }
+    }
+}
+
+LONG64 PublishedConfig_Publish(const ConfigSnapshot* base,
+                               PublishedConfigEdit edit, const void* context) {
+    AcquireSRWLockExclusive(&g_publishedWriteLock);
+    LONG current = InterlockedCompareExchange(&g_publishedCurrent, 0, 0);
+    const PublishedConfig* previous = &g_publishedSlots[current].published;
+    PublishedConfigSlot* target = WaitForSpareSlot(current);
+
+    target->published.config = base ? *base : previous->config;
+    if (edit) edit(&target->published.config, context);
+    target->published.version = previous->version + 1;
+    LONG64 version = target->published.version;
+    InterlockedExchange(&g_publishedCurrent, (LONG)(target - g_publishedSlots));
+    ReleaseSRWLockExclusive(&g_publishedWriteLock);
+    return version;
+}
+
+LONG64 PublishedConfig_GetVersion(void) {
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    LONG64 version = published->version;
+    PublishedConfig_Release(published);
+    return version;
+}
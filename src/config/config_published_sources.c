@@ -0,0 +1,89 @@
+/**
+ * @file config_published_sources.c
+ * @brief Points where the applied configuration is republished.
+ */
+
+#include "config/config_published.h"
+#include "config.h"
+#include "log.h"
+
+#include <string.h>
+
+typedef struct {
+    const char* soundFile;
+    int volume;
+} NotificationSoundEdit;
+
+typedef struct {
+    int normal;
+    int fast;
+} OpacityStepsEdit;
+
+static void CopySoundFile(ConfigSnapshot* config, const char* soundFile) {
+    strncpy_s(config->notificationSoundFile,
+              sizeof(config->notificationSoundFile), soundFile, _TRUNCATE);
+}
+
+static void UseAppliedSoundFile(ConfigSnapshot* config, const void* context) {
+    (void)context;
+    CopySoundFile(config, g_AppConfig.notification.sound.sound_file);
+}
+
+static void ExpandSoundFile(ConfigSnapshot* config, const void* context) {
+    (void)context;
+    char expanded[MAX_PATH] = {0};
+    if (ExpandEffectiveLocalAppDataPath(config->notificationSoundFile,
+                                        expanded, sizeof(expanded))) {
+        CopySoundFile(config, expanded);
+    }
+}
+
+static void ApplyNotificationSoundEdit(ConfigSnapshot* config, const void* context) {
+    const NotificationSoundEdit* edit = (const NotificationSoundEdit*)context;
+    if (edit->soundFile) CopySoundFile(config, edit->soundFile);
+    if (edit->volume >= 0) config->notificationSoundVolume = edit->volume;
+}
+
+static void ApplyTimeoutMessageEdit(ConfigSnapshot* config, const void* context) {
+    strncpy_s(config->timeoutMessage, sizeof(config->timeoutMessage),
+              (const char*)context, _TRUNCATE);
+}
+
+static void ApplyOpacityStepsEdit(ConfigSnapshot* config, const void* context) {
+    const OpacityStepsEdit* edit = (const OpacityStepsEdit*)context;
+    config->opacityStepNormal = edit->normal;
+    config->opacityStepFast = edit->fast;
+}
+
+void PublishAppliedConfig(const ConfigSnapshot* snapshot) {
+    if (!snapshot) return;
+    PublishedConfig_Publish(snapshot, UseAppliedSoundFile, NULL);
+}
+
+BOOL PublishConfigFromFile(const char* configPath) {
+    if (!configPath || configPath[0] == '\0') return FALSE;
+    /* Same load and validation as startup, minus the write-back */
+    ConfigSnapshot snapshot;
+    if (!LoadConfigFromFile(configPath, &snapshot)) {
+        LOG_WARNING("Config snapshot rebuild failed; keeping the previous one");
+        return FALSE;
+    }
+    ValidateConfigSnapshot(&snapshot);
+    PublishedConfig_Publish(&snapshot, ExpandSoundFile, NULL);
+    return TRUE;
+}
+
+void PublishNotificationSound(const char* soundFile, int volume) {
+    NotificationSoundEdit edit = {soundFile, volume};
+    PublishedConfig_Publish(NULL, ApplyNotificationSoundEdit, &edit);
+}
+
+void PublishTimeoutMessage(const char* timeoutMessage) {
+    if (!timeoutMessage) return;
+    PublishedConfig_Publish(NULL, ApplyTimeoutMessageEdit, timeoutMessage);
+}
+
+void PublishOpacitySteps(int normalStep, int fastStep) {
+    OpacityStepsEdit edit = {normalStep, fastStep};
+    PublishedConfig_Publish(NULL, ApplyOpacityStepsEdit, &edit);
+}
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "config/config_watcher.h"
+#include "config/config_published.h"
 #include "config.h"
 #include "window_procedure/window_procedure.h"
 #include "tray/tray_animation_core.h"
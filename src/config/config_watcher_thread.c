@@ -172,6 +172,7 @@ DWORD WINAPI ConfigWatcher_ThreadProc(LPVOID lpParam) {
                 }
                 if (ConfigWatcher_ShouldProcessChange(stopEvent)) {
                     InvalidateIniCache();
+                    PublishConfigFromFile(iniPath);
                     NotifyConfigChanges(targetHwnd);
                 }
             }
@@ -4,6 +4,7 @@
  */
 
 #include "dialog_countdown_internal.h"
+#include "drawing/drawing_dib_pool.h"
 
 void CountdownHandlePaint(HWND hwnd, CountdownDialogState* state) {
     if (!hwnd || !state) return;
@@ -14,22 +15,10 @@ void CountdownHandlePaint(HWND hwnd, CountdownDialogState* state) {
     GetClientRect(hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = CreateCompatibleDC(target);
-    HBITMAP bitmap = buffer
-        ? CreateCompatibleBitmap(target, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap
-        ? SelectObject(buffer, bitmap) : NULL;
-    if (buffer && bitmap) {
-        CountdownPaint(hwnd, state, buffer);
-        BitBlt(target, 0, 0, width, height, buffer, 0, 0, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-        DeleteObject(bitmap);
-        DeleteDC(buffer);
-    } else {
-        CountdownPaint(hwnd, state, target);
-        if (bitmap) DeleteObject(bitmap);
-        if (buffer) DeleteDC(buffer);
-    }
+    DibPaintBuffer buffer;
+    CountdownPaint(hwnd, state,
+                   DibPool_BeginPaintBuffer(target, 0, 0, width, height, &buffer));
+    DibPool_EndPaintBuffer(&buffer);
     EndPaint(hwnd, &paint);
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "dialog_modern_internal.h"
+#include "drawing/drawing_dib_pool.h"
 
 void ModernApplyComboListRegion(HWND hwnd, ModernControl* control) {
     if (!hwnd || !control || !control->owner) return;
@@ -196,21 +197,10 @@ void ModernPaintComboList(HWND hwnd, ModernControl* control,
     GetClientRect(hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = width > 0 && height > 0 ? CreateCompatibleDC(target) : NULL;
-    HBITMAP bitmap = buffer
-        ? CreateCompatibleBitmap(target, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap
-        ? SelectObject(buffer, bitmap) : NULL;
-
-    if (buffer && bitmap && oldBitmap) {
-        ModernDrawComboList(hwnd, control, buffer);
-        BitBlt(target, 0, 0, width, height, buffer, 0, 0, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-    } else {
-        ModernDrawComboList(hwnd, control, target);
-    }
-    if (bitmap) DeleteObject(bitmap);
-    if (buffer) DeleteDC(buffer);
+    DibPaintBuffer buffer;
+    ModernDrawComboList(hwnd, control,
+                        DibPool_BeginPaintBuffer(target, 0, 0, width, height, &buffer));
+    DibPool_EndPaintBuffer(&buffer);
     if (!suppliedDc) EndPaint(hwnd, &paint);
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "dialog_modern_internal.h"
+#include "drawing/drawing_dib_pool.h"
 
 void ModernStopDateTimeRepeat(ModernControl* control) {
     if (!control || !control->hwnd) return;
@@ -28,10 +29,8 @@ void ModernPaintDateTime(ModernControl* control, HDC suppliedDc) {
     GetClientRect(control->hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = width > 0 && height > 0 ? CreateCompatibleDC(hdc) : NULL;
-    HBITMAP bitmap = buffer ? CreateCompatibleBitmap(hdc, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap ? SelectObject(buffer, bitmap) : NULL;
-    HDC drawDc = buffer && bitmap ? buffer : hdc;
+    DibPaintBuffer buffer;
+    HDC drawDc = DibPool_BeginPaintBuffer(hdc, 0, 0, width, height, &buffer);
     FillRect(drawDc, &client, state->fieldBrush);
 
     SYSTEMTIME time = {0};
@@ -140,13 +139,7 @@ void ModernPaintDateTime(ModernControl* control, HDC suppliedDc) {
     }
     ModernDrawFieldOutlineToDc(control, drawDc);
 
-    if (buffer && bitmap) {
-        BitBlt(hdc, client.left, client.top, width, height,
-               buffer, client.left, client.top, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-    }
-    if (bitmap) DeleteObject(bitmap);
-    if (buffer) DeleteDC(buffer);
+    DibPool_EndPaintBuffer(&buffer);
     if (!suppliedDc) EndPaint(control->hwnd, &paint);
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "dialog_modern_internal.h"
+#include "drawing/drawing_dib_pool.h"
 #include <wctype.h>
 
 #define MODERN_HINT_MAX_CHARS 4096
@@ -219,17 +220,10 @@ void ModernPaintInstruction(ModernControl* control, HDC suppliedDc) {
     GetClientRect(control->hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = width > 0 && height > 0 ? CreateCompatibleDC(hdc) : NULL;
-    HBITMAP bitmap = buffer ? CreateCompatibleBitmap(hdc, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap ? SelectObject(buffer, bitmap) : NULL;
-    HDC target = buffer && bitmap ? buffer : hdc;
+    DibPaintBuffer buffer;
+    HDC target = DibPool_BeginPaintBuffer(hdc, 0, 0, width, height, &buffer);
 
     ModernDrawInstruction(control, target, &client);
-    if (buffer && bitmap) {
-        BitBlt(hdc, 0, 0, width, height, buffer, 0, 0, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-    }
-    if (bitmap) DeleteObject(bitmap);
-    if (buffer) DeleteDC(buffer);
+    DibPool_EndPaintBuffer(&buffer);
     if (!suppliedDc) EndPaint(control->hwnd, &paint);
 }
@@ -4,26 +4,16 @@
  */
 
 #include "dialog_modern_internal.h"
+#include "drawing/drawing_dib_pool.h"
 
 void ModernPaintBuffered(ModernDialogState* state, HDC target) {
     RECT client = {0};
     GetClientRect(state->hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = CreateCompatibleDC(target);
-    HBITMAP bitmap = buffer ? CreateCompatibleBitmap(target, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap ? SelectObject(buffer, bitmap) : NULL;
-    if (buffer && bitmap) {
-        ModernDrawDialog(state, buffer);
-        BitBlt(target, 0, 0, width, height, buffer, 0, 0, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-        DeleteObject(bitmap);
-        DeleteDC(buffer);
-    } else {
-        ModernDrawDialog(state, target);
-        if (bitmap) DeleteObject(bitmap);
-        if (buffer) DeleteDC(buffer);
-    }
+    DibPaintBuffer buffer;
+    ModernDrawDialog(state, DibPool_BeginPaintBuffer(target, 0, 0, width, height, &buffer));
+    DibPool_EndPaintBuffer(&buffer);
 }
 
 void ModernDrawFieldOutlineToDc(ModernControl* control, HDC hdc) {
@@ -183,10 +173,8 @@ void ModernPaintSlider(ModernControl* control, HDC suppliedDc) {
     GetClientRect(control->hwnd, &client);
     int width = client.right - client.left;
     int height = client.bottom - client.top;
-    HDC buffer = width > 0 && height > 0 ? CreateCompatibleDC(hdc) : NULL;
-    HBITMAP bitmap = buffer ? CreateCompatibleBitmap(hdc, width, height) : NULL;
-    HGDIOBJ oldBitmap = buffer && bitmap ? SelectObject(buffer, bitmap) : NULL;
-    HDC drawDc = buffer && bitmap ? buffer : hdc;
+    DibPaintBuffer buffer;
+    HDC drawDc = DibPool_BeginPaintBuffer(hdc, 0, 0, width, height, &buffer);
     FillRect(drawDc, &client, state->surfaceBrush);
 
     LONG_PTR style = GetWindowLongPtrW(control->hwnd, GWL_STYLE);
@@ -258,13 +246,7 @@ void ModernPaintSlider(ModernControl* control, HDC suppliedDc) {
     if (thumbPen) DeleteObject(thumbPen);
     if (thumbBrush) DeleteObject(thumbBrush);
 
-    if (buffer && bitmap) {
-        BitBlt(hdc, client.left, client.top, width, height,
-               buffer, client.left, client.top, SRCCOPY);
-        SelectObject(buffer, oldBitmap);
-    }
-    if (bitmap) DeleteObject(bitmap);
-    if (buffer) DeleteDC(buffer);
+    DibPool_EndPaintBuffer(&buffer);
 
     if (!suppliedDc) EndPaint(control->hwnd, &paint);
 }
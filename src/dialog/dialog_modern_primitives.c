@@ -1,4 +1,5 @@
 #include "dialog/dialog_modern.h"
+#include "drawing/drawing_dib_pool.h"
 #include "tray/tray_menu_theme.h"
 #include "utils/win32_dynamic_loader.h"
 #include <dwmapi.h>
@@ -245,21 +246,19 @@ void DialogModern_DrawTitleSignature(HDC hdc, const RECT* titleRect, UINT dpi, i
                    x + width + paddingX, y + bottomPadding};
     int outputWidth = bounds.right - bounds.left;
     int outputHeight = bounds.bottom - bounds.top;
-    HDC sampleDc = sampleScale > 1 ? CreateCompatibleDC(hdc) : NULL;
-    HBITMAP sampleBitmap = sampleDc ? CreateCompatibleBitmap( hdc, outputWidth * sampleScale, outputHeight * sampleScale) : NULL;
-    HGDIOBJ oldBitmap = sampleBitmap
-        ? SelectObject(sampleDc, sampleBitmap) : NULL;
-    HDC drawDc = sampleBitmap ? sampleDc : hdc;
+    DibSurface sample = {0};
+    BOOL sampled = sampleScale > 1 && DibPool_Acquire(outputWidth * sampleScale, outputHeight * sampleScale, 0, &sample);
+    HDC drawDc = sampled ? sample.dc : hdc;
     POINT scaledStroke[10];
     POINT scaledAirStroke[4];
     const POINT* drawStroke = stroke;
     const POINT* drawAirStroke = airStroke;
     int drawScale = 1;
-    if (sampleBitmap) {
+    if (sampled) {
         RECT sampleRect = {0, 0, outputWidth * sampleScale,
                            outputHeight * sampleScale};
         HBRUSH surfaceBrush = CreateSolidBrush(surface);
-        FillRect(sampleDc, &sampleRect, surfaceBrush);
+        FillRect(sample.dc, &sampleRect, surfaceBrush);
         DeleteObject(surfaceBrush);
         DialogModernScaleSignaturePoints(stroke, scaledStroke, _countof(stroke), bounds.left, bounds.top, sampleScale);
         DialogModernScaleSignaturePoints( airStroke, scaledAirStroke, _countof(airStroke), bounds.left, bounds.top, sampleScale);
@@ -275,15 +274,13 @@ void DialogModern_DrawTitleSignature(HDC hdc, const RECT* titleRect, UINT dpi, i
     } else {
         DialogModernDrawBezierStroke(drawDc, drawStroke, _countof(stroke), mainWidth * drawScale, accent);
     }
-    if (sampleBitmap) {
+    if (sampled) {
         int oldMode = SetStretchBltMode(hdc, HALFTONE);
         POINT oldOrigin = {0};
         SetBrushOrgEx(hdc, bounds.left, bounds.top, &oldOrigin);
-        StretchBlt(hdc, bounds.left, bounds.top, outputWidth, outputHeight, sampleDc, 0, 0, outputWidth * sampleScale, outputHeight * sampleScale, SRCCOPY);
+        StretchBlt(hdc, bounds.left, bounds.top, outputWidth, outputHeight, sample.dc, 0, 0, outputWidth * sampleScale, outputHeight * sampleScale, SRCCOPY);
         SetBrushOrgEx(hdc, oldOrigin.x, oldOrigin.y, NULL);
         SetStretchBltMode(hdc, oldMode);
-        SelectObject(sampleDc, oldBitmap);
-        DeleteObject(sampleBitmap);
+        DibPool_Release(&sample);
     }
-    if (sampleDc) DeleteDC(sampleDc);
 }
@@ -88,7 +88,7 @@ BOOL HandleSoundTestButton(
             }
         }
     } else {
-        StopNotificationSound();
+        StopPreviewNotificationSound();
         SetDlgItemTextW(
             hwndDlg, IDC_TEST_SOUND_BUTTON,
             GetLocalizedString(NULL, L"Test"));
@@ -129,7 +129,7 @@ void SetupAudioPlaybackCallback(HWND hwndDlg) {
 
 void CleanupAudioPlayback(BOOL isPlaying) {
     if (isPlaying) {
-        StopNotificationSound();
+        StopPreviewNotificationSound();
     }
     SetAudioPlaybackCompleteCallback(NULL, NULL);
 }
@@ -5,6 +5,7 @@
 #include "config.h"
 #include "language.h"
 #include "audio_player.h"
+#include "utils/directory_index.h"
 #include "utils/natural_sort.h"
 #include "utils/directory_watcher.h"
 
@@ -1,9 +1,42 @@
 #include "dialog_notification_audio_internal.h"
+#include "log/log_trace.h"
 
 static int CompareSoundFileRows(const void* first, const void* second) {
     return NaturalCompareW((const wchar_t*)first, (const wchar_t*)second);
 }
 
+typedef struct {
+    wchar_t (*files)[MAX_PATH];
+    int capacity;
+    int count;
+    LONG generation;
+} SoundScanContext;
+
+/* The audio folder is rescanned on every dialog open; the index turns an
+ * unchanged folder into a single attribute query. */
+static DirectoryIndex g_soundDirectoryIndex;
+
+static BOOL AcceptSoundFile(const WIN32_FIND_DATAW* data, BYTE* metadata,
+                            void* context) {
+    (void)metadata;
+    (void)context;
+    return NotificationAudio_IsSupportedFileName(data->cFileName);
+}
+
+static BOOL IsSoundIndexScanCanceled(void* context) {
+    const SoundScanContext* ctx = (const SoundScanContext*)context;
+    return NotificationAudio_IsScanCanceled(ctx->generation);
+}
+
+static BOOL AddSoundFileRow(const DirectoryIndexEntry* entry, void* context) {
+    SoundScanContext* ctx = (SoundScanContext*)context;
+    if (ctx->count >= ctx->capacity) return FALSE;
+    wcsncpy_s(ctx->files[ctx->count], MAX_PATH,
+              DirectoryIndex_EntryFileName(entry), _TRUNCATE);
+    ctx->count++;
+    return TRUE;
+}
+
 static int ScanNotificationSoundFiles(
     wchar_t files[][MAX_PATH], int capacity, LONG generation) {
     if (!files || capacity <= 0) {
@@ -22,59 +55,23 @@ static int ScanNotificationSoundFiles(
         return NOTIFICATION_SOUND_SCAN_FAILED;
     }
 
-    wchar_t searchPath[MAX_PATH];
-    if (_snwprintf_s(searchPath, MAX_PATH, _TRUNCATE,
-                     L"%s\\*.*", wideAudioPath) < 0) {
-        return NOTIFICATION_SOUND_SCAN_FAILED;
-    }
-
-    WIN32_FIND_DATAW findData;
-    HANDLE findHandle = FindFirstFileW(searchPath, &findData);
-    if (findHandle == INVALID_HANDLE_VALUE) {
-        DWORD error = GetLastError();
-        if (error == ERROR_FILE_NOT_FOUND ||
-            error == ERROR_PATH_NOT_FOUND ||
-            error == ERROR_NO_MORE_FILES) {
-            return 0;
-        }
-        return NOTIFICATION_SOUND_SCAN_FAILED;
-    }
-
-    int fileCount = 0;
-    int scannedEntries = 0;
-    BOOL scanCanceled = FALSE;
-    BOOL stoppedEarly = FALSE;
-    do {
-        if (NotificationAudio_IsScanCanceled(generation)) {
-            scanCanceled = TRUE;
-            stoppedEarly = TRUE;
-            break;
-        }
-        if (++scannedEntries > NOTIFICATION_SOUND_SCAN_ENTRY_LIMIT ||
-            fileCount >= capacity) {
-            stoppedEarly = TRUE;
-            break;
-        }
-        if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ||
-            !NotificationAudio_IsSupportedFileName(findData.cFileName)) {
-            continue;
-        }
-
-        wcsncpy_s(files[fileCount], MAX_PATH, findData.cFileName, _TRUNCATE);
-        fileCount++;
-    } while (FindNextFileW(findHandle, &findData));
-
-    DWORD findError = stoppedEarly ? ERROR_SUCCESS : GetLastError();
-    FindClose(findHandle);
-    if (scanCanceled || NotificationAudio_IsScanCanceled(generation) ||
-        (!stoppedEarly && findError != ERROR_NO_MORE_FILES)) {
+    SoundScanContext ctx = { files, capacity, 0, generation };
+    DirectoryIndex_Init(&g_soundDirectoryIndex, 0, capacity,
+                        NOTIFICATION_SOUND_SCAN_ENTRY_LIMIT,
+                        AcceptSoundFile, NULL);
+    DirectoryIndexCallbacks callbacks = {
+        IsSoundIndexScanCanceled, NULL, AddSoundFileRow, &ctx
+    };
+    if (DirectoryIndex_Refresh(&g_soundDirectoryIndex, wideAudioPath,
+                               &callbacks) == DIRECTORY_INDEX_FAILED ||
+        NotificationAudio_IsScanCanceled(generation)) {
         return NOTIFICATION_SOUND_SCAN_FAILED;
     }
 
-    if (fileCount > 1) {
-        qsort(files, (size_t)fileCount, sizeof(files[0]), CompareSoundFileRows);
+    if (ctx.count > 1) {
+        qsort(files, (size_t)ctx.count, sizeof(files[0]), CompareSoundFileRows);
     }
-    return fileCount;
+    return ctx.count;
 }
 
 static BOOL GetAudioFolderPathW(wchar_t* outPath, size_t outSize) {
@@ -122,12 +119,15 @@ void NotificationAudio_StopFolderWatcher(void) {
 
 DWORD WINAPI NotificationAudio_ScanThread(LPVOID lpParam) {
     LONG generation = (LONG)(INT_PTR)lpParam;
+    TraceSpan_NameThread("sound-scan");
+    TRACE_SPAN_BEGIN(scanSpan, "NotificationSound.Scan");
     wchar_t (*files)[MAX_PATH] = malloc(
         (size_t)NOTIFICATION_SOUND_ENTRY_LIMIT * sizeof(*files));
     if (!files) {
         if (!NotificationAudio_IsScanCanceled(generation)) {
             NotificationAudio_MarkCacheScanFailed(generation);
         }
+        TRACE_SPAN_END(scanSpan);
         return 0;
     }
 
@@ -141,5 +141,6 @@ DWORD WINAPI NotificationAudio_ScanThread(LPVOID lpParam) {
         NotificationAudio_MarkCacheScanFailed(generation);
     }
     free(files);
+    TRACE_SPAN_END(scanSpan);
     return 0;
 }
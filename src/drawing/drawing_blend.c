@@ -0,0 +1,53 @@
+/**
+ * @file drawing_blend.c
+ * @brief Row kernels for the shared blend library.
+ */
+
+#include "drawing/drawing_blend.h"
+
+void DrawingBlend_PremultiplyMaxRow(DWORD* dest, const BYTE* coverage, int count,
+                                    int r, int g, int b) {
+    ULONGLONG color = DrawingBlend_ColorLanes(r, g, b);
+    for (int i = 0; i < count; i++) {
+        BYTE alpha = coverage[i];
+        DWORD pixel = DrawingBlend_Premultiply(color, alpha);
+        /* A select rather than a branch: coverage edges mispredict */
+        dest[i] = alpha > (dest[i] >> 24) ? pixel : dest[i];
+    }
+}
+
+void DrawingBlend_PremultiplyMaxColorsRow(DWORD* dest, const BYTE* coverage,
+                                          const COLORREF* colors, int count) {
+    for (int i = 0; i < count; i++) {
+        BYTE alpha = coverage[i];
+        COLORREF c = colors[i];
+        DWORD pixel = DrawingBlend_Premultiply(
+            DrawingBlend_ColorLanes(GetRValue(c), GetGValue(c), GetBValue(c)), alpha);
+        dest[i] = alpha > (dest[i] >> 24) ? pixel : dest[i];
+    }
+}
+
+void DrawingBlend_OverRow(DWORD* dest, const BYTE* coverage, int count,
+                          int r, int g, int b) {
+    ULONGLONG color = DrawingBlend_ColorLanes(r, g, b);
+    for (int i = 0; i < count; i++) {
+        BYTE alpha = coverage[i];
+        if (alpha != 0) dest[i] = DrawingBlend_Over(dest[i], color, alpha);
+    }
+}
+
+void DrawingBlend_AddRow(DWORD* dest, const BYTE* coverage, int count,
+                         int r, int g, int b) {
+    for (int i = 0; i < count; i++) {
+        BYTE alpha = coverage[i];
+        if (alpha != 0) dest[i] = DrawingBlend_Add(dest[i], r, g, b, alpha);
+    }
+}
+
+void DrawingBlend_LerpRow(DWORD* dest, const BYTE* coverage, int count,
+                          int r, int g, int b) {
+    for (int i = 0; i < count; i++) {
+        BYTE alpha = coverage[i];
+        if (alpha != 0) dest[i] = DrawingBlend_Lerp(dest[i], r, g, b, alpha);
+    }
+}
@@ -0,0 +1,289 @@
+/**
+ * @file drawing_dib_pool.c
+ * @brief Size-bucketed DIB section pool with a global byte budget.
+ *
+ * Idle surfaces sit in per-size-class LIFO lists so the most recently used
+ * fit is handed out first. Each DC keeps one SaveDC level recorded right
+ * after its bitmap was selected; RestoreDC on release undoes whatever the
+ * lessee selected or changed. Dialogs may paint on their own threads, so
+ * the lists are guarded by a lock and GDI calls happen outside it.
+ */
+
+#include "drawing/drawing_dib_pool.h"
+
+#include <stdlib.h>
+
+#define DIB_POOL_MIN_BUCKET_SHIFT 12
+#define DIB_POOL_TRIM_CHECK_MS 1000u
+#define DIB_POOL_MAX_BYTES ((size_t)1 << 30)
+
+struct DibPoolEntry {
+    DibPoolEntry* next;
+    HDC dc;
+    HBITMAP bitmap;
+    HGDIOBJ oldBitmap;
+    void* bits;
+    int width;
+    int height;
+    size_t bytes;
+    int bucket;
+    DWORD idleSince;
+};
+
+static SRWLOCK g_dibPoolLock = SRWLOCK_INIT;
+static DibPoolEntry* g_idleEntries[DIB_POOL_BUCKET_COUNT];
+static DibPoolStats g_dibPoolStats;
+static DWORD g_lastTrimCheckTick = 0;
+static BOOL g_dibPoolShutdown = FALSE;
+
+static int BucketForBytes(size_t bytes) {
+    int bucket = 0;
+    size_t classBytes = (size_t)1 << DIB_POOL_MIN_BUCKET_SHIFT;
+    while (classBytes < bytes && bucket < DIB_POOL_BUCKET_COUNT - 1) {
+        classBytes <<= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static BOOL SurfaceBytes(int width, int height, size_t* bytes) {
+    if (width <= 0 || height <= 0) return FALSE;
+    size_t pixels = (size_t)width * (size_t)height;
+    if (pixels / (size_t)width != (size_t)height || pixels > DIB_POOL_MAX_BYTES / 4u) {
+        return FALSE;
+    }
+    *bytes = pixels * 4u;
+    return TRUE;
+}
+
+static int RoundDimension(int value) {
+    int rounded = (value + DIB_POOL_GRANULARITY - 1) & ~(DIB_POOL_GRANULARITY - 1);
+    return rounded > value ? rounded : value;
+}
+
+static void DestroyEntry(DibPoolEntry* entry) {
+    if (!entry) return;
+    if (entry->dc && entry->oldBitmap) SelectObject(entry->dc, entry->oldBitmap);
+    if (entry->bitmap) DeleteObject(entry->bitmap);
+    if (entry->dc) DeleteDC(entry->dc);
+    free(entry);
+}
+
+static void DestroyEntryList(DibPoolEntry* list) {
+    while (list) {
+        DibPoolEntry* next = list->next;
+        DestroyEntry(list);
+        list = next;
+    }
+}
+
+static void UnlinkIdleLocked(DibPoolEntry** link, DibPoolEntry** destroyList) {
+    DibPoolEntry* entry = *link;
+    *link = entry->next;
+    g_dibPoolStats.idleSurfaces--;
+    g_dibPoolStats.idleBytes -= entry->bytes;
+    g_dibPoolStats.idleByBucket[entry->bucket]--;
+    if (destroyList) {
+        g_dibPoolStats.destroyed++;
+        entry->next = *destroyList;
+        *destroyList = entry;
+    }
+}
+
+/* Oldest idle surface across every size class */
+static BOOL EvictOldestLocked(DibPoolEntry** destroyList) {
+    DibPoolEntry** oldest = NULL;
+    DWORD now = GetTickCount();
+    for (int b = 0; b < DIB_POOL_BUCKET_COUNT; b++) {
+        for (DibPoolEntry** link = &g_idleEntries[b]; *link; link = &(*link)->next) {
+            if (!oldest || now - (*link)->idleSince > now - (*oldest)->idleSince) {
+                oldest = link;
+            }
+        }
+    }
+    if (!oldest) return FALSE;
+    UnlinkIdleLocked(oldest, destroyList);
+    return TRUE;
+}
+
+static void TrimIdleLocked(DWORD maxIdleMs, DWORD now, DibPoolEntry** destroyList) {
+    for (int b = 0; b < DIB_POOL_BUCKET_COUNT; b++) {
+        DibPoolEntry** link = &g_idleEntries[b];
+        while (*link) {
+            if (now - (*link)->idleSince >= maxIdleMs) {
+                UnlinkIdleLocked(link, destroyList);
+            } else {
+                link = &(*link)->next;
+            }
+        }
+    }
+}
+
+static void MaybeTrimLocked(DibPoolEntry** destroyList) {
+    DWORD now = GetTickCount();
+    if (now - g_lastTrimCheckTick < DIB_POOL_TRIM_CHECK_MS) return;
+    g_lastTrimCheckTick = now;
+    TrimIdleLocked(DIB_POOL_IDLE_TRIM_MS, now, destroyList);
+}
+
+static BOOL EntryFits(const DibPoolEntry* entry, int width, int height,
+                      UINT flags, size_t requestedBytes) {
+    if (entry->width < width || entry->height < height) return FALSE;
+    if ((flags & DIB_POOL_EXACT_WIDTH) && entry->width != width) return FALSE;
+    if ((flags & DIB_POOL_EXACT_HEIGHT) && entry->height != height) return FALSE;
+    return entry->bytes / DIB_POOL_SHRINK_THRESHOLD_MULTIPLIER <= requestedBytes;
+}
+
+/* The shrink threshold bounds a fit to two size classes above the request */
+static DibPoolEntry* TakeIdleLocked(int width, int height, UINT flags,
+                                    size_t bytes, size_t roundedBytes) {
+    int last = BucketForBytes(roundedBytes) + 2;
+    for (int b = BucketForBytes(bytes); b < DIB_POOL_BUCKET_COUNT && b <= last; b++) {
+        for (DibPoolEntry** link = &g_idleEntries[b]; *link; link = &(*link)->next) {
+            if (!EntryFits(*link, width, height, flags, roundedBytes)) continue;
+            DibPoolEntry* entry = *link;
+            UnlinkIdleLocked(link, NULL);
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static DibPoolEntry* CreateEntry(int width, int height, size_t bytes) {
+    DibPoolEntry* entry = (DibPoolEntry*)calloc(1, sizeof(DibPoolEntry));
+    if (!entry) return NULL;
+    BITMAPINFO info;
+    ZeroMemory(&info, sizeof(info));
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    entry->dc = CreateCompatibleDC(NULL);
+    entry->bitmap = entry->dc
+        ? CreateDIBSection(entry->dc, &info, DIB_RGB_COLORS, &entry->bits, NULL, 0) : NULL;
+    entry->oldBitmap = entry->bitmap && entry->bits
+        ? SelectObject(entry->dc, entry->bitmap) : NULL;
+    if (!entry->oldBitmap || entry->oldBitmap == HGDI_ERROR || SaveDC(entry->dc) == 0) {
+        if (entry->oldBitmap == HGDI_ERROR) entry->oldBitmap = NULL;
+        DestroyEntry(entry);
+        return NULL;
+    }
+    entry->width = width;
+    entry->height = height;
+    entry->bytes = bytes;
+    entry->bucket = BucketForBytes(bytes);
+    return entry;
+}
+
+BOOL DibPool_Acquire(int width, int height, UINT flags, DibSurface* surface) {
+    if (!surface) return FALSE;
+    ZeroMemory(surface, sizeof(*surface));
+    size_t bytes = 0;
+    if (!SurfaceBytes(width, height, &bytes)) return FALSE;
+    int createWidth = (flags & DIB_POOL_EXACT_WIDTH) ? width : RoundDimension(width);
+    int createHeight = (flags & DIB_POOL_EXACT_HEIGHT) ? height : RoundDimension(height);
+    size_t createBytes = 0;
+    if (!SurfaceBytes(createWidth, createHeight, &createBytes)) {
+        createWidth = width;
+        createHeight = height;
+        createBytes = bytes;
+    }
+
+    DibPoolEntry* destroyList = NULL;
+    AcquireSRWLockExclusive(&g_dibPoolLock);
+    MaybeTrimLocked(&destroyList);
+    DibPoolEntry* entry = TakeIdleLocked(width, height, flags, bytes, createBytes);
+    BOOL reused = entry != NULL;
+    if (!reused) {
+        /* Idle surfaces give way before a new one pushes past the budget */
+        while (g_dibPoolStats.leasedBytes + g_dibPoolStats.idleBytes + createBytes >
+                   DIB_POOL_BUDGET_BYTES &&
+               EvictOldestLocked(&destroyList)) {
+        }
+    }
+    ReleaseSRWLockExclusive(&g_dibPoolLock);
+    DestroyEntryList(destroyList);
+
+    if (!entry) {
+        entry = CreateEntry(createWidth, createHeight, createBytes);
+        if (!entry) return FALSE;
+    }
+
+    AcquireSRWLockExclusive(&g_dibPoolLock);
+    if (reused) {
+        g_dibPoolStats.reused++;
+    } else {
+        g_dibPoolStats.created++;
+    }
+    g_dibPoolStats.leasedSurfaces++;
+    g_dibPoolStats.leasedBytes += entry->bytes;
+    ReleaseSRWLockExclusive(&g_dibPoolLock);
+
+    surface->dc = entry->dc;
+    surface->bitmap = entry->bitmap;
+    surface->bits = entry->bits;
+    surface->width = entry->width;
+    surface->height = entry->height;
+    surface->entry = entry;
+    return TRUE;
+}
+
+void DibPool_Release(DibSurface* surface) {
+    if (!surface || !surface->entry) return;
+    DibPoolEntry* entry = surface->entry;
+    ZeroMemory(surface, sizeof(*surface));
+
+    /* Pop back to the state saved at creation, then save it again */
+    BOOL reset = RestoreDC(entry->dc, -1) && SaveDC(entry->dc) != 0;
+
+    DibPoolEntry* destroyList = NULL;
+    AcquireSRWLockExclusive(&g_dibPoolLock);
+    g_dibPoolStats.leasedSurfaces--;
+    g_dibPoolStats.leasedBytes -= entry->bytes;
+    MaybeTrimLocked(&destroyList);
+    BOOL keep = reset && !g_dibPoolShutdown;
+    while (keep && (g_dibPoolStats.idleSurfaces >= DIB_POOL_MAX_IDLE_SURFACES ||
+                    g_dibPoolStats.leasedBytes + g_dibPoolStats.idleBytes + entry->bytes >
+                        DIB_POOL_BUDGET_BYTES)) {
+        keep = EvictOldestLocked(&destroyList);
+    }
+    if (keep) {
+        entry->idleSince = GetTickCount();
+        entry->next = g_idleEntries[entry->bucket];
+        g_idleEntries[entry->bucket] = entry;
+        g_dibPoolStats.idleSurfaces++;
+        g_dibPoolStats.idleBytes += entry->bytes;
+        g_dibPoolStats.idleByBucket[entry->bucket]++;
+    } else {
+        g_dibPoolStats.destroyed++;
+        entry->next = destroyList;
+        destroyList = entry;
+    }
+    ReleaseSRWLockExclusive(&g_dibPoolLock);
+    DestroyEntryList(destroyList);
+}
+
+void DibPool_Trim(DWORD maxIdleMs) {
+    DibPoolEntry* destroyList = NULL;
+    AcquireSRWLockExclusive(&g_dibPoolLock);
+    TrimIdleLocked(maxIdleMs, GetTickCount(), &destroyList);
+    ReleaseSRWLockExclusive(&g_dibPoolLock);
+    DestroyEntryList(destroyList);
+}
+
+void DibPool_GetStats(DibPoolStats* stats) {
+    if (!stats) return;
+    AcquireSRWLockShared(&g_dibPoolLock);
+    *stats = g_dibPoolStats;
+    ReleaseSRWLockShared(&g_dibPoolLock);
+    stats->gdiObjects = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS);
+}
+
+void DibPool_Shutdown(void) {
+    AcquireSRWLockExclusive(&g_dibPoolLock);
+    g_dibPoolShutdown = TRUE;
+    ReleaseSRWLockExclusive(&g_dibPoolLock);
+    DibPool_Trim(0);
+}
@@ -0,0 +1,29 @@
+/**
+ * @file drawing_dib_pool_paint.c
+ * @brief Pooled double buffers for WM_PAINT and owner-draw handlers.
+ */
+
+#include "drawing/drawing_dib_pool.h"
+
+HDC DibPool_BeginPaintBuffer(HDC target, int x, int y, int width, int height,
+                             DibPaintBuffer* paint) {
+    if (!paint) return target;
+    ZeroMemory(paint, sizeof(*paint));
+    paint->target = target;
+    paint->x = x;
+    paint->y = y;
+    paint->width = width;
+    paint->height = height;
+    if (!target || width <= 0 || height <= 0 ||
+        !DibPool_Acquire(width, height, 0, &paint->surface)) {
+        return target;
+    }
+    return paint->surface.dc;
+}
+
+void DibPool_EndPaintBuffer(DibPaintBuffer* paint) {
+    if (!paint || !paint->surface.dc) return;
+    BitBlt(paint->target, paint->x, paint->y, paint->width, paint->height,
+           paint->surface.dc, 0, 0, SRCCOPY);
+    DibPool_Release(&paint->surface);
+}
@@ -4,40 +4,11 @@
 #include <windows.h>
 #include "drawing/drawing_effect.h"
 #include "drawing/drawing_effect_common.h"
+#include "drawing/drawing_effect_aqua_internal.h"
+#include "drawing/drawing_effect_tiles.h"
 
-#define EFFECT_BUFFER_SHRINK_RATIO 4
-#define EFFECT_BUFFER_SHRINK_DELAY_MS 5000ULL
-#define EFFECT_BUFFER_SHRINK_MIN_SIZE (256 * 1024)
 #define EFFECT_BUFFER_MAX_PIXELS (4096 * 4096)
 
-static unsigned char* g_effectBuffer1 = NULL;
-static unsigned char* g_effectBuffer2 = NULL;
-static unsigned char* g_effectBuffer3 = NULL;
-static int g_effectBufferSize = 0;
-static ULONGLONG g_effectShrinkCandidateTick = 0;
-static INIT_ONCE g_effectBufferLockOnce = INIT_ONCE_STATIC_INIT;
-static CRITICAL_SECTION g_effectBufferCS;
-
-static BOOL CALLBACK InitEffectBufferLock(PINIT_ONCE initOnce, PVOID parameter, PVOID* context) {
-    (void)initOnce;
-    (void)parameter;
-    (void)context;
-    InitializeCriticalSection(&g_effectBufferCS);
-    return TRUE;
-}
-
-BOOL DrawingEffect_BeginBufferUse(void) {
-    if (!InitOnceExecuteOnce(&g_effectBufferLockOnce, InitEffectBufferLock, NULL, NULL)) {
-        return FALSE;
-    }
-    EnterCriticalSection(&g_effectBufferCS);
-    return TRUE;
-}
-
-void DrawingEffect_EndBufferUse(void) {
-    LeaveCriticalSection(&g_effectBufferCS);
-}
-
 BOOL DrawingEffect_CalculateBufferSize(int w, int h, int padding,
                                        int* outGw, int* outGh,
                                        int* outNeededSize) {
@@ -66,83 +37,6 @@ BOOL DrawingEffect_CalculateBufferSize(int w, int h, int padding,
     return TRUE;
 }
 
-static void FreeEffectBuffers(void) {
-    if (g_effectBuffer1) { free(g_effectBuffer1); g_effectBuffer1 = NULL; }
-    if (g_effectBuffer2) { free(g_effectBuffer2); g_effectBuffer2 = NULL; }
-    if (g_effectBuffer3) { free(g_effectBuffer3); g_effectBuffer3 = NULL; }
-    g_effectBufferSize = 0;
-    g_effectShrinkCandidateTick = 0;
-}
-
-static void ResetEffectBufferShrinkCandidate(void) {
-    g_effectShrinkCandidateTick = 0;
-}
-
-static void MaybeShrinkOversizedEffectBuffers(int neededSize) {
-    if (g_effectBufferSize < EFFECT_BUFFER_SHRINK_MIN_SIZE ||
-        neededSize > g_effectBufferSize / EFFECT_BUFFER_SHRINK_RATIO ||
-        !g_effectBuffer1 || !g_effectBuffer2 || !g_effectBuffer3) {
-        ResetEffectBufferShrinkCandidate();
-        return;
-    }
-
-    ULONGLONG now = GetTickCount64();
-    if (g_effectShrinkCandidateTick == 0) {
-        g_effectShrinkCandidateTick = now;
-        return;
-    }
-
-    if (now - g_effectShrinkCandidateTick >= EFFECT_BUFFER_SHRINK_DELAY_MS) {
-        FreeEffectBuffers();
-    }
-}
-
-static BOOL EnsureEffectBuffers(int neededSize) {
-    if (neededSize <= 0) return FALSE;
-    if (neededSize <= g_effectBufferSize &&
-        g_effectBuffer1 && g_effectBuffer2 && g_effectBuffer3) {
-        MaybeShrinkOversizedEffectBuffers(neededSize);
-        if (neededSize <= g_effectBufferSize &&
-            g_effectBuffer1 && g_effectBuffer2 && g_effectBuffer3) {
-            return TRUE;
-        }
-    } else {
-        ResetEffectBufferShrinkCandidate();
-    }
-
-    unsigned char* newBuffer1 = (unsigned char*)malloc((size_t)neededSize);
-    unsigned char* newBuffer2 = (unsigned char*)malloc((size_t)neededSize);
-    unsigned char* newBuffer3 = (unsigned char*)malloc((size_t)neededSize);
-
-    if (!newBuffer1 || !newBuffer2 || !newBuffer3) {
-        free(newBuffer1);
-        free(newBuffer2);
-        free(newBuffer3);
-        return FALSE;
-    }
-
-    FreeEffectBuffers();
-    g_effectBuffer1 = newBuffer1;
-    g_effectBuffer2 = newBuffer2;
-    g_effectBuffer3 = newBuffer3;
-    g_effectBufferSize = neededSize;
-    return TRUE;
-}
-
-BOOL DrawingEffect_EnsureBuffers(int neededSize, DrawingEffectBuffers* outBuffers) {
-    if (!outBuffers) return FALSE;
-    ZeroMemory(outBuffers, sizeof(*outBuffers));
-
-    if (!EnsureEffectBuffers(neededSize)) {
-        return FALSE;
-    }
-
-    outBuffers->buffer1 = g_effectBuffer1;
-    outBuffers->buffer2 = g_effectBuffer2;
-    outBuffers->buffer3 = g_effectBuffer3;
-    return TRUE;
-}
-
 static BOOL CalculateBlurPixelCount(int w, int h, size_t* outPixelCount) {
     if (!outPixelCount || w <= 0 || h <= 0) return FALSE;
 
@@ -259,6 +153,9 @@ void ApplyGaussianBlur(unsigned char* src, unsigned char* dest, unsigned char* t
 
 void CleanupDrawingEffects(void) {
     if (!DrawingEffect_BeginBufferUse()) return;
-    FreeEffectBuffers();
+    DrawingEffectTiles_Shutdown();
+    DrawingEffect_FreeScratch();
+    AquaNoiseTexture_Free();
+    AquaGlyphCache_Free();
     DrawingEffect_EndBufferUse();
 }
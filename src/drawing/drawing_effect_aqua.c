@@ -4,56 +4,15 @@
 #include "drawing/drawing_effect.h"
 #include "drawing/drawing_effect_common.h"
 #include "drawing/drawing_effect_aqua_internal.h"
-#define AQUA_RIPPLE_FLOW_MS 14000U
-#define AQUA_RIPPLE_FLOW_CYCLES 7
-#define AQUA_NOISE_FIXED_ONE 256
-#define AQUA_NOISE_SAMPLE_STEP 2
-static void BuildAquaNoiseMap(unsigned char* noiseMap, unsigned char* coarseMap, int gw, int gh, int noiseFirstI, int noiseLastI, int noiseFirstJ, int noiseLastJ, long long startX, long long startY, int freqXPpm, int freqYPpm, int flowQ8, int sampleStep) {
-    const int step = AquaClampInt(sampleStep, AQUA_NOISE_SAMPLE_STEP, 4);
-    int coarseFirstI = AquaClampInt(noiseFirstI / step - 1, 0, (gw + step - 1) / step);
-    int coarseLastI = AquaClampInt((noiseLastI + step - 1) / step + 1, 0, (gw + step - 1) / step);
-    int coarseFirstJ = AquaClampInt(noiseFirstJ / step - 1, 0, (gh + step - 1) / step);
-    int coarseLastJ = AquaClampInt((noiseLastJ + step - 1) / step + 1, 0, (gh + step - 1) / step);
-    int coarseW = coarseLastI - coarseFirstI;
-    int coarseH = coarseLastJ - coarseFirstJ;
-    if (coarseW <= 1 || coarseH <= 1) {
-        for (int j = noiseFirstJ; j < noiseLastJ; j++) {
-            int screenY = (int)(startY + (long long)j);
-            unsigned char* noiseRow = noiseMap + (size_t)j * (size_t)gw;
-            for (int i = noiseFirstI; i < noiseLastI; i++) {
-                int screenX = (int)(startX + (long long)i);
-                noiseRow[i] = (unsigned char)AquaFractalNoise(screenX, screenY, freqXPpm, freqYPpm, flowQ8, 11u);
-            }
-        }
-        return;
-    }
-    for (int cy = 0; cy < coarseH; cy++) {
-        int fullY = (coarseFirstJ + cy) * step;
-        int screenY = (int)(startY + (long long)fullY);
-        unsigned char* coarseRow = coarseMap + (size_t)cy * (size_t)coarseW;
-        for (int cx = 0; cx < coarseW; cx++) {
-            int fullX = (coarseFirstI + cx) * step;
-            int screenX = (int)(startX + (long long)fullX);
-            coarseRow[cx] = (unsigned char)AquaFractalNoise(screenX, screenY, freqXPpm, freqYPpm, flowQ8, 11u);
-        }
-    }
+/* One flow period scrolls the whole texture: 0.5 lattice cells per second */
+#define AQUA_RIPPLE_FLOW_MS 112000U
+/* One texel row per phase (about 0.9 px); frames crossfade between phases */
+#define AQUA_RIPPLE_FLOW_PHASES AQUA_TEXTURE_HEIGHT
+#define AQUA_NOISE_FREQ_X_PPM 8000
+#define AQUA_NOISE_FREQ_Y_PPM 70000
+static void BuildAquaNoiseMap(const unsigned char* texture, unsigned char* noiseMap, int gw, int noiseFirstI, int noiseLastI, int noiseFirstJ, int noiseLastJ, long long startX, long long startY, int flowQ8) {
     for (int j = noiseFirstJ; j < noiseLastJ; j++) {
-        int coarseY = j / step;
-        int y0 = AquaClampInt(coarseY - coarseFirstJ, 0, coarseH - 1);
-        int y1 = AquaClampInt(y0 + 1, 0, coarseH - 1);
-        int ty = ((j - coarseY * step) << 8) / step;
-        unsigned char* noiseRow = noiseMap + (size_t)j * (size_t)gw;
-        const unsigned char* coarseRow0 = coarseMap + (size_t)y0 * (size_t)coarseW;
-        const unsigned char* coarseRow1 = coarseMap + (size_t)y1 * (size_t)coarseW;
-        for (int i = noiseFirstI; i < noiseLastI; i++) {
-            int coarseX = i / step;
-            int x0 = AquaClampInt(coarseX - coarseFirstI, 0, coarseW - 1);
-            int x1 = AquaClampInt(x0 + 1, 0, coarseW - 1);
-            int tx = ((i - coarseX * step) << 8) / step;
-            int top = AquaLerpByte256(coarseRow0[x0], coarseRow0[x1], tx);
-            int bottom = AquaLerpByte256(coarseRow1[x0], coarseRow1[x1], tx);
-            noiseRow[i] = (unsigned char)AquaLerpByte256(top, bottom, ty);
-        }
+        AquaNoiseTexture_SampleRow(texture, noiseMap + (size_t)j * (size_t)gw + noiseFirstI, noiseLastI - noiseFirstI, startX + noiseFirstI, startY + j, AQUA_NOISE_FREQ_X_PPM, AQUA_NOISE_FREQ_Y_PPM, flowQ8);
     }
 }
 static inline void GetAquaPixelColor(int screenX, int screenY, int baseR, int baseG, int baseB, GlowColorCallback colorCb, void* userData, int* outR, int* outG, int* outB) {
@@ -105,63 +64,87 @@ static inline void BlendPremultipliedBody(DWORD* pixel, int r, int g, int b, int
              ((DWORD)AquaClampByte(outG) << 8) |
              (DWORD)AquaClampByte(outB);
 }
-void RenderAquaEffect(DWORD* pixels, int destWidth, int destHeight, int x_pos, int y_pos, const unsigned char* bitmap, int w, int h, int r, int g, int b, GlowColorCallback colorCb, void* userData, int timeOffset) {
-    if (!pixels || !bitmap || destWidth <= 0 || destHeight <= 0) return;
-    int displacementScale = AquaClampInt((h + 2) / 8, 5, (h >= 160) ? 14 : 22);
-    int shadowOffset = AquaClampInt((h + 9) / 18, 3, 8);
-    int glowBlur = AquaClampInt((h + 5) / 14, (h >= 120) ? 3 : 4, (h >= 160) ? 5 : 14);
-    int padding = displacementScale + shadowOffset + glowBlur + 4;
-    int gw = 0;
-    int gh = 0;
-    int neededSize = 0;
-    if (!DrawingEffect_CalculateBufferSize(w, h, padding, &gw, &gh, &neededSize)) {
-        return;
-    }
-    long long startX = (long long)x_pos - (long long)padding;
-    long long startY = (long long)y_pos - (long long)padding;
-    int firstI = 0;
-    int lastI = 0;
-    int firstJ = 0;
-    int lastJ = 0;
-    if (!DrawingEffect_CalculateVisibleSpan(startX, gw, destWidth, &firstI, &lastI) || !DrawingEffect_CalculateVisibleSpan(startY, gh, destHeight, &firstJ, &lastJ)) {
-        return;
+typedef struct {
+    const unsigned char* bitmap;
+    int w;
+    int h;
+    int padding;
+    int displacementScale;
+    int glowBlur;
+    int gw;
+    int gh;
+    int neededSize;
+    long long startX;
+    long long startY;
+} AquaGlyphLayout;
+typedef struct {
+    const unsigned char* body;
+    const unsigned char* glow;
+    BOOL cached;
+} AquaGlyphMaps;
+static void CompositeAquaGlyph(DWORD* pixels, int destWidth, const AquaGlyphLayout* layout, int firstI, int lastI, int firstJ, int lastJ, int shadowOffset, const AquaGlyphMaps* from, const AquaGlyphMaps* to, int blend, int r, int g, int b, GlowColorCallback colorCb, void* userData) {
+    int gw = layout->gw;
+    for (int j = firstJ; j < lastJ; j++) {
+        int shadowJ = j - shadowOffset;
+        BOOL hasGlow = shadowJ >= 0 && shadowJ < layout->gh;
+        int screenY = (int)(layout->startY + (long long)j);
+        DWORD* destRow = pixels + (size_t)screenY * (size_t)destWidth;
+        size_t bodyOffset = (size_t)j * (size_t)gw;
+        size_t glowOffset = hasGlow ? (size_t)shadowJ * (size_t)gw : 0;
+        for (int i = firstI; i < lastI; i++) {
+            int glow = hasGlow ? from->glow[glowOffset + i] : 0;
+            int mass = from->body[bodyOffset + i];
+            if (blend > 0) {
+                if (hasGlow) glow = AquaLerpByte256(glow, to->glow[glowOffset + i], blend);
+                mass = AquaLerpByte256(mass, to->body[bodyOffset + i], blend);
+            }
+            int alpha = glow > 2 ? (glow * 90) >> 8 : 0;
+            if (alpha <= 0 && mass <= 0) continue;
+            /* Glow then body on the same pixel, so one color lookup serves both */
+            int screenX = (int)(layout->startX + (long long)i);
+            int colorR = r;
+            int colorG = g;
+            int colorB = b;
+            GetAquaPixelColor(screenX, screenY, r, g, b, colorCb, userData, &colorR, &colorG, &colorB);
+            AddPremultipliedGlow(destRow + screenX, colorR, colorG, colorB, alpha);
+            BlendPremultipliedBody(destRow + screenX, colorR, colorG, colorB, mass);
+        }
     }
-    if (firstI < 1) firstI = 1;
-    if (lastI > gw - 1) lastI = gw - 1;
-    if (firstJ < 1) firstJ = 1;
-    if (lastJ > gh - 1) lastJ = gh - 1;
-    if (firstI >= lastI || firstJ >= lastJ) {
-        return;
+}
+static BOOL BuildAquaGlyphMaps(const AquaGlyphLayout* layout, const AquaGlyphKey* key, AquaGlyphMaps* maps) {
+    const unsigned char* cached = AquaGlyphCache_Find(key, layout->gw, layout->gh);
+    if (cached) {
+        maps->body = cached;
+        maps->glow = cached + (size_t)layout->gw * (size_t)layout->gh;
+        maps->cached = TRUE;
+        return TRUE;
     }
-    if (!DrawingEffect_BeginBufferUse()) return;
     DrawingEffectBuffers buffers;
-    if (!DrawingEffect_EnsureBuffers(neededSize, &buffers)) {
-        DrawingEffect_EndBufferUse();
-        return;
-    }
+    const unsigned char* texture = AquaNoiseTexture_Acquire();
+    if (!texture || !DrawingEffect_EnsureBuffers(layout->neededSize, &buffers)) return FALSE;
+    int gw = layout->gw;
+    int gh = layout->gh;
+    int padding = layout->padding;
+    int displacementScale = layout->displacementScale;
     unsigned char* alphaMap = buffers.buffer1;
     unsigned char* glowMap = buffers.buffer2;
     unsigned char* noiseMap = buffers.buffer2;
     unsigned char* displacedMap = buffers.buffer3;
-    memset(alphaMap, 0, (size_t)neededSize);
-    for (int j = 0; j < h; j++) {
-        memcpy(alphaMap + (j + padding) * gw + padding, bitmap + (size_t)j * (size_t)w, (size_t)w);
+    memset(alphaMap, 0, (size_t)layout->neededSize);
+    for (int j = 0; j < layout->h; j++) {
+        memcpy(alphaMap + (j + padding) * gw + padding, layout->bitmap + (size_t)j * (size_t)layout->w, (size_t)layout->w);
     }
-    unsigned int timeMs = (unsigned int)timeOffset;
-    int freqXPpm = 8000;
-    int freqYPpm = 70000;
-    int noiseSampleStep = (h >= 160) ? 4 : ((h >= 80) ? 3 : AQUA_NOISE_SAMPLE_STEP);
-    int flowQ8 = (int)(((unsigned long long)(timeMs % AQUA_RIPPLE_FLOW_MS) * AQUA_NOISE_FIXED_ONE * AQUA_RIPPLE_FLOW_CYCLES) / AQUA_RIPPLE_FLOW_MS);
+    int flowQ8 = key->flowPhase * 256;
     int displaceFirstI = AquaClampInt(padding - displacementScale - 2, 1, gw - 1);
-    int displaceLastI = AquaClampInt(padding + w + displacementScale + 2, 1, gw - 1);
+    int displaceLastI = AquaClampInt(padding + layout->w + displacementScale + 2, 1, gw - 1);
     int displaceFirstJ = AquaClampInt(padding - displacementScale - 2, 1, gh - 1);
-    int displaceLastJ = AquaClampInt(padding + h + displacementScale + 2, 1, gh - 1);
+    int displaceLastJ = AquaClampInt(padding + layout->h + displacementScale + 2, 1, gh - 1);
     int noiseFirstI = AquaClampInt(displaceFirstI - 18, 0, gw);
     int noiseLastI = AquaClampInt(displaceLastI + 14, 0, gw);
     int noiseFirstJ = AquaClampInt(displaceFirstJ - 12, 0, gh);
     int noiseLastJ = AquaClampInt(displaceLastJ + 12, 0, gh);
-    BuildAquaNoiseMap(noiseMap, displacedMap, gw, gh, noiseFirstI, noiseLastI, noiseFirstJ, noiseLastJ, startX, startY, freqXPpm, freqYPpm, flowQ8, noiseSampleStep);
-    memset(displacedMap, 0, (size_t)neededSize);
+    BuildAquaNoiseMap(texture, noiseMap, gw, noiseFirstI, noiseLastI, noiseFirstJ, noiseLastJ, layout->startX, layout->startY, flowQ8);
+    memset(displacedMap, 0, (size_t)layout->neededSize);
     for (int j = displaceFirstJ; j < displaceLastJ; j++) {
         unsigned char* displacedRow = displacedMap + (size_t)j * (size_t)gw;
         const unsigned char* noiseRow = noiseMap + (size_t)j * (size_t)gw;
@@ -184,40 +167,66 @@ void RenderAquaEffect(DWORD* pixels, int destWidth, int destHeight, int x_pos, i
             displacedRow[i] = (unsigned char)AquaErodedAlpha(displaced, poreNoise, displacementNoise);
         }
     }
-    ApplyGaussianBlur(displacedMap, glowMap, alphaMap, gw, gh, glowBlur);
-    for (int j = firstJ; j < lastJ; j++) {
-        int shadowJ = j - shadowOffset;
-        if (shadowJ < 0 || shadowJ >= gh) continue;
-        int screenY = (int)(startY + (long long)j);
-        DWORD* destRow = pixels + (size_t)screenY * (size_t)destWidth;
-        const unsigned char* glowRow = glowMap + (size_t)shadowJ * (size_t)gw;
-        for (int i = firstI; i < lastI; i++) {
-            int glow = glowRow[i];
-            if (glow <= 2) continue;
-            int alpha = (glow * 90) >> 8;
-            if (alpha <= 0) continue;
-            int screenX = (int)(startX + (long long)i);
-            int glowR = r;
-            int glowG = g;
-            int glowB = b;
-            GetAquaPixelColor(screenX, screenY, r, g, b, colorCb, userData, &glowR, &glowG, &glowB);
-            AddPremultipliedGlow(destRow + screenX, glowR, glowG, glowB, alpha);
-        }
+    ApplyGaussianBlur(displacedMap, glowMap, alphaMap, gw, gh, layout->glowBlur);
+    const unsigned char* stored = AquaGlyphCache_Store(key, gw, gh, displacedMap, glowMap);
+    maps->body = stored ? stored : displacedMap;
+    maps->glow = stored ? stored + (size_t)gw * (size_t)gh : glowMap;
+    maps->cached = stored != NULL;
+    return TRUE;
+}
+void RenderAquaEffect(DWORD* pixels, int destWidth, int destHeight, int x_pos, int y_pos, const unsigned char* bitmap, int w, int h, int r, int g, int b, GlowColorCallback colorCb, void* userData, int timeOffset) {
+    if (!pixels || !bitmap || destWidth <= 0 || destHeight <= 0) return;
+    AquaGlyphLayout layout;
+    layout.bitmap = bitmap;
+    layout.w = w;
+    layout.h = h;
+    layout.displacementScale = AquaClampInt((h + 2) / 8, 5, (h >= 160) ? 14 : 22);
+    int shadowOffset = AquaClampInt((h + 9) / 18, 3, 8);
+    layout.glowBlur = AquaClampInt((h + 5) / 14, (h >= 120) ? 3 : 4, (h >= 160) ? 5 : 14);
+    layout.padding = layout.displacementScale + shadowOffset + layout.glowBlur + 4;
+    if (!DrawingEffect_CalculateBufferSize(w, h, layout.padding, &layout.gw, &layout.gh, &layout.neededSize)) {
+        return;
     }
-    for (int j = firstJ; j < lastJ; j++) {
-        int screenY = (int)(startY + (long long)j);
-        DWORD* destRow = pixels + (size_t)screenY * (size_t)destWidth;
-        const unsigned char* bodyRow = displacedMap + (size_t)j * (size_t)gw;
-        for (int i = firstI; i < lastI; i++) {
-            int mass = bodyRow[i];
-            if (mass <= 0) continue;
-            int screenX = (int)(startX + (long long)i);
-            int fillR = r;
-            int fillG = g;
-            int fillB = b;
-            GetAquaPixelColor(screenX, screenY, r, g, b, colorCb, userData, &fillR, &fillG, &fillB);
-            BlendPremultipliedBody(destRow + screenX, fillR, fillG, fillB, mass);
+    layout.startX = (long long)x_pos - (long long)layout.padding;
+    layout.startY = (long long)y_pos - (long long)layout.padding;
+    int firstI = 0;
+    int lastI = 0;
+    int firstJ = 0;
+    int lastJ = 0;
+    if (!DrawingEffect_CalculateVisibleSpan(layout.startX, layout.gw, destWidth, &firstI, &lastI) || !DrawingEffect_CalculateVisibleRows(layout.startY, layout.gh, destHeight, &firstJ, &lastJ)) {
+        return;
+    }
+    if (firstI < 1) firstI = 1;
+    if (lastI > layout.gw - 1) lastI = layout.gw - 1;
+    if (firstJ < 1) firstJ = 1;
+    if (lastJ > layout.gh - 1) lastJ = layout.gh - 1;
+    if (firstI >= lastI || firstJ >= lastJ) {
+        return;
+    }
+    unsigned int phaseQ8 = (unsigned int)(((unsigned long long)((unsigned int)timeOffset % AQUA_RIPPLE_FLOW_MS) * AQUA_RIPPLE_FLOW_PHASES * 256u) / AQUA_RIPPLE_FLOW_MS);
+    int blend = (int)(phaseQ8 & 0xFFu);
+    AquaGlyphKey key;
+    key.bitmapHash = AquaGlyphCache_HashBitmap(bitmap, w, h);
+    key.startX = layout.startX;
+    key.startY = layout.startY;
+    key.width = w;
+    key.height = h;
+    key.flowPhase = (int)(phaseQ8 >> 8);
+    if (!DrawingEffect_BeginBufferUse()) return;
+    AquaGlyphMaps from;
+    AquaGlyphMaps to;
+    if (!BuildAquaGlyphMaps(&layout, &key, &from)) {
+        DrawingEffect_EndBufferUse();
+        return;
+    }
+    to = from;
+    /* The next phase would overwrite uncached maps in the shared buffers */
+    if (blend > 0 && from.cached) {
+        key.flowPhase = (key.flowPhase + 1) % AQUA_RIPPLE_FLOW_PHASES;
+        if (!BuildAquaGlyphMaps(&layout, &key, &to) || !to.cached) {
+            to = from;
         }
     }
+    CompositeAquaGlyph(pixels, destWidth, &layout, firstI, lastI, firstJ, lastJ, shadowOffset, &from, &to, blend, r, g, b, colorCb, userData);
     DrawingEffect_EndBufferUse();
 }
@@ -0,0 +1,134 @@
+/**
+ * @file drawing_effect_aqua_cache.c
+ * @brief Per-glyph cache of the eroded body and blurred glow maps of Aqua.
+ *
+ * Both maps depend only on the glyph bitmap, its screen position and the
+ * quantized flow phase, so a glyph that has not moved reuses them until the
+ * ripple advances by one phase; frames between two phases blend both
+ * entries. Entries are evicted least recently used within a byte budget and
+ * their buffers are reused, so steady-state frames rarely allocate. Each
+ * scratch slot has its own cache, so tile workers never share entries;
+ * callers hold the effect buffer lock or own their slot.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "drawing/drawing_effect_aqua_internal.h"
+#include "drawing/drawing_effect_common.h"
+
+#define AQUA_GLYPH_CACHE_ENTRIES 64
+#define AQUA_GLYPH_CACHE_BUDGET (4u * 1024u * 1024u)
+
+typedef struct {
+    AquaGlyphKey key;
+    int gw;
+    int gh;
+    unsigned char* maps;
+    size_t capacity;
+    ULONGLONG lastUse;
+    BOOL valid;
+} AquaGlyphCacheEntry;
+
+typedef struct {
+    AquaGlyphCacheEntry entries[AQUA_GLYPH_CACHE_ENTRIES];
+    size_t bytes;
+    ULONGLONG clock;
+} AquaGlyphCache;
+
+static AquaGlyphCache g_aquaGlyphCaches[DRAWING_EFFECT_SCRATCH_SLOTS];
+
+static AquaGlyphCache* CurrentCache(void) {
+    return &g_aquaGlyphCaches[DrawingEffect_GetScratchSlot()];
+}
+
+ULONGLONG AquaGlyphCache_HashBitmap(const unsigned char* bitmap, int w, int h) {
+    ULONGLONG hash = 1469598103934665603ULL;
+    size_t size = (size_t)w * (size_t)h;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bitmap[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static BOOL KeysEqual(const AquaGlyphKey* a, const AquaGlyphKey* b) {
+    return a->bitmapHash == b->bitmapHash && a->startX == b->startX &&
+           a->startY == b->startY && a->width == b->width &&
+           a->height == b->height && a->flowPhase == b->flowPhase;
+}
+
+const unsigned char* AquaGlyphCache_Find(const AquaGlyphKey* key, int gw, int gh) {
+    AquaGlyphCache* cache = CurrentCache();
+    for (int i = 0; i < AQUA_GLYPH_CACHE_ENTRIES; i++) {
+        AquaGlyphCacheEntry* entry = &cache->entries[i];
+        if (!entry->valid || entry->gw != gw || entry->gh != gh) continue;
+        if (!KeysEqual(&entry->key, key)) continue;
+        entry->lastUse = ++cache->clock;
+        return entry->maps;
+    }
+    return NULL;
+}
+
+static void ReleaseEntry(AquaGlyphCache* cache, AquaGlyphCacheEntry* entry) {
+    cache->bytes -= entry->capacity;
+    free(entry->maps);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static AquaGlyphCacheEntry* LeastRecentlyUsed(AquaGlyphCache* cache,
+                                              const AquaGlyphCacheEntry* keep) {
+    AquaGlyphCacheEntry* oldest = NULL;
+    for (int i = 0; i < AQUA_GLYPH_CACHE_ENTRIES; i++) {
+        AquaGlyphCacheEntry* entry = &cache->entries[i];
+        if (entry == keep || !entry->maps) continue;
+        if (!oldest || entry->lastUse < oldest->lastUse) oldest = entry;
+    }
+    return oldest;
+}
+
+static AquaGlyphCacheEntry* ChooseVictim(AquaGlyphCache* cache) {
+    for (int i = 0; i < AQUA_GLYPH_CACHE_ENTRIES; i++) {
+        if (!cache->entries[i].valid) return &cache->entries[i];
+    }
+    return LeastRecentlyUsed(cache, NULL);
+}
+
+const unsigned char* AquaGlyphCache_Store(const AquaGlyphKey* key, int gw, int gh,
+                                         const unsigned char* displaced,
+                                         const unsigned char* glow) {
+    size_t mapSize = (size_t)gw * (size_t)gh;
+    if (mapSize == 0 || mapSize * 2 > AQUA_GLYPH_CACHE_BUDGET / 4) return NULL;
+    AquaGlyphCache* cache = CurrentCache();
+    AquaGlyphCacheEntry* entry = ChooseVictim(cache);
+    entry->valid = FALSE;
+    if (entry->capacity < mapSize * 2) {
+        if (entry->maps) ReleaseEntry(cache, entry);
+        while (cache->bytes + mapSize * 2 > AQUA_GLYPH_CACHE_BUDGET) {
+            AquaGlyphCacheEntry* oldest = LeastRecentlyUsed(cache, entry);
+            if (!oldest) break;
+            ReleaseEntry(cache, oldest);
+        }
+        entry->maps = (unsigned char*)malloc(mapSize * 2);
+        if (!entry->maps) return NULL;
+        entry->capacity = mapSize * 2;
+        cache->bytes += entry->capacity;
+    }
+    memcpy(entry->maps, displaced, mapSize);
+    memcpy(entry->maps + mapSize, glow, mapSize);
+    entry->key = *key;
+    entry->gw = gw;
+    entry->gh = gh;
+    entry->lastUse = ++cache->clock;
+    entry->valid = TRUE;
+    return entry->maps;
+}
+
+void AquaGlyphCache_Free(void) {
+    for (int slot = 0; slot < DRAWING_EFFECT_SCRATCH_SLOTS; slot++) {
+        AquaGlyphCache* cache = &g_aquaGlyphCaches[slot];
+        for (int i = 0; i < AQUA_GLYPH_CACHE_ENTRIES; i++) {
+            if (cache->entries[i].maps) ReleaseEntry(cache, &cache->entries[i]);
+        }
+        cache->bytes = 0;
+        cache->clock = 0;
+    }
+}
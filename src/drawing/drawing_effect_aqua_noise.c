@@ -1,12 +1,5 @@
 #include "drawing/drawing_effect_aqua_internal.h"
 
-#define AQUA_NOISE_FIXED_ONE 256
-
-int AquaClampByte(int value) { return value < 0 ? 0 : value > 255 ? 255 : value; }
-int AquaClampInt(int value, int minValue, int maxValue) {
-    return value < minValue ? minValue : value > maxValue ? maxValue : value;
-}
-int AquaLerpByte256(int a, int b, int t256) { return a + (((b - a) * t256) >> 8); }
 static int SmoothStepByte(int t) { return (t * t * (768 - (t << 1))) >> 16; }
 static unsigned int AquaHashNoise(int x, int y, unsigned int seed) {
     unsigned int h = (unsigned int)x * 374761393u;
@@ -17,23 +10,21 @@ static unsigned int AquaHashNoise(int x, int y, unsigned int seed) {
 int AquaFloorFixed8(int value) {
     return value >= 0 ? value >> 8 : -(((-value) + 255) >> 8);
 }
-static int AquaValueNoiseQ8(int xQ8, int yQ8, unsigned int seed) {
+/* Lattice points wrap at the period, so the noise tiles seamlessly */
+int AquaTileableValueNoiseQ8(int xQ8, int yQ8, int periodX, int periodY,
+                             unsigned int seed) {
     int xi = AquaFloorFixed8(xQ8), yi = AquaFloorFixed8(yQ8);
     int sx = SmoothStepByte(xQ8 - (xi << 8));
     int sy = SmoothStepByte(yQ8 - (yi << 8));
-    int n00 = AquaHashNoise(xi, yi, seed) & 0xFF;
-    int n10 = AquaHashNoise(xi + 1, yi, seed) & 0xFF;
-    int n01 = AquaHashNoise(xi, yi + 1, seed) & 0xFF;
-    int n11 = AquaHashNoise(xi + 1, yi + 1, seed) & 0xFF;
+    int x0 = ((xi % periodX) + periodX) % periodX, x1 = (x0 + 1) % periodX;
+    int y0 = ((yi % periodY) + periodY) % periodY, y1 = (y0 + 1) % periodY;
+    int n00 = AquaHashNoise(x0, y0, seed) & 0xFF;
+    int n10 = AquaHashNoise(x1, y0, seed) & 0xFF;
+    int n01 = AquaHashNoise(x0, y1, seed) & 0xFF;
+    int n11 = AquaHashNoise(x1, y1, seed) & 0xFF;
     return AquaLerpByte256(AquaLerpByte256(n00, n10, sx),
                            AquaLerpByte256(n01, n11, sx), sy);
 }
-int AquaFractalNoise(int screenX, int screenY, int freqXPpm, int freqYPpm,
-                     int flowQ8, unsigned int seed) {
-    long long x = (long long)screenX * freqXPpm * AQUA_NOISE_FIXED_ONE / 1000000LL;
-    long long y = (long long)screenY * freqYPpm * AQUA_NOISE_FIXED_ONE / 1000000LL;
-    return AquaValueNoiseQ8((int)x, (int)(y - flowQ8), seed);
-}
 int AquaNoiseAt(const unsigned char* noiseMap, int width, int height, int x, int y) {
     x = AquaClampInt(x, 0, width - 1); y = AquaClampInt(y, 0, height - 1);
     return noiseMap[(size_t)y * width + (size_t)x];
@@ -0,0 +1,74 @@
+/**
+ * @file drawing_effect_aqua_texture.c
+ * @brief Precomputed, seamlessly wrapping noise texture for the Aqua effect.
+ *
+ * The value-noise lattice wraps every AQUA_TEXTURE_CELLS_X by
+ * AQUA_TEXTURE_CELLS_Y cells, so one texture covers any screen position and
+ * any flow offset. Rendering samples it bilinearly instead of hashing four
+ * lattice points per noise sample. Built lazily on first use and read-only
+ * afterwards; tile workers racing to build it keep whichever copy lands first.
+ */
+
+#include <stdlib.h>
+#include "drawing/drawing_effect_aqua_internal.h"
+
+#define AQUA_TEXTURE_SEED 11u
+#define AQUA_TEXTURE_Q16_ONE 65536LL
+
+static unsigned char* volatile g_aquaNoiseTexture = NULL;
+
+const unsigned char* AquaNoiseTexture_Acquire(void) {
+    unsigned char* current = (unsigned char*)InterlockedCompareExchangePointer(
+        (PVOID volatile*)&g_aquaNoiseTexture, NULL, NULL);
+    if (current) return current;
+    unsigned char* texture = (unsigned char*)malloc(
+        (size_t)AQUA_TEXTURE_WIDTH * (size_t)AQUA_TEXTURE_HEIGHT);
+    if (!texture) return NULL;
+    const int texelQ8 = 256 / AQUA_TEXELS_PER_CELL;
+    for (int y = 0; y < AQUA_TEXTURE_HEIGHT; y++) {
+        unsigned char* row = texture + (size_t)y * AQUA_TEXTURE_WIDTH;
+        for (int x = 0; x < AQUA_TEXTURE_WIDTH; x++) {
+            row[x] = (unsigned char)AquaTileableValueNoiseQ8(
+                x * texelQ8, y * texelQ8, AQUA_TEXTURE_CELLS_X,
+                AQUA_TEXTURE_CELLS_Y, AQUA_TEXTURE_SEED);
+        }
+    }
+    current = (unsigned char*)InterlockedCompareExchangePointer(
+        (PVOID volatile*)&g_aquaNoiseTexture, texture, NULL);
+    if (!current) return texture;
+    free(texture);
+    return current;
+}
+
+void AquaNoiseTexture_Free(void) {
+    free(InterlockedExchangePointer((PVOID volatile*)&g_aquaNoiseTexture, NULL));
+}
+
+static long long WrapQ16(long long value, int period) {
+    long long span = (long long)period * AQUA_TEXTURE_Q16_ONE;
+    value %= span;
+    return value < 0 ? value + span : value;
+}
+
+/* Texture coordinates advance in Q16 so long rows do not drift */
+void AquaNoiseTexture_SampleRow(const unsigned char* texture, unsigned char* out,
+                                int count, long long screenX, long long screenY,
+                                int freqXPpm, int freqYPpm, int flowQ8) {
+    long long stepX = (long long)freqXPpm * AQUA_TEXELS_PER_CELL * AQUA_TEXTURE_Q16_ONE / 1000000LL;
+    long long stepY = (long long)freqYPpm * AQUA_TEXELS_PER_CELL * AQUA_TEXTURE_Q16_ONE / 1000000LL;
+    long long u = WrapQ16(screenX * stepX, AQUA_TEXTURE_WIDTH);
+    long long v = WrapQ16(screenY * stepY - ((long long)flowQ8 << 8), AQUA_TEXTURE_HEIGHT);
+    int y0 = (int)(v >> 16);
+    int y1 = (y0 + 1) % AQUA_TEXTURE_HEIGHT;
+    int ty = (int)((v >> 8) & 0xFF);
+    const unsigned char* row0 = texture + (size_t)y0 * AQUA_TEXTURE_WIDTH;
+    const unsigned char* row1 = texture + (size_t)y1 * AQUA_TEXTURE_WIDTH;
+    for (int i = 0; i < count; i++, u += stepX) {
+        int x0 = (int)(u >> 16) & (AQUA_TEXTURE_WIDTH - 1);
+        int x1 = (x0 + 1) & (AQUA_TEXTURE_WIDTH - 1);
+        int tx = (int)((u >> 8) & 0xFF);
+        int top = AquaLerpByte256(row0[x0], row0[x1], tx);
+        int bottom = AquaLerpByte256(row1[x0], row1[x1], tx);
+        out[i] = (unsigned char)AquaLerpByte256(top, bottom, ty);
+    }
+}
@@ -3,6 +3,9 @@
 
 #include <windows.h>
 
+/** Slot 0 is the shared, locked scratch set; the rest belong to tile workers */
+#define DRAWING_EFFECT_SCRATCH_SLOTS 9
+
 typedef struct {
     unsigned char* buffer1;
     unsigned char* buffer2;
@@ -19,6 +22,30 @@ BOOL DrawingEffect_CalculateBufferSize(int w, int h, int padding,
 BOOL DrawingEffect_CalculateVisibleSpan(long long start, int length, int limit,
                                         int* outFirst, int* outLast);
 
+/** @brief Returns the calling thread's scratch set, sized for neededSize bytes */
 BOOL DrawingEffect_EnsureBuffers(int neededSize, DrawingEffectBuffers* outBuffers);
 
+/** @brief Frees every scratch set; caller holds the buffer lock with tiles idle */
+void DrawingEffect_FreeScratch(void);
+
+/** @brief Scratch slot of the calling thread, 0 outside tile workers */
+int DrawingEffect_GetScratchSlot(void);
+
+/**
+ * @brief Binds the calling thread to a scratch slot and clips its effect
+ *        writes to rows [rowTop, rowBottom) until DrawingEffect_LeaveTile
+ * @return FALSE if the thread's tile context could not be allocated
+ */
+BOOL DrawingEffect_EnterTile(int slot, int rowTop, int rowBottom);
+void DrawingEffect_LeaveTile(void);
+
+/** @brief Narrows [*top, *bottom) to the current tile's rows, if any */
+void DrawingEffect_ClipRows(int* top, int* bottom);
+
+/**
+ * @brief DrawingEffect_CalculateVisibleSpan for rows, also clipped to the tile
+ */
+BOOL DrawingEffect_CalculateVisibleRows(long long start, int length, int limit,
+                                        int* outFirst, int* outLast);
+
 #endif /* DRAWING_EFFECT_COMMON_H */
@@ -1,10 +1,9 @@
 #include <string.h>
 #include <windows.h>
+#include "drawing/drawing_blend.h"
 #include "drawing/drawing_effect.h"
 #include "drawing/drawing_effect_common.h"
 
-#define DIV255(x) (((x) + 1 + ((x) >> 8)) >> 8)
-
 void RenderGlassEffect(DWORD* pixels, int destWidth, int destHeight,
                       int x_pos, int y_pos,
                       const unsigned char* bitmap, int w, int h,
@@ -28,7 +27,7 @@ void RenderGlassEffect(DWORD* pixels, int destWidth, int destHeight,
     int firstJ = 0;
     int lastJ = 0;
     if (!DrawingEffect_CalculateVisibleSpan(startX, gw, destWidth, &firstI, &lastI) ||
-        !DrawingEffect_CalculateVisibleSpan(startY, gh, destHeight, &firstJ, &lastJ)) {
+        !DrawingEffect_CalculateVisibleRows(startY, gh, destHeight, &firstJ, &lastJ)) {
         return;
     }
 
@@ -92,23 +91,22 @@ void RenderGlassEffect(DWORD* pixels, int destWidth, int destHeight,
             int bodyB = b;
             if (colorCb) colorCb(screenX, screenY, &bodyR, &bodyG, &bodyB, userData);
 
+            /* Color blends go through source-over lanes; alpha only ever
+             * takes the max, so the A lane of each blend is discarded */
             DWORD* pPixel = pDestRow + screenX;
-            DWORD bgPixel = *pPixel;
-            int finalA = (bgPixel >> 24) & 0xFF;
-            int finalR = (bgPixel >> 16) & 0xFF;
-            int finalG = (bgPixel >> 8) & 0xFF;
-            int finalB = bgPixel & 0xFF;
+            DWORD color = *pPixel;
+            int finalA = (color >> 24) & 0xFF;
 
             if (shadowVal > 0 && srcAlpha < 255) {
-                int shadowColor = 0;
                 int shadowOpacity = (shadowVal * 100) / 255;
-                int invShadow = 255 - shadowOpacity;
-                finalR = (finalR * invShadow + shadowColor * shadowOpacity) / 255;
-                finalG = (finalG * invShadow + shadowColor * shadowOpacity) / 255;
-                finalB = (finalB * invShadow + shadowColor * shadowOpacity) / 255;
+                color = DrawingBlend_Over(color, DrawingBlend_ColorLanes(0, 0, 0),
+                                          (BYTE)shadowOpacity);
                 finalA = max(finalA, shadowOpacity);
             }
 
+            int fireR = 0;
+            int fireG = 0;
+            int fireB = 0;
             if (srcAlpha > 0) {
                 int valUL = 0;
                 int valDR = 0;
@@ -119,19 +117,13 @@ void RenderGlassEffect(DWORD* pixels, int destWidth, int destHeight,
                 int refraction = (int)srcAlpha - (int)valDR;
 
                 int bodyAlpha = 15 + sheen;
-                int invBodyAlpha = 255 - bodyAlpha;
-
-                finalR = DIV255(finalR * invBodyAlpha + bodyR * bodyAlpha);
-                finalG = DIV255(finalG * invBodyAlpha + bodyG * bodyAlpha);
-                finalB = DIV255(finalB * invBodyAlpha + bodyB * bodyAlpha);
+                ULONGLONG body = DrawingBlend_ColorLanes(bodyR, bodyG, bodyB);
+                color = DrawingBlend_Over(color, body, (BYTE)bodyAlpha);
                 finalA = max(finalA, bodyAlpha);
 
                 if (refraction > 50) {
                     int rimA = refraction >> 1;
-                    int invRimA = 255 - rimA;
-                    finalR = DIV255(finalR * invRimA + bodyR * rimA);
-                    finalG = DIV255(finalG * invRimA + bodyG * rimA);
-                    finalB = DIV255(finalB * invRimA + bodyB * rimA);
+                    color = DrawingBlend_Over(color, body, (BYTE)rimA);
                     finalA = max(finalA, rimA);
                 }
 
@@ -142,19 +134,18 @@ void RenderGlassEffect(DWORD* pixels, int destWidth, int destHeight,
                     if (spec > 255) spec = 255;
 
                     if (spec > 0) {
-                        int fireR = spec;
-                        int fireG = spec;
-                        int fireB = spec + (spec / 6);
+                        fireR = spec;
+                        fireG = spec;
+                        fireB = spec + (spec / 6);
                         if (fireB > 255) fireB = 255;
-
-                        finalR += fireR;
-                        finalG += fireG;
-                        finalB += fireB;
                         finalA = max(finalA, spec);
                     }
                 }
             }
 
+            int finalR = (int)((color >> 16) & 0xFF) + fireR;
+            int finalG = (int)((color >> 8) & 0xFF) + fireG;
+            int finalB = (int)(color & 0xFF) + fireB;
             if (finalR > 255) finalR = 255;
             if (finalG > 255) finalG = 255;
             if (finalB > 255) finalB = 255;
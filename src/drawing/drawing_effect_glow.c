@@ -1,5 +1,6 @@
 #include <string.h>
 #include <windows.h>
+#include "drawing/drawing_blend.h"
 #include "drawing/drawing_effect.h"
 #include "drawing/drawing_effect_common.h"
 
@@ -26,7 +27,7 @@ void RenderGlowEffect(DWORD* pixels, int destWidth, int destHeight,
     int firstJ = 0;
     int lastJ = 0;
     if (!DrawingEffect_CalculateVisibleSpan(startX, gw, destWidth, &firstI, &lastI) ||
-        !DrawingEffect_CalculateVisibleSpan(startY, gh, destHeight, &firstJ, &lastJ)) {
+        !DrawingEffect_CalculateVisibleRows(startY, gh, destHeight, &firstJ, &lastJ)) {
         return;
     }
 
@@ -51,46 +52,27 @@ void RenderGlowEffect(DWORD* pixels, int destWidth, int destHeight,
 
     for (int j = firstJ; j < lastJ; j++) {
         int screenY = (int)(startY + (long long)j);
-
         DWORD* pDestRow = pixels + (size_t)screenY * (size_t)destWidth;
         const unsigned char* pGlowRow = glowMap + j * gw;
+        if (!colorCb) {
+            DrawingBlend_AddRow(pDestRow + (startX + (long long)firstI), pGlowRow + firstI,
+                                lastI - firstI, r, g, b);
+            continue;
+        }
 
         for (int i = firstI; i < lastI; i++) {
             int screenX = (int)(startX + (long long)i);
 
-            int alpha = pGlowRow[i];
+            BYTE alpha = pGlowRow[i];
             if (alpha == 0) continue;
 
             int finalR = r;
             int finalG = g;
             int finalB = b;
-            if (colorCb) {
-                colorCb(screenX, screenY, &finalR, &finalG, &finalB, userData);
-            }
+            colorCb(screenX, screenY, &finalR, &finalG, &finalB, userData);
 
             DWORD* pPixel = pDestRow + screenX;
-            DWORD bgPixel = *pPixel;
-
-            int bgR = (bgPixel >> 16) & 0xFF;
-            int bgG = (bgPixel >> 8) & 0xFF;
-            int bgB = bgPixel & 0xFF;
-
-            int glowR = (finalR * alpha) / 255;
-            int glowG = (finalG * alpha) / 255;
-            int glowB = (finalB * alpha) / 255;
-
-            int outR = bgR + glowR;
-            int outG = bgG + glowG;
-            int outB = bgB + glowB;
-
-            if (outR > 255) outR = 255;
-            if (outG > 255) outG = 255;
-            if (outB > 255) outB = 255;
-
-            int bgA = (bgPixel >> 24) & 0xFF;
-            int outA = max(bgA, alpha);
-
-            *pPixel = (outA << 24) | (outR << 16) | (outG << 8) | outB;
+            *pPixel = DrawingBlend_Add(*pPixel, finalR, finalG, finalB, alpha);
         }
     }
 
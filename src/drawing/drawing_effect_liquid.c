@@ -14,7 +14,8 @@ static inline int FastIntDist(int dx, int dy) {
 }
 
 static unsigned char g_specularLUT[256];
-static BOOL g_specularLUTInitialized = FALSE;
+/* Tile workers may render Liquid concurrently, so the tables build once */
+static INIT_ONCE g_liquidLUTOnce = INIT_ONCE_STATIC_INIT;
 
 typedef struct {
     short dR;
@@ -24,21 +25,16 @@ typedef struct {
 } SlopeProps;
 
 static SlopeProps g_slopeLUT[256];
-static BOOL g_slopeLUTInitialized = FALSE;
 
 static void InitSpecularLUT(void) {
-    if (g_specularLUTInitialized) return;
     for (int i = 0; i < 256; i++) {
         float f = i / 255.0f;
         f = f * f * f * f;
         g_specularLUT[i] = (unsigned char)(f * 255.0f);
     }
-    g_specularLUTInitialized = TRUE;
 }
 
 static void InitSlopeLUT(void) {
-    if (g_slopeLUTInitialized) return;
-
     for (int i = 0; i < 256; i++) {
         int slope_int = i;
         int clearAmt = 0;
@@ -67,7 +63,15 @@ static void InitSlopeLUT(void) {
         if (alpha > 255) alpha = 255;
         g_slopeLUT[i].alpha = (unsigned char)alpha;
     }
-    g_slopeLUTInitialized = TRUE;
+}
+
+static BOOL CALLBACK InitLiquidLUTs(PINIT_ONCE initOnce, PVOID parameter, PVOID* context) {
+    (void)initOnce;
+    (void)parameter;
+    (void)context;
+    InitSpecularLUT();
+    InitSlopeLUT();
+    return TRUE;
 }
 
 void RenderLiquidEffect(DWORD* pixels, int destWidth, int destHeight,
@@ -94,7 +98,7 @@ void RenderLiquidEffect(DWORD* pixels, int destWidth, int destHeight,
     int firstJ = 0;
     int lastJ = 0;
     if (!DrawingEffect_CalculateVisibleSpan(startX, gw, destWidth, &firstI, &lastI) ||
-        !DrawingEffect_CalculateVisibleSpan(startY, gh, destHeight, &firstJ, &lastJ)) {
+        !DrawingEffect_CalculateVisibleRows(startY, gh, destHeight, &firstJ, &lastJ)) {
         return;
     }
     if (firstI < 2) firstI = 2;
@@ -105,9 +109,8 @@ void RenderLiquidEffect(DWORD* pixels, int destWidth, int destHeight,
         return;
     }
 
+    if (!InitOnceExecuteOnce(&g_liquidLUTOnce, InitLiquidLUTs, NULL, NULL)) return;
     if (!DrawingEffect_BeginBufferUse()) return;
-    InitSpecularLUT();
-    InitSlopeLUT();
 
     DrawingEffectBuffers buffers;
     if (!DrawingEffect_EnsureBuffers(neededSize, &buffers)) {
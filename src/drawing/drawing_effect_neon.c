@@ -26,7 +26,7 @@ void RenderNeonEffect(DWORD* pixels, int destWidth, int destHeight,
     int firstJ = 0;
     int lastJ = 0;
     if (!DrawingEffect_CalculateVisibleSpan(startX, gw, destWidth, &firstI, &lastI) ||
-        !DrawingEffect_CalculateVisibleSpan(startY, gh, destHeight, &firstJ, &lastJ)) {
+        !DrawingEffect_CalculateVisibleRows(startY, gh, destHeight, &firstJ, &lastJ)) {
         return;
     }
 
@@ -1,6 +1,8 @@
 #include <string.h>
 #include <windows.h>
+#include "drawing/drawing_blend.h"
 #include "drawing/drawing_effect.h"
+#include "drawing/drawing_effect_common.h"
 
 #define RETRO_SHADOW_OFFSET_PIXELS 3
 
@@ -36,6 +38,11 @@ static BOOL ClipRetroBitmap(int x, int y,
     long long clipTop = (top < 0) ? 0 : top;
     long long clipRight = (right > (long long)destWidth) ? (long long)destWidth : right;
     long long clipBottom = (bottom > (long long)destHeight) ? (long long)destHeight : bottom;
+    int rowTop = 0;
+    int rowBottom = destHeight;
+    DrawingEffect_ClipRows(&rowTop, &rowBottom);
+    if (clipTop < (long long)rowTop) clipTop = rowTop;
+    if (clipBottom > (long long)rowBottom) clipBottom = rowBottom;
 
     if (clipLeft >= clipRight || clipTop >= clipBottom) {
         return FALSE;
@@ -50,28 +57,6 @@ static BOOL ClipRetroBitmap(int x, int y,
     return TRUE;
 }
 
-static void BlendSolidColorPixel(DWORD* destPixel, unsigned char alpha,
-                                 int r, int g, int b) {
-    if (!destPixel || alpha == 0) return;
-
-    DWORD currentPixel = *destPixel;
-    int currentA = (int)((currentPixel >> 24) & 0xFF);
-    int currentR = (int)((currentPixel >> 16) & 0xFF);
-    int currentG = (int)((currentPixel >> 8) & 0xFF);
-    int currentB = (int)(currentPixel & 0xFF);
-    int invAlpha = 255 - (int)alpha;
-
-    int outA = (int)alpha + (currentA * invAlpha) / 255;
-    int outR = (r * (int)alpha + currentR * invAlpha) / 255;
-    int outG = (g * (int)alpha + currentG * invAlpha) / 255;
-    int outB = (b * (int)alpha + currentB * invAlpha) / 255;
-
-    *destPixel = ((DWORD)outA << 24) |
-                 ((DWORD)outR << 16) |
-                 ((DWORD)outG << 8) |
-                 (DWORD)outB;
-}
-
 static void RenderRetroShadowPass(DWORD* pixels, int destWidth, int destHeight,
                                   int x_pos, int y_pos,
                                   const unsigned char* bitmap, int w, int h,
@@ -88,16 +73,8 @@ static void RenderRetroShadowPass(DWORD* pixels, int destWidth, int destHeight,
         DWORD* destRow = pixels + (size_t)destY * (size_t)destWidth + (size_t)shadowClip.destLeft;
         const unsigned char* srcRow = bitmap + (size_t)j * (size_t)w + (size_t)shadowClip.srcLeft;
 
-        for (int i = shadowClip.srcLeft; i < shadowClip.srcRight; ++i) {
-            unsigned char alpha = *srcRow++;
-            if (alpha == 0) {
-                destRow++;
-                continue;
-            }
-
-            BlendSolidColorPixel(destRow, alpha, shadowR, shadowG, shadowB);
-            destRow++;
-        }
+        DrawingBlend_OverRow(destRow, srcRow, shadowClip.srcRight - shadowClip.srcLeft,
+                             shadowR, shadowG, shadowB);
     }
 }
 
@@ -130,6 +107,11 @@ void RenderRetroEffect(DWORD* pixels, int destWidth, int destHeight,
             int destY = foreClip.destTop + (j - foreClip.srcTop);
             DWORD* destRow = pixels + (size_t)destY * (size_t)destWidth + (size_t)foreClip.destLeft;
             const unsigned char* srcRow = bitmap + (size_t)j * (size_t)w + (size_t)foreClip.srcLeft;
+            if (!colorCb) {
+                DrawingBlend_OverRow(destRow, srcRow, foreClip.srcRight - foreClip.srcLeft,
+                                     r, g, b);
+                continue;
+            }
 
             for (int i = foreClip.srcLeft; i < foreClip.srcRight; ++i) {
                 unsigned char alpha = *srcRow++;
@@ -141,13 +123,11 @@ void RenderRetroEffect(DWORD* pixels, int destWidth, int destHeight,
                 int finalR = r;
                 int finalG = g;
                 int finalB = b;
+                colorCb(foreClip.destLeft + (i - foreClip.srcLeft),
+                        destY, &finalR, &finalG, &finalB, userData);
 
-                if (colorCb) {
-                    colorCb(foreClip.destLeft + (i - foreClip.srcLeft),
-                            destY, &finalR, &finalG, &finalB, userData);
-                }
-
-                BlendSolidColorPixel(destRow, alpha, finalR, finalG, finalB);
+                *destRow = DrawingBlend_Over(*destRow, DrawingBlend_ColorLanes(finalR, finalG, finalB),
+                                             alpha);
                 destRow++;
             }
         }
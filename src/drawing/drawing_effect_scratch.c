@@ -0,0 +1,210 @@
+/**
+ * @file drawing_effect_scratch.c
+ * @brief Effect scratch buffers and the per-thread tile context.
+ *
+ * Slot 0 is the shared scratch set used by ordinary callers and is guarded
+ * by the effect buffer lock. Tile workers each own one of the other slots
+ * for the duration of a band, so they need no lock, and they clip every
+ * write to the rows of their band.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "drawing/drawing_effect.h"
+#include "drawing/drawing_effect_common.h"
+#ifdef CATIME_USE_WIN32_FLS
+#include "utils/thread_local_buffer.h"
+#endif
+
+#define EFFECT_BUFFER_SHRINK_RATIO 4
+#define EFFECT_BUFFER_SHRINK_DELAY_MS 5000ULL
+#define EFFECT_BUFFER_SHRINK_MIN_SIZE (256 * 1024)
+
+typedef struct {
+    unsigned char* buffer1;
+    unsigned char* buffer2;
+    unsigned char* buffer3;
+    int size;
+    ULONGLONG shrinkCandidateTick;
+} EffectScratchSet;
+
+static EffectScratchSet g_effectScratch[DRAWING_EFFECT_SCRATCH_SLOTS];
+static INIT_ONCE g_effectBufferLockOnce = INIT_ONCE_STATIC_INIT;
+static CRITICAL_SECTION g_effectBufferCS;
+
+typedef struct {
+    int slot;
+    BOOL rowClipActive;
+    int rowTop;
+    int rowBottom;
+} EffectTileContext;
+
+#if defined(CATIME_USE_WIN32_FLS)
+static ThreadLocalBuffer g_effectTileStorage =
+    THREAD_LOCAL_BUFFER_STATIC_INIT(sizeof(EffectTileContext));
+#elif defined(_MSC_VER)
+__declspec(thread) static EffectTileContext t_effectTile;
+#elif defined(__GNUC__)
+static __thread EffectTileContext t_effectTile;
+#else
+static EffectTileContext t_effectTile;
+#endif
+
+/* NULL only when fiber-local storage cannot be allocated; reads as no tile */
+static EffectTileContext* CurrentTile(void) {
+#if defined(CATIME_USE_WIN32_FLS)
+    return (EffectTileContext*)ThreadLocalBuffer_Get(&g_effectTileStorage);
+#else
+    return &t_effectTile;
+#endif
+}
+
+static BOOL CALLBACK InitEffectBufferLock(PINIT_ONCE initOnce, PVOID parameter, PVOID* context) {
+    (void)initOnce;
+    (void)parameter;
+    (void)context;
+    InitializeCriticalSection(&g_effectBufferCS);
+    return TRUE;
+}
+
+BOOL DrawingEffect_BeginBufferUse(void) {
+    if (DrawingEffect_GetScratchSlot() > 0) return TRUE;
+    if (!InitOnceExecuteOnce(&g_effectBufferLockOnce, InitEffectBufferLock, NULL, NULL)) {
+        return FALSE;
+    }
+    EnterCriticalSection(&g_effectBufferCS);
+    return TRUE;
+}
+
+void DrawingEffect_EndBufferUse(void) {
+    if (DrawingEffect_GetScratchSlot() > 0) return;
+    LeaveCriticalSection(&g_effectBufferCS);
+}
+
+int DrawingEffect_GetScratchSlot(void) {
+    const EffectTileContext* tile = CurrentTile();
+    return tile ? tile->slot : 0;
+}
+
+BOOL DrawingEffect_EnterTile(int slot, int rowTop, int rowBottom) {
+    EffectTileContext* tile = CurrentTile();
+    if (!tile) return FALSE;
+    tile->slot = (slot > 0 && slot < DRAWING_EFFECT_SCRATCH_SLOTS) ? slot : 0;
+    tile->rowTop = rowTop;
+    tile->rowBottom = rowBottom;
+    tile->rowClipActive = TRUE;
+    return TRUE;
+}
+
+void DrawingEffect_LeaveTile(void) {
+    EffectTileContext* tile = CurrentTile();
+    if (!tile) return;
+    tile->slot = 0;
+    tile->rowClipActive = FALSE;
+}
+
+void DrawingEffect_ClipRows(int* top, int* bottom) {
+    const EffectTileContext* tile = CurrentTile();
+    if (!top || !bottom || !tile || !tile->rowClipActive) return;
+    if (*top < tile->rowTop) *top = tile->rowTop;
+    if (*bottom > tile->rowBottom) *bottom = tile->rowBottom;
+}
+
+BOOL DrawingEffect_CalculateVisibleRows(long long start, int length, int limit,
+                                        int* outFirst, int* outLast) {
+    if (!DrawingEffect_CalculateVisibleSpan(start, length, limit, outFirst, outLast)) {
+        return FALSE;
+    }
+    const EffectTileContext* tile = CurrentTile();
+    if (!tile || !tile->rowClipActive) return TRUE;
+
+    long long first = (long long)tile->rowTop - start;
+    long long last = (long long)tile->rowBottom - start;
+    if (first < (long long)*outFirst) first = *outFirst;
+    if (last > (long long)*outLast) last = *outLast;
+    if (first >= last) return FALSE;
+
+    *outFirst = (int)first;
+    *outLast = (int)last;
+    return TRUE;
+}
+
+static void FreeScratchSet(EffectScratchSet* set) {
+    free(set->buffer1);
+    free(set->buffer2);
+    free(set->buffer3);
+    ZeroMemory(set, sizeof(*set));
+}
+
+static void MaybeShrinkOversizedEffectBuffers(EffectScratchSet* set, int neededSize) {
+    if (set->size < EFFECT_BUFFER_SHRINK_MIN_SIZE ||
+        neededSize > set->size / EFFECT_BUFFER_SHRINK_RATIO ||
+        !set->buffer1 || !set->buffer2 || !set->buffer3) {
+        set->shrinkCandidateTick = 0;
+        return;
+    }
+
+    ULONGLONG now = GetTickCount64();
+    if (set->shrinkCandidateTick == 0) {
+        set->shrinkCandidateTick = now;
+        return;
+    }
+
+    if (now - set->shrinkCandidateTick >= EFFECT_BUFFER_SHRINK_DELAY_MS) {
+        FreeScratchSet(set);
+    }
+}
+
+static BOOL EnsureEffectBuffers(EffectScratchSet* set, int neededSize) {
+    if (neededSize <= 0) return FALSE;
+    if (neededSize <= set->size &&
+        set->buffer1 && set->buffer2 && set->buffer3) {
+        MaybeShrinkOversizedEffectBuffers(set, neededSize);
+        if (neededSize <= set->size &&
+            set->buffer1 && set->buffer2 && set->buffer3) {
+            return TRUE;
+        }
+    } else {
+        set->shrinkCandidateTick = 0;
+    }
+
+    unsigned char* newBuffer1 = (unsigned char*)malloc((size_t)neededSize);
+    unsigned char* newBuffer2 = (unsigned char*)malloc((size_t)neededSize);
+    unsigned char* newBuffer3 = (unsigned char*)malloc((size_t)neededSize);
+
+    if (!newBuffer1 || !newBuffer2 || !newBuffer3) {
+        free(newBuffer1);
+        free(newBuffer2);
+        free(newBuffer3);
+        return FALSE;
+    }
+
+    FreeScratchSet(set);
+    set->buffer1 = newBuffer1;
+    set->buffer2 = newBuffer2;
+    set->buffer3 = newBuffer3;
+    set->size = neededSize;
+    return TRUE;
+}
+
+BOOL DrawingEffect_EnsureBuffers(int neededSize, DrawingEffectBuffers* outBuffers) {
+    if (!outBuffers) return FALSE;
+    ZeroMemory(outBuffers, sizeof(*outBuffers));
+
+    EffectScratchSet* set = &g_effectScratch[DrawingEffect_GetScratchSlot()];
+    if (!EnsureEffectBuffers(set, neededSize)) {
+        return FALSE;
+    }
+
+    outBuffers->buffer1 = set->buffer1;
+    outBuffers->buffer2 = set->buffer2;
+    outBuffers->buffer3 = set->buffer3;
+    return TRUE;
+}
+
+void DrawingEffect_FreeScratch(void) {
+    for (int i = 0; i < DRAWING_EFFECT_SCRATCH_SLOTS; i++) {
+        FreeScratchSet(&g_effectScratch[i]);
+    }
+}
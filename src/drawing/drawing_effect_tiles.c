@@ -0,0 +1,265 @@
+/**
+ * @file drawing_effect_tiles.c
+ * @brief Records glyph effect passes and replays them in parallel bands.
+ *
+ * A flush cuts the frame into at most one band per core. Cuts are placed
+ * where the recorded glyphs split the work evenly and then nudged to the
+ * nearby row crossed by the fewest glyphs, so few glyphs are built twice.
+ * Every band replays the whole list in order and relies on the effects
+ * clipping to its rows.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "drawing/drawing_effect_tiles.h"
+#include "drawing/drawing_effect.h"
+#include "drawing/drawing_effect_common.h"
+#include "drawing/drawing_render_metrics.h"
+#include "drawing_effect_tiles_internal.h"
+
+#define EFFECT_TILES_MIN_PIXELS 250000LL
+#define EFFECT_TILES_MIN_BAND_ROWS 96
+#define EFFECT_TILES_CUT_SEARCH_ROWS 24
+#define EFFECT_TILES_GLYPH_REACH 48
+#define EFFECT_TILES_ARENA_LIMIT (64u * 1024u * 1024u)
+#define EFFECT_TILES_ALIGN(size) (((size) + 15u) & ~(size_t)15u)
+
+typedef struct {
+    DrawingEffectTileReplay replay;
+    size_t argsOffset;
+    size_t bitmapOffset;
+    int top;
+    int bottom;
+    int weight;
+} EffectTileJob;
+
+typedef struct {
+    long long weight;
+    int coverage;
+} EffectTileRow;
+
+typedef struct {
+    DWORD* pixels;
+    int width;
+    int height;
+    EffectTileJob* jobs;
+    int jobCount;
+    int jobCapacity;
+    unsigned char* arena;
+    size_t arenaUsed;
+    size_t arenaCapacity;
+    EffectTileRow* rows;
+    int rowCapacity;
+} EffectTileBatch;
+
+static EffectTileBatch g_tileBatch;
+static volatile LONG g_tileOwner = 0;
+static int g_tileProcessorCount = 0;
+
+static BOOL OwnsBatch(void) {
+    LONG owner = g_tileOwner;
+    return owner != 0 && (DWORD)owner == GetCurrentThreadId();
+}
+
+static int ProcessorCount(void) {
+    if (g_tileProcessorCount == 0) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        g_tileProcessorCount = info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+    }
+    return g_tileProcessorCount;
+}
+
+static void ReplayJobs(void) {
+    for (int i = 0; i < g_tileBatch.jobCount; i++) {
+        const EffectTileJob* job = &g_tileBatch.jobs[i];
+        job->replay(g_tileBatch.pixels, g_tileBatch.width, g_tileBatch.height,
+                    g_tileBatch.arena + job->bitmapOffset,
+                    g_tileBatch.arena + job->argsOffset);
+    }
+}
+
+/* A thread without a tile context leaves its band untouched for the caller */
+static BOOL ReplayBand(int slot, int rowTop, int rowBottom) {
+    if (!DrawingEffect_EnterTile(slot, rowTop, rowBottom)) return FALSE;
+    ReplayJobs();
+    DrawingEffect_LeaveTile();
+    return TRUE;
+}
+
+static BOOL BuildRowProfile(void) {
+    int height = g_tileBatch.height;
+    if (g_tileBatch.rowCapacity < height + 1) {
+        EffectTileRow* rows = (EffectTileRow*)realloc(g_tileBatch.rows, sizeof(EffectTileRow) * ((size_t)height + 1));
+        if (!rows) return FALSE;
+        g_tileBatch.rows = rows;
+        g_tileBatch.rowCapacity = height + 1;
+    }
+    EffectTileRow* rows = g_tileBatch.rows;
+    memset(rows, 0, sizeof(EffectTileRow) * ((size_t)height + 1));
+    for (int i = 0; i < g_tileBatch.jobCount; i++) {
+        const EffectTileJob* job = &g_tileBatch.jobs[i];
+        rows[job->top].weight += job->weight;
+        rows[job->top].coverage++;
+        rows[job->bottom].weight -= job->weight;
+        rows[job->bottom].coverage--;
+    }
+    /* Difference array to per-row load, then weight to a running total */
+    long long load = 0;
+    long long total = 0;
+    int coverage = 0;
+    for (int y = 0; y <= height; y++) {
+        load += rows[y].weight;
+        coverage += rows[y].coverage;
+        total += load;
+        rows[y].weight = total;
+        rows[y].coverage = coverage;
+    }
+    return TRUE;
+}
+
+/* Fills cuts[0..bands] with band edges covering [0, height); returns bands */
+static int PlanBands(int* cuts, int maxBands) {
+    int height = g_tileBatch.height;
+    int bands = height / EFFECT_TILES_MIN_BAND_ROWS;
+    if (bands > maxBands) bands = maxBands;
+    if (bands < 2 || !BuildRowProfile()) return 1;
+
+    const EffectTileRow* rows = g_tileBatch.rows;
+    long long total = rows[height - 1].weight;
+    int count = 0;
+    cuts[count++] = 0;
+    int y = 1;
+    for (int k = 1; k < bands; k++) {
+        long long target = total * k / bands;
+        while (y < height - 1 && rows[y].weight < target) y++;
+        int best = y;
+        for (int d = 1; d <= EFFECT_TILES_CUT_SEARCH_ROWS; d++) {
+            if (y - d > 0 && rows[y - d - 1].coverage < rows[best - 1].coverage) best = y - d;
+            if (y + d < height && rows[y + d - 1].coverage < rows[best - 1].coverage) best = y + d;
+        }
+        if (best - cuts[count - 1] < EFFECT_TILES_MIN_BAND_ROWS / 2 ||
+            height - best < EFFECT_TILES_MIN_BAND_ROWS / 2) {
+            continue;
+        }
+        cuts[count++] = best;
+    }
+    cuts[count] = height;
+    return count;
+}
+
+static int ClampRow(long long row) {
+    if (row < 0) return 0;
+    return row > g_tileBatch.height ? g_tileBatch.height : (int)row;
+}
+
+static void ResetBatchJobs(void) {
+    g_tileBatch.jobCount = 0;
+    g_tileBatch.arenaUsed = 0;
+}
+
+BOOL DrawingEffectTiles_Begin(DWORD* pixels, int width, int height) {
+    if (!pixels || width <= 0 || height < 2 * EFFECT_TILES_MIN_BAND_ROWS) return FALSE;
+    if ((long long)width * (long long)height < EFFECT_TILES_MIN_PIXELS) return FALSE;
+    if (ProcessorCount() < 2) return FALSE;
+    if (InterlockedCompareExchange(&g_tileOwner, (LONG)GetCurrentThreadId(), 0) != 0) {
+        return FALSE;
+    }
+    g_tileBatch.pixels = pixels;
+    g_tileBatch.width = width;
+    g_tileBatch.height = height;
+    return TRUE;
+}
+
+static BOOL ReserveJob(size_t bytes) {
+    if (g_tileBatch.jobCount == g_tileBatch.jobCapacity) {
+        int capacity = g_tileBatch.jobCapacity ? g_tileBatch.jobCapacity * 2 : 256;
+        EffectTileJob* jobs = (EffectTileJob*)realloc(g_tileBatch.jobs, sizeof(EffectTileJob) * (size_t)capacity);
+        if (!jobs) return FALSE;
+        g_tileBatch.jobs = jobs;
+        g_tileBatch.jobCapacity = capacity;
+    }
+    if (g_tileBatch.arenaUsed + bytes > g_tileBatch.arenaCapacity) {
+        size_t capacity = g_tileBatch.arenaCapacity ? g_tileBatch.arenaCapacity : 64u * 1024u;
+        while (capacity < g_tileBatch.arenaUsed + bytes) capacity *= 2;
+        unsigned char* arena = (unsigned char*)realloc(g_tileBatch.arena, capacity);
+        if (!arena) return FALSE;
+        g_tileBatch.arena = arena;
+        g_tileBatch.arenaCapacity = capacity;
+    }
+    return TRUE;
+}
+
+BOOL DrawingEffectTiles_Submit(DWORD* pixels, DrawingEffectTileReplay replay,
+                               const void* args, size_t argsSize,
+                               const unsigned char* bitmap, int w, int h,
+                               int top) {
+    if (!pixels || !replay || !args || !bitmap || w <= 0 || h <= 0) return FALSE;
+    if (!OwnsBatch() || pixels != g_tileBatch.pixels) return FALSE;
+    if ((size_t)h > EFFECT_TILES_ARENA_LIMIT / (size_t)w) return FALSE;
+
+    size_t argsBytes = EFFECT_TILES_ALIGN(argsSize);
+    size_t bitmapBytes = EFFECT_TILES_ALIGN((size_t)w * (size_t)h);
+    if (g_tileBatch.arenaUsed + argsBytes + bitmapBytes > EFFECT_TILES_ARENA_LIMIT) {
+        DrawingEffectTiles_Flush();
+    }
+    if (!ReserveJob(argsBytes + bitmapBytes)) {
+        DrawingEffectTiles_Flush();
+        return FALSE;
+    }
+
+    EffectTileJob* job = &g_tileBatch.jobs[g_tileBatch.jobCount++];
+    job->replay = replay;
+    job->argsOffset = g_tileBatch.arenaUsed;
+    job->bitmapOffset = g_tileBatch.arenaUsed + argsBytes;
+    memcpy(g_tileBatch.arena + job->argsOffset, args, argsSize);
+    memcpy(g_tileBatch.arena + job->bitmapOffset, bitmap, (size_t)w * (size_t)h);
+    g_tileBatch.arenaUsed += argsBytes + bitmapBytes;
+
+    job->top = ClampRow((long long)top - EFFECT_TILES_GLYPH_REACH);
+    job->bottom = ClampRow((long long)top + h + EFFECT_TILES_GLYPH_REACH);
+    job->weight = w + 2 * EFFECT_TILES_GLYPH_REACH;
+    return TRUE;
+}
+
+void DrawingEffectTiles_Flush(void) {
+    if (!OwnsBatch() || g_tileBatch.jobCount == 0) return;
+
+    LONGLONG flushBegin = RenderMetrics_StageBegin();
+    if (DrawingEffect_BeginBufferUse()) {
+        int cuts[EFFECT_TILES_MAX_WORKERS + 2];
+        int bands = 1;
+        /* Band 0 and any band a worker gives back run here, under a tile */
+        if (DrawingEffect_EnterTile(0, 0, g_tileBatch.height)) {
+            DrawingEffect_LeaveTile();
+            bands = PlanBands(cuts, EffectTileWorkers_Ensure(ProcessorCount() - 1) + 1);
+        }
+        if (bands < 2) {
+            ReplayJobs();
+        } else {
+            EffectTileWorkers_Run(bands, cuts, ReplayBand);
+        }
+        DrawingEffect_EndBufferUse();
+    }
+    RenderMetrics_StageEnd(RENDER_STAGE_EFFECT, flushBegin);
+    ResetBatchJobs();
+}
+
+void DrawingEffectTiles_End(void) {
+    if (!OwnsBatch()) return;
+    DrawingEffectTiles_Flush();
+    g_tileBatch.pixels = NULL;
+    InterlockedExchange(&g_tileOwner, 0);
+}
+
+void DrawingEffectTiles_Shutdown(void) {
+    DrawingEffectTiles_Flush();
+    EffectTileWorkers_Stop();
+
+    if (g_tileOwner != 0) return;
+    free(g_tileBatch.jobs);
+    free(g_tileBatch.arena);
+    free(g_tileBatch.rows);
+    ZeroMemory(&g_tileBatch, sizeof(g_tileBatch));
+}
@@ -0,0 +1,31 @@
+/**
+ * @file drawing_effect_tiles_internal.h
+ * @brief Worker pool behind the banded effect replay.
+ */
+
+#ifndef DRAWING_EFFECT_TILES_INTERNAL_H
+#define DRAWING_EFFECT_TILES_INTERNAL_H
+
+#include <windows.h>
+#include "drawing_effect_common.h"
+
+#define EFFECT_TILES_MAX_WORKERS (DRAWING_EFFECT_SCRATCH_SLOTS - 1)
+
+/** @brief Replays one band using a scratch slot; FALSE if nothing was drawn */
+typedef BOOL (*EffectTileBandFn)(int slot, int rowTop, int rowBottom);
+
+/** @brief Starts workers up to wanted; returns how many are available */
+int EffectTileWorkers_Ensure(int wanted);
+
+/**
+ * @brief Runs band k on worker k and band 0 on the caller, then waits
+ *
+ * A band a worker could not replay is replayed again on the caller.
+ * @param cuts Band edges; band k spans cuts[k] to cuts[k + 1]
+ */
+void EffectTileWorkers_Run(int bands, const int* cuts, EffectTileBandFn replayBand);
+
+/** @brief Joins and releases every worker */
+void EffectTileWorkers_Stop(void);
+
+#endif /* DRAWING_EFFECT_TILES_INTERNAL_H */
@@ -0,0 +1,95 @@
+/**
+ * @file drawing_effect_tiles_workers.c
+ * @brief Persistent threads that replay effect bands.
+ *
+ * Worker k always takes band k and scratch slot k, so its buffers and Aqua
+ * cache stay warm across frames. Workers sleep on an auto-reset event
+ * between flushes. All calls come from a flush or from effect cleanup,
+ * both of which hold the effect buffer lock.
+ */
+
+#include "drawing_effect_tiles_internal.h"
+
+typedef struct {
+    HANDLE thread;
+    HANDLE startEvent;
+    HANDLE doneEvent;
+    int slot;
+    int rowTop;
+    int rowBottom;
+    EffectTileBandFn replayBand;
+    BOOL replayed;
+} EffectTileWorker;
+
+static EffectTileWorker g_tileWorkers[EFFECT_TILES_MAX_WORKERS];
+static int g_tileWorkerCount = 0;
+static volatile LONG g_tileWorkersStop = 0;
+
+static DWORD WINAPI EffectTileWorkerProc(LPVOID param) {
+    EffectTileWorker* worker = (EffectTileWorker*)param;
+    for (;;) {
+        WaitForSingleObject(worker->startEvent, INFINITE);
+        if (InterlockedCompareExchange(&g_tileWorkersStop, 0, 0)) break;
+        worker->replayed = worker->replayBand(worker->slot, worker->rowTop, worker->rowBottom);
+        SetEvent(worker->doneEvent);
+    }
+    return 0;
+}
+
+static void CloseWorkerHandles(EffectTileWorker* worker) {
+    if (worker->thread) CloseHandle(worker->thread);
+    if (worker->startEvent) CloseHandle(worker->startEvent);
+    if (worker->doneEvent) CloseHandle(worker->doneEvent);
+    ZeroMemory(worker, sizeof(*worker));
+}
+
+int EffectTileWorkers_Ensure(int wanted) {
+    if (wanted > EFFECT_TILES_MAX_WORKERS) wanted = EFFECT_TILES_MAX_WORKERS;
+    while (g_tileWorkerCount < wanted) {
+        EffectTileWorker* worker = &g_tileWorkers[g_tileWorkerCount];
+        worker->slot = g_tileWorkerCount + 1;
+        worker->startEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        worker->doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (worker->startEvent && worker->doneEvent) {
+            worker->thread = CreateThread(NULL, 0, EffectTileWorkerProc, worker, 0, NULL);
+        }
+        if (!worker->thread) {
+            CloseWorkerHandles(worker);
+            break;
+        }
+        g_tileWorkerCount++;
+    }
+    return g_tileWorkerCount < wanted ? g_tileWorkerCount : wanted;
+}
+
+void EffectTileWorkers_Run(int bands, const int* cuts, EffectTileBandFn replayBand) {
+    HANDLE doneEvents[EFFECT_TILES_MAX_WORKERS];
+    int started = 0;
+    for (int k = 1; k < bands && k <= g_tileWorkerCount; k++) {
+        EffectTileWorker* worker = &g_tileWorkers[k - 1];
+        worker->rowTop = cuts[k];
+        worker->rowBottom = cuts[k + 1];
+        worker->replayBand = replayBand;
+        doneEvents[started++] = worker->doneEvent;
+        SetEvent(worker->startEvent);
+    }
+    replayBand(0, cuts[0], cuts[1]);
+    if (started > 0) {
+        WaitForMultipleObjects((DWORD)started, doneEvents, TRUE, INFINITE);
+    }
+    for (int k = 0; k < started; k++) {
+        EffectTileWorker* worker = &g_tileWorkers[k];
+        if (!worker->replayed) replayBand(0, worker->rowTop, worker->rowBottom);
+    }
+}
+
+void EffectTileWorkers_Stop(void) {
+    InterlockedExchange(&g_tileWorkersStop, 1);
+    for (int i = 0; i < g_tileWorkerCount; i++) {
+        SetEvent(g_tileWorkers[i].startEvent);
+        WaitForSingleObject(g_tileWorkers[i].thread, INFINITE);
+        CloseWorkerHandles(&g_tileWorkers[i]);
+    }
+    g_tileWorkerCount = 0;
+    InterlockedExchange(&g_tileWorkersStop, 0);
+}
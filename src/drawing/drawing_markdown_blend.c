@@ -4,7 +4,10 @@
  */
 
 #include "drawing/drawing_markdown_stb_internal.h"
+#include "drawing/drawing_blend.h"
+#include "drawing/drawing_effect_tiles.h"
 #include <stddef.h>
+#include <stdlib.h>
 
 void MarkdownStbInternal_BlendItalic(void* destBits, int destWidth, int destHeight,
                                       int x_pos, int y_pos,
@@ -12,6 +15,7 @@ void MarkdownStbInternal_BlendItalic(void* destBits, int destWidth, int destHeig
                                       int r, int g, int b, float slant) {
     DWORD* pixels = (DWORD*)destBits;
     if (!pixels || !bitmap || destWidth <= 0 || destHeight <= 0 || w <= 0 || h <= 0) return;
+    DrawingEffectTiles_Flush();
 
     int firstJ = 0;
     int lastJ = 0;
@@ -32,26 +36,7 @@ void MarkdownStbInternal_BlendItalic(void* destBits, int destWidth, int destHeig
         DWORD* dest = pixels + (size_t)screenY * (size_t)destWidth +
                       (size_t)(rowX + (long long)firstI);
         const unsigned char* src = bitmap + (size_t)j * (size_t)w + (size_t)firstI;
-
-        for (int i = firstI; i < lastI; ++i) {
-            unsigned char alpha = *src++;
-            if (alpha == 0) {
-                dest++;
-                continue;
-            }
-
-            DWORD existing = *dest;
-            int er = (existing >> 16) & 0xFF;
-            int eg = (existing >> 8) & 0xFF;
-            int eb = existing & 0xFF;
-            int ea = (existing >> 24) & 0xFF;
-            int nr = er + ((r - er) * alpha) / 255;
-            int ng = eg + ((g - eg) * alpha) / 255;
-            int nb = eb + ((b - eb) * alpha) / 255;
-            int na = ea + ((255 - ea) * alpha) / 255;
-            *dest = (na << 24) | (nr << 16) | (ng << 8) | nb;
-            dest++;
-        }
+        DrawingBlend_LerpRow(dest, src, lastI - firstI, r, g, b);
     }
 }
 
@@ -61,6 +46,7 @@ void MarkdownStbInternal_BlendItalicGradient(void* destBits, int destWidth, int
                                               float slant, const GradientInfo* info, int timeOffset, int totalWidth) {
     DWORD* pixels = (DWORD*)destBits;
     if (!pixels || !info || !bitmap || destWidth <= 0 || destHeight <= 0 || w <= 0 || h <= 0) return;
+    DrawingEffectTiles_Flush();
 
     int firstJ = 0;
     int lastJ = 0;
@@ -105,14 +91,77 @@ void MarkdownStbInternal_BlendItalicGradient(void* destBits, int destWidth, int
             int g = GetGValue(sample);
             int b = GetBValue(sample);
 
-            DWORD finalR = (r * alpha) / 255;
-            DWORD finalG = (g * alpha) / 255;
-            DWORD finalB = (b * alpha) / 255;
-            *destRow++ = (alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+            *destRow++ = DrawingBlend_Premultiply(DrawingBlend_ColorLanes(r, g, b), alpha);
         }
     }
 }
 
+/* Color-tag rows fill lazily: a tag rarely spans the whole width, and a
+ * column is valid while its stamp matches the bound tag's. */
+static COLORREF* g_colorTagRow = NULL;
+static DWORD* g_colorTagRowStamps = NULL;
+static int g_colorTagRowCapacity = 0;
+static DWORD g_colorTagRowStamp = 0;
+static const MarkdownColorTag* g_colorTagRowTag = NULL;
+
+static void NextColorTagRowStamp(void) {
+    if (++g_colorTagRowStamp == 0) {
+        if (g_colorTagRowStamps) {
+            ZeroMemory(g_colorTagRowStamps, (size_t)g_colorTagRowCapacity * sizeof(DWORD));
+        }
+        g_colorTagRowStamp = 1;
+    }
+}
+
+void MarkdownStbInternal_ResetColorTagRow(int width) {
+    if (width > g_colorTagRowCapacity) {
+        MarkdownStbInternal_ReleaseColorTagRow();
+        g_colorTagRow = (COLORREF*)malloc((size_t)width * sizeof(COLORREF));
+        g_colorTagRowStamps = (DWORD*)calloc((size_t)width, sizeof(DWORD));
+        if (!g_colorTagRow || !g_colorTagRowStamps) {
+            /* Columns are then sampled directly */
+            MarkdownStbInternal_ReleaseColorTagRow();
+        } else {
+            g_colorTagRowCapacity = width;
+        }
+    }
+    g_colorTagRowTag = NULL;
+    NextColorTagRowStamp();
+}
+
+void MarkdownStbInternal_ReleaseColorTagRow(void) {
+    free(g_colorTagRow);
+    free(g_colorTagRowStamps);
+    g_colorTagRow = NULL;
+    g_colorTagRowStamps = NULL;
+    g_colorTagRowCapacity = 0;
+    g_colorTagRowTag = NULL;
+}
+
+static void BindColorTagRow(const MarkdownColorTag* colorTag) {
+    if (colorTag != g_colorTagRowTag) {
+        g_colorTagRowTag = colorTag;
+        NextColorTagRowStamp();
+    }
+}
+
+static COLORREF SampleColorTagColumn(const MarkdownColorTag* colorTag, long long x,
+                                     int totalWidth, long long animOffsetFixed) {
+    BOOL cached = x >= 0 && x < (long long)g_colorTagRowCapacity;
+    if (cached && g_colorTagRowStamps[x] == g_colorTagRowStamp) {
+        return g_colorTagRow[x];
+    }
+
+    long long position = MarkdownStbInternal_GradientPositionFixed(x, totalWidth, animOffsetFixed);
+    COLORREF sample = MarkdownStbInternal_SampleGradient(colorTag->colors,
+                                                         colorTag->colorCount, position);
+    if (cached) {
+        g_colorTagRow[x] = sample;
+        g_colorTagRowStamps[x] = g_colorTagRowStamp;
+    }
+    return sample;
+}
+
 void MarkdownStbInternal_BlendColorTagGradient(void* destBits, int destWidth, int destHeight,
                                                 int x_pos, int y_pos,
                                                 const unsigned char* bitmap, int w, int h,
@@ -121,15 +170,15 @@ void MarkdownStbInternal_BlendColorTagGradient(void* destBits, int destWidth, in
 
     DWORD* pixels = (DWORD*)destBits;
     if (!pixels || !bitmap || destWidth <= 0 || destHeight <= 0 || w <= 0 || h <= 0) return;
+    DrawingEffectTiles_Flush();
 
-    int colorCount = colorTag->colorCount;
     int firstI = 0;
     int lastI = 0;
     int firstJ = 0;
     int lastJ = 0;
     long long animOffsetFixed =
         ((long long)(timeOffset % 2000) * MARKDOWN_GRADIENT_FIXED_ONE) / 2000;
-    long long gradientStep = MarkdownStbInternal_GradientStepFixed(totalWidth);
+    BindColorTagRow(colorTag);
     if (!MarkdownStbInternal_CalculateVisibleSpan(x_pos, w, destWidth, &firstI, &lastI) ||
         !MarkdownStbInternal_CalculateVisibleSpan(y_pos, h, destHeight, &firstJ, &lastJ)) {
         return;
@@ -140,30 +189,21 @@ void MarkdownStbInternal_BlendColorTagGradient(void* destBits, int destWidth, in
         long long destX = (long long)x_pos + (long long)firstI;
         DWORD* destRow = pixels + (size_t)screen_y * (size_t)destWidth + (size_t)destX;
         const unsigned char* srcRow = bitmap + (size_t)j * (size_t)w + (size_t)firstI;
-        long long gradientPosition = MarkdownStbInternal_GradientPositionFixed(destX,
-                                                                   totalWidth,
-                                                                   animOffsetFixed);
 
         for (int i = firstI; i < lastI; ++i) {
             unsigned char alpha = *srcRow++;
             if (alpha == 0) {
-                MarkdownStbInternal_AdvanceGradientFixed(&gradientPosition, gradientStep);
                 destRow++;
                 continue;
             }
 
-            COLORREF sample = MarkdownStbInternal_SampleGradient(colorTag->colors,
-                                                          colorCount,
-                                                          gradientPosition);
-            MarkdownStbInternal_AdvanceGradientFixed(&gradientPosition, gradientStep);
+            COLORREF sample = SampleColorTagColumn(colorTag, destX + (i - firstI),
+                                                   totalWidth, animOffsetFixed);
             int r = GetRValue(sample);
             int g = GetGValue(sample);
             int b = GetBValue(sample);
 
-            DWORD finalR = (r * alpha) / 255;
-            DWORD finalG = (g * alpha) / 255;
-            DWORD finalB = (b * alpha) / 255;
-            *destRow++ = (alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+            *destRow++ = DrawingBlend_Premultiply(DrawingBlend_ColorLanes(r, g, b), alpha);
         }
     }
 }
@@ -177,11 +217,11 @@ void MarkdownStbInternal_BlendColorTagGradientItalic(void* destBits, int destWid
 
     DWORD* pixels = (DWORD*)destBits;
     if (!pixels || !bitmap || destWidth <= 0 || destHeight <= 0 || w <= 0 || h <= 0) return;
+    DrawingEffectTiles_Flush();
 
-    int colorCount = colorTag->colorCount;
     long long animOffsetFixed =
         ((long long)(timeOffset % 2000) * MARKDOWN_GRADIENT_FIXED_ONE) / 2000;
-    long long gradientStep = MarkdownStbInternal_GradientStepFixed(totalWidth);
+    BindColorTagRow(colorTag);
     int firstJ = 0;
     int lastJ = 0;
     if (!MarkdownStbInternal_CalculateVisibleSpan(y_pos, h, destHeight, &firstJ, &lastJ)) {
@@ -201,30 +241,21 @@ void MarkdownStbInternal_BlendColorTagGradientItalic(void* destBits, int destWid
         long long destX = rowX + (long long)firstI;
         DWORD* destRow = pixels + (size_t)screen_y * (size_t)destWidth + (size_t)destX;
         const unsigned char* srcRow = bitmap + (size_t)j * (size_t)w + (size_t)firstI;
-        long long gradientPosition = MarkdownStbInternal_GradientPositionFixed(destX,
-                                                                   totalWidth,
-                                                                   animOffsetFixed);
 
         for (int i = firstI; i < lastI; ++i) {
             unsigned char alpha = *srcRow++;
             if (alpha == 0) {
-                MarkdownStbInternal_AdvanceGradientFixed(&gradientPosition, gradientStep);
                 destRow++;
                 continue;
             }
 
-            COLORREF sample = MarkdownStbInternal_SampleGradient(colorTag->colors,
-                                                          colorCount,
-                                                          gradientPosition);
-            MarkdownStbInternal_AdvanceGradientFixed(&gradientPosition, gradientStep);
+            COLORREF sample = SampleColorTagColumn(colorTag, destX + (i - firstI),
+                                                   totalWidth, animOffsetFixed);
             int r = GetRValue(sample);
             int g = GetGValue(sample);
             int b = GetBValue(sample);
 
-            DWORD finalR = (r * alpha) / 255;
-            DWORD finalG = (g * alpha) / 255;
-            DWORD finalB = (b * alpha) / 255;
-            *destRow++ = (alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+            *destRow++ = DrawingBlend_Premultiply(DrawingBlend_ColorLanes(r, g, b), alpha);
         }
     }
 }
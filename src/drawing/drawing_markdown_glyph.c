@@ -111,6 +111,14 @@ void MarkdownStbInternal_PrepareGlyph(
         }
     }
 
+    if (context->layout && index < context->layout->len) {
+        const MarkdownLayoutGlyph* cached = &context->layout->glyphs[index];
+        glyph->metrics = cached->metrics;
+        glyph->charFontInfo = cached->charFontInfo;
+        glyph->charScale = cached->charScale;
+        return;
+    }
+
     glyph->charFontInfo = context->fontInfo;
     glyph->charScale = glyph->scale;
     while (context->curFontTagIdx < context->fontTagCount &&
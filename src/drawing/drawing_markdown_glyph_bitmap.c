@@ -4,6 +4,7 @@
  */
 
 #include "drawing/drawing_markdown_stb_internal.h"
+#include "drawing/drawing_effect_tiles.h"
 #include "drawing/drawing_text_stb.h"
 #include "markdown/markdown_interactive.h"
 
@@ -28,8 +29,8 @@ void MarkdownStbInternal_DrawGlyph(
         glyphFontInfo = glyph->charFontInfo;
         glyphScale = glyph->charScale;
     } else if (glyph->metrics.isFallback) {
-        glyphFontInfo = context->fallbackFontInfo;
-        glyphScale = glyph->fallbackScale;
+        glyphFontInfo = GetGlyphFontInfoSTB(&glyph->metrics, glyph->scale,
+                                            glyph->fallbackScale, &glyphScale);
     }
 
     int visibilityMargin = glyph->isItalic ? line->lineMaxHeight : 0;
@@ -69,22 +70,21 @@ void MarkdownStbInternal_DrawGlyph(
                         context->width);
                 }
             } else {
-                BlendCharBitmapGradientSTBWithInfo(
+                BlendCharBitmapGradientScanlineSTB(
                     context->bits, context->width, context->height,
-                    glyphX, glyphY, bitmap, w, h, 0, context->width,
-                    context->frameGradientInfo, context->timeOffset,
-                    context->activeEffect);
+                    glyphX, glyphY, bitmap, w, h, context->gradientScanline,
+                    context->timeOffset, context->activeEffect);
                 if (glyph->isBold) {
-                    BlendCharBitmapGradientSTBWithInfo(
+                    BlendCharBitmapGradientScanlineSTB(
                         context->bits, context->width, context->height,
-                        glyphXBold, glyphY, bitmap, w, h, 0,
-                        context->width, context->frameGradientInfo,
-                        context->timeOffset, context->activeEffect);
-                    BlendCharBitmapGradientSTBWithInfo(
+                        glyphXBold, glyphY, bitmap, w, h,
+                        context->gradientScanline, context->timeOffset,
+                        context->activeEffect);
+                    BlendCharBitmapGradientScanlineSTB(
                         context->bits, context->width, context->height,
-                        glyphX, glyphYBold, bitmap, w, h, 0,
-                        context->width, context->frameGradientInfo,
-                        context->timeOffset, context->activeEffect);
+                        glyphX, glyphYBold, bitmap, w, h,
+                        context->gradientScanline, context->timeOffset,
+                        context->activeEffect);
                 }
             }
         } else if (glyph->useColorTagGradient && glyph->activeColorTag) {
@@ -153,6 +153,7 @@ void MarkdownStbInternal_DrawGlyph(
         stbtt_FreeBitmap(bitmap, NULL);
 
         if (glyph->isStrikethrough) {
+            DrawingEffectTiles_Flush();
             int lineY = MarkdownStbInternal_AddIntClamped(
                 baselineY, -(h / 3));
             DWORD* pixels = (DWORD*)context->bits;
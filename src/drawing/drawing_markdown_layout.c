@@ -0,0 +1,189 @@
+/**
+ * @file drawing_markdown_layout.c
+ * @brief Small LRU of shaped Markdown layouts shared by measure and render.
+ *
+ * A frame measures its text and then draws it; both passes used to resolve
+ * every glyph again. Layouts are keyed by the text, size, heading and
+ * font-tag signatures and the STB font generation, so the clock, a plugin
+ * text and a preview can alternate without evicting each other.
+ */
+
+#include "drawing/drawing_markdown_stb_internal.h"
+#include "drawing/drawing_text_stb.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <wchar.h>
+
+static MarkdownTextLayout g_layoutCache[MARKDOWN_LAYOUT_CACHE_SIZE];
+static DWORD g_layoutClock = 0;
+
+static DWORD HashLayoutText(const wchar_t* text, size_t len) {
+    DWORD hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (DWORD)text[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static DWORD ComputeHeadingSignature(const MarkdownHeading* headings, int headingCount) {
+    DWORD hash = 2166136261u;
+
+    if (!headings || headingCount <= 0) {
+        return (hash ^ 0u) * 16777619u;
+    }
+
+    hash = (hash ^ (DWORD)headingCount) * 16777619u;
+    for (int i = 0; i < headingCount; ++i) {
+        hash = (hash ^ (DWORD)headings[i].level) * 16777619u;
+        hash = (hash ^ (DWORD)headings[i].startPos) * 16777619u;
+        hash = (hash ^ (DWORD)headings[i].endPos) * 16777619u;
+    }
+
+    return hash;
+}
+
+static DWORD ComputeFontTagSignature(const MarkdownFontTag* fontTags, int fontTagCount) {
+    DWORD hash = 2166136261u;
+
+    if (!fontTags || fontTagCount <= 0) {
+        return (hash ^ 0u) * 16777619u;
+    }
+
+    hash = (hash ^ (DWORD)fontTagCount) * 16777619u;
+    for (int i = 0; i < fontTagCount; ++i) {
+        hash = (hash ^ (DWORD)fontTags[i].startPos) * 16777619u;
+        hash = (hash ^ (DWORD)fontTags[i].endPos) * 16777619u;
+        const wchar_t* p = fontTags[i].fontName;
+        while (p && *p) {
+            hash = (hash ^ (DWORD)*p++) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+static void FreeLayout(MarkdownTextLayout* layout) {
+    free((void*)layout->text);
+    free(layout->lines);
+    free(layout->glyphs);
+    ZeroMemory(layout, sizeof(*layout));
+}
+
+static MarkdownTextLayout* FindLayout(const MarkdownTextLayout* key) {
+    for (int i = 0; i < MARKDOWN_LAYOUT_CACHE_SIZE; i++) {
+        MarkdownTextLayout* entry = &g_layoutCache[i];
+        if (entry->valid &&
+            entry->textHash == key->textHash &&
+            entry->len == key->len &&
+            entry->fontSize == key->fontSize &&
+            fabsf(entry->fontScale - key->fontScale) < 0.0001f &&
+            entry->headingSignature == key->headingSignature &&
+            entry->fontTagSignature == key->fontTagSignature &&
+            entry->fontStateGeneration == key->fontStateGeneration &&
+            wmemcmp(entry->text, key->text, key->len) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static MarkdownTextLayout* ClaimLayoutSlot(void) {
+    MarkdownTextLayout* victim = &g_layoutCache[0];
+    for (int i = 0; i < MARKDOWN_LAYOUT_CACHE_SIZE; i++) {
+        MarkdownTextLayout* entry = &g_layoutCache[i];
+        if (!entry->valid) {
+            victim = entry;
+            break;
+        }
+        if (entry->lastUse < victim->lastUse) victim = entry;
+    }
+    FreeLayout(victim);
+    return victim;
+}
+
+/* Caller holds BeginFontUseSTB() */
+BOOL MarkdownStbInternal_AcquireLayout(
+    const wchar_t* text,
+    const MarkdownHeading* headings, int headingCount,
+    const MarkdownFontTag* fontTags, int fontTagCount,
+    int fontSize, float fontScale, int* width, int* height,
+    const MarkdownTextLayout** outLayout) {
+    if (outLayout) *outLayout = NULL;
+    if (!text) return FALSE;
+
+    MarkdownTextLayout key = {0};
+    key.text = text;
+    key.len = wcslen(text);
+    key.textHash = HashLayoutText(text, key.len);
+    key.fontSize = fontSize;
+    key.fontScale = fontScale;
+    key.headingSignature = ComputeHeadingSignature(headings, headingCount);
+    key.fontTagSignature = ComputeFontTagSignature(fontTags, fontTagCount);
+    key.fontStateGeneration = GetFontStateGenerationSTB();
+
+    MarkdownTextLayout* entry = FindLayout(&key);
+    if (entry) {
+        entry->lastUse = ++g_layoutClock;
+        if (width) *width = entry->width;
+        if (height) *height = entry->height;
+        if (outLayout) *outLayout = entry;
+        return TRUE;
+    }
+
+    size_t lineCount = 1;
+    for (size_t i = 0; i < key.len; i++) {
+        if (text[i] == L'\n') lineCount++;
+    }
+
+    entry = ClaimLayoutSlot();
+    *entry = key;
+    wchar_t* textCopy = (wchar_t*)malloc((key.len + 1) * sizeof(wchar_t));
+    entry->lines = (MarkdownLayoutLine*)malloc(lineCount * sizeof(MarkdownLayoutLine));
+    entry->glyphs = key.len > 0
+        ? (MarkdownLayoutGlyph*)malloc(key.len * sizeof(MarkdownLayoutGlyph))
+        : NULL;
+    if (textCopy) wmemcpy(textCopy, text, key.len + 1);
+    entry->text = textCopy;
+
+    if (!textCopy || !entry->lines || (key.len > 0 && !entry->glyphs)) {
+        /* Out of memory: still measure, just without keeping the layout */
+        FreeLayout(entry);
+        MarkdownTextLayout scratch = key;
+        BOOL measured = MarkdownStbInternal_BuildLayout(
+            &scratch, headings, headingCount, fontTags, fontTagCount);
+        if (measured && width) *width = scratch.width;
+        if (measured && height) *height = scratch.height;
+        return measured;
+    }
+
+    if (!MarkdownStbInternal_BuildLayout(entry, headings, headingCount,
+                                         fontTags, fontTagCount)) {
+        FreeLayout(entry);
+        return FALSE;
+    }
+    if (width) *width = entry->width;
+    if (height) *height = entry->height;
+
+    /* Loading a <font:> face moves the generation; the entry is rebuilt on
+     * the next call, once every face it needs is resident. */
+    if (GetFontStateGenerationSTB() != key.fontStateGeneration) {
+        FreeLayout(entry);
+        return TRUE;
+    }
+
+    entry->valid = TRUE;
+    entry->lastUse = ++g_layoutClock;
+    if (outLayout) *outLayout = entry;
+    return TRUE;
+}
+
+void ClearMarkdownLayoutCacheSTB(void) {
+    if (!BeginFontUseSTB()) return;
+    for (int i = 0; i < MARKDOWN_LAYOUT_CACHE_SIZE; i++) {
+        FreeLayout(&g_layoutCache[i]);
+    }
+    g_layoutClock = 0;
+    MarkdownStbInternal_ReleaseColorTagRow();
+    EndFontUseSTB();
+}
@@ -4,6 +4,7 @@
  */
 
 #include "drawing/drawing_markdown_stb_internal.h"
+#include "drawing/drawing_effect_tiles.h"
 #include "drawing/drawing_text_stb.h"
 #include "markdown/markdown_interactive.h"
 
@@ -33,6 +34,13 @@ void MarkdownStbInternal_MeasureLine(
     if (!context || !line) return;
     line->start = start;
     line->end = end;
+    if (context->layout && context->layoutLine < context->layout->lineCount) {
+        const MarkdownLayoutLine* cached =
+            &context->layout->lines[context->layoutLine];
+        line->lineMaxHeight = cached->lineMaxHeight;
+        line->maxAscent = cached->maxAscent;
+        return;
+    }
     line->lineMaxHeight = MarkdownStbInternal_GetLineHeightFromMetric(
         context->lineHeightMetric, context->baseScale);
     line->maxAscent = (int)(context->baseAscent * context->baseScale);
@@ -82,6 +90,7 @@ BOOL MarkdownStbInternal_DrawHorizontalRule(
         return TRUE;
     }
 
+    DrawingEffectTiles_Flush();
     DWORD* pixels = (DWORD*)context->bits;
     long long hrLeft = (long long)context->blockLeftX;
     int hrWidth = context->maxLineWidth;
@@ -166,6 +175,7 @@ void MarkdownStbInternal_PrepareLineDecorations(
                 &firstY, &lastY) &&
             MarkdownStbInternal_CalculateVisibleSpan(
                 barX, barWidth, context->width, &firstX, &lastX)) {
+            DrawingEffectTiles_Flush();
             DWORD* pixels = (DWORD*)context->bits;
             for (int yOffset = firstY; yOffset < lastY; yOffset++) {
                 int y = (int)((long long)line->currentY + yOffset);
@@ -9,18 +9,19 @@
 #include <math.h>
 #include <wchar.h>
 
-BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
-                              const MarkdownHeading* headings, int headingCount,
-                              const MarkdownFontTag* fontTags, int fontTagCount,
-                              int fontSize, float fontScale,
-                              int* width, int* height) {
-    if (!BeginFontUseSTB()) return FALSE;
-    BOOL result = FALSE;
-
-    if (!IsFontLoadedSTB() || !text) goto done;
+/* Caller holds BeginFontUseSTB(). Lines and glyphs are recorded only when
+ * their arrays are allocated; width and height are always produced. */
+BOOL MarkdownStbInternal_BuildLayout(
+    MarkdownTextLayout* layout,
+    const MarkdownHeading* headings, int headingCount,
+    const MarkdownFontTag* fontTags, int fontTagCount) {
+    if (!layout || !layout->text || !IsFontLoadedSTB()) return FALSE;
+
+    const wchar_t* text = layout->text;
+    float fontScale = layout->fontScale;
     if (!isfinite(fontScale) || fontScale <= 0.0f) fontScale = 1.0f;
 
-    float scaledFontSize = (float)((double)fontSize * (double)fontScale);
+    float scaledFontSize = (float)((double)layout->fontSize * (double)fontScale);
     if (!isfinite(scaledFontSize) || scaledFontSize < 1.0f) scaledFontSize = 1.0f;
 
     const stbtt_fontinfo* fontInfo = GetMainFontInfoSTB();
@@ -33,13 +34,18 @@ BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
     int ascent, descent, lineGap;
     stbtt_GetFontVMetrics(fontInfo, &ascent, &descent, &lineGap);
     int lineHeightMetric = ascent - descent + lineGap;
+    int baseLineHeight = MarkdownStbInternal_GetLineHeightFromMetric(lineHeightMetric, baseScale);
+    int baseAscent = (int)(ascent * baseScale);
 
     int maxWidth = 0;
     int curLineWidth = 0;
     int totalHeight = 0;
-    int curLineMaxHeight = MarkdownStbInternal_GetLineHeightFromMetric(lineHeightMetric, baseScale); // Default to base height
+    int curLineMaxHeight = baseLineHeight; // Default to base height
+    /* The renderer also sizes horizontal rule lines by their own markers */
+    MarkdownLayoutLine curLine = {baseLineHeight, baseAscent};
+    int lineIndex = 0;
 
-    size_t len = wcslen(text);
+    size_t len = layout->len;
     // Optimization: Track current range indexes
     int curHeadingIdx = 0;
     int curFontTagIdx = 0;
@@ -52,14 +58,15 @@ BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
             if (curLineWidth > maxWidth) maxWidth = curLineWidth;
             curLineWidth = 0;
             totalHeight = MarkdownStbInternal_AddIntClamped(totalHeight, curLineMaxHeight);
-            curLineMaxHeight = MarkdownStbInternal_GetLineHeightFromMetric(lineHeightMetric, baseScale); // Reset to base
+            curLineMaxHeight = baseLineHeight; // Reset to base
+            if (layout->lines) layout->lines[lineIndex] = curLine;
+            lineIndex++;
+            curLine.lineMaxHeight = baseLineHeight;
+            curLine.maxAscent = baseAscent;
             continue;
         }
         if (text[i] == L'\r') continue;
 
-        // Skip horizontal rule markers (they span full width, don't affect max width)
-        if (text[i] == L'\x2500') continue;
-
         // Determine style
         float scale = baseScale;
         float fallbackScale = fallbackBaseScale;
@@ -76,6 +83,17 @@ BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
             }
         }
 
+        // Update line height if this char is taller
+        int h = MarkdownStbInternal_GetLineHeightFromMetric(lineHeightMetric, scale);
+        if (h > curLine.lineMaxHeight) curLine.lineMaxHeight = h;
+        int a = MarkdownStbInternal_GetLineHeightFromMetric(ascent, scale);
+        if (a > curLine.maxAscent) curLine.maxAscent = a;
+
+        // Horizontal rule markers span full width, so they don't affect the size
+        BOOL measured = text[i] != L'\x2500';
+        if (measured && h > curLineMaxHeight) curLineMaxHeight = h;
+        if (!measured && !layout->glyphs) continue;
+
         const stbtt_fontinfo* charFontInfo = fontInfo;
         float charScale = scale;
         while (curFontTagIdx < fontTagCount && charPos >= fontTags[curFontTagIdx].endPos) {
@@ -95,29 +113,60 @@ BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
             }
         }
 
-        // Update line height if this char is taller
-        int h = MarkdownStbInternal_GetLineHeightFromMetric(lineHeightMetric, scale);
-        if (h > curLineMaxHeight) curLineMaxHeight = h;
-
+        /* Kerning stops at the line end, as it does when the line is drawn */
+        wchar_t next = (i + 1 < len && text[i + 1] != L'\n') ? text[i + 1] : 0;
         GlyphMetrics gm;
         if (charFontInfo != fontInfo) {
             if (!GetCachedFontCharMetricsSTB(charFontInfo, text[i], charScale, &gm) ||
                 gm.index == 0) {
-                GetCharMetricsSTB(text[i], (i < len - 1) ? text[i+1] : 0, scale, fallbackScale, &gm);
+                GetCharMetricsSTB(text[i], next, scale, fallbackScale, &gm);
+                charFontInfo = fontInfo;
+                charScale = scale;
             }
         } else {
-            GetCharMetricsSTB(text[i], (i < len - 1) ? text[i+1] : 0, scale, fallbackScale, &gm);
+            GetCharMetricsSTB(text[i], next, scale, fallbackScale, &gm);
+        }
+        if (measured) {
+            curLineWidth = MarkdownStbInternal_AddIntClamped(curLineWidth, gm.advance + gm.kern);
+        }
+        if (layout->glyphs) {
+            layout->glyphs[i].metrics = gm;
+            layout->glyphs[i].charFontInfo = charFontInfo;
+            layout->glyphs[i].charScale = charScale;
         }
-        curLineWidth = MarkdownStbInternal_AddIntClamped(curLineWidth, gm.advance + gm.kern);
     }
     if (curLineWidth > maxWidth) maxWidth = curLineWidth;
     totalHeight = MarkdownStbInternal_AddIntClamped(totalHeight, curLineMaxHeight);
+    if (layout->lines) layout->lines[lineIndex] = curLine;
+
+    layout->lineCount = lineIndex + 1;
+    layout->width = maxWidth;
+    layout->height = totalHeight;
+    return TRUE;
+}
 
-    if (width) *width = maxWidth;
-    if (height) *height = totalHeight;
-    result = TRUE;
+BOOL MeasureMarkdownSTBScaled(const wchar_t* text,
+                              const MarkdownHeading* headings, int headingCount,
+                              const MarkdownFontTag* fontTags, int fontTagCount,
+                              int fontSize, float fontScale,
+                              int* width, int* height) {
+    if (!BeginFontUseSTB()) return FALSE;
+    BOOL result = FALSE;
+
+    if (IsFontLoadedSTB() && text) {
+        int measuredWidth = 0;
+        int measuredHeight = 0;
+        if (MarkdownStbInternal_AcquireLayout(text, headings, headingCount,
+                                              fontTags, fontTagCount,
+                                              fontSize, fontScale,
+                                              &measuredWidth, &measuredHeight,
+                                              NULL)) {
+            if (width) *width = measuredWidth;
+            if (height) *height = measuredHeight;
+            result = TRUE;
+        }
+    }
 
-done:
     EndFontUseSTB();
     return result;
 }
@@ -4,6 +4,7 @@
  */
 
 #include "drawing/drawing_markdown_stb_internal.h"
+#include "drawing/drawing_effect_tiles.h"
 #include "drawing/drawing_text_stb.h"
 #include "log.h"
 #include "markdown/markdown_interactive.h"
@@ -66,11 +67,14 @@ static BOOL InitializeMarkdownRenderContext(
     context->fontInfo = GetMainFontInfoSTB();
     context->fallbackFontInfo = GetFallbackFontInfoSTB();
     context->fallbackLoaded = IsFallbackFontLoadedSTB();
+    /* Sized exactly as the layout was measured, so cached glyphs line up */
+    float pixelHeight = (float)((double)fontSize * (double)fontScale);
+    if (!isfinite(pixelHeight) || pixelHeight < 1.0f) pixelHeight = 1.0f;
     context->baseScale = stbtt_ScaleForPixelHeight(
-        context->fontInfo, (float)(fontSize * fontScale));
+        context->fontInfo, pixelHeight);
     context->fallbackBaseScale = context->fallbackLoaded
         ? stbtt_ScaleForPixelHeight(
-              context->fallbackFontInfo, (float)(fontSize * fontScale))
+              context->fallbackFontInfo, pixelHeight)
         : 0.0f;
 
     int baseDescent = 0;
@@ -102,6 +106,13 @@ static BOOL InitializeMarkdownRenderContext(
         context->timeOffset = (int)frameTick;
     }
 
+    /* Gradient colors depend only on the column: compute them once a frame */
+    MarkdownStbInternal_ResetColorTagRow(width);
+    if (context->frameGradientInfo) {
+        context->gradientScanline = AcquireGradientScanlineSTB(
+            context->frameGradientInfo, 0, width, context->timeOffset, width);
+    }
+
     context->globalStrikethroughLineColor =
         0xFF000000 | (GetRValue(color) << 16) |
         (GetGValue(color) << 8) | GetBValue(color);
@@ -150,6 +161,16 @@ void RenderMarkdownSTBMeasured(void* bits, int width, int height,
         EndFontUseSTB();
         return;
     }
+    int layoutWidth = 0;
+    int layoutHeight = 0;
+    MarkdownStbInternal_AcquireLayout(
+        text, headings, headingCount, fontTags, fontTagCount, fontSize,
+        fontScale, &layoutWidth, &layoutHeight, &context.layout);
+
+    /* Effect glyphs are recorded and drawn in parallel bands; direct
+       pixel writes in between flush first to keep the draw order */
+    BOOL tiled = context.activeEffect != EFFECT_TYPE_NONE &&
+                 DrawingEffectTiles_Begin((DWORD*)bits, width, height);
 
     size_t currentLineStart = 0;
     for (size_t index = 0; index <= context.len; index++) {
@@ -168,6 +189,7 @@ void RenderMarkdownSTBMeasured(void* bits, int width, int height,
         if (MarkdownStbInternal_DrawHorizontalRule(&context, &line)) {
             context.currentY = MarkdownStbInternal_AddIntClamped(
                 context.currentY, line.lineMaxHeight);
+            context.layoutLine++;
             currentLineStart = index + 1;
             continue;
         }
@@ -176,8 +198,10 @@ void RenderMarkdownSTBMeasured(void* bits, int width, int height,
         MarkdownStbInternal_RenderLine(&context, &line);
         context.currentY = MarkdownStbInternal_AddIntClamped(
             context.currentY, line.lineMaxHeight);
+        context.layoutLine++;
         currentLineStart = index + 1;
     }
+    if (tiled) DrawingEffectTiles_End();
 
     for (int i = 0; i < linkCount; i++) {
         if (links[i].linkUrl &&
@@ -10,6 +10,44 @@
 #include "color/gradient.h"
 
 #define MARKDOWN_GRADIENT_FIXED_ONE (1LL << 32)
+#define MARKDOWN_LAYOUT_CACHE_SIZE 8
+
+/** @brief Vertical metrics of one source line, as the renderer lays it out. */
+typedef struct {
+    int lineMaxHeight;
+    int maxAscent;
+} MarkdownLayoutLine;
+
+/** @brief Resolved face and metrics for one source character. */
+typedef struct {
+    GlyphMetrics metrics;
+    const stbtt_fontinfo* charFontInfo;
+    float charScale;
+} MarkdownLayoutGlyph;
+
+/**
+ * @brief Shaped layout of one text at one size, shared by measure and render.
+ *
+ * Face pointers stay valid while the STB font generation is unchanged, so a
+ * layout is only reused at the generation it was built under.
+ */
+typedef struct {
+    BOOL valid;
+    DWORD textHash;
+    const wchar_t* text;
+    size_t len;
+    int fontSize;
+    float fontScale;
+    DWORD headingSignature;
+    DWORD fontTagSignature;
+    DWORD fontStateGeneration;
+    DWORD lastUse;
+    int width;
+    int height;
+    MarkdownLayoutLine* lines;
+    int lineCount;
+    MarkdownLayoutGlyph* glyphs;
+} MarkdownTextLayout;
 
 typedef struct {
     void* bits;
@@ -59,6 +97,9 @@ typedef struct {
     int timeOffset;
     DWORD globalStrikethroughLineColor;
     int checkboxIndex;
+    const GradientScanline* gradientScanline;
+    const MarkdownTextLayout* layout;
+    int layoutLine;
 } MarkdownRenderContext;
 
 typedef struct {
@@ -116,6 +157,8 @@ void MarkdownStbInternal_BlendItalicGradient(
     void* destBits, int destWidth, int destHeight,
     int x_pos, int y_pos, const unsigned char* bitmap, int w, int h,
     float slant, const GradientInfo* info, int timeOffset, int totalWidth);
+void MarkdownStbInternal_ResetColorTagRow(int width);
+void MarkdownStbInternal_ReleaseColorTagRow(void);
 void MarkdownStbInternal_BlendColorTagGradient(
     void* destBits, int destWidth, int destHeight,
     int x_pos, int y_pos, const unsigned char* bitmap, int w, int h,
@@ -126,6 +169,17 @@ void MarkdownStbInternal_BlendColorTagGradientItalic(
     const MarkdownColorTag* colorTag, int timeOffset, int totalWidth,
     float slant);
 
+BOOL MarkdownStbInternal_BuildLayout(
+    MarkdownTextLayout* layout,
+    const MarkdownHeading* headings, int headingCount,
+    const MarkdownFontTag* fontTags, int fontTagCount);
+BOOL MarkdownStbInternal_AcquireLayout(
+    const wchar_t* text,
+    const MarkdownHeading* headings, int headingCount,
+    const MarkdownFontTag* fontTags, int fontTagCount,
+    int fontSize, float fontScale, int* width, int* height,
+    const MarkdownTextLayout** outLayout);
+
 COLORREF MarkdownStbInternal_GetAlertColor(BlockquoteAlertType type);
 void MarkdownStbInternal_MeasureLine(
     const MarkdownRenderContext* context, size_t start, size_t end,
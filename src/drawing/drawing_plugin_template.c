@@ -0,0 +1,54 @@
+/**
+ * @file drawing_plugin_template.c
+ * @brief Slot splicing and image offsets for plugin text templates.
+ */
+
+#include "drawing/drawing_plugin_template.h"
+
+#include <string.h>
+
+static void AppendSpan(wchar_t** dst, size_t* remaining,
+                       const wchar_t* text, size_t textLen) {
+    if (!text || textLen == 0 || *remaining == 0) return;
+    if (textLen > *remaining) textLen = *remaining;
+    memcpy(*dst, text, textLen * sizeof(wchar_t));
+    *dst += textLen;
+    *remaining -= textLen;
+}
+
+size_t PluginTemplate_Splice(const wchar_t* templateText, size_t templateLen,
+                             const int* slotOffsets, int slotCount,
+                             const wchar_t* timerText,
+                             wchar_t* out, size_t outCount) {
+    if (!out || outCount == 0) return 0;
+    size_t timerLen = timerText ? wcslen(timerText) : 0;
+
+    wchar_t* dst = out;
+    size_t remaining = outCount - 1;
+    size_t copied = 0;
+    for (int i = 0; templateText && i < slotCount && remaining > 0; i++) {
+        size_t offset = (size_t)slotOffsets[i];
+        if (offset < copied || offset > templateLen) break;
+        AppendSpan(&dst, &remaining, templateText + copied, offset - copied);
+        AppendSpan(&dst, &remaining, timerText, timerLen);
+        copied = offset;
+    }
+    if (templateText) {
+        AppendSpan(&dst, &remaining, templateText + copied, templateLen - copied);
+    }
+    *dst = L'\0';
+    return (size_t)(dst - out);
+}
+
+int PluginTemplate_ImagePosition(int templatePos, int imageIndex,
+                                 const int* slotImagesBefore, int slotCount,
+                                 size_t timerLen, size_t outLen) {
+    int slots = 0;
+    while (slots < slotCount && slotImagesBefore[slots] <= imageIndex) {
+        slots++;
+    }
+    unsigned long long position = (unsigned long long)(templatePos > 0 ? templatePos : 0) +
+                                  (unsigned long long)slots * (unsigned long long)timerLen;
+    if (position > outLen) position = outLen;
+    return (int)position;
+}
@@ -20,11 +20,19 @@ void HandleWindowPaint(HWND hwnd, const PAINTSTRUCT* ps) {
     }
 
     PaintFrameContext frame = {0};
-    if (!PrepareDrawingPaintFrame(&frame, hwnd, ps)) {
-        return;
-    }
-    if (!RenderDrawingPaintFrame(&frame)) {
-        return;
+    RenderMetrics_BeginFrame();
+    LONGLONG stageBegin = RenderMetrics_StageBegin();
+    BOOL prepared = PrepareDrawingPaintFrame(&frame, hwnd, ps);
+    RenderMetrics_StageEnd(RENDER_STAGE_PREPARE, stageBegin);
+    if (prepared) {
+        stageBegin = RenderMetrics_StageBegin();
+        BOOL rendered = RenderDrawingPaintFrame(&frame);
+        RenderMetrics_StageEnd(RENDER_STAGE_RENDER, stageBegin);
+        if (rendered) {
+            stageBegin = RenderMetrics_StageBegin();
+            PresentDrawingPaintFrame(&frame);
+            RenderMetrics_StageEnd(RENDER_STAGE_PRESENT, stageBegin);
+        }
     }
-    PresentDrawingPaintFrame(&frame);
+    RenderMetrics_EndFrame();
 }
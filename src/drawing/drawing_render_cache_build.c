@@ -5,36 +5,6 @@
 
 #include "drawing_render_internal.h"
 
-BOOL RefreshMeasureCacheFontTags(const MarkdownFontTag* fontTags, int fontTagCount) {
-    if (!fontTags || fontTagCount <= 0) {
-        return TRUE;
-    }
-
-    if (!CanUseMeasureCacheForFontTags(fontTags, fontTagCount)) {
-        return FALSE;
-    }
-
-    if (!BeginFontUseSTB()) {
-        return FALSE;
-    }
-
-    for (int i = 0; i < fontTagCount; i++) {
-        BOOL seen = FALSE;
-        for (int j = 0; j < i; j++) {
-            if (wcscmp(fontTags[i].fontName, fontTags[j].fontName) == 0) {
-                seen = TRUE;
-                break;
-            }
-        }
-        if (!seen) {
-            (void)GetCachedFontSTB(fontTags[i].fontName);
-        }
-    }
-
-    EndFontUseSTB();
-    return TRUE;
-}
-
 void EnsureMarkdownRenderCache(const wchar_t* text) {
     if (!text) {
         ClearMarkdownRenderCache();
@@ -60,6 +30,7 @@ void EnsureMarkdownRenderCache(const wchar_t* text) {
         return;
     }
 
+    LONGLONG parseBegin = RenderMetrics_StageBegin();
     BOOL parsedMarkdown = ParseMarkdownLinks(
         text,
         &g_markdownRenderCache.mdText,
@@ -71,6 +42,7 @@ void EnsureMarkdownRenderCache(const wchar_t* text) {
         &g_markdownRenderCache.colorTags, &g_markdownRenderCache.colorTagCount,
         &g_markdownRenderCache.fontTags, &g_markdownRenderCache.fontTagCount
     );
+    RenderMetrics_StageEnd(RENDER_STAGE_MARKDOWN_PARSE, parseBegin);
     g_markdownRenderCache.isMarkdown = parsedMarkdown;
 
     if (!parsedMarkdown) {
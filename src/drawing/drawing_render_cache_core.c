@@ -1,50 +1,10 @@
 /**
  * @file drawing_render_cache_core.c
- * @brief Text and markdown cache signatures and stable measurement text.
+ * @brief Markdown and plugin paint caches and stable measurement text.
  */
 
 #include "drawing_render_internal.h"
 
-void ClearTextMeasureCache(void) {
-    ZeroMemory(&g_textMeasureCache, sizeof(g_textMeasureCache));
-}
-DWORD ComputeHeadingSignature(const MarkdownHeading* headings, int headingCount) {
-    DWORD hash = 2166136261u;
-
-    if (!headings || headingCount <= 0) {
-        return (hash ^ 0u) * 16777619u;
-    }
-
-    hash = (hash ^ (DWORD)headingCount) * 16777619u;
-    for (int i = 0; i < headingCount; ++i) {
-        hash = (hash ^ (DWORD)headings[i].level) * 16777619u;
-        hash = (hash ^ (DWORD)headings[i].startPos) * 16777619u;
-        hash = (hash ^ (DWORD)headings[i].endPos) * 16777619u;
-    }
-
-    return hash;
-}
-
-DWORD ComputeFontTagSignature(const MarkdownFontTag* fontTags, int fontTagCount) {
-    DWORD hash = 2166136261u;
-
-    if (!fontTags || fontTagCount <= 0) {
-        return (hash ^ 0u) * 16777619u;
-    }
-
-    hash = (hash ^ (DWORD)fontTagCount) * 16777619u;
-    for (int i = 0; i < fontTagCount; ++i) {
-        hash = (hash ^ (DWORD)fontTags[i].startPos) * 16777619u;
-        hash = (hash ^ (DWORD)fontTags[i].endPos) * 16777619u;
-        const wchar_t* p = fontTags[i].fontName;
-        while (p && *p) {
-            hash = (hash ^ (DWORD)*p++) * 16777619u;
-        }
-    }
-
-    return hash;
-}
-
 void ClearMarkdownRenderCache(void) {
     if (g_markdownRenderCache.links) {
         FreeMarkdownLinks(g_markdownRenderCache.links, g_markdownRenderCache.linkCount);
@@ -63,6 +23,7 @@ void ClearPluginPaintCache(void) {
     if (g_pluginPaintCache.images) {
         FreeMarkdownImages(g_pluginPaintCache.images, g_pluginPaintCache.imageCount);
     }
+    free(g_pluginPaintCache.imageTemplatePositions);
     ZeroMemory(&g_pluginPaintCache, sizeof(g_pluginPaintCache));
 }
 
@@ -148,29 +109,3 @@ void StabilizeScaleGestureText(HWND hwnd, wchar_t* text, size_t textCount) {
              _countof(g_scaleGestureTextCache.text),
              text);
 }
-
-BOOL CanUseMeasureCacheForFontTags(const MarkdownFontTag* fontTags, int fontTagCount) {
-    if (!fontTags || fontTagCount <= 0) {
-        return TRUE;
-    }
-
-    int uniqueCount = 0;
-    for (int i = 0; i < fontTagCount; i++) {
-        BOOL seen = FALSE;
-        for (int j = 0; j < i; j++) {
-            if (wcscmp(fontTags[i].fontName, fontTags[j].fontName) == 0) {
-                seen = TRUE;
-                break;
-            }
-        }
-        if (seen) {
-            continue;
-        }
-
-        if (++uniqueCount > MAX_CACHED_FONTS) {
-            return FALSE;
-        }
-    }
-
-    return TRUE;
-}
@@ -31,56 +31,21 @@ BOOL MeasureTextMarkdown(const wchar_t* text, const RenderContext* ctx, SIZE* ou
                                const MarkdownHeading* headings, int headingCount,
                                const MarkdownFontTag* fontTags, int fontTagCount) {
     if (ctx && ctx->fontPathResolved && text && outSize) {
-        int fontSize = ctx->renderFontSize;
-        float fontScaleFactor = ctx->fontScaleFactor;
-        BOOL isMarkdown = (headings && headingCount > 0) || (fontTags && fontTagCount > 0);
-        DWORD headingSignature = ComputeHeadingSignature(headings, headingCount);
-        DWORD fontTagSignature = ComputeFontTagSignature(fontTags, fontTagCount);
-
         if (!InitFontSTB(ctx->absoluteFontPath)) {
             return FALSE;
         }
 
-        BOOL canUseMeasureCache = RefreshMeasureCacheFontTags(fontTags, fontTagCount);
-
-        DWORD fontStateGeneration = GetFontStateGenerationSTB();
-
-        if (canUseMeasureCache &&
-            g_textMeasureCache.valid &&
-            g_textMeasureCache.isMarkdown == isMarkdown &&
-            g_textMeasureCache.fontSize == fontSize &&
-            fabsf(g_textMeasureCache.fontScaleFactor - fontScaleFactor) < 0.0001f &&
-            g_textMeasureCache.headingSignature == headingSignature &&
-            g_textMeasureCache.fontTagSignature == fontTagSignature &&
-            g_textMeasureCache.fontStateGeneration == fontStateGeneration &&
-            strcmp(g_textMeasureCache.fontPath, ctx->absoluteFontPath) == 0 &&
-            CachedWideTextEquals(g_textMeasureCache.text,
-                                 _countof(g_textMeasureCache.text),
-                                 g_textMeasureCache.textLen,
-                                 text)) {
-            *outSize = g_textMeasureCache.size;
-            return TRUE;
-        }
-
+        /* Repeat measurements are served by the Markdown layout cache */
         int w, h;
-        if (MeasureMarkdownSTBScaled(text, headings, headingCount, fontTags, fontTagCount,
-                                     fontSize, fontScaleFactor, &w, &h)) {
+        LONGLONG measureBegin = RenderMetrics_StageBegin();
+        BOOL measured = MeasureMarkdownSTBScaled(text, headings, headingCount,
+                                                 fontTags, fontTagCount,
+                                                 ctx->renderFontSize,
+                                                 ctx->fontScaleFactor, &w, &h);
+        RenderMetrics_StageEnd(RENDER_STAGE_MEASURE, measureBegin);
+        if (measured) {
             outSize->cx = w;
             outSize->cy = h;
-            g_textMeasureCache.valid = TRUE;
-            g_textMeasureCache.isMarkdown = isMarkdown;
-            g_textMeasureCache.fontSize = fontSize;
-            g_textMeasureCache.fontScaleFactor = fontScaleFactor;
-            g_textMeasureCache.headingSignature = headingSignature;
-            g_textMeasureCache.fontTagSignature = fontTagSignature;
-            g_textMeasureCache.fontStateGeneration = GetFontStateGenerationSTB();
-            strcpy_s(g_textMeasureCache.fontPath, sizeof(g_textMeasureCache.fontPath),
-                     ctx->absoluteFontPath);
-            CopyCachedWideText(g_textMeasureCache.text,
-                               _countof(g_textMeasureCache.text),
-                               &g_textMeasureCache.textLen,
-                               text);
-            g_textMeasureCache.size = *outSize;
             return TRUE;
         }
     }
@@ -144,10 +109,13 @@ BOOL RenderTextMarkdown(HDC hdc, const RECT* rect, const wchar_t* text, const Re
 
 void CleanupDrawingRenderCache(void) {
     ClearClickableRegions();
+    PublishClickableRegions();
     ClearPluginPaintCache();
     ClearMarkdownRenderCache();
-    ClearTextMeasureCache();
+    ClearMarkdownLayoutCacheSTB();
+    ReleaseGradientScanlineSTB();
     ReleaseScaleFrameSnapshot();
     ReleaseRenderDibCache();
+    ReleaseRenderPresentCache();
     CleanupFontSTB();
 }
@@ -31,11 +31,11 @@ BOOL RenderDrawingPaintFrame(PaintFrameContext* frame) {
     BOOL measuredTextSizeValid = frame->measuredTextSizeValid;
 
     HDC memDC;
-    HBITMAP memBitmap, oldBitmap;
+    HBITMAP memBitmap;
     void* pBits = NULL;
 
     // Create buffer with the final correct size
-    if (!SetupDoubleBufferDIB(hdc, &rect, &memDC, &memBitmap, &oldBitmap, &pBits)) {
+    if (!SetupDoubleBufferDIB(hdc, &rect, &memDC, &memBitmap, &pBits)) {
         DWORD error = GetLastError();
         if (ShouldLogMainWindowRenderFailure()) {
             WriteLog(LOG_LEVEL_ERROR,
@@ -127,6 +127,8 @@ BOOL RenderDrawingPaintFrame(PaintFrameContext* frame) {
                 }
             }
 
+            PublishClickableRegions();
+
             // Fill clickable regions with minimal alpha for mouse hit-testing (non-edit mode only)
             if (!CLOCK_EDIT_MODE) {
                 FillClickableRegionsAlpha(pixels, rect.right, rect.bottom);
@@ -134,6 +136,7 @@ BOOL RenderDrawingPaintFrame(PaintFrameContext* frame) {
 
             // Render images below text (centered horizontally like text)
             if (images && imageCount > 0) {
+                LONGLONG imageBegin = RenderMetrics_StageBegin();
                 int imgY = textHeight > 0 ? AddRenderDimensionClamped(textHeight, 5) : 5;
                 int maxW = rect.right - 10;
                 if (maxW <= 0) maxW = rect.right;  // Fallback if window too narrow
@@ -202,15 +205,22 @@ BOOL RenderDrawingPaintFrame(PaintFrameContext* frame) {
                 if (imageRenderCtxActive) {
                     EndImageRenderContext(&imageRenderCtx);
                 }
+                RenderMetrics_StageEnd(RENDER_STAGE_IMAGE, imageBegin);
             }
         } else if (CLOCK_EDIT_MODE) {
             FixAlphaChannel(pBits, rect.right, rect.bottom);
         }
     }
 
+    /* Frames without text still retire the previous frame's regions */
+    PublishClickableRegions();
+
+    if (RenderMetrics_IsOverlayEnabled()) {
+        RenderMetrics_DrawOverlay(memDC, pixels, rect.right, rect.bottom);
+    }
+
     frame->memDC = memDC;
     frame->memBitmap = memBitmap;
-    frame->oldBitmap = oldBitmap;
     frame->bits = pBits;
     frame->usedScaleComposite = usedScaleComposite;
     return TRUE;
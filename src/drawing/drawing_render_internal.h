@@ -22,19 +22,23 @@ const wchar_t* FindNextPluginTextMarker(const wchar_t* src,
 COLORREF ParseColorString(const char* colorStr, const GradientInfo* gradientInfo);
 int CalculateRenderFontSize(int baseFontSize, float scaleFactor);
 BOOL HasPotentialMarkdownSyntax(const wchar_t* text);
-void ClearTextMeasureCache(void);
-DWORD ComputeHeadingSignature(const MarkdownHeading* headings, int headingCount);
-DWORD ComputeFontTagSignature(const MarkdownFontTag* fontTags, int fontTagCount);
 void ClearMarkdownRenderCache(void);
 void ClearPluginPaintCache(void);
+BOOL CompilePluginTextTemplate(const wchar_t* pluginText, MarkdownImage* stackImages,
+                               MarkdownImage** images, int* imageCount,
+                               BOOL* imagesHeapAllocated, BOOL* imagesOwnedByCache);
+void SplicePluginText(const wchar_t* pluginText, const wchar_t* timerText,
+                      wchar_t* out, size_t outCount, MarkdownImage* stackImages,
+                      MarkdownImage** images, int* imageCount,
+                      BOOL* imagesHeapAllocated);
+void RenderPluginTextTemplate(const wchar_t* timerText, wchar_t* out, size_t outCount,
+                              MarkdownImage* images, int imageCount);
 void CopyCachedWideText(wchar_t* dest, size_t destCount,
                                size_t* storedLen, const wchar_t* src);
 BOOL CachedWideTextEquals(const wchar_t* cached, size_t cachedCount,
                                  size_t storedLen, const wchar_t* text);
 BOOL BuildStableDigitMeasureText(const wchar_t* source, wchar_t* dest, size_t destCount);
 void StabilizeScaleGestureText(HWND hwnd, wchar_t* text, size_t textCount);
-BOOL CanUseMeasureCacheForFontTags(const MarkdownFontTag* fontTags, int fontTagCount);
-BOOL RefreshMeasureCacheFontTags(const MarkdownFontTag* fontTags, int fontTagCount);
 void EnsureMarkdownRenderCache(const wchar_t* text);
 BOOL ExpandFontPathEnvironmentUtf8(const char* fontFileName, char* outPath, size_t outPathSize);
 BOOL ResolveFontPathFromName(const char* fontFileName, char* outPath);
@@ -100,12 +104,13 @@ BOOL CompositeScaleFrameSnapshot(HWND hwnd,
                                         int destHeight);
 void ReleaseRenderDibCache(void);
 BOOL ShouldReuseRenderDibCache(int width, int height, size_t requiredPixels);
-BOOL SetupDoubleBufferDIB(HDC hdc, const RECT* rect, HDC* memDC, HBITMAP* memBitmap, HBITMAP* oldBitmap, void** ppvBits);
+BOOL SetupDoubleBufferDIB(HDC hdc, const RECT* rect, HDC* memDC, HBITMAP* memBitmap, void** ppvBits);
 void FixAlphaChannel(void* bits, int width, int height);
 void AdjustWindowSize(HWND hwnd, const SIZE* textSize, RECT* rect);
 void HandleWindowPaint(HWND hwnd, const PAINTSTRUCT* ps);
 BOOL PrepareDrawingPaintFrame(PaintFrameContext* frame, HWND hwnd, const PAINTSTRUCT* ps);
 BOOL RenderDrawingPaintFrame(PaintFrameContext* frame);
 void PresentDrawingPaintFrame(PaintFrameContext* frame);
+void ReleaseRenderPresentCache(void);
 
 #endif /* DRAWING_RENDER_INTERNAL_H */
@@ -0,0 +1,156 @@
+/**
+ * @file drawing_render_metrics.c
+ * @brief Frame accumulation, interval histograms and the periodic log summary.
+ *
+ * Frames begin and end on the UI thread, so the histograms are only written
+ * and read there; other threads fail the owner check before touching state.
+ */
+
+#include "drawing/drawing_render_metrics.h"
+#include "drawing_render_metrics_internal.h"
+#include "drawing/drawing_dib_pool.h"
+
+#include "config.h"
+#include "log.h"
+
+typedef struct {
+    BOOL active;
+    DWORD threadId;
+    LONGLONG frameBegin;
+    LONGLONG stageTicks[RENDER_STAGE_COUNT];
+    BOOL stageTouched[RENDER_STAGE_COUNT];
+    DWORD counters[RENDER_COUNTER_COUNT];
+} RenderFrameSample;
+
+static const char* const kStageNames[RENDER_STAGE_COUNT] = {
+    "frame", "prepare", "md-parse", "measure", "render",
+    "glyph", "effect", "image", "present"
+};
+
+static RenderFrameSample g_frame;
+static RenderMetricsInterval g_interval;
+static LARGE_INTEGER g_frequency;
+static volatile LONG g_overlayEnabled = 0;
+
+const char* RenderMetrics_StageName(RenderMetricStage stage) {
+    return stage >= 0 && stage < RENDER_STAGE_COUNT ? kStageNames[stage] : "?";
+}
+
+const RenderMetricsInterval* RenderMetrics_GetInterval(void) {
+    return &g_interval;
+}
+
+static LONGLONG Now(void) {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart != 0 ? now.QuadPart : 1;
+}
+
+static DWORD TicksToMicroseconds(LONGLONG ticks) {
+    if (ticks <= 0 || g_frequency.QuadPart <= 0) return 0;
+    ULONGLONG us = (ULONGLONG)ticks * 1000000ULL / (ULONGLONG)g_frequency.QuadPart;
+    return us > MAXDWORD ? MAXDWORD : (DWORD)us;
+}
+
+static BOOL IsFrameThread(void) {
+    return g_frame.active && g_frame.threadId == GetCurrentThreadId();
+}
+
+static void ResetInterval(DWORD now) {
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        HdrHistogram_Reset(&g_interval.stages[i]);
+    }
+    ZeroMemory(g_interval.counters, sizeof(g_interval.counters));
+    g_interval.startTick = now;
+}
+
+void RenderMetrics_BeginFrame(void) {
+    if (g_frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&g_frequency);
+        ResetInterval(GetTickCount());
+    }
+    ZeroMemory(&g_frame, sizeof(g_frame));
+    g_frame.threadId = GetCurrentThreadId();
+    g_frame.frameBegin = Now();
+    g_frame.active = TRUE;
+}
+
+LONGLONG RenderMetrics_StageBegin(void) {
+    return IsFrameThread() ? Now() : 0;
+}
+
+void RenderMetrics_StageEnd(RenderMetricStage stage, LONGLONG begin) {
+    if (begin == 0 || stage < 0 || stage >= RENDER_STAGE_COUNT || !IsFrameThread()) {
+        return;
+    }
+    g_frame.stageTicks[stage] += Now() - begin;
+    g_frame.stageTouched[stage] = TRUE;
+}
+
+void RenderMetrics_Count(RenderMetricCounter counter) {
+    if (counter < 0 || counter >= RENDER_COUNTER_COUNT || !IsFrameThread()) return;
+    g_frame.counters[counter]++;
+}
+
+static void LogIntervalSummary(DWORD elapsedMs) {
+    const HdrHistogram* frames = &g_interval.stages[RENDER_STAGE_FRAME];
+    ULONGLONG hits = g_interval.counters[RENDER_COUNTER_GLYPH_CACHE_HIT];
+    ULONGLONG misses = g_interval.counters[RENDER_COUNTER_GLYPH_CACHE_MISS];
+    LOG_INFO("Render metrics: %llu frame(s) in %lu ms, glyph cache %llu hit / %llu miss, "
+             "%llu DIB realloc(s), %llu unchanged present(s) skipped",
+             frames->totalCount, elapsedMs, hits, misses,
+             g_interval.counters[RENDER_COUNTER_DIB_REALLOC],
+             g_interval.counters[RENDER_COUNTER_PRESENT_SKIPPED]);
+    DibPoolStats pool;
+    DibPool_GetStats(&pool);
+    LOG_INFO("DIB pool: %zu leased (%zu KB), %zu idle (%zu KB), "
+             "%llu created / %llu reused / %llu destroyed, %lu GDI object(s)",
+             pool.leasedSurfaces, pool.leasedBytes / 1024u,
+             pool.idleSurfaces, pool.idleBytes / 1024u,
+             pool.created, pool.reused, pool.destroyed, pool.gdiObjects);
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        const HdrHistogram* h = &g_interval.stages[i];
+        if (h->totalCount == 0) continue;
+        LOG_INFO("  %-8s n=%llu mean=%luus p50=%luus p90=%luus p99=%luus max=%luus",
+                 kStageNames[i], h->totalCount, HdrHistogram_Mean(h),
+                 HdrHistogram_ValueAtPercentile(h, 50.0),
+                 HdrHistogram_ValueAtPercentile(h, 90.0),
+                 HdrHistogram_ValueAtPercentile(h, 99.0), h->max);
+    }
+}
+
+void RenderMetrics_EndFrame(void) {
+    if (!IsFrameThread()) return;
+    g_frame.stageTicks[RENDER_STAGE_FRAME] = Now() - g_frame.frameBegin;
+    g_frame.stageTouched[RENDER_STAGE_FRAME] = TRUE;
+    g_frame.active = FALSE;
+
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        if (g_frame.stageTouched[i]) {
+            HdrHistogram_Record(&g_interval.stages[i],
+                                TicksToMicroseconds(g_frame.stageTicks[i]));
+        }
+    }
+    for (int i = 0; i < RENDER_COUNTER_COUNT; i++) {
+        g_interval.counters[i] += g_frame.counters[i];
+    }
+
+    DWORD now = GetTickCount();
+    DWORD elapsed = now - g_interval.startTick;
+    if (elapsed >= RENDER_METRICS_SUMMARY_INTERVAL_MS) {
+        LogIntervalSummary(elapsed);
+        ResetInterval(now);
+    }
+}
+
+void RenderMetrics_LoadConfig(void) {
+    char configPath[MAX_PATH] = {0};
+    GetConfigPath(configPath, MAX_PATH);
+    BOOL enabled = ReadIniBool(INI_SECTION_OPTIONS, RENDER_METRICS_OVERLAY_KEY,
+                               FALSE, configPath);
+    InterlockedExchange(&g_overlayEnabled, enabled ? 1 : 0);
+}
+
+BOOL RenderMetrics_IsOverlayEnabled(void) {
+    return g_overlayEnabled != 0;
+}
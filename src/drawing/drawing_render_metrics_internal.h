@@ -0,0 +1,23 @@
+/**
+ * @file drawing_render_metrics_internal.h
+ * @brief Interval statistics shared by the metrics log and overlay.
+ */
+
+#ifndef DRAWING_RENDER_METRICS_INTERNAL_H
+#define DRAWING_RENDER_METRICS_INTERNAL_H
+
+#include "drawing/drawing_render_metrics.h"
+#include "utils/hdr_histogram.h"
+
+typedef struct {
+    HdrHistogram stages[RENDER_STAGE_COUNT];  /**< Microseconds per frame */
+    ULONGLONG counters[RENDER_COUNTER_COUNT];
+    DWORD startTick;
+} RenderMetricsInterval;
+
+const char* RenderMetrics_StageName(RenderMetricStage stage);
+
+/** @note UI thread only */
+const RenderMetricsInterval* RenderMetrics_GetInterval(void);
+
+#endif /* DRAWING_RENDER_METRICS_INTERNAL_H */
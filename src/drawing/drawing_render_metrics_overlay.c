@@ -0,0 +1,107 @@
+/**
+ * @file drawing_render_metrics_overlay.c
+ * @brief Debug overlay with the current interval's stage percentiles.
+ *
+ * GDI text clears the alpha byte of every pixel it touches, so the box is
+ * filled with opaque black first and touched pixels are made opaque again
+ * after drawing; the result stays valid premultiplied alpha.
+ */
+
+#include "drawing_render_metrics_internal.h"
+
+#include <stdio.h>
+
+#define RENDER_METRICS_OVERLAY_MAX_LINES (RENDER_STAGE_COUNT + 2)
+#define RENDER_METRICS_OVERLAY_LINE_CHARS 80
+#define RENDER_METRICS_OVERLAY_PADDING 4
+#define RENDER_METRICS_OVERLAY_BACKGROUND 0xFF000000u
+
+static int FormatOverlayLines(wchar_t lines[][RENDER_METRICS_OVERLAY_LINE_CHARS]) {
+    const RenderMetricsInterval* interval = RenderMetrics_GetInterval();
+    int count = 0;
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        const HdrHistogram* h = &interval->stages[i];
+        if (h->totalCount == 0) continue;
+        _snwprintf_s(lines[count++], RENDER_METRICS_OVERLAY_LINE_CHARS, _TRUNCATE,
+                     L"%-8hs p50 %6.2f  p99 %6.2f  max %6.2f ms",
+                     RenderMetrics_StageName((RenderMetricStage)i),
+                     HdrHistogram_ValueAtPercentile(h, 50.0) / 1000.0,
+                     HdrHistogram_ValueAtPercentile(h, 99.0) / 1000.0,
+                     h->max / 1000.0);
+    }
+
+    ULONGLONG hits = interval->counters[RENDER_COUNTER_GLYPH_CACHE_HIT];
+    ULONGLONG lookups = hits + interval->counters[RENDER_COUNTER_GLYPH_CACHE_MISS];
+    _snwprintf_s(lines[count++], RENDER_METRICS_OVERLAY_LINE_CHARS, _TRUNCATE,
+                 L"frames %llu  glyph hit %.1f%%  DIB realloc %llu",
+                 interval->stages[RENDER_STAGE_FRAME].totalCount,
+                 lookups > 0 ? (double)hits * 100.0 / (double)lookups : 100.0,
+                 interval->counters[RENDER_COUNTER_DIB_REALLOC]);
+    return count;
+}
+
+static void FillBox(DWORD* pixels, int width, const RECT* box, DWORD color) {
+    for (int y = box->top; y < box->bottom; y++) {
+        DWORD* row = pixels + (size_t)y * (size_t)width;
+        for (int x = box->left; x < box->right; x++) {
+            row[x] = color;
+        }
+    }
+}
+
+static void RestoreTextAlpha(DWORD* pixels, int width, const RECT* box) {
+    for (int y = box->top; y < box->bottom; y++) {
+        DWORD* row = pixels + (size_t)y * (size_t)width;
+        for (int x = box->left; x < box->right; x++) {
+            row[x] |= 0xFF000000u;
+        }
+    }
+}
+
+void RenderMetrics_DrawOverlay(HDC memDC, DWORD* pixels, int width, int height) {
+    if (!memDC || !pixels || width <= 0 || height <= 0) return;
+
+    wchar_t lines[RENDER_METRICS_OVERLAY_MAX_LINES][RENDER_METRICS_OVERLAY_LINE_CHARS];
+    int lineCount = FormatOverlayLines(lines);
+
+    HGDIOBJ oldFont = SelectObject(memDC, GetStockObject(DEFAULT_GUI_FONT));
+    TEXTMETRICW metrics;
+    int lineHeight = GetTextMetricsW(memDC, &metrics) ? metrics.tmHeight : 13;
+    int boxWidth = 0;
+    for (int i = 0; i < lineCount; i++) {
+        SIZE extent;
+        if (GetTextExtentPoint32W(memDC, lines[i], (int)wcslen(lines[i]), &extent) &&
+            extent.cx > boxWidth) {
+            boxWidth = extent.cx;
+        }
+    }
+
+    RECT box = {0, 0,
+                boxWidth + 2 * RENDER_METRICS_OVERLAY_PADDING,
+                lineCount * lineHeight + 2 * RENDER_METRICS_OVERLAY_PADDING};
+    if (box.right > width) box.right = width;
+    if (box.bottom > height) box.bottom = height;
+
+    GdiFlush();
+    FillBox(pixels, width, &box, RENDER_METRICS_OVERLAY_BACKGROUND);
+
+    int oldMode = SetBkMode(memDC, TRANSPARENT);
+    COLORREF oldColor = SetTextColor(memDC, RGB(255, 255, 255));
+    HRGN clip = CreateRectRgnIndirect(&box);
+    if (clip) SelectClipRgn(memDC, clip);
+    for (int i = 0; i < lineCount; i++) {
+        TextOutW(memDC, RENDER_METRICS_OVERLAY_PADDING,
+                 RENDER_METRICS_OVERLAY_PADDING + i * lineHeight,
+                 lines[i], (int)wcslen(lines[i]));
+    }
+    if (clip) {
+        SelectClipRgn(memDC, NULL);
+        DeleteObject(clip);
+    }
+    SetTextColor(memDC, oldColor);
+    SetBkMode(memDC, oldMode);
+    SelectObject(memDC, oldFont);
+
+    GdiFlush();
+    RestoreTextAlpha(pixels, width, &box);
+}
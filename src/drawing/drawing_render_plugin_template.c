@@ -0,0 +1,181 @@
+/**
+ * @file drawing_render_plugin_template.c
+ * @brief Compile plugin text once and splice the timer into it per frame.
+ *
+ * Plugin text only changes when the plugin writes new output, while
+ * <catime></catime> placeholders change every tick. Scanning markers and
+ * extracting images happens on compile; a frame only copies the static
+ * spans and the current timer string. When the compiled images cannot be
+ * kept, the template is dropped and the timer is spliced while parsing.
+ */
+
+#include "drawing_render_internal.h"
+#include "drawing/drawing_plugin_template.h"
+
+#include <stdlib.h>
+
+/*
+ * Strip ![](path) images into the image list. Without timerText every
+ * <catime></catime> slot is recorded in the plugin paint cache; with it,
+ * the timer is written in place of each placeholder.
+ */
+static size_t ParsePluginText(const wchar_t* pluginText, const wchar_t* timerText,
+                              wchar_t* out, size_t outCount, MarkdownImage* stackImages,
+                              MarkdownImage** imagesOut, int* imageCountOut,
+                              BOOL* imagesHeapAllocated) {
+    PluginPaintCache* cache = &g_pluginPaintCache;
+    size_t timerLen = timerText ? wcslen(timerText) : 0;
+
+    ZeroMemory(stackImages, PLUGIN_IMAGE_STACK_CAPACITY * sizeof(*stackImages));
+    MarkdownImage* images = stackImages;
+    int imageCapacity = PLUGIN_IMAGE_STACK_CAPACITY;
+    int imageCount = 0;
+    BOOL imageCapacityExhausted = FALSE;
+
+    const wchar_t* src = pluginText;
+    wchar_t* dst = out;
+    size_t remaining = outCount - 1;
+    while (*src && remaining > 0) {
+        PluginTextMarkerKind markerKind = PLUGIN_TEXT_MARKER_NONE;
+        const wchar_t* marker = FindNextPluginTextMarker(src, !imageCapacityExhausted, &markerKind);
+
+        if (!marker) {
+            AppendWideSpan(&dst, &remaining, src, wcslen(src));
+            break;
+        }
+
+        if (marker > src) {
+            AppendWideSpan(&dst, &remaining, src, (size_t)(marker - src));
+            src = marker;
+            if (remaining == 0) {
+                break;
+            }
+        }
+
+        if (markerKind == PLUGIN_TEXT_MARKER_IMAGE && images && !imageCapacityExhausted) {
+            if (imageCount >= imageCapacity &&
+                !EnsurePaintMarkdownImageCapacity(&images, &imageCapacity,
+                                                  imagesHeapAllocated, stackImages)) {
+                imageCapacityExhausted = TRUE;
+            }
+
+            if (!imageCapacityExhausted) {
+                const wchar_t* imgSrc = src;
+                if (ExtractMarkdownImage(&imgSrc, images, &imageCount, imageCapacity,
+                                         (int)(dst - out))) {
+                    src = imgSrc;
+                    continue;
+                }
+            }
+        }
+
+        if (markerKind == PLUGIN_TEXT_MARKER_CATIME &&
+            (timerText || cache->slotCount < PLUGIN_TEXT_TEMPLATE_MAX_SLOTS)) {
+            const wchar_t* tagEnd = wcsstr(src + CATIME_OPEN_TAG_LEN, CATIME_CLOSE_TAG);
+            if (tagEnd) {
+                if (timerText) {
+                    AppendWideSpan(&dst, &remaining, timerText, timerLen);
+                } else {
+                    cache->slotOffsets[cache->slotCount] = (int)(dst - out);
+                    cache->slotImagesBefore[cache->slotCount] = imageCount;
+                    cache->slotCount++;
+                }
+                src = tagEnd + CATIME_CLOSE_TAG_LEN;
+                continue;
+            }
+        }
+
+        *dst++ = *src++;
+        remaining--;
+    }
+    *dst = L'\0';
+
+    *imagesOut = images;
+    *imageCountOut = imageCount;
+    return (size_t)(dst - out);
+}
+
+BOOL CompilePluginTextTemplate(const wchar_t* pluginText, MarkdownImage* stackImages,
+                               MarkdownImage** imagesOut, int* imageCountOut,
+                               BOOL* imagesHeapAllocated, BOOL* imagesOwnedByCache) {
+    ClearPluginPaintCache();
+    PluginPaintCache* cache = &g_pluginPaintCache;
+
+    MarkdownImage* images = NULL;
+    int imageCount = 0;
+    cache->templateTextLen = ParsePluginText(pluginText, NULL, cache->templateText,
+                                             _countof(cache->templateText), stackImages,
+                                             &images, &imageCount, imagesHeapAllocated);
+    CopyCachedWideText(cache->sourceText, _countof(cache->sourceText),
+                       &cache->sourceTextLen, pluginText);
+    *imagesOut = images;
+    *imageCountOut = imageCount;
+
+    if (imageCount == 0) {
+        cache->valid = TRUE;
+        return TRUE;
+    }
+
+    MarkdownImage* cachedImages =
+        MovePaintMarkdownImagesToHeap(images, imageCount,
+                                      imagesHeapAllocated, stackImages);
+    if (!cachedImages) {
+        /* Images stay with the frame; offsets are only right without slots */
+        if (cache->slotCount == 0) return TRUE;
+        FreePaintMarkdownImages(images, imageCount, *imagesHeapAllocated);
+        *imagesHeapAllocated = FALSE;
+        ClearPluginPaintCache();
+        *imagesOut = NULL;
+        *imageCountOut = 0;
+        return FALSE;
+    }
+
+    cache->images = cachedImages;
+    cache->imageCount = imageCount;
+    *imagesOut = cachedImages;
+    *imagesOwnedByCache = TRUE;
+    if (cache->slotCount > 0) {
+        cache->imageTemplatePositions = (int*)malloc((size_t)imageCount * sizeof(int));
+        if (!cache->imageTemplatePositions) {
+            ClearPluginPaintCache();
+            *imagesOwnedByCache = FALSE;
+            *imagesOut = NULL;
+            *imageCountOut = 0;
+            return FALSE;
+        }
+        for (int i = 0; i < imageCount; i++) {
+            cache->imageTemplatePositions[i] = cachedImages[i].startPos;
+        }
+    }
+    cache->valid = TRUE;
+    return TRUE;
+}
+
+void SplicePluginText(const wchar_t* pluginText, const wchar_t* timerText,
+                      wchar_t* out, size_t outCount, MarkdownImage* stackImages,
+                      MarkdownImage** imagesOut, int* imageCountOut,
+                      BOOL* imagesHeapAllocated) {
+    if (!out || outCount == 0) return;
+    ParsePluginText(pluginText, timerText ? timerText : L"", out, outCount, stackImages,
+                    imagesOut, imageCountOut, imagesHeapAllocated);
+}
+
+void RenderPluginTextTemplate(const wchar_t* timerText, wchar_t* out, size_t outCount,
+                              MarkdownImage* images, int imageCount) {
+    if (!out || outCount == 0) return;
+    const PluginPaintCache* cache = &g_pluginPaintCache;
+    size_t outLen = PluginTemplate_Splice(cache->templateText, cache->templateTextLen,
+                                          cache->slotOffsets, cache->slotCount,
+                                          timerText, out, outCount);
+
+    /* Images after a slot shift by the timer length placed before them. */
+    if (!cache->imageTemplatePositions || images != cache->images) return;
+    size_t timerLen = timerText ? wcslen(timerText) : 0;
+    for (int i = 0; i < imageCount && i < cache->imageCount; i++) {
+        int position = PluginTemplate_ImagePosition(cache->imageTemplatePositions[i], i,
+                                                    cache->slotImagesBefore,
+                                                    cache->slotCount, timerLen, outLen);
+        images[i].startPos = position;
+        images[i].endPos = position;
+    }
+}
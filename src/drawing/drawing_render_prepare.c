@@ -16,7 +16,6 @@ BOOL PrepareDrawingPaintFrame(PaintFrameContext* frame, HWND hwnd,
     PaintTextBuffers* paintBuffers = frame->paintBuffers;
     wchar_t* timeText = paintBuffers->timeText;
     wchar_t* pluginText = paintBuffers->pluginText;
-    wchar_t* result = paintBuffers->pluginResult;
     HDC hdc = frame->hdc;
     RECT rect = {0};
     GetClientRect(hwnd, &rect);
@@ -37,119 +36,28 @@ BOOL PrepareDrawingPaintFrame(PaintFrameContext* frame, HWND hwnd,
     MarkdownImage* stackImages = frame->stackImages;
     MarkdownImage* images = NULL;
     int imageCount = 0;
-    int imageCapacity;
     BOOL imagesHeapAllocated = FALSE;
-    BOOL imageCapacityExhausted = FALSE;
     BOOL imagesOwnedByCache = FALSE;
 
     if (PluginData_GetText(pluginText, TIME_TEXT_MAX_LEN)) {
-        BOOL canUsePluginPaintCache = (wcsstr(pluginText, CATIME_OPEN_TAG) == NULL);
-
-        if (canUsePluginPaintCache && g_pluginPaintCache.valid &&
+        if (g_pluginPaintCache.valid &&
             CachedWideTextEquals(g_pluginPaintCache.sourceText,
                                  _countof(g_pluginPaintCache.sourceText),
                                  g_pluginPaintCache.sourceTextLen,
                                  pluginText)) {
-            wcscpy_s(timeText, TIME_TEXT_MAX_LEN, g_pluginPaintCache.renderedText);
             images = g_pluginPaintCache.images;
             imageCount = g_pluginPaintCache.imageCount;
             imagesOwnedByCache = TRUE;
+            RenderPluginTextTemplate(paintBuffers->timerTextSnapshot, timeText,
+                                     TIME_TEXT_MAX_LEN, images, imageCount);
+        } else if (CompilePluginTextTemplate(pluginText, stackImages, &images, &imageCount,
+                                             &imagesHeapAllocated, &imagesOwnedByCache)) {
+            RenderPluginTextTemplate(paintBuffers->timerTextSnapshot, timeText,
+                                     TIME_TEXT_MAX_LEN, images, imageCount);
         } else {
-        wchar_t savedTime[256];
-        wcsncpy(savedTime, timeText, _countof(savedTime) - 1);
-        savedTime[_countof(savedTime) - 1] = L'\0';
-        size_t savedTimeLen = wcslen(savedTime);
-
-        ZeroMemory(stackImages, sizeof(frame->stackImages));
-        images = stackImages;
-        imageCapacity = PLUGIN_IMAGE_STACK_CAPACITY;
-
-        // Replace ALL <catime></catime> tags and extract ![](path) images in one pass.
-        result[0] = L'\0';
-        const wchar_t* src = pluginText;
-        wchar_t* dst = result;
-        size_t remaining = TIME_TEXT_MAX_LEN - 1;
-        while (*src && remaining > 0) {
-            PluginTextMarkerKind markerKind = PLUGIN_TEXT_MARKER_NONE;
-            const wchar_t* marker = FindNextPluginTextMarker(src, !imageCapacityExhausted, &markerKind);
-
-            if (!marker) {
-                AppendWideSpan(&dst, &remaining, src, wcslen(src));
-                break;
-            }
-
-            if (marker > src) {
-                AppendWideSpan(&dst, &remaining, src, (size_t)(marker - src));
-                src = marker;
-                if (remaining == 0) {
-                    break;
-                }
-            }
-
-            if (markerKind == PLUGIN_TEXT_MARKER_IMAGE && images && !imageCapacityExhausted) {
-                if (imageCount >= imageCapacity &&
-                    !EnsurePaintMarkdownImageCapacity(&images, &imageCapacity,
-                                                      &imagesHeapAllocated, stackImages)) {
-                    imageCapacityExhausted = TRUE;
-                }
-
-                if (!imageCapacityExhausted) {
-                    const wchar_t* imgSrc = src;
-                    if (ExtractMarkdownImage(&imgSrc, images, &imageCount, imageCapacity,
-                                             (int)(dst - result))) {
-                        src = imgSrc;
-                        continue;
-                    }
-                }
-            }
-
-            if (markerKind == PLUGIN_TEXT_MARKER_CATIME) {
-                const wchar_t* tagEnd = wcsstr(src + CATIME_OPEN_TAG_LEN, CATIME_CLOSE_TAG);
-                if (tagEnd) {
-                    AppendWideSpan(&dst, &remaining, savedTime, savedTimeLen);
-                    src = tagEnd + CATIME_CLOSE_TAG_LEN;
-                    continue;
-                }
-            }
-
-            *dst++ = *src++;
-            remaining--;
-        }
-        *dst = L'\0';
-
-        wcscpy_s(timeText, TIME_TEXT_MAX_LEN, result);
-
-        if (canUsePluginPaintCache) {
-            ClearPluginPaintCache();
-
-            CopyCachedWideText(g_pluginPaintCache.sourceText,
-                               _countof(g_pluginPaintCache.sourceText),
-                               &g_pluginPaintCache.sourceTextLen,
-                               pluginText);
-            wcscpy_s(g_pluginPaintCache.renderedText, TIME_TEXT_MAX_LEN, result);
-
-            if (imageCount > 0) {
-                g_pluginPaintCache.images =
-                    MovePaintMarkdownImagesToHeap(images, imageCount,
-                                                  &imagesHeapAllocated,
-                                                  stackImages);
-
-                if (g_pluginPaintCache.images) {
-                    g_pluginPaintCache.imageCount = imageCount;
-                    g_pluginPaintCache.valid = TRUE;
-                    images = g_pluginPaintCache.images;
-                    imagesOwnedByCache = TRUE;
-                }
-            } else {
-                g_pluginPaintCache.valid = TRUE;
-            }
-        } else if (g_pluginPaintCache.valid &&
-                   !CachedWideTextEquals(g_pluginPaintCache.sourceText,
-                                         _countof(g_pluginPaintCache.sourceText),
-                                         g_pluginPaintCache.sourceTextLen,
-                                         pluginText)) {
-            ClearPluginPaintCache();
-        }
+            SplicePluginText(pluginText, paintBuffers->timerTextSnapshot, timeText,
+                             TIME_TEXT_MAX_LEN, stackImages, &images, &imageCount,
+                             &imagesHeapAllocated);
         }
     } else {
         ClearPluginPaintCache();
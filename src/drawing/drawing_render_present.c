@@ -1,10 +1,94 @@
 /**
  * @file drawing_render_present.c
  * @brief Present a rendered DIB through the layered main window.
+ *
+ * Only the tiles that changed since the last present are handed to
+ * UpdateLayeredWindowIndirect, and byte-identical frames are not presented
+ * at all, so a large translucent window no longer re-uploads its whole
+ * surface every tick.
  */
 
 #include "drawing_render_internal.h"
 
+/* The screen DC only serves palette matching, so one is kept for the session */
+static HDC AcquirePresentScreenDC(void) {
+    if (!g_renderPresentCache.screenDC) {
+        g_renderPresentCache.screenDC = GetDC(NULL);
+    }
+    return g_renderPresentCache.screenDC;
+}
+
+/** @param dirty Changed area, or the whole surface after a reset */
+static BOOL UpdateLayeredSurface(HWND hwnd, HDC hdcScreen, HDC memDC,
+                                 const SIZE* size, const BLENDFUNCTION* blend,
+                                 const RECT* dirty) {
+    POINT ptSrc = {0, 0};
+    UPDATELAYEREDWINDOWINFO info = {0};
+    info.cbSize = sizeof(info);
+    info.hdcDst = hdcScreen;
+    info.pptDst = NULL;  /* Keep the window where it is */
+    info.psize = size;
+    info.hdcSrc = memDC;
+    info.pptSrc = &ptSrc;
+    info.pblend = blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = dirty;
+    return UpdateLayeredWindowIndirect(hwnd, &info);
+}
+
+static BOOL PresentLayeredFrame(HWND hwnd, HDC hdcScreen, HDC memDC,
+                                int width, int height, BYTE alpha,
+                                const RECT* dirty) {
+    SIZE sizeWnd = {width, height};
+    BLENDFUNCTION blend = {0};
+    blend.BlendOp = AC_SRC_OVER;
+    blend.BlendFlags = 0;
+    blend.SourceConstantAlpha = alpha;
+    blend.AlphaFormat = AC_SRC_ALPHA;
+
+    if (UpdateLayeredSurface(hwnd, hdcScreen, memDC, &sizeWnd, &blend, dirty)) {
+        return TRUE;
+    }
+
+    DWORD err = GetLastError();
+    if (err != ERROR_INVALID_PARAMETER) {
+        if (ShouldLogMainWindowRenderFailure()) {
+            WriteLog(LOG_LEVEL_ERROR,
+                     "UpdateLayeredWindow failed! Error code: %lu", err);
+        }
+        return FALSE;
+    }
+
+    // Error 87 often implies conflict between SetLayeredWindowAttributes and UpdateLayeredWindow
+    // Reset WS_EX_LAYERED style to clear the internal state
+    LONG exStyle = GetWindowLong(hwnd, GWL_EXSTYLE);
+    SetWindowLong(hwnd, GWL_EXSTYLE, exStyle & ~WS_EX_LAYERED);
+    SetWindowLong(hwnd, GWL_EXSTYLE, exStyle | WS_EX_LAYERED);
+
+    // Retry update; the reset dropped the surface, so upload all of it
+    if (!UpdateLayeredSurface(hwnd, hdcScreen, memDC, &sizeWnd, &blend, NULL)) {
+        err = GetLastError();
+        if (ShouldLogMainWindowRenderFailure()) {
+            WriteLog(LOG_LEVEL_ERROR,
+                     "UpdateLayeredWindow failed retry! Error code: %lu", err);
+        }
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void InvalidateDrawingRenderPresentCache(void) {
+    PresentDamage_Invalidate(&g_renderPresentCache.damage);
+}
+
+void ReleaseRenderPresentCache(void) {
+    if (g_renderPresentCache.screenDC) {
+        ReleaseDC(NULL, g_renderPresentCache.screenDC);
+    }
+    PresentDamage_Release(&g_renderPresentCache.damage);
+    ZeroMemory(&g_renderPresentCache, sizeof(g_renderPresentCache));
+}
+
 void PresentDrawingPaintFrame(PaintFrameContext* frame) {
     if (!frame) return;
 
@@ -19,7 +103,6 @@ void PresentDrawingPaintFrame(PaintFrameContext* frame) {
     int colorTagCount = frame->colorTagCount;
     HDC memDC = frame->memDC;
     HBITMAP memBitmap = frame->memBitmap;
-    HBITMAP oldBitmap = frame->oldBitmap;
     BOOL usedScaleComposite = frame->usedScaleComposite;
     BOOL hasContent = frame->hasContent;
 
@@ -39,67 +122,44 @@ void PresentDrawingPaintFrame(PaintFrameContext* frame) {
         FreePaintMarkdownImages(images, imageCount, imagesHeapAllocated);
     }
 
-    HDC hdcScreen = GetDC(NULL);
-    if (!hdcScreen) {
-        ReleaseRenderDibCache();
-        StopDrawingRenderAnimationTimer(hwnd);
-        RecordMainWindowRenderFailure(hwnd);
-        return;
-    }
-    POINT ptSrc = {0, 0};
-    SIZE sizeWnd = {rect.right, rect.bottom};
-    POINT ptDst = {0, 0};
-
-    RECT rcWindow;
-    GetWindowRect(hwnd, &rcWindow);
-    ptDst.x = rcWindow.left;
-    ptDst.y = rcWindow.top;
-
     BYTE alpha = (BYTE)((CLOCK_WINDOW_OPACITY * 255) / 100);
+    RenderPresentCache* cache = &g_renderPresentCache;
+    if (cache->hwnd != hwnd || cache->width != rect.right ||
+        cache->height != rect.bottom || cache->alpha != alpha) {
+        PresentDamage_Invalidate(&cache->damage);
+    }
 
-    BLENDFUNCTION blend = {0};
-    blend.BlendOp = AC_SRC_OVER;
-    blend.BlendFlags = 0;
-    blend.SourceConstantAlpha = alpha;
-    blend.AlphaFormat = AC_SRC_ALPHA;
-
+    RECT dirty;
     BOOL layeredUpdateSucceeded = TRUE;
-    if (!UpdateLayeredWindow(hwnd, hdcScreen, &ptDst, &sizeWnd, memDC, &ptSrc, 0, &blend, ULW_ALPHA)) {
-        DWORD err = GetLastError();
-        layeredUpdateSucceeded = FALSE;
-        if (err == ERROR_INVALID_PARAMETER) {
-            // Error 87 often implies conflict between SetLayeredWindowAttributes and UpdateLayeredWindow
-            // Reset WS_EX_LAYERED style to clear the internal state
-            LONG exStyle = GetWindowLong(hwnd, GWL_EXSTYLE);
-            SetWindowLong(hwnd, GWL_EXSTYLE, exStyle & ~WS_EX_LAYERED);
-            SetWindowLong(hwnd, GWL_EXSTYLE, exStyle | WS_EX_LAYERED);
-
-            // Retry update
-            if (!UpdateLayeredWindow(hwnd, hdcScreen, &ptDst, &sizeWnd, memDC, &ptSrc, 0, &blend, ULW_ALPHA)) {
-                err = GetLastError();
-                if (ShouldLogMainWindowRenderFailure()) {
-                    WriteLog(LOG_LEVEL_ERROR,
-                             "UpdateLayeredWindow failed retry! Error code: %lu", err);
-                }
-            } else {
-                layeredUpdateSucceeded = TRUE;
-            }
-        } else {
-            if (ShouldLogMainWindowRenderFailure()) {
-                WriteLog(LOG_LEVEL_ERROR,
-                         "UpdateLayeredWindow failed! Error code: %lu", err);
-            }
+    if (!PresentDamage_Compute(&cache->damage, (const DWORD*)frame->bits,
+                               rect.right, rect.bottom, &dirty)) {
+        /* Byte-identical frame: the window already shows it */
+        RenderMetrics_Count(RENDER_COUNTER_PRESENT_SKIPPED);
+    } else {
+        HDC hdcScreen = AcquirePresentScreenDC();
+        if (!hdcScreen) {
+            ReleaseRenderDibCache();
+            StopDrawingRenderAnimationTimer(hwnd);
+            RecordMainWindowRenderFailure(hwnd);
+            return;
         }
-        if (!layeredUpdateSucceeded) {
+        layeredUpdateSucceeded = PresentLayeredFrame(hwnd, hdcScreen, memDC,
+                                                     rect.right, rect.bottom,
+                                                     alpha, &dirty);
+        if (layeredUpdateSucceeded) {
+            cache->hwnd = hwnd;
+            cache->width = rect.right;
+            cache->height = rect.bottom;
+            cache->alpha = alpha;
+            PresentDamage_Commit(&cache->damage);
+        } else {
+            PresentDamage_Invalidate(&cache->damage);
             StopDrawingRenderAnimationTimer(hwnd);
             RecordMainWindowRenderFailure(hwnd);
         }
     }
 
-    ReleaseDC(NULL, hdcScreen);
-
     UNREFERENCED_PARAMETER(memBitmap);
-    UNREFERENCED_PARAMETER(oldBitmap);
 
     if (layeredUpdateSucceeded) {
         g_renderDibCache.frameValid = TRUE;
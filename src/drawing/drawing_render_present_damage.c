@@ -0,0 +1,145 @@
+/**
+ * @file drawing_render_present_damage.c
+ * @brief Frame damage tracking for partial layered-window presents.
+ *
+ * The renderer clears and redraws the whole DIB every frame, so what it
+ * touched is found by comparing per-tile hashes with the last presented
+ * frame rather than by tracking every draw call.
+ */
+
+#include "drawing_render_present_damage.h"
+
+#include <stdlib.h>
+
+#define PRESENT_DAMAGE_TILE_SIZE (1 << PRESENT_DAMAGE_TILE_SHIFT)
+#define PRESENT_DAMAGE_FNV_OFFSET 14695981039346656037ULL
+#define PRESENT_DAMAGE_FNV_PRIME 1099511628211ULL
+
+static int TileCount(int pixels) {
+    return (pixels + PRESENT_DAMAGE_TILE_SIZE - 1) >> PRESENT_DAMAGE_TILE_SHIFT;
+}
+
+static BOOL EnsureTileCapacity(PresentDamageTracker* tracker, size_t tiles) {
+    if (tracker->capacity >= tiles) return TRUE;
+    ULONGLONG* presented = (ULONGLONG*)malloc(tiles * sizeof(ULONGLONG));
+    ULONGLONG* pending = (ULONGLONG*)malloc(tiles * sizeof(ULONGLONG));
+    if (!presented || !pending) {
+        free(presented);
+        free(pending);
+        return FALSE;
+    }
+    PresentDamage_Release(tracker);
+    tracker->presented = presented;
+    tracker->pending = pending;
+    tracker->capacity = tiles;
+    return TRUE;
+}
+
+/* Rows are folded into their tile's running hash so each pixel is read once */
+static void HashTiles(ULONGLONG* hashes, const DWORD* pixels, int width, int height) {
+    int cols = TileCount(width);
+    for (int y = 0; y < height; y++) {
+        ULONGLONG* rowHashes = hashes + (size_t)(y >> PRESENT_DAMAGE_TILE_SHIFT) * cols;
+        const DWORD* row = pixels + (size_t)y * width;
+        if ((y & (PRESENT_DAMAGE_TILE_SIZE - 1)) == 0) {
+            for (int c = 0; c < cols; c++) rowHashes[c] = PRESENT_DAMAGE_FNV_OFFSET;
+        }
+        for (int c = 0; c < cols; c++) {
+            int x0 = c << PRESENT_DAMAGE_TILE_SHIFT;
+            int x1 = x0 + PRESENT_DAMAGE_TILE_SIZE < width ? x0 + PRESENT_DAMAGE_TILE_SIZE : width;
+            ULONGLONG hash = rowHashes[c];
+            for (int x = x0; x < x1; x++) {
+                hash = (hash ^ row[x]) * PRESENT_DAMAGE_FNV_PRIME;
+            }
+            rowHashes[c] = hash;
+        }
+    }
+}
+
+static void SetFullDirty(RECT* outDirty, int width, int height) {
+    outDirty->left = 0;
+    outDirty->top = 0;
+    outDirty->right = width;
+    outDirty->bottom = height;
+}
+
+BOOL PresentDamage_Compute(PresentDamageTracker* tracker, const DWORD* pixels,
+                           int width, int height, RECT* outDirty) {
+    if (!tracker || !outDirty) return TRUE;
+    SetFullDirty(outDirty, width > 0 ? width : 0, height > 0 ? height : 0);
+    tracker->pendingReady = FALSE;
+    if (!pixels || width <= 0 || height <= 0) {
+        tracker->valid = FALSE;
+        return TRUE;
+    }
+
+    int cols = TileCount(width);
+    int rows = TileCount(height);
+    if (!EnsureTileCapacity(tracker, (size_t)cols * rows)) {
+        tracker->valid = FALSE;
+        return TRUE;
+    }
+    if (tracker->width != width || tracker->height != height) {
+        tracker->valid = FALSE;
+    }
+    HashTiles(tracker->pending, pixels, width, height);
+    tracker->pendingReady = TRUE;
+    tracker->width = width;
+    tracker->height = height;
+    if (!tracker->valid) return TRUE;
+
+    int minCol = cols, minRow = rows, maxCol = -1, maxRow = -1;
+    for (int r = 0; r < rows; r++) {
+        const ULONGLONG* presented = tracker->presented + (size_t)r * cols;
+        const ULONGLONG* pending = tracker->pending + (size_t)r * cols;
+        for (int c = 0; c < cols; c++) {
+            if (presented[c] == pending[c]) continue;
+            if (c < minCol) minCol = c;
+            if (c > maxCol) maxCol = c;
+            if (r < minRow) minRow = r;
+            maxRow = r;
+        }
+    }
+    if (maxRow < 0) {
+        SetRectEmpty(outDirty);
+        return FALSE;
+    }
+
+    outDirty->left = minCol << PRESENT_DAMAGE_TILE_SHIFT;
+    outDirty->top = minRow << PRESENT_DAMAGE_TILE_SHIFT;
+    outDirty->right = (maxCol + 1) << PRESENT_DAMAGE_TILE_SHIFT;
+    outDirty->bottom = (maxRow + 1) << PRESENT_DAMAGE_TILE_SHIFT;
+    if (outDirty->right > width) outDirty->right = width;
+    if (outDirty->bottom > height) outDirty->bottom = height;
+    return TRUE;
+}
+
+void PresentDamage_Commit(PresentDamageTracker* tracker) {
+    if (!tracker) return;
+    if (!tracker->pendingReady) {
+        tracker->valid = FALSE;
+        return;
+    }
+    ULONGLONG* presented = tracker->presented;
+    tracker->presented = tracker->pending;
+    tracker->pending = presented;
+    tracker->pendingReady = FALSE;
+    tracker->valid = TRUE;
+}
+
+void PresentDamage_Invalidate(PresentDamageTracker* tracker) {
+    if (!tracker) return;
+    tracker->valid = FALSE;
+    tracker->pendingReady = FALSE;
+}
+
+void PresentDamage_Release(PresentDamageTracker* tracker) {
+    if (!tracker) return;
+    free(tracker->presented);
+    free(tracker->pending);
+    tracker->presented = NULL;
+    tracker->pending = NULL;
+    tracker->capacity = 0;
+    tracker->valid = FALSE;
+    tracker->pendingReady = FALSE;
+}
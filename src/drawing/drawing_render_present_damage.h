@@ -0,0 +1,41 @@
+/**
+ * @file drawing_render_present_damage.h
+ * @brief Tile hashes that find the part of a frame changed since the last present.
+ */
+
+#ifndef DRAWING_RENDER_PRESENT_DAMAGE_H
+#define DRAWING_RENDER_PRESENT_DAMAGE_H
+
+#include <windows.h>
+
+/** 32x32 pixel tiles: fine enough for a digit, small enough to hash cheaply */
+#define PRESENT_DAMAGE_TILE_SHIFT 5
+
+typedef struct {
+    ULONGLONG* presented;   /**< Tile hashes of the frame the window shows */
+    ULONGLONG* pending;     /**< Tile hashes of the frame being presented */
+    size_t capacity;        /**< Tiles allocated in each array */
+    int width;
+    int height;
+    BOOL valid;             /**< presented describes the window's surface */
+    BOOL pendingReady;      /**< pending was filled by the last compute */
+} PresentDamageTracker;
+
+/**
+ * Hash a top-down 32bpp frame and report the tile-aligned bounding box of
+ * changed pixels, clipped to the frame.
+ * @return TRUE if a present is needed; outDirty is the whole frame when
+ *         nothing trustworthy was presented before
+ */
+BOOL PresentDamage_Compute(PresentDamageTracker* tracker, const DWORD* pixels,
+                           int width, int height, RECT* outDirty);
+
+/** Record the pending hashes as what the window now shows */
+void PresentDamage_Commit(PresentDamageTracker* tracker);
+
+/** Forget the presented frame; the next present covers the whole surface */
+void PresentDamage_Invalidate(PresentDamageTracker* tracker);
+
+void PresentDamage_Release(PresentDamageTracker* tracker);
+
+#endif /* DRAWING_RENDER_PRESENT_DAMAGE_H */
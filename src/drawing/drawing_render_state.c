@@ -16,7 +16,7 @@ PaintTextBuffers g_paintTextBuffers = {0};
 ScaleGestureTextCache g_scaleGestureTextCache = {0};
 MarkdownRenderCache g_markdownRenderCache = {0};
 PluginPaintCache g_pluginPaintCache = {0};
-TextMeasureCache g_textMeasureCache = {0};
 FontPathResolveCache g_fontPathResolveCache = {0};
 RenderDibCache g_renderDibCache = {0};
+RenderPresentCache g_renderPresentCache = {0};
 ScaleFrameSnapshot g_scaleFrameSnapshot = {0};
@@ -97,7 +97,7 @@ BOOL TryCaptureScaleFrameSnapshot(HWND hwnd,
         g_renderDibCache.frameHwnd != hwnd ||
         g_renderDibCache.frameWidth != width ||
         g_renderDibCache.frameHeight != height ||
-        !g_renderDibCache.bits) {
+        !g_renderDibCache.surface.bits) {
         return FALSE;
     }
 
@@ -106,7 +106,7 @@ BOOL TryCaptureScaleFrameSnapshot(HWND hwnd,
     }
 
     memcpy(g_scaleFrameSnapshot.bits,
-           g_renderDibCache.bits,
+           g_renderDibCache.surface.bits,
            pixelCount * sizeof(DWORD));
     g_scaleFrameSnapshot.hwnd = hwnd;
     g_scaleFrameSnapshot.gestureSerial = gestureSerial;
@@ -147,38 +147,36 @@ BOOL CompositeScaleFrameSnapshot(HWND hwnd,
 }
 
 void ReleaseRenderDibCache(void) {
-    if (g_renderDibCache.memDC && g_renderDibCache.oldBitmap) {
-        SelectObject(g_renderDibCache.memDC, g_renderDibCache.oldBitmap);
-    }
-    if (g_renderDibCache.memBitmap) {
-        DeleteObject(g_renderDibCache.memBitmap);
-    }
-    if (g_renderDibCache.memDC) {
-        DeleteDC(g_renderDibCache.memDC);
-    }
+    DibPool_Release(&g_renderDibCache.surface);
     ZeroMemory(&g_renderDibCache, sizeof(g_renderDibCache));
 }
 
 BOOL ShouldReuseRenderDibCache(int width, int height, size_t requiredPixels) {
+    const DibSurface* surface = &g_renderDibCache.surface;
     size_t cachedPixels = 0;
-    if (!g_renderDibCache.memDC || !g_renderDibCache.memBitmap || !g_renderDibCache.bits) {
+    if (!surface->dc || !surface->bits) {
         return FALSE;
     }
-    if (g_renderDibCache.width != width || g_renderDibCache.height < height) {
+    if (surface->width != width || surface->height < height) {
         return FALSE;
     }
-    if (!CalculatePixelCount(g_renderDibCache.width, g_renderDibCache.height, &cachedPixels)) {
+    if (!CalculatePixelCount(surface->width, surface->height, &cachedPixels)) {
         return FALSE;
     }
     if (requiredPixels > 0 &&
-        cachedPixels / RENDER_DIB_SHRINK_THRESHOLD_MULTIPLIER > requiredPixels) {
+        cachedPixels / DIB_POOL_SHRINK_THRESHOLD_MULTIPLIER > requiredPixels) {
         return FALSE;
     }
     return TRUE;
 }
 
-/** @note GM_ADVANCED + HALFTONE improve text quality on high-DPI displays */
-BOOL SetupDoubleBufferDIB(HDC hdc, const RECT* rect, HDC* memDC, HBITMAP* memBitmap, HBITMAP* oldBitmap, void** ppvBits) {
+/**
+ * @note The surface is leased from the DIB pool with an exact width because
+ *       pixel passes use the frame width as the stride.
+ * @note GM_ADVANCED + HALFTONE improve text quality on high-DPI displays
+ */
+BOOL SetupDoubleBufferDIB(HDC hdc, const RECT* rect, HDC* memDC, HBITMAP* memBitmap, void** ppvBits) {
+    UNREFERENCED_PARAMETER(hdc);
     size_t pixelCount;
     if (!rect || !CalculatePixelCount(rect->right, rect->bottom, &pixelCount)) {
         return FALSE;
@@ -188,67 +186,30 @@ BOOL SetupDoubleBufferDIB(HDC hdc, const RECT* rect, HDC* memDC, HBITMAP* memBit
         return FALSE;
     }
 
-    if (ShouldReuseRenderDibCache(rect->right, rect->bottom, pixelCount)) {
-        *memDC = g_renderDibCache.memDC;
-        *memBitmap = g_renderDibCache.memBitmap;
-        *oldBitmap = g_renderDibCache.oldBitmap;
-        *ppvBits = g_renderDibCache.bits;
-        return TRUE;
-    }
-
-    HDC newMemDC = CreateCompatibleDC(hdc);
-    if (!newMemDC) {
-        return FALSE;
-    }
-
-    BITMAPINFO bmi = {0};
-    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = rect->right;
-    // Negative height creates a top-down DIB, matching STB's coordinate system
-    bmi.bmiHeader.biHeight = -rect->bottom;
-    bmi.bmiHeader.biPlanes = 1;
-    bmi.bmiHeader.biBitCount = 32;
-    bmi.bmiHeader.biCompression = BI_RGB;
-
-    void* newBits = NULL;
-    HBITMAP newBitmap = CreateDIBSection(hdc, &bmi, DIB_RGB_COLORS, &newBits, NULL, 0);
-    if (!newBitmap || !newBits) {
-        if (newBitmap) DeleteObject(newBitmap);
-        DeleteDC(newMemDC);
-        return FALSE;
-    }
-
-    HBITMAP newOldBitmap = (HBITMAP)SelectObject(newMemDC, newBitmap);
-    if (!newOldBitmap) {
-        DeleteObject(newBitmap);
-        DeleteDC(newMemDC);
-        return FALSE;
-    }
-
-    SetGraphicsMode(newMemDC, GM_ADVANCED);
-    SetBkMode(newMemDC, TRANSPARENT);
-    SetStretchBltMode(newMemDC, HALFTONE);
-    SetBrushOrgEx(newMemDC, 0, 0, NULL);
-    SetTextAlign(newMemDC, TA_LEFT | TA_TOP);
-    SetTextCharacterExtra(newMemDC, 0);
-    SetMapMode(newMemDC, MM_TEXT);
-    SetICMMode(newMemDC, ICM_ON);
-    SetLayout(newMemDC, 0);
-
-    ReleaseRenderDibCache();
-
-    g_renderDibCache.memDC = newMemDC;
-    g_renderDibCache.memBitmap = newBitmap;
-    g_renderDibCache.oldBitmap = newOldBitmap;
-    g_renderDibCache.bits = newBits;
-    g_renderDibCache.width = rect->right;
-    g_renderDibCache.height = rect->bottom;
-
-    *memDC = g_renderDibCache.memDC;
-    *memBitmap = g_renderDibCache.memBitmap;
-    *oldBitmap = g_renderDibCache.oldBitmap;
-    *ppvBits = g_renderDibCache.bits;
+    if (!ShouldReuseRenderDibCache(rect->right, rect->bottom, pixelCount)) {
+        /* Hand the old surface back first so the pool can recycle it */
+        ReleaseRenderDibCache();
+        RenderMetrics_Count(RENDER_COUNTER_DIB_REALLOC);
+        if (!DibPool_Acquire(rect->right, rect->bottom, DIB_POOL_EXACT_WIDTH,
+                             &g_renderDibCache.surface)) {
+            return FALSE;
+        }
 
+        HDC newMemDC = g_renderDibCache.surface.dc;
+        SetGraphicsMode(newMemDC, GM_ADVANCED);
+        SetBkMode(newMemDC, TRANSPARENT);
+        SetStretchBltMode(newMemDC, HALFTONE);
+        SetBrushOrgEx(newMemDC, 0, 0, NULL);
+        SetTextAlign(newMemDC, TA_LEFT | TA_TOP);
+        SetTextCharacterExtra(newMemDC, 0);
+        SetMapMode(newMemDC, MM_TEXT);
+        SetICMMode(newMemDC, ICM_ON);
+        SetLayout(newMemDC, 0);
+    }
+
+    *memDC = g_renderDibCache.surface.dc;
+    *memBitmap = g_renderDibCache.surface.bitmap;
+    *ppvBits = g_renderDibCache.surface.bits;
     return TRUE;
 }
 
@@ -14,9 +14,9 @@ BOOL CalculatePixelCount(int width, int height, size_t* pixelCount) {
 }
 
 UINT GetRenderAnimationTimerInterval(size_t pixelCount, BOOL hasColorTagGradient) {
+    /* Aqua samples a precomputed texture and reuses per-glyph maps */
     if (GetActiveEffect() == EFFECT_TYPE_AQUA) {
-        (void)pixelCount;
-        return 120u;
+        return (pixelCount < 200000u) ? 33u : 50u;
     }
 
     if (hasColorTagGradient) {
@@ -12,6 +12,9 @@
 #include <windows.h>
 #include <mmsystem.h>
 #include "drawing/drawing_render.h"
+#include "drawing/drawing_render_metrics.h"
+#include "drawing/drawing_dib_pool.h"
+#include "drawing_render_present_damage.h"
 #include "drawing/drawing_time_format.h"
 #include "drawing/drawing_text_stb.h"
 #include "drawing/drawing_markdown_stb.h"
@@ -51,7 +54,6 @@ extern float PLUGIN_FONT_SCALE_FACTOR;
 
 #define MAX_RENDER_DIB_DIMENSION 4096
 #define MAX_RENDER_DIB_PIXELS (4096u * 4096u)
-#define RENDER_DIB_SHRINK_THRESHOLD_MULTIPLIER 4u
 #define SCALE_SNAPSHOT_MIN_PIXELS 500000u
 #define PLUGIN_IMAGE_STACK_CAPACITY 4
 #define CATIME_MAIN_WINDOW_CLASS_NAME L"CatimeWindowClass"
@@ -65,12 +67,13 @@ extern float PLUGIN_FONT_SCALE_FACTOR;
 #define CATIME_CLOSE_TAG L"</catime>"
 #define CATIME_OPEN_TAG_LEN 8u
 #define CATIME_CLOSE_TAG_LEN 9u
+#define PLUGIN_TEXT_TEMPLATE_MAX_SLOTS \
+    ((int)(TIME_TEXT_MAX_LEN / (CATIME_OPEN_TAG_LEN + CATIME_CLOSE_TAG_LEN)) + 1)
 
 typedef struct {
     wchar_t timeText[TIME_TEXT_MAX_LEN];
     wchar_t timerTextSnapshot[TIME_TEXT_MAX_LEN];
     wchar_t pluginText[TIME_TEXT_MAX_LEN];
-    wchar_t pluginResult[TIME_TEXT_MAX_LEN];
     wchar_t measureText[TIME_TEXT_MAX_LEN];
 } PaintTextBuffers;
 
@@ -109,29 +112,24 @@ typedef struct {
     int fontTagCount;
 } MarkdownRenderCache;
 
+/**
+ * Plugin text compiled once per distinct source: static text with images
+ * extracted, plus the offsets where the timer string is spliced each frame.
+ */
 typedef struct {
     BOOL valid;
     wchar_t sourceText[TIME_TEXT_MAX_LEN];
     size_t sourceTextLen;
-    wchar_t renderedText[TIME_TEXT_MAX_LEN];
+    wchar_t templateText[TIME_TEXT_MAX_LEN];
+    size_t templateTextLen;
+    int slotOffsets[PLUGIN_TEXT_TEMPLATE_MAX_SLOTS];
+    int slotImagesBefore[PLUGIN_TEXT_TEMPLATE_MAX_SLOTS];
+    int slotCount;
+    int* imageTemplatePositions;
     MarkdownImage* images;
     int imageCount;
 } PluginPaintCache;
 
-typedef struct {
-    BOOL valid;
-    BOOL isMarkdown;
-    int fontSize;
-    float fontScaleFactor;
-    DWORD headingSignature;
-    DWORD fontTagSignature;
-    DWORD fontStateGeneration;
-    char fontPath[MAX_PATH];
-    wchar_t text[TIME_TEXT_MAX_LEN];
-    size_t textLen;
-    SIZE size;
-} TextMeasureCache;
-
 typedef struct {
     BOOL valid;
     char fontFileName[MAX_PATH];
@@ -141,12 +139,7 @@ typedef struct {
 } FontPathResolveCache;
 
 typedef struct {
-    HDC memDC;
-    HBITMAP memBitmap;
-    HBITMAP oldBitmap;
-    void* bits;
-    int width;
-    int height;
+    DibSurface surface;
     BOOL frameValid;
     BOOL frameWasScaleComposite;
     BOOL frameEditMode;
@@ -155,6 +148,16 @@ typedef struct {
     int frameHeight;
 } RenderDibCache;
 
+/** What the layered main window currently shows, for partial presents */
+typedef struct {
+    HDC screenDC;
+    HWND hwnd;
+    int width;
+    int height;
+    BYTE alpha;
+    PresentDamageTracker damage;
+} RenderPresentCache;
+
 typedef struct {
     HDC memDC;
     HBITMAP memBitmap;
@@ -192,7 +195,6 @@ typedef struct {
     BOOL measuredTextSizeValid;
     HDC memDC;
     HBITMAP memBitmap;
-    HBITMAP oldBitmap;
     void* bits;
     BOOL usedScaleComposite;
 } PaintFrameContext;
@@ -208,9 +210,9 @@ extern PaintTextBuffers g_paintTextBuffers;
 extern ScaleGestureTextCache g_scaleGestureTextCache;
 extern MarkdownRenderCache g_markdownRenderCache;
 extern PluginPaintCache g_pluginPaintCache;
-extern TextMeasureCache g_textMeasureCache;
 extern FontPathResolveCache g_fontPathResolveCache;
 extern RenderDibCache g_renderDibCache;
+extern RenderPresentCache g_renderPresentCache;
 extern ScaleFrameSnapshot g_scaleFrameSnapshot;
 
 #endif /* DRAWING_RENDER_TYPES_H */
@@ -0,0 +1,79 @@
+/**
+ * @file drawing_sparkline.c
+ * @brief Coverage and block-character sparklines.
+ */
+
+#include "drawing/drawing_sparkline.h"
+
+#include <string.h>
+
+#define SPARKLINE_BLOCK_LEVELS 8
+
+static float ResolveScale(const MetricHistoryPoint* points, int pointCount,
+                          float scaleMax) {
+    if (scaleMax > 0.0f) return scaleMax;
+    float largest = 0.0f;
+    for (int i = 0; i < pointCount; ++i) {
+        if (points[i].count != 0 && points[i].max > largest) largest = points[i].max;
+    }
+    return largest;
+}
+
+/* Pixels of height covered by value; any positive value shows at least one */
+static int ScaleToRows(float value, float scale, int height) {
+    if (value <= 0.0f || scale <= 0.0f) return 0;
+    float rows = value / scale * (float)height;
+    if (rows >= (float)height) return height;
+    int rounded = (int)(rows + 0.5f);
+    return rounded < 1 ? 1 : rounded;
+}
+
+void Sparkline_RasterizeCoverage(BYTE* coverage, int width, int height,
+                                 const MetricHistoryPoint* points, int pointCount,
+                                 float scaleMax) {
+    if (!coverage || width <= 0 || height <= 0) return;
+    memset(coverage, 0, (size_t)width * (size_t)height);
+    if (!points || pointCount <= 0) return;
+    float scale = ResolveScale(points, pointCount, scaleMax);
+
+    for (int x = 0; x < width; ++x) {
+        const MetricHistoryPoint* point =
+            &points[(int)((LONGLONG)x * pointCount / width)];
+        if (point->count == 0) continue;
+        int averageRows = ScaleToRows(point->average, scale, height);
+        int maxRows = ScaleToRows(point->max, scale, height);
+        for (int row = 0; row < maxRows; ++row) {
+            BYTE value = SPARKLINE_BAND_COVERAGE;
+            if (row + 1 == averageRows) {
+                value = 255;
+            } else if (row < averageRows) {
+                value = SPARKLINE_FILL_COVERAGE;
+            }
+            coverage[(size_t)(height - 1 - row) * (size_t)width + (size_t)x] = value;
+        }
+    }
+}
+
+int Sparkline_FormatText(const MetricHistoryPoint* points, int pointCount,
+                         float scaleMax, wchar_t* output, size_t outputCount) {
+    if (!output || outputCount == 0) return 0;
+    output[0] = L'\0';
+    if (!points || pointCount <= 0) return 0;
+    float scale = ResolveScale(points, pointCount, scaleMax);
+
+    int written = 0;
+    for (int i = 0; i < pointCount && (size_t)written + 1 < outputCount; ++i) {
+        wchar_t ch = L' ';
+        if (points[i].count != 0) {
+            int level = 0;
+            if (scale > 0.0f && points[i].average > 0.0f) {
+                level = (int)(points[i].average / scale * SPARKLINE_BLOCK_LEVELS);
+                if (level >= SPARKLINE_BLOCK_LEVELS) level = SPARKLINE_BLOCK_LEVELS - 1;
+            }
+            ch = (wchar_t)(0x2581 + level);
+        }
+        output[written++] = ch;
+    }
+    output[written] = L'\0';
+    return written;
+}
@@ -4,6 +4,7 @@
  */
 
 #include "drawing_text_stb_internal.h"
+#include "drawing/drawing_render_metrics.h"
 
 unsigned char* CreateVisibleGlyphBitmapSTB(const stbtt_fontinfo* fontInfo,
                                            int glyphIndex,
@@ -73,7 +74,7 @@ unsigned char* CreateVisibleGlyphBitmapSTB(const stbtt_fontinfo* fontInfo,
         return NULL;
     }
 
-    BOOL cacheable = (fontInfo == &g_fontInfo || fontInfo == &g_fallbackFontInfo);
+    BOOL cacheable = (fontInfo == &g_fontInfo || IsFallbackFontInfoLocked(fontInfo));
     DWORD fontGeneration = cacheable ? GetFontStateGenerationSTB() : 0;
     DWORD scaleXBits = cacheable ? FloatBitsForGlyphCache(scaleX) : 0;
     DWORD scaleYBits = cacheable ? FloatBitsForGlyphCache(scaleY) : 0;
@@ -89,6 +90,7 @@ unsigned char* CreateVisibleGlyphBitmapSTB(const stbtt_fontinfo* fontInfo,
                                                                   outYoff,
                                                                   pixelCount);
         if (cachedBitmap) {
+            RenderMetrics_Count(RENDER_COUNTER_GLYPH_CACHE_HIT);
             if (width) *width = outW;
             if (height) *height = outH;
             if (xoff) *xoff = outXoff;
@@ -97,17 +99,22 @@ unsigned char* CreateVisibleGlyphBitmapSTB(const stbtt_fontinfo* fontInfo,
         }
     }
 
+    if (cacheable) {
+        RenderMetrics_Count(RENDER_COUNTER_GLYPH_CACHE_MISS);
+    }
     unsigned char* bitmap = (unsigned char*)malloc(pixelCount);
     if (!bitmap) {
         return NULL;
     }
     memset(bitmap, 0, pixelCount);
 
+    LONGLONG rasterizeBegin = RenderMetrics_StageBegin();
     stbtt_vertex* vertices = NULL;
     int numVerts = stbtt_GetGlyphShape(fontInfo, glyphIndex, &vertices);
     if (!vertices || numVerts <= 0) {
         if (vertices) stbtt_FreeShape(fontInfo, vertices);
         free(bitmap);
+        RenderMetrics_StageEnd(RENDER_STAGE_GLYPH_RASTERIZE, rasterizeBegin);
         return NULL;
     }
 
@@ -120,6 +127,7 @@ unsigned char* CreateVisibleGlyphBitmapSTB(const stbtt_fontinfo* fontInfo,
                     scaleX, scaleY, 0.0f, 0.0f,
                     outXoff, outYoff, 1, fontInfo->userdata);
     stbtt_FreeShape(fontInfo, vertices);
+    RenderMetrics_StageEnd(RENDER_STAGE_GLYPH_RASTERIZE, rasterizeBegin);
 
     if (cacheable) {
         StoreGlyphBitmapCacheLocked(fontInfo,
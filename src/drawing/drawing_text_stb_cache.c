@@ -209,7 +209,10 @@ void ApplyCachedGlyphMetrics(const GlyphMetricsCacheEntry* entry,
                                     GlyphMetrics* out) {
     out->index = entry->index;
     out->isFallback = entry->isFallback;
-    out->advance = ScaleTextMetricClamped(entry->advanceUnits,
-                                          entry->isFallback ? fallbackScale : scale);
+    out->fallbackSlot = entry->fallbackSlot;
+    out->advance = ScaleTextMetricClamped(
+        entry->advanceUnits,
+        entry->isFallback ? GetFallbackFontScaleLocked(entry->fallbackSlot, fallbackScale)
+                          : scale);
     out->kern = ScaleTextMetricClamped(entry->kernUnits, scale);
 }
@@ -0,0 +1,177 @@
+/**
+ * @file drawing_text_stb_coverage.c
+ * @brief Per-font code point coverage built straight from the cmap.
+ *
+ * Walking the cmap subtable stb_truetype selected visits each mapped range
+ * once, instead of binary-searching it for every code point. The decoding
+ * mirrors stbtt_FindGlyphIndex, including its quirks, so a covered code
+ * point is exactly one for which that call returns a non-zero glyph.
+ */
+
+#include "drawing_text_stb_internal.h"
+
+#define FONT_COVERAGE_CODEPOINTS (FONT_COVERAGE_PAGE_COUNT * 256)
+#define FONT_COVERAGE_WORDS (FONT_COVERAGE_PAGE_COUNT * FONT_COVERAGE_PAGE_WORDS)
+
+static unsigned int ReadU16(const unsigned char* p) {
+    return ((unsigned int)p[0] << 8) | p[1];
+}
+
+static unsigned int ReadU32(const unsigned char* p) {
+    return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) |
+           ((unsigned int)p[2] << 8) | p[3];
+}
+
+static void MarkCodepoint(DWORD* bits, unsigned int codepoint) {
+    bits[codepoint >> 5] |= 1u << (codepoint & 31);
+}
+
+static void MarkFormat4(DWORD* bits, const unsigned char* table) {
+    unsigned int segCount = ReadU16(table + 6) >> 1;
+    const unsigned char* endCodes = table + 14;
+    const unsigned char* startCodes = endCodes + segCount * 2 + 2;
+    const unsigned char* deltas = startCodes + segCount * 2;
+    const unsigned char* rangeOffsets = deltas + segCount * 2;
+    unsigned int firstFree = 0;
+
+    for (unsigned int seg = 0; seg < segCount; seg++) {
+        unsigned int end = ReadU16(endCodes + seg * 2);
+        unsigned int start = ReadU16(startCodes + seg * 2);
+        unsigned int delta = ReadU16(deltas + seg * 2);
+        unsigned int rangeOffset = ReadU16(rangeOffsets + seg * 2);
+        /* The lookup picks the first segment ending at or after c */
+        unsigned int first = start > firstFree ? start : firstFree;
+        for (unsigned int c = first; c <= end; c++) {
+            unsigned int glyph;
+            if (rangeOffset == 0) {
+                glyph = (c + delta) & 0xFFFFu;
+            } else {
+                glyph = ReadU16(rangeOffsets + seg * 2 + rangeOffset + (c - start) * 2);
+            }
+            if (glyph != 0) MarkCodepoint(bits, c);
+        }
+        if (end + 1 > firstFree) firstFree = end + 1;
+    }
+}
+
+static void MarkFormat12Or13(DWORD* bits, const unsigned char* table, BOOL constantGlyph) {
+    unsigned int groups = ReadU32(table + 12);
+    for (unsigned int group = 0; group < groups; group++) {
+        const unsigned char* entry = table + 16 + group * 12;
+        unsigned int start = ReadU32(entry);
+        unsigned int end = ReadU32(entry + 4);
+        unsigned int startGlyph = ReadU32(entry + 8);
+        if (start >= FONT_COVERAGE_CODEPOINTS) break;
+        if (end >= FONT_COVERAGE_CODEPOINTS) end = FONT_COVERAGE_CODEPOINTS - 1;
+        for (unsigned int c = start; c <= end; c++) {
+            unsigned int glyph = constantGlyph ? startGlyph : startGlyph + (c - start);
+            if (glyph != 0) MarkCodepoint(bits, c);
+        }
+    }
+}
+
+static void MarkCmap(DWORD* bits, const stbtt_fontinfo* info) {
+    const unsigned char* table = info->data + info->index_map;
+    unsigned int format = ReadU16(table);
+
+    if (format == 0) {
+        unsigned int bytes = ReadU16(table + 2);
+        for (unsigned int c = 0; c + 6 < bytes && c < 256; c++) {
+            if (table[6 + c] != 0) MarkCodepoint(bits, c);
+        }
+    } else if (format == 6) {
+        unsigned int first = ReadU16(table + 6);
+        unsigned int count = ReadU16(table + 8);
+        for (unsigned int i = 0; i < count && first + i < FONT_COVERAGE_CODEPOINTS; i++) {
+            if (ReadU16(table + 10 + i * 2) != 0) MarkCodepoint(bits, first + i);
+        }
+    } else if (format == 4) {
+        MarkFormat4(bits, table);
+    } else if (format == 12 || format == 13) {
+        MarkFormat12Or13(bits, table, format == 13);
+    }
+    /* Other formats never resolve in stbtt_FindGlyphIndex */
+}
+
+static WORD ClassifyPage(const DWORD* page) {
+    BOOL empty = TRUE;
+    BOOL full = TRUE;
+    for (int i = 0; i < FONT_COVERAGE_PAGE_WORDS; i++) {
+        if (page[i] != 0) empty = FALSE;
+        if (page[i] != 0xFFFFFFFFu) full = FALSE;
+    }
+    if (empty) return FONT_COVERAGE_EMPTY_PAGE;
+    if (full) return FONT_COVERAGE_FULL_PAGE;
+    return 0xFFFF;
+}
+
+void FreeFontCoverage(FontCoverage* coverage) {
+    if (!coverage) return;
+    free(coverage->blocks);
+    ZeroMemory(coverage, sizeof(*coverage));
+}
+
+BOOL BuildFontCoverage(const stbtt_fontinfo* info, FontCoverage* coverage) {
+    if (!coverage) return FALSE;
+    FreeFontCoverage(coverage);
+    if (!info || !info->data || info->index_map <= 0) return FALSE;
+
+    DWORD* bits = (DWORD*)calloc(FONT_COVERAGE_WORDS, sizeof(DWORD));
+    if (!bits) return FALSE;
+    MarkCmap(bits, info);
+
+    /* Blocks are packed in place at the front of the scratch bitmap; block
+     * k never overtakes page k, so unread pages are never overwritten. */
+    int blockCount = 0;
+    for (int page = 0; page < FONT_COVERAGE_PAGE_COUNT; page++) {
+        const DWORD* pageBits = bits + page * FONT_COVERAGE_PAGE_WORDS;
+        WORD kind = ClassifyPage(pageBits);
+        if (kind != 0xFFFF) {
+            coverage->pages[page] = kind;
+            continue;
+        }
+
+        int block = 0;
+        while (block < blockCount &&
+               memcmp(bits + block * FONT_COVERAGE_PAGE_WORDS, pageBits,
+                      FONT_COVERAGE_PAGE_WORDS * sizeof(DWORD)) != 0) {
+            block++;
+        }
+        if (block == blockCount) {
+            memmove(bits + block * FONT_COVERAGE_PAGE_WORDS, pageBits,
+                    FONT_COVERAGE_PAGE_WORDS * sizeof(DWORD));
+            blockCount++;
+        }
+        coverage->pages[page] = (WORD)(block + 2);
+    }
+
+    if (blockCount > 0) {
+        coverage->blocks = (DWORD*)malloc((size_t)blockCount *
+                                          FONT_COVERAGE_PAGE_WORDS * sizeof(DWORD));
+        if (!coverage->blocks) {
+            free(bits);
+            ZeroMemory(coverage, sizeof(*coverage));
+            return FALSE;
+        }
+        memcpy(coverage->blocks, bits,
+               (size_t)blockCount * FONT_COVERAGE_PAGE_WORDS * sizeof(DWORD));
+    }
+    free(bits);
+
+    coverage->blockCount = blockCount;
+    coverage->valid = TRUE;
+    return TRUE;
+}
+
+BOOL FontCoverageContains(const FontCoverage* coverage, wchar_t c) {
+    if (!coverage || !coverage->valid) return TRUE;
+    unsigned int codepoint = (unsigned int)c;
+    if (codepoint >= FONT_COVERAGE_CODEPOINTS) return TRUE;
+
+    WORD page = coverage->pages[codepoint >> 8];
+    if (page == FONT_COVERAGE_EMPTY_PAGE) return FALSE;
+    if (page == FONT_COVERAGE_FULL_PAGE) return TRUE;
+
+    const DWORD* block = coverage->blocks + (size_t)(page - 2) * FONT_COVERAGE_PAGE_WORDS;
+    return (block[(codepoint & 0xFF) >> 5] >> (codepoint & 31)) & 1u;
+}
@@ -4,6 +4,21 @@
  */
 
 #include "drawing_text_stb_internal.h"
+#include "drawing/drawing_blend.h"
+#include "drawing/drawing_effect_tiles.h"
+#include "drawing/drawing_render_metrics.h"
+
+typedef struct {
+    int x;
+    int y;
+    int w;
+    int h;
+    int r;
+    int g;
+    int b;
+    EffectType effect;
+    int timeOffset;
+} SolidGlyphTileArgs;
 
 static void GetContrastShadowColor(int r, int g, int b,
                                    int* shadowR, int* shadowG, int* shadowB) {
@@ -24,11 +39,11 @@ void BlendCharBitmapSTB(void* destBits, int destWidth, int destHeight,
                                  GetActiveEffect(), (int)GetTickCount());
 }
 
-void BlendCharBitmapSTBWithEffect(void* destBits, int destWidth, int destHeight,
-                                  int x_pos, int y_pos,
-                                  const unsigned char* bitmap, int w, int h,
-                                  int r, int g, int b,
-                                  EffectType effect, int timeOffset) {
+static void BlendSolidGlyph(void* destBits, int destWidth, int destHeight,
+                            int x_pos, int y_pos,
+                            const unsigned char* bitmap, int w, int h,
+                            int r, int g, int b,
+                            EffectType effect, int timeOffset) {
     DWORD* pixels = (DWORD*)destBits;
     size_t pixelCount = 0;
 
@@ -78,26 +93,35 @@ void BlendCharBitmapSTBWithEffect(void* destBits, int destWidth, int destHeight,
         DWORD* destRow = pixels + (size_t)destY * (size_t)destWidth + (size_t)clip.destLeft;
         const unsigned char* srcRow = bitmap + (size_t)j * (size_t)w + (size_t)clip.srcLeft;
 
-        for (int i = clip.srcLeft; i < clip.srcRight; ++i) {
-            unsigned char alpha = *srcRow++;
-            if (alpha == 0) {
-                destRow++;
-                continue;
-            }
+        /* Premultiplied for UpdateLayeredWindow; the more opaque pixel wins */
+        DrawingBlend_PremultiplyMaxRow(destRow, srcRow, clip.srcRight - clip.srcLeft,
+                                       r, g, b);
+    }
+}
 
-            DWORD currentPixel = *destRow;
-            DWORD currentA = (currentPixel >> 24) & 0xFF;
+static void ReplaySolidGlyph(DWORD* pixels, int width, int height,
+                             const unsigned char* bitmap, const void* args) {
+    const SolidGlyphTileArgs* glyph = (const SolidGlyphTileArgs*)args;
+    BlendSolidGlyph(pixels, width, height, glyph->x, glyph->y, bitmap,
+                    glyph->w, glyph->h, glyph->r, glyph->g, glyph->b,
+                    glyph->effect, glyph->timeOffset);
+}
 
-            /* If new pixel is more opaque, overwrite */
-            if (alpha > currentA) {
-                /* Calculate premultiplied color values for UpdateLayeredWindow */
-                DWORD finalR = (r * alpha) / 255;
-                DWORD finalG = (g * alpha) / 255;
-                DWORD finalB = (b * alpha) / 255;
-                DWORD finalA = (DWORD)alpha;
-                *destRow = (finalA << 24) | (finalR << 16) | (finalG << 8) | finalB;
-            }
-            destRow++;
+void BlendCharBitmapSTBWithEffect(void* destBits, int destWidth, int destHeight,
+                                  int x_pos, int y_pos,
+                                  const unsigned char* bitmap, int w, int h,
+                                  int r, int g, int b,
+                                  EffectType effect, int timeOffset) {
+    if (effect != EFFECT_TYPE_NONE) {
+        SolidGlyphTileArgs args = {x_pos, y_pos, w, h, r, g, b, effect, timeOffset};
+        if (DrawingEffectTiles_Submit((DWORD*)destBits, ReplaySolidGlyph, &args, sizeof(args),
+                                      bitmap, w, h, y_pos)) {
+            return;
         }
     }
+
+    LONGLONG effectBegin = effect != EFFECT_TYPE_NONE ? RenderMetrics_StageBegin() : 0;
+    BlendSolidGlyph(destBits, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
+                    r, g, b, effect, timeOffset);
+    RenderMetrics_StageEnd(RENDER_STAGE_EFFECT, effectBegin);
 }
@@ -0,0 +1,122 @@
+/**
+ * @file drawing_text_stb_fallback.c
+ * @brief Ordered fallback font chain with per-face coverage.
+ *
+ * Glyphs the main font lacks go to the first chain face whose coverage has
+ * the code point, so mixed CJK, symbol and Latin text costs one bit test per
+ * face instead of a cmap search per face. The chain outlives main font
+ * switches and is released only by CleanupFontSTB.
+ */
+
+#include "drawing_text_stb_internal.h"
+
+/* Each link takes the first of its alternatives that loads */
+typedef struct {
+    const wchar_t* paths[2];
+} FallbackFontLink;
+
+static const FallbackFontLink g_fallbackFontLinks[MAX_FALLBACK_FONTS] = {
+    /* CJK, blocks and BW emoji */
+    {{L"C:\\Windows\\Fonts\\msyh.ttc", L"C:\\Windows\\Fonts\\msyh.ttf"}},
+    /* Symbols, arrows, box drawing */
+    {{L"C:\\Windows\\Fonts\\seguisym.ttf", NULL}},
+    /* Arabic, Hebrew, Armenian, Georgian and extended Latin */
+    {{L"C:\\Windows\\Fonts\\segoeui.ttf", NULL}},
+    /* Last resort; color glyphs may render blank in STB */
+    {{L"C:\\Windows\\Fonts\\seguiemj.ttf", NULL}},
+};
+
+static BOOL LoadFallbackFontLocked(const wchar_t* path, FallbackFont* font) {
+    HANDLE hFile = INVALID_HANDLE_VALUE;
+    HANDLE hMapping = NULL;
+    unsigned char* buffer = LoadFontMappingW(path, &hFile, &hMapping);
+    if (!buffer) return FALSE;
+
+    if (!InitFontInfoFromBufferW(&font->fontInfo, buffer, path)) {
+        ReleaseMappedFont(buffer, hFile, hMapping);
+        return FALSE;
+    }
+
+    font->buffer = buffer;
+    font->hFile = hFile;
+    font->hMapping = hMapping;
+    if (!BuildFontCoverage(&font->fontInfo, &font->coverage)) {
+        LOG_WARNING("Fallback font coverage unavailable, probing instead: %ls", path);
+    }
+    return TRUE;
+}
+
+void LoadFallbackFontChainLocked(void) {
+    if (g_fallbackFontCount > 0) return;
+
+    float baseUnitScale = 0.0f;
+    for (int link = 0; link < MAX_FALLBACK_FONTS; link++) {
+        for (int alt = 0; alt < 2 && g_fallbackFontLinks[link].paths[alt]; alt++) {
+            const wchar_t* path = g_fallbackFontLinks[link].paths[alt];
+            FallbackFont* font = &g_fallbackFonts[g_fallbackFontCount];
+            if (!LoadFallbackFontLocked(path, font)) continue;
+
+            /* Callers pass one fallbackScale, computed for the first link */
+            float unitScale = stbtt_ScaleForPixelHeight(&font->fontInfo, 1.0f);
+            if (g_fallbackFontCount == 0) baseUnitScale = unitScale;
+            font->scaleRatio = (g_fallbackFontCount > 0 && baseUnitScale > 0.0f)
+                ? unitScale / baseUnitScale
+                : 1.0f;
+            g_fallbackFontCount++;
+            LOG_INFO("STB Fallback Font %d loaded: %ls", g_fallbackFontCount, path);
+            break;
+        }
+    }
+
+    if (g_fallbackFontCount == 0) {
+        LOG_WARNING("Failed to load fallback font (Emoji/Symbol)");
+    }
+}
+
+void ReleaseFallbackFontChainLocked(void) {
+    for (int i = 0; i < g_fallbackFontCount; i++) {
+        FallbackFont* font = &g_fallbackFonts[i];
+        ReleaseMappedFont(font->buffer, font->hFile, font->hMapping);
+        FreeFontCoverage(&font->coverage);
+        ZeroMemory(font, sizeof(*font));
+        font->hFile = INVALID_HANDLE_VALUE;
+    }
+    g_fallbackFontCount = 0;
+}
+
+int FindFallbackGlyphLocked(wchar_t c, int* outSlot) {
+    for (int i = 0; i < g_fallbackFontCount; i++) {
+        if (!FontCoverageContains(&g_fallbackFonts[i].coverage, c)) continue;
+        int glyphIndex = stbtt_FindGlyphIndex(&g_fallbackFonts[i].fontInfo, (int)c);
+        if (glyphIndex != 0) {
+            if (outSlot) *outSlot = i;
+            return glyphIndex;
+        }
+    }
+    return 0;
+}
+
+float GetFallbackFontScaleLocked(int slot, float fallbackScale) {
+    if (slot <= 0 || slot >= g_fallbackFontCount) return fallbackScale;
+    return fallbackScale * g_fallbackFonts[slot].scaleRatio;
+}
+
+BOOL IsFallbackFontInfoLocked(const stbtt_fontinfo* fontInfo) {
+    for (int i = 0; i < g_fallbackFontCount; i++) {
+        if (fontInfo == &g_fallbackFonts[i].fontInfo) return TRUE;
+    }
+    return FALSE;
+}
+
+const stbtt_fontinfo* GetGlyphFontInfoSTB(const GlyphMetrics* metrics,
+                                          float scale,
+                                          float fallbackScale,
+                                          float* glyphScale) {
+    if (!metrics || !metrics->isFallback ||
+        metrics->fallbackSlot < 0 || metrics->fallbackSlot >= g_fallbackFontCount) {
+        if (glyphScale) *glyphScale = scale;
+        return &g_fontInfo;
+    }
+    if (glyphScale) *glyphScale = GetFallbackFontScaleLocked(metrics->fallbackSlot, fallbackScale);
+    return &g_fallbackFonts[metrics->fallbackSlot].fontInfo;
+}
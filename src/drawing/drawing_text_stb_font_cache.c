@@ -23,6 +23,7 @@ static void ReleaseCachedFontSlotLocked(int slot) {
         AdvanceFontStateGeneration();
     }
     ZeroMemory(&g_fontCache[slot], sizeof(CachedFont));
+    FreeFontCoverage(&g_fontCacheCoverage[slot]);
     g_fontCacheLRU[slot] = 0;
     ClearFontTagGlyphMetricsCacheSlotLocked(slot);
 }
@@ -258,6 +259,7 @@ stbtt_fontinfo* GetCachedFontSTB(const wchar_t* fontPath) {
     g_fontCache[targetSlot].lastValidateTick = GetTickCount();
     g_fontCache[targetSlot].fileInfoValid = TRUE;
     g_fontCache[targetSlot].isLoaded = TRUE;
+    BuildFontCoverage(&g_fontCache[targetSlot].fontInfo, &g_fontCacheCoverage[targetSlot]);
     TouchFontCacheSlotLocked(targetSlot);
     AdvanceFontStateGeneration();
 
@@ -74,6 +74,14 @@ void GetGlowGradientColor(int x, int y,
 
     if (!ctx || !ctx->info || !r || !g || !b) return;
 
+    if (ctx->scanline && x >= 0 && x < ctx->scanlineWidth) {
+        COLORREF c = ctx->scanline[x];
+        *r = GetRValue(c);
+        *g = GetGValue(c);
+        *b = GetBValue(c);
+        return;
+    }
+
     if (ctx->isAnimated) {
         long long lutPosition = 0;
         if (ctx->totalWidth > 0) {
@@ -98,7 +106,7 @@ void GetGlowGradientColor(int x, int y,
     }
 }
 
-static DWORD ComputeGradientLUTSignature(const GradientInfo* info) {
+DWORD ComputeGradientLUTSignature(const GradientInfo* info) {
     if (!info) return 0;
 
     DWORD signature = 2166136261u;
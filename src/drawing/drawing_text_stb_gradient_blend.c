@@ -4,6 +4,19 @@
  */
 
 #include "drawing_text_stb_internal.h"
+#include "drawing/drawing_blend.h"
+#include "drawing/drawing_effect_tiles.h"
+#include "drawing/drawing_render_metrics.h"
+
+typedef struct {
+    int x;
+    int y;
+    int w;
+    int h;
+    const GradientScanline* scanline;
+    int timeOffset;
+    EffectType effect;
+} GradientGlyphTileArgs;
 
 void BlendCharBitmapGradientSTB(void* destBits, int destWidth, int destHeight,
                                 int x_pos, int y_pos,
@@ -30,47 +43,33 @@ void BlendCharBitmapGradientSTBWithEffect(void* destBits, int destWidth, int des
                                        timeOffset, effect);
 }
 
-void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destHeight,
-                                        int x_pos, int y_pos,
-                                        const unsigned char* bitmap, int w, int h,
-                                        int startX, int totalWidth,
-                                        const GradientInfo* gradientInfo,
-                                        int timeOffset, EffectType effect) {
-    const GradientInfo* info = gradientInfo;
+static void InitRowGradientContext(GlowGradientContext* ctx,
+                                   const GradientScanline* scanline) {
+    InitGlowGradientContext(ctx, &scanline->info, scanline->startX,
+                            scanline->totalWidth, scanline->timeOffset);
+    ctx->scanline = scanline->colors;
+    ctx->scanlineWidth = scanline->width;
+}
+
+static void BlendGradientGlyph(void* destBits, int destWidth, int destHeight,
+                               int x_pos, int y_pos,
+                               const unsigned char* bitmap, int w, int h,
+                               const GradientScanline* scanline,
+                               int timeOffset, EffectType effect) {
     DWORD* pixels = (DWORD*)destBits;
     size_t destPixelCount = 0;
     size_t bitmapPixelCount = 0;
 
-    if (!pixels || !bitmap ||
+    if (!pixels || !bitmap || !scanline || scanline->width < destWidth ||
         !CalculateBitmapPixelCount(destWidth, destHeight, &destPixelCount) ||
         !CalculateBitmapPixelCount(w, h, &bitmapPixelCount)) {
         return;
     }
 
-    if (!info) return;
-
-    int r1 = 0, g1 = 0, b1 = 0;
-    int r2 = 0, g2 = 0, b2 = 0;
-
-    /* Animation parameters */
-    float lutStep = 0.0f;
-
-    if (info->isAnimated) {
-        BOOL needLutUpdate = !GradientLUTMatches(info);
-        if (needLutUpdate) InitializeGradientLUT(info);
-
-        if (totalWidth > 0) {
-            lutStep = (float)LUT_SIZE / (float)totalWidth;
-        }
-    } else {
-        r1 = GetRValue(info->startColor);
-        g1 = GetGValue(info->startColor);
-        b1 = GetBValue(info->startColor);
-
-        r2 = GetRValue(info->endColor);
-        g2 = GetGValue(info->endColor);
-        b2 = GetBValue(info->endColor);
-    }
+    const GradientInfo* info = &scanline->info;
+    int r1 = GetRValue(info->startColor);
+    int g1 = GetGValue(info->startColor);
+    int b1 = GetBValue(info->startColor);
 
     /* Render glow effect if enabled - use gradient start color as base but use callback for per-pixel color */
     if (effect == EFFECT_TYPE_GLOW) {
@@ -79,7 +78,7 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int glowB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitRowGradientContext(&ctx, scanline);
         RenderGlowEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                          glowR, glowG, glowB, GetGlowGradientColor, &ctx);
     } else if (effect == EFFECT_TYPE_GLASS) {
@@ -88,7 +87,7 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int glassB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitRowGradientContext(&ctx, scanline);
         RenderGlassEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                          glassR, glassG, glassB, GetGlowGradientColor, &ctx);
         /*
@@ -101,7 +100,7 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int neonB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitRowGradientContext(&ctx, scanline);
         RenderNeonEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                          neonR, neonG, neonB, GetGlowGradientColor, &ctx);
         /* Neon replaces solid text */
@@ -112,7 +111,7 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int holoB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitRowGradientContext(&ctx, scanline);
         RenderHolographicEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                                 holoR, holoG, holoB, GetGlowGradientColor, &ctx, timeOffset);
         /* Critical: Return early */
@@ -123,7 +122,7 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int liquidB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitRowGradientContext(&ctx, scanline);
         RenderLiquidEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                            liquidR, liquidG, liquidB, GetGlowGradientColor, &ctx, timeOffset);
         /* Critical: Return early */
@@ -134,7 +133,9 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
         int aquaB = GetBValue(info->startColor);
 
         GlowGradientContext ctx;
-        InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+        InitGlowGradientContext(&ctx, info, scanline->startX, scanline->totalWidth,
+                                timeOffset);
+        /* Aqua samples the gradient unanimated, so the row does not apply */
         ctx.timeOffset = 0;
         RenderAquaEffect(pixels, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
                          aquaR, aquaG, aquaB, GetGlowGradientColor, &ctx, timeOffset);
@@ -170,67 +171,51 @@ void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destH
 
         DWORD* destRow = pixels + destIndex;
         const unsigned char* srcRow = bitmap + srcIndex;
+        const COLORREF* colors = scanline->colors + clip.destLeft;
 
-        /* Pre-calculate starting LUT index for this row if Animated */
-        float currentLutIdxFloat = 0.0f;
-        if (info->isAnimated) {
-            long long rowStartX = (long long)clip.destLeft - (long long)startX;
-            if (totalWidth > 0) {
-                currentLutIdxFloat = ((float)rowStartX / (float)totalWidth) * LUT_SIZE;
-            }
-        }
+        DrawingBlend_PremultiplyMaxColorsRow(destRow, srcRow, colors,
+                                             clip.srcRight - clip.srcLeft);
+    }
+}
 
-        long long currentGradientFixed = 0;
-        long long gradientFixedStep = 0;
-        if (!info->isAnimated && totalWidth > 0) {
-            currentGradientFixed = GradientPositionFixed(clip.destLeft, startX, totalWidth);
-            gradientFixedStep = GRADIENT_FIXED_ONE / (long long)totalWidth;
-        }
+static void ReplayGradientGlyph(DWORD* pixels, int width, int height,
+                                const unsigned char* bitmap, const void* args) {
+    const GradientGlyphTileArgs* glyph = (const GradientGlyphTileArgs*)args;
+    BlendGradientGlyph(pixels, width, height, glyph->x, glyph->y, bitmap,
+                       glyph->w, glyph->h, glyph->scanline, glyph->timeOffset,
+                       glyph->effect);
+}
+
+void BlendCharBitmapGradientScanlineSTB(void* destBits, int destWidth, int destHeight,
+                                        int x_pos, int y_pos,
+                                        const unsigned char* bitmap, int w, int h,
+                                        const GradientScanline* scanline,
+                                        int timeOffset, EffectType effect) {
+    if (!scanline) return;
 
-        for (int i = clip.srcLeft; i < clip.srcRight; ++i) {
-            unsigned char alpha = *srcRow++;
-
-            if (alpha == 0) {
-                if (info->isAnimated) currentLutIdxFloat += lutStep;
-                else AdvanceGradientPositionFixed(&currentGradientFixed, gradientFixedStep);
-                destRow++;
-                continue;
-            }
-
-            int r, g, b;
-
-            if (info->isAnimated) {
-                /* Optimized LUT Lookup */
-                int lutIdx = (int)currentLutIdxFloat - timeOffset;
-                currentLutIdxFloat += lutStep;
-
-                /* Optimized wrap-around logic */
-                lutIdx = lutIdx & (LUT_SIZE - 1);
-
-                COLORREF c = g_gradientLUT[lutIdx];
-                r = GetRValue(c);
-                g = GetGValue(c);
-                b = GetBValue(c);
-            } else {
-                r = InterpolateGradientChannelFixed(r1, r2, currentGradientFixed);
-                g = InterpolateGradientChannelFixed(g1, g2, currentGradientFixed);
-                b = InterpolateGradientChannelFixed(b1, b2, currentGradientFixed);
-                AdvanceGradientPositionFixed(&currentGradientFixed, gradientFixedStep);
-            }
-
-            /* Blend */
-            DWORD currentPixel = *destRow;
-            DWORD currentA = (currentPixel >> 24) & 0xFF;
-
-            if (alpha > currentA) {
-                DWORD finalR = (r * alpha) / 255;
-                DWORD finalG = (g * alpha) / 255;
-                DWORD finalB = (b * alpha) / 255;
-                DWORD finalA = (DWORD)alpha;
-
-                *destRow = (finalA << 24) | (finalR << 16) | (finalG << 8) | finalB;
-            }
-            destRow++;
+    if (effect != EFFECT_TYPE_NONE) {
+        /* The row outlives the batch: rebuilding it flushes first */
+        GradientGlyphTileArgs args = {x_pos, y_pos, w, h, scanline, timeOffset, effect};
+        if (DrawingEffectTiles_Submit((DWORD*)destBits, ReplayGradientGlyph, &args, sizeof(args),
+                                      bitmap, w, h, y_pos)) {
+            return;
         }
     }
+
+    LONGLONG effectBegin = effect != EFFECT_TYPE_NONE ? RenderMetrics_StageBegin() : 0;
+    BlendGradientGlyph(destBits, destWidth, destHeight, x_pos, y_pos, bitmap, w, h,
+                       scanline, timeOffset, effect);
+    RenderMetrics_StageEnd(RENDER_STAGE_EFFECT, effectBegin);
+}
+
+void BlendCharBitmapGradientSTBWithInfo(void* destBits, int destWidth, int destHeight,
+                                        int x_pos, int y_pos,
+                                        const unsigned char* bitmap, int w, int h,
+                                        int startX, int totalWidth,
+                                        const GradientInfo* gradientInfo,
+                                        int timeOffset, EffectType effect) {
+    const GradientScanline* scanline = AcquireGradientScanlineSTB(
+        gradientInfo, startX, totalWidth, timeOffset, destWidth);
+    BlendCharBitmapGradientScanlineSTB(destBits, destWidth, destHeight, x_pos, y_pos,
+                                       bitmap, w, h, scanline, timeOffset, effect);
 }
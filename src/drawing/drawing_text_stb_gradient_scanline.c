@@ -0,0 +1,87 @@
+/**
+ * @file drawing_text_stb_gradient_scanline.c
+ * @brief Per-frame gradient rows shared by every glyph of a text run.
+ *
+ * A gradient color depends only on the destination column, so a run's
+ * colors are computed once per frame and each glyph, effect callback and
+ * tile replay indexes that row instead of redoing the LUT or fixed-point
+ * math per pixel.
+ */
+
+#include "drawing_text_stb_internal.h"
+#include "drawing/drawing_effect_tiles.h"
+
+static GradientScanline g_gradientScanline = {0};
+
+static BOOL ScanlineMatches(const GradientScanline* row, const GradientInfo* info,
+                            DWORD signature, int startX, int totalWidth,
+                            int timeOffset, int destWidth) {
+    return row->valid &&
+           row->signature == signature &&
+           row->info.type == info->type &&
+           row->info.isAnimated == info->isAnimated &&
+           row->startX == startX &&
+           row->totalWidth == totalWidth &&
+           row->timeOffset == timeOffset &&
+           row->width == destWidth;
+}
+
+const GradientScanline* AcquireGradientScanlineSTB(const GradientInfo* info,
+                                                   int startX, int totalWidth,
+                                                   int timeOffset, int destWidth) {
+    if (!info || destWidth <= 0) return NULL;
+
+    /* A static gradient is the same row in every frame */
+    if (!info->isAnimated) timeOffset = 0;
+
+    GradientScanline* row = &g_gradientScanline;
+    DWORD signature = ComputeGradientLUTSignature(info);
+    if (ScanlineMatches(row, info, signature, startX, totalWidth, timeOffset, destWidth)) {
+        return row;
+    }
+
+    /* Recorded glyphs read the row and LUT at replay, so drain them first */
+    DrawingEffectTiles_Flush();
+    if (info->isAnimated && !GradientLUTMatches(info)) {
+        InitializeGradientLUT(info);
+    }
+
+    if (destWidth > row->capacity) {
+        COLORREF* colors = (COLORREF*)realloc(row->colors, (size_t)destWidth * sizeof(COLORREF));
+        if (!colors) {
+            ReleaseGradientScanlineSTB();
+            return NULL;
+        }
+        row->colors = colors;
+        row->capacity = destWidth;
+    }
+
+    row->info = *info;
+    row->info.name = NULL;
+    row->info.displayName = NULL;
+    row->info.palette = NULL;
+    row->info.paletteCount = 0;
+    row->signature = signature;
+    row->startX = startX;
+    row->totalWidth = totalWidth;
+    row->timeOffset = timeOffset;
+    row->width = destWidth;
+
+    /* Same formulas the effect callbacks evaluate per pixel */
+    GlowGradientContext ctx;
+    InitGlowGradientContext(&ctx, info, startX, totalWidth, timeOffset);
+    for (int x = 0; x < destWidth; x++) {
+        int r = 0, g = 0, b = 0;
+        GetGlowGradientColor(x, 0, &r, &g, &b, &ctx);
+        row->colors[x] = RGB(r, g, b);
+    }
+
+    row->valid = TRUE;
+    return row;
+}
+
+void ReleaseGradientScanlineSTB(void) {
+    DrawingEffectTiles_Flush();
+    free(g_gradientScanline.colors);
+    ZeroMemory(&g_gradientScanline, sizeof(g_gradientScanline));
+}
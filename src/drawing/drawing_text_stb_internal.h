@@ -29,19 +29,19 @@ extern DWORD g_currentFontLastValidateTick;
 extern BOOL g_currentFontFileInfoValid;
 extern BOOL g_fontLoaded;
 
-extern unsigned char* g_fallbackFontBuffer;
-extern stbtt_fontinfo g_fallbackFontInfo;
-extern BOOL g_fallbackFontLoaded;
+extern FontCoverage g_fontCoverage;
+
+extern FallbackFont g_fallbackFonts[MAX_FALLBACK_FONTS];
+extern int g_fallbackFontCount;
 
 extern HANDLE g_hFontFile;
 extern HANDLE g_hFontMapping;
-extern HANDLE g_hFallbackFontFile;
-extern HANDLE g_hFallbackFontMapping;
 extern volatile LONG g_fontStateGeneration;
 
 extern CachedFont g_fontCache[MAX_CACHED_FONTS];
 extern int g_fontCacheLRU[MAX_CACHED_FONTS];
 extern int g_fontCacheAccessCounter;
+extern FontCoverage g_fontCacheCoverage[MAX_CACHED_FONTS];
 extern FontTagGlyphMetricsCacheEntry
     g_fontTagGlyphMetricsCache[MAX_CACHED_FONTS][FONT_TAG_GLYPH_METRICS_CACHE_SIZE];
 extern FailedFontCacheEntry g_failedFontCache[MAX_FAILED_FONT_CACHE];
@@ -109,6 +109,15 @@ void ApplyCachedGlyphMetrics(const GlyphMetricsCacheEntry* entry,
                              float fallbackScale,
                              GlyphMetrics* out);
 
+BOOL BuildFontCoverage(const stbtt_fontinfo* info, FontCoverage* coverage);
+void FreeFontCoverage(FontCoverage* coverage);
+BOOL FontCoverageContains(const FontCoverage* coverage, wchar_t c);
+void LoadFallbackFontChainLocked(void);
+void ReleaseFallbackFontChainLocked(void);
+int FindFallbackGlyphLocked(wchar_t c, int* outSlot);
+float GetFallbackFontScaleLocked(int slot, float fallbackScale);
+BOOL IsFallbackFontInfoLocked(const stbtt_fontinfo* fontInfo);
+
 void ReleaseMappedFont(unsigned char* buffer, HANDLE hFile, HANDLE hMapping);
 BOOL InitFontInfoFromBuffer(stbtt_fontinfo* fontInfo,
                             const unsigned char* buffer,
@@ -152,6 +161,7 @@ void InitGlowGradientContext(GlowGradientContext* ctx,
 void GetGlowGradientColor(int x, int y,
                           int* r, int* g, int* b,
                           const void* userData);
+DWORD ComputeGradientLUTSignature(const GradientInfo* info);
 BOOL GradientLUTMatches(const GradientInfo* info);
 void InitializeGradientLUT(const GradientInfo* info);
 
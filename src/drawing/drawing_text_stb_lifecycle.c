@@ -5,12 +5,12 @@
 
 #include "drawing_text_stb_internal.h"
 
-static void CleanupFontSTBLocked(void);
+static void CleanupFontSTBLocked(BOOL releaseFallbacks);
 
 BOOL IsFontLoadedSTB(void) { return g_fontLoaded; }
-BOOL IsFallbackFontLoadedSTB(void) { return g_fallbackFontLoaded; }
+BOOL IsFallbackFontLoadedSTB(void) { return g_fallbackFontCount > 0; }
 stbtt_fontinfo* GetMainFontInfoSTB(void) { return &g_fontInfo; }
-stbtt_fontinfo* GetFallbackFontInfoSTB(void) { return &g_fallbackFontInfo; }
+stbtt_fontinfo* GetFallbackFontInfoSTB(void) { return &g_fallbackFonts[0].fontInfo; }
 
 unsigned char* LoadFontMappingW(const wchar_t* path, HANDLE* phFile, HANDLE* phMapping) {
     HANDLE hFile = INVALID_HANDLE_VALUE;
@@ -69,26 +69,26 @@ static unsigned char* LoadFontMapping(const char* path, HANDLE* phFile, HANDLE*
 void CleanupFontSTB(void) {
     if (!BeginFontUseSTB()) return;
 
-    CleanupFontSTBLocked();
+    CleanupFontSTBLocked(TRUE);
 
     EndFontUseSTB();
 }
 
-static void CleanupFontSTBLocked(void) {
-    BOOL hadMainFontState = g_fontLoaded || g_fallbackFontLoaded ||
-                            g_fontBuffer || g_fallbackFontBuffer;
+/* Switching the main font keeps the fallback chain and its coverage: they
+ * do not depend on the main face and are the costly part to reload. */
+static void CleanupFontSTBLocked(BOOL releaseFallbacks) {
+    BOOL hadMainFontState = g_fontLoaded || g_fallbackFontCount > 0 || g_fontBuffer;
 
     /* Cleanup main font */
     ReleaseMappedFont(g_fontBuffer, g_hFontFile, g_hFontMapping);
     g_fontBuffer = NULL;
     g_hFontFile = INVALID_HANDLE_VALUE;
     g_hFontMapping = NULL;
+    FreeFontCoverage(&g_fontCoverage);
 
-    /* Cleanup fallback font */
-    ReleaseMappedFont(g_fallbackFontBuffer, g_hFallbackFontFile, g_hFallbackFontMapping);
-    g_fallbackFontBuffer = NULL;
-    g_hFallbackFontFile = INVALID_HANDLE_VALUE;
-    g_hFallbackFontMapping = NULL;
+    if (releaseFallbacks) {
+        ReleaseFallbackFontChainLocked();
+    }
 
     /* Cleanup font cache */
     ClearFontCacheSTBLocked();
@@ -96,7 +96,6 @@ static void CleanupFontSTBLocked(void) {
     ClearGlyphBitmapCacheLocked();
 
     g_fontLoaded = FALSE;
-    g_fallbackFontLoaded = FALSE;
     memset(g_currentFontPath, 0, sizeof(g_currentFontPath));
     ZeroMemory(&g_currentFontLastWriteTime, sizeof(g_currentFontLastWriteTime));
     g_currentFontFileSize = 0;
@@ -147,7 +146,7 @@ BOOL InitFontSTB(const char* fontFilePath) {
     }
 
     // Success - now replace the global state
-    CleanupFontSTBLocked();
+    CleanupFontSTBLocked(FALSE);
 
     g_fontBuffer = newBuffer;
     g_fontInfo = newInfo;
@@ -164,46 +163,9 @@ BOOL InitFontSTB(const char* fontFilePath) {
 
     LOG_INFO("STB Font loaded successfully: %s", fontFilePath);
 
-    /* Load Fallback Font */
-    /* Priority:
-       1. Microsoft YaHei (msyh.ttc) - Best coverage for CJK, Blocks & BW Emojis
-       2. Microsoft YaHei (msyh.ttf) - Legacy
-       3. Segoe UI Symbol (seguisym.ttf) - Good for blocks
-       4. Segoe UI Emoji (seguiemj.ttf) - Last resort (might render blank in STB)
-    */
-    const char* fallbackPath = "C:\\Windows\\Fonts\\msyh.ttc";
-    HANDLE hFallbackFile = INVALID_HANDLE_VALUE;
-    HANDLE hFallbackMapping = NULL;
-    unsigned char* fallbackBuffer = LoadFontMapping(fallbackPath, &hFallbackFile, &hFallbackMapping);
-
-    if (!fallbackBuffer) {
-        fallbackPath = "C:\\Windows\\Fonts\\msyh.ttf";
-        fallbackBuffer = LoadFontMapping(fallbackPath, &hFallbackFile, &hFallbackMapping);
-    }
-
-    if (!fallbackBuffer) {
-        fallbackPath = "C:\\Windows\\Fonts\\seguisym.ttf";
-        fallbackBuffer = LoadFontMapping(fallbackPath, &hFallbackFile, &hFallbackMapping);
-    }
-
-    if (!fallbackBuffer) {
-        fallbackPath = "C:\\Windows\\Fonts\\seguiemj.ttf";
-        fallbackBuffer = LoadFontMapping(fallbackPath, &hFallbackFile, &hFallbackMapping);
-    }
-
-    if (fallbackBuffer) {
-        if (InitFontInfoFromBuffer(&g_fallbackFontInfo, fallbackBuffer, fallbackPath)) {
-            g_fallbackFontBuffer = fallbackBuffer;
-            g_hFallbackFontFile = hFallbackFile;
-            g_hFallbackFontMapping = hFallbackMapping;
-            g_fallbackFontLoaded = TRUE;
-            LOG_INFO("STB Fallback Font loaded: %s", fallbackPath);
-        } else {
-            ReleaseMappedFont(fallbackBuffer, hFallbackFile, hFallbackMapping);
-        }
-    } else {
-        LOG_WARNING("Failed to load fallback font (Emoji/Symbol)");
-    }
+    /* Coverage lets glyph lookups skip faces that cannot have the glyph */
+    BuildFontCoverage(&g_fontInfo, &g_fontCoverage);
+    LoadFallbackFontChainLocked();
 
     EndFontUseSTB();
     return TRUE;
@@ -0,0 +1,85 @@
+/**
+ * @file drawing_text_stb_math.c
+ * @brief Overflow-safe size, clipping and clamping arithmetic for glyph blits.
+ */
+
+#include "drawing_text_stb_internal.h"
+#include "drawing/drawing_effect_common.h"
+
+BOOL CalculateBitmapPixelCount(int width, int height, size_t* outPixelCount) {
+    if (!outPixelCount || width <= 0 || height <= 0) return FALSE;
+
+    size_t sw = (size_t)width;
+    size_t sh = (size_t)height;
+    if (sw > (size_t)-1 / sh) return FALSE;
+
+    *outPixelCount = sw * sh;
+    return TRUE;
+}
+
+BOOL ClipTextBitmapToDestination(int x, int y,
+                                        int bitmapWidth, int bitmapHeight,
+                                        int destWidth, int destHeight,
+                                        TextBitmapClip* clip) {
+    if (!clip || bitmapWidth <= 0 || bitmapHeight <= 0 ||
+        destWidth <= 0 || destHeight <= 0) {
+        return FALSE;
+    }
+
+    long long left = (long long)x;
+    long long top = (long long)y;
+    long long right = left + (long long)bitmapWidth;
+    long long bottom = top + (long long)bitmapHeight;
+
+    if (right <= 0 || bottom <= 0 ||
+        left >= (long long)destWidth || top >= (long long)destHeight) {
+        return FALSE;
+    }
+
+    long long clipLeft = (left < 0) ? 0 : left;
+    long long clipTop = (top < 0) ? 0 : top;
+    long long clipRight = (right > (long long)destWidth) ? (long long)destWidth : right;
+    long long clipBottom = (bottom > (long long)destHeight) ? (long long)destHeight : bottom;
+    int rowTop = 0;
+    int rowBottom = destHeight;
+    DrawingEffect_ClipRows(&rowTop, &rowBottom);
+    if (clipTop < (long long)rowTop) clipTop = rowTop;
+    if (clipBottom > (long long)rowBottom) clipBottom = rowBottom;
+
+    if (clipLeft >= clipRight || clipTop >= clipBottom) {
+        return FALSE;
+    }
+
+    long long srcLeft = clipLeft - left;
+    long long srcTop = clipTop - top;
+    long long srcRight = clipRight - left;
+    long long srcBottom = clipBottom - top;
+
+    if (srcRight > (long long)bitmapWidth || srcBottom > (long long)bitmapHeight ||
+        srcLeft > (long long)INT_MAX || srcTop > (long long)INT_MAX ||
+        srcRight > (long long)INT_MAX || srcBottom > (long long)INT_MAX) {
+        return FALSE;
+    }
+
+    clip->srcLeft = (int)srcLeft;
+    clip->srcTop = (int)srcTop;
+    clip->srcRight = (int)srcRight;
+    clip->srcBottom = (int)srcBottom;
+    clip->destLeft = (int)clipLeft;
+    clip->destTop = (int)clipTop;
+    return TRUE;
+}
+
+int ClampTextInt64(long long value) {
+    if (value > (long long)INT_MAX) return INT_MAX;
+    if (value < (long long)INT_MIN) return INT_MIN;
+    return (int)value;
+}
+
+int AddTextIntClamped(int value, int delta) {
+    return ClampTextInt64((long long)value + (long long)delta);
+}
+
+int MulTextIntClamped(int value, int factor) {
+    return ClampTextInt64((long long)value * (long long)factor);
+}
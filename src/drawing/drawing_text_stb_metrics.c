@@ -10,6 +10,7 @@ void GetCharMetricsSTB(wchar_t c, wchar_t nextC, float scale, float fallbackScal
 
     out->index = 0;
     out->isFallback = FALSE;
+    out->fallbackSlot = 0;
     out->advance = 0;
     out->kern = 0;
 
@@ -37,19 +38,25 @@ void GetCharMetricsSTB(wchar_t c, wchar_t nextC, float scale, float fallbackScal
         cached->nextC = cacheNextC;
         cached->index = spaceIdx;
         cached->isFallback = FALSE;
+        cached->fallbackSlot = 0;
         cached->advanceUnits = adv * 4;
         cached->kernUnits = 0;
         ApplyCachedGlyphMetrics(cached, scale, fallbackScale, out);
         return;
     }
 
-    out->index = stbtt_FindGlyphIndex(&g_fontInfo, (int)c);
+    /* Coverage answers "not in this face" without searching its cmap */
+    if (FontCoverageContains(&g_fontCoverage, c)) {
+        out->index = stbtt_FindGlyphIndex(&g_fontInfo, (int)c);
+    }
 
-    if (out->index == 0 && g_fallbackFontLoaded && c != L' ') {
-        int fallbackIndex = stbtt_FindGlyphIndex(&g_fallbackFontInfo, (int)c);
+    if (out->index == 0 && c != L' ') {
+        int fallbackSlot = 0;
+        int fallbackIndex = FindFallbackGlyphLocked(c, &fallbackSlot);
         if (fallbackIndex != 0) {
             out->index = fallbackIndex;
             out->isFallback = TRUE;
+            out->fallbackSlot = fallbackSlot;
         }
     }
 
@@ -57,12 +64,13 @@ void GetCharMetricsSTB(wchar_t c, wchar_t nextC, float scale, float fallbackScal
     int lsb = 0;
     int kern = 0;
     if (out->isFallback) {
-        stbtt_GetGlyphHMetrics(&g_fallbackFontInfo, out->index, &adv, &lsb);
+        stbtt_GetGlyphHMetrics(&g_fallbackFonts[out->fallbackSlot].fontInfo,
+                               out->index, &adv, &lsb);
     } else {
         stbtt_GetGlyphHMetrics(&g_fontInfo, out->index, &adv, &lsb);
 
         // Kerning
-        if (cacheNextC) {
+        if (cacheNextC && FontCoverageContains(&g_fontCoverage, cacheNextC)) {
             int nextIdx = stbtt_FindGlyphIndex(&g_fontInfo, (int)cacheNextC);
             if (nextIdx != 0) {
                 kern = stbtt_GetGlyphKernAdvance(&g_fontInfo, out->index, nextIdx);
@@ -75,6 +83,7 @@ void GetCharMetricsSTB(wchar_t c, wchar_t nextC, float scale, float fallbackScal
     cached->nextC = cacheNextC;
     cached->index = out->index;
     cached->isFallback = out->isFallback;
+    cached->fallbackSlot = out->fallbackSlot;
     cached->advanceUnits = adv;
     cached->kernUnits = kern;
     ApplyCachedGlyphMetrics(cached, scale, fallbackScale, out);
@@ -88,6 +97,7 @@ BOOL GetCachedFontCharMetricsSTB(const stbtt_fontinfo* fontInfo,
 
     out->index = 0;
     out->isFallback = FALSE;
+    out->fallbackSlot = 0;
     out->advance = 0;
     out->kern = 0;
 
@@ -111,7 +121,9 @@ BOOL GetCachedFontCharMetricsSTB(const stbtt_fontinfo* fontInfo,
         return TRUE;
     }
 
-    int glyphIndex = stbtt_FindGlyphIndex(fontInfo, (int)c);
+    int glyphIndex = FontCoverageContains(&g_fontCacheCoverage[fontSlot], c)
+        ? stbtt_FindGlyphIndex(fontInfo, (int)c)
+        : 0;
     int advanceUnits = 0;
     if (glyphIndex != 0) {
         int lsb = 0;
@@ -4,6 +4,7 @@
  */
 
 #include "drawing_text_stb_internal.h"
+#include "drawing/drawing_effect_tiles.h"
 
 BOOL MeasureTextSTB(const wchar_t* text, int fontSize, int* width, int* height) {
     if (!BeginFontUseSTB()) return FALSE;
@@ -12,7 +13,7 @@ BOOL MeasureTextSTB(const wchar_t* text, int fontSize, int* width, int* height)
     if (!g_fontLoaded || !text) goto done;
 
     float scale = stbtt_ScaleForPixelHeight(&g_fontInfo, (float)fontSize);
-    float fallbackScale = g_fallbackFontLoaded ? stbtt_ScaleForPixelHeight(&g_fallbackFontInfo, (float)fontSize) : 0;
+    float fallbackScale = g_fallbackFontCount > 0 ? stbtt_ScaleForPixelHeight(&g_fallbackFonts[0].fontInfo, (float)fontSize) : 0;
 
     int maxWidth = 0;
     int curLineWidth = 0;
@@ -51,11 +52,12 @@ void RenderTextSTB(void* bits, int width, int height, const wchar_t* text,
                    COLORREF color, int fontSize, float fontScale, BOOL editMode) {
     UNREFERENCED_PARAMETER(editMode);
 
+    BOOL tiled = FALSE;
     if (!BeginFontUseSTB()) return;
     if (!g_fontLoaded || !text || !bits) goto done;
 
     float scale = stbtt_ScaleForPixelHeight(&g_fontInfo, (float)(fontSize * fontScale));
-    float fallbackScale = g_fallbackFontLoaded ? stbtt_ScaleForPixelHeight(&g_fallbackFontInfo, (float)(fontSize * fontScale)) : 0;
+    float fallbackScale = g_fallbackFontCount > 0 ? stbtt_ScaleForPixelHeight(&g_fallbackFonts[0].fontInfo, (float)(fontSize * fontScale)) : 0;
 
     int ascent, descent, lineGap;
     stbtt_GetFontVMetrics(&g_fontInfo, &ascent, &descent, &lineGap);
@@ -67,6 +69,9 @@ void RenderTextSTB(void* bits, int width, int height, const wchar_t* text,
     int b = GetBValue(color);
     EffectType effect = GetActiveEffect();
     int timeOffset = (int)GetTickCount();
+    /* Effect glyphs are recorded and drawn in parallel bands at the end */
+    tiled = effect != EFFECT_TYPE_NONE &&
+            DrawingEffectTiles_Begin((DWORD*)bits, width, height);
 
     // Pre-calculate line widths for centering
     // We can do a quick pass or re-use Measure logic per line
@@ -114,8 +119,9 @@ void RenderTextSTB(void* bits, int width, int height, const wchar_t* text,
                     int w, h, xoff, yoff;
                     unsigned char* bitmap = NULL;
 
-                    const stbtt_fontinfo* glyphFontInfo = gm.isFallback ? &g_fallbackFontInfo : &g_fontInfo;
-                    float glyphScale = gm.isFallback ? fallbackScale : scale;
+                    float glyphScale = scale;
+                    const stbtt_fontinfo* glyphFontInfo =
+                        GetGlyphFontInfoSTB(&gm, scale, fallbackScale, &glyphScale);
                     int glyphMargin = (effect != EFFECT_TYPE_NONE) ? 24 : 0;
                     bitmap = CreateVisibleGlyphBitmapSTB(glyphFontInfo, gm.index,
                                                          glyphScale, glyphScale,
@@ -143,6 +149,7 @@ void RenderTextSTB(void* bits, int width, int height, const wchar_t* text,
     }
 
 done:
+    if (tiled) DrawingEffectTiles_End();
     EndFontUseSTB();
 }
 
@@ -14,19 +14,19 @@ DWORD g_currentFontLastValidateTick = 0;
 BOOL g_currentFontFileInfoValid = FALSE;
 BOOL g_fontLoaded = FALSE;
 
-unsigned char* g_fallbackFontBuffer = NULL;
-stbtt_fontinfo g_fallbackFontInfo;
-BOOL g_fallbackFontLoaded = FALSE;
+FontCoverage g_fontCoverage = {0};
+
+FallbackFont g_fallbackFonts[MAX_FALLBACK_FONTS] = {0};
+int g_fallbackFontCount = 0;
 
 HANDLE g_hFontFile = INVALID_HANDLE_VALUE;
 HANDLE g_hFontMapping = NULL;
-HANDLE g_hFallbackFontFile = INVALID_HANDLE_VALUE;
-HANDLE g_hFallbackFontMapping = NULL;
 volatile LONG g_fontStateGeneration = 1;
 
 CachedFont g_fontCache[MAX_CACHED_FONTS] = {0};
 int g_fontCacheLRU[MAX_CACHED_FONTS] = {0};
 int g_fontCacheAccessCounter = 0;
+FontCoverage g_fontCacheCoverage[MAX_CACHED_FONTS] = {0};
 FontTagGlyphMetricsCacheEntry
     g_fontTagGlyphMetricsCache[MAX_CACHED_FONTS][FONT_TAG_GLYPH_METRICS_CACHE_SIZE] = {0};
 FailedFontCacheEntry g_failedFontCache[MAX_FAILED_FONT_CACHE] = {0};
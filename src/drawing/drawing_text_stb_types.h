@@ -20,6 +20,11 @@
 #define GLYPH_METRICS_CACHE_SIZE 512
 #define GLYPH_BITMAP_CACHE_SIZE 32
 #define GLYPH_BITMAP_CACHE_MAX_BYTES (256u * 1024u)
+#define MAX_FALLBACK_FONTS 4
+#define FONT_COVERAGE_PAGE_COUNT 256
+#define FONT_COVERAGE_PAGE_WORDS 8
+#define FONT_COVERAGE_EMPTY_PAGE 0
+#define FONT_COVERAGE_FULL_PAGE 1
 
 typedef struct {
     BOOL valid;
@@ -33,12 +38,38 @@ typedef struct {
     DWORD retryAfterFailureTick;
 } FailedFontCacheEntry;
 
+/**
+ * @brief Which BMP code points a font's cmap maps to a glyph.
+ *
+ * Text is UTF-16, so only the BMP is indexed. Each 256-code-point page is
+ * empty, full, or an index (offset by 2) into deduplicated 256-bit blocks.
+ * An invalid index answers TRUE for everything so callers fall back to
+ * probing the font.
+ */
+typedef struct {
+    BOOL valid;
+    WORD pages[FONT_COVERAGE_PAGE_COUNT];
+    DWORD* blocks;
+    int blockCount;
+} FontCoverage;
+
+/** @brief One link of the fallback chain, tried in load order. */
+typedef struct {
+    unsigned char* buffer;
+    HANDLE hFile;
+    HANDLE hMapping;
+    stbtt_fontinfo fontInfo;
+    float scaleRatio;  /* Scale relative to the first link's fallbackScale */
+    FontCoverage coverage;
+} FallbackFont;
+
 typedef struct {
     BOOL valid;
     wchar_t c;
     wchar_t nextC;
     int index;
     BOOL isFallback;
+    int fallbackSlot;
     int advanceUnits;
     int kernUnits;
 } GlyphMetricsCacheEntry;
@@ -80,6 +111,9 @@ typedef struct {
     int endR;
     int endG;
     int endB;
+    /* Optional precomputed row; columns outside it are computed directly */
+    const COLORREF* scanline;
+    int scanlineWidth;
 } GlowGradientContext;
 
 #endif /* DRAWING_TEXT_STB_TYPES_H */
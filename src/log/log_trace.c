@@ -0,0 +1,292 @@
+/**
+ * @file log_trace.c
+ * @brief Per-thread span buffers and Chrome trace_event export
+ *
+ * A thread claims a buffer slot with one interlocked increment on its first
+ * span and afterwards only writes its own buffer. The event count is
+ * published after the event is filled, and the end timestamp is stored
+ * atomically, so the exporter can read while threads keep recording.
+ * Buffers are never freed: a worker that outlives shutdown may still be
+ * writing to its own, so they are left for process exit to reclaim.
+ */
+
+#include "log/log_trace.h"
+#ifdef CATIME_USE_WIN32_FLS
+#include "utils/thread_local_buffer.h"
+#endif
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_JSON_CHUNK 4096
+
+typedef struct {
+    const char* name;
+    LONGLONG begin;
+    volatile LONGLONG end;  /**< 0 while the span is open */
+    BOOL instant;
+} TraceEvent;
+
+typedef struct {
+    DWORD threadId;
+    const char* volatile threadName;
+    volatile LONG count;
+    volatile LONG dropped;
+    TraceEvent events[TRACE_SPAN_MAX_EVENTS_PER_THREAD];
+} TraceThreadBuffer;
+
+static volatile LONG g_traceEnabled = 0;
+static volatile LONG g_traceShutDown = 0;
+static volatile LONG g_traceSession = 0;
+static volatile LONG g_traceThreadCount = 0;
+static TraceThreadBuffer* volatile g_traceThreads[TRACE_SPAN_MAX_THREADS];
+static LARGE_INTEGER g_traceEpoch;
+static LARGE_INTEGER g_traceFrequency;
+
+typedef struct {
+    TraceThreadBuffer* buffer;
+    LONG session;
+} TraceThreadState;
+
+#if defined(CATIME_USE_WIN32_FLS)
+static ThreadLocalBuffer g_traceThreadStorage =
+    THREAD_LOCAL_BUFFER_STATIC_INIT(sizeof(TraceThreadState));
+#elif defined(_MSC_VER)
+__declspec(thread) static TraceThreadState t_traceState;
+#elif defined(__GNUC__)
+static __thread TraceThreadState t_traceState;
+#else
+#error "log_trace.c requires compiler thread-local storage"
+#endif
+
+/* NULL only when fiber-local storage cannot be allocated; spans are skipped */
+static TraceThreadState* GetThreadState(void) {
+#if defined(CATIME_USE_WIN32_FLS)
+    return (TraceThreadState*)ThreadLocalBuffer_Get(&g_traceThreadStorage);
+#else
+    return &t_traceState;
+#endif
+}
+
+static LONGLONG TraceNow(void) {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    /* 0 marks an open span, so never hand out a zero timestamp. */
+    return now.QuadPart != 0 ? now.QuadPart : 1;
+}
+
+BOOL TraceSpan_Enable(void) {
+    if (InterlockedCompareExchange(&g_traceShutDown, 0, 0)) return FALSE;
+    if (InterlockedCompareExchange(&g_traceEnabled, 0, 0)) return TRUE;
+    if (!QueryPerformanceFrequency(&g_traceFrequency) ||
+        g_traceFrequency.QuadPart <= 0) {
+        return FALSE;
+    }
+    QueryPerformanceCounter(&g_traceEpoch);
+    InterlockedIncrement(&g_traceSession);
+    InterlockedExchange(&g_traceEnabled, 1);
+    return TRUE;
+}
+
+BOOL TraceSpan_IsEnabled(void) {
+    return g_traceEnabled != 0;
+}
+
+static TraceThreadBuffer* GetThreadBuffer(void) {
+    TraceThreadState* state = GetThreadState();
+    if (!state) return NULL;
+    LONG session = g_traceSession;
+    if (state->session == session) return state->buffer;
+    /* Never register after shutdown, which bumps the session */
+    if (!g_traceEnabled) return NULL;
+
+    state->session = session;
+    state->buffer = NULL;
+    LONG slot = InterlockedIncrement(&g_traceThreadCount) - 1;
+    if (slot >= TRACE_SPAN_MAX_THREADS) return NULL;
+
+    TraceThreadBuffer* buffer = (TraceThreadBuffer*)calloc(1, sizeof(*buffer));
+    if (!buffer) return NULL;
+    buffer->threadId = GetCurrentThreadId();
+    InterlockedExchangePointer((PVOID volatile*)&g_traceThreads[slot], buffer);
+    state->buffer = buffer;
+    return buffer;
+}
+
+void TraceSpan_NameThread(const char* name) {
+    if (!g_traceEnabled || !name) return;
+    TraceThreadBuffer* buffer = GetThreadBuffer();
+    if (buffer) buffer->threadName = name;
+}
+
+static int AppendEvent(const char* name, BOOL instant) {
+    TraceThreadBuffer* buffer = GetThreadBuffer();
+    if (!buffer || !g_traceEnabled) return -1;
+    LONG index = buffer->count;
+    if (index >= TRACE_SPAN_MAX_EVENTS_PER_THREAD) {
+        InterlockedIncrement(&buffer->dropped);
+        return -1;
+    }
+    TraceEvent* event = &buffer->events[index];
+    event->name = name;
+    event->instant = instant;
+    event->begin = TraceNow();
+    event->end = instant ? event->begin : 0;
+    InterlockedExchange(&buffer->count, index + 1);
+    return (int)index;
+}
+
+int TraceSpan_Begin(const char* name) {
+    if (!g_traceEnabled || !name) return -1;
+    return AppendEvent(name, FALSE);
+}
+
+void TraceSpan_End(int token) {
+    if (token < 0 || !g_traceEnabled) return;
+    const TraceThreadState* state = GetThreadState();
+    TraceThreadBuffer* buffer = state && state->session == g_traceSession ? state->buffer : NULL;
+    if (!buffer || token >= buffer->count) return;
+    InterlockedExchange64(&buffer->events[token].end, TraceNow());
+}
+
+void TraceSpan_Instant(const char* name) {
+    if (!g_traceEnabled || !name) return;
+    (void)AppendEvent(name, TRUE);
+}
+
+typedef struct {
+    HANDLE file;
+    char data[TRACE_JSON_CHUNK];
+    size_t used;
+    BOOL failed;
+} TraceWriter;
+
+static void WriterFlush(TraceWriter* writer) {
+    if (writer->failed || writer->used == 0) return;
+    DWORD written = 0;
+    if (!WriteFile(writer->file, writer->data, (DWORD)writer->used, &written, NULL) ||
+        written != (DWORD)writer->used) {
+        writer->failed = TRUE;
+    }
+    writer->used = 0;
+}
+
+static void WriterPut(TraceWriter* writer, const char* text, size_t length) {
+    while (length > 0 && !writer->failed) {
+        size_t room = sizeof(writer->data) - writer->used;
+        size_t chunk = length < room ? length : room;
+        memcpy(writer->data + writer->used, text, chunk);
+        writer->used += chunk;
+        text += chunk;
+        length -= chunk;
+        if (writer->used == sizeof(writer->data)) WriterFlush(writer);
+    }
+}
+
+static void WriterPrintf(TraceWriter* writer, const char* format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int length = _vsnprintf_s(line, sizeof(line), _TRUNCATE, format, args);
+    va_end(args);
+    if (length > 0) WriterPut(writer, line, (size_t)length);
+}
+
+static void WriterPutJsonString(TraceWriter* writer, const char* text) {
+    WriterPut(writer, "\"", 1);
+    for (const char* p = text; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\') {
+            char escaped[2] = {'\\', (char)c};
+            WriterPut(writer, escaped, 2);
+        } else if (c < 0x20) {
+            WriterPrintf(writer, "\\u%04x", c);
+        } else {
+            WriterPut(writer, p, 1);
+        }
+    }
+    WriterPut(writer, "\"", 1);
+}
+
+static double TicksToMicroseconds(LONGLONG ticks) {
+    return (double)ticks * 1000000.0 / (double)g_traceFrequency.QuadPart;
+}
+
+static void WriteThreadEvents(TraceWriter* writer, const TraceThreadBuffer* buffer,
+                              DWORD pid, BOOL* first) {
+    if (buffer->threadName) {
+        WriterPrintf(writer, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lu,"
+                     "\"tid\":%lu,\"args\":{\"name\":", *first ? "" : ",\n",
+                     pid, buffer->threadId);
+        WriterPutJsonString(writer, buffer->threadName);
+        WriterPut(writer, "}}", 2);
+        *first = FALSE;
+    }
+
+    LONG count = InterlockedCompareExchange((volatile LONG*)&buffer->count, 0, 0);
+    for (LONG i = 0; i < count; i++) {
+        const TraceEvent* event = &buffer->events[i];
+        LONGLONG end = InterlockedCompareExchange64(
+            (volatile LONGLONG*)&event->end, 0, 0);
+        if (end == 0) continue;
+
+        WriterPrintf(writer, "%s{\"name\":", *first ? "" : ",\n");
+        WriterPutJsonString(writer, event->name);
+        double ts = TicksToMicroseconds(event->begin - g_traceEpoch.QuadPart);
+        if (event->instant) {
+            WriterPrintf(writer, ",\"ph\":\"i\",\"s\":\"p\",\"pid\":%lu,\"tid\":%lu,"
+                         "\"ts\":%.3f}", pid, buffer->threadId, ts);
+        } else {
+            double dur = TicksToMicroseconds(end - event->begin);
+            WriterPrintf(writer, ",\"ph\":\"X\",\"pid\":%lu,\"tid\":%lu,"
+                         "\"ts\":%.3f,\"dur\":%.3f}", pid, buffer->threadId, ts, dur);
+        }
+        *first = FALSE;
+    }
+}
+
+BOOL TraceSpan_WriteChromeTrace(const wchar_t* path) {
+    if (!path || !*path || g_traceFrequency.QuadPart <= 0) return FALSE;
+
+    TraceWriter* writer = (TraceWriter*)calloc(1, sizeof(*writer));
+    if (!writer) return FALSE;
+    writer->file = CreateFileW(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (writer->file == INVALID_HANDLE_VALUE) {
+        free(writer);
+        return FALSE;
+    }
+
+    DWORD pid = GetCurrentProcessId();
+    BOOL first = TRUE;
+    LONG dropped = 0;
+    LONG threads = InterlockedCompareExchange(&g_traceThreadCount, 0, 0);
+    if (threads > TRACE_SPAN_MAX_THREADS) threads = TRACE_SPAN_MAX_THREADS;
+
+    WriterPrintf(writer, "{\"traceEvents\":[\n");
+    for (LONG i = 0; i < threads; i++) {
+        const TraceThreadBuffer* buffer = g_traceThreads[i];
+        if (!buffer) continue;
+        WriteThreadEvents(writer, buffer, pid, &first);
+        dropped += buffer->dropped;
+    }
+    WriterPrintf(writer, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":"
+                 "{\"droppedSpans\":%ld}}\n", dropped);
+    WriterFlush(writer);
+
+    BOOL ok = !writer->failed;
+    CloseHandle(writer->file);
+    free(writer);
+    if (!ok) DeleteFileW(path);
+    return ok;
+}
+
+void TraceSpan_Shutdown(void) {
+    InterlockedExchange(&g_traceShutDown, 1);
+    InterlockedExchange(&g_traceEnabled, 0);
+    /* Cached buffers go stale; a writer past its enabled check finishes
+     * into memory that stays valid. */
+    InterlockedIncrement(&g_traceSession);
+}
@@ -1,14 +1,19 @@
 #include "main/main_initialization.h"
 #include "main_initialization_internal.h"
 #include "log.h"
+#include "log/log_trace.h"
+#include "config/config_core_api.h"
 #include "timer/timer_events.h"
 #include "window/window_desktop_integration.h"
 #include "../../resource/resource.h"
 
+#include <shellapi.h>
 #include <stdlib.h>
 #include <wchar.h>
 
 #define STARTUP_WINDOW_RECOVERY_DELAY_MS 2000
+#define STARTUP_TRACE_FLAG L"--trace-startup"
+#define STARTUP_TRACE_FILENAME L"catime_trace.json"
 
 static int s_ciSmokeExitCode = 0;
 
@@ -69,6 +74,59 @@ int Main_GetCiSmokeExitCode(void) {
     return s_ciSmokeExitCode;
 }
 
+void Main_ConfigureStartupTrace(void) {
+    if (!IsCiSmokeMode() && !ContainsFlag(GetCommandLineW(), STARTUP_TRACE_FLAG)) {
+        return;
+    }
+    if (TraceSpan_Enable()) {
+        TraceSpan_NameThread("main");
+    }
+}
+
+/** @brief --trace-startup=<path> wins; otherwise the trace sits next to config.ini */
+static BOOL ResolveStartupTracePath(wchar_t* path, size_t pathSize) {
+    int argumentCount = 0;
+    LPWSTR* arguments = CommandLineToArgvW(GetCommandLineW(), &argumentCount);
+    if (arguments) {
+        size_t flagLength = wcslen(STARTUP_TRACE_FLAG);
+        for (int i = 1; i < argumentCount; i++) {
+            if (wcsncmp(arguments[i], STARTUP_TRACE_FLAG, flagLength) == 0 &&
+                arguments[i][flagLength] == L'=' && arguments[i][flagLength + 1]) {
+                wcsncpy_s(path, pathSize, arguments[i] + flagLength + 1, _TRUNCATE);
+                LocalFree(arguments);
+                return TRUE;
+            }
+        }
+        LocalFree(arguments);
+    }
+
+    char configPath[MAX_PATH] = {0};
+    GetConfigPath(configPath, MAX_PATH);
+    wchar_t configDir[MAX_PATH];
+    if (!configPath[0] ||
+        MultiByteToWideChar(CP_UTF8, 0, configPath, -1, configDir, MAX_PATH) <= 0) {
+        return FALSE;
+    }
+    wchar_t* slash = wcsrchr(configDir, L'\\');
+    if (!slash) return FALSE;
+    *slash = L'\0';
+    int written = _snwprintf_s(path, pathSize, _TRUNCATE, L"%s\\%s",
+                               configDir, STARTUP_TRACE_FILENAME);
+    return written >= 0 && (size_t)written < pathSize;
+}
+
+void Main_WriteStartupTrace(void) {
+    if (!TraceSpan_IsEnabled()) return;
+    wchar_t path[MAX_PATH];
+    if (!ResolveStartupTracePath(path, MAX_PATH)) {
+        LOG_WARNING("Startup trace path could not be resolved");
+    } else if (TraceSpan_WriteChromeTrace(path)) {
+        LOG_INFO("Startup trace written: %ls", path);
+    } else {
+        LOG_WARNING("Failed to write startup trace (error=%lu)", GetLastError());
+    }
+}
+
 void Main_ScheduleStartupWindowRecovery(HWND hwnd, BOOL topmost) {
     UINT timerId = topmost ? TIMER_ID_TOPMOST_RETRY : TIMER_ID_VISIBILITY_RETRY;
     if (!SetTimer(hwnd, timerId, STARTUP_WINDOW_RECOVERY_DELAY_MS, NULL)) {
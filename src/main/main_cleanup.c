@@ -1,4 +1,5 @@
 #include "main/main_initialization.h"
+#include "main_initialization_internal.h"
 #include "async_update_checker.h"
 #include "audio_player.h"
 #include "config.h"
@@ -6,12 +7,14 @@
 #include "config/config_watcher.h"
 #include "dialog/dialog_font_picker.h"
 #include "dialog/dialog_notification_audio.h"
+#include "drawing/drawing_dib_pool.h"
 #include "drawing/drawing_effect.h"
 #include "drawing/drawing_image.h"
 #include "drawing/drawing_render.h"
 #include "font.h"
 #include "language.h"
 #include "log.h"
+#include "log/log_trace.h"
 #include "markdown/markdown_interactive.h"
 #include "notification.h"
 #include "plugin/plugin_data.h"
@@ -25,7 +28,7 @@ void CleanupResources(void) {
     CleanupMarkdownInteractive();
     CleanupDrawingRenderCache();
     CleanupDrawingEffects();
-    StopNotificationSound();
+    ShutdownAudioPlayer();
     CleanupNotificationResources();
     CleanupUpdateThreadBlocking();
     CleanupUpdateCheckResources();
@@ -41,11 +44,14 @@ void CleanupResources(void) {
     CleanupPluginTrustCS();
     ShutdownDrawingImage();
     ShutdownWindowVisualEffects();
+    DibPool_Shutdown();
     if (ConfigWatcher_Shutdown()) {
         ShutdownIniCache();
     } else {
         LOG_WARNING("Config watcher did not stop; INI cache retained");
     }
+    Main_WriteStartupTrace();
+    TraceSpan_Shutdown();
     CleanupLanguage();
     CoUninitialize();
     CleanupLogSystem();
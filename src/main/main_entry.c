@@ -9,6 +9,7 @@
 #include "main_initialization_internal.h"
 #include "window.h"
 #include "log.h"
+#include "log/log_trace.h"
 #include "config.h"
 #include "startup.h"
 
@@ -31,7 +32,13 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     (void)hPrevInstance;
     (void)lpCmdLine;
 
-    if (!InitializeSubsystems()) {
+    Main_ConfigureStartupTrace();
+    TRACE_SPAN_BEGIN(startupSpan, "Startup");
+    TRACE_SPAN_BEGIN(subsystemsSpan, "InitializeSubsystems");
+    BOOL subsystemsReady = InitializeSubsystems();
+    TRACE_SPAN_END(subsystemsSpan);
+    if (!subsystemsReady) {
+        TraceSpan_Shutdown();
         return 1;
     }
 
@@ -39,7 +46,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         LOG_WARNING("Could not repair the existing startup shortcut before startup");
     }
 
-    if (!InitializeApplicationSubsystem(hInstance)) {
+    TRACE_SPAN_BEGIN(applicationSpan, "InitializeApplicationSubsystem");
+    BOOL applicationReady = InitializeApplicationSubsystem(hInstance);
+    TRACE_SPAN_END(applicationSpan);
+    if (!applicationReady) {
         CleanupResources();
         return 1;
     }
@@ -50,7 +60,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     InitializeDialogLanguages();
 
     LOG_INFO("Starting main window creation...");
+    TRACE_SPAN_BEGIN(windowSpan, "CreateMainWindow");
     HWND hwnd = CreateMainWindow(hInstance, nCmdShow);
+    TRACE_SPAN_END(windowSpan);
     if (!hwnd) {
         LOG_ERROR("Main window creation failed. Application cannot continue. Check log file for details.");
         CleanupResources();
@@ -58,7 +70,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     }
     LOG_INFO("Main window creation successful, handle: 0x%p", hwnd);
 
-    if (!SetupMainWindow(hInstance, hwnd, nCmdShow)) {
+    TRACE_SPAN_BEGIN(setupSpan, "SetupMainWindow");
+    BOOL setupReady = SetupMainWindow(hInstance, hwnd, nCmdShow);
+    TRACE_SPAN_END(setupSpan);
+    TRACE_SPAN_END(startupSpan);
+    if (!setupReady) {
         DestroyWindow(hwnd);
         CleanupResources();
         return 0;
@@ -7,8 +7,10 @@
 #include "dialog/dialog_common.h"
 #include "dialog/dialog_language.h"
 #include "dialog/dialog_notification_audio.h"
+#include "drawing/drawing_render_metrics.h"
 #include "drawing/drawing_timer_precision.h"
 #include "log.h"
+#include "log/log_trace.h"
 #include "markdown/markdown_interactive.h"
 #include "plugin/plugin_data.h"
 #include "plugin/plugin_manager.h"
@@ -96,7 +98,9 @@ void HandleStartupMode(HWND hwnd) {
 
 BOOL InitializeSubsystems(void) {
     InitCommonControls();
+    TRACE_SPAN_BEGIN(logSpan, "InitializeLogSystem");
     (void)InitializeLogSystem();
+    TRACE_SPAN_END(logSpan);
     SetupExceptionHandler();
     Main_DropPrivileges();
     if (!InitDWMFunctions()) {
@@ -117,10 +121,14 @@ BOOL InitializeApplicationSubsystem(HINSTANCE hInstance) {
     InitializeAppConfigDefaults();
     InitMarkdownInteractive();
     PluginManager_Init();
-    if (!InitializeApplication(hInstance)) {
+    TRACE_SPAN_BEGIN(applicationSpan, "InitializeApplication");
+    BOOL initialized = InitializeApplication(hInstance);
+    TRACE_SPAN_END(applicationSpan);
+    if (!initialized) {
         LOG_ERROR("Application initialization failed");
         return FALSE;
     }
+    RenderMetrics_LoadConfig();
     LOG_INFO("Application initialization completed");
     return TRUE;
 }
@@ -139,6 +147,7 @@ void InitializeDialogLanguages(void) {
 }
 
 static void InitializeAsyncCaches(HWND hwnd) {
+    TRACE_SPAN_BEGIN(cachesSpan, "InitializeAsyncCaches");
     PluginData_Init(hwnd);
     PluginManager_SetNotifyWindow(hwnd);
     PluginManager_RequestScanAsync();
@@ -148,6 +157,7 @@ static void InitializeAsyncCaches(HWND hwnd) {
     FontMenu_RequestScanAsync();
     NotificationSoundCache_Initialize();
     NotificationSoundCache_RequestScanAsync();
+    TRACE_SPAN_END(cachesSpan);
 }
 
 static BOOL HandleCommandLine(HWND hwnd, BOOL* launchedFromStartup) {
@@ -7,11 +7,14 @@
 #include <wchar.h>
 #include <shellapi.h>
 #define CATIME_MAIN_WINDOW_CLASS_NAME L"CatimeWindowClass"
+/* Regions of the frame being rendered; written under g_interactiveCS */
 static ClickableRegion g_regions[MAX_CLICKABLE_REGIONS];
 static int g_regionCount = 0;
-static volatile LONG g_regionCountVisible = 0;
-static int g_windowOffsetX = 0;
-static int g_windowOffsetY = 0;
+static BOOL g_regionsDirty = FALSE;
+/* Index of the last rendered frame; readers pin it instead of locking */
+static ClickableRegionIndex* volatile g_publishedIndex = NULL;
+static volatile LONG g_indexReaders = 0;
+static volatile LONG64 g_windowOffset = 0;
 static CRITICAL_SECTION g_interactiveCS;
 static volatile LONG g_initialized = 0;
 static SRWLOCK g_interactiveLifecycleLock = SRWLOCK_INIT;
@@ -55,7 +58,31 @@ static void ClearClickableRegionsLocked(void) {
     }
     ZeroMemory(g_regions, sizeof(g_regions));
     g_regionCount = 0;
-    InterlockedExchange(&g_regionCountVisible, 0);
+    g_regionsDirty = TRUE;
+}
+static const ClickableRegionIndex* PinPublishedIndex(void) {
+    InterlockedIncrement(&g_indexReaders);
+    return (const ClickableRegionIndex*)InterlockedCompareExchangePointer(
+        (PVOID volatile*)&g_publishedIndex, NULL, NULL);
+}
+static void UnpinPublishedIndex(void) {
+    InterlockedDecrement(&g_indexReaders);
+}
+/* Readers pin before loading the pointer, so once the count drains no one
+ * can still hold the retired index. */
+static void ReplacePublishedIndexLocked(ClickableRegionIndex* next) {
+    ClickableRegionIndex* retired = (ClickableRegionIndex*)InterlockedExchangePointer(
+        (PVOID volatile*)&g_publishedIndex, next);
+    if (!retired) return;
+    while (InterlockedCompareExchange(&g_indexReaders, 0, 0) != 0) {
+        SwitchToThread();
+    }
+    MarkdownInteractive_FreeIndex(retired);
+}
+static POINT ToLocalPoint(POINT pt) {
+    ULONGLONG offset = (ULONGLONG)InterlockedCompareExchange64(&g_windowOffset, 0, 0);
+    POINT localPt = { pt.x - (LONG)(DWORD)(offset >> 32), pt.y - (LONG)(DWORD)offset };
+    return localPt;
 }
 void InitMarkdownInteractive(void) {
     AcquireSRWLockExclusive(&g_interactiveLifecycleLock);
@@ -67,9 +94,8 @@ void InitMarkdownInteractive(void) {
     if (InterlockedCompareExchange(&g_initialized, INTERACTIVE_CS_INITIALIZING, INTERACTIVE_CS_UNINITIALIZED) == INTERACTIVE_CS_UNINITIALIZED) {
         InitializeCriticalSection(&g_interactiveCS);
         g_regionCount = 0;
-        g_windowOffsetX = 0;
-        g_windowOffsetY = 0;
-        InterlockedExchange(&g_regionCountVisible, 0);
+        g_regionsDirty = FALSE;
+        InterlockedExchange64(&g_windowOffset, 0);
         InterlockedExchange(&g_initialized, INTERACTIVE_CS_INITIALIZED);
     }
     ReleaseSRWLockExclusive(&g_interactiveLifecycleLock);
@@ -82,6 +108,7 @@ void CleanupMarkdownInteractive(void) {
     }
     EnterCriticalSection(&g_interactiveCS);
     ClearClickableRegionsLocked();
+    ReplacePublishedIndexLocked(NULL);
     LeaveCriticalSection(&g_interactiveCS);
     DeleteCriticalSection(&g_interactiveCS);
     InterlockedExchange(&g_initialized, INTERACTIVE_CS_UNINITIALIZED);
@@ -115,7 +142,7 @@ void AddLinkRegion(const RECT* rect, const wchar_t* url) {
         r->checkboxIndex = -1;
         r->isChecked = FALSE;
         g_regionCount++;
-        InterlockedExchange(&g_regionCountVisible, g_regionCount);
+        g_regionsDirty = TRUE;
     }
     LeaveCriticalSection(&g_interactiveCS);
     EndInteractiveUse();
@@ -136,71 +163,49 @@ void AddCheckboxRegion(const RECT* rect, int index, BOOL isChecked) {
         r->checkboxIndex = index;
         r->isChecked = isChecked;
         g_regionCount++;
-        InterlockedExchange(&g_regionCountVisible, g_regionCount);
+        g_regionsDirty = TRUE;
     }
     LeaveCriticalSection(&g_interactiveCS);
     EndInteractiveUse();
 }
-void UpdateRegionPositions(int windowX, int windowY) {
+void PublishClickableRegions(void) {
     if (!BeginInteractiveUse()) return;
     EnterCriticalSection(&g_interactiveCS);
-    if (g_windowOffsetX == windowX && g_windowOffsetY == windowY) {
-        LeaveCriticalSection(&g_interactiveCS);
-        EndInteractiveUse();
-        return;
+    if (g_regionsDirty) {
+        g_regionsDirty = FALSE;
+        /* An unchanged layout keeps its index; only new geometry rebuilds */
+        const ClickableRegionIndex* current = (const ClickableRegionIndex*)g_publishedIndex;
+        if (!MarkdownInteractive_IndexMatches(current, g_regions, g_regionCount)) {
+            ReplacePublishedIndexLocked(MarkdownInteractive_BuildIndex(g_regions, g_regionCount));
+        }
     }
-    g_windowOffsetX = windowX;
-    g_windowOffsetY = windowY;
     LeaveCriticalSection(&g_interactiveCS);
     EndInteractiveUse();
 }
-static BOOL CopyClickableRegionAtLocked(POINT localPt, ClickableRegion* outRegion) {
-    if (!outRegion) return FALSE;
-    for (int i = 0; i < g_regionCount; i++) {
-        if (PtInRect(&g_regions[i].rect, localPt)) {
-            *outRegion = g_regions[i];
-            if (g_regions[i].url) {
-                outRegion->url = _wcsdup(g_regions[i].url);
-                if (!outRegion->url) {
-                    return FALSE;
-                }
-            }
-            return TRUE;
-        }
-    }
-    return FALSE;
+void UpdateRegionPositions(int windowX, int windowY) {
+    ULONGLONG offset = ((ULONGLONG)(DWORD)windowX << 32) | (DWORD)windowY;
+    InterlockedExchange64(&g_windowOffset, (LONG64)offset);
 }
 BOOL IsClickableRegionAt(POINT pt) {
     if (!BeginInteractiveUse()) return FALSE;
-    if (InterlockedCompareExchange(&g_regionCountVisible, 0, 0) <= 0) {
-        EndInteractiveUse();
-        return FALSE;
-    }
-    BOOL result = FALSE;
-    EnterCriticalSection(&g_interactiveCS);
-    POINT localPt = { pt.x - g_windowOffsetX, pt.y - g_windowOffsetY };
-    for (int i = 0; i < g_regionCount; i++) {
-        if (PtInRect(&g_regions[i].rect, localPt)) {
-            result = TRUE;
-            break;
-        }
-    }
-    LeaveCriticalSection(&g_interactiveCS);
+    const ClickableRegionIndex* index = PinPublishedIndex();
+    BOOL result = index && MarkdownInteractive_FindRegion(index, ToLocalPoint(pt)) != NULL;
+    UnpinPublishedIndex();
     EndInteractiveUse();
     return result;
 }
 BOOL HandleRegionClickAt(POINT pt, HWND hwnd) {
     if (!BeginInteractiveUse()) return FALSE;
-    if (InterlockedCompareExchange(&g_regionCountVisible, 0, 0) <= 0) {
-        EndInteractiveUse();
-        return FALSE;
-    }
     ClickableRegion region = {0};
     BOOL found = FALSE;
-    EnterCriticalSection(&g_interactiveCS);
-    POINT localPt = { pt.x - g_windowOffsetX, pt.y - g_windowOffsetY };
-    found = CopyClickableRegionAtLocked(localPt, &region);
-    LeaveCriticalSection(&g_interactiveCS);
+    const ClickableRegionIndex* index = PinPublishedIndex();
+    const ClickableRegion* hit = index ? MarkdownInteractive_FindRegion(index, ToLocalPoint(pt)) : NULL;
+    if (hit) {
+        region = *hit;
+        region.url = hit->url ? _wcsdup(hit->url) : NULL;
+        found = !hit->url || region.url;
+    }
+    UnpinPublishedIndex();
     EndInteractiveUse();
     if (!found) {
         return FALSE;
@@ -213,35 +218,20 @@ BOOL HandleRegionClickAt(POINT pt, HWND hwnd) {
 }
 BOOL HasClickableRegions(void) {
     if (!BeginInteractiveUse()) return FALSE;
-    BOOL hasRegions = InterlockedCompareExchange(&g_regionCountVisible, 0, 0) > 0;
+    BOOL hasRegions = InterlockedCompareExchangePointer(
+        (PVOID volatile*)&g_publishedIndex, NULL, NULL) != NULL;
     EndInteractiveUse();
     return hasRegions;
 }
 void FillClickableRegionsAlpha(DWORD* pixels, int width, int height) {
     if (!pixels) return;
-    if (!BeginInteractiveUse()) return;
-    if (InterlockedCompareExchange(&g_regionCountVisible, 0, 0) <= 0) {
-        EndInteractiveUse();
-        return;
-    }
     if (width <= 0 || height <= 0 || (size_t)width > ((size_t)-1) / (size_t)height / sizeof(DWORD)) {
-        EndInteractiveUse();
         return;
     }
-    RECT regions[MAX_CLICKABLE_REGIONS];
-    int regionCount = 0;
-    EnterCriticalSection(&g_interactiveCS);
-    regionCount = g_regionCount;
-    if (regionCount > MAX_CLICKABLE_REGIONS) {
-        regionCount = MAX_CLICKABLE_REGIONS;
-    }
-    for (int i = 0; i < regionCount; i++) {
-        regions[i] = g_regions[i].rect;
-    }
-    LeaveCriticalSection(&g_interactiveCS);
-    EndInteractiveUse();
-    for (int i = 0; i < regionCount; i++) {
-        RECT* r = &regions[i];
+    if (!BeginInteractiveUse()) return;
+    const ClickableRegionIndex* index = PinPublishedIndex();
+    for (int i = 0; index && i < index->regionCount; i++) {
+        const RECT* r = &index->regions[i].rect;
         int left = r->left < 0 ? 0 : r->left;
         int top = r->top < 0 ? 0 : r->top;
         int right = r->right > width ? width : r->right;
@@ -250,14 +240,16 @@ void FillClickableRegionsAlpha(DWORD* pixels, int width, int height) {
             continue;
         }
         for (int y = top; y < bottom; y++) {
+            DWORD* row = &pixels[(size_t)y * (size_t)width];
             for (int x = left; x < right; x++) {
-                DWORD* pixel = &pixels[(size_t)y * (size_t)width + (size_t)x];
-                if ((*pixel & 0xFF000000) == 0) {
-                    *pixel = 0x01000000;  /* Minimal alpha, invisible */
+                if ((row[x] & 0xFF000000) == 0) {
+                    row[x] = 0x01000000;  /* Minimal alpha, invisible */
                 }
             }
         }
     }
+    UnpinPublishedIndex();
+    EndInteractiveUse();
 }
 static BOOL HandleRegionClick(const ClickableRegion* region, HWND hwnd) {
     if (!region) return FALSE;
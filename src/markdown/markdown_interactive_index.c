@@ -0,0 +1,195 @@
+/**
+ * @file markdown_interactive_index.c
+ * @brief Uniform-grid spatial index over Markdown clickable regions.
+ *
+ * Hover and click tests run on every mouse move and click-through timer
+ * tick. The grid maps a point to the few regions overlapping its cell, so
+ * a dense checklist costs a cell lookup instead of a scan of every region.
+ */
+
+#include "markdown_interactive_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+static BOOL ContainsPoint(const RECT* rect, POINT pt) {
+    return pt.x >= rect->left && pt.x < rect->right &&
+           pt.y >= rect->top && pt.y < rect->bottom;
+}
+
+static BOOL IsEmptyRegionRect(const RECT* rect) {
+    return rect->left >= rect->right || rect->top >= rect->bottom;
+}
+
+static int CellCoord(LONG value, LONG origin, int shift) {
+    return (int)(((LONGLONG)value - origin) >> shift);
+}
+
+/* Cells covered by a non-empty rect, clamped to the grid */
+static void GetCellSpan(const ClickableRegionIndex* index, const RECT* rect,
+                        int* c0, int* r0, int* c1, int* r1) {
+    *c0 = CellCoord(rect->left, index->bounds.left, index->cellShift);
+    *r0 = CellCoord(rect->top, index->bounds.top, index->cellShift);
+    *c1 = CellCoord(rect->right - 1, index->bounds.left, index->cellShift);
+    *r1 = CellCoord(rect->bottom - 1, index->bounds.top, index->cellShift);
+    if (*c1 >= index->cols) *c1 = index->cols - 1;
+    if (*r1 >= index->rows) *r1 = index->rows - 1;
+}
+
+void MarkdownInteractive_FreeIndex(ClickableRegionIndex* index) {
+    if (!index) return;
+    for (int i = 0; i < index->regionCount; i++) {
+        free(index->regions[i].url);
+    }
+    free(index->cellStart);
+    free(index->cellRegions);
+    free(index);
+}
+
+static BOOL CopyRegions(ClickableRegionIndex* index, const ClickableRegion* regions, int count) {
+    for (int i = 0; i < count; i++) {
+        index->regions[i] = regions[i];
+        index->regions[i].url = NULL;
+        if (regions[i].url) {
+            index->regions[i].url = _wcsdup(regions[i].url);
+            if (!index->regions[i].url) return FALSE;
+        }
+        index->regionCount = i + 1;
+    }
+    return TRUE;
+}
+
+static void ComputeGrid(ClickableRegionIndex* index) {
+    BOOL any = FALSE;
+    for (int i = 0; i < index->regionCount; i++) {
+        const RECT* rect = &index->regions[i].rect;
+        if (IsEmptyRegionRect(rect)) continue;
+        if (!any) {
+            index->bounds = *rect;
+            any = TRUE;
+            continue;
+        }
+        if (rect->left < index->bounds.left) index->bounds.left = rect->left;
+        if (rect->top < index->bounds.top) index->bounds.top = rect->top;
+        if (rect->right > index->bounds.right) index->bounds.right = rect->right;
+        if (rect->bottom > index->bounds.bottom) index->bounds.bottom = rect->bottom;
+    }
+    if (!any) {
+        index->bounds.left = index->bounds.top = 0;
+        index->bounds.right = index->bounds.bottom = 1;
+    }
+
+    LONGLONG width = (LONGLONG)index->bounds.right - index->bounds.left;
+    LONGLONG height = (LONGLONG)index->bounds.bottom - index->bounds.top;
+    int shift = CLICKABLE_INDEX_MIN_CELL_SHIFT;
+    for (;;) {
+        LONGLONG cols = ((width - 1) >> shift) + 1;
+        LONGLONG rows = ((height - 1) >> shift) + 1;
+        if (cols * rows <= CLICKABLE_INDEX_MAX_CELLS || shift >= 31) {
+            index->cols = (int)cols;
+            index->rows = (int)rows;
+            break;
+        }
+        shift++;
+    }
+    index->cellShift = shift;
+}
+
+ClickableRegionIndex* MarkdownInteractive_BuildIndex(const ClickableRegion* regions, int count) {
+    if (!regions || count <= 0) return NULL;
+    if (count > MAX_CLICKABLE_REGIONS) count = MAX_CLICKABLE_REGIONS;
+
+    ClickableRegionIndex* index = (ClickableRegionIndex*)calloc(1, sizeof(ClickableRegionIndex));
+    if (!index) return NULL;
+    if (!CopyRegions(index, regions, count)) {
+        MarkdownInteractive_FreeIndex(index);
+        return NULL;
+    }
+    ComputeGrid(index);
+
+    /* Counting pass, then prefix sums, then a fill pass in region order */
+    int cellCount = index->cols * index->rows;
+    index->cellStart = (int*)calloc((size_t)cellCount + 1, sizeof(int));
+    if (!index->cellStart) {
+        MarkdownInteractive_FreeIndex(index);
+        return NULL;
+    }
+    int total = 0;
+    for (int i = 0; i < index->regionCount; i++) {
+        const RECT* rect = &index->regions[i].rect;
+        if (IsEmptyRegionRect(rect)) continue;
+        int c0, r0, c1, r1;
+        GetCellSpan(index, rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) index->cellStart[r * index->cols + c + 1]++;
+        }
+        total += (c1 - c0 + 1) * (r1 - r0 + 1);
+    }
+    for (int cell = 0; cell < cellCount; cell++) {
+        index->cellStart[cell + 1] += index->cellStart[cell];
+    }
+
+    index->cellRegions = (BYTE*)malloc(total > 0 ? (size_t)total : 1);
+    int* cursor = (int*)malloc((size_t)cellCount * sizeof(int));
+    if (!index->cellRegions || !cursor) {
+        free(cursor);
+        MarkdownInteractive_FreeIndex(index);
+        return NULL;
+    }
+    memcpy(cursor, index->cellStart, (size_t)cellCount * sizeof(int));
+    for (int i = 0; i < index->regionCount; i++) {
+        const RECT* rect = &index->regions[i].rect;
+        if (IsEmptyRegionRect(rect)) continue;
+        int c0, r0, c1, r1;
+        GetCellSpan(index, rect, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                index->cellRegions[cursor[r * index->cols + c]++] = (BYTE)i;
+            }
+        }
+    }
+    free(cursor);
+    return index;
+}
+
+static BOOL SameRect(const RECT* a, const RECT* b) {
+    return a->left == b->left && a->top == b->top &&
+           a->right == b->right && a->bottom == b->bottom;
+}
+
+static BOOL SameUrl(const wchar_t* a, const wchar_t* b) {
+    if (!a || !b) return a == b;
+    return wcscmp(a, b) == 0;
+}
+
+BOOL MarkdownInteractive_IndexMatches(const ClickableRegionIndex* index,
+                                      const ClickableRegion* regions, int count) {
+    if (count > MAX_CLICKABLE_REGIONS) count = MAX_CLICKABLE_REGIONS;
+    if (!index) return count <= 0;
+    if (index->regionCount != count) return FALSE;
+    for (int i = 0; i < count; i++) {
+        const ClickableRegion* a = &index->regions[i];
+        const ClickableRegion* b = &regions[i];
+        if (a->type != b->type || !SameRect(&a->rect, &b->rect) ||
+            a->checkboxIndex != b->checkboxIndex || a->isChecked != b->isChecked ||
+            !SameUrl(a->url, b->url)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+const ClickableRegion* MarkdownInteractive_FindRegion(const ClickableRegionIndex* index,
+                                                      POINT localPt) {
+    if (!index || !ContainsPoint(&index->bounds, localPt)) return NULL;
+    int col = CellCoord(localPt.x, index->bounds.left, index->cellShift);
+    int row = CellCoord(localPt.y, index->bounds.top, index->cellShift);
+    if (col >= index->cols || row >= index->rows) return NULL;
+    int cell = row * index->cols + col;
+    for (int k = index->cellStart[cell]; k < index->cellStart[cell + 1]; k++) {
+        const ClickableRegion* region = &index->regions[index->cellRegions[k]];
+        if (ContainsPoint(&region->rect, localPt)) return region;
+    }
+    return NULL;
+}
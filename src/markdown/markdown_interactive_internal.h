@@ -3,6 +3,34 @@
 
 #include <windows.h>
 
+#include "markdown/markdown_interactive.h"
+
 BOOL MarkdownInteractive_IsValidWindow(HWND hwnd);
 
+/* Smallest grid cell; grows so a layout never needs more cells than this */
+#define CLICKABLE_INDEX_MIN_CELL_SHIFT 5
+#define CLICKABLE_INDEX_MAX_CELLS 1024
+
+/**
+ * Immutable uniform-grid index over one frame's clickable regions.
+ * Cell lists keep region order, so the first hit matches the old scan.
+ */
+typedef struct {
+    int regionCount;
+    ClickableRegion regions[MAX_CLICKABLE_REGIONS];
+    RECT bounds;
+    int cellShift;
+    int cols;
+    int rows;
+    int* cellStart;         /* cols * rows + 1 offsets into cellRegions */
+    BYTE* cellRegions;      /* Region indices, ascending within a cell */
+} ClickableRegionIndex;
+
+ClickableRegionIndex* MarkdownInteractive_BuildIndex(const ClickableRegion* regions, int count);
+void MarkdownInteractive_FreeIndex(ClickableRegionIndex* index);
+BOOL MarkdownInteractive_IndexMatches(const ClickableRegionIndex* index,
+                                      const ClickableRegion* regions, int count);
+const ClickableRegion* MarkdownInteractive_FindRegion(const ClickableRegionIndex* index,
+                                                      POINT localPt);
+
 #endif
@@ -15,6 +15,7 @@
 #include "config.h"
 #include "config/config_defaults.h"
 #include "dialog/dialog_notification.h"
+#include "drawing/drawing_dib_pool.h"
 #include "log.h"
 #include "utils/render_retry.h"
 #include "window/window_placement.h"
@@ -32,7 +33,6 @@
 #define NOTIFICATION_MAX_HEIGHT 900
 #define NOTIFICATION_MAX_PAINT_PIXELS (NOTIFICATION_MAX_WIDTH * NOTIFICATION_MAX_HEIGHT)
 #define NOTIFICATION_MIN_FONT_PIXEL_SIZE 8
-#define NOTIFICATION_PAINT_SHRINK_THRESHOLD_MULTIPLIER 4u
 #define CATIME_MAIN_WINDOW_CLASS_NAME L"CatimeWindowClass"
 
 typedef struct {
@@ -50,18 +50,8 @@ typedef struct {
     BOOL opacitySavePending;
     int pendingOpacity;
     int opacitySaveRetryCount;
-    HDC paintDC;
-    HBITMAP paintBitmap;
-    HBITMAP oldPaintBitmap;
-    void* paintBits;
-    int paintWidth;
-    int paintHeight;
-    HDC textMaskDC;
-    HBITMAP textMaskBitmap;
-    HBITMAP oldTextMaskBitmap;
-    void* textMaskBits;
-    int textMaskWidth;
-    int textMaskHeight;
+    DibSurface paintSurface;
+    DibSurface textMaskSurface;
     RenderRetryController renderRetry;
 } NotificationData;
 
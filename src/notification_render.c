@@ -12,6 +12,7 @@
 #include "color/color_state.h"
 #include "color/gradient.h"
 #include "config/config_defaults.h"
+#include "drawing/drawing_blend.h"
 #include "menu_preview.h"
 
 static HFONT g_notificationContentFont = NULL;
@@ -94,24 +95,10 @@ static BYTE CalculateNotificationCornerAlpha(int x, int y,
     return (BYTE)(((int)opacity * insideSamples + 8) / 16);
 }
 
-static void PremultiplyNotificationPixel(unsigned char* pixel, BYTE alpha) {
-    pixel[3] = alpha;
-    if (alpha == 0) {
-        pixel[0] = 0;
-        pixel[1] = 0;
-        pixel[2] = 0;
-        return;
-    }
-
-    pixel[0] = (unsigned char)(((int)pixel[0] * alpha + 127) / 255);
-    pixel[1] = (unsigned char)(((int)pixel[1] * alpha + 127) / 255);
-    pixel[2] = (unsigned char)(((int)pixel[2] * alpha + 127) / 255);
-}
-
 static void ApplyNotificationLayerAlpha(NotificationData* data,
                                         int width, int height) {
-    if (!data || !data->paintBits || width <= 0 || height <= 0 ||
-        data->paintWidth < width) {
+    if (!data || !data->paintSurface.bits || width <= 0 || height <= 0 ||
+        data->paintSurface.width < width) {
         return;
     }
 
@@ -122,17 +109,16 @@ static void ApplyNotificationLayerAlpha(NotificationData* data,
         radius = maxRadius;
     }
 
-    unsigned char* pixels = (unsigned char*)data->paintBits;
-    int strideWidth = data->paintWidth;
+    DWORD* pixels = (DWORD*)data->paintSurface.bits;
+    int strideWidth = data->paintSurface.width;
     for (int y = 0; y < height; y++) {
         BOOL yInsideMiddle = radius <= 0 || (y >= radius && y < height - radius);
+        DWORD* row = pixels + (size_t)y * (size_t)strideWidth;
         for (int x = 0; x < width; x++) {
-            unsigned char* pixel =
-                pixels + ((size_t)y * (size_t)strideWidth + (size_t)x) * 4;
             BYTE alpha = (yInsideMiddle || (x >= radius && x < width - radius))
                 ? opacity
                 : CalculateNotificationCornerAlpha(x, y, width, height, radius, opacity);
-            PremultiplyNotificationPixel(pixel, alpha);
+            row[x] = DrawingBlend_PremultiplyRounded(row[x], alpha);
         }
     }
 }
@@ -254,8 +240,8 @@ BOOL NotificationRenderLayeredWindow(HWND hwnd, NotificationData* data) {
             clientRect.right - NOTIFICATION_PADDING_H,
             clientRect.bottom - NOTIFICATION_PADDING_V
         };
-        DrawNotificationTextWithCurrentColor(data, memDC, data->paintBits,
-                                             data->paintWidth,
+        DrawNotificationTextWithCurrentColor(data, memDC, data->paintSurface.bits,
+                                             data->paintSurface.width,
                                              paintWidth, paintHeight,
                                              data->messageText, textRect,
                                              contentFont,
@@ -1,6 +1,7 @@
 #include "notification_render_internal.h"
 #include "color/color_state.h"
 #include "color/gradient.h"
+#include "drawing/drawing_blend.h"
 #include "menu_preview.h"
 
 static COLORREF GetNotificationSolidTextColor(const char* activeColor) {
@@ -20,12 +21,9 @@ BOOL NotificationCurrentColorIsAnimatedGradient(void) {
 static void BlendNotificationDibPixel(unsigned char* pixel, COLORREF foreground,
                                       BYTE alpha) {
     if (!pixel || alpha == 0) return;
-    pixel[0] = (unsigned char)((GetBValue(foreground) * alpha +
-                                pixel[0] * (255 - alpha)) / 255);
-    pixel[1] = (unsigned char)((GetGValue(foreground) * alpha +
-                                pixel[1] * (255 - alpha)) / 255);
-    pixel[2] = (unsigned char)((GetRValue(foreground) * alpha +
-                                pixel[2] * (255 - alpha)) / 255);
+    pixel[0] = DrawingBlend_MixByte(GetBValue(foreground), pixel[0], alpha);
+    pixel[1] = DrawingBlend_MixByte(GetGValue(foreground), pixel[1], alpha);
+    pixel[2] = DrawingBlend_MixByte(GetRValue(foreground), pixel[2], alpha);
 }
 
 static BOOL DrawGradientNotificationText(NotificationData* data, HDC memDC,
@@ -70,14 +68,14 @@ static BOOL DrawGradientNotificationText(NotificationData* data, HDC memDC,
         }
         gradientColors[x] = GetGradientColorAt(gradientInfo, t);
     }
-    unsigned char* pixels = (unsigned char*)data->textMaskBits;
+    unsigned char* pixels = (unsigned char*)data->textMaskSurface.bits;
     unsigned char* destPixels = (unsigned char*)destBits;
     for (int y = 0; y < maskHeight; y++) {
         int destY = rect.top + yOffset + y;
         if (destY < 0 || destY >= destHeight) continue;
         for (int x = 0; x < width; x++) {
             const unsigned char* pixel =
-                pixels + ((size_t)y * data->textMaskWidth + x) * 4;
+                pixels + ((size_t)y * data->textMaskSurface.width + x) * 4;
             BYTE alpha = (BYTE)(((int)pixel[0] + pixel[1] + pixel[2]) / 3);
             int destX = rect.left + x;
             if (!alpha || destX < 0 || destX >= destWidth) continue;
@@ -0,0 +1,151 @@
+/**
+ * @file plugin_channel.c
+ * @brief Seqlock ring protocol and reference producer for the plugin channel.
+ */
+
+#include "plugin/plugin_channel.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static LONG ReadSequence(const volatile LONG* sequence) {
+    LONG value = *sequence;
+    MemoryBarrier();
+    return value;
+}
+
+void PluginChannel_InitBuffer(PluginChannelBuffer* buffer) {
+    if (!buffer) return;
+    ZeroMemory(buffer, sizeof(*buffer));
+    buffer->slotCount = PLUGIN_CHANNEL_SLOT_COUNT;
+    buffer->slotBytes = PLUGIN_CHANNEL_SLOT_BYTES;
+    buffer->version = PLUGIN_CHANNEL_VERSION;
+    MemoryBarrier();
+    buffer->magic = PLUGIN_CHANNEL_MAGIC;
+}
+
+BOOL PluginChannel_IsCompatible(const PluginChannelBuffer* buffer) {
+    return buffer &&
+           buffer->magic == PLUGIN_CHANNEL_MAGIC &&
+           buffer->version == PLUGIN_CHANNEL_VERSION &&
+           buffer->slotCount == PLUGIN_CHANNEL_SLOT_COUNT &&
+           buffer->slotBytes == PLUGIN_CHANNEL_SLOT_BYTES;
+}
+
+PluginChannelReadResult PluginChannel_ReadLatest(const PluginChannelBuffer* buffer,
+                                                 ULONG lastSequence,
+                                                 char* data, DWORD* lengthOut,
+                                                 ULONG* sequenceOut) {
+    if (!buffer || !data || !lengthOut || !sequenceOut) {
+        return PLUGIN_CHANNEL_READ_NONE;
+    }
+
+    for (int attempt = 0; attempt < PLUGIN_CHANNEL_READ_RETRIES; attempt++) {
+        ULONG published = (ULONG)ReadSequence(&buffer->publishedSequence);
+        if (published == 0 || published == lastSequence) {
+            return PLUGIN_CHANNEL_READ_NONE;
+        }
+
+        const PluginChannelSlot* slot =
+            &buffer->slots[published % PLUGIN_CHANNEL_SLOT_COUNT];
+        LONG expected = (LONG)(published * 2u);
+        if (ReadSequence(&slot->sequence) != expected) {
+            continue;
+        }
+
+        DWORD length = *(const volatile DWORD*)&slot->length;
+        if (length > PLUGIN_CHANNEL_SLOT_BYTES) {
+            continue;
+        }
+        memcpy(data, slot->data, length);
+        if (ReadSequence(&slot->sequence) != expected) {
+            continue;
+        }
+
+        *lengthOut = length;
+        *sequenceOut = published;
+        return PLUGIN_CHANNEL_READ_OK;
+    }
+    return PLUGIN_CHANNEL_READ_BUSY;
+}
+
+ULONG PluginChannel_Write(PluginChannelBuffer* buffer,
+                          const char* data, DWORD length) {
+    if (!buffer || (length > 0 && !data) || length > PLUGIN_CHANNEL_SLOT_BYTES) {
+        return 0;
+    }
+
+    ULONG sequence = (ULONG)buffer->publishedSequence + 1u;
+    if (sequence == 0) sequence = 1;
+    PluginChannelSlot* slot = &buffer->slots[sequence % PLUGIN_CHANNEL_SLOT_COUNT];
+
+    /* Interlocked stores are full barriers, so the odd marker is visible
+     * before the payload and the payload before the even marker. */
+    InterlockedExchange(&slot->sequence, (LONG)(sequence * 2u - 1u));
+    if (length > 0) {
+        memcpy(slot->data, data, length);
+    }
+    slot->length = length;
+    InterlockedExchange(&slot->sequence, (LONG)(sequence * 2u));
+    InterlockedExchange(&buffer->publishedSequence, (LONG)sequence);
+    return sequence;
+}
+
+BOOL PluginChannelProducer_Open(PluginChannelProducer* producer,
+                                const wchar_t* channelName) {
+    if (!producer) return FALSE;
+    ZeroMemory(producer, sizeof(*producer));
+
+    wchar_t name[PLUGIN_CHANNEL_NAME_CHARS];
+    if (channelName) {
+        if (wcsncpy_s(name, PLUGIN_CHANNEL_NAME_CHARS, channelName, _TRUNCATE) != 0) {
+            return FALSE;
+        }
+    } else {
+        DWORD length = GetEnvironmentVariableW(PLUGIN_CHANNEL_ENV_NAME, name,
+                                               PLUGIN_CHANNEL_NAME_CHARS);
+        if (length == 0 || length >= PLUGIN_CHANNEL_NAME_CHARS) return FALSE;
+    }
+
+    wchar_t eventName[PLUGIN_CHANNEL_NAME_CHARS];
+    int written = _snwprintf_s(eventName, PLUGIN_CHANNEL_NAME_CHARS, _TRUNCATE,
+                               L"%ls%ls", name, PLUGIN_CHANNEL_EVENT_SUFFIX);
+    if (written < 0) return FALSE;
+
+    producer->mapping = OpenFileMappingW(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, name);
+    if (!producer->mapping) return FALSE;
+
+    producer->buffer = (PluginChannelBuffer*)MapViewOfFile(
+        producer->mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0,
+        sizeof(PluginChannelBuffer));
+    producer->readyEvent = OpenEventW(EVENT_MODIFY_STATE, FALSE, eventName);
+    if (!producer->buffer || !producer->readyEvent ||
+        !PluginChannel_IsCompatible(producer->buffer)) {
+        PluginChannelProducer_Close(producer);
+        return FALSE;
+    }
+
+    InterlockedExchange(&producer->buffer->producerPid, (LONG)GetCurrentProcessId());
+    return TRUE;
+}
+
+BOOL PluginChannelProducer_Publish(PluginChannelProducer* producer,
+                                   const char* utf8, DWORD length) {
+    if (!producer || !producer->buffer) return FALSE;
+    if (PluginChannel_Write(producer->buffer, utf8, length) == 0) return FALSE;
+    return SetEvent(producer->readyEvent);
+}
+
+void PluginChannelProducer_Close(PluginChannelProducer* producer) {
+    if (!producer) return;
+    if (producer->buffer) {
+        UnmapViewOfFile(producer->buffer);
+    }
+    if (producer->readyEvent) {
+        CloseHandle(producer->readyEvent);
+    }
+    if (producer->mapping) {
+        CloseHandle(producer->mapping);
+    }
+    ZeroMemory(producer, sizeof(*producer));
+}
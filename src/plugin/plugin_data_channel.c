@@ -0,0 +1,107 @@
+/**
+ * @file plugin_data_channel.c
+ * @brief Host side of the shared-memory plugin output channel.
+ */
+
+#include "plugin_data_internal.h"
+#include "plugin/plugin_channel.h"
+
+static HANDLE g_channelMapping = NULL;
+static HANDLE g_channelReadyEvent = NULL;
+static PluginChannelBuffer* g_channelBuffer = NULL;
+/* Records up to this one belong to a plugin run that has been stopped. */
+static volatile LONG g_channelRetiredSequence = 0;
+
+static BOOL BuildChannelNames(wchar_t* name, wchar_t* eventName) {
+    int written = _snwprintf_s(name, PLUGIN_CHANNEL_NAME_CHARS, _TRUNCATE,
+                               L"%ls%lu", PLUGIN_CHANNEL_NAME_PREFIX,
+                               GetCurrentProcessId());
+    if (written < 0) return FALSE;
+    written = _snwprintf_s(eventName, PLUGIN_CHANNEL_NAME_CHARS, _TRUNCATE,
+                           L"%ls%ls", name, PLUGIN_CHANNEL_EVENT_SUFFIX);
+    return written >= 0;
+}
+
+BOOL CreatePluginChannel(void) {
+    if (g_channelBuffer) return TRUE;
+
+    wchar_t name[PLUGIN_CHANNEL_NAME_CHARS];
+    wchar_t eventName[PLUGIN_CHANNEL_NAME_CHARS];
+    if (!BuildChannelNames(name, eventName)) return FALSE;
+
+    g_channelMapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                          0, (DWORD)sizeof(PluginChannelBuffer), name);
+    if (g_channelMapping) {
+        g_channelBuffer = (PluginChannelBuffer*)MapViewOfFile(
+            g_channelMapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0,
+            sizeof(PluginChannelBuffer));
+    }
+    if (g_channelBuffer) {
+        g_channelReadyEvent = CreateEventW(NULL, FALSE, FALSE, eventName);
+    }
+    if (!g_channelReadyEvent) {
+        LOG_WARNING("PluginData: Output channel unavailable (error=%lu), using output.txt only",
+                    GetLastError());
+        DestroyPluginChannel();
+        return FALSE;
+    }
+
+    PluginChannel_InitBuffer(g_channelBuffer);
+    InterlockedExchange(&g_channelRetiredSequence, 0);
+    /* Plugins are child processes and inherit this through CreateProcess/ShellExecute. */
+    if (!SetEnvironmentVariableW(PLUGIN_CHANNEL_ENV_NAME, name)) {
+        LOG_WARNING("PluginData: Failed to export output channel name (error=%lu)",
+                    GetLastError());
+    }
+    return TRUE;
+}
+
+void DestroyPluginChannel(void) {
+    SetEnvironmentVariableW(PLUGIN_CHANNEL_ENV_NAME, NULL);
+    if (g_channelBuffer) {
+        UnmapViewOfFile(g_channelBuffer);
+        g_channelBuffer = NULL;
+    }
+    if (g_channelReadyEvent) {
+        CloseHandle(g_channelReadyEvent);
+        g_channelReadyEvent = NULL;
+    }
+    if (g_channelMapping) {
+        CloseHandle(g_channelMapping);
+        g_channelMapping = NULL;
+    }
+}
+
+HANDLE GetPluginChannelEvent(void) {
+    return g_channelReadyEvent;
+}
+
+ULONG GetRetiredPluginChannelSequence(void) {
+    return (ULONG)InterlockedCompareExchange(&g_channelRetiredSequence, 0, 0);
+}
+
+void RetirePluginChannelRecords(void) {
+    if (!g_channelBuffer) return;
+    LONG published = InterlockedCompareExchange(&g_channelBuffer->publishedSequence, 0, 0);
+    InterlockedExchange(&g_channelRetiredSequence, published);
+}
+
+BOOL ProcessPluginChannel(ULONG* lastSequence, BOOL forceRefresh) {
+    if (!g_channelBuffer || !lastSequence) return FALSE;
+
+    char content[PLUGIN_CHANNEL_SLOT_BYTES];
+    DWORD length = 0;
+    ULONG sequence = 0;
+    ULONG baseline = forceRefresh ? GetRetiredPluginChannelSequence() : *lastSequence;
+    if (PluginChannel_ReadLatest(g_channelBuffer, baseline, content, &length,
+                                 &sequence) != PLUGIN_CHANNEL_READ_OK) {
+        /* A busy slot means the producer is mid-burst; its next SetEvent retries. */
+        return FALSE;
+    }
+    PluginParseResult result = ApplyStreamedPluginContent(content, length);
+    if (result == PLUGIN_PARSE_TRANSIENT_FAILURE) {
+        return FALSE;
+    }
+    *lastSequence = sequence;
+    return TRUE;
+}
@@ -28,6 +28,13 @@ BOOL ProcessPluginOutputFile(const wchar_t* filePath, BOOL forceRefresh,
             *lastFileSize = 0;
 
             EnterCriticalSection(&g_dataCS);
+            /* A channel-only or log-only plugin never writes output.txt;
+             * its absence retracts only what output.txt itself showed. */
+            if (g_displayFromStream) {
+                InvalidateLastOutputFileStateLocked();
+                LeaveCriticalSection(&g_dataCS);
+                return FALSE;
+            }
             BOOL hadCatimeTag = PluginDisplayHasCatimeTagLocked();
             BOOL displayChanged = ClearPluginDisplayDataLocked();
             BOOL displayTimerRecheck = hadCatimeTag != PluginDisplayHasCatimeTagLocked();
@@ -53,6 +60,12 @@ BOOL ProcessPluginOutputFile(const wchar_t* filePath, BOOL forceRefresh,
         *lastWriteTime = currentWriteTime;
         *lastFileSize = 0;
         EnterCriticalSection(&g_dataCS);
+        if (g_displayFromStream) {
+            UpdateLastOutputFileStateLocked(&currentWriteTime, 0);
+            LeaveCriticalSection(&g_dataCS);
+            CloseHandle(hFile);
+            return FALSE;
+        }
         BOOL hadCatimeTag = PluginDisplayHasCatimeTagLocked();
         BOOL displayChanged = ClearPluginDisplayDataLocked();
         BOOL timerRecheck = hadCatimeTag != PluginDisplayHasCatimeTagLocked();
@@ -148,6 +161,7 @@ BOOL ProcessPluginOutputFile(const wchar_t* filePath, BOOL forceRefresh,
         PluginParseResult parseResult =
             ParseContent(currentContent, bytesRead, FALSE, &displayChanged, &timerRecheck);
         if (parseResult == PLUGIN_PARSE_OK) {
+            NotePluginOutputApplied();
             *lastWriteTime = currentWriteTime;
             *lastFileSize = fileSize;
             EnterCriticalSection(&g_dataCS);
@@ -7,6 +7,7 @@
 #define PLUGIN_DATA_INTERNAL_H
 
 #include "plugin/plugin_data_types.h"
+#include "plugin/plugin_log_frame.h"
 #include "plugin/plugin_data.h"
 #include "plugin/plugin_exit.h"
 #include "config.h"
@@ -57,6 +58,8 @@ extern ULONGLONG g_lastOutputFileSize;
 extern BOOL g_hasLastOutputFileState;
 extern wchar_t g_pluginOutputDirectory[MAX_PATH];
 extern wchar_t g_displaySourcePath[MAX_PATH];
+/* The display came from the output channel or output.log, not output.txt */
+extern BOOL g_displayFromStream;
 extern volatile LONG g_pollIntervalMs;
 extern DWORD g_lastNotifyTime;
 extern PendingNotification g_pendingNotify;
@@ -89,13 +92,18 @@ PluginParseResult ParseContent(const char* content, size_t contentLen,
                                BOOL suppressSideEffects,
                                BOOL* displayChangedOut,
                                BOOL* timerRecheckOut);
+PluginParseResult ApplyStreamedPluginContent(const char* content, DWORD length);
+void NotePluginOutputApplied(void);
+void CancelPluginLaunchMeasurement(void);
 
 BOOL GetDefaultPluginOutputDirectoryW(wchar_t* buffer, size_t bufferSize);
 BOOL SetDefaultPluginOutputDirectoryLocked(void);
 BOOL EnsurePluginOutputDirectoryLocked(void);
 BOOL GetPluginOutputDirectory(wchar_t* buffer, size_t bufferSize);
 BOOL GetPluginOutputPathW(wchar_t* buffer, size_t bufferSize);
+BOOL GetPluginOutputLogPathW(wchar_t* buffer, size_t bufferSize);
 void SetDisplaySourcePathLocked(const wchar_t* sourcePath);
+void MarkDisplayStreamedLocked(void);
 BOOL GetDirectoryFromPathW(const wchar_t* path, wchar_t* directory, size_t directorySize);
 void EnsureOutputDirExistsW(const wchar_t* filePath);
 
@@ -114,6 +122,17 @@ BOOL GetPluginOutputFileStateW(const wchar_t* filePath,
 BOOL ProcessPluginOutputFile(const wchar_t* filePath, BOOL forceRefresh,
                              FILETIME* lastWriteTime, ULONGLONG* lastFileSize);
 
+BOOL ProcessPluginOutputLog(const wchar_t* logPath, PluginLogCursor* cursor,
+                            BOOL forceRefresh);
+void FreePluginLogCursor(PluginLogCursor* cursor);
+
+BOOL CreatePluginChannel(void);
+void DestroyPluginChannel(void);
+HANDLE GetPluginChannelEvent(void);
+ULONG GetRetiredPluginChannelSequence(void);
+void RetirePluginChannelRecords(void);
+BOOL ProcessPluginChannel(ULONG* lastSequence, BOOL forceRefresh);
+
 BOOL IsWatcherRunning(void);
 void SetWatcherRunning(BOOL running);
 BOOL IsWatcherStartFailureCoolingDown(DWORD now);
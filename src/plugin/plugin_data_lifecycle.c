@@ -112,6 +112,7 @@ void PluginData_Init(HWND hwnd) {
     if (GetPluginOutputPathW(outputPath, MAX_PATH)) {
         EnsureOutputDirExistsW(outputPath);
     }
+    CreatePluginChannel();
 
     g_pluginDataResourcesRetained = FALSE;
     g_pluginDataInitialized = TRUE;
@@ -148,6 +149,7 @@ void PluginData_Shutdown(void) {
         g_hWatchWakeEvent = NULL;
     }
     LeaveCriticalSection(&g_watchCS);
+    DestroyPluginChannel();
 
     /* Shutdown exit subsystem */
     if (!PluginExit_Shutdown()) {
@@ -0,0 +1,167 @@
+/**
+ * @file plugin_data_log.c
+ * @brief Incremental reader for the append-only output.log protocol.
+ */
+
+#include "plugin_data_internal.h"
+
+static BOOL FrameHasNotifyTag(const char* payload, DWORD length) {
+    static const char tag[] = "<notify";
+    const DWORD tagLength = (DWORD)(sizeof(tag) - 1);
+    for (DWORD i = 0; i + tagLength <= length; i++) {
+        if (payload[i] == '<' && memcmp(payload + i, tag, tagLength) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static BOOL ReadAt(HANDLE hFile, ULONGLONG offset, char* buffer,
+                   DWORD bytesToRead, DWORD* bytesRead) {
+    LARGE_INTEGER position;
+    position.QuadPart = (LONGLONG)offset;
+    *bytesRead = 0;
+    return SetFilePointerEx(hFile, position, NULL, FILE_BEGIN) &&
+           ReadFile(hFile, buffer, bytesToRead, bytesRead, NULL);
+}
+
+/** A writer that truncated and refilled past our offset leaves a non-boundary byte there. */
+static BOOL IsFrameBoundary(HANDLE hFile, ULONGLONG offset) {
+    if (offset == 0) return TRUE;
+    char previous = 0;
+    DWORD bytesRead = 0;
+    return ReadAt(hFile, offset - 1, &previous, 1, &bytesRead) &&
+           bytesRead == 1 && previous == '\n';
+}
+
+static BOOL StoreLatestFrame(PluginLogCursor* cursor, const PluginLogFrame* frame) {
+    if (!cursor->latest) {
+        cursor->latest = (char*)malloc(PLUGIN_LOG_MAX_FRAME_BYTES);
+        if (!cursor->latest) return FALSE;
+    }
+    memcpy(cursor->latest, frame->payload, frame->length);
+    cursor->latestLength = frame->length;
+    cursor->hasLatest = TRUE;
+    return TRUE;
+}
+
+/* Applying marks the display as streamed, so an absent output.txt no
+ * longer retracts the frame */
+static BOOL ApplyLatestFrame(PluginLogCursor* cursor) {
+    return cursor->hasLatest &&
+           ApplyStreamedPluginContent(cursor->latest, cursor->latestLength) ==
+               PLUGIN_PARSE_OK;
+}
+
+/**
+ * @brief Decode every complete frame between the cursor and end
+ * @details Only the newest frame becomes the display; an older frame is
+ * applied on its own only when it carries a <notify> tag that would
+ * otherwise be lost. A trailing partial frame stays unread.
+ */
+static BOOL ReadNewFrames(HANDLE hFile, PluginLogCursor* cursor, ULONGLONG end) {
+    char* chunk = (char*)malloc(PLUGIN_LOG_READ_CHUNK_BYTES);
+    if (!chunk) return FALSE;
+
+    BOOL pending = FALSE;
+    BOOL applied = FALSE;
+    DWORD malformed = 0;
+    ULONGLONG position = cursor->offset;
+    size_t filled = 0;
+    while (position + filled < end) {
+        DWORD bytesToRead = (DWORD)(PLUGIN_LOG_READ_CHUNK_BYTES - filled);
+        if ((ULONGLONG)bytesToRead > end - position - filled) {
+            bytesToRead = (DWORD)(end - position - filled);
+        }
+        DWORD bytesRead = 0;
+        if (!ReadAt(hFile, position + filled, chunk + filled, bytesToRead, &bytesRead) ||
+            bytesRead == 0) {
+            break;
+        }
+        filled += bytesRead;
+
+        size_t parsed = 0;
+        for (;;) {
+            PluginLogFrame frame;
+            size_t consumed = 0;
+            PluginLogFrameResult result =
+                PluginLogFrame_Next(chunk + parsed, filled - parsed, &frame, &consumed);
+            if (result == PLUGIN_LOG_FRAME_INCOMPLETE) break;
+            parsed += consumed;
+            if (result == PLUGIN_LOG_FRAME_MALFORMED) {
+                malformed++;
+                continue;
+            }
+            if (pending && FrameHasNotifyTag(cursor->latest, cursor->latestLength)) {
+                applied |= ApplyLatestFrame(cursor);
+            }
+            pending = StoreLatestFrame(cursor, &frame);
+        }
+
+        if (parsed == 0 && filled == PLUGIN_LOG_READ_CHUNK_BYTES) {
+            parsed = filled;
+            malformed++;
+        }
+        memmove(chunk, chunk + parsed, filled - parsed);
+        filled -= parsed;
+        position += parsed;
+    }
+    free(chunk);
+
+    if (malformed > 0) {
+        LOG_WARNING("PluginData: Skipped %lu malformed output.log record(s)", malformed);
+    }
+    cursor->offset = position;
+    if (pending) {
+        applied |= ApplyLatestFrame(cursor);
+    }
+    return applied;
+}
+
+BOOL ProcessPluginOutputLog(const wchar_t* logPath, PluginLogCursor* cursor,
+                            BOOL forceRefresh) {
+    if (!logPath || !cursor) return FALSE;
+
+    HANDLE hFile = CreateFileW(logPath, GENERIC_READ, PLUGIN_OUTPUT_FILE_SHARE, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        /* No log is the normal case; output.txt alone decides what is shown. */
+        cursor->offset = 0;
+        cursor->primed = TRUE;
+        cursor->hasLatest = FALSE;
+        return FALSE;
+    }
+
+    LARGE_INTEGER sizeValue;
+    if (!GetFileSizeEx(hFile, &sizeValue) || sizeValue.QuadPart < 0) {
+        CloseHandle(hFile);
+        return FALSE;
+    }
+    ULONGLONG fileSize = (ULONGLONG)sizeValue.QuadPart;
+
+    if (fileSize < cursor->offset || !IsFrameBoundary(hFile, cursor->offset)) {
+        LOG_INFO("PluginData: output.log was truncated, reading from the start");
+        cursor->offset = 0;
+    }
+    if (!cursor->primed && fileSize > MAX_PLUGIN_OUTPUT_BYTES) {
+        LOG_WARNING("PluginData: Skipping existing output.log larger than %llu bytes",
+                    (ULONGLONG)MAX_PLUGIN_OUTPUT_BYTES);
+        cursor->offset = fileSize;
+    }
+    cursor->primed = TRUE;
+
+    BOOL applied = FALSE;
+    if (cursor->offset < fileSize) {
+        applied = ReadNewFrames(hFile, cursor, fileSize);
+    } else if (forceRefresh) {
+        applied = ApplyLatestFrame(cursor);
+    }
+    CloseHandle(hFile);
+    return applied;
+}
+
+void FreePluginLogCursor(PluginLogCursor* cursor) {
+    if (!cursor) return;
+    free(cursor->latest);
+    ZeroMemory(cursor, sizeof(*cursor));
+}
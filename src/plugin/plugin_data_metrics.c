@@ -0,0 +1,68 @@
+/**
+ * @file plugin_data_metrics.c
+ * @brief Launch-to-first-output latency for warm and cold plugin starts.
+ */
+
+#include "plugin_data_internal.h"
+
+static SRWLOCK g_launchMetricsLock = SRWLOCK_INIT;
+static LONGLONG g_pendingLaunchCounter = 0;
+static BOOL g_pendingLaunchWarm = FALSE;
+/* Checked without the lock so every output update stays a single read. */
+static volatile LONG g_launchMeasurementPending = 0;
+static PluginLaunchLatencyStats g_launchStats[2];
+
+void PluginData_BeginLaunchMeasurement(LONGLONG startCounter, BOOL warm) {
+    AcquireSRWLockExclusive(&g_launchMetricsLock);
+    g_pendingLaunchCounter = startCounter;
+    g_pendingLaunchWarm = warm;
+    InterlockedExchange(&g_launchMeasurementPending, startCounter != 0);
+    ReleaseSRWLockExclusive(&g_launchMetricsLock);
+}
+
+void CancelPluginLaunchMeasurement(void) {
+    InterlockedExchange(&g_launchMeasurementPending, 0);
+}
+
+void NotePluginOutputApplied(void) {
+    if (InterlockedCompareExchange(&g_launchMeasurementPending, 0, 0) == 0) return;
+
+    LARGE_INTEGER now;
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceCounter(&now) || !QueryPerformanceFrequency(&frequency) ||
+        frequency.QuadPart <= 0) {
+        return;
+    }
+
+    AcquireSRWLockExclusive(&g_launchMetricsLock);
+    if (InterlockedExchange(&g_launchMeasurementPending, 0) == 0 ||
+        now.QuadPart < g_pendingLaunchCounter) {
+        ReleaseSRWLockExclusive(&g_launchMetricsLock);
+        return;
+    }
+    LONGLONG elapsed = now.QuadPart - g_pendingLaunchCounter;
+    ULONGLONG micros = (ULONGLONG)(elapsed / frequency.QuadPart) * 1000000ULL +
+                       (ULONGLONG)(elapsed % frequency.QuadPart) * 1000000ULL /
+                           (ULONGLONG)frequency.QuadPart;
+    BOOL warm = g_pendingLaunchWarm;
+    PluginLaunchLatencyStats* stats = &g_launchStats[warm ? 1 : 0];
+    if (stats->count == 0 || micros < stats->minMicros) stats->minMicros = micros;
+    if (micros > stats->maxMicros) stats->maxMicros = micros;
+    stats->lastMicros = micros;
+    stats->totalMicros += micros;
+    stats->count++;
+    DWORD count = stats->count;
+    ULONGLONG average = stats->totalMicros / count;
+    ReleaseSRWLockExclusive(&g_launchMetricsLock);
+
+    LOG_INFO("PluginData: First output %llu us after %s launch (avg %llu us over %lu)",
+             micros, warm ? "warm" : "cold", average, count);
+}
+
+BOOL PluginData_GetLaunchLatencyStats(BOOL warm, PluginLaunchLatencyStats* stats) {
+    if (!stats) return FALSE;
+    AcquireSRWLockShared(&g_launchMetricsLock);
+    *stats = g_launchStats[warm ? 1 : 0];
+    ReleaseSRWLockShared(&g_launchMetricsLock);
+    return stats->count > 0;
+}
@@ -43,6 +43,8 @@ void PluginData_SetActive(BOOL active) {
         }
         StartWatcherThreadIfNeeded();
     } else {
+        RetirePluginChannelRecords();
+        CancelPluginLaunchMeasurement();
         PluginExit_Cancel();
         if (!StopWatcherThreadIfIdle(PLUGIN_DATA_WATCHER_UI_STOP_WAIT_MS)) {
             LOG_WARNING("PluginData: Watcher stop deferred while deactivating plugin data");
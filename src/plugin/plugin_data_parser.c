@@ -148,3 +148,75 @@ PluginParseResult ParseContent(const char* content, size_t contentLen,
     }
     return PLUGIN_PARSE_OK;
 }
+
+static void ClearStreamedPluginDisplay(BOOL markStreamed) {
+    EnterCriticalSection(&g_dataCS);
+    BOOL hadCatimeTag = PluginDisplayHasCatimeTagLocked();
+    BOOL displayChanged = ClearPluginDisplayDataLocked();
+    BOOL timerRecheck = hadCatimeTag != PluginDisplayHasCatimeTagLocked();
+    ClearLastContentCacheLocked();
+    if (markStreamed) {
+        MarkDisplayStreamedLocked();
+    } else {
+        SetDisplaySourcePathLocked(NULL);
+    }
+    LeaveCriticalSection(&g_dataCS);
+    if (timerRecheck) {
+        QueuePluginDataTimerRecheck();
+    }
+    if ((displayChanged || timerRecheck) && g_hNotifyWnd) {
+        RequestPluginDataRedraw(g_hNotifyWnd);
+    }
+}
+
+/**
+ * @brief Apply one complete update from the output channel or output.log
+ * @details On success the display is marked as streamed in the same
+ * critical section that stores it, so an output.txt check can never see
+ * the new content without the mark.
+ */
+PluginParseResult ApplyStreamedPluginContent(const char* content, DWORD length) {
+    if (!content || length == 0) {
+        ClearStreamedPluginDisplay(TRUE);
+        return PLUGIN_PARSE_OK;
+    }
+
+    EnterCriticalSection(&g_dataCS);
+    BOOL contentChanged = g_lastContent == NULL ||
+                          g_lastContentSize != (size_t)length + 1 ||
+                          memcmp(content, g_lastContent, length) != 0;
+    if (!contentChanged) {
+        MarkDisplayStreamedLocked();
+    }
+    LeaveCriticalSection(&g_dataCS);
+    if (!contentChanged) {
+        return PLUGIN_PARSE_OK;
+    }
+
+    BOOL displayChanged = FALSE;
+    BOOL timerRecheck = FALSE;
+    PluginParseResult parseResult =
+        ParseContent(content, length, FALSE, &displayChanged, &timerRecheck);
+    if (parseResult == PLUGIN_PARSE_FAILED) {
+        ClearStreamedPluginDisplay(FALSE);
+        return parseResult;
+    }
+    if (parseResult != PLUGIN_PARSE_OK) {
+        return parseResult;
+    }
+    NotePluginOutputApplied();
+
+    EnterCriticalSection(&g_dataCS);
+    /* Streamed sources have no file to edit, so checkbox toggles and relative
+     * image paths fall back to output.txt and its folder. */
+    MarkDisplayStreamedLocked();
+    UpdateLastContentCache(content, length);
+    LeaveCriticalSection(&g_dataCS);
+    if (timerRecheck) {
+        QueuePluginDataTimerRecheck();
+    }
+    if ((displayChanged || timerRecheck) && g_hNotifyWnd) {
+        RequestPluginDataRedraw(g_hNotifyWnd);
+    }
+    return PLUGIN_PARSE_OK;
+}
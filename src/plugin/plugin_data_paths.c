@@ -74,7 +74,8 @@ BOOL GetPluginOutputDirectory(wchar_t* buffer, size_t bufferSize) {
  * @brief Get plugin output file path
  * @return TRUE if successful, FALSE otherwise
  */
-BOOL GetPluginOutputPathW(wchar_t* buffer, size_t bufferSize) {
+static BOOL GetPluginOutputFilePathW(const wchar_t* fileName,
+                                     wchar_t* buffer, size_t bufferSize) {
     if (!buffer || bufferSize == 0 || bufferSize > (size_t)MAXDWORD) {
         return FALSE;
     }
@@ -87,7 +88,7 @@ BOOL GetPluginOutputPathW(wchar_t* buffer, size_t bufferSize) {
     }
 
     int written = _snwprintf_s(buffer, bufferSize, _TRUNCATE,
-                               L"%s\\%s", outputDir, PLUGIN_OUTPUT_FILENAME_W);
+                               L"%s\\%s", outputDir, fileName);
     if (written < 0 || (size_t)written >= bufferSize) {
         buffer[0] = L'\0';
         return FALSE;
@@ -95,7 +96,16 @@ BOOL GetPluginOutputPathW(wchar_t* buffer, size_t bufferSize) {
     return TRUE;
 }
 
+BOOL GetPluginOutputPathW(wchar_t* buffer, size_t bufferSize) {
+    return GetPluginOutputFilePathW(PLUGIN_OUTPUT_FILENAME_W, buffer, bufferSize);
+}
+
+BOOL GetPluginOutputLogPathW(wchar_t* buffer, size_t bufferSize) {
+    return GetPluginOutputFilePathW(PLUGIN_LOG_FILENAME_W, buffer, bufferSize);
+}
+
 void SetDisplaySourcePathLocked(const wchar_t* sourcePath) {
+    g_displayFromStream = FALSE;
     if (!sourcePath || sourcePath[0] == L'\0' || wcslen(sourcePath) >= MAX_PATH) {
         g_displaySourcePath[0] = L'\0';
         return;
@@ -105,6 +115,12 @@ void SetDisplaySourcePathLocked(const wchar_t* sourcePath) {
     g_displaySourcePath[MAX_PATH - 1] = L'\0';
 }
 
+/** @brief Streamed sources have no file; output.txt changes must not retract them */
+void MarkDisplayStreamedLocked(void) {
+    SetDisplaySourcePathLocked(NULL);
+    g_displayFromStream = TRUE;
+}
+
 BOOL GetDirectoryFromPathW(const wchar_t* path,
                                   wchar_t* directory,
                                   size_t directorySize) {
@@ -41,6 +41,7 @@ ULONGLONG g_lastOutputFileSize = 0;
 BOOL g_hasLastOutputFileState = FALSE;
 wchar_t g_pluginOutputDirectory[MAX_PATH] = {0};
 wchar_t g_displaySourcePath[MAX_PATH] = {0};
+BOOL g_displayFromStream = FALSE;
 volatile LONG g_pollIntervalMs = DEFAULT_POLL_INTERVAL_MS;
 DWORD g_lastNotifyTime = 0;
 PendingNotification g_pendingNotify = {0};
@@ -51,6 +51,7 @@ void PluginData_Clear(void) {
     /* Clear any pending notification to prevent stale notifications */
     ResetPendingNotificationLocked();
     LeaveCriticalSection(&g_dataCS);
+    RetirePluginChannelRecords();
     if (!StopWatcherThreadIfIdle(PLUGIN_DATA_WATCHER_UI_STOP_WAIT_MS)) {
         LOG_WARNING("PluginData: Watcher stop deferred while clearing plugin data");
     }
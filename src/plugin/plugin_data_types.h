@@ -29,6 +29,8 @@
 #define PLUGIN_OUTPUT_STACK_BUFFER_BYTES 1024
 #define PLUGIN_DISPLAY_STACK_WCHARS 1024
 #define PLUGIN_LAST_CONTENT_RETAIN_BYTES (64 * 1024)
+/* Must hold at least one maximal output.log record */
+#define PLUGIN_LOG_READ_CHUNK_BYTES (64 * 1024)
 #define MAX_CHANGE_DEBOUNCE_MS 50
 #define PLUGIN_OUTPUT_FILE_SHARE (FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE)
 
@@ -43,6 +45,15 @@ typedef struct {
     BOOL pending;
 } PendingNotification;
 
+/** Watcher-owned read position in output.log */
+typedef struct {
+    ULONGLONG offset;
+    BOOL primed;
+    char* latest;
+    DWORD latestLength;
+    BOOL hasLatest;
+} PluginLogCursor;
+
 typedef enum {
     PLUGIN_PARSE_FAILED = 0,
     PLUGIN_PARSE_OK,
@@ -85,6 +85,10 @@ DWORD WINAPI FileWatcherThread(LPVOID lpParam) {
         return 0;
     }
 
+    wchar_t logPath[MAX_PATH] = {0};
+    BOOL hasLogPath = GetPluginOutputLogPathW(logPath, MAX_PATH);
+    PluginLogCursor logCursor = {0};
+
     wchar_t outputDir[MAX_PATH] = {0};
     HANDLE changeHandle = INVALID_HANDLE_VALUE;
     if (GetPluginOutputDirectory(outputDir, MAX_PATH)) {
@@ -104,6 +108,12 @@ DWORD WINAPI FileWatcherThread(LPVOID lpParam) {
     CopyLastOutputFileStateLocked(&lastWriteTime, &lastFileSize);
     LeaveCriticalSection(&g_dataCS);
 
+    /* The channel event stays valid until PluginData_Shutdown, which stops
+     * this thread first. */
+    HANDLE channelEvent = GetPluginChannelEvent();
+    ULONG lastChannelSequence = GetRetiredPluginChannelSequence();
+    BOOL checkFile = TRUE;
+
     while (IsWatcherRunning()) {
         BOOL forceRefresh = InterlockedExchange(&g_forceNextUpdate, FALSE) != FALSE;
         if (forceRefresh) {
@@ -111,13 +121,28 @@ DWORD WINAPI FileWatcherThread(LPVOID lpParam) {
             lastFileSize = 0;
         }
 
-        ProcessPluginOutputFile(filePath, forceRefresh, &lastWriteTime, &lastFileSize);
+        /* Channel wakeups skip the files so high-rate producers cause no file I/O. */
+        if (checkFile || forceRefresh) {
+            ProcessPluginOutputFile(filePath, forceRefresh, &lastWriteTime, &lastFileSize);
+            if (hasLogPath) {
+                ProcessPluginOutputLog(logPath, &logCursor, forceRefresh);
+            }
+        }
+        ProcessPluginChannel(&lastChannelSequence, forceRefresh);
+        checkFile = TRUE;
 
-        HANDLE waitHandles[3];
+        HANDLE waitHandles[4];
         DWORD waitCount = 0;
+        DWORD channelIndex = 0;
+        DWORD changeIndex = 0;
         waitHandles[waitCount++] = g_hWatchStopEvent;
         waitHandles[waitCount++] = g_hWatchWakeEvent;
+        if (channelEvent) {
+            channelIndex = waitCount;
+            waitHandles[waitCount++] = channelEvent;
+        }
         if (changeHandle != INVALID_HANDLE_VALUE) {
+            changeIndex = waitCount;
             waitHandles[waitCount++] = changeHandle;
         }
 
@@ -132,7 +157,11 @@ DWORD WINAPI FileWatcherThread(LPVOID lpParam) {
             }
             continue;
         }
-        if (changeHandle != INVALID_HANDLE_VALUE && waitResult == WAIT_OBJECT_0 + 2) {
+        if (channelIndex != 0 && waitResult == WAIT_OBJECT_0 + channelIndex) {
+            checkFile = FALSE;
+            continue;
+        }
+        if (changeIndex != 0 && waitResult == WAIT_OBJECT_0 + changeIndex) {
             RearmChangeNotification(&changeHandle);
             if (!DebouncePluginOutputChange(&changeHandle)) {
                 break;
@@ -152,6 +181,7 @@ DWORD WINAPI FileWatcherThread(LPVOID lpParam) {
     if (changeHandle != INVALID_HANDLE_VALUE) {
         FindCloseChangeNotification(changeHandle);
     }
+    FreePluginLogCursor(&logCursor);
 
     SetWatcherRunning(FALSE);
 
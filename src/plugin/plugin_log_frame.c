@@ -0,0 +1,80 @@
+/**
+ * @file plugin_log_frame.c
+ * @brief Decoder for output.log records.
+ */
+
+#include "plugin_log_frame.h"
+
+#include <string.h>
+
+static PluginLogFrameResult SkipLine(const char* buffer, size_t available,
+                                     size_t* consumed) {
+    const char* newline = (const char*)memchr(buffer, '\n', available);
+    if (!newline) {
+        /* Keep waiting only while the bad line could still be a header. */
+        if (available <= PLUGIN_LOG_MAX_LENGTH_DIGITS + 2) {
+            *consumed = 0;
+            return PLUGIN_LOG_FRAME_INCOMPLETE;
+        }
+        *consumed = available;
+        return PLUGIN_LOG_FRAME_MALFORMED;
+    }
+    *consumed = (size_t)(newline - buffer) + 1;
+    return PLUGIN_LOG_FRAME_MALFORMED;
+}
+
+static size_t MatchLineEnd(const char* buffer, size_t available, size_t pos,
+                           BOOL* incomplete) {
+    *incomplete = FALSE;
+    if (pos >= available) {
+        *incomplete = TRUE;
+        return 0;
+    }
+    if (buffer[pos] == '\n') return 1;
+    if (buffer[pos] != '\r') return 0;
+    if (pos + 1 >= available) {
+        *incomplete = TRUE;
+        return 0;
+    }
+    return buffer[pos + 1] == '\n' ? 2 : 0;
+}
+
+PluginLogFrameResult PluginLogFrame_Next(const char* buffer, size_t available,
+                                         PluginLogFrame* frame, size_t* consumed) {
+    *consumed = 0;
+    if (!buffer || available == 0) return PLUGIN_LOG_FRAME_INCOMPLETE;
+    if (buffer[0] != '#') return SkipLine(buffer, available, consumed);
+
+    size_t pos = 1;
+    DWORD length = 0;
+    while (pos < available && buffer[pos] >= '0' && buffer[pos] <= '9') {
+        if (pos > PLUGIN_LOG_MAX_LENGTH_DIGITS) {
+            return SkipLine(buffer, available, consumed);
+        }
+        length = length * 10u + (DWORD)(buffer[pos] - '0');
+        pos++;
+    }
+    if (pos >= available) return PLUGIN_LOG_FRAME_INCOMPLETE;
+
+    BOOL incomplete = FALSE;
+    size_t headerEnd = MatchLineEnd(buffer, available, pos, &incomplete);
+    if (incomplete) return PLUGIN_LOG_FRAME_INCOMPLETE;
+    if (pos == 1 || headerEnd == 0 || length > PLUGIN_LOG_MAX_FRAME_BYTES) {
+        return SkipLine(buffer, available, consumed);
+    }
+    pos += headerEnd;
+
+    if (available - pos < length) return PLUGIN_LOG_FRAME_INCOMPLETE;
+    size_t terminator = MatchLineEnd(buffer, available, pos + length, &incomplete);
+    if (incomplete) return PLUGIN_LOG_FRAME_INCOMPLETE;
+    if (terminator == 0) {
+        /* Length disagrees with the data; drop the header and resync. */
+        *consumed = pos;
+        return PLUGIN_LOG_FRAME_MALFORMED;
+    }
+
+    frame->payload = buffer + pos;
+    frame->length = length;
+    *consumed = pos + length + terminator;
+    return PLUGIN_LOG_FRAME_OK;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file plugin_log_frame.h
+ * @brief Frame format of the append-only output.log plugin protocol.
+ *
+ * Each record is "#<payload bytes>\n<payload>\n". Writers append whole
+ * records in binary mode and may truncate the file at any time to compact
+ * it; the host tracks its offset and only ever parses bytes appended since
+ * the previous check. CRLF is accepted after the length and the payload.
+ */
+
+#ifndef PLUGIN_LOG_FRAME_H
+#define PLUGIN_LOG_FRAME_H
+
+#include <stddef.h>
+#include <windows.h>
+
+#define PLUGIN_LOG_FILENAME_W L"output.log"
+#define PLUGIN_LOG_MAX_FRAME_BYTES (16u * 1024u)
+#define PLUGIN_LOG_MAX_LENGTH_DIGITS 5
+/** Longest header plus payload plus terminator */
+#define PLUGIN_LOG_MAX_RECORD_BYTES \
+    (PLUGIN_LOG_MAX_FRAME_BYTES + PLUGIN_LOG_MAX_LENGTH_DIGITS + 5u)
+
+typedef enum {
+    PLUGIN_LOG_FRAME_OK = 0,
+    /** More bytes are needed; consumed is 0 */
+    PLUGIN_LOG_FRAME_INCOMPLETE,
+    /** Not a frame; consumed skips to the next line so parsing can resync */
+    PLUGIN_LOG_FRAME_MALFORMED
+} PluginLogFrameResult;
+
+typedef struct {
+    const char* payload;
+    DWORD length;
+} PluginLogFrame;
+
+/**
+ * @brief Decode the record at the start of buffer
+ * @param consumed Receives the bytes to advance past on OK or MALFORMED
+ */
+PluginLogFrameResult PluginLogFrame_Next(const char* buffer, size_t available,
+                                         PluginLogFrame* frame, size_t* consumed);
+
+#endif /* PLUGIN_LOG_FRAME_H */
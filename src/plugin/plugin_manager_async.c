@@ -126,6 +126,16 @@ void PluginManager_RequestScanAsync(void) {
         }
     }
 
+    /* Nothing was renamed, added or removed since the last good scan, so the
+     * list is current and opening the menu needs no directory walk. */
+    if (g_asyncScanHasLastSnapshot && IsPluginFolderUnchangedSinceScan()) {
+        InterlockedExchange(&g_asyncScanPending, 0);
+        ReleaseSRWLockExclusive(&g_asyncScanLock);
+        return;
+    }
+    /* Any change from here on lands after the snapshot and re-marks it. */
+    InterlockedExchange(&g_pluginFolderDirty, 0);
+
     ReleaseSRWLockExclusive(&g_asyncScanLock);
 
     hasCurrentSnapshot = GetPluginDirSnapshot(&currentSnapshot);
@@ -143,6 +153,7 @@ void PluginManager_RequestScanAsync(void) {
 
     if (InterlockedCompareExchange(&g_asyncScanShuttingDown, 0, 0) != 0) {
         free(threadParams);
+        MarkPluginFolderDirty();
         InterlockedExchange(&g_asyncScanPending, 0);
         ReleaseSRWLockExclusive(&g_asyncScanLock);
         return;
@@ -160,6 +171,7 @@ void PluginManager_RequestScanAsync(void) {
                                                &currentSnapshot,
                                                GetTickCount())) {
         free(threadParams);
+        MarkPluginFolderDirty();
         InterlockedExchange(&g_asyncScanPending, 0);
         ReleaseSRWLockExclusive(&g_asyncScanLock);
         return;
@@ -167,6 +179,7 @@ void PluginManager_RequestScanAsync(void) {
 
     if (!threadParams) {
         MarkAsyncScanFailureLocked(hasCurrentSnapshot, &currentSnapshot);
+        MarkPluginFolderDirty();
         InterlockedExchange(&g_asyncScanPending, 0);
         ReleaseSRWLockExclusive(&g_asyncScanLock);
         return;
@@ -178,6 +191,7 @@ void PluginManager_RequestScanAsync(void) {
     } else {
         free(threadParams);
         MarkAsyncScanFailureLocked(hasCurrentSnapshot, &currentSnapshot);
+        MarkPluginFolderDirty();
         InterlockedExchange(&g_asyncScanPending, 0);
     }
 
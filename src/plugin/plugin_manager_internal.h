@@ -13,6 +13,7 @@
 #include "config/config_plugin_security.h"
 #include "dialog/dialog_plugin_security.h"
 #include "utils/natural_sort.h"
+#include "utils/directory_index.h"
 #include "utils/directory_watcher.h"
 #include "../resource/resource.h"
 #include "log.h"
@@ -53,6 +54,7 @@ extern BOOL g_asyncScanHasFailureSnapshot;
 extern BOOL g_asyncScanFailureHadSnapshot;
 extern PluginDirSnapshot g_asyncScanFailureSnapshot;
 extern volatile LONG g_asyncScanFailureCooldownUntil;
+extern volatile LONG g_pluginFolderDirty;
 extern BOOL g_pluginLocksInitialized;
 extern BOOL g_pluginProcessInitialized;
 
@@ -69,6 +71,8 @@ LONG QueueHotReloadRequestLocked(int index, const wchar_t* name,
 BOOL WideToUtf8Fixed(const wchar_t* src, char* dest, int destCount);
 BOOL PluginManager_GetPluginDirW(wchar_t* buffer, size_t bufferSize);
 void OnPluginFolderChanged(void* context);
+void MarkPluginFolderDirty(void);
+BOOL IsPluginFolderUnchangedSinceScan(void);
 void StartPluginFolderWatcher(void);
 void StopPluginFolderWatcher(void);
 wchar_t ToLowerAsciiW(wchar_t ch);
@@ -82,11 +86,9 @@ BOOL BuildRelativePathW(wchar_t* outPath, size_t outSize,
                         const wchar_t* fileName);
 BOOL AddPluginEntry(PluginScanContext* ctx, const wchar_t* pluginDir,
                     const wchar_t* fileName, const wchar_t* relativePath);
-void ScanPluginFolderRecursive(const wchar_t* pluginDir,
-                               const wchar_t* folderPath,
-                               const wchar_t* relativePath,
-                               PluginScanContext* ctx,
-                               int depth, LONG generation);
+void ScanPluginFolder(const wchar_t* pluginDir, PluginScanContext* ctx,
+                      LONG generation);
+void ResetPluginScanIndex(void);
 int ComparePluginInfo(const void* a, const void* b);
 BOOL GetFileModTime(const wchar_t* path, FILETIME* modTime);
 DWORD WINAPI HotReloadThread(LPVOID lpParam);
@@ -111,7 +113,14 @@ BOOL IsAsyncScanFailureRecentlyCachedLocked(
 void MarkAsyncScanFailureLocked(BOOL hasSnapshot,
                                 const PluginDirSnapshot* snapshot);
 void ClearAsyncScanFailureLocked(void);
-int PluginManager_ScanPluginsForGeneration(LONG generation);
+int PluginManager_ScanPluginsForGeneration(LONG generation,
+                                           const PluginDirSnapshot* snapshot);
+BOOL LoadPluginScanCache(const wchar_t* pluginDir,
+                         const PluginDirSnapshot* snapshot,
+                         PluginScanContext* ctx);
+void SavePluginScanCache(const wchar_t* pluginDir,
+                         const PluginDirSnapshot* snapshot,
+                         const PluginInfo* plugins, int count);
 DWORD WINAPI AsyncScanThread(LPVOID lpParam);
 BOOL CleanupRetiredAsyncScanThread(DWORD waitMs);
 BOOL HasRetiredAsyncScanThread(void);
@@ -33,6 +33,7 @@ void PluginManager_Init(void) {
     g_hAsyncScanThread = NULL;
     g_asyncScanHasLastSnapshot = FALSE;
     ZeroMemory(&g_asyncScanLastSnapshot, sizeof(g_asyncScanLastSnapshot));
+    MarkPluginFolderDirty();
     g_asyncScanHasFailureSnapshot = FALSE;
     g_asyncScanFailureHadSnapshot = FALSE;
     ZeroMemory(&g_asyncScanFailureSnapshot, sizeof(g_asyncScanFailureSnapshot));
@@ -115,6 +116,7 @@ void PluginManager_Shutdown(void) {
     }
 
     PluginData_Clear();
+    ResetPluginScanIndex();
 
     /* Shutdown process management once plugin state has been detached.  The
      * async scanner may still be retiring, but it no longer needs the job.
@@ -4,8 +4,11 @@
  */
 
 #include "plugin_manager_internal.h"
+#include "log/log_trace.h"
+#include "tray/tray_menu_cache.h"
 
-int PluginManager_ScanPluginsForGeneration(LONG generation) {
+int PluginManager_ScanPluginsForGeneration(LONG generation,
+                                           const PluginDirSnapshot* snapshot) {
     wchar_t pluginDir[MAX_PATH];
     if (!PluginManager_GetPluginDirW(pluginDir, MAX_PATH)) {
         return PLUGIN_SCAN_FAILED;
@@ -47,7 +50,10 @@ int PluginManager_ScanPluginsForGeneration(LONG generation) {
 
     PluginScanContext scanCtx = {0};
     scanCtx.plugins = newPlugins;
-    ScanPluginFolderRecursive(pluginDir, pluginDir, L"", &scanCtx, 0, generation);
+    BOOL fromCache = LoadPluginScanCache(pluginDir, snapshot, &scanCtx);
+    if (!fromCache) {
+        ScanPluginFolder(pluginDir, &scanCtx, generation);
+    }
     if (IsAsyncScanShuttingDown() || !IsAsyncScanGenerationCurrent(generation)) {
         scanCancelled = TRUE;
         goto cleanup;
@@ -63,8 +69,11 @@ int PluginManager_ScanPluginsForGeneration(LONG generation) {
     }
 
     // Sort plugins by display name (natural order) for consistent menu ordering
-    if (newPluginCount > 1) {
-        qsort(newPlugins, newPluginCount, sizeof(PluginInfo), ComparePluginInfo);
+    if (!fromCache) {
+        if (newPluginCount > 1) {
+            qsort(newPlugins, newPluginCount, sizeof(PluginInfo), ComparePluginInfo);
+        }
+        SavePluginScanCache(pluginDir, snapshot, newPlugins, newPluginCount);
     }
 
     if (IsAsyncScanShuttingDown() ||
@@ -149,6 +158,7 @@ int PluginManager_ScanPluginsForGeneration(LONG generation) {
                (size_t)(MAX_PLUGINS - newPluginCount) * sizeof(PluginInfo));
     }
     g_pluginCount = newPluginCount;
+    TrayMenuCache_Invalidate(TRAY_MENU_CACHE_PLUGINS);
 
     // Re-map g_lastRunningPluginIndex to new list
     if (lastRunningPath[0]) {
@@ -206,13 +216,15 @@ cleanup:
 
 int PluginManager_ScanPlugins(void) {
     LONG generation = InterlockedCompareExchange(&g_asyncScanGeneration, 0, 0);
-    return PluginManager_ScanPluginsForGeneration(generation);
+    return PluginManager_ScanPluginsForGeneration(generation, NULL);
 }
 
 DWORD WINAPI AsyncScanThread(LPVOID lpParam) {
     PluginDirSnapshot requestedSnapshot = {0};
     BOOL hasRequestedSnapshot = FALSE;
     LONG generation = 0;
+    TraceSpan_NameThread("plugin-scan");
+    TRACE_SPAN_BEGIN(scanSpan, "PluginManager.Scan");
 
     if (lpParam) {
         const AsyncScanThreadParams* params = (const AsyncScanThreadParams*)lpParam;
@@ -226,7 +238,8 @@ DWORD WINAPI AsyncScanThread(LPVOID lpParam) {
         generation = InterlockedCompareExchange(&g_asyncScanGeneration, 0, 0);
     }
 
-    int scanResult = PluginManager_ScanPluginsForGeneration(generation);
+    int scanResult = PluginManager_ScanPluginsForGeneration(
+        generation, hasRequestedSnapshot ? &requestedSnapshot : NULL);
 
     AcquireSRWLockExclusive(&g_asyncScanLock);
     if (scanResult >= 0 &&
@@ -237,13 +250,17 @@ DWORD WINAPI AsyncScanThread(LPVOID lpParam) {
             g_asyncScanHasLastSnapshot = TRUE;
         }
         ClearAsyncScanFailureLocked();
-    } else if (scanResult < 0 &&
-               !IsAsyncScanShuttingDown() &&
-               IsAsyncScanGenerationCurrent(generation)) {
-        MarkAsyncScanFailureLocked(hasRequestedSnapshot, &requestedSnapshot);
+    } else {
+        MarkPluginFolderDirty();
+        if (scanResult < 0 &&
+            !IsAsyncScanShuttingDown() &&
+            IsAsyncScanGenerationCurrent(generation)) {
+            MarkAsyncScanFailureLocked(hasRequestedSnapshot, &requestedSnapshot);
+        }
     }
     InterlockedExchange(&g_asyncScanPending, 0);
     ReleaseSRWLockExclusive(&g_asyncScanLock);
 
+    TRACE_SPAN_END(scanSpan);
     return 0;
 }
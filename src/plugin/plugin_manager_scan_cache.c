@@ -0,0 +1,183 @@
+/**
+ * @file plugin_manager_scan_cache.c
+ * @brief On-disk plugin list keyed by the plugin directory snapshot.
+ *
+ * The sorted scan result is written next to config.ini (never inside the
+ * watched plugins folder) so a start-up scan whose snapshot matches the
+ * previous session can rebuild the list without enumerating or sorting.
+ */
+
+#include "plugin_manager_internal.h"
+
+#define PLUGIN_SCAN_CACHE_FILENAME L"plugin_scan.cache"
+#define PLUGIN_SCAN_CACHE_VERSION 1u
+#define PLUGIN_SCAN_CACHE_MAX_BYTES \
+    (sizeof(PluginScanCacheHeader) + (MAX_PATH + (MAX_PLUGINS * (MAX_PATH + 1))) * sizeof(wchar_t))
+
+typedef struct {
+    char magic[4];
+    DWORD version;
+    ULONGLONG contentHash;
+    FILETIME lastWriteTime;
+    DWORD entryCount;
+    DWORD pluginCount;
+    DWORD dirChars;
+    DWORD reserved;
+} PluginScanCacheHeader;
+
+static BOOL GetPluginScanCachePath(wchar_t* path, size_t pathSize) {
+    char configPath[MAX_PATH] = {0};
+    GetConfigPath(configPath, MAX_PATH);
+    wchar_t configDir[MAX_PATH];
+    if (!configPath[0] ||
+        MultiByteToWideChar(CP_UTF8, 0, configPath, -1, configDir, MAX_PATH) <= 0) {
+        return FALSE;
+    }
+    wchar_t* slash = wcsrchr(configDir, L'\\');
+    if (!slash) return FALSE;
+    *slash = L'\0';
+    int written = _snwprintf_s(path, pathSize, _TRUNCATE, L"%s\\%s",
+                               configDir, PLUGIN_SCAN_CACHE_FILENAME);
+    return written >= 0 && (size_t)written < pathSize;
+}
+
+static BOOL IsCacheableSnapshot(const PluginDirSnapshot* snapshot) {
+    return snapshot && snapshot->exists && !snapshot->truncated;
+}
+
+static BOOL HeaderMatchesSnapshot(const PluginScanCacheHeader* header,
+                                  const PluginDirSnapshot* snapshot) {
+    return memcmp(header->magic, "CPSC", 4) == 0 &&
+           header->version == PLUGIN_SCAN_CACHE_VERSION &&
+           header->contentHash == snapshot->contentHash &&
+           header->entryCount == snapshot->entryCount &&
+           CompareFileTime(&header->lastWriteTime, &snapshot->lastWriteTime) == 0 &&
+           header->pluginCount <= MAX_PLUGINS &&
+           header->dirChars > 0 && header->dirChars < MAX_PATH;
+}
+
+/** @return TRUE when ctx was filled, already sorted, from a matching cache */
+static BOOL DecodePluginScanCache(const BYTE* data, DWORD size,
+                                  const wchar_t* pluginDir,
+                                  const PluginDirSnapshot* snapshot,
+                                  PluginScanContext* ctx) {
+    PluginScanCacheHeader header;
+    if (size < sizeof(header)) return FALSE;
+    memcpy(&header, data, sizeof(header));
+    if (!HeaderMatchesSnapshot(&header, snapshot)) return FALSE;
+
+    DWORD offset = (DWORD)sizeof(header);
+    DWORD dirBytes = header.dirChars * (DWORD)sizeof(wchar_t);
+    size_t pluginDirChars = wcslen(pluginDir);
+    if (size - offset < dirBytes || pluginDirChars != header.dirChars ||
+        _wcsnicmp((const wchar_t*)(data + offset), pluginDir, pluginDirChars) != 0) {
+        return FALSE;
+    }
+    offset += dirBytes;
+
+    for (DWORD i = 0; i < header.pluginCount; i++) {
+        WORD chars = 0;
+        if (size - offset < sizeof(chars)) return FALSE;
+        memcpy(&chars, data + offset, sizeof(chars));
+        offset += (DWORD)sizeof(chars);
+        DWORD pathBytes = (DWORD)chars * (DWORD)sizeof(wchar_t);
+        if (chars == 0 || chars >= MAX_PATH || size - offset < pathBytes) return FALSE;
+
+        wchar_t relativePath[MAX_PATH];
+        memcpy(relativePath, data + offset, pathBytes);
+        relativePath[chars] = L'\0';
+        offset += pathBytes;
+        const wchar_t* fileName = wcsrchr(relativePath, L'\\');
+        fileName = fileName ? fileName + 1 : relativePath;
+        if (!AddPluginEntry(ctx, pluginDir, fileName, relativePath)) return FALSE;
+    }
+    return offset == size;
+}
+
+BOOL LoadPluginScanCache(const wchar_t* pluginDir,
+                         const PluginDirSnapshot* snapshot,
+                         PluginScanContext* ctx) {
+    if (!pluginDir || !ctx || !IsCacheableSnapshot(snapshot)) return FALSE;
+
+    wchar_t cachePath[MAX_PATH];
+    if (!GetPluginScanCachePath(cachePath, MAX_PATH)) return FALSE;
+    HANDLE hFile = CreateFileW(cachePath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return FALSE;
+
+    BOOL loaded = FALSE;
+    LARGE_INTEGER fileSize;
+    BYTE* data = NULL;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 &&
+        fileSize.QuadPart <= (LONGLONG)PLUGIN_SCAN_CACHE_MAX_BYTES &&
+        (data = (BYTE*)malloc((size_t)fileSize.QuadPart)) != NULL) {
+        DWORD bytesRead = 0;
+        if (ReadFile(hFile, data, (DWORD)fileSize.QuadPart, &bytesRead, NULL) &&
+            bytesRead == (DWORD)fileSize.QuadPart) {
+            loaded = DecodePluginScanCache(data, bytesRead, pluginDir, snapshot, ctx);
+        }
+    }
+    free(data);
+    CloseHandle(hFile);
+
+    if (!loaded) {
+        ctx->count = 0;
+        ctx->full = FALSE;
+        return FALSE;
+    }
+    LOG_INFO("Plugin scan restored %d plugin(s) from cache", ctx->count);
+    return TRUE;
+}
+
+static BOOL WriteAll(HANDLE hFile, const void* data, DWORD size) {
+    DWORD written = 0;
+    return WriteFile(hFile, data, size, &written, NULL) && written == size;
+}
+
+void SavePluginScanCache(const wchar_t* pluginDir,
+                         const PluginDirSnapshot* snapshot,
+                         const PluginInfo* plugins, int count) {
+    if (!pluginDir || !plugins || count < 0 || count > MAX_PLUGINS ||
+        !IsCacheableSnapshot(snapshot)) {
+        return;
+    }
+    size_t dirChars = wcslen(pluginDir);
+    if (dirChars == 0 || dirChars >= MAX_PATH) return;
+
+    wchar_t cachePath[MAX_PATH];
+    wchar_t tempPath[MAX_PATH];
+    if (!GetPluginScanCachePath(cachePath, MAX_PATH) ||
+        _snwprintf_s(tempPath, MAX_PATH, _TRUNCATE, L"%s.tmp", cachePath) < 0) {
+        return;
+    }
+    HANDLE hFile = CreateFileW(tempPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return;
+
+    PluginScanCacheHeader header;
+    ZeroMemory(&header, sizeof(header));
+    memcpy(header.magic, "CPSC", 4);
+    header.version = PLUGIN_SCAN_CACHE_VERSION;
+    header.contentHash = snapshot->contentHash;
+    header.lastWriteTime = snapshot->lastWriteTime;
+    header.entryCount = snapshot->entryCount;
+    header.pluginCount = (DWORD)count;
+    header.dirChars = (DWORD)dirChars;
+
+    BOOL ok = WriteAll(hFile, &header, sizeof(header)) &&
+              WriteAll(hFile, pluginDir, (DWORD)(dirChars * sizeof(wchar_t)));
+    for (int i = 0; ok && i < count; i++) {
+        const wchar_t* relativePath = plugins[i].path + dirChars + 1;
+        size_t pathChars = wcslen(plugins[i].path);
+        WORD chars = (WORD)(pathChars > dirChars ? pathChars - dirChars - 1 : 0);
+        ok = chars > 0 &&
+             WriteAll(hFile, &chars, sizeof(chars)) &&
+             WriteAll(hFile, relativePath, (DWORD)chars * (DWORD)sizeof(wchar_t));
+    }
+    CloseHandle(hFile);
+
+    if (!ok || !MoveFileExW(tempPath, cachePath, MOVEFILE_REPLACE_EXISTING)) {
+        LOG_WARNING("Failed to write plugin scan cache (error=%lu)", GetLastError());
+        DeleteFileW(tempPath);
+    }
+}
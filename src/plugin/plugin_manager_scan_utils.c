@@ -1,6 +1,6 @@
 /**
  * @file plugin_manager_scan_utils.c
- * @brief Plugin filename filtering, hashing, and recursive enumeration.
+ * @brief Plugin filename filtering, hashing, and incremental enumeration.
  */
 
 #include "plugin_manager_internal.h"
@@ -113,111 +113,55 @@ BOOL AddPluginEntry(PluginScanContext* ctx,
     return TRUE;
 }
 
-void ScanPluginFolderRecursive(const wchar_t* pluginDir,
-                                      const wchar_t* folderPath,
-                                      const wchar_t* relativePath,
-                                      PluginScanContext* ctx,
-                                      int depth,
-                                      LONG generation) {
-    if (!ctx || ctx->full || ctx->failed ||
-        IsAsyncScanShuttingDown() ||
-        !IsAsyncScanGenerationCurrent(generation)) {
-        return;
-    }
-
-    if (depth >= MAX_PLUGIN_RECURSION_DEPTH) {
-        LOG_WARNING("Plugin scan recursion depth reached at: %ls", folderPath);
-        return;
-    }
-
-    wchar_t searchPath[MAX_PATH];
-    int written = _snwprintf_s(searchPath, MAX_PATH, _TRUNCATE,
-                               L"%s\\*", folderPath);
-    if (written < 0 || written >= MAX_PATH) {
-        LOG_WARNING("Plugin scan path is too long: %ls", folderPath);
-        ctx->failed = TRUE;
-        return;
-    }
-
-    WIN32_FIND_DATAW findData;
-    HANDLE hFind = FindFirstFileW(searchPath, &findData);
-    if (hFind == INVALID_HANDLE_VALUE) {
-        DWORD error = GetLastError();
-        if (error != ERROR_FILE_NOT_FOUND &&
-            error != ERROR_PATH_NOT_FOUND &&
-            error != ERROR_NO_MORE_FILES) {
-            LOG_WARNING("Plugin folder scan failed: %ls (error=%lu)",
-                        folderPath, error);
-            ctx->failed = TRUE;
-        }
-        return;
-    }
+/* Kept across scans so rescans only re-enumerate changed plugin folders. */
+static DirectoryIndex g_pluginDirectoryIndex;
 
-    BOOL stoppedEarly = FALSE;
-    do {
-        if (ctx->full || IsAsyncScanShuttingDown() ||
-            !IsAsyncScanGenerationCurrent(generation)) {
-            stoppedEarly = TRUE;
-            break;
-        }
-
-        if (wcscmp(findData.cFileName, L".") == 0 ||
-            wcscmp(findData.cFileName, L"..") == 0) {
-            continue;
-        }
-
-        if (++ctx->scannedEntries > MAX_PLUGIN_SCAN_ENTRIES) {
-            LOG_WARNING("Plugin directory scan limit reached (%d entries)",
-                        MAX_PLUGIN_SCAN_ENTRIES);
-            ctx->full = TRUE;
-            stoppedEarly = TRUE;
-            break;
-        }
+static BOOL AcceptPluginFile(const WIN32_FIND_DATAW* data, BYTE* metadata,
+                             void* context) {
+    (void)metadata;
+    (void)context;
+    return IsSupportedPluginFileW(data->cFileName);
+}
 
-        wchar_t childRelativePath[MAX_PATH];
-        if (!BuildRelativePathW(childRelativePath, MAX_PATH,
-                                relativePath, findData.cFileName)) {
-            LOG_WARNING("Plugin relative path is too long: %ls", findData.cFileName);
-            continue;
-        }
+static BOOL IsPluginIndexScanCanceled(void* context) {
+    const PluginScanContext* ctx = (const PluginScanContext*)context;
+    return IsAsyncScanShuttingDown() ||
+           !IsAsyncScanGenerationCurrent(ctx->generation);
+}
 
-        BOOL isDirectory =
-            (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-        if (isDirectory) {
-            if (findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
-                continue;
-            }
-
-            wchar_t childFullPath[MAX_PATH];
-            int pathWritten = _snwprintf_s(childFullPath, MAX_PATH, _TRUNCATE,
-                                           L"%s\\%s", folderPath, findData.cFileName);
-            if (pathWritten < 0 || pathWritten >= MAX_PATH) {
-                LOG_WARNING("Plugin folder path is too long: %ls", childRelativePath);
-                continue;
-            }
-
-            ScanPluginFolderRecursive(pluginDir, childFullPath, childRelativePath,
-                                      ctx, depth + 1, generation);
-            if (ctx->failed || ctx->full) {
-                stoppedEarly = TRUE;
-                break;
-            }
-        } else if (IsSupportedPluginFileW(findData.cFileName)) {
-            if (!AddPluginEntry(ctx, pluginDir, findData.cFileName,
-                                childRelativePath)) {
-                stoppedEarly = TRUE;
-                break;
-            }
-        }
-    } while (FindNextFileW(hFind, &findData));
+static BOOL AddIndexedPluginEntry(const DirectoryIndexEntry* entry,
+                                  void* context) {
+    PluginScanContext* ctx = (PluginScanContext*)context;
+    return AddPluginEntry(ctx, ctx->pluginDir,
+                          DirectoryIndex_EntryFileName(entry),
+                          entry->relativePath);
+}
 
-    DWORD findError = stoppedEarly ? ERROR_SUCCESS : GetLastError();
-    FindClose(hFind);
-    if (!stoppedEarly && findError != ERROR_NO_MORE_FILES) {
-        LOG_WARNING("Plugin folder enumeration failed: %ls (error=%lu)",
-                    folderPath, findError);
+void ScanPluginFolder(const wchar_t* pluginDir, PluginScanContext* ctx,
+                      LONG generation) {
+    if (!pluginDir || !ctx) return;
+    ctx->pluginDir = pluginDir;
+    ctx->generation = generation;
+
+    DirectoryIndex_Init(&g_pluginDirectoryIndex, MAX_PLUGIN_RECURSION_DEPTH - 1,
+                        MAX_PLUGINS, MAX_PLUGIN_SCAN_ENTRIES,
+                        AcceptPluginFile, NULL);
+    DirectoryIndexCallbacks callbacks = {
+        IsPluginIndexScanCanceled, NULL, AddIndexedPluginEntry, ctx
+    };
+    if (DirectoryIndex_Refresh(&g_pluginDirectoryIndex, pluginDir,
+                               &callbacks) == DIRECTORY_INDEX_FAILED) {
         ctx->failed = TRUE;
+        return;
     }
+    DirectoryIndexStats stats;
+    DirectoryIndex_GetStats(&g_pluginDirectoryIndex, &stats);
+    LOG_INFO("Plugin scan indexed %d plugin(s) (%lu folders read, %lu reused)",
+             ctx->count, stats.enumeratedFolders, stats.reusedFolders);
+}
+
+void ResetPluginScanIndex(void) {
+    DirectoryIndex_Free(&g_pluginDirectoryIndex);
 }
 
 /**
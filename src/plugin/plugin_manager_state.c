@@ -35,6 +35,12 @@ BOOL g_asyncScanHasFailureSnapshot = FALSE;
 BOOL g_asyncScanFailureHadSnapshot = FALSE;
 PluginDirSnapshot g_asyncScanFailureSnapshot = {0};
 volatile LONG g_asyncScanFailureCooldownUntil = 0;
+/* Cleared when a scan snapshot is taken; set by the folder watcher. */
+volatile LONG g_pluginFolderDirty = 1;
+/* Guards reads of the watcher thread handle against Stop closing it; the
+ * handle is only read while the watcher is marked live. */
+static SRWLOCK g_pluginFolderWatcherLock = SRWLOCK_INIT;
+static BOOL g_pluginFolderWatcherLive = FALSE;
 BOOL g_pluginLocksInitialized = FALSE;
 BOOL g_pluginProcessInitialized = FALSE;
 
@@ -127,8 +133,24 @@ BOOL PluginManager_GetPluginDirW(wchar_t* buffer, size_t bufferSize) {
     return TRUE;
 }
 
+void MarkPluginFolderDirty(void) {
+    InterlockedExchange(&g_pluginFolderDirty, 1);
+}
+
+/** Without a live watcher a change could go unseen, so only trust it while running. */
+BOOL IsPluginFolderUnchangedSinceScan(void) {
+    AcquireSRWLockShared(&g_pluginFolderWatcherLock);
+    HANDLE watcherThread = g_pluginFolderWatcherLive ? g_pluginFolderWatcher.thread : NULL;
+    BOOL unchanged = InterlockedCompareExchange(&g_pluginFolderDirty, 0, 0) == 0 &&
+                     watcherThread &&
+                     WaitForSingleObject(watcherThread, 0) == WAIT_TIMEOUT;
+    ReleaseSRWLockShared(&g_pluginFolderWatcherLock);
+    return unchanged;
+}
+
 void OnPluginFolderChanged(void* context) {
     (void)context;
+    MarkPluginFolderDirty();
     PluginManager_RequestScanAsync();
 }
 
@@ -139,17 +161,25 @@ void StartPluginFolderWatcher(void) {
         return;
     }
 
-    DirectoryWatcher_Start(&g_pluginFolderWatcher,
-                           pluginDir,
-                           TRUE,
-                           FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME,
-                           DIRECTORY_WATCHER_DEFAULT_DEBOUNCE_MS,
-                           OnPluginFolderChanged,
-                           NULL,
-                           "PluginFolderWatcher");
+    BOOL started = DirectoryWatcher_Start(&g_pluginFolderWatcher,
+                                          pluginDir,
+                                          TRUE,
+                                          FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME,
+                                          DIRECTORY_WATCHER_DEFAULT_DEBOUNCE_MS,
+                                          OnPluginFolderChanged,
+                                          NULL,
+                                          "PluginFolderWatcher");
+    AcquireSRWLockExclusive(&g_pluginFolderWatcherLock);
+    g_pluginFolderWatcherLive = started;
+    ReleaseSRWLockExclusive(&g_pluginFolderWatcherLock);
 }
 
+/* Not held across Stop: the watcher callback requests a scan, which reads
+ * the live flag and would otherwise deadlock against the join. */
 void StopPluginFolderWatcher(void) {
+    AcquireSRWLockExclusive(&g_pluginFolderWatcherLock);
+    g_pluginFolderWatcherLive = FALSE;
+    ReleaseSRWLockExclusive(&g_pluginFolderWatcherLock);
     DirectoryWatcher_Stop(&g_pluginFolderWatcher, ASYNC_PLUGIN_SCAN_STOP_TIMEOUT_MS);
 }
 
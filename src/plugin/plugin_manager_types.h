@@ -28,8 +28,9 @@ typedef struct {
 
 typedef struct {
     PluginInfo* plugins;
+    const wchar_t* pluginDir;
+    LONG generation;
     int count;
-    int scannedEntries;
     BOOL full;
     BOOL failed;
 } PluginScanContext;
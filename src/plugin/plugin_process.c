@@ -36,6 +36,10 @@ BOOL PluginProcess_Launch(PluginInfo* plugin) {
     args->pluginSnapshot = *plugin;
     args->readyState = PLUGIN_LAUNCH_READY_PENDING;
     args->refCount = 1;
+    LARGE_INTEGER launchStart;
+    if (QueryPerformanceCounter(&launchStart)) {
+        args->launchStartCounter = launchStart.QuadPart;
+    }
 
     HANDLE readyEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
     if (!readyEvent) {
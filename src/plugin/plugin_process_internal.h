@@ -39,6 +39,7 @@ typedef struct {
     wchar_t errorMsg[128];
     volatile LONG readyState;
     volatile LONG refCount;
+    LONGLONG launchStartCounter;
     PluginInfo pluginSnapshot;
 } PluginLauncherArgs;
 
@@ -60,6 +61,12 @@ BOOL PluginProcess_IsFileInterpreter(const wchar_t* path);
 const wchar_t* PluginProcess_GetInterpreter(const wchar_t* path);
 const wchar_t* PluginProcess_GetInterpreterName(const wchar_t* path);
 
+void PluginProcessPool_Init(void);
+void PluginProcessPool_Shutdown(void);
+BOOL PluginProcessPool_TryTake(const wchar_t* scriptPath, HANDLE job,
+                               HANDLE* processOut, DWORD* processIdOut);
+void PluginProcessPool_Refill(const wchar_t* scriptPath);
+
 void PluginProcess_TerminateTree(DWORD pid, int depth);
 void PluginProcess_TerminateAllJobProcesses(void);
 
@@ -19,9 +19,15 @@ DWORD WINAPI PluginLauncherThread(LPVOID parameter) {
     HANDLE process = NULL;
     HANDLE monitor = NULL;
     DWORD processId = 0;
+    BOOL warm = FALSE;
     const wchar_t* interpreter = PluginProcess_GetInterpreter(plugin->path);
 
-    if (interpreter) {
+    if (interpreter && PluginProcessPool_TryTake(plugin->path, args->hJob,
+                                                 &process, &processId)) {
+        /* Already in the job; assigning again would only fail on Windows 7. */
+        warm = TRUE;
+        ClosePluginLaunchJobHandle(args);
+    } else if (interpreter) {
         wchar_t commandLine[MAX_PATH * 2 + 256];
         if (_snwprintf_s(commandLine, _countof(commandLine), _TRUNCATE,
                         L"%s \"%s\"", interpreter, plugin->path) < 0) {
@@ -98,6 +104,7 @@ DWORD WINAPI PluginLauncherThread(LPVOID parameter) {
     plugin->pi.dwThreadId = 0;
     plugin->isRunning = TRUE;
     args->success = TRUE;
+    PluginData_BeginLaunchMeasurement(args->launchStartCounter, warm);
     if (!SignalPluginLaunchReady(args)) {
         PluginProcess_TerminateTree(processId, 0);
         if (monitor) CloseHandle(monitor);
@@ -105,6 +112,8 @@ DWORD WINAPI PluginLauncherThread(LPVOID parameter) {
         ReleaseAbandonedPluginLaunchArgs(args);
         return 0;
     }
+    /* Pre-spawn the next interpreter while this plugin is starting up. */
+    if (interpreter) PluginProcessPool_Refill(plugin->path);
     ReleaseAbandonedPluginLaunchArgs(args);
 
     if (monitor) {
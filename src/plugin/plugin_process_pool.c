@@ -0,0 +1,236 @@
+/**
+ * @file plugin_process_pool.c
+ * @brief Optional warm interpreters that skip cold start on plugin launch.
+ *
+ * Each idle interpreter runs a tiny bootstrap that blocks reading one
+ * UTF-8 script path from its stdin pipe, then changes to the script's
+ * folder and runs it in-process. Idle interpreters stay outside the plugin
+ * job, because every launch sweeps that job; a taken one is assigned to the
+ * job before it is given its script. If Catime exits without cleanup the
+ * pipe breaks, the bootstrap reads EOF, and the interpreter exits.
+ */
+
+#include "plugin_process_internal.h"
+#include "config.h"
+
+#define PLUGIN_POOL_PATH_UTF8_BYTES (MAX_PATH * 3 + 2)
+
+typedef enum {
+    PLUGIN_POOL_PYTHON = 0,
+    PLUGIN_POOL_POWERSHELL,
+    PLUGIN_POOL_LANGUAGE_COUNT
+} PluginPoolLanguage;
+
+typedef struct {
+    HANDLE process;
+    HANDLE stdinWrite;
+    DWORD processId;
+} WarmInterpreter;
+
+/* The interpreter and its options come from the cold launch path; only
+ * the way the script is handed over differs. */
+static const wchar_t* const kPoolExtensions[PLUGIN_POOL_LANGUAGE_COUNT] = {
+    L".py", L".ps1"
+};
+
+static const wchar_t* const kBootstrapArguments[PLUGIN_POOL_LANGUAGE_COUNT] = {
+    L"-c \"import os,sys,runpy;"
+    L"p=sys.stdin.buffer.readline().decode('utf-8').strip();"
+    L"p or sys.exit();d=os.path.dirname(p);os.chdir(d);"
+    L"sys.path.insert(0,d);sys.argv=[p];"
+    L"runpy.run_path(p,run_name='__main__')\"",
+    /* exit $LASTEXITCODE gives the script's own exit code, as -File does */
+    L"-Command \"[Console]::InputEncoding=[Text.Encoding]::UTF8;"
+    L"$p=[Console]::In.ReadLine();if(-not $p){exit};"
+    L"Set-Location -LiteralPath (Split-Path -LiteralPath $p);"
+    L"& $p;exit $LASTEXITCODE\""
+};
+
+/* Cold launches end with the option that names the script file */
+#define PLUGIN_POOL_SCRIPT_FILE_OPTION L" -File"
+
+static CRITICAL_SECTION g_poolCS;
+static BOOL g_poolInitialized = FALSE;
+static BOOL g_poolEnabled = FALSE;
+static WarmInterpreter g_warm[PLUGIN_POOL_LANGUAGE_COUNT];
+
+static int GetPoolLanguage(const wchar_t* scriptPath) {
+    const wchar_t* extension = scriptPath ? wcsrchr(scriptPath, L'.') : NULL;
+    if (!extension) return -1;
+    if (_wcsicmp(extension, L".py") == 0 ||
+        _wcsicmp(extension, L".pyw") == 0) return PLUGIN_POOL_PYTHON;
+    if (_wcsicmp(extension, L".ps1") == 0) return PLUGIN_POOL_POWERSHELL;
+    return -1;
+}
+
+static void ReleaseWarmInterpreter(WarmInterpreter* warm, BOOL terminate) {
+    if (warm->stdinWrite) CloseHandle(warm->stdinWrite);
+    if (warm->process) {
+        if (terminate) TerminateProcess(warm->process, 0);
+        CloseHandle(warm->process);
+    }
+    ZeroMemory(warm, sizeof(*warm));
+}
+
+static BOOL BuildBootstrapCommand(PluginPoolLanguage language,
+                                  wchar_t* commandLine, size_t commandChars) {
+    const wchar_t* interpreter = PluginProcess_GetInterpreter(kPoolExtensions[language]);
+    if (!interpreter) return FALSE;
+    size_t hostChars = wcslen(interpreter);
+    size_t optionChars = wcslen(PLUGIN_POOL_SCRIPT_FILE_OPTION);
+    if (hostChars > optionChars &&
+        _wcsicmp(interpreter + hostChars - optionChars,
+                 PLUGIN_POOL_SCRIPT_FILE_OPTION) == 0) {
+        hostChars -= optionChars;
+    }
+    int written = _snwprintf_s(commandLine, commandChars, _TRUNCATE, L"%.*s %s",
+                               (int)hostChars, interpreter,
+                               kBootstrapArguments[language]);
+    return written > 0;
+}
+
+/**
+ * @brief Pipe whose read end alone is inheritable
+ * @details Both ends start private; flipping inheritance off the write end
+ * after the fact would let a concurrent CreateProcess inherit it, and a
+ * leaked write end keeps the bootstrap from ever seeing EOF.
+ */
+static BOOL CreateBootstrapPipe(HANDLE* childRead, HANDLE* parentWrite) {
+    HANDLE privateRead = NULL;
+    if (!CreatePipe(&privateRead, parentWrite, NULL, 0)) return FALSE;
+    HANDLE self = GetCurrentProcess();
+    BOOL duplicated = DuplicateHandle(self, privateRead, self, childRead, 0,
+                                      TRUE, DUPLICATE_SAME_ACCESS);
+    CloseHandle(privateRead);
+    if (!duplicated) {
+        CloseHandle(*parentWrite);
+        *parentWrite = NULL;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static BOOL SpawnWarmInterpreter(PluginPoolLanguage language, WarmInterpreter* warm) {
+    wchar_t commandLine[512];
+    if (!BuildBootstrapCommand(language, commandLine, _countof(commandLine))) {
+        return FALSE;
+    }
+    HANDLE stdinRead = NULL;
+    HANDLE stdinWrite = NULL;
+    if (!CreateBootstrapPipe(&stdinRead, &stdinWrite)) return FALSE;
+
+    STARTUPINFOW startup = {0};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESHOWWINDOW | STARTF_USESTDHANDLES;
+    startup.wShowWindow = SW_HIDE;
+    startup.hStdInput = stdinRead;
+    PROCESS_INFORMATION processInfo = {0};
+    BOOL created = CreateProcessW(NULL, commandLine, NULL, NULL, TRUE,
+                                  CREATE_NO_WINDOW, NULL, NULL,
+                                  &startup, &processInfo);
+    CloseHandle(stdinRead);
+    if (!created) {
+        LOG_WARNING("[Pool] Failed to pre-spawn interpreter %d: %lu",
+                    (int)language, GetLastError());
+        CloseHandle(stdinWrite);
+        return FALSE;
+    }
+    CloseHandle(processInfo.hThread);
+    warm->process = processInfo.hProcess;
+    warm->stdinWrite = stdinWrite;
+    warm->processId = processInfo.dwProcessId;
+    return TRUE;
+}
+
+static BOOL IsWarmInterpreterAlive(const WarmInterpreter* warm) {
+    return warm->process && WaitForSingleObject(warm->process, 0) == WAIT_TIMEOUT;
+}
+
+void PluginProcessPool_Init(void) {
+    if (!g_poolInitialized) {
+        InitializeCriticalSection(&g_poolCS);
+        ZeroMemory(g_warm, sizeof(g_warm));
+        g_poolInitialized = TRUE;
+    }
+    char configPath[MAX_PATH];
+    GetConfigPath(configPath, MAX_PATH);
+    EnterCriticalSection(&g_poolCS);
+    g_poolEnabled = ReadIniBool(INI_SECTION_OPTIONS, "PLUGIN_WARM_POOL",
+                                FALSE, configPath);
+    LeaveCriticalSection(&g_poolCS);
+    if (g_poolEnabled) {
+        LOG_INFO("[Pool] Warm interpreter pool enabled");
+    }
+}
+
+void PluginProcessPool_Shutdown(void) {
+    if (!g_poolInitialized) return;
+    EnterCriticalSection(&g_poolCS);
+    for (int i = 0; i < PLUGIN_POOL_LANGUAGE_COUNT; i++) {
+        ReleaseWarmInterpreter(&g_warm[i], TRUE);
+    }
+    /* The lock stays alive: a launcher thread may still be refilling. */
+    g_poolEnabled = FALSE;
+    LeaveCriticalSection(&g_poolCS);
+}
+
+BOOL PluginProcessPool_TryTake(const wchar_t* scriptPath, HANDLE job,
+                               HANDLE* processOut, DWORD* processIdOut) {
+    int language = GetPoolLanguage(scriptPath);
+    if (language < 0 || !g_poolInitialized || !processOut || !processIdOut) {
+        return FALSE;
+    }
+
+    char pathUtf8[PLUGIN_POOL_PATH_UTF8_BYTES];
+    int pathBytes = WideCharToMultiByte(CP_UTF8, 0, scriptPath, -1, pathUtf8,
+                                        (int)sizeof(pathUtf8) - 1, NULL, NULL);
+    if (pathBytes <= 1) return FALSE;
+    pathUtf8[pathBytes - 1] = '\n';
+
+    WarmInterpreter warm;
+    EnterCriticalSection(&g_poolCS);
+    warm = g_warm[language];
+    ZeroMemory(&g_warm[language], sizeof(g_warm[language]));
+    LeaveCriticalSection(&g_poolCS);
+    if (!IsWarmInterpreterAlive(&warm)) {
+        ReleaseWarmInterpreter(&warm, TRUE);
+        return FALSE;
+    }
+
+    if (job && !AssignProcessToJobObject(job, warm.process)) {
+        LOG_WARNING("[Pool] Failed to assign warm interpreter to Job: %lu",
+                    GetLastError());
+    }
+    DWORD written = 0;
+    BOOL sent = WriteFile(warm.stdinWrite, pathUtf8, (DWORD)pathBytes,
+                          &written, NULL) && written == (DWORD)pathBytes;
+    CloseHandle(warm.stdinWrite);
+    warm.stdinWrite = NULL;
+    if (!sent) {
+        ReleaseWarmInterpreter(&warm, TRUE);
+        return FALSE;
+    }
+    *processOut = warm.process;
+    *processIdOut = warm.processId;
+    return TRUE;
+}
+
+void PluginProcessPool_Refill(const wchar_t* scriptPath) {
+    int language = GetPoolLanguage(scriptPath);
+    if (language < 0 || !g_poolInitialized) return;
+
+    EnterCriticalSection(&g_poolCS);
+    BOOL needed = g_poolEnabled && !IsWarmInterpreterAlive(&g_warm[language]);
+    if (needed) ReleaseWarmInterpreter(&g_warm[language], TRUE);
+    LeaveCriticalSection(&g_poolCS);
+    if (!needed) return;
+
+    WarmInterpreter warm = {0};
+    if (!SpawnWarmInterpreter((PluginPoolLanguage)language, &warm)) return;
+
+    EnterCriticalSection(&g_poolCS);
+    BOOL keep = g_poolEnabled && !g_warm[language].process;
+    if (keep) g_warm[language] = warm;
+    LeaveCriticalSection(&g_poolCS);
+    if (!keep) ReleaseWarmInterpreter(&warm, TRUE);
+}
@@ -96,11 +96,13 @@ BOOL PluginProcess_Init(void) {
         g_pluginJob = NULL;
         return FALSE;
     }
+    PluginProcessPool_Init();
     return TRUE;
 }
 
 void PluginProcess_Shutdown(void) {
     g_pluginNotifyWindow = NULL;
+    PluginProcessPool_Shutdown();
     if (g_pluginJob) {
         CloseHandle(g_pluginJob);
         g_pluginJob = NULL;
@@ -257,6 +257,22 @@ BOOL SystemMonitor_GetNetSpeed(float* outUpBytesPerSec,
     return available;
 }
 
+int SystemMonitor_QueryHistory(SystemMonitorMetric metric,
+                               ULONGLONG fromTick, ULONGLONG toTick,
+                               MetricHistoryPoint* points, int pointCount) {
+    if (!points || pointCount <= 0) return 0;
+    if (metric < 0 || metric >= SYSTEM_MONITOR_METRIC_COUNT) {
+        ZeroMemory(points, (size_t)pointCount * sizeof(*points));
+        return 0;
+    }
+    AcquireSRWLockShared(&g_monitorStateLock);
+    int filled = MetricHistory_Query(
+        Monitor_IsInitialized() != 0 ? &g_monitorState.history[metric] : NULL,
+        fromTick, toTick, points, pointCount);
+    ReleaseSRWLockShared(&g_monitorStateLock);
+    return filled;
+}
+
 BOOL SystemMonitor_GetBatteryPercent(int* outPercent) {
     if (!outPercent) return FALSE;
     SYSTEM_POWER_STATUS status;
@@ -96,18 +96,23 @@ void Monitor_RefreshBasicCacheIfNeeded(void) {
 
     float cpuPercent = 0.0f;
     CpuSampleResult cpuResult = SampleCpuUsage(&cpuPercent);
+    float memoryPercent = 0.0f;
+    BOOL memorySampled = SampleMemoryUsage(&memoryPercent);
+    ULONGLONG sampleTick = Monitor_GetTickMs();
+
     if (cpuResult == CPU_SAMPLE_OK) {
         g_monitorState.cpu.cachedPercent = cpuPercent;
         g_monitorState.cpu.sampleAvailable = TRUE;
+        MetricHistory_Insert(&g_monitorState.history[SYSTEM_MONITOR_METRIC_CPU],
+                             sampleTick, cpuPercent);
     }
-
-    float memoryPercent = 0.0f;
-    if (SampleMemoryUsage(&memoryPercent)) {
+    if (memorySampled) {
         g_monitorState.memory.cachedPercent = memoryPercent;
         g_monitorState.memory.sampleAvailable = TRUE;
+        MetricHistory_Insert(&g_monitorState.history[SYSTEM_MONITOR_METRIC_MEMORY],
+                             sampleTick, memoryPercent);
     }
 
-    ULONGLONG sampleTick = Monitor_GetTickMs();
     g_monitorState.cpu.lastUpdateTick = sampleTick;
     g_monitorState.memory.lastUpdateTick = sampleTick;
     Monitor_AdvanceSnapshotRevision();
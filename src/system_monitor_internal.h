@@ -78,6 +78,7 @@ typedef struct {
     NetworkState network;
     DWORD updateIntervalMs;
     ULONGLONG snapshotRevision;
+    MetricHistory history[SYSTEM_MONITOR_METRIC_COUNT];
 } SystemMonitorState;
 
 extern volatile LONG g_monitorInitialized;
@@ -106,6 +106,12 @@ void Monitor_ApplyNetworkSample(const NetInterfaceCounter* counters,
             up <= MONITOR_MAX_REASONABLE_RATE_BPS) {
             g_monitorState.network.cachedDownBps = (float)down;
             g_monitorState.network.cachedUpBps = (float)up;
+            MetricHistory_Insert(
+                &g_monitorState.history[SYSTEM_MONITOR_METRIC_UPLOAD],
+                now, (float)up);
+            MetricHistory_Insert(
+                &g_monitorState.history[SYSTEM_MONITOR_METRIC_DOWNLOAD],
+                now, (float)down);
         } else {
             g_monitorState.network.cachedDownBps = 0.0f;
             g_monitorState.network.cachedUpBps = 0.0f;
@@ -5,6 +5,7 @@
 
 #include "taskbar_monitor_internal.h"
 
+#include "drawing/drawing_dib_pool.h"
 #include "drawing/system_ui_font.h"
 #include "log.h"
 
@@ -121,27 +122,17 @@ BOOL TaskbarMonitor_Present(
     int height = client.bottom - client.top;
     if (width <= 0 || height <= 0) return FALSE;
 
+    /* Exact size: the pixel passes treat width as the stride */
     HDC screenDc = GetDC(NULL);
-    HDC sourceDc = screenDc ? CreateCompatibleDC(screenDc) : NULL;
-    BITMAPINFO bitmapInfo = {0};
-    bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bitmapInfo.bmiHeader.biWidth = width;
-    bitmapInfo.bmiHeader.biHeight = -height;
-    bitmapInfo.bmiHeader.biPlanes = 1;
-    bitmapInfo.bmiHeader.biBitCount = 32;
-    bitmapInfo.bmiHeader.biCompression = BI_RGB;
-    DWORD* pixels = NULL;
-    HBITMAP bitmap = sourceDc ? CreateDIBSection(
-        sourceDc, &bitmapInfo, DIB_RGB_COLORS, (void**)&pixels, NULL, 0) : NULL;
-    if (!bitmap || !pixels) {
-        if (bitmap) DeleteObject(bitmap);
-        if (sourceDc) DeleteDC(sourceDc);
+    DibSurface surface = {0};
+    if (!screenDc || !DibPool_Acquire(width, height, DIB_POOL_EXACT, &surface)) {
         if (screenDc) ReleaseDC(NULL, screenDc);
         return FALSE;
     }
+    HDC sourceDc = surface.dc;
+    DWORD* pixels = (DWORD*)surface.bits;
 
     size_t pixelCount = (size_t)width * (size_t)height;
-    HGDIOBJ oldBitmap = SelectObject(sourceDc, bitmap);
     HFONT font = g_taskbarMonitor.font
         ? g_taskbarMonitor.font : (HFONT)GetStockObject(DEFAULT_GUI_FONT);
     HGDIOBJ oldFont = SelectObject(sourceDc, font);
@@ -151,6 +142,8 @@ BOOL TaskbarMonitor_Present(
     BOOL presented = FALSE;
     if (g_taskbarMonitor.compositionMode != TASKBAR_COMPOSITION_COLOR_KEY) {
         FillPixels(pixels, pixelCount, 0x00ffffffu);
+        TaskbarMonitor_DrawMetricSparklines(
+            pixels, width, height, metrics, metricCount);
         SetTextColor(sourceDc, RGB(0, 0, 0));
         TaskbarMonitor_DrawMetricGrid(
             sourceDc, width, height, metrics, metricCount);
@@ -210,9 +203,7 @@ BOOL TaskbarMonitor_Present(
     }
 
     SelectObject(sourceDc, oldFont);
-    SelectObject(sourceDc, oldBitmap);
-    DeleteObject(bitmap);
-    DeleteDC(sourceDc);
+    DibPool_Release(&surface);
     ReleaseDC(NULL, screenDc);
     return presented;
 }
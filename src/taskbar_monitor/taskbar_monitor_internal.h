@@ -22,6 +22,10 @@
 #define TASKBAR_MONITOR_CELL_PADDING 1
 #define TASKBAR_MONITOR_COLUMN_GAP 2
 #define TASKBAR_MONITOR_GROUP_GAP 2
+#define TASKBAR_MONITOR_SPARKLINE_SPAN_MS 60000ULL
+#define TASKBAR_MONITOR_SPARKLINE_POINTS 60
+/** @brief Mask darkness of full sparkline coverage, kept below text */
+#define TASKBAR_MONITOR_SPARKLINE_STRENGTH 90
 
 typedef enum {
     TASKBAR_HOST_NONE = 0,
@@ -43,6 +47,9 @@ typedef enum {
 typedef struct {
     TaskbarMetricGroup group;
     int row;
+    BOOL hasHistory;
+    SystemMonitorMetric historyMetric;
+    float historyScale;
     wchar_t label[TASKBAR_MONITOR_LABEL_LENGTH];
     wchar_t value[TASKBAR_MONITOR_VALUE_LENGTH];
 } TaskbarMetricText;
@@ -163,6 +170,12 @@ void TaskbarMonitor_ColorizeTextMask(
 void TaskbarMonitor_DrawMetricGrid(
     HDC dc, int width, int height,
     const TaskbarMetricText* metrics, int metricCount);
+BOOL TaskbarMonitor_GetMetricCell(
+    int width, int height, const TaskbarMetricText* metrics,
+    int metricCount, int index, RECT* cell);
+void TaskbarMonitor_DrawMetricSparklines(
+    DWORD* pixels, int width, int height,
+    const TaskbarMetricText* metrics, int metricCount);
 
 void TaskbarMonitor_RestoreClassicTaskList(void);
 BOOL TaskbarMonitor_ReserveClassicSlot(RECT* monitorRect);
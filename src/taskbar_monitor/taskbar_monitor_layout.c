@@ -99,6 +99,36 @@ static void GetPreviewContentBounds(int width, int height, RECT* bounds) {
     }
 }
 
+static void GetMetricCellInContent(
+    int width, int height, const TaskbarMetricText* metrics,
+    int metricCount, int index, RECT* cell) {
+    if (g_taskbarMonitor.horizontal) {
+        int left;
+        int right;
+        GetHorizontalGroupBounds(
+            metrics[index].group, width, &left, &right);
+        int row = metrics[index].row;
+        SetRect(cell, left, height * row / 2,
+                right, height * (row + 1) / 2);
+    } else {
+        SetRect(cell, 0, height * index / metricCount,
+                width, height * (index + 1) / metricCount);
+    }
+}
+
+BOOL TaskbarMonitor_GetMetricCell(
+    int width, int height, const TaskbarMetricText* metrics,
+    int metricCount, int index, RECT* cell) {
+    if (!metrics || !cell || index < 0 || index >= metricCount) return FALSE;
+    RECT content = {0};
+    GetPreviewContentBounds(width, height, &content);
+    GetMetricCellInContent(content.right - content.left,
+                           content.bottom - content.top,
+                           metrics, metricCount, index, cell);
+    OffsetRect(cell, content.left, content.top);
+    return TRUE;
+}
+
 void TaskbarMonitor_DrawMetricGrid(
     HDC dc, int width, int height,
     const TaskbarMetricText* metrics, int metricCount) {
@@ -114,27 +144,10 @@ void TaskbarMonitor_DrawMetricGrid(
         width = content.right - content.left;
         height = content.bottom - content.top;
     }
-    if (g_taskbarMonitor.horizontal) {
-        for (int i = 0; i < metricCount; ++i) {
-            int left;
-            int right;
-            GetHorizontalGroupBounds(
-                metrics[i].group, width, &left, &right);
-            int row = metrics[i].row;
-            RECT cell = {
-                left,
-                height * row / 2,
-                right,
-                height * (row + 1) / 2
-            };
-            DrawMetricRow(dc, &cell, &metrics[i]);
-        }
-    } else {
-        for (int i = 0; i < metricCount; ++i) {
-            RECT cell = {0, height * i / metricCount,
-                         width, height * (i + 1) / metricCount};
-            DrawMetricRow(dc, &cell, &metrics[i]);
-        }
+    for (int i = 0; i < metricCount; ++i) {
+        RECT cell;
+        GetMetricCellInContent(width, height, metrics, metricCount, i, &cell);
+        DrawMetricRow(dc, &cell, &metrics[i]);
     }
     if (savedDc != 0) RestoreDC(dc, savedDc);
 }
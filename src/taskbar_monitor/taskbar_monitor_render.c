@@ -84,6 +84,14 @@ static void SetMetricText(
     wcsncpy_s(metric->value, _countof(metric->value), value, _TRUNCATE);
 }
 
+static void SetMetricHistory(TaskbarMetricText* metric,
+                             SystemMonitorMetric source, float scale) {
+    if (!metric) return;
+    metric->hasHistory = TRUE;
+    metric->historyMetric = source;
+    metric->historyScale = scale;
+}
+
 static int RoundPercent(float percent) {
     if (percent < 0.0f) return 0;
     if (percent > 100.0f) return 100;
@@ -103,9 +111,13 @@ static int BuildMetricTexts(TaskbarMetricText* metrics) {
                    download, _countof(download));
         SetMetricText(&metrics[metricCount], TASKBAR_METRIC_GROUP_NETWORK,
                       0, L"\x2191:", upload);
+        SetMetricHistory(&metrics[metricCount],
+                         SYSTEM_MONITOR_METRIC_UPLOAD, 0.0f);
         ++metricCount;
         SetMetricText(&metrics[metricCount], TASKBAR_METRIC_GROUP_NETWORK,
                       1, L"\x2193:", download);
+        SetMetricHistory(&metrics[metricCount],
+                         SYSTEM_MONITOR_METRIC_DOWNLOAD, 0.0f);
         ++metricCount;
     }
     if (g_taskbarMonitor.cpuMemoryEnabled) {
@@ -126,9 +138,13 @@ static int BuildMetricTexts(TaskbarMetricText* metrics) {
         }
         SetMetricText(&metrics[metricCount], TASKBAR_METRIC_GROUP_RESOURCE,
                       0, g_taskbarMonitor.cpuLabel, cpu);
+        SetMetricHistory(&metrics[metricCount],
+                         SYSTEM_MONITOR_METRIC_CPU, 100.0f);
         ++metricCount;
         SetMetricText(&metrics[metricCount], TASKBAR_METRIC_GROUP_RESOURCE,
                       1, g_taskbarMonitor.memoryLabel, memory);
+        SetMetricHistory(&metrics[metricCount],
+                         SYSTEM_MONITOR_METRIC_MEMORY, 100.0f);
         ++metricCount;
     }
     return metricCount;
@@ -0,0 +1,68 @@
+/**
+ * @file taskbar_monitor_sparkline.c
+ * @brief Recent-history graphs behind each taskbar metric row.
+ *
+ * Graphs are drawn into the text mask before the text, as light grey, so
+ * the per-pixel colorize pass turns them into faint text-colored fills and
+ * the numbers stay on top. The color-key fallback has no partial coverage
+ * and therefore draws no graphs.
+ */
+
+#include "taskbar_monitor_internal.h"
+
+#include "drawing/drawing_sparkline.h"
+
+#include <stdlib.h>
+
+static void DarkenMask(DWORD* pixels, int width, const RECT* cell,
+                       const BYTE* coverage) {
+    int cellWidth = cell->right - cell->left;
+    int cellHeight = cell->bottom - cell->top;
+    for (int y = 0; y < cellHeight; ++y) {
+        DWORD* row = pixels + (size_t)(cell->top + y) * (size_t)width + cell->left;
+        const BYTE* source = coverage + (size_t)y * (size_t)cellWidth;
+        for (int x = 0; x < cellWidth; ++x) {
+            if (source[x] == 0) continue;
+            DWORD shade = 255u - (DWORD)source[x] *
+                TASKBAR_MONITOR_SPARKLINE_STRENGTH / 255u;
+            if (shade < (row[x] & 0xffu)) {
+                row[x] = (shade << 16) | (shade << 8) | shade;
+            }
+        }
+    }
+}
+
+void TaskbarMonitor_DrawMetricSparklines(
+    DWORD* pixels, int width, int height,
+    const TaskbarMetricText* metrics, int metricCount) {
+    if (!pixels || !metrics || width <= 0 || height <= 0) return;
+    ULONGLONG now = GetTickCount64();
+    ULONGLONG from = now > TASKBAR_MONITOR_SPARKLINE_SPAN_MS
+        ? now - TASKBAR_MONITOR_SPARKLINE_SPAN_MS : 0;
+    RECT bounds = {0, 0, width, height};
+
+    for (int i = 0; i < metricCount; ++i) {
+        if (!metrics[i].hasHistory) continue;
+        RECT cell;
+        if (!TaskbarMonitor_GetMetricCell(width, height, metrics,
+                                          metricCount, i, &cell) ||
+            !IntersectRect(&cell, &cell, &bounds)) {
+            continue;
+        }
+
+        MetricHistoryPoint points[TASKBAR_MONITOR_SPARKLINE_POINTS];
+        if (SystemMonitor_QueryHistory(metrics[i].historyMetric, from, now + 1,
+                                       points, _countof(points)) == 0) {
+            continue;
+        }
+        int cellWidth = cell.right - cell.left;
+        int cellHeight = cell.bottom - cell.top;
+        BYTE* coverage = malloc((size_t)cellWidth * (size_t)cellHeight);
+        if (!coverage) continue;
+        Sparkline_RasterizeCoverage(coverage, cellWidth, cellHeight,
+                                    points, _countof(points),
+                                    metrics[i].historyScale);
+        DarkenMask(pixels, width, &cell, coverage);
+        free(coverage);
+    }
+}
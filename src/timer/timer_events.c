@@ -48,6 +48,9 @@ BOOL TimerEvents_HandleFontValidation(HWND hwnd) {
     if (CheckAndReloadCurrentFontPath()) {
         InvalidateRect(hwnd, NULL, TRUE);
     }
+    /* The pool only trims on acquire and release; this tick never stops,
+     * so surfaces left idle after the last paint are still destroyed */
+    DibPool_Trim(DIB_POOL_IDLE_TRIM_MS);
 
     if (!SetTimer(hwnd, TIMER_ID_FONT_VALIDATION,
                   FONT_CHECK_INTERVAL_MS, NULL)) {
@@ -21,6 +21,7 @@
 #include "config/config_defaults.h"
 #include "window.h"
 #include "drawing.h"
+#include "drawing/drawing_dib_pool.h"
 #include "menu_preview.h"
 #include "audio_player.h"
 #include "drag_scale.h"
@@ -36,6 +37,8 @@
 #define RETRY_INTERVAL_MS 1500
 #define FONT_CHECK_INTERVAL_MS 2000
 #define MESSAGE_BUFFER_SIZE 256
+/* Countdowns warm the notification sound this long before they expire */
+#define NOTIFICATION_SOUND_PREWARM_LEAD_MS 3000
 
 /* Monotonic time source is implemented by timer.c. */
 int64_t GetAbsoluteTimeMs(void);
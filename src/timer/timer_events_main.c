@@ -4,6 +4,10 @@
  */
 
 #include "timer_events_internal.h"
+#include "config/config_published.h"
+#include "log/log_trace.h"
+
+#include <string.h>
 
 BOOL TimerEvents_ShouldRenderMainTimer(void) {
     g_visibleTimerCurrentText[0] = L'\0';
@@ -33,6 +37,9 @@ BOOL TimerEvents_ShouldCheckActiveTimerRender(int currentElapsedSecond,
 }
 
 void Timer_NotifyMainWindowPainted(const wchar_t* timerText) {
+    if (!g_hasLastPaintedTimerText) {
+        TraceSpan_Instant("FirstPresentedFrame");
+    }
     TimerRenderCache_CommitPaint(g_lastPaintedTimerText,
                                  _countof(g_lastPaintedTimerText),
                                  &g_hasLastPaintedTimerText,
@@ -58,8 +65,15 @@ void TimerEvents_HandleCountdownCompletion(HWND hwnd) {
                         CLOCK_TIMEOUT_ACTION != TIMEOUT_ACTION_OPEN_WEBSITE;
 
     if (shouldNotify) {
-        TimerEvents_ShowTimeoutNotification(
-            hwnd, g_AppConfig.notification.messages.timeout_message, TRUE);
+        /* Copy out so the pin is not held across a modal notification */
+        char timeoutMessage[NOTIFICATION_MESSAGE_BUFFER_SIZE];
+        const PublishedConfig* published = PublishedConfig_Acquire();
+        strncpy_s(timeoutMessage, sizeof(timeoutMessage),
+                  published->version != 0 ? published->config.timeoutMessage
+                      : g_AppConfig.notification.messages.timeout_message,
+                  _TRUNCATE);
+        PublishedConfig_Release(published);
+        TimerEvents_ShowTimeoutNotification(hwnd, timeoutMessage, TRUE);
     }
 
     if (!TimerEvents_IsActivePomodoroTimer()) {
@@ -78,6 +92,16 @@ void TimerEvents_HandleCountdownCompletion(HWND hwnd) {
     }
 }
 
+static void PrewarmNotificationSoundNearDeadline(HWND hwnd, int64_t remainingMs) {
+    static int64_t s_prewarmedTarget = 0;
+    if (remainingMs <= 0 || remainingMs > NOTIFICATION_SOUND_PREWARM_LEAD_MS ||
+        s_prewarmedTarget == g_target_end_time) {
+        return;
+    }
+    s_prewarmedTarget = g_target_end_time;
+    PrewarmNotificationSound(hwnd, (DWORD)remainingMs);
+}
+
 static BOOL HandleMainTimer(HWND hwnd) {
     static DWORD s_lastTopmostCheck = 0;
     static UINT s_lastDesiredInterval = 0;
@@ -126,6 +150,7 @@ static BOOL HandleMainTimer(HWND hwnd) {
     } else {
         int64_t remainingMs = g_target_end_time - currentTimeMs;
         if (remainingMs < 0) remainingMs = 0;
+        if (CLOCK_TOTAL_TIME > 0) PrewarmNotificationSoundNearDeadline(hwnd, remainingMs);
         int remainingSecRounded = (int)((remainingMs + 999) / 1000);
         currentElapsedSec = CLOCK_TOTAL_TIME - remainingSecRounded;
         if (currentElapsedSec > CLOCK_TOTAL_TIME) {
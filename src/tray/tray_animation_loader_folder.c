@@ -4,6 +4,7 @@
  */
 
 #include "tray_animation_loader_internal.h"
+#include "utils/directory_index.h"
 #include <wctype.h>
 
 static int CompareFolderFiles(const void* left, const void* right) {
@@ -15,102 +16,139 @@ static int CompareFolderFiles(const void* left, const void* right) {
     return NaturalCompareW(a->name, b->name);
 }
 
-static void ExtractSortNumber(AnimationFolderFile* file, size_t nameLength) {
-    file->hasNumber = 0;
-    file->number = 0;
+typedef struct {
+    int hasNumber;
+    int number;
+} FolderFrameSortKey;
+
+typedef struct {
+    const wchar_t* folder;
+    AnimationFolderFile* files;
+    int count;
+    HANDLE cancelEvent;
+} FolderScanContext;
+
+/* Frame folders are often reloaded unchanged; the index skips re-enumeration
+ * and keeps each frame's parsed sort number between loads. A few folders
+ * keep their own index so animations that alternate stay incremental. */
+#define FOLDER_FRAME_INDEX_SLOTS 4
+
+typedef struct {
+    DirectoryIndex index;
+    wchar_t folder[MAX_PATH];
+    ULONGLONG lastUsed;
+} FolderFrameIndexSlot;
+
+static FolderFrameIndexSlot g_folderFrameIndexes[FOLDER_FRAME_INDEX_SLOTS];
+static SRWLOCK g_folderFrameIndexLock = SRWLOCK_INIT;
+static ULONGLONG g_folderFrameIndexClock = 0;
+
+/** @brief Index already holding folder, else the least recently used one */
+static DirectoryIndex* AcquireFolderFrameIndex(const wchar_t* folder) {
+    AcquireSRWLockExclusive(&g_folderFrameIndexLock);
+    FolderFrameIndexSlot* slot = &g_folderFrameIndexes[0];
+    for (int i = 0; i < FOLDER_FRAME_INDEX_SLOTS; i++) {
+        FolderFrameIndexSlot* candidate = &g_folderFrameIndexes[i];
+        if (_wcsicmp(candidate->folder, folder) == 0) {
+            slot = candidate;
+            break;
+        }
+        if (candidate->lastUsed < slot->lastUsed) slot = candidate;
+    }
+    wcsncpy_s(slot->folder, MAX_PATH, folder, _TRUNCATE);
+    slot->lastUsed = ++g_folderFrameIndexClock;
+    ReleaseSRWLockExclusive(&g_folderFrameIndexLock);
+    return &slot->index;
+}
+
+static void ExtractSortNumber(const wchar_t* name, size_t nameLength,
+                              FolderFrameSortKey* key) {
+    key->hasNumber = 0;
+    key->number = 0;
     for (size_t i = 0; i < nameLength; ++i) {
-        if (!iswdigit(file->name[i])) continue;
-        file->hasNumber = 1;
-        while (i < nameLength && iswdigit(file->name[i])) {
-            int digit = file->name[i] - L'0';
-            file->number = file->number <= (INT_MAX - digit) / 10
-                ? file->number * 10 + digit : INT_MAX;
+        if (!iswdigit(name[i])) continue;
+        key->hasNumber = 1;
+        while (i < nameLength && iswdigit(name[i])) {
+            int digit = name[i] - L'0';
+            key->number = key->number <= (INT_MAX - digit) / 10
+                ? key->number * 10 + digit : INT_MAX;
             ++i;
         }
         break;
     }
 }
 
-static BOOL AddFolderFile(AnimationFolderFile** files, int* count,
-                          int* capacity, const wchar_t* folder,
-                          const WIN32_FIND_DATAW* data) {
+static BOOL AcceptFolderFrame(const WIN32_FIND_DATAW* data, BYTE* metadata,
+                              void* context) {
+    (void)context;
     const wchar_t* extension = wcsrchr(data->cFileName, L'.');
-    if (!AnimationLoader_IsSupportedFolderExtension(extension)) return TRUE;
+    if (!AnimationLoader_IsSupportedFolderExtension(extension)) return FALSE;
     if (!AnimationLoader_IsFindDataSizeAllowed(data)) {
         WriteLog(LOG_LEVEL_WARNING,
                  "Skipping oversized folder animation frame: %ls (%llu bytes)",
                  data->cFileName,
                  ((ULONGLONG)data->nFileSizeHigh << 32) |
                     data->nFileSizeLow);
-        return TRUE;
+        return FALSE;
     }
     size_t nameLength = (size_t)(extension - data->cFileName);
-    if (!nameLength || nameLength >= MAX_PATH) return TRUE;
+    if (!nameLength || nameLength >= MAX_PATH) return FALSE;
 
-    if (*count >= *capacity) {
-        if (*capacity >= ANIMATION_LOADER_MAX_FOLDER_FRAMES) return FALSE;
-        int newCapacity = *capacity * 2;
-        if (newCapacity > ANIMATION_LOADER_MAX_FOLDER_FRAMES) {
-            newCapacity = ANIMATION_LOADER_MAX_FOLDER_FRAMES;
-        }
-        AnimationFolderFile* resized = (AnimationFolderFile*)realloc(
-            *files, sizeof(**files) * (size_t)newCapacity);
-        if (!resized) return FALSE;
-        *files = resized;
-        *capacity = newCapacity;
-    }
+    FolderFrameSortKey key;
+    ExtractSortNumber(data->cFileName, nameLength, &key);
+    memcpy(metadata, &key, sizeof(key));
+    return TRUE;
+}
+
+static BOOL IsFolderScanCanceled(void* context) {
+    return AnimationLoader_IsCanceled(((FolderScanContext*)context)->cancelEvent);
+}
+
+static BOOL AddFolderFile(const DirectoryIndexEntry* entry, void* context) {
+    FolderScanContext* ctx = (FolderScanContext*)context;
+    const wchar_t* fileName = DirectoryIndex_EntryFileName(entry);
+    const wchar_t* extension = wcsrchr(fileName, L'.');
+    if (ctx->count >= ANIMATION_LOADER_MAX_FOLDER_FRAMES) return FALSE;
+    if (!extension) return TRUE;
 
-    AnimationFolderFile* file = &(*files)[*count];
+    AnimationFolderFile* file = &ctx->files[ctx->count];
     ZeroMemory(file, sizeof(*file));
-    wcsncpy(file->name, data->cFileName, nameLength);
+    size_t nameLength = (size_t)(extension - fileName);
+    wcsncpy(file->name, fileName, nameLength);
     file->name[nameLength] = L'\0';
     if (_snwprintf_s(file->path, MAX_PATH, _TRUNCATE,
-                     L"%s\\%s", folder, data->cFileName) < 0) {
+                     L"%s\\%s", ctx->folder, fileName) < 0) {
         return TRUE;
     }
-    ExtractSortNumber(file, nameLength);
-    ++*count;
+    FolderFrameSortKey key;
+    memcpy(&key, entry->metadata, sizeof(key));
+    file->hasNumber = key.hasNumber;
+    file->number = key.number;
+    ++ctx->count;
     return TRUE;
 }
 
 static BOOL ScanFolderFiles(const wchar_t* folder,
-                            AnimationFolderFile** files,
+                            AnimationFolderFile* files,
                             int* count, HANDLE cancelEvent) {
-    wchar_t search[MAX_PATH] = {0};
-    if (_snwprintf_s(search, MAX_PATH, _TRUNCATE,
-                     L"%s\\*", folder) < 0) return FALSE;
-    WIN32_FIND_DATAW data;
-    HANDLE find = FindFirstFileW(search, &data);
-    if (find == INVALID_HANDLE_VALUE) return TRUE;
-
-    int capacity = 64;
-    int scanned = 0;
-    BOOL result = TRUE;
-    do {
-        if (AnimationLoader_IsCanceled(cancelEvent)) {
-            result = FALSE;
-            break;
-        }
-        if (++scanned > ANIMATION_LOADER_MAX_SCAN_ENTRIES) {
-            WriteLog(LOG_LEVEL_WARNING,
-                     "Folder animation scan limit reached (%d), ignoring remaining files",
-                     ANIMATION_LOADER_MAX_SCAN_ENTRIES);
-            break;
-        }
-        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
-        if (!AddFolderFile(files, count, &capacity, folder, &data)) {
-            if (*count >= ANIMATION_LOADER_MAX_FOLDER_FRAMES) {
-                WriteLog(LOG_LEVEL_WARNING,
-                         "Folder animation frame limit reached (%d), ignoring remaining files",
-                         ANIMATION_LOADER_MAX_FOLDER_FRAMES);
-                break;
-            }
-            result = FALSE;
-            break;
-        }
-    } while (FindNextFileW(find, &data));
-    FindClose(find);
-    return result;
+    FolderScanContext ctx = { folder, files, 0, cancelEvent };
+    DirectoryIndex* index = AcquireFolderFrameIndex(folder);
+    DirectoryIndex_Init(index, 0,
+                        ANIMATION_LOADER_MAX_FOLDER_FRAMES,
+                        ANIMATION_LOADER_MAX_SCAN_ENTRIES,
+                        AcceptFolderFrame, NULL);
+    DirectoryIndexCallbacks callbacks = {
+        IsFolderScanCanceled, NULL, AddFolderFile, &ctx
+    };
+    int indexed = DirectoryIndex_Refresh(index, folder, &callbacks);
+    if (indexed == DIRECTORY_INDEX_FAILED) return FALSE;
+    if (indexed >= ANIMATION_LOADER_MAX_FOLDER_FRAMES) {
+        WriteLog(LOG_LEVEL_WARNING,
+                 "Folder animation frame limit reached (%d), ignoring remaining files",
+                 ANIMATION_LOADER_MAX_FOLDER_FRAMES);
+    }
+    *count = ctx.count;
+    return TRUE;
 }
 
 static HICON LoadFolderFrame(IWICImagingFactory** factory,
@@ -145,10 +183,10 @@ BOOL LoadIconsFromFolderWithCancel(const char* utf8FolderPath,
                             folder, MAX_PATH) <= 0) return FALSE;
 
     AnimationFolderFile* files = (AnimationFolderFile*)malloc(
-        sizeof(*files) * 64u);
+        sizeof(*files) * (size_t)ANIMATION_LOADER_MAX_FOLDER_FRAMES);
     if (!files) return FALSE;
     int count = 0;
-    if (!ScanFolderFiles(folder, &files, &count, cancelEvent) || !count ||
+    if (!ScanFolderFiles(folder, files, &count, cancelEvent) || !count ||
         AnimationLoader_IsCanceled(cancelEvent)) {
         free(files);
         return FALSE;
@@ -1,4 +1,6 @@
 #include "tray_animation_menu_internal.h"
+#include "log/log_trace.h"
+#include "tray/tray_menu_cache.h"
 
 BOOL GetAnimationsFolderPathW(wchar_t* outPath, size_t size) {
     if (!outPath || size == 0 || size > INT_MAX) return FALSE;
@@ -183,6 +185,8 @@ static int ScanAnimationsFolder(
 
 DWORD WINAPI AnimationScanThread(LPVOID parameter) {
     LONG generation = (LONG)(INT_PTR)parameter;
+    TraceSpan_NameThread("animation-scan");
+    TRACE_SPAN_BEGIN(scanSpan, "AnimationMenu.Scan");
     AnimEntry* entries = malloc(
         (size_t)MAX_ANIM_ENTRIES * sizeof(*entries));
     int count = ANIMATION_MENU_SCAN_FAILED;
@@ -210,11 +214,13 @@ DWORD WINAPI AnimationScanThread(LPVOID parameter) {
             g_animMenuCacheCount = count;
             g_animMenuCacheReady = !scanFailed;
             g_animMenuCacheFailed = scanFailed;
+            TrayMenuCache_Invalidate(TRAY_MENU_CACHE_ANIMATION);
             InterlockedExchange(
                 &g_animMenuLastScanTick, (LONG)GetTickCount());
         }
         ReleaseSRWLockExclusive(&g_animMenuCacheLock);
     }
     free(entries);
+    TRACE_SPAN_END(scanSpan);
     return 0;
 }
@@ -10,6 +10,8 @@ COLORREF g_percentTextColor = RGB(0, 0, 0);
 COLORREF g_percentBgColor = TRANSPARENT_BG_AUTO;
 PercentIconCacheEntry g_percentIconCache[
     GENERATED_PERCENT_ICON_CACHE_SIZE];
+DWORD g_percentIconCacheClock = 0;
+PercentIconAtlas g_percentIconAtlas;
 CapsIconCacheEntry g_capsIconCache[2];
 COLORREF g_cachedThemeTextColor = CLR_INVALID;
 DWORD g_lastThemeCheckTick = 0;
@@ -68,6 +70,8 @@ void ClearGeneratedIconCacheLocked(void) {
         ZeroMemory(&g_percentIconCache[i],
                    sizeof(g_percentIconCache[i]));
     }
+    g_percentIconCacheClock = 0;
+    FreePercentIconAtlas(&g_percentIconAtlas);
     for (int i = 0; i < (int)_countof(g_capsIconCache); ++i) {
         if (g_capsIconCache[i].icon) {
             DestroyIcon(g_capsIconCache[i].icon);
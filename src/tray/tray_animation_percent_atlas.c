@@ -0,0 +1,235 @@
+/**
+ * @file tray_animation_percent_atlas.c
+ * @brief Pre-rasterized digits for generated percent tray icons
+ *
+ * Percent icons only ever show 0-100, so the fitted-font work is done once
+ * per icon size: one font per digit count, each digit drawn white on black
+ * and kept as coverage. Composing a value is then a blit of two or three
+ * cells plus memory bitmaps for the icon, with no DC or font involved.
+ */
+
+#include "tray_animation_percent_internal.h"
+
+static const wchar_t* const kDigitClassSamples[PERCENT_ATLAS_DIGIT_CLASSES] = {
+    L"0", L"00", L"100"
+};
+
+static HBITMAP CreateScratchDib(int width, int height, void** bits) {
+    BITMAPINFO info;
+    ZeroMemory(&info, sizeof(info));
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    *bits = NULL;
+    HBITMAP bitmap = CreateDIBSection(NULL, &info, DIB_RGB_COLORS, bits, NULL, 0);
+    if (bitmap && !*bits) {
+        DeleteObject(bitmap);
+        return NULL;
+    }
+    return bitmap;
+}
+
+static BOOL RasterizeDigitClass(
+    HDC dc, DWORD* scratch, int scratchWidth, int cx, int cy,
+    UINT dpi, int digitClass, PercentIconAtlas* atlas, size_t* offset) {
+    const wchar_t* sample = kDigitClassSamples[digitClass];
+    SIZE textSize = {0};
+    HFONT font = CreateFittedMetricIconTextFont(
+        dc, sample, digitClass + 1, cx - 1, cy, dpi, &textSize);
+    if (!font) return FALSE;
+    HGDIOBJ oldFont = SelectObject(dc, font);
+    if (!oldFont || oldFont == HGDI_ERROR) {
+        DeleteObject(font);
+        return FALSE;
+    }
+
+    int y = (cy - textSize.cy) / 2;
+    if (y < 0) y = 0;
+    BOOL ok = TRUE;
+    for (int digit = 0; digit < 10 && ok; ++digit) {
+        wchar_t ch = (wchar_t)(L'0' + digit);
+        SIZE digitSize = {0};
+        ok = GetTextExtentPoint32W(dc, &ch, 1, &digitSize);
+        if (!ok) break;
+        int advance = digitSize.cx < cx ? digitSize.cx : cx;
+        int cellWidth = advance + 2 * PERCENT_ATLAS_CELL_MARGIN;
+
+        ZeroMemory(scratch, (size_t)scratchWidth * (size_t)cy * sizeof(DWORD));
+        ok = TextOutW(dc, PERCENT_ATLAS_CELL_MARGIN, y, &ch, 1) && GdiFlush();
+        if (!ok) break;
+
+        PercentAtlasGlyph* glyph = &atlas->glyphs[digitClass][digit];
+        glyph->advance = advance;
+        glyph->offset = *offset;
+        BYTE* cell = atlas->coverage + *offset;
+        for (int row = 0; row < cy; ++row) {
+            const DWORD* source = scratch + (size_t)row * (size_t)scratchWidth;
+            for (int col = 0; col < cellWidth; ++col) {
+                *cell++ = GetMaskPixelAlpha(source[col]);
+            }
+        }
+        *offset += (size_t)cellWidth * (size_t)cy;
+    }
+
+    SelectObject(dc, oldFont);
+    DeleteObject(font);
+    return ok;
+}
+
+BOOL BuildPercentIconAtlas(int cx, int cy, PercentIconAtlas* atlas) {
+    if (!atlas || cx <= 0 || cy <= 0) return FALSE;
+    ZeroMemory(atlas, sizeof(*atlas));
+
+    int scratchWidth = cx + 2 * PERCENT_ATLAS_CELL_MARGIN;
+    size_t cellBytes = (size_t)scratchWidth * (size_t)cy;
+    atlas->coverage = malloc(cellBytes * 10u * PERCENT_ATLAS_DIGIT_CLASSES);
+    if (!atlas->coverage) return FALSE;
+
+    HDC screenDc = GetDC(NULL);
+    HDC dc = screenDc ? CreateCompatibleDC(screenDc) : NULL;
+    void* bits = NULL;
+    HBITMAP scratch = dc ? CreateScratchDib(scratchWidth, cy, &bits) : NULL;
+    HGDIOBJ oldBitmap = scratch ? SelectObject(dc, scratch) : NULL;
+    BOOL ok = oldBitmap != NULL;
+    if (ok) {
+        SetBkMode(dc, TRANSPARENT);
+        SetTextColor(dc, RGB(255, 255, 255));
+        UINT dpi = (UINT)GetDeviceCaps(dc, LOGPIXELSY);
+        size_t offset = 0;
+        for (int digitClass = 0; digitClass < PERCENT_ATLAS_DIGIT_CLASSES && ok; ++digitClass) {
+            ok = RasterizeDigitClass(dc, bits, scratchWidth, cx, cy, dpi,
+                                     digitClass, atlas, &offset);
+        }
+        SelectObject(dc, oldBitmap);
+    }
+    if (scratch) DeleteObject(scratch);
+    if (dc) DeleteDC(dc);
+    if (screenDc) ReleaseDC(NULL, screenDc);
+
+    if (!ok) {
+        FreePercentIconAtlas(atlas);
+        return FALSE;
+    }
+    atlas->cx = cx;
+    atlas->cy = cy;
+    atlas->valid = TRUE;
+    return TRUE;
+}
+
+void FreePercentIconAtlas(PercentIconAtlas* atlas) {
+    if (!atlas) return;
+    free(atlas->coverage);
+    ZeroMemory(atlas, sizeof(*atlas));
+}
+
+BOOL ComposePercentCoverageLocked(
+    const PercentIconAtlas* atlas, int percent, int cx, int cy,
+    BYTE* coverage) {
+    if (!atlas || !atlas->valid || atlas->cx != cx || atlas->cy != cy ||
+        !coverage) {
+        return FALSE;
+    }
+    if (percent > GENERATED_PERCENT_ICON_MAX_VALUE) percent = GENERATED_PERCENT_ICON_MAX_VALUE;
+    if (percent < 0) percent = 0;
+
+    int digits[3];
+    int count = 0;
+    do {
+        digits[count++] = percent % 10;
+        percent /= 10;
+    } while (percent > 0);
+
+    const PercentAtlasGlyph* glyphs = atlas->glyphs[count - 1];
+    int textWidth = 0;
+    for (int i = 0; i < count; ++i) textWidth += glyphs[digits[i]].advance;
+    int x = (cx - textWidth) / 2;
+    if (x < 0) x = 0;
+
+    ZeroMemory(coverage, (size_t)cx * (size_t)cy);
+    for (int i = count - 1; i >= 0; --i) {
+        const PercentAtlasGlyph* glyph = &glyphs[digits[i]];
+        int cellWidth = glyph->advance + 2 * PERCENT_ATLAS_CELL_MARGIN;
+        int left = x - PERCENT_ATLAS_CELL_MARGIN;
+        const BYTE* cell = atlas->coverage + glyph->offset;
+        for (int row = 0; row < cy; ++row) {
+            const BYTE* source = cell + (size_t)row * (size_t)cellWidth;
+            BYTE* target = coverage + (size_t)row * (size_t)cx;
+            for (int col = 0; col < cellWidth; ++col) {
+                int tx = left + col;
+                if (tx < 0 || tx >= cx) continue;
+                if (source[col] > target[tx]) target[tx] = source[col];
+            }
+        }
+        x += glyph->advance;
+    }
+    return TRUE;
+}
+
+static DWORD BlendSolidPixel(COLORREF textColor, COLORREF bgColor, BYTE alpha) {
+    DWORD inverse = 255u - alpha;
+    DWORD red = ((DWORD)GetRValue(textColor) * alpha + (DWORD)GetRValue(bgColor) * inverse + 127u) / 255u;
+    DWORD green = ((DWORD)GetGValue(textColor) * alpha + (DWORD)GetGValue(bgColor) * inverse + 127u) / 255u;
+    DWORD blue = ((DWORD)GetBValue(textColor) * alpha + (DWORD)GetBValue(bgColor) * inverse + 127u) / 255u;
+    return 0xFF000000u | (red << 16) | (green << 8) | blue;
+}
+
+/* Mask bits are clear wherever the alpha byte of a pixel is non-zero */
+static HBITMAP CreateAlphaMaskBitmap(const DWORD* pixels, int cx, int cy) {
+    SIZE_T stride = (SIZE_T)(((cx + 15) / 16) * 2);
+    SIZE_T size = stride * (SIZE_T)cy;
+    BYTE stackBits[ICON_MASK_STACK_BYTES];
+    BYTE* bits = size <= sizeof(stackBits) ? stackBits : malloc(size);
+    if (!bits) return NULL;
+    memset(bits, 0xFF, size);
+    for (int y = 0; y < cy; ++y) {
+        for (int x = 0; x < cx; ++x) {
+            if ((pixels[(size_t)y * (size_t)cx + (size_t)x] >> 24) == 0) continue;
+            bits[(SIZE_T)y * stride + (SIZE_T)(x >> 3)] &= (BYTE)~(0x80u >> (x & 7));
+        }
+    }
+    HBITMAP mask = CreateBitmap(cx, cy, 1, 1, bits);
+    if (bits != stackBits) free(bits);
+    return mask;
+}
+
+HICON CreatePercentIconFromCoverage(
+    const BYTE* coverage, int cx, int cy,
+    COLORREF textColor, COLORREF bgColor) {
+    if (!coverage || cx <= 0 || cy <= 0) return NULL;
+    BOOL transparent = bgColor == TRANSPARENT_BG_AUTO;
+    size_t count = (size_t)cx * (size_t)cy;
+    DWORD stackPixels[GENERATED_PERCENT_ICON_STACK_PIXELS];
+    DWORD* pixels = count <= _countof(stackPixels) ? stackPixels : malloc(count * sizeof(DWORD));
+    if (!pixels) return NULL;
+    for (size_t i = 0; i < count; ++i) {
+        pixels[i] = transparent ? ComposeAlphaTextPixel(textColor, coverage[i])
+                                : BlendSolidPixel(textColor, bgColor, coverage[i]);
+    }
+
+    HICON icon = CreatePercentIconFromPixels(pixels, cx, cy, transparent);
+    if (pixels != stackPixels) free(pixels);
+    return icon;
+}
+
+HICON CreatePercentIconFromPixels(
+    const DWORD* pixels, int cx, int cy, BOOL transparent) {
+    if (!pixels || cx <= 0 || cy <= 0) return NULL;
+    HBITMAP colorBitmap = CreateBitmap(cx, cy, 1, 32, pixels);
+    HBITMAP maskBitmap = transparent ? CreateAlphaMaskBitmap(pixels, cx, cy)
+                                     : CreateInitializedMaskBitmap(cx, cy, 0x00);
+    HICON icon = NULL;
+    if (colorBitmap && maskBitmap) {
+        ICONINFO iconInfo;
+        ZeroMemory(&iconInfo, sizeof(iconInfo));
+        iconInfo.fIcon = TRUE;
+        iconInfo.hbmColor = colorBitmap;
+        iconInfo.hbmMask = maskBitmap;
+        icon = CreateIconIndirect(&iconInfo);
+    }
+    if (maskBitmap) DeleteObject(maskBitmap);
+    if (colorBitmap) DeleteObject(colorBitmap);
+    return icon;
+}
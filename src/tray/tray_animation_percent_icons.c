@@ -1,6 +1,15 @@
+/**
+ * @file tray_animation_percent_icons.c
+ * @brief Generated percent tray icons with a small LRU of recent values
+ */
+
 #include "tray_animation_percent_internal.h"
 
-static HICON CreatePercentIcon16Uncached(
+#include "drawing/drawing_dib_pool.h"
+
+/* Full GDI path; only used when the digit atlas cannot be built. Text is
+ * drawn into a pooled surface and copied out, so no DIB or DC is created */
+static HICON CreatePercentIconWithGdi(
     int percent, int cx, int cy,
     COLORREF textColor, COLORREF bgColor) {
     if (percent > GENERATED_PERCENT_ICON_MAX_VALUE) percent = 100;
@@ -8,37 +17,10 @@ static HICON CreatePercentIcon16Uncached(
     BOOL transparent = bgColor == TRANSPARENT_BG_AUTO;
     DWORD marker = ColorRefToDibRgb(textColor) ^ 0x00010101u;
 
-    BITMAPINFO info;
-    ZeroMemory(&info, sizeof(info));
-    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    info.bmiHeader.biWidth = cx;
-    info.bmiHeader.biHeight = -cy;
-    info.bmiHeader.biPlanes = 1;
-    info.bmiHeader.biBitCount = 32;
-    info.bmiHeader.biCompression = BI_RGB;
-    VOID* bits = NULL;
-    HBITMAP colorBitmap = CreateDIBSection(
-        NULL, &info, DIB_RGB_COLORS, &bits, NULL, 0);
-    if (!colorBitmap || !bits) {
-        if (colorBitmap) DeleteObject(colorBitmap);
-        return NULL;
-    }
-
-    HDC screenDc = GetDC(NULL);
-    HDC memoryDc = screenDc ? CreateCompatibleDC(screenDc) : NULL;
-    if (!screenDc || !memoryDc) {
-        if (memoryDc) DeleteDC(memoryDc);
-        if (screenDc) ReleaseDC(NULL, screenDc);
-        DeleteObject(colorBitmap);
-        return NULL;
-    }
-    HGDIOBJ oldBitmap = SelectObject(memoryDc, colorBitmap);
-    if (!oldBitmap) {
-        DeleteDC(memoryDc);
-        ReleaseDC(NULL, screenDc);
-        DeleteObject(colorBitmap);
-        return NULL;
-    }
+    DibSurface surface;
+    if (!DibPool_Acquire(cx, cy, DIB_POOL_EXACT, &surface)) return NULL;
+    HDC memoryDc = surface.dc;
+    VOID* bits = surface.bits;
     if (transparent) {
         ZeroMemory(bits, (size_t)cx * (size_t)cy * sizeof(DWORD));
     } else {
@@ -65,7 +47,7 @@ static HICON CreatePercentIcon16Uncached(
     BOOL textDrawn = TRUE;
     if (transparent) {
         textDrawn = DrawAlphaTextOnTransparentIcon(
-            screenDc, bits, cx, cy, font,
+            memoryDc, bits, cx, cy, font,
             text, textLength, x, y, textColor);
         if (!textDrawn) {
             textDrawn = DrawFallbackTextOnTransparentIcon(
@@ -78,66 +60,77 @@ static HICON CreatePercentIcon16Uncached(
         if (textDrawn) MakeIconFullyOpaque(bits, cx, cy);
     }
     if (oldFont) SelectObject(memoryDc, oldFont);
-    SelectObject(memoryDc, oldBitmap);
-    if (!textDrawn) {
-        if (font) DeleteObject(font);
-        ReleaseDC(NULL, screenDc);
-        DeleteDC(memoryDc);
-        DeleteObject(colorBitmap);
-        return NULL;
-    }
+    if (font) DeleteObject(font);
 
-    HBITMAP maskBitmap = CreateInitializedMaskBitmap(
-        cx, cy, transparent ? 0xFF : 0x00);
-    if (!maskBitmap) {
-        if (font) DeleteObject(font);
-        ReleaseDC(NULL, screenDc);
-        DeleteDC(memoryDc);
-        DeleteObject(colorBitmap);
-        return NULL;
-    }
-    HDC maskDc = CreateCompatibleDC(screenDc);
-    if (!maskDc) {
-        if (font) DeleteObject(font);
-        ReleaseDC(NULL, screenDc);
-        DeleteDC(memoryDc);
-        DeleteObject(maskBitmap);
-        DeleteObject(colorBitmap);
-        return NULL;
+    HICON icon = textDrawn
+        ? CreatePercentIconFromPixels(bits, cx, cy, transparent) : NULL;
+    DibPool_Release(&surface);
+    return icon;
+}
+
+static PercentIconCacheEntry* FindCachedPercentIconLocked(
+    int percent, int cx, int cy, COLORREF textColor, COLORREF bgColor) {
+    for (int i = 0; i < (int)_countof(g_percentIconCache); ++i) {
+        PercentIconCacheEntry* entry = &g_percentIconCache[i];
+        if (entry->valid && entry->icon && entry->percent == percent &&
+            entry->textColor == textColor && entry->bgColor == bgColor &&
+            entry->cx == cx && entry->cy == cy) {
+            return entry;
+        }
     }
-    HGDIOBJ oldMask = SelectObject(maskDc, maskBitmap);
-    if (!oldMask) {
-        if (font) DeleteObject(font);
-        DeleteDC(maskDc);
-        ReleaseDC(NULL, screenDc);
-        DeleteDC(memoryDc);
-        DeleteObject(maskBitmap);
-        DeleteObject(colorBitmap);
-        return NULL;
+    return NULL;
+}
+
+static PercentIconCacheEntry* SelectPercentIconVictimLocked(void) {
+    PercentIconCacheEntry* victim = &g_percentIconCache[0];
+    for (int i = 0; i < (int)_countof(g_percentIconCache); ++i) {
+        PercentIconCacheEntry* entry = &g_percentIconCache[i];
+        if (!entry->valid) return entry;
+        if (entry->lastUse < victim->lastUse) victim = entry;
     }
-    if (transparent) {
-        SetBkMode(maskDc, TRANSPARENT);
-        SetTextColor(maskDc, RGB(0, 0, 0));
-        HFONT oldMaskFont = font ? (HFONT)SelectObject(maskDc, font) : NULL;
-        (void)TextOutW(maskDc, x, y, text, textLength);
-        (void)GdiFlush();
-        if (oldMaskFont) SelectObject(maskDc, oldMaskFont);
+    return victim;
+}
+
+static void StorePercentIconLocked(
+    HICON icon, int percent, int cx, int cy,
+    COLORREF textColor, COLORREF bgColor) {
+    HICON cached = CopyIcon(icon);
+    if (!cached) return;
+    PercentIconCacheEntry* entry = FindCachedPercentIconLocked(
+        percent, cx, cy, textColor, bgColor);
+    if (!entry) entry = SelectPercentIconVictimLocked();
+    if (entry->icon) DestroyIcon(entry->icon);
+    entry->icon = cached;
+    entry->percent = percent;
+    entry->textColor = textColor;
+    entry->bgColor = bgColor;
+    entry->cx = cx;
+    entry->cy = cy;
+    entry->lastUse = ++g_percentIconCacheClock;
+    entry->valid = TRUE;
+}
+
+/** @brief Compose from the atlas, building it first when the size changed */
+static BOOL ComposePercentCoverage(
+    int percent, int cx, int cy, BYTE* coverage) {
+    if (!BeginPercentIconCacheAccess()) return FALSE;
+    BOOL composed = ComposePercentCoverageLocked(
+        &g_percentIconAtlas, percent, cx, cy, coverage);
+    EndPercentIconCacheAccess();
+    if (composed) return TRUE;
+
+    PercentIconAtlas atlas;
+    if (!BuildPercentIconAtlas(cx, cy, &atlas)) return FALSE;
+    if (!BeginPercentIconCacheAccess()) {
+        FreePercentIconAtlas(&atlas);
+        return FALSE;
     }
-    SelectObject(maskDc, oldMask);
-    if (font) DeleteObject(font);
-    DeleteDC(maskDc);
-    ReleaseDC(NULL, screenDc);
-    DeleteDC(memoryDc);
-
-    ICONINFO iconInfo;
-    ZeroMemory(&iconInfo, sizeof(iconInfo));
-    iconInfo.fIcon = TRUE;
-    iconInfo.hbmColor = colorBitmap;
-    iconInfo.hbmMask = maskBitmap;
-    HICON icon = CreateIconIndirect(&iconInfo);
-    DeleteObject(maskBitmap);
-    DeleteObject(colorBitmap);
-    return icon;
+    FreePercentIconAtlas(&g_percentIconAtlas);
+    g_percentIconAtlas = atlas;
+    composed = ComposePercentCoverageLocked(
+        &g_percentIconAtlas, percent, cx, cy, coverage);
+    EndPercentIconCacheAccess();
+    return composed;
 }
 
 HICON CreatePercentIcon16(int percent) {
@@ -151,38 +144,41 @@ HICON CreatePercentIcon16(int percent) {
     COLORREF bgColor;
     if (!GetIconColorSnapshot(&textColor, &bgColor) ||
         !BeginPercentIconCacheAccess()) return NULL;
-    PercentIconCacheEntry* entry = &g_percentIconCache[percent];
-    if (entry->valid && entry->icon && entry->textColor == textColor &&
-        entry->bgColor == bgColor && entry->cx == cx && entry->cy == cy) {
+    PercentIconCacheEntry* entry = FindCachedPercentIconLocked(
+        percent, cx, cy, textColor, bgColor);
+    if (entry) {
+        entry->lastUse = ++g_percentIconCacheClock;
         HICON result = CopyIcon(entry->icon);
         EndPercentIconCacheAccess();
         return result;
     }
     EndPercentIconCacheAccess();
 
-    HICON generated = CreatePercentIcon16Uncached(
-        percent, cx, cy, textColor, bgColor);
+    size_t count = (size_t)cx * (size_t)cy;
+    BYTE stackCoverage[GENERATED_PERCENT_ICON_STACK_PIXELS];
+    BYTE* coverage = count <= sizeof(stackCoverage) ? stackCoverage : malloc(count);
+    HICON generated = NULL;
+    if (coverage && ComposePercentCoverage(percent, cx, cy, coverage)) {
+        generated = CreatePercentIconFromCoverage(
+            coverage, cx, cy, textColor, bgColor);
+    }
+    if (coverage != stackCoverage) free(coverage);
+    if (!generated) {
+        generated = CreatePercentIconWithGdi(
+            percent, cx, cy, textColor, bgColor);
+    }
     if (!generated) return NULL;
-    HICON result = generated;
+
     if (BeginPercentIconCacheAccess()) {
         COLORREF currentTextColor;
         COLORREF currentBgColor;
         if (SnapshotIconColorsLocked(
                 &currentTextColor, &currentBgColor) &&
             currentTextColor == textColor && currentBgColor == bgColor) {
-            HICON cached = CopyIcon(generated);
-            entry = &g_percentIconCache[percent];
-            if (cached) {
-                if (entry->icon) DestroyIcon(entry->icon);
-                entry->icon = cached;
-                entry->textColor = textColor;
-                entry->bgColor = bgColor;
-                entry->cx = cx;
-                entry->cy = cy;
-                entry->valid = TRUE;
-            }
+            StorePercentIconLocked(
+                generated, percent, cx, cy, textColor, bgColor);
         }
         EndPercentIconCacheAccess();
     }
-    return result;
+    return generated;
 }
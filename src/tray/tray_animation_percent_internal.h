@@ -11,18 +11,45 @@
 #define GENERATED_TRAY_ICON_FALLBACK_SIZE 16
 #define GENERATED_TRAY_ICON_MAX_SIZE 256
 #define GENERATED_PERCENT_ICON_MAX_VALUE 100
-#define GENERATED_PERCENT_ICON_CACHE_SIZE \
-    (GENERATED_PERCENT_ICON_MAX_VALUE + 1)
+/** @brief Live metrics hover around a few values; keep only recent icons */
+#define GENERATED_PERCENT_ICON_CACHE_SIZE 8
+/** @brief Icons up to 32x32 compose on the stack */
+#define GENERATED_PERCENT_ICON_STACK_PIXELS (32 * 32)
+/** @brief "0"-"9", "10"-"99" and "100" each get their own fitted font */
+#define PERCENT_ATLAS_DIGIT_CLASSES 3
+/** @brief Columns kept on each side of a digit's advance for overhang */
+#define PERCENT_ATLAS_CELL_MARGIN 1
 
 typedef struct {
     HICON icon;
+    int percent;
     COLORREF textColor;
     COLORREF bgColor;
     int cx;
     int cy;
+    DWORD lastUse;
     BOOL valid;
 } PercentIconCacheEntry;
 
+typedef struct {
+    int advance;
+    size_t offset;
+} PercentAtlasGlyph;
+
+/**
+ * @brief Digit coverage for one icon size
+ * @details Cells are icon-height, (advance + 2 * margin)-wide 8-bit coverage
+ *          with the glyph already at its final vertical position. Coverage
+ *          is color independent, so only size and font changes rebuild it.
+ */
+typedef struct {
+    BOOL valid;
+    int cx;
+    int cy;
+    PercentAtlasGlyph glyphs[PERCENT_ATLAS_DIGIT_CLASSES][10];
+    BYTE* coverage;
+} PercentIconAtlas;
+
 typedef struct {
     HICON icon;
     COLORREF textColor;
@@ -37,6 +64,8 @@ extern COLORREF g_percentTextColor;
 extern COLORREF g_percentBgColor;
 extern PercentIconCacheEntry g_percentIconCache[
     GENERATED_PERCENT_ICON_CACHE_SIZE];
+extern DWORD g_percentIconCacheClock;
+extern PercentIconAtlas g_percentIconAtlas;
 extern CapsIconCacheEntry g_capsIconCache[2];
 extern COLORREF g_cachedThemeTextColor;
 extern DWORD g_lastThemeCheckTick;
@@ -54,6 +83,8 @@ void FillSolidIconBackground(
 void RepairTransparentIconAlpha(
     void* bits, int cx, int cy, DWORD marker);
 void MakeIconFullyOpaque(void* bits, int cx, int cy);
+DWORD ComposeAlphaTextPixel(COLORREF color, BYTE alpha);
+BYTE GetMaskPixelAlpha(DWORD pixel);
 BOOL DrawFallbackTextOnTransparentIcon(
     HDC dc, void* bits, int cx, int cy, DWORD marker,
     HFONT font, const wchar_t* text, int textLen,
@@ -71,6 +102,21 @@ HFONT CreateFittedMetricIconTextFont(
     int maxWidth, int maxHeight, UINT dpi, SIZE* outSize);
 HBITMAP CreateInitializedMaskBitmap(int cx, int cy, BYTE value);
 void ClearGeneratedIconCacheLocked(void);
+BOOL BuildPercentIconAtlas(int cx, int cy, PercentIconAtlas* atlas);
+void FreePercentIconAtlas(PercentIconAtlas* atlas);
+/**
+ * @brief Blit the digits of percent into a cx * cy coverage buffer
+ * @return FALSE when the atlas does not match the requested size
+ */
+BOOL ComposePercentCoverageLocked(
+    const PercentIconAtlas* atlas, int percent, int cx, int cy,
+    BYTE* coverage);
+HICON CreatePercentIconFromCoverage(
+    const BYTE* coverage, int cx, int cy,
+    COLORREF textColor, COLORREF bgColor);
+/** @brief Icon from top-down 32bpp pixels; transparent masks by alpha */
+HICON CreatePercentIconFromPixels(
+    const DWORD* pixels, int cx, int cy, BOOL transparent);
 BOOL SnapshotIconColorsLocked(COLORREF* textColor, COLORREF* bgColor);
 BOOL GetIconColorSnapshot(COLORREF* textColor, COLORREF* bgColor);
 
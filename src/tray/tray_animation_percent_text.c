@@ -1,5 +1,6 @@
 #include "tray_animation_percent_internal.h"
 
+#include "drawing/drawing_dib_pool.h"
 #include "drawing/system_ui_font.h"
 
 void FillTransparentIconBackground(
@@ -32,14 +33,14 @@ void MakeIconFullyOpaque(void* bits, int cx, int cy) {
     for (int i = 0; i < cx * cy; i++) pixels[i] |= 0xFF000000u;
 }
 
-static DWORD ComposeAlphaTextPixel(COLORREF color, BYTE alpha) {
+DWORD ComposeAlphaTextPixel(COLORREF color, BYTE alpha) {
     DWORD red = ((DWORD)GetRValue(color) * alpha + 127u) / 255u;
     DWORD green = ((DWORD)GetGValue(color) * alpha + 127u) / 255u;
     DWORD blue = ((DWORD)GetBValue(color) * alpha + 127u) / 255u;
     return ((DWORD)alpha << 24) | (red << 16) | (green << 8) | blue;
 }
 
-static BYTE GetMaskPixelAlpha(DWORD pixel) {
+BYTE GetMaskPixelAlpha(DWORD pixel) {
     BYTE red = (BYTE)((pixel >> 16) & 0xFF);
     BYTE green = (BYTE)((pixel >> 8) & 0xFF);
     BYTE blue = (BYTE)(pixel & 0xFF);
@@ -79,33 +80,10 @@ BOOL DrawAlphaTextOnTransparentIcon(
     if (!screenDc || !targetBits || !font || !text || textLen <= 0 ||
         cx <= 0 || cy <= 0) return FALSE;
 
-    BITMAPINFO bitmapInfo;
-    ZeroMemory(&bitmapInfo, sizeof(bitmapInfo));
-    bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bitmapInfo.bmiHeader.biWidth = cx;
-    bitmapInfo.bmiHeader.biHeight = -cy;
-    bitmapInfo.bmiHeader.biPlanes = 1;
-    bitmapInfo.bmiHeader.biBitCount = 32;
-    bitmapInfo.bmiHeader.biCompression = BI_RGB;
-
-    VOID* maskBits = NULL;
-    HBITMAP maskBitmap = CreateDIBSection(
-        NULL, &bitmapInfo, DIB_RGB_COLORS, &maskBits, NULL, 0);
-    if (!maskBitmap || !maskBits) {
-        if (maskBitmap) DeleteObject(maskBitmap);
-        return FALSE;
-    }
-    HDC maskDc = CreateCompatibleDC(screenDc);
-    if (!maskDc) {
-        DeleteObject(maskBitmap);
-        return FALSE;
-    }
-    HGDIOBJ oldBitmap = SelectObject(maskDc, maskBitmap);
-    if (!oldBitmap) {
-        DeleteDC(maskDc);
-        DeleteObject(maskBitmap);
-        return FALSE;
-    }
+    DibSurface mask;
+    if (!DibPool_Acquire(cx, cy, DIB_POOL_EXACT, &mask)) return FALSE;
+    HDC maskDc = mask.dc;
+    VOID* maskBits = mask.bits;
 
     ZeroMemory(maskBits, (size_t)cx * (size_t)cy * sizeof(DWORD));
     SetBkMode(maskDc, TRANSPARENT);
@@ -124,9 +102,7 @@ BOOL DrawAlphaTextOnTransparentIcon(
             target[i] = ComposeAlphaTextPixel(textColor, alpha);
         }
     }
-    SelectObject(maskDc, oldBitmap);
-    DeleteDC(maskDc);
-    DeleteObject(maskBitmap);
+    DibPool_Release(&mask);
     return drawn;
 }
 
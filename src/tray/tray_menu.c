@@ -26,6 +26,7 @@
 #include "utils/natural_sort.h"
 #include "utils/string_format.h"
 #include "tray/tray_menu_pomodoro.h"
+#include "tray/tray_menu_cache.h"
 #include "tray/tray_menu_font.h"
 #include "tray/tray_menu_submenus.h"
 #include "tray/tray_menu_theme.h"
@@ -33,6 +34,7 @@
 #include "color/color_parser.h"
 #include "taskbar_monitor.h"
 #include "tray/tray.h"
+#include "window_procedure/window_drop_target.h"
 #include "window_procedure/window_message_handlers.h"
 #include "dialog/dialog_font_picker.h"
 
@@ -93,22 +95,31 @@ void ShowColorMenu(HWND hwnd, const POINT* anchor) {
     AppendMenuW(hMenu, MF_SEPARATOR, 0, NULL);
 
     BuildFormatSubmenu(hMenu);
-    BuildFontSubmenu(hMenu);
+    TrayMenuCache_AppendSubmenu(hMenu, TRAY_MENU_CACHE_FONT,
+                                GetLocalizedString(NULL, L"Font"));
     BuildColorSubmenu(hMenu);
     BuildStyleSubmenu(hMenu);
 
     AppendMenuW(hMenu, MF_SEPARATOR, 0, NULL);
 
-    BuildPluginsSubmenu(hMenu);
+    TrayMenuCache_AppendSubmenu(hMenu, TRAY_MENU_CACHE_PLUGINS,
+                                GetLocalizedString(NULL, L"Plugins"));
 
     AppendMenuW(hMenu, MF_SEPARATOR, 0, NULL);
 
-    BuildAnimationSubmenu(hMenu);
+    TrayMenuCache_AppendSubmenu(hMenu, TRAY_MENU_CACHE_ANIMATION,
+                                GetLocalizedString(NULL, L"Tray Icon"));
 
     AppendMenuW(hMenu, MF_SEPARATOR, 0, NULL);
 
     BuildHelpSubmenu(hMenu);
 
+    /* Only offered while dropped files are still being copied */
+    if (IsDropImportJobRunning()) {
+        AppendMenuW(hMenu, MF_STRING, CLOCK_IDM_CANCEL_DROP_IMPORT,
+                    GetLocalizedString(NULL, L"Cancel Import"));
+    }
+
     /* Exit */
     AppendMenuW(hMenu, MF_STRING, CLOCK_IDM_EXIT,
                 GetLocalizedString(NULL, L"Exit"));
@@ -121,6 +132,7 @@ void ShowColorMenu(HWND hwnd, const POINT* anchor) {
     UINT selectedCommand = TrackPopupMenu(
         hMenu, TPM_LEFTALIGN | TPM_RIGHTBUTTON | TPM_RETURNCMD,
         pt.x, pt.y, 0, hwnd, NULL);
+    TrayMenuCache_DetachSubmenus(hMenu);
     TrayMenuTracking_End(&tracking);
     BOOL isTaskbarMonitorCommand =
         selectedCommand == CLOCK_IDM_TASKBAR_MONITOR_CPU_MEMORY ||
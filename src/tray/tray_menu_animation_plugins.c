@@ -4,7 +4,13 @@
  */
 
 #include "tray_menu_submenus_internal.h"
+#include "tray/tray_menu_cache.h"
 #include "tray/tray_menu_pagination.h"
+#include "taskbar_monitor.h"
+
+/* Fixed speed shown in the retained label; a change needs a rebuild. */
+static double g_builtFixedSpeedMultiplier = 0.0;
+static int g_patchActivePluginIndex = -1;
 
 static BOOL IsCustomTextDisplaySourceActive(void) {
     if (!PluginData_IsActive()) {
@@ -26,8 +32,7 @@ static BOOL IsCustomTextDisplaySourceActive(void) {
     return _wcsicmp(fileName, L"custom_display.txt") == 0;
 }
 
-void BuildAnimationSubmenu(HMENU hMenu) {
-    HMENU hAnimMenu = CreatePopupMenu();
+void FillAnimationSubmenu(HMENU hAnimMenu) {
     if (!hAnimMenu) return;
     {
         const char* currentAnim = GetCurrentAnimationName();
@@ -51,10 +56,11 @@ void BuildAnimationSubmenu(HMENU hMenu) {
                             CLOCK_IDM_ANIM_SPEED_TIMER, GetLocalizedString(NULL, L"By Countdown Progress"));
                 AppendMenuW(hAnimSpeedMenu, MF_SEPARATOR, 0, NULL);
                 wchar_t fixedSpeedLabel[160] = {0};
+                g_builtFixedSpeedMultiplier = GetAnimationFixedSpeedMultiplier();
                 _snwprintf_s(fixedSpeedLabel, _countof(fixedSpeedLabel), _TRUNCATE,
                              L"%ls (%.4gx)",
                              GetLocalizedString(NULL, L"Set Fixed Speed..."),
-                             GetAnimationFixedSpeedMultiplier());
+                             g_builtFixedSpeedMultiplier);
                 AppendMenuW(hAnimSpeedMenu, MF_STRING | (currentMetric == ANIMATION_SPEED_FIXED ? MF_CHECKED : MF_UNCHECKED),
                             CLOCK_IDM_ANIM_SPEED_FIXED, fixedSpeedLabel);
                 if (!AppendMenuW(hAnimMenu, MF_POPUP, (UINT_PTR)hAnimSpeedMenu,
@@ -75,17 +81,48 @@ void BuildAnimationSubmenu(HMENU hMenu) {
             LOG_WARNING("Failed to paginate the animation menu");
         }
     }
-    if (!AppendMenuW(hMenu, MF_POPUP, (UINT_PTR)hAnimMenu, GetLocalizedString(NULL, L"Tray Icon"))) {
-        DestroyMenu(hAnimMenu);
+}
+
+static int QueryAnimationMenuCheck(UINT id) {
+    switch (id) {
+        case CLOCK_IDM_ANIM_SPEED_ORIGINAL:
+            return GetAnimationSpeedMetric() == ANIMATION_SPEED_ORIGINAL;
+        case CLOCK_IDM_ANIM_SPEED_MEMORY:
+            return GetAnimationSpeedMetric() == ANIMATION_SPEED_MEMORY;
+        case CLOCK_IDM_ANIM_SPEED_CPU:
+            return GetAnimationSpeedMetric() == ANIMATION_SPEED_CPU;
+        case CLOCK_IDM_ANIM_SPEED_TIMER:
+            return GetAnimationSpeedMetric() == ANIMATION_SPEED_TIMER;
+        case CLOCK_IDM_ANIM_SPEED_FIXED:
+            return GetAnimationSpeedMetric() == ANIMATION_SPEED_FIXED;
+        case CLOCK_IDM_TASKBAR_MONITOR_NETWORK:
+            return TaskbarMonitor_IsOptionEnabled(TASKBAR_MONITOR_OPTION_NETWORK);
+        case CLOCK_IDM_TASKBAR_MONITOR_CPU_MEMORY:
+            return TaskbarMonitor_IsOptionEnabled(TASKBAR_MONITOR_OPTION_CPU_MEMORY);
+        default:
+            break;
     }
+
+    char name[MAX_PATH] = {0};
+    if (!GetAnimationNameFromMenuId(id, name, sizeof(name))) return -1;
+    const char* current = GetCurrentAnimationName();
+    if (!current) return 0;
+    return GetBuiltinAnimDefById(id) ? _stricmp(current, name) == 0
+                                     : strcmp(current, name) == 0;
 }
 
-/**
- * @brief Build plugins submenu
- * @param hMenu Parent menu handle
- */
-void BuildPluginsSubmenu(HMENU hMenu) {
-    HMENU hPluginsMenu = CreatePopupMenu();
+BOOL PatchAnimationSubmenu(HMENU hAnimMenu) {
+    if (GetMenuState(hAnimMenu, CLOCK_IDM_ANIM_SPEED_FIXED, MF_BYCOMMAND) !=
+            (UINT)-1 &&
+        GetAnimationFixedSpeedMultiplier() != g_builtFixedSpeedMultiplier) {
+        return FALSE;
+    }
+    AnimationMenu_RequestScanAsync();
+    TrayMenuCache_PatchChecks(hAnimMenu, QueryAnimationMenuCheck, FALSE);
+    return TRUE;
+}
+
+void FillPluginsSubmenu(HMENU hPluginsMenu) {
     if (!hPluginsMenu) return;
 
     PluginManager_RequestScanAsync();
@@ -141,9 +178,21 @@ void BuildPluginsSubmenu(HMENU hMenu) {
             GetLocalizedString(NULL, L"More"))) {
         LOG_WARNING("Failed to paginate the plugin menu");
     }
+}
 
-    if (!AppendMenuW(hMenu, MF_POPUP, (UINT_PTR)hPluginsMenu,
-                     GetLocalizedString(NULL, L"Plugins"))) {
-        DestroyMenu(hPluginsMenu);
+static int QueryPluginsMenuCheck(UINT id) {
+    if (id == CLOCK_IDM_CUSTOM_TEXT_DISPLAY) {
+        return g_patchActivePluginIndex < 0 && IsCustomTextDisplaySourceActive();
+    }
+    if (id < CLOCK_IDM_PLUGINS_BASE || id >= CLOCK_IDM_PLUGINS_BASE + MAX_PLUGINS) {
+        return -1;
     }
+    return (int)(id - CLOCK_IDM_PLUGINS_BASE) == g_patchActivePluginIndex;
+}
+
+BOOL PatchPluginsSubmenu(HMENU hPluginsMenu) {
+    PluginManager_RequestScanAsync();
+    g_patchActivePluginIndex = PluginManager_GetActivePluginIndex();
+    TrayMenuCache_PatchChecks(hPluginsMenu, QueryPluginsMenuCheck, FALSE);
+    return TRUE;
 }
@@ -0,0 +1,162 @@
+/**
+ * @file tray_menu_cache.c
+ * @brief Retained font, plugin and animation submenus.
+ *
+ * Menus are only touched on the UI thread; scan workers merely bump the
+ * generation counters, and the next WM_INITMENUPOPUP of that submenu
+ * rebuilds it in place so the handle attached to the parent stays valid.
+ */
+
+#include "tray/tray_menu_cache.h"
+
+#include "log.h"
+#include "tray/tray_menu_font.h"
+#include "tray/tray_menu_pagination.h"
+#include "tray/tray_menu_submenus.h"
+
+#define TRAY_MENU_CACHE_MAX_DEPTH 256
+
+typedef struct {
+    void (*fill)(HMENU menu);
+    BOOL (*patch)(HMENU menu);
+} TrayMenuCacheBuilder;
+
+typedef struct {
+    HMENU menu;
+    LONG builtGeneration;
+    int builtItemLimit;
+    BOOL built;
+} TrayMenuCacheEntry;
+
+static const TrayMenuCacheBuilder kBuilders[TRAY_MENU_CACHE_SLOT_COUNT] = {
+    {FillFontSubmenu, PatchFontSubmenu},
+    {FillPluginsSubmenu, PatchPluginsSubmenu},
+    {FillAnimationSubmenu, PatchAnimationSubmenu}
+};
+
+static volatile LONG g_slotGenerations[TRAY_MENU_CACHE_SLOT_COUNT];
+static TrayMenuCacheEntry g_entries[TRAY_MENU_CACHE_SLOT_COUNT];
+
+void TrayMenuCache_Invalidate(TrayMenuCacheSlot slot) {
+    if (slot < 0 || slot >= TRAY_MENU_CACHE_SLOT_COUNT) return;
+    InterlockedIncrement(&g_slotGenerations[slot]);
+}
+
+void TrayMenuCache_InvalidateAll(void) {
+    for (int i = 0; i < TRAY_MENU_CACHE_SLOT_COUNT; i++) {
+        InterlockedIncrement(&g_slotGenerations[i]);
+    }
+}
+
+BOOL TrayMenuCache_AppendSubmenu(HMENU parent, TrayMenuCacheSlot slot,
+                                 const wchar_t* label) {
+    if (!parent || slot < 0 || slot >= TRAY_MENU_CACHE_SLOT_COUNT) return FALSE;
+    TrayMenuCacheEntry* entry = &g_entries[slot];
+    if (!entry->menu) {
+        entry->menu = CreatePopupMenu();
+        entry->built = FALSE;
+        if (!entry->menu) {
+            LOG_WARNING("Failed to create retained tray submenu %d", (int)slot);
+            return FALSE;
+        }
+    }
+    return AppendMenuW(parent, MF_POPUP, (UINT_PTR)entry->menu, label);
+}
+
+void TrayMenuCache_DetachSubmenus(HMENU parent) {
+    if (!parent) return;
+    for (int i = GetMenuItemCount(parent) - 1; i >= 0; i--) {
+        HMENU child = GetSubMenu(parent, i);
+        if (!child) continue;
+        for (int slot = 0; slot < TRAY_MENU_CACHE_SLOT_COUNT; slot++) {
+            if (child == g_entries[slot].menu) {
+                RemoveMenu(parent, (UINT)i, MF_BYPOSITION);
+                break;
+            }
+        }
+    }
+}
+
+static void ClearMenu(HMENU menu) {
+    /* DeleteMenu also destroys nested folder and continuation popups. */
+    for (int i = GetMenuItemCount(menu) - 1; i >= 0; i--) {
+        DeleteMenu(menu, (UINT)i, MF_BYPOSITION);
+    }
+}
+
+BOOL TrayMenuCache_OnInitMenuPopup(HMENU menu) {
+    if (!menu) return FALSE;
+    for (int slot = 0; slot < TRAY_MENU_CACHE_SLOT_COUNT; slot++) {
+        TrayMenuCacheEntry* entry = &g_entries[slot];
+        if (entry->menu != menu) continue;
+
+        LONG generation = InterlockedCompareExchange(&g_slotGenerations[slot], 0, 0);
+        int itemLimit = TrayMenuPagination_GetScreenItemLimit();
+        BOOL current = entry->built &&
+                       entry->builtGeneration == generation &&
+                       entry->builtItemLimit == itemLimit;
+        if (current && kBuilders[slot].patch(menu)) return TRUE;
+
+        ClearMenu(menu);
+        kBuilders[slot].fill(menu);
+        entry->built = TRUE;
+        entry->builtGeneration = generation;
+        entry->builtItemLimit = itemLimit;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/** @return TRUE when any item below menu ends up checked */
+static BOOL PatchChecksRecursive(HMENU menu, TrayMenuCheckQuery query,
+                                 BOOL checkFolders, int depth) {
+    if (depth > TRAY_MENU_CACHE_MAX_DEPTH) return FALSE;
+    BOOL anyChecked = FALSE;
+    int count = GetMenuItemCount(menu);
+    for (int i = 0; i < count; i++) {
+        MENUITEMINFOW item = {0};
+        item.cbSize = sizeof(item);
+        item.fMask = MIIM_DATA | MIIM_ID | MIIM_STATE | MIIM_SUBMENU | MIIM_FTYPE;
+        if (!GetMenuItemInfoW(menu, (UINT)i, TRUE, &item) ||
+            (item.fType & MFT_SEPARATOR)) {
+            continue;
+        }
+
+        int checked;
+        if (item.hSubMenu) {
+            BOOL childChecked = PatchChecksRecursive(item.hSubMenu, query,
+                                                     checkFolders, depth + 1);
+            checked = (checkFolders || TrayMenuPagination_IsContinuationItem(&item))
+                          ? childChecked : -1;
+            if (childChecked) anyChecked = TRUE;
+        } else {
+            checked = query(item.wID);
+        }
+
+        if (checked < 0) {
+            if (item.fState & MFS_CHECKED) anyChecked = TRUE;
+            continue;
+        }
+        if (checked) anyChecked = TRUE;
+        if (((item.fState & MFS_CHECKED) != 0) != (checked != 0)) {
+            CheckMenuItem(menu, (UINT)i,
+                          MF_BYPOSITION | (checked ? MF_CHECKED : MF_UNCHECKED));
+        }
+    }
+    return anyChecked;
+}
+
+void TrayMenuCache_PatchChecks(HMENU menu, TrayMenuCheckQuery query,
+                               BOOL checkFolders) {
+    if (!menu || !query) return;
+    (void)PatchChecksRecursive(menu, query, checkFolders, 0);
+}
+
+void TrayMenuCache_Cleanup(void) {
+    for (int slot = 0; slot < TRAY_MENU_CACHE_SLOT_COUNT; slot++) {
+        if (g_entries[slot].menu) {
+            DestroyMenu(g_entries[slot].menu);
+        }
+        ZeroMemory(&g_entries[slot], sizeof(g_entries[slot]));
+    }
+}
@@ -8,6 +8,7 @@
 #include "config.h"
 #include "language.h"
 #include "log.h"
+#include "tray/tray_menu_cache.h"
 #include "tray/tray_menu_pagination.h"
 #include "tray/tray_menu.h"
 #include "../resource/resource.h"
@@ -110,18 +111,47 @@ static const wchar_t* GetPathBaseNameW(const wchar_t* path) {
     return slash ? slash + 1 : path;
 }
 
-void BuildFontSubmenu(HMENU hMenu) {
-    HMENU hFontSubMenu = CreatePopupMenu();
-    if (!hFontSubMenu) {
-        WriteLog(LOG_LEVEL_ERROR, "Failed to create font submenu");
-        return;
+typedef enum {
+    CURRENT_FONT_SYSTEM,
+    CURRENT_FONT_CUSTOM,
+    CURRENT_FONT_BARE_NAME
+} CurrentFontKind;
+
+static CurrentFontKind ClassifyCurrentFont(void) {
+    const char* prefix = FONTS_PATH_PREFIX;
+    if (_strnicmp(FONT_FILE_NAME, prefix, strlen(prefix)) == 0) {
+        return CURRENT_FONT_CUSTOM;
+    }
+    if (strchr(FONT_FILE_NAME, ':') != NULL) {
+        return (strstr(FONT_FILE_NAME, "Windows\\Fonts") != NULL ||
+                strstr(FONT_FILE_NAME, "WINDOWS\\Fonts") != NULL)
+            ? CURRENT_FONT_SYSTEM : CURRENT_FONT_CUSTOM;
     }
+    if (strchr(FONT_FILE_NAME, '\\') != NULL || strchr(FONT_FILE_NAME, '/') != NULL) {
+        return CURRENT_FONT_CUSTOM;
+    }
+    return CURRENT_FONT_BARE_NAME;
+}
+
+static BOOL GetCurrentFontBaseName(wchar_t* out, size_t size) {
+    return MultiByteToWideChar(CP_UTF8, 0, FONT_FILE_NAME, -1, out, (int)size) > 0 &&
+           out[0] != L'\0';
+}
+
+/* License state the retained submenu was built for; a change needs a rebuild. */
+static BOOL g_fontMenuBuiltForLicense = FALSE;
+static wchar_t g_patchFontRelPath[MAX_PATH];
+static BOOL g_patchIsSystemFont = FALSE;
+
+void FillFontSubmenu(HMENU hFontSubMenu) {
+    if (!hFontSubMenu) return;
     FontMenuInternal_ResetIdMap();
     TrayMenuPaginationRange fontItems = {0};
 
     int g_advancedFontId = CMD_FONT_SELECTION_BASE;
 
-    if (NeedsFontLicenseVersionAcceptance()) {
+    g_fontMenuBuiltForLicense = NeedsFontLicenseVersionAcceptance();
+    if (g_fontMenuBuiltForLicense) {
         AppendMenuW(hFontSubMenu, MF_STRING, CLOCK_IDC_FONT_LICENSE_AGREE,
                    GetLocalizedString(NULL, L"Click to agree to license agreement"));
     } else {
@@ -174,21 +204,13 @@ void BuildFontSubmenu(HMENU hMenu) {
         }
 
         /* Determine if current font is a system font */
-        const char* prefix = FONTS_PATH_PREFIX;
-        size_t prefixLen = strlen(prefix);
-
-        if (_strnicmp(FONT_FILE_NAME, prefix, prefixLen) == 0) {
-            isSystemFont = FALSE;
-        } else if (strchr(FONT_FILE_NAME, ':') != NULL) {
-            isSystemFont = (strstr(FONT_FILE_NAME, "Windows\\Fonts") != NULL ||
-                           strstr(FONT_FILE_NAME, "WINDOWS\\Fonts") != NULL);
-        } else if (strchr(FONT_FILE_NAME, '\\') != NULL || strchr(FONT_FILE_NAME, '/') != NULL) {
-            isSystemFont = FALSE;
-        } else {
+        CurrentFontKind fontKind = ClassifyCurrentFont();
+        isSystemFont = fontKind == CURRENT_FONT_SYSTEM;
+        if (fontKind == CURRENT_FONT_BARE_NAME) {
             /* Just filename - check if in scanned fonts */
             wchar_t wFontName[MAX_PATH] = L"";
-            if (MultiByteToWideChar(CP_UTF8, 0, FONT_FILE_NAME, -1, wFontName, MAX_PATH) > 0 &&
-                wFontName[0] != L'\0') {
+            isSystemFont = TRUE;
+            if (GetCurrentFontBaseName(wFontName, MAX_PATH)) {
                 for (int i = 0; i < fontCount; i++) {
                     if (_wcsicmp(GetPathBaseNameW(fontSnapshot[i].relativePath), wFontName) == 0) {
                         isSystemFont = FALSE;
@@ -216,12 +238,48 @@ void BuildFontSubmenu(HMENU hMenu) {
             LOG_WARNING("Failed to paginate the font menu");
         }
     }
+}
+
+static int QueryFontMenuCheck(UINT id) {
+    if (id == CLOCK_IDM_SYSTEM_FONT_PICKER) return g_patchIsSystemFont;
+    if (id < CMD_FONT_SELECTION_BASE ||
+        id >= CMD_FONT_SELECTION_BASE + MAX_FONT_ENTRIES) {
+        return -1;
+    }
+    for (int i = 0; i < g_fontMenuIdMapCount; i++) {
+        if (g_fontMenuIdMap[i].id == id) {
+            return g_patchFontRelPath[0] != L'\0' &&
+                   _wcsicmp(g_fontMenuIdMap[i].relativePath, g_patchFontRelPath) == 0;
+        }
+    }
+    return -1;
+}
 
-    if (!AppendMenuW(hMenu, MF_POPUP, (UINT_PTR)hFontSubMenu,
-                     GetLocalizedString(NULL, L"Font"))) {
-        DestroyMenu(hFontSubMenu);
-        WriteLog(LOG_LEVEL_ERROR, "Failed to attach font submenu");
+BOOL PatchFontSubmenu(HMENU hFontSubMenu) {
+    if (NeedsFontLicenseVersionAcceptance() != g_fontMenuBuiltForLicense) {
+        return FALSE;
+    }
+    if (g_fontMenuBuiltForLicense) return TRUE;
+    FontMenu_RequestScanAsync();
+
+    GetCurrentFontRelativePath(g_patchFontRelPath, MAX_PATH);
+    CurrentFontKind fontKind = ClassifyCurrentFont();
+    g_patchIsSystemFont = fontKind == CURRENT_FONT_SYSTEM;
+    if (fontKind == CURRENT_FONT_BARE_NAME) {
+        wchar_t wFontName[MAX_PATH] = L"";
+        g_patchIsSystemFont = TRUE;
+        if (GetCurrentFontBaseName(wFontName, MAX_PATH)) {
+            for (int i = 0; i < g_fontMenuIdMapCount; i++) {
+                if (_wcsicmp(GetPathBaseNameW(g_fontMenuIdMap[i].relativePath),
+                             wFontName) == 0) {
+                    g_patchIsSystemFont = FALSE;
+                    break;
+                }
+            }
+        }
     }
+    TrayMenuCache_PatchChecks(hFontSubMenu, QueryFontMenuCheck, TRUE);
+    return TRUE;
 }
 
 BOOL GetFontPathFromMenuId(UINT id, char* outPath, size_t outPathSize) {
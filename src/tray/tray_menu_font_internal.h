@@ -35,6 +35,7 @@ BOOL FontMenuInternal_IsScanCanceled(LONG generation);
 BOOL FontMenuInternal_CleanupRetiredScanThreadLocked(DWORD waitMs);
 int FontMenuInternal_ScanFontsFolder(FontEntry* entries, int capacity,
                                      LONG generation);
+void FontMenuInternal_ResetScanIndex(void);
 void FontMenuInternal_BuildMenuFromEntries(
     HMENU hRootMenu, const FontEntry* entries, int count,
     const wchar_t* currentFontRelPath, int* fontId);
@@ -115,5 +115,6 @@ void FontMenu_Shutdown(void) {
     ReleaseSRWLockExclusive(&g_fontMenuCacheLock);
     InterlockedExchange(&g_fontMenuLastScanTick, 0);
 
+    FontMenuInternal_ResetScanIndex();
     FontMenuInternal_ResetIdMap();
 }
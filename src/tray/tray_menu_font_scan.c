@@ -1,12 +1,13 @@
 /**
  * @file tray_menu_font_scan.c
- * @brief Recursive discovery of custom font files.
+ * @brief Incremental recursive discovery of custom font files.
  */
 
 #include "tray_menu_font_internal.h"
 
 #include "font/font_path_manager.h"
 #include "log.h"
+#include "utils/directory_index.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -15,18 +16,44 @@ typedef struct {
     FontEntry* entries;
     int count;
     int capacity;
-    int scannedEntries;
-    BOOL truncated;
+    int added;
+    int changed;
+    int removed;
+    LONG generation;
     BOOL full;
-    BOOL failed;
 } FontScanContext;
 
+/* Kept across scans so reopening the menu only re-enumerates changed folders. */
+static DirectoryIndex g_fontDirectoryIndex;
+
 static BOOL GetFontsFolderPath(wchar_t* outPath, size_t size) {
     return GetFontsFolderW(outPath, size, FALSE);
 }
 
-static BOOL AddFontEntry(FontScanContext* ctx, const wchar_t* fileName,
-                         const wchar_t* relativePath) {
+static BOOL AcceptFontFile(const WIN32_FIND_DATAW* data, BYTE* metadata,
+                           void* context) {
+    (void)metadata;
+    (void)context;
+    const wchar_t* ext = wcsrchr(data->cFileName, L'.');
+    return ext && (_wcsicmp(ext, L".ttf") == 0 || _wcsicmp(ext, L".otf") == 0);
+}
+
+static BOOL IsFontIndexScanCanceled(void* context) {
+    const FontScanContext* ctx = (const FontScanContext*)context;
+    return FontMenuInternal_IsScanCanceled(ctx->generation);
+}
+
+static void CountFontDelta(DirectoryIndexChange change,
+                           const DirectoryIndexEntry* entry, void* context) {
+    (void)entry;
+    FontScanContext* ctx = (FontScanContext*)context;
+    if (change == DIRECTORY_INDEX_ADDED) ctx->added++;
+    else if (change == DIRECTORY_INDEX_CHANGED) ctx->changed++;
+    else ctx->removed++;
+}
+
+static BOOL AddFontEntry(const DirectoryIndexEntry* indexed, void* context) {
+    FontScanContext* ctx = (FontScanContext*)context;
     if (ctx->count >= ctx->capacity) {
         if (!ctx->full) {
             WriteLog(LOG_LEVEL_WARNING, "Font list capacity reached (%d), stopping scan",
@@ -36,11 +63,12 @@ static BOOL AddFontEntry(FontScanContext* ctx, const wchar_t* fileName,
         return FALSE;
     }
 
+    const wchar_t* fileName = DirectoryIndex_EntryFileName(indexed);
     FontEntry* entry = &ctx->entries[ctx->count];
     wcsncpy(entry->fileName, fileName, MAX_FONT_NAME_LENGTH - 1);
     entry->fileName[MAX_FONT_NAME_LENGTH - 1] = L'\0';
 
-    wcsncpy(entry->relativePath, relativePath, MAX_PATH - 1);
+    wcsncpy(entry->relativePath, indexed->relativePath, MAX_PATH - 1);
     entry->relativePath[MAX_PATH - 1] = L'\0';
 
     /* Display name = filename without extension */
@@ -53,105 +81,8 @@ static BOOL AddFontEntry(FontScanContext* ctx, const wchar_t* fileName,
     return TRUE;
 }
 
-static void ScanFontFolderRecursive(const wchar_t* folderPath,
-                                    const wchar_t* relativePath,
-                                    FontScanContext* ctx,
-                                    int depth,
-                                    LONG generation) {
-    if (ctx->full || FontMenuInternal_IsScanCanceled(generation)) return;
-
-    if (depth >= MAX_RECURSION_DEPTH) {
-        WriteLog(LOG_LEVEL_WARNING, "Max recursion depth reached at: %ls", folderPath);
-        return;
-    }
-
-    wchar_t searchPath[MAX_PATH];
-    int written = _snwprintf_s(searchPath, MAX_PATH, _TRUNCATE, L"%s\\*", folderPath);
-    if (written < 0 || written >= MAX_PATH) {
-        WriteLog(LOG_LEVEL_WARNING, "Font scan path is too long: %ls", folderPath);
-        ctx->failed = TRUE;
-        return;
-    }
-
-    WIN32_FIND_DATAW findData;
-    HANDLE hFind = FindFirstFileW(searchPath, &findData);
-
-    if (hFind == INVALID_HANDLE_VALUE) {
-        DWORD error = GetLastError();
-        if (error != ERROR_FILE_NOT_FOUND &&
-            error != ERROR_PATH_NOT_FOUND &&
-            error != ERROR_NO_MORE_FILES) {
-            WriteLog(LOG_LEVEL_WARNING, "Font folder scan failed: %ls (error=%lu)",
-                     folderPath, error);
-            ctx->failed = TRUE;
-        }
-        return;
-    }
-
-    BOOL stoppedEarly = FALSE;
-    do {
-        if (ctx->full || FontMenuInternal_IsScanCanceled(generation)) {
-            stoppedEarly = TRUE;
-            break;
-        }
-
-        if (wcscmp(findData.cFileName, L".") == 0 ||
-            wcscmp(findData.cFileName, L"..") == 0) {
-            continue;
-        }
-
-        if (ctx->scannedEntries >= MAX_FONT_SCAN_ENTRIES) {
-            if (!ctx->truncated) {
-                WriteLog(LOG_LEVEL_WARNING, "Font scan entry limit reached (%d)",
-                         MAX_FONT_SCAN_ENTRIES);
-            }
-            ctx->truncated = TRUE;
-            ctx->full = TRUE;
-            stoppedEarly = TRUE;
-            break;
-        }
-        ctx->scannedEntries++;
-
-        wchar_t fullPath[MAX_PATH];
-        int len1 = _snwprintf_s(fullPath, MAX_PATH, _TRUNCATE, L"%s\\%s", folderPath, findData.cFileName);
-        if (len1 < 0 || len1 >= MAX_PATH) continue;
-
-        wchar_t newRelativePath[MAX_PATH];
-        if (!relativePath || relativePath[0] == L'\0') {
-            wcsncpy(newRelativePath, findData.cFileName, MAX_PATH - 1);
-            newRelativePath[MAX_PATH - 1] = L'\0';
-        } else {
-            int len2 = _snwprintf_s(newRelativePath, MAX_PATH, _TRUNCATE, L"%s\\%s", relativePath, findData.cFileName);
-            if (len2 < 0 || len2 >= MAX_PATH) continue;
-        }
-
-        BOOL isDirectory = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-        if (isDirectory) {
-            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
-                ScanFontFolderRecursive(fullPath, newRelativePath, ctx, depth + 1, generation);
-                if (ctx->failed) {
-                    stoppedEarly = TRUE;
-                    break;
-                }
-            }
-        } else {
-            const wchar_t* ext = wcsrchr(findData.cFileName, L'.');
-            if (ext && (_wcsicmp(ext, L".ttf") == 0 || _wcsicmp(ext, L".otf") == 0)) {
-                if (!AddFontEntry(ctx, findData.cFileName, newRelativePath)) {
-                    stoppedEarly = TRUE;
-                    break;
-                }
-            }
-        }
-    } while (!ctx->full && FindNextFileW(hFind, &findData));
-
-    DWORD findError = stoppedEarly ? ERROR_SUCCESS : GetLastError();
-    FindClose(hFind);
-    if (!stoppedEarly && findError != ERROR_NO_MORE_FILES) {
-        WriteLog(LOG_LEVEL_WARNING, "Font folder enumeration failed: %ls (error=%lu)",
-                 folderPath, findError);
-        ctx->failed = TRUE;
-    }
+void FontMenuInternal_ResetScanIndex(void) {
+    DirectoryIndex_Free(&g_fontDirectoryIndex);
 }
 
 int FontMenuInternal_ScanFontsFolder(FontEntry* entries, int capacity, LONG generation) {
@@ -159,6 +90,7 @@ int FontMenuInternal_ScanFontsFolder(FontEntry* entries, int capacity, LONG gene
     ctx.entries = entries;
     ctx.count = 0;
     ctx.capacity = capacity;
+    ctx.generation = generation;
 
     wchar_t fontsPath[MAX_PATH];
     if (!GetFontsFolderPath(fontsPath, MAX_PATH)) {
@@ -181,12 +113,23 @@ int FontMenuInternal_ScanFontsFolder(FontEntry* entries, int capacity, LONG gene
         return FONT_MENU_SCAN_FAILED;
     }
 
-    ScanFontFolderRecursive(fontsPath, L"", &ctx, 0, generation);
-    if (ctx.failed || FontMenuInternal_IsScanCanceled(generation)) {
+    DirectoryIndex_Init(&g_fontDirectoryIndex, MAX_RECURSION_DEPTH - 1,
+                        capacity, MAX_FONT_SCAN_ENTRIES, AcceptFontFile, NULL);
+    DirectoryIndexCallbacks callbacks = {
+        IsFontIndexScanCanceled, CountFontDelta, AddFontEntry, &ctx
+    };
+    int indexed = DirectoryIndex_Refresh(&g_fontDirectoryIndex, fontsPath, &callbacks);
+    if (indexed == DIRECTORY_INDEX_FAILED ||
+        FontMenuInternal_IsScanCanceled(generation)) {
         return FONT_MENU_SCAN_FAILED;
     }
 
-    WriteLog(LOG_LEVEL_INFO, "Font scan complete: %d fonts found%s",
-             ctx.count, ctx.truncated ? " (truncated)" : "");
+    DirectoryIndexStats stats;
+    DirectoryIndex_GetStats(&g_fontDirectoryIndex, &stats);
+    WriteLog(LOG_LEVEL_INFO,
+             "Font scan complete: %d fonts found%s (+%d ~%d -%d, %lu folders read, %lu reused)",
+             ctx.count, stats.truncated ? " (truncated)" : "",
+             ctx.added, ctx.changed, ctx.removed,
+             stats.enumeratedFolders, stats.reusedFolders);
     return ctx.count;
 }
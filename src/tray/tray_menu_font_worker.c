@@ -6,6 +6,8 @@
 #include "tray_menu_font_internal.h"
 
 #include "log.h"
+#include "log/log_trace.h"
+#include "tray/tray_menu_cache.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -76,6 +78,8 @@ BOOL FontMenuInternal_CleanupRetiredScanThreadLocked(DWORD waitMs) {
 
 static DWORD WINAPI FontScanThread(LPVOID lpParam) {
     LONG generation = (LONG)(INT_PTR)lpParam;
+    TraceSpan_NameThread("font-scan");
+    TRACE_SPAN_BEGIN(scanSpan, "FontMenu.Scan");
 
     FontEntry* entries = (FontEntry*)malloc((size_t)MAX_FONT_ENTRIES * sizeof(*entries));
     int count = FONT_MENU_SCAN_FAILED;
@@ -103,12 +107,14 @@ static DWORD WINAPI FontScanThread(LPVOID lpParam) {
             g_fontMenuCacheCount = count;
             g_fontMenuCacheReady = !scanFailed;
             g_fontMenuCacheFailed = scanFailed;
+            TrayMenuCache_Invalidate(TRAY_MENU_CACHE_FONT);
             InterlockedExchange(&g_fontMenuLastScanTick, (LONG)GetTickCount());
         }
         ReleaseSRWLockExclusive(&g_fontMenuCacheLock);
     }
 
     free(entries);
+    TRACE_SPAN_END(scanSpan);
     return 0;
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "tray_menu_submenus_internal.h"
+#include "tray/tray_menu_cache.h"
 
 static HBITMAP s_hUpdateDot = NULL;
 static int s_updateDotCx = 0;
@@ -274,6 +275,7 @@ HBITMAP TraySubmenu_GetVlainaCheckBitmap(void) {
 }
 
 void CleanupTraySubmenuResources(void) {
+    TrayMenuCache_Cleanup();
     if (s_hUpdateDot) {
         DeleteObject(s_hUpdateDot);
         s_hUpdateDot = NULL;
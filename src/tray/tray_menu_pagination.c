@@ -214,9 +214,11 @@ static BOOL PaginateMenuRange(
 
     MENUITEMINFOW moreItem = {0};
     moreItem.cbSize = sizeof(moreItem);
-    moreItem.fMask = MIIM_FTYPE | MIIM_STATE | MIIM_STRING | MIIM_SUBMENU;
+    moreItem.fMask = MIIM_DATA | MIIM_FTYPE | MIIM_STATE | MIIM_STRING |
+                     MIIM_SUBMENU;
     moreItem.fType = MFT_STRING;
     moreItem.fState = continuationChecked ? MFS_CHECKED : MFS_UNCHECKED;
+    moreItem.dwItemData = TRAY_MENU_PAGINATION_CONTINUATION_TAG;
     moreItem.dwTypeData = (wchar_t*)moreLabel;
     moreItem.hSubMenu = continuation;
     if (!InsertMenuItemW(
@@ -251,6 +253,11 @@ BOOL TrayMenuPagination_ApplyRange(
         existingTrailingItemCount, pageItemLimit, moreLabel, 0);
 }
 
+BOOL TrayMenuPagination_IsContinuationItem(const MENUITEMINFOW* item) {
+    return item && (item->fMask & MIIM_DATA) && item->hSubMenu &&
+           item->dwItemData == TRAY_MENU_PAGINATION_CONTINUATION_TAG;
+}
+
 BOOL TrayMenuPagination_ApplyRangeForCurrentMonitor(
     HMENU menu, const TrayMenuPaginationRange* range,
     const wchar_t* moreLabel) {
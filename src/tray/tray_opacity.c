@@ -6,6 +6,7 @@
 #include "tray_internal.h"
 #include "config.h"
 #include "config/config_defaults.h"
+#include "config/config_published.h"
 #include "language.h"
 #include "preview_display.h"
 #include "log.h"
@@ -114,10 +115,15 @@ void HandleTrayOpacityWheel(HWND hwnd, int wheelDirection,
         return;
     }
 
-    extern int ReadConfigOpacityStepNormal(void);
-    extern int ReadConfigOpacityStepFast(void);
-    int step = ctrlPressed ? ReadConfigOpacityStepFast()
-                           : ReadConfigOpacityStepNormal();
+    /* Wheel bursts read the published steps without touching the INI lock */
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    int step = ctrlPressed ? published->config.opacityStepFast
+                           : published->config.opacityStepNormal;
+    if (published->version == 0) {
+        step = ctrlPressed ? g_AppConfig.display.opacity_step_fast
+                           : g_AppConfig.display.opacity_step_normal;
+    }
+    PublishedConfig_Release(published);
     if (step <= 0) step = 1;
 
     int oldOpacity = CLOCK_WINDOW_OPACITY;
@@ -8,13 +8,35 @@
 #include "config.h"
 #include "system_monitor.h"
 #include "timer/timer.h"
+#include "drawing/drawing_sparkline.h"
 #include "tray/tray_animation_core.h"
 #include "tray/tray_animation_loader.h"
 #include "utils/network_rate.h"
+#include "window_procedure/window_drop_target.h"
 #include "log.h"
 #include <stdio.h>
 #include <string.h>
 
+#define TOOLTIP_SPARKLINE_SPAN_MS 120000ULL
+#define TOOLTIP_SPARKLINE_COLUMNS 8
+
+/* Two minutes of history as block characters; szTip is only 128 wide */
+static void AppendPercentSparkline(wchar_t* value, size_t valueSize,
+                                   SystemMonitorMetric metric) {
+    MetricHistoryPoint points[TOOLTIP_SPARKLINE_COLUMNS];
+    ULONGLONG now = GetTickCount64();
+    ULONGLONG from = now > TOOLTIP_SPARKLINE_SPAN_MS
+        ? now - TOOLTIP_SPARKLINE_SPAN_MS : 0;
+    if (SystemMonitor_QueryHistory(metric, from, now + 1, points,
+                                   _countof(points)) < 2) {
+        return;
+    }
+    wchar_t graph[TOOLTIP_SPARKLINE_COLUMNS + 2] = L" ";
+    Sparkline_FormatText(points, _countof(points), 100.0f,
+                         graph + 1, _countof(graph) - 1);
+    wcsncat_s(value, valueSize, graph, _TRUNCATE);
+}
+
 static void BuildBasicTooltip(
     wchar_t* tip, size_t tipSize,
     const SystemMonitorSnapshot* snapshot) {
@@ -30,10 +52,13 @@ static void BuildBasicTooltip(
     if (snapshot && snapshot->cpuAvailable) {
         _snwprintf_s(cpu, _countof(cpu), _TRUNCATE,
                      L"%.1f%%", snapshot->cpuPercent);
+        AppendPercentSparkline(cpu, _countof(cpu), SYSTEM_MONITOR_METRIC_CPU);
     }
     if (snapshot && snapshot->memoryAvailable) {
         _snwprintf_s(memory, _countof(memory), _TRUNCATE,
                      L"%.1f%%", snapshot->memoryPercent);
+        AppendPercentSparkline(memory, _countof(memory),
+                               SYSTEM_MONITOR_METRIC_MEMORY);
     }
     if (snapshot && snapshot->networkAvailable) {
         FormattedNetworkRate uploadRate = FormatNetworkBytesPerSecond(
@@ -148,6 +173,17 @@ static void AppendUptimeLine(wchar_t* tip, size_t tipSize) {
     wcsncat_s(tip, tipSize, extra, _TRUNCATE);
 }
 
+static void AppendDropImportLine(wchar_t* tip, size_t tipSize) {
+    int imported = 0;
+    DWORD scanned = 0;
+    if (!GetDropImportProgress(&imported, &scanned)) return;
+    wchar_t extra[64];
+    _snwprintf_s(extra, _countof(extra), _TRUNCATE,
+                 GetLocalizedString(NULL, L"Tray Tooltip Importing"),
+                 imported, (unsigned)scanned);
+    wcsncat_s(tip, tipSize, extra, _TRUNCATE);
+}
+
 void UpdateTrayTooltip(const wchar_t* tip) {
     HWND owner = GetValidTrayMainWindow();
     if (!tip || !owner || !IsTrayIconActiveForWindow(owner)) {
@@ -219,6 +255,7 @@ void CALLBACK TrayTipTimerProc(HWND hwnd, UINT msg, UINT_PTR id, DWORD time) {
         showAnimationSpeed = metric != ANIMATION_SPEED_ORIGINAL;
     }
     AppendUptimeLine(tip, _countof(tip));
+    AppendDropImportLine(tip, _countof(tip));
     if (showAnimationSpeed) {
         float cpu = sharedSnapshot ? sharedSnapshot->cpuPercent : 0.0f;
         float memory = sharedSnapshot
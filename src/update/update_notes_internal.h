@@ -25,6 +25,5 @@ BOOL UpdateNotes_Initialize(HWND dialog, const char* releaseNotes);
 void UpdateNotes_Cleanup(HWND dialog);
 void UpdateNotes_Recalculate(HWND dialog);
 BOOL UpdateNotes_Paint(HWND dialog, const DRAWITEMSTRUCT* item);
-void UpdateNotes_ReleasePaintBuffer(void);
 
 #endif
@@ -1,73 +1,11 @@
 #include "update_notes_internal.h"
 #include "dialog/dialog_modern.h"
+#include "drawing/drawing_dib_pool.h"
 #include "../../resource/resource.h"
 
 #include <stdlib.h>
 
 #define UPDATE_NOTES_MAX_PAINT_PIXELS (4096u * 4096u)
-#define UPDATE_NOTES_SHRINK_THRESHOLD 4u
-
-typedef struct {
-    HDC hdc;
-    HBITMAP bitmap;
-    HBITMAP previousBitmap;
-    int width;
-    int height;
-} NotesPaintBuffer;
-
-static NotesPaintBuffer g_paintBuffer;
-
-void UpdateNotes_ReleasePaintBuffer(void) {
-    if (g_paintBuffer.hdc && g_paintBuffer.previousBitmap) {
-        SelectObject(g_paintBuffer.hdc, g_paintBuffer.previousBitmap);
-    }
-    if (g_paintBuffer.bitmap) DeleteObject(g_paintBuffer.bitmap);
-    if (g_paintBuffer.hdc) DeleteDC(g_paintBuffer.hdc);
-    ZeroMemory(&g_paintBuffer, sizeof(g_paintBuffer));
-}
-
-static BOOL EnsurePaintBuffer(HDC target, int width, int height,
-                              HDC* paintDc) {
-    if (!target || !paintDc || width <= 0 || height <= 0) return FALSE;
-    if ((size_t)width > UPDATE_NOTES_MAX_PAINT_PIXELS / (size_t)height) {
-        return FALSE;
-    }
-
-    if (g_paintBuffer.hdc && g_paintBuffer.width >= width &&
-        g_paintBuffer.height >= height) {
-        size_t requested = (size_t)width * (size_t)height;
-        size_t cached = (size_t)g_paintBuffer.width *
-                        (size_t)g_paintBuffer.height;
-        if (requested > 0 &&
-            cached / UPDATE_NOTES_SHRINK_THRESHOLD <= requested) {
-            *paintDc = g_paintBuffer.hdc;
-            return TRUE;
-        }
-    }
-
-    HDC memoryDc = CreateCompatibleDC(target);
-    if (!memoryDc) return FALSE;
-    HBITMAP bitmap = CreateCompatibleBitmap(target, width, height);
-    if (!bitmap) {
-        DeleteDC(memoryDc);
-        return FALSE;
-    }
-    HBITMAP previous = (HBITMAP)SelectObject(memoryDc, bitmap);
-    if (!previous) {
-        DeleteObject(bitmap);
-        DeleteDC(memoryDc);
-        return FALSE;
-    }
-
-    UpdateNotes_ReleasePaintBuffer();
-    g_paintBuffer.hdc = memoryDc;
-    g_paintBuffer.bitmap = bitmap;
-    g_paintBuffer.previousBitmap = previous;
-    g_paintBuffer.width = width;
-    g_paintBuffer.height = height;
-    *paintDc = memoryDc;
-    return TRUE;
-}
 
 static void DrawNotesContent(HWND dialog, const DRAWITEMSTRUCT* item,
                              HDC paintDc, RECT rect,
@@ -126,10 +64,15 @@ BOOL UpdateNotes_Paint(HWND dialog, const DRAWITEMSTRUCT* item) {
                  targetRect.bottom - targetRect.top};
     int width = rect.right;
     int height = rect.bottom;
-    if (width <= 0 || height <= 0) return TRUE;
+    if (width <= 0 || height <= 0 ||
+        (size_t)width > UPDATE_NOTES_MAX_PAINT_PIXELS / (size_t)height) {
+        return TRUE;
+    }
 
-    HDC paintDc = NULL;
-    if (!EnsurePaintBuffer(item->hDC, width, height, &paintDc)) return TRUE;
+    DibPaintBuffer buffer;
+    HDC paintDc = DibPool_BeginPaintBuffer(item->hDC, targetRect.left, targetRect.top,
+                                           width, height, &buffer);
+    if (paintDc == item->hDC) return TRUE;
     DialogModernPalette palette;
     DialogModern_CopyPalette(dialog, &palette);
     HBRUSH background = CreateSolidBrush(palette.surface);
@@ -143,7 +86,6 @@ BOOL UpdateNotes_Paint(HWND dialog, const DRAWITEMSTRUCT* item) {
         paintDc, &panel, DialogModern_Scale(DialogModern_GetDpi(dialog), 14),
         palette.field, palette.border, 1);
     DrawNotesContent(dialog, item, paintDc, rect, &palette);
-    BitBlt(item->hDC, targetRect.left, targetRect.top, width, height,
-           paintDc, 0, 0, SRCCOPY);
+    DibPool_EndPaintBuffer(&buffer);
     return TRUE;
 }
@@ -66,7 +66,6 @@ void UpdateNotes_Cleanup(HWND dialog) {
     free(g_notesDisplayText);
     g_notesDisplayText = NULL;
     g_notesTextHeight = 0;
-    UpdateNotes_ReleasePaintBuffer();
 }
 
 static void ParseNotes(const wchar_t* source) {
@@ -0,0 +1,251 @@
+/**
+ * @file directory_index.c
+ * @brief Incremental directory index storage and delta commit
+ */
+
+#include "directory_index_internal.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+static BOOL EnsureCapacity(void** items, int* capacity, int required,
+                           size_t itemSize) {
+    if (required <= *capacity) return TRUE;
+    int newCapacity = *capacity > 0 ? *capacity : DIRECTORY_INDEX_INITIAL_CAPACITY;
+    while (newCapacity < required) {
+        if (newCapacity > INT_MAX / 2) return FALSE;
+        newCapacity *= 2;
+    }
+    void* resized = realloc(*items, itemSize * (size_t)newCapacity);
+    if (!resized) return FALSE;
+    *items = resized;
+    *capacity = newCapacity;
+    return TRUE;
+}
+
+void DirectoryIndexInternal_ClearLocked(DirectoryIndex* index) {
+    free(index->entries);
+    free(index->folders);
+    DirectoryIndexInternal_FreeLookup(index);
+    index->entries = NULL;
+    index->folders = NULL;
+    index->entryCount = 0;
+    index->entryCapacity = 0;
+    index->folderCount = 0;
+    index->folderCapacity = 0;
+    index->root[0] = L'\0';
+    index->needsFullScan = TRUE;
+    index->truncated = FALSE;
+}
+
+void DirectoryIndex_Init(DirectoryIndex* index, int maxDepth,
+                         int maxEntries, int maxScanEntries,
+                         DirectoryIndexAcceptCallback accept,
+                         void* acceptContext) {
+    if (!index) return;
+    AcquireSRWLockExclusive(&index->lock);
+    if (index->maxDepth != maxDepth || index->maxEntries != maxEntries ||
+        index->maxScanEntries != maxScanEntries || index->accept != accept ||
+        index->acceptContext != acceptContext) {
+        DirectoryIndexInternal_ClearLocked(index);
+    }
+    index->maxDepth = maxDepth < 0 ? 0 : maxDepth;
+    index->maxEntries = maxEntries;
+    index->maxScanEntries = maxScanEntries;
+    index->accept = accept;
+    index->acceptContext = acceptContext;
+    ReleaseSRWLockExclusive(&index->lock);
+}
+
+void DirectoryIndex_Invalidate(DirectoryIndex* index) {
+    if (!index) return;
+    AcquireSRWLockExclusive(&index->lock);
+    index->needsFullScan = TRUE;
+    ReleaseSRWLockExclusive(&index->lock);
+}
+
+void DirectoryIndex_GetStats(DirectoryIndex* index, DirectoryIndexStats* stats) {
+    if (!stats) return;
+    ZeroMemory(stats, sizeof(*stats));
+    if (!index) return;
+    AcquireSRWLockShared(&index->lock);
+    stats->entryCount = index->entryCount;
+    stats->truncated = index->truncated;
+    stats->enumeratedFolders = index->enumeratedFolders;
+    stats->reusedFolders = index->reusedFolders;
+    ReleaseSRWLockShared(&index->lock);
+}
+
+void DirectoryIndex_Free(DirectoryIndex* index) {
+    if (!index) return;
+    AcquireSRWLockExclusive(&index->lock);
+    DirectoryIndexInternal_ClearLocked(index);
+    ReleaseSRWLockExclusive(&index->lock);
+}
+
+const wchar_t* DirectoryIndex_EntryFileName(const DirectoryIndexEntry* entry) {
+    if (!entry) return L"";
+    return entry->relativePath + entry->nameOffset;
+}
+
+BOOL DirectoryIndexInternal_IsCanceled(const DirectoryIndexPass* pass) {
+    return pass && pass->callbacks && pass->callbacks->isCanceled &&
+           pass->callbacks->isCanceled(pass->callbacks->context);
+}
+
+int DirectoryIndexInternal_AddFolder(DirectoryIndex* index,
+                                     const wchar_t* relativePath,
+                                     int parent, int depth) {
+    if (!EnsureCapacity((void**)&index->folders, &index->folderCapacity,
+                        index->folderCount + 1, sizeof(*index->folders))) {
+        return -1;
+    }
+    DirectoryIndexFolder* folder = &index->folders[index->folderCount];
+    ZeroMemory(folder, sizeof(*folder));
+    wcsncpy_s(folder->relativePath, MAX_PATH, relativePath, _TRUNCATE);
+    folder->pathHash = DirectoryIndexInternal_HashPath(folder->relativePath);
+    folder->parent = parent;
+    folder->depth = depth;
+    int added = index->folderCount++;
+    if (!DirectoryIndexInternal_LinkFolder(index, added)) {
+        index->folderCount--;
+        return -1;
+    }
+    return added;
+}
+
+void DirectoryIndexInternal_MarkFolderFilesSeen(DirectoryIndex* index,
+                                                int folder) {
+    int i = index->folders[folder].firstFile;
+    for (; i >= 0; i = index->entries[i].nextInFolder) {
+        index->entries[i].seen = TRUE;
+        index->scannedEntries++;
+    }
+}
+
+BOOL DirectoryIndexInternal_StoreFile(DirectoryIndexPass* pass, int folder,
+                                      const wchar_t* relativePath,
+                                      const WIN32_FIND_DATAW* data) {
+    DirectoryIndex* index = pass->index;
+    ULONGLONG hash = DirectoryIndexInternal_HashPath(relativePath);
+    ULONGLONG size = ((ULONGLONG)data->nFileSizeHigh << 32) | data->nFileSizeLow;
+    int existing =
+        DirectoryIndexInternal_FindEntry(index, folder, hash, relativePath);
+    if (existing >= 0) {
+        DirectoryIndexEntry* entry = &index->entries[existing];
+        if (entry->size == size &&
+            CompareFileTime(&entry->lastWriteTime, &data->ftLastWriteTime) == 0) {
+            entry->seen = TRUE;
+            return TRUE;
+        }
+    }
+
+    BYTE metadata[DIRECTORY_INDEX_METADATA_BYTES] = {0};
+    if (index->accept && !index->accept(data, metadata, index->acceptContext)) {
+        return TRUE;
+    }
+
+    if (existing < 0) {
+        if (index->maxEntries > 0 && index->entryCount >= index->maxEntries) {
+            pass->full = TRUE;
+            return FALSE;
+        }
+        if (!EnsureCapacity((void**)&index->entries, &index->entryCapacity,
+                            index->entryCount + 1, sizeof(*index->entries))) {
+            pass->failed = TRUE;
+            return FALSE;
+        }
+        existing = index->entryCount++;
+        DirectoryIndexEntry* added = &index->entries[existing];
+        ZeroMemory(added, sizeof(*added));
+        wcsncpy_s(added->relativePath, MAX_PATH, relativePath, _TRUNCATE);
+        const wchar_t* separator = wcsrchr(added->relativePath, L'\\');
+        added->nameOffset =
+            (WORD)(separator ? (separator - added->relativePath) + 1 : 0);
+        added->pathHash = hash;
+        added->folder = folder;
+        if (!DirectoryIndexInternal_LinkEntry(index, existing)) {
+            index->entryCount--;
+            pass->failed = TRUE;
+            return FALSE;
+        }
+    } else {
+        index->entries[existing].changed = TRUE;
+    }
+
+    DirectoryIndexEntry* entry = &index->entries[existing];
+    entry->size = size;
+    entry->lastWriteTime = data->ftLastWriteTime;
+    memcpy(entry->metadata, metadata, sizeof(entry->metadata));
+    entry->seen = TRUE;
+    return TRUE;
+}
+
+void DirectoryIndexInternal_ResetSeen(DirectoryIndex* index) {
+    for (int i = 0; i < index->folderCount; i++) {
+        index->folders[i].seen = FALSE;
+    }
+    for (int i = 0; i < index->entryCount; i++) {
+        index->entries[i].seen = FALSE;
+    }
+    index->scannedEntries = 0;
+    index->enumeratedFolders = 0;
+    index->reusedFolders = 0;
+}
+
+static void ReportDelta(DirectoryIndexPass* pass, DirectoryIndexChange change,
+                        const DirectoryIndexEntry* entry) {
+    if (pass->callbacks && pass->callbacks->onDelta) {
+        pass->callbacks->onDelta(change, entry, pass->callbacks->context);
+    }
+}
+
+BOOL DirectoryIndexInternal_Commit(DirectoryIndexPass* pass) {
+    DirectoryIndex* index = pass->index;
+
+    /* Folders only ever reference earlier parents, so one forward pass
+     * can compact them and build the old-to-new index map together. */
+    int* remap = (int*)malloc(sizeof(int) * (size_t)(index->folderCount + 1));
+    if (!remap) return FALSE;
+    int keptFolders = 0;
+    for (int i = 0; i < index->folderCount; i++) {
+        DirectoryIndexFolder folder = index->folders[i];
+        int parent = folder.parent >= 0 ? remap[folder.parent] : folder.parent;
+        if (!folder.seen || (folder.parent >= 0 && parent < 0)) {
+            remap[i] = -1;
+            continue;
+        }
+        folder.parent = parent;
+        index->folders[keptFolders] = folder;
+        remap[i] = keptFolders++;
+    }
+
+    int keptEntries = 0;
+    for (int i = 0; i < index->entryCount; i++) {
+        DirectoryIndexEntry* entry = &index->entries[i];
+        int folder = remap[entry->folder];
+        if (!entry->seen || folder < 0) {
+            if (entry->reported) ReportDelta(pass, DIRECTORY_INDEX_REMOVED, entry);
+            continue;
+        }
+        if (!entry->reported) {
+            ReportDelta(pass, DIRECTORY_INDEX_ADDED, entry);
+        } else if (entry->changed) {
+            ReportDelta(pass, DIRECTORY_INDEX_CHANGED, entry);
+        }
+        entry->reported = TRUE;
+        entry->changed = FALSE;
+        entry->folder = folder;
+        if (keptEntries != i) index->entries[keptEntries] = *entry;
+        keptEntries++;
+    }
+
+    free(remap);
+    index->folderCount = keptFolders;
+    index->entryCount = keptEntries;
+    index->truncated = pass->full;
+    index->needsFullScan = pass->full || keptFolders == 0;
+    return TRUE;
+}
@@ -0,0 +1,40 @@
+#ifndef DIRECTORY_INDEX_INTERNAL_H
+#define DIRECTORY_INDEX_INTERNAL_H
+
+#include "utils/directory_index.h"
+
+#define DIRECTORY_INDEX_INITIAL_CAPACITY 64
+#define DIRECTORY_INDEX_NO_PARENT (-1)
+
+typedef struct {
+    DirectoryIndex* index;
+    const DirectoryIndexCallbacks* callbacks;
+    BOOL full;
+    BOOL failed;
+} DirectoryIndexPass;
+
+void DirectoryIndexInternal_ClearLocked(DirectoryIndex* index);
+BOOL DirectoryIndexInternal_IsCanceled(const DirectoryIndexPass* pass);
+ULONGLONG DirectoryIndexInternal_HashPath(const wchar_t* path);
+BOOL DirectoryIndexInternal_RebuildLookup(DirectoryIndex* index);
+BOOL DirectoryIndexInternal_LinkFolder(DirectoryIndex* index, int folder);
+BOOL DirectoryIndexInternal_LinkEntry(DirectoryIndex* index, int entry);
+void DirectoryIndexInternal_FreeLookup(DirectoryIndex* index);
+int DirectoryIndexInternal_FindFolder(const DirectoryIndex* index,
+                                      const wchar_t* relativePath);
+int DirectoryIndexInternal_FindEntry(const DirectoryIndex* index, int folder,
+                                     ULONGLONG hash,
+                                     const wchar_t* relativePath);
+int DirectoryIndexInternal_AddFolder(DirectoryIndex* index,
+                                     const wchar_t* relativePath,
+                                     int parent, int depth);
+void DirectoryIndexInternal_MarkFolderFilesSeen(DirectoryIndex* index,
+                                                int folder);
+BOOL DirectoryIndexInternal_StoreFile(DirectoryIndexPass* pass, int folder,
+                                      const wchar_t* relativePath,
+                                      const WIN32_FIND_DATAW* data);
+void DirectoryIndexInternal_ResetSeen(DirectoryIndex* index);
+BOOL DirectoryIndexInternal_Commit(DirectoryIndexPass* pass);
+BOOL DirectoryIndexInternal_ScanFolder(DirectoryIndexPass* pass, int folder);
+
+#endif /* DIRECTORY_INDEX_INTERNAL_H */
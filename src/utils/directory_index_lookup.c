@@ -0,0 +1,145 @@
+/**
+ * @file directory_index_lookup.c
+ * @brief Path hash buckets and per-folder links for the directory index
+ *
+ * Buckets chain entries and folders by pathHash; each folder also links its
+ * child folders and files. All links are array indices, rebuilt in one pass
+ * whenever the arrays are compacted or outgrow the bucket table, so a
+ * refresh stays linear in the size of the tree.
+ */
+
+#include "directory_index_internal.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+static wchar_t ToLowerAsciiChar(wchar_t ch) {
+    return (ch >= L'A' && ch <= L'Z') ? (wchar_t)(ch - L'A' + L'a') : ch;
+}
+
+ULONGLONG DirectoryIndexInternal_HashPath(const wchar_t* path) {
+    ULONGLONG hash = 1469598103934665603ull;
+    while (path && *path) {
+        hash ^= (ULONGLONG)ToLowerAsciiChar(*path++);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static int BucketOf(ULONGLONG hash, int bucketCount) {
+    return (int)((hash ^ (hash >> 32)) & (ULONGLONG)(bucketCount - 1));
+}
+
+/** @brief Resize to a power of two at least twice count; every bucket empty */
+static BOOL ResetBuckets(int** buckets, int* bucketCount, int count) {
+    int wanted = DIRECTORY_INDEX_INITIAL_CAPACITY;
+    while (wanted < count * 2) {
+        if (wanted > INT_MAX / 2) return FALSE;
+        wanted *= 2;
+    }
+    if (wanted != *bucketCount) {
+        int* resized = (int*)realloc(*buckets, sizeof(int) * (size_t)wanted);
+        if (!resized) return FALSE;
+        *buckets = resized;
+        *bucketCount = wanted;
+    }
+    for (int i = 0; i < wanted; i++) (*buckets)[i] = -1;
+    return TRUE;
+}
+
+static void LinkFolder(DirectoryIndex* index, int folder) {
+    DirectoryIndexFolder* item = &index->folders[folder];
+    int bucket = BucketOf(item->pathHash, index->folderBucketCount);
+    item->nextInBucket = index->folderBuckets[bucket];
+    index->folderBuckets[bucket] = folder;
+    item->firstChild = -1;
+    item->lastChild = -1;
+    item->nextSibling = -1;
+    item->firstFile = -1;
+
+    /* Appended, so children are rescanned in the order they were found */
+    if (item->parent < 0) return;
+    DirectoryIndexFolder* parent = &index->folders[item->parent];
+    if (parent->lastChild >= 0) {
+        index->folders[parent->lastChild].nextSibling = folder;
+    } else {
+        parent->firstChild = folder;
+    }
+    parent->lastChild = folder;
+}
+
+static void LinkEntry(DirectoryIndex* index, int entry) {
+    DirectoryIndexEntry* item = &index->entries[entry];
+    int bucket = BucketOf(item->pathHash, index->entryBucketCount);
+    item->nextInBucket = index->entryBuckets[bucket];
+    index->entryBuckets[bucket] = entry;
+    item->nextInFolder = index->folders[item->folder].firstFile;
+    index->folders[item->folder].firstFile = entry;
+}
+
+BOOL DirectoryIndexInternal_RebuildLookup(DirectoryIndex* index) {
+    if (!ResetBuckets(&index->folderBuckets, &index->folderBucketCount,
+                      index->folderCount) ||
+        !ResetBuckets(&index->entryBuckets, &index->entryBucketCount,
+                      index->entryCount)) {
+        return FALSE;
+    }
+    /* Parents always precede their children, so one forward pass suffices */
+    for (int i = 0; i < index->folderCount; i++) LinkFolder(index, i);
+    for (int i = 0; i < index->entryCount; i++) LinkEntry(index, i);
+    return TRUE;
+}
+
+BOOL DirectoryIndexInternal_LinkFolder(DirectoryIndex* index, int folder) {
+    if (index->folderCount * 2 > index->folderBucketCount) {
+        return DirectoryIndexInternal_RebuildLookup(index);
+    }
+    LinkFolder(index, folder);
+    return TRUE;
+}
+
+BOOL DirectoryIndexInternal_LinkEntry(DirectoryIndex* index, int entry) {
+    if (index->entryCount * 2 > index->entryBucketCount) {
+        return DirectoryIndexInternal_RebuildLookup(index);
+    }
+    LinkEntry(index, entry);
+    return TRUE;
+}
+
+void DirectoryIndexInternal_FreeLookup(DirectoryIndex* index) {
+    free(index->entryBuckets);
+    free(index->folderBuckets);
+    index->entryBuckets = NULL;
+    index->folderBuckets = NULL;
+    index->entryBucketCount = 0;
+    index->folderBucketCount = 0;
+}
+
+int DirectoryIndexInternal_FindFolder(const DirectoryIndex* index,
+                                      const wchar_t* relativePath) {
+    if (index->folderBucketCount == 0) return -1;
+    ULONGLONG hash = DirectoryIndexInternal_HashPath(relativePath);
+    int i = index->folderBuckets[BucketOf(hash, index->folderBucketCount)];
+    for (; i >= 0; i = index->folders[i].nextInBucket) {
+        if (index->folders[i].pathHash == hash &&
+            _wcsicmp(index->folders[i].relativePath, relativePath) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int DirectoryIndexInternal_FindEntry(const DirectoryIndex* index, int folder,
+                                     ULONGLONG hash,
+                                     const wchar_t* relativePath) {
+    if (index->entryBucketCount == 0) return -1;
+    int i = index->entryBuckets[BucketOf(hash, index->entryBucketCount)];
+    for (; i >= 0; i = index->entries[i].nextInBucket) {
+        const DirectoryIndexEntry* entry = &index->entries[i];
+        if (entry->folder == folder && entry->pathHash == hash &&
+            _wcsicmp(entry->relativePath, relativePath) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file directory_index_scan.c
+ * @brief Folder walk that re-enumerates only folders whose write time changed
+ */
+
+#include "directory_index_internal.h"
+#include "log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <wchar.h>
+
+static BOOL BuildChildPath(wchar_t* outPath, const wchar_t* parent,
+                           const wchar_t* name) {
+    if (name[0] == L'\0') {
+        return wcsncpy_s(outPath, MAX_PATH, parent, _TRUNCATE) == 0;
+    }
+    if (!parent || parent[0] == L'\0') {
+        return wcsncpy_s(outPath, MAX_PATH, name, _TRUNCATE) == 0;
+    }
+    int written = _snwprintf_s(outPath, MAX_PATH, _TRUNCATE,
+                               L"%s\\%s", parent, name);
+    return written >= 0 && written < MAX_PATH;
+}
+
+static BOOL HasScanBudget(DirectoryIndexPass* pass) {
+    DirectoryIndex* index = pass->index;
+    if (index->maxScanEntries > 0 &&
+        index->scannedEntries >= index->maxScanEntries) {
+        if (!pass->full) {
+            LOG_WARNING("Directory index scan limit reached (%d entries): %ls",
+                        index->maxScanEntries, index->root);
+        }
+        pass->full = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static BOOL ScanChildFolder(DirectoryIndexPass* pass, int parent,
+                            const wchar_t* relativePath) {
+    DirectoryIndex* index = pass->index;
+    int child = DirectoryIndexInternal_FindFolder(index, relativePath);
+    if (child < 0) {
+        child = DirectoryIndexInternal_AddFolder(
+            index, relativePath, parent, index->folders[parent].depth + 1);
+        if (child < 0) {
+            pass->failed = TRUE;
+            return FALSE;
+        }
+    }
+    return DirectoryIndexInternal_ScanFolder(pass, child);
+}
+
+static BOOL EnumerateFolder(DirectoryIndexPass* pass, int folder,
+                            const wchar_t* fullPath) {
+    DirectoryIndex* index = pass->index;
+    wchar_t searchPath[MAX_PATH];
+    int written = _snwprintf_s(searchPath, MAX_PATH, _TRUNCATE,
+                               L"%s\\*", fullPath);
+    if (written < 0 || written >= MAX_PATH) {
+        LOG_WARNING("Directory index path is too long: %ls", fullPath);
+        pass->failed = TRUE;
+        return FALSE;
+    }
+
+    WIN32_FIND_DATAW findData;
+    HANDLE hFind = FindFirstFileW(searchPath, &findData);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND ||
+            error == ERROR_NO_MORE_FILES) {
+            return TRUE;
+        }
+        LOG_WARNING("Directory index scan failed: %ls (error=%lu)",
+                    fullPath, error);
+        pass->failed = TRUE;
+        return FALSE;
+    }
+
+    index->enumeratedFolders++;
+    BOOL stoppedEarly = FALSE;
+    do {
+        if (DirectoryIndexInternal_IsCanceled(pass)) {
+            pass->failed = TRUE;
+            stoppedEarly = TRUE;
+            break;
+        }
+        if (wcscmp(findData.cFileName, L".") == 0 ||
+            wcscmp(findData.cFileName, L"..") == 0) {
+            continue;
+        }
+        if (!HasScanBudget(pass)) {
+            stoppedEarly = TRUE;
+            break;
+        }
+        index->scannedEntries++;
+
+        wchar_t childRelativePath[MAX_PATH];
+        if (!BuildChildPath(childRelativePath,
+                            index->folders[folder].relativePath,
+                            findData.cFileName)) {
+            continue;
+        }
+
+        BOOL isDirectory =
+            (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        BOOL keepGoing = TRUE;
+        if (isDirectory) {
+            if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) &&
+                index->folders[folder].depth < index->maxDepth) {
+                keepGoing = ScanChildFolder(pass, folder, childRelativePath);
+            }
+        } else {
+            keepGoing = DirectoryIndexInternal_StoreFile(
+                pass, folder, childRelativePath, &findData);
+        }
+        if (!keepGoing || pass->failed || pass->full) {
+            stoppedEarly = TRUE;
+            break;
+        }
+    } while (FindNextFileW(hFind, &findData));
+
+    DWORD findError = stoppedEarly ? ERROR_SUCCESS : GetLastError();
+    FindClose(hFind);
+    if (!stoppedEarly && findError != ERROR_NO_MORE_FILES) {
+        LOG_WARNING("Directory index enumeration failed: %ls (error=%lu)",
+                    fullPath, findError);
+        pass->failed = TRUE;
+    }
+    return !stoppedEarly && !pass->failed;
+}
+
+static BOOL ReuseFolder(DirectoryIndexPass* pass, int folder) {
+    DirectoryIndex* index = pass->index;
+    index->reusedFolders++;
+    DirectoryIndexInternal_MarkFolderFilesSeen(index, folder);
+
+    /* A folder's write time does not cover its subfolders, so each known
+     * child is still stat'ed; only the enumeration is skipped. */
+    int child = index->folders[folder].firstChild;
+    for (; child >= 0; child = index->folders[child].nextSibling) {
+        if (!DirectoryIndexInternal_ScanFolder(pass, child) &&
+            (pass->failed || pass->full)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+BOOL DirectoryIndexInternal_ScanFolder(DirectoryIndexPass* pass, int folder) {
+    DirectoryIndex* index = pass->index;
+    if (DirectoryIndexInternal_IsCanceled(pass)) {
+        pass->failed = TRUE;
+        return FALSE;
+    }
+
+    wchar_t fullPath[MAX_PATH];
+    if (!BuildChildPath(fullPath, index->root,
+                        index->folders[folder].relativePath)) {
+        return TRUE;
+    }
+
+    WIN32_FILE_ATTRIBUTE_DATA attrs;
+    if (!GetFileAttributesExW(fullPath, GetFileExInfoStandard, &attrs)) {
+        DWORD error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND) {
+            return TRUE;
+        }
+        LOG_WARNING("Directory index stat failed: %ls (error=%lu)",
+                    fullPath, error);
+        pass->failed = TRUE;
+        return FALSE;
+    }
+    if (!(attrs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ||
+        (folder > 0 && (attrs.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))) {
+        return TRUE;
+    }
+
+    index->folders[folder].seen = TRUE;
+    FILETIME known = index->folders[folder].lastWriteTime;
+    BOOL unchanged = !index->needsFullScan &&
+                     (known.dwLowDateTime != 0 || known.dwHighDateTime != 0) &&
+                     CompareFileTime(&known, &attrs.ftLastWriteTime) == 0;
+    if (unchanged) {
+        return ReuseFolder(pass, folder);
+    }
+
+    /* Clear first so an interrupted enumeration is retried next time. */
+    ZeroMemory(&index->folders[folder].lastWriteTime, sizeof(FILETIME));
+    if (!EnumerateFolder(pass, folder, fullPath)) {
+        return FALSE;
+    }
+    index->folders[folder].lastWriteTime = attrs.ftLastWriteTime;
+    return TRUE;
+}
+
+static void VisitEntries(DirectoryIndex* index,
+                         const DirectoryIndexCallbacks* callbacks) {
+    if (!callbacks || !callbacks->onEntry) return;
+    for (int i = 0; i < index->entryCount; i++) {
+        if (!callbacks->onEntry(&index->entries[i], callbacks->context)) {
+            return;
+        }
+    }
+}
+
+int DirectoryIndex_Refresh(DirectoryIndex* index, const wchar_t* root,
+                           const DirectoryIndexCallbacks* callbacks) {
+    if (!index || !root || root[0] == L'\0' || wcslen(root) >= MAX_PATH) {
+        return DIRECTORY_INDEX_FAILED;
+    }
+
+    AcquireSRWLockExclusive(&index->lock);
+    if (_wcsicmp(index->root, root) != 0) {
+        DirectoryIndexInternal_ClearLocked(index);
+        wcsncpy_s(index->root, MAX_PATH, root, _TRUNCATE);
+    }
+
+    DirectoryIndexPass pass = {0};
+    pass.index = index;
+    pass.callbacks = callbacks;
+    DirectoryIndexInternal_ResetSeen(index);
+    if (!DirectoryIndexInternal_RebuildLookup(index)) {
+        pass.failed = TRUE;
+    } else if (index->folderCount == 0 &&
+        DirectoryIndexInternal_AddFolder(index, L"", DIRECTORY_INDEX_NO_PARENT,
+                                         0) < 0) {
+        pass.failed = TRUE;
+    }
+
+    if (!pass.failed) {
+        DirectoryIndexInternal_ScanFolder(&pass, 0);
+    }
+    int result = DIRECTORY_INDEX_FAILED;
+    if (!pass.failed && !DirectoryIndexInternal_IsCanceled(&pass) &&
+        DirectoryIndexInternal_Commit(&pass)) {
+        VisitEntries(index, callbacks);
+        result = index->entryCount;
+    } else {
+        index->needsFullScan = TRUE;
+    }
+    ReleaseSRWLockExclusive(&index->lock);
+    return result;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file hdr_histogram.c
+ * @brief Log-linear bucket math and percentile queries.
+ */
+
+#include "utils/hdr_histogram.h"
+
+static int HighestBit(DWORD value) {
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+int HdrHistogram_BucketIndex(DWORD value) {
+    if (value < HDR_HISTOGRAM_SUB_BUCKETS) return (int)value;
+    int shift = HighestBit(value) - (HDR_HISTOGRAM_SUB_BUCKET_BITS - 1);
+    return shift * HDR_HISTOGRAM_HALF_BUCKETS + (int)(value >> shift);
+}
+
+DWORD HdrHistogram_BucketHighestValue(int index) {
+    if (index < 0) return 0;
+    if (index < HDR_HISTOGRAM_SUB_BUCKETS) return (DWORD)index;
+    int shift = index / HDR_HISTOGRAM_HALF_BUCKETS - 1;
+    ULONGLONG subBucket = (ULONGLONG)(index % HDR_HISTOGRAM_HALF_BUCKETS) +
+                          HDR_HISTOGRAM_HALF_BUCKETS;
+    ULONGLONG highest = ((subBucket + 1) << shift) - 1;
+    return highest > MAXDWORD ? MAXDWORD : (DWORD)highest;
+}
+
+void HdrHistogram_Reset(HdrHistogram* histogram) {
+    if (!histogram) return;
+    ZeroMemory(histogram, sizeof(*histogram));
+}
+
+void HdrHistogram_Record(HdrHistogram* histogram, DWORD value) {
+    if (!histogram) return;
+    int index = HdrHistogram_BucketIndex(value);
+    if (index >= HDR_HISTOGRAM_BUCKETS) index = HDR_HISTOGRAM_BUCKETS - 1;
+    if (histogram->counts[index] < MAXDWORD) histogram->counts[index]++;
+    if (histogram->totalCount == 0 || value < histogram->min) histogram->min = value;
+    if (value > histogram->max) histogram->max = value;
+    histogram->totalCount++;
+    histogram->sum += value;
+}
+
+DWORD HdrHistogram_ValueAtPercentile(const HdrHistogram* histogram, double percentile) {
+    if (!histogram || histogram->totalCount == 0) return 0;
+    if (percentile < 0.0) percentile = 0.0;
+    if (percentile > 100.0) percentile = 100.0;
+
+    ULONGLONG target = (ULONGLONG)((percentile / 100.0) * (double)histogram->totalCount + 0.5);
+    if (target == 0) target = 1;
+    ULONGLONG seen = 0;
+    for (int i = 0; i < HDR_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= target) {
+            DWORD value = HdrHistogram_BucketHighestValue(i);
+            return value > histogram->max ? histogram->max : value;
+        }
+    }
+    return histogram->max;
+}
+
+DWORD HdrHistogram_Mean(const HdrHistogram* histogram) {
+    if (!histogram || histogram->totalCount == 0) return 0;
+    return (DWORD)(histogram->sum / histogram->totalCount);
+}
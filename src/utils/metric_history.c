@@ -0,0 +1,150 @@
+/**
+ * @file metric_history.c
+ * @brief Tiered ring buckets and range resampling.
+ */
+
+#include "utils/metric_history.h"
+#include "utils/finite_double.h"
+
+typedef struct {
+    DWORD resolutionMs;
+    DWORD capacity;
+    DWORD offset;
+} MetricHistoryTier;
+
+static const MetricHistoryTier kTiers[METRIC_HISTORY_TIER_COUNT] = {
+    {1000u, 300u, 0u},
+    {10000u, 360u, 300u},
+    {60000u, 1440u, 660u},
+};
+
+/* Epoch 0 marks an empty slot, so bucket numbers start at 1 */
+static DWORD EpochForTick(const MetricHistoryTier* tier, ULONGLONG tickMs) {
+    return (DWORD)(tickMs / tier->resolutionMs) + 1u;
+}
+
+static void FoldSample(MetricHistoryBucket* bucket, DWORD epoch, float value) {
+    if (bucket->epoch != epoch) {
+        bucket->epoch = epoch;
+        bucket->count = 1;
+        bucket->min = value;
+        bucket->max = value;
+        bucket->sum = value;
+        return;
+    }
+    if (value < bucket->min) bucket->min = value;
+    if (value > bucket->max) bucket->max = value;
+    bucket->sum += value;
+    if (bucket->count < MAXDWORD) bucket->count++;
+}
+
+void MetricHistory_Reset(MetricHistory* history) {
+    if (!history) return;
+    ZeroMemory(history, sizeof(*history));
+}
+
+void MetricHistory_Insert(MetricHistory* history, ULONGLONG tickMs, float value) {
+    if (!history || !DoubleIsFiniteStrict((double)value)) return;
+    for (int i = 0; i < METRIC_HISTORY_TIER_COUNT; ++i) {
+        const MetricHistoryTier* tier = &kTiers[i];
+        DWORD epoch = EpochForTick(tier, tickMs);
+        MetricHistoryBucket* bucket =
+            &history->slots[tier->offset + epoch % tier->capacity];
+        /* A newer lap already owns this slot; the sample is out of range */
+        if (bucket->epoch > epoch) continue;
+        FoldSample(bucket, epoch, value);
+    }
+    if (!history->hasSamples || tickMs > history->latestTick) {
+        history->latestTick = tickMs;
+    }
+    history->hasSamples = TRUE;
+}
+
+DWORD MetricHistory_TierResolutionMs(int tier) {
+    if (tier < 0 || tier >= METRIC_HISTORY_TIER_COUNT) return 0;
+    return kTiers[tier].resolutionMs;
+}
+
+static DWORD OldestRetainedEpoch(const MetricHistoryTier* tier, ULONGLONG latestTick) {
+    DWORD latest = EpochForTick(tier, latestTick);
+    return latest > tier->capacity ? latest - tier->capacity + 1u : 1u;
+}
+
+int MetricHistory_SelectTier(const MetricHistory* history, ULONGLONG fromTickMs) {
+    if (!history) return 0;
+    for (int i = 0; i < METRIC_HISTORY_TIER_COUNT - 1; ++i) {
+        const MetricHistoryTier* tier = &kTiers[i];
+        if (EpochForTick(tier, fromTickMs) >=
+            OldestRetainedEpoch(tier, history->latestTick)) {
+            return i;
+        }
+    }
+    return METRIC_HISTORY_TIER_COUNT - 1;
+}
+
+static void FoldBucket(MetricHistoryPoint* point, const MetricHistoryBucket* bucket) {
+    float average = bucket->sum / (float)bucket->count;
+    if (point->count == 0) {
+        point->min = bucket->min;
+        point->max = bucket->max;
+        point->average = average;
+        point->count = bucket->count;
+        return;
+    }
+    if (bucket->min < point->min) point->min = bucket->min;
+    if (bucket->max > point->max) point->max = bucket->max;
+    DWORD total = point->count + bucket->count;
+    if (total < point->count) total = MAXDWORD;
+    point->average = (point->average * (float)point->count + bucket->sum) / (float)total;
+    point->count = total;
+}
+
+static int ColumnForTick(ULONGLONG tickMs, ULONGLONG fromTickMs, ULONGLONG span,
+                         int pointCount) {
+    if (tickMs <= fromTickMs) return 0;
+    ULONGLONG column = (tickMs - fromTickMs) * (ULONGLONG)pointCount / span;
+    return column >= (ULONGLONG)pointCount ? pointCount - 1 : (int)column;
+}
+
+int MetricHistory_Query(const MetricHistory* history,
+                        ULONGLONG fromTickMs, ULONGLONG toTickMs,
+                        MetricHistoryPoint* points, int pointCount) {
+    if (!points || pointCount <= 0) return 0;
+    ZeroMemory(points, (size_t)pointCount * sizeof(*points));
+    if (!history || !history->hasSamples || toTickMs <= fromTickMs) return 0;
+
+    const MetricHistoryTier* tier = &kTiers[MetricHistory_SelectTier(history, fromTickMs)];
+    DWORD first = EpochForTick(tier, fromTickMs);
+    DWORD last = EpochForTick(tier, toTickMs - 1);
+    DWORD oldest = OldestRetainedEpoch(tier, history->latestTick);
+    DWORD latest = EpochForTick(tier, history->latestTick);
+    if (first < oldest) first = oldest;
+    if (last > latest) last = latest;
+
+    ULONGLONG span = toTickMs - fromTickMs;
+    BOOL wideBuckets = (ULONGLONG)tier->resolutionMs * (ULONGLONG)pointCount > span;
+    for (DWORD epoch = first; epoch <= last && epoch >= first; ++epoch) {
+        const MetricHistoryBucket* bucket =
+            &history->slots[tier->offset + epoch % tier->capacity];
+        if (bucket->epoch != epoch || bucket->count == 0) continue;
+
+        /* A bucket wider than a column feeds every column it overlaps;
+         * narrower buckets land in one column so no sample counts twice */
+        ULONGLONG start = (ULONGLONG)(epoch - 1u) * tier->resolutionMs;
+        int firstColumn = ColumnForTick(start, fromTickMs, span, pointCount);
+        int lastColumn = firstColumn;
+        if (wideBuckets) {
+            lastColumn = ColumnForTick(start + tier->resolutionMs - 1u,
+                                       fromTickMs, span, pointCount);
+        }
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            FoldBucket(&points[column], bucket);
+        }
+    }
+
+    int filled = 0;
+    for (int i = 0; i < pointCount; ++i) {
+        if (points[i].count != 0) filled++;
+    }
+    return filled;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file pcm_mix.c
+ * @brief Q15 gain ramps, 32-bit accumulation and saturation.
+ */
+
+#include "utils/pcm_mix.h"
+
+/* Ramp positions carry 16 extra fraction bits so short buffers still
+ * advance smoothly between Q15 gain steps */
+#define PCM_MIX_RAMP_SHIFT 16
+
+int32_t PcmMix_StepGain(int32_t gain, int32_t target, int32_t maxDelta) {
+    if (maxDelta < 0) maxDelta = 0;
+    if (gain < target) return target - gain > maxDelta ? gain + maxDelta : target;
+    if (gain > target) return gain - target > maxDelta ? gain - maxDelta : target;
+    return gain;
+}
+
+int32_t PcmMix_FadeDelta(uint32_t frames, uint32_t fadeFrames) {
+    if (fadeFrames == 0 || frames >= fadeFrames) return PCM_MIX_UNITY_GAIN;
+    int32_t delta = (int32_t)(((uint64_t)PCM_MIX_UNITY_GAIN * frames) / fadeFrames);
+    return delta > 0 ? delta : 1;
+}
+
+void PcmMix_Accumulate(int32_t* accum, const int16_t* source,
+                       size_t frames, int channels,
+                       int32_t gainFrom, int32_t gainTo) {
+    if (!accum || !source || frames == 0 || channels <= 0) return;
+    size_t samples = frames * (size_t)channels;
+    if (gainFrom == gainTo) {
+        if (gainFrom == 0) return;
+        if (gainFrom == PCM_MIX_UNITY_GAIN) {
+            for (size_t i = 0; i < samples; ++i) accum[i] += source[i];
+            return;
+        }
+        for (size_t i = 0; i < samples; ++i) {
+            accum[i] += (source[i] * gainFrom) >> 15;
+        }
+        return;
+    }
+
+    int64_t ramp = (int64_t)gainFrom << PCM_MIX_RAMP_SHIFT;
+    int64_t step = (((int64_t)gainTo - gainFrom) << PCM_MIX_RAMP_SHIFT) /
+                   (int64_t)frames;
+    for (size_t frame = 0; frame < frames; ++frame) {
+        int32_t gain = (int32_t)(ramp >> PCM_MIX_RAMP_SHIFT);
+        const int16_t* in = source + frame * (size_t)channels;
+        int32_t* out = accum + frame * (size_t)channels;
+        for (int c = 0; c < channels; ++c) out[c] += (in[c] * gain) >> 15;
+        ramp += step;
+    }
+}
+
+void PcmMix_Resolve(int16_t* output, const int32_t* accum, size_t samples) {
+    if (!output || !accum) return;
+    for (size_t i = 0; i < samples; ++i) {
+        int32_t value = accum[i];
+        if (value > INT16_MAX) value = INT16_MAX;
+        if (value < INT16_MIN) value = INT16_MIN;
+        output[i] = (int16_t)value;
+    }
+}
@@ -20,6 +20,9 @@ typedef struct {
     BOOL isPreviewingFont;
     BOOL isPreviewingAnim;
     BOOL isValidDrop;
+    /* Previews kept until the background import applies or drops them */
+    BOOL pendingFontPreview;
+    BOOL pendingAnimPreview;
 } OleDropTarget;
 STDMETHODIMP QueryInterface(IDropTarget* this, REFIID riid, void** ppvObject);
 STDMETHODIMP_(ULONG) AddRef(IDropTarget* this);
@@ -86,6 +89,24 @@ static void ClearFontPreviewStateAfterDropApply(void) {
     PREVIEW_FONT_NAME[0] = '\0';
     PREVIEW_INTERNAL_NAME[0] = '\0';
 }
+static void SettlePendingDropPreview(OleDropTarget* target, const DropImportResult* result) {
+    if (target->pendingFontPreview) {
+        if (result->fontApplied) {
+            ClearFontPreviewStateAfterDropApply();
+        } else {
+            CancelFontPreview();
+            RefreshCustomTextDisplayDialogFont();
+            InvalidateRect(target->hwnd, NULL, TRUE);
+        }
+        target->pendingFontPreview = FALSE;
+    }
+    if (target->pendingAnimPreview) {
+        if (!result->animationApplied) {
+            CancelAnimationPreview();
+        }
+        target->pendingAnimPreview = FALSE;
+    }
+}
 static void ReleaseFontPreviewResourceForDrop(OleDropTarget* target) {
     if (!target) return;
     if (target->isPreviewingFont) {
@@ -130,10 +151,12 @@ STDMETHODIMP DragEnter(IDropTarget* this, IDataObject* pDataObj, DWORD grfKeySta
             OleDrop_ScanPathForResources(filePath, &scan);
             if (OleDrop_IsResourceScanResolved(&scan)) break;
         }
-        if (!scan.truncated && scan.fontCount == 1) {
+        /* A preview would be settled by the import that is still running */
+        BOOL canPreview = !scan.truncated && !IsDropImportJobRunning();
+        if (canPreview && scan.fontCount == 1) {
             StartPreview(target, scan.fontPath);
         }
-        if (!scan.truncated && scan.animCount == 1) {
+        if (canPreview && scan.animCount == 1) {
             StartPreview(target, scan.animPath);
         }
         if (scan.truncated) {
@@ -183,26 +206,16 @@ STDMETHODIMP Drop(IDropTarget* this, IDataObject* pDataObj, DWORD grfKeyState, P
     target->isValidDrop = FALSE;
     if (pDataObj->lpVtbl->GetData(pDataObj, &fmt, &stg) == S_OK) {
         HDROP hDrop = (HDROP)stg.hGlobal;
-        DropImportResult result = HandleDropFiles(target->hwnd, hDrop);
+        DropImportResult noResult = {0};
+        BOOL started = StartDropImportJob(target->hwnd, hDrop);
         ReleaseStgMedium(&stg);
-        if (hadFontPreview) {
-            if (result.fontApplied) {
-                ClearFontPreviewStateAfterDropApply();
-            } else {
-                CancelFontPreview();
-                RefreshCustomTextDisplayDialogFont();
-                InvalidateRect(target->hwnd, NULL, TRUE);
-            }
-        }
-        if (hadAnimationPreview) {
-            if (!result.animationApplied) {
-                CancelAnimationPreview();
-            }
-            target->isPreviewingAnim = FALSE;
-        }
-        *pdwEffect = (result.movedCount > 0 || result.fontApplied || result.animationApplied)
-            ? DROPEFFECT_COPY
-            : DROPEFFECT_NONE;
+        /* Starting a job cancels the previous one, whose previews are left */
+        SettlePendingDropPreview(target, &noResult);
+        target->pendingFontPreview = hadFontPreview;
+        target->pendingAnimPreview = hadAnimationPreview;
+        target->isPreviewingAnim = FALSE;
+        if (!started) SettlePendingDropPreview(target, &noResult);
+        *pdwEffect = started ? DROPEFFECT_COPY : DROPEFFECT_NONE;
     } else {
         if (hadFontPreview) {
             CancelFontPreview();
@@ -217,6 +230,9 @@ STDMETHODIMP Drop(IDropTarget* this, IDataObject* pDataObj, DWORD grfKeyState, P
     }
     return S_OK;
 }
+void OleDropTarget_CompleteImport(const DropImportResult* result) {
+    if (result) SettlePendingDropPreview(&g_dropTarget, result);
+}
 void InitializeOleDropTarget(HWND hwnd) {
     if (!hwnd || !IsWindow(hwnd)) {
         LOG_WARNING("InitializeOleDropTarget called with invalid window handle");
@@ -243,6 +259,8 @@ void InitializeOleDropTarget(HWND hwnd) {
     g_dropTarget.isPreviewingFont = FALSE;
     g_dropTarget.isPreviewingAnim = FALSE;
     g_dropTarget.isValidDrop = FALSE;
+    g_dropTarget.pendingFontPreview = FALSE;
+    g_dropTarget.pendingAnimPreview = FALSE;
     hr = RegisterDragDrop(hwnd, (IDropTarget*)&g_dropTarget);
     if (FAILED(hr)) {
         LOG_ERROR("RegisterDragDrop failed (hr=0x%08lX)", (unsigned long)hr);
@@ -14,6 +14,7 @@ typedef struct {
 static const CommandDispatchEntry COMMAND_DISPATCH_TABLE[] = {
     {CLOCK_IDM_CUSTOM_COUNTDOWN, CmdCustomCountdown},
     {CLOCK_IDM_EXIT, CmdExit},
+    {CLOCK_IDM_CANCEL_DROP_IMPORT, CmdCancelDropImport},
     {CLOCK_IDM_RESET_POSITION, CmdResetPosition},
     {CLOCK_IDM_RESET_ALL, CmdResetDefaults},
     {CLOCK_IDM_TIMER_PAUSE_RESUME, CmdPauseResume},
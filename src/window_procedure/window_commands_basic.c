@@ -16,6 +16,14 @@ LRESULT CmdExit(HWND hwnd, WPARAM wp, LPARAM lp) {
     return 0;
 }
 
+LRESULT CmdCancelDropImport(HWND hwnd, WPARAM wp, LPARAM lp) {
+    (void)hwnd; (void)wp; (void)lp;
+    if (CancelDropImportJob()) {
+        LOG_INFO("Dropped resource import canceled by the user");
+    }
+    return 0;
+}
+
 LRESULT CmdAbout(HWND hwnd, WPARAM wp, LPARAM lp) {
     (void)wp; (void)lp;
     ShowAboutDialog(hwnd);
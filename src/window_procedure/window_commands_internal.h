@@ -6,6 +6,7 @@
 #include "window_procedure/window_helpers.h"
 #include "window_procedure/window_hotkeys.h"
 #include "window_procedure/window_message_handlers.h"
+#include "window_procedure/window_drop_target.h"
 #include "timer/timer_events.h"
 #include "timer/main_timer.h"
 #include "tray/tray_events.h"
@@ -62,6 +63,7 @@ extern char CLOCK_TEXT_COLOR[COLOR_HEX_BUFFER];
 float ParseDefaultScaleOrFallback(const char* value, float fallback);
 void ToggleTextEffect(HWND hwnd, TextEffectType effect);
 LRESULT CmdExit(HWND hwnd, WPARAM wp, LPARAM lp);
+LRESULT CmdCancelDropImport(HWND hwnd, WPARAM wp, LPARAM lp);
 LRESULT CmdAbout(HWND hwnd, WPARAM wp, LPARAM lp);
 LRESULT CmdToggleTopmost(HWND hwnd, WPARAM wp, LPARAM lp);
 LRESULT CmdEditMode(HWND hwnd, WPARAM wp, LPARAM lp);
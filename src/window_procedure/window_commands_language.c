@@ -1,6 +1,7 @@
 #include "window_commands_internal.h"
 
 #include "taskbar_monitor.h"
+#include "tray/tray_menu_cache.h"
 
 static const struct {
     UINT menuId;
@@ -18,6 +19,7 @@ BOOL HandleLanguageSelection(HWND hwnd, UINT menuId) {
         if (menuId == LANGUAGE_MAP[i].menuId) {
             if (WriteConfigLanguage(LANGUAGE_MAP[i].language) &&
                 SetLanguage(LANGUAGE_MAP[i].language)) {
+                TrayMenuCache_InvalidateAll();
                 InvalidateRect(hwnd, NULL, TRUE);
                 TaskbarMonitor_Refresh();
             }
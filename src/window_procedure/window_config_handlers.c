@@ -3,12 +3,25 @@
  * @brief Dispatches a complete configuration reload.
  */
 
-#include "window_procedure/window_config_handlers.h"
+#include "window_procedure/window_config_handlers_internal.h"
 
 #include "config/config_watcher.h"
+#include "drawing/drawing_render_metrics.h"
+#include "tray/tray_menu_cache.h"
+
+const PublishedConfig* WindowConfigInternal_AcquireReloadedConfig(void) {
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    if (published->version == 0) {
+        PublishedConfig_Release(published);
+        return NULL;
+    }
+    return published;
+}
 
 LRESULT HandleAppConfigChanged(HWND hwnd) {
     ConfigWatcher_BeginConfigReloadHandling();
+    TrayMenuCache_InvalidateAll();
+    RenderMetrics_LoadConfig();
     HandleAppAnimSpeedChanged(hwnd);
     HandleAppAnimPathChanged(hwnd);
     HandleAppDisplayChanged(hwnd);
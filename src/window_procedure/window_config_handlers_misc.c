@@ -6,12 +6,12 @@
 #include "window_procedure/window_config_handlers_internal.h"
 #include "window_procedure/window_hotkeys.h"
 #include "config.h"
+#include "config/config_applier.h"
 #include "log.h"
 #include "taskbar_monitor.h"
 #include "tray/tray_animation_core.h"
 #include "window_procedure/window_utils.h"
 
-#include <stdio.h>
 #include <string.h>
 
 typedef struct {
@@ -23,18 +23,17 @@ typedef struct {
 static BOOL g_hotReloadRecentFilesConfigValid = FALSE;
 static HotReloadRecentFilesConfig g_lastHotReloadRecentFilesConfig = {0};
 
-static void ReadHotReloadRecentFilesConfig(HotReloadRecentFilesConfig* config) {
+static void ReadHotReloadRecentFilesConfig(const ConfigSnapshot* snapshot,
+                                           HotReloadRecentFilesConfig* config) {
     if (!config) return;
 
     ZeroMemory(config, sizeof(*config));
-    for (int i = 0; i < MAX_RECENT_FILES; i++) {
-        char key[32];
-        snprintf(key, sizeof(key), "CLOCK_RECENT_FILE_%d", i + 1);
-        if (!WindowConfigInternal_ReadStringExact(INI_SECTION_RECENTFILES, key, "",
-                                      config->recentFiles[i],
-                                      sizeof(config->recentFiles[i]))) {
-            config->recentFiles[i][0] = '\0';
-        }
+    int count = snapshot->recentFilesCount;
+    if (count < 0) count = 0;
+    if (count > MAX_RECENT_FILES) count = MAX_RECENT_FILES;
+    for (int i = 0; i < count; i++) {
+        strncpy_s(config->recentFiles[i], sizeof(config->recentFiles[i]),
+                  snapshot->recentFiles[i].path, _TRUNCATE);
     }
 
     config->timeoutAction = CLOCK_TIMEOUT_ACTION;
@@ -82,20 +81,23 @@ LRESULT HandleAppHotkeysChanged(HWND hwnd) {
 LRESULT HandleAppRecentFilesChanged(HWND hwnd) {
     (void)hwnd;
 
+    const PublishedConfig* published = WindowConfigInternal_AcquireReloadedConfig();
+    if (!published) return 0;
+
     HotReloadRecentFilesConfig recentConfig = {0};
-    ReadHotReloadRecentFilesConfig(&recentConfig);
+    ReadHotReloadRecentFilesConfig(&published->config, &recentConfig);
 
     BOOL recentFilesChanged = HotReloadRecentFilesChanged(&recentConfig);
     BOOL validationInputChanged = HotReloadRecentValidationInputChanged(&recentConfig);
+    if (recentFilesChanged) {
+        /* The snapshot already dropped entries whose files are gone */
+        ApplyRecentFilesSettings(&published->config);
+    }
+    PublishedConfig_Release(published);
     if (!recentFilesChanged && !validationInputChanged) {
         return 0;
     }
 
-    if (recentFilesChanged) {
-        extern void LoadRecentFiles(void);
-        LoadRecentFiles();
-    }
-
     if (CLOCK_TIMEOUT_ACTION == TIMEOUT_ACTION_OPEN_FILE) {
         int recentFilesCount = g_AppConfig.recent_files.count;
         if (recentFilesCount < 0) recentFilesCount = 0;
@@ -129,12 +131,14 @@ LRESULT HandleAppAnimPathChanged(HWND hwnd) {
     (void)hwnd;
     /* The taskbar monitor is one shared surface, so its options remain
      * synchronized even though each process keeps its own tray animation. */
-    BOOL taskbarMonitorEnabled = ReadConfigBool(
-        "Animation", "TASKBAR_MONITOR_ENABLED", FALSE);
-    BOOL taskbarMonitorCpuMemory = taskbarMonitorEnabled && ReadConfigBool(
-        "Animation", "TASKBAR_MONITOR_CPU_MEMORY", TRUE);
-    BOOL taskbarMonitorNetwork = taskbarMonitorEnabled && ReadConfigBool(
-        "Animation", "TASKBAR_MONITOR_NETWORK", TRUE);
+    const PublishedConfig* published = WindowConfigInternal_AcquireReloadedConfig();
+    if (!published) return 0;
+    BOOL taskbarMonitorEnabled = published->config.taskbarMonitorEnabled;
+    BOOL taskbarMonitorCpuMemory = taskbarMonitorEnabled &&
+        published->config.taskbarMonitorCpuMemory;
+    BOOL taskbarMonitorNetwork = taskbarMonitorEnabled &&
+        published->config.taskbarMonitorNetwork;
+    PublishedConfig_Release(published);
     if (taskbarMonitorCpuMemory != TaskbarMonitor_IsOptionEnabled(
             TASKBAR_MONITOR_OPTION_CPU_MEMORY) ||
         taskbarMonitorNetwork != TaskbarMonitor_IsOptionEnabled(
@@ -5,8 +5,6 @@
 
 #include "window_procedure/window_config_handlers_internal.h"
 #include "config.h"
-#include "config/config_defaults.h"
-#include "log.h"
 #include "timer/main_timer.h"
 #include "timer/timer.h"
 #include "window_procedure/window_utils.h"
@@ -15,96 +13,76 @@
 
 extern char CLOCK_TIMEOUT_WEBSITE_URL[MAX_PATH];
 
-LRESULT HandleAppTimerChanged(HWND hwnd) {
+static void CopyIfChanged(char* target, size_t size, const char* value) {
+    if (strcmp(target, value) != 0) {
+        strncpy_s(target, size, value, _TRUNCATE);
+    }
+}
+
+/** @brief Unlike ApplyTimerSettings, leaves a running countdown alone */
+static void ApplyTimerConfig(HWND hwnd, const ConfigSnapshot* config) {
     bool changed = false;
     bool intervalChanged = false;
 
     /* Basic timer settings */
-    changed |= WindowConfigInternal_LoadAndCompareBool(CFG_SECTION_TIMER, CFG_KEY_USE_24HOUR,
-                                  &CLOCK_USE_24HOUR, CLOCK_USE_24HOUR);
-    intervalChanged = WindowConfigInternal_LoadAndCompareBool(CFG_SECTION_TIMER, CFG_KEY_SHOW_SECONDS,
-                                         &CLOCK_SHOW_SECONDS, CLOCK_SHOW_SECONDS);
-    changed |= intervalChanged;
+    if (CLOCK_USE_24HOUR != (bool)config->use24Hour) {
+        CLOCK_USE_24HOUR = config->use24Hour;
+        changed = true;
+    }
+    if (CLOCK_SHOW_SECONDS != (bool)config->showSeconds) {
+        CLOCK_SHOW_SECONDS = config->showSeconds;
+        intervalChanged = true;
+        changed = true;
+    }
 
     /* Time format */
-    char formatBuf[32];
-    ReadConfigStr(CFG_SECTION_TIMER, CFG_KEY_TIME_FORMAT, "DEFAULT", formatBuf, sizeof(formatBuf));
-    TimeFormatType newFormat = TimeFormatType_FromStr(formatBuf);
-    if (newFormat != g_AppConfig.display.time_format.format) {
-        g_AppConfig.display.time_format.format = newFormat;
+    if (config->timeFormat != g_AppConfig.display.time_format.format) {
+        g_AppConfig.display.time_format.format = config->timeFormat;
         changed = true;
     }
 
     /* Milliseconds display */
-    BOOL newShowMs = ReadConfigBool(CFG_SECTION_TIMER, CFG_KEY_SHOW_MILLISECONDS, FALSE);
-    if (newShowMs != g_AppConfig.display.time_format.show_milliseconds) {
-        g_AppConfig.display.time_format.show_milliseconds = newShowMs;
+    if (config->showMilliseconds != g_AppConfig.display.time_format.show_milliseconds) {
+        g_AppConfig.display.time_format.show_milliseconds = config->showMilliseconds;
         MainTimer_Stop();
         ResetTimerWithInterval(hwnd);
         changed = true;
     }
 
     /* Timeout settings */
-    WindowConfigInternal_LoadAndCompareString(CFG_SECTION_TIMER, CFG_KEY_TIMEOUT_TEXT,
-                         CLOCK_TIMEOUT_TEXT, sizeof(CLOCK_TIMEOUT_TEXT), "0");
+    CopyIfChanged(CLOCK_TIMEOUT_TEXT, sizeof(CLOCK_TIMEOUT_TEXT), config->timeoutText);
 
     /* Timeout action (preserve one-time actions) */
     if (CLOCK_TIMEOUT_ACTION != TIMEOUT_ACTION_SHUTDOWN &&
         CLOCK_TIMEOUT_ACTION != TIMEOUT_ACTION_RESTART &&
         CLOCK_TIMEOUT_ACTION != TIMEOUT_ACTION_SLEEP) {
-        char actionBuf[32];
-        ReadConfigStr(CFG_SECTION_TIMER, CFG_KEY_TIMEOUT_ACTION, "MESSAGE", actionBuf, sizeof(actionBuf));
-        TimeoutActionType newAction = TimeoutActionType_FromStr(actionBuf);
-        if (newAction != CLOCK_TIMEOUT_ACTION) {
-            CLOCK_TIMEOUT_ACTION = newAction;
-        }
+        CLOCK_TIMEOUT_ACTION = config->timeoutAction;
     }
 
     /* Timeout file and website */
-    WindowConfigInternal_LoadAndCompareString(CFG_SECTION_TIMER, CFG_KEY_TIMEOUT_FILE,
-                         CLOCK_TIMEOUT_FILE_PATH, sizeof(CLOCK_TIMEOUT_FILE_PATH), "");
-
-    WindowConfigInternal_LoadAndCompareString(CFG_SECTION_TIMER, CFG_KEY_TIMEOUT_WEBSITE,
-                         CLOCK_TIMEOUT_WEBSITE_URL, sizeof(CLOCK_TIMEOUT_WEBSITE_URL), "");
+    CopyIfChanged(CLOCK_TIMEOUT_FILE_PATH, sizeof(CLOCK_TIMEOUT_FILE_PATH),
+                  config->timeoutFilePath);
+    CopyIfChanged(CLOCK_TIMEOUT_WEBSITE_URL, sizeof(CLOCK_TIMEOUT_WEBSITE_URL),
+                  config->timeoutWebsiteUrl);
 
     /* Default start time */
-    int newDefaultStartTime = WindowConfigInternal_NormalizeDefaultStartTime(
-        ReadConfigInt(CFG_SECTION_TIMER, CFG_KEY_DEFAULT_START_TIME,
-                      g_AppConfig.timer.default_start_time));
-    if (newDefaultStartTime != g_AppConfig.timer.default_start_time) {
-        g_AppConfig.timer.default_start_time = newDefaultStartTime;
-    }
+    g_AppConfig.timer.default_start_time = config->defaultStartTime;
 
-    /* Time options */
-    char optionsBuf[TIME_OPTIONS_CONFIG_BUFFER_SIZE] = {0};
-    BOOL optionsComplete = ReadIniStringExact(CFG_SECTION_TIMER, CFG_KEY_TIME_OPTIONS,
-                                              DEFAULT_TIME_OPTIONS_INI, optionsBuf,
-                                              sizeof(optionsBuf), GetCachedConfigPath());
-    int newArr[MAX_TIME_OPTIONS] = {0};
-    int newCnt = 0;
-    if (!optionsComplete) {
-        WriteLog(LOG_LEVEL_WARNING,
-                 "Countdown presets config is too long during reload; keeping current presets");
-    } else if (WindowConfigInternal_ParseQuickCountdownOptions(optionsBuf, newArr, &newCnt) &&
-               (newCnt != time_options_count ||
-                memcmp(newArr, time_options, (size_t)newCnt * sizeof(int)) != 0)) {
+    /* Time options, already validated when the snapshot was built */
+    int newCnt = config->timeOptionsCount;
+    if (newCnt > 0 && newCnt <= MAX_TIME_OPTIONS &&
+        (newCnt != time_options_count ||
+         memcmp(config->timeOptions, time_options, (size_t)newCnt * sizeof(int)) != 0)) {
         ZeroMemory(time_options, sizeof(time_options));
         time_options_count = newCnt;
-        memcpy(time_options, newArr, (size_t)newCnt * sizeof(int));
+        memcpy(time_options, config->timeOptions, (size_t)newCnt * sizeof(int));
     }
 
     /* Startup mode */
-    char startupModeBuf[sizeof(CLOCK_STARTUP_MODE)] = {0};
-    ReadConfigStr(CFG_SECTION_TIMER, CFG_KEY_STARTUP_MODE, CLOCK_STARTUP_MODE,
-                  startupModeBuf, sizeof(startupModeBuf));
-
     char normalizedStartupMode[sizeof(CLOCK_STARTUP_MODE)] = {0};
-    WindowConfigInternal_NormalizeStartupMode(startupModeBuf, normalizedStartupMode,
+    WindowConfigInternal_NormalizeStartupMode(config->startupMode, normalizedStartupMode,
                                      sizeof(normalizedStartupMode));
-    if (strcmp(normalizedStartupMode, CLOCK_STARTUP_MODE) != 0) {
-        strncpy_s(CLOCK_STARTUP_MODE, sizeof(CLOCK_STARTUP_MODE),
-                  normalizedStartupMode, _TRUNCATE);
-    }
+    CopyIfChanged(CLOCK_STARTUP_MODE, sizeof(CLOCK_STARTUP_MODE), normalizedStartupMode);
 
     if (changed) {
         if (intervalChanged) {
@@ -112,6 +90,12 @@ LRESULT HandleAppTimerChanged(HWND hwnd) {
         }
         InvalidateRect(hwnd, NULL, TRUE);
     }
+}
 
+LRESULT HandleAppTimerChanged(HWND hwnd) {
+    const PublishedConfig* published = WindowConfigInternal_AcquireReloadedConfig();
+    if (!published) return 0;
+    ApplyTimerConfig(hwnd, &published->config);
+    PublishedConfig_Release(published);
     return 0;
 }
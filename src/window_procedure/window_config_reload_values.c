@@ -21,50 +21,6 @@
 #define NOTIFICATION_MAX_WINDOW_HEIGHT 900
 #define MIN_BASE_FONT_SIZE 8
 #define MAX_BASE_FONT_SIZE 500
-#define MIN_DEFAULT_START_TIME_SECONDS 1
-#define MAX_DEFAULT_START_TIME_SECONDS 86400
-
-BOOL WindowConfigInternal_ReadStringExact(const char* section, const char* key,
-                                     const char* def, char* target,
-                                     DWORD targetSize) {
-    if (!target || targetSize == 0) return FALSE;
-
-    if (!ReadIniStringExact(section, key, def ? def : "", target, targetSize,
-                            GetCachedConfigPath())) {
-        WriteLog(LOG_LEVEL_WARNING,
-                 "Hot reload ignored %s.%s because the config value is too long",
-                 section ? section : "(null)",
-                 key ? key : "(null)");
-        return FALSE;
-    }
-
-    return TRUE;
-}
-
-BOOL WindowConfigInternal_LoadAndCompareString(const char* section, const char* key,
-                                  char* target, size_t size, const char* def) {
-    if (!target || size == 0 || size > MAX_PATH) return FALSE;
-
-    char temp[MAX_PATH] = {0};
-    if (!WindowConfigInternal_ReadStringExact(section, key, def, temp, (DWORD)size)) {
-        return FALSE;
-    }
-
-    if (strcmp(temp, target) != 0) {
-        strncpy_s(target, size, temp, _TRUNCATE);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-BOOL WindowConfigInternal_LoadAndCompareBool(const char* section, const char* key, bool* target, bool def) {
-    BOOL temp = ReadConfigBool(section, key, def);
-    if (temp != *target) {
-        *target = temp;
-        return TRUE;
-    }
-    return FALSE;
-}
 
 int WindowConfigInternal_NormalizeBaseFontSize(int fontSize) {
     if (fontSize < MIN_BASE_FONT_SIZE || fontSize > MAX_BASE_FONT_SIZE) {
@@ -75,33 +31,6 @@ int WindowConfigInternal_NormalizeBaseFontSize(int fontSize) {
     return fontSize;
 }
 
-int WindowConfigInternal_NormalizeDefaultStartTime(int seconds) {
-    if (seconds < MIN_DEFAULT_START_TIME_SECONDS ||
-        seconds > MAX_DEFAULT_START_TIME_SECONDS) {
-        WriteLog(LOG_LEVEL_WARNING,
-                 "Ignoring invalid hot-reload default start time %d, using default %d",
-                 seconds, DEFAULT_START_TIME_SECONDS);
-        return DEFAULT_START_TIME_SECONDS;
-    }
-    return seconds;
-}
-
-int WindowConfigInternal_ClampInt(const char* key, int value, int minValue, int maxValue) {
-    if (value < minValue) {
-        WriteLog(LOG_LEVEL_WARNING,
-                 "Clamping invalid hot-reload %s value %d to %d",
-                 key ? key : "config", value, minValue);
-        return minValue;
-    }
-    if (value > maxValue) {
-        WriteLog(LOG_LEVEL_WARNING,
-                 "Clamping invalid hot-reload %s value %d to %d",
-                 key ? key : "config", value, maxValue);
-        return maxValue;
-    }
-    return value;
-}
-
 void WindowConfigInternal_NormalizeTextColor(const char* color,
                                            char* output,
                                            size_t outputSize) {
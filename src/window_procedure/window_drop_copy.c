@@ -0,0 +1,236 @@
+/**
+ * @file window_drop_copy.c
+ * @brief Content dedupe, hard links and streamed copies for dropped resources.
+ *
+ * A resource pack dropped twice, or a font that already sits in the fonts
+ * folder under another name, is matched by size, then by a content hash and
+ * finally byte for byte instead of being copied again. New files are hard-linked when source and
+ * target share a volume and otherwise streamed through one large buffer.
+ */
+
+#include <string.h>
+#include "window_drop_target_internal.h"
+
+#define DROP_IMPORT_HASH_OFFSET 14695981039346656037ull
+#define DROP_IMPORT_HASH_PRIME 1099511628211ull
+
+static BOOL HashFileContent(const wchar_t* path, DropImportState* state, ULONGLONG* outHash) {
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return FALSE;
+    ULONGLONG hash = DROP_IMPORT_HASH_OFFSET;
+    BOOL ok = TRUE;
+    for (;;) {
+        DWORD read = 0;
+        if (DropImport_IsCanceled(state) ||
+            !ReadFile(file, state->copyBuffer, DROP_IMPORT_COPY_BUFFER_BYTES, &read, NULL)) {
+            ok = FALSE;
+            break;
+        }
+        if (read == 0) break;
+        for (DWORD i = 0; i < read; i++) {
+            hash = (hash ^ state->copyBuffer[i]) * DROP_IMPORT_HASH_PRIME;
+        }
+    }
+    CloseHandle(file);
+    if (ok) *outHash = hash;
+    return ok;
+}
+
+/* Each half of the copy buffer holds one file, read in step */
+static BOOL FilesHaveSameContent(const wchar_t* pathA, const wchar_t* pathB, DropImportState* state) {
+    HANDLE fileA = CreateFileW(pathA, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fileA == INVALID_HANDLE_VALUE) return FALSE;
+    HANDLE fileB = CreateFileW(pathB, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fileB == INVALID_HANDLE_VALUE) {
+        CloseHandle(fileA);
+        return FALSE;
+    }
+    const DWORD half = DROP_IMPORT_COPY_BUFFER_BYTES / 2;
+    BYTE* bufferA = state->copyBuffer;
+    BYTE* bufferB = state->copyBuffer + half;
+    BOOL same = TRUE;
+    for (;;) {
+        DWORD readA = 0;
+        DWORD readB = 0;
+        if (DropImport_IsCanceled(state) ||
+            !ReadFile(fileA, bufferA, half, &readA, NULL) ||
+            !ReadFile(fileB, bufferB, half, &readB, NULL) ||
+            readA != readB || memcmp(bufferA, bufferB, readA) != 0) {
+            same = FALSE;
+            break;
+        }
+        if (readA == 0) break;
+    }
+    CloseHandle(fileB);
+    CloseHandle(fileA);
+    return same;
+}
+
+void DropImport_ReleaseExistingIndex(DropImportState* state) {
+    if (!state) return;
+    free(state->existing);
+    state->existing = NULL;
+    state->existingCount = 0;
+    state->existingCapacity = 0;
+    state->existingDir[0] = L'\0';
+}
+
+static DropImportExistingFile* AppendExistingFile(DropImportState* state) {
+    if (state->existingCount >= (int)DROP_IMPORT_SCAN_ENTRY_BUDGET) return NULL;
+    if (state->existingCount == state->existingCapacity) {
+        int capacity = state->existingCapacity ? state->existingCapacity * 2 : 32;
+        DropImportExistingFile* grown = (DropImportExistingFile*)realloc(
+            state->existing, (size_t)capacity * sizeof(DropImportExistingFile));
+        if (!grown) return NULL;
+        state->existing = grown;
+        state->existingCapacity = capacity;
+    }
+    DropImportExistingFile* entry = &state->existing[state->existingCount++];
+    ZeroMemory(entry, sizeof(*entry));
+    return entry;
+}
+
+/* Folder contents are listed once per target folder, not once per file */
+static void IndexTargetDirectory(DropImportState* state, const wchar_t* targetDir) {
+    if (_wcsicmp(state->existingDir, targetDir) == 0) return;
+    state->existingCount = 0;
+    if (wcscpy_s(state->existingDir, MAX_PATH, targetDir) != 0) {
+        state->existingDir[0] = L'\0';
+        return;
+    }
+    wchar_t searchPath[MAX_PATH];
+    if (_snwprintf_s(searchPath, MAX_PATH, _TRUNCATE, L"%s\\*", targetDir) < 0) return;
+    WIN32_FIND_DATAW findData;
+    HANDLE hFind = FindFirstFileW(searchPath, &findData);
+    if (hFind == INVALID_HANDLE_VALUE) return;
+    do {
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+        DropImportExistingFile* entry = AppendExistingFile(state);
+        if (!entry) break;
+        entry->size = ((ULONGLONG)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
+        wcscpy_s(entry->name, MAX_PATH, findData.cFileName);
+    } while (FindNextFileW(hFind, &findData));
+    FindClose(hFind);
+}
+
+BOOL DropImport_FindExistingCopy(DropImportState* state, const wchar_t* srcPath,
+                                 ULONGLONG fileSize, const wchar_t* targetDir,
+                                 wchar_t* outPath, size_t size) {
+    if (!state || !state->copyBuffer || !srcPath || !targetDir || !outPath) return FALSE;
+    IndexTargetDirectory(state, targetDir);
+
+    BOOL sourceHashed = FALSE;
+    ULONGLONG sourceHash = 0;
+    for (int i = 0; i < state->existingCount; i++) {
+        DropImportExistingFile* entry = &state->existing[i];
+        if (entry->size != fileSize) continue;
+        if (_snwprintf_s(outPath, size, _TRUNCATE, L"%s\\%s", targetDir, entry->name) < 0) continue;
+        if (!sourceHashed) {
+            if (!HashFileContent(srcPath, state, &sourceHash)) return FALSE;
+            sourceHashed = TRUE;
+        }
+        if (!entry->hashed) {
+            if (!HashFileContent(outPath, state, &entry->hash)) continue;
+            entry->hashed = TRUE;
+        }
+        /* A hash match alone could import a different file as a duplicate */
+        if (entry->hash == sourceHash && FilesHaveSameContent(srcPath, outPath, state)) {
+            return TRUE;
+        }
+    }
+    outPath[0] = L'\0';
+    return FALSE;
+}
+
+void DropImport_RememberImportedFile(DropImportState* state, const wchar_t* destPath, ULONGLONG fileSize) {
+    if (!state || !destPath || state->existingDir[0] == L'\0') return;
+    const wchar_t* name = wcsrchr(destPath, L'\\');
+    name = name ? name + 1 : destPath;
+    DropImportExistingFile* entry = NULL;
+    for (int i = 0; i < state->existingCount && !entry; i++) {
+        if (_wcsicmp(state->existing[i].name, name) == 0) entry = &state->existing[i];
+    }
+    if (!entry) entry = AppendExistingFile(state);
+    if (!entry) return;
+    entry->size = fileSize;
+    entry->hashed = FALSE;
+    wcscpy_s(entry->name, MAX_PATH, name);
+}
+
+static BOOL IsSameVolume(const wchar_t* pathA, const wchar_t* pathB) {
+    wchar_t volumeA[MAX_PATH];
+    wchar_t volumeB[MAX_PATH];
+    if (!GetVolumePathNameW(pathA, volumeA, MAX_PATH) ||
+        !GetVolumePathNameW(pathB, volumeB, MAX_PATH)) {
+        return FALSE;
+    }
+    return _wcsicmp(volumeA, volumeB) == 0;
+}
+
+static BOOL StreamCopyFile(const wchar_t* srcPath, const wchar_t* destPath, DropImportState* state) {
+    HANDLE src = CreateFileW(srcPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (src == INVALID_HANDLE_VALUE) return FALSE;
+    HANDLE dest = CreateFileW(destPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (dest == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        CloseHandle(src);
+        SetLastError(error);
+        return FALSE;
+    }
+    BOOL ok = TRUE;
+    for (;;) {
+        DWORD read = 0;
+        DWORD written = 0;
+        if (DropImport_IsCanceled(state)) {
+            SetLastError(ERROR_CANCELLED);
+            ok = FALSE;
+            break;
+        }
+        if (!ReadFile(src, state->copyBuffer, DROP_IMPORT_COPY_BUFFER_BYTES, &read, NULL)) {
+            ok = FALSE;
+            break;
+        }
+        if (read == 0) break;
+        if (!WriteFile(dest, state->copyBuffer, read, &written, NULL) || written != read) {
+            ok = FALSE;
+            break;
+        }
+    }
+    DWORD error = GetLastError();
+    CloseHandle(dest);
+    CloseHandle(src);
+    SetLastError(error);
+    return ok;
+}
+
+/* Lands the file under a temporary name first so a half-written resource
+ * never shows up in the menus or the folder watchers. */
+BOOL DropImport_TransferFile(const wchar_t* srcPath, const wchar_t* targetDir,
+                             const wchar_t* destPath, DropImportState* state) {
+    if (!srcPath || !targetDir || !destPath || !state || !state->copyBuffer) return FALSE;
+    wchar_t tempPath[MAX_PATH] = {0};
+    if (GetTempFileNameW(targetDir, L"ctd", 0, tempPath) == 0) {
+        LOG_ERROR("Failed to create temporary dropped resource file in: %ls (error=%lu)", targetDir, GetLastError());
+        return FALSE;
+    }
+    BOOL landed = FALSE;
+    if (IsSameVolume(srcPath, targetDir) && DeleteFileW(tempPath)) {
+        landed = CreateHardLinkW(tempPath, srcPath, NULL);
+    }
+    if (!landed) {
+        landed = StreamCopyFile(srcPath, tempPath, state);
+    }
+    BOOL success = landed &&
+                   MoveFileExW(tempPath, destPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!success) {
+        DWORD error = GetLastError();
+        DeleteFileW(tempPath);
+        SetLastError(error);
+    }
+    return success;
+}
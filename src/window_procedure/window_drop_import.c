@@ -43,15 +43,9 @@ static ULONGLONG GetDropImportMaxBytes(ResourceType type) {
     }
     return 0;
 }
-static BOOL IsDropImportFileSizeAllowed(const wchar_t* srcPath, ResourceType type) {
+static BOOL IsDropImportFileSizeAllowed(const wchar_t* srcPath, ResourceType type, ULONGLONG fileSize) {
     ULONGLONG maxBytes = GetDropImportMaxBytes(type);
     if (!srcPath || maxBytes == 0) return FALSE;
-    WIN32_FILE_ATTRIBUTE_DATA data;
-    if (!GetFileAttributesExW(srcPath, GetFileExInfoStandard, &data)) {
-        LOG_WARNING("Failed to query dropped resource size: %ls (error=%lu)", srcPath, GetLastError());
-        return FALSE;
-    }
-    ULONGLONG fileSize = ((ULONGLONG)data.nFileSizeHigh << 32) | data.nFileSizeLow;
     if (fileSize > maxBytes) {
         LOG_WARNING("Dropped resource too large: %ls (%llu bytes, limit %llu bytes)", srcPath, fileSize, maxBytes);
         return FALSE;
@@ -116,25 +110,7 @@ static const wchar_t* GetCachedTargetRoot(ResourceType type, const DropImportSta
     }
     return NULL;
 }
-static BOOL CopyResourceFileAtomicW(const wchar_t* srcPath, const wchar_t* targetDir, const wchar_t* destPath) {
-    if (!srcPath || !targetDir || !destPath) return FALSE;
-    wchar_t tempPath[MAX_PATH] = {
-        0
-    };
-    if (GetTempFileNameW(targetDir, L"ctd", 0, tempPath) == 0) {
-        LOG_ERROR("Failed to create temporary dropped resource file in: %ls (error=%lu)", targetDir, GetLastError());
-        return FALSE;
-    }
-    BOOL success = CopyFileW(srcPath, tempPath, FALSE) &&
-    MoveFileExW(tempPath, destPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
-    if (!success) {
-        DWORD error = GetLastError();
-        DeleteFileW(tempPath);
-        SetLastError(error);
-    }
-    return success;
-}
-BOOL DropImport_ImportResourceFile(const wchar_t* srcPath, ResourceType type, const DropImportState* state, const wchar_t* relativeDir, wchar_t* outNewPath, size_t size) {
+BOOL DropImport_ImportResourceFile(const wchar_t* srcPath, ResourceType type, ULONGLONG fileSize, DropImportState* state, const wchar_t* relativeDir, wchar_t* outNewPath, size_t size) {
     wchar_t baseDir[MAX_PATH];
     wchar_t targetDir[MAX_PATH];
     const wchar_t* cachedBaseDir = GetCachedTargetRoot(type, state);
@@ -173,12 +149,22 @@ BOOL DropImport_ImportResourceFile(const wchar_t* srcPath, ResourceType type, co
         return TRUE;
         /* Already in place */
     }
-    if (!IsDropImportFileSizeAllowed(srcPath, type)) {
+    if (!IsDropImportFileSizeAllowed(srcPath, type, fileSize)) {
         return FALSE;
     }
-    if (CopyResourceFileAtomicW(srcPath, targetDir, outNewPath)) {
+    wchar_t existingPath[MAX_PATH];
+    if (DropImport_FindExistingCopy(state, srcPath, fileSize, targetDir, existingPath, MAX_PATH) &&
+        wcscpy_s(outNewPath, size, existingPath) == 0) {
+        state->dedupedCount++;
+        return TRUE;
+    }
+    if (DropImport_TransferFile(srcPath, targetDir, outNewPath, state)) {
+        DropImport_RememberImportedFile(state, outNewPath, fileSize);
         return TRUE;
     }
+    if (DropImport_IsCanceled(state)) {
+        return FALSE;
+    }
     LOG_ERROR("Failed to import dropped resource: %ls -> %ls (error=%lu)", srcPath, outNewPath, GetLastError());
     return FALSE;
 }
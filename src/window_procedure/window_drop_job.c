@@ -0,0 +1,254 @@
+/**
+ * @file window_drop_job.c
+ * @brief Background import job for dropped files and folders.
+ *
+ * The drop handler only copies the dropped paths; enumeration, dedupe and
+ * copying run on a worker that posts progress and a final completion to the
+ * main window. Auto-apply of a single font or animation still happens on the
+ * UI thread once the whole drop has been seen.
+ *
+ * A job is shared by the UI thread and its worker and freed by whichever
+ * lets go last, so canceling never waits for a copy to wind down.
+ */
+
+#include "window_drop_target_internal.h"
+#include "window_procedure/ole_drop_target.h"
+
+#define DROP_IMPORT_SHUTDOWN_WAIT_MS 2000
+#define DROP_IMPORT_SHUTDOWN_POLL_MS 10
+
+typedef struct {
+    wchar_t (*paths)[MAX_PATH];
+    UINT pathCount;
+    volatile LONG refCount;
+    volatile LONG canceled;
+    DropImportState state;
+} DropImportJob;
+
+static SRWLOCK g_dropJobLock = SRWLOCK_INIT;
+static DropImportJob* g_dropJob = NULL;
+static volatile LONG g_dropJobGeneration = 0;
+/* Workers still running, including canceled ones winding down */
+static volatile LONG g_dropWorkerCount = 0;
+/* Latest progress of the current job, only touched on the UI thread */
+static int g_dropProgressImported = 0;
+static DWORD g_dropProgressScanned = 0;
+
+BOOL DropImport_IsCanceled(const DropImportState* state) {
+    return state && state->canceled && InterlockedCompareExchange(state->canceled, 0, 0) != 0;
+}
+
+static void PostDropImportProgress(DropImportState* state, BOOL force) {
+    if (!state->notifyHwnd) return;
+    DWORD now = GetTickCount();
+    if (!force && (DWORD)(now - state->lastProgressTick) < DROP_IMPORT_PROGRESS_INTERVAL_MS) return;
+    state->lastProgressTick = now;
+    WORD imported = (WORD)min(state->importedCount, 0xFFFF);
+    WORD scanned = (WORD)min(state->scannedEntries, 0xFFFFu);
+    PostMessageW(state->notifyHwnd, WM_APP_DROP_IMPORT_PROGRESS,
+                 (WPARAM)state->generation, MAKELPARAM(imported, scanned));
+}
+
+void DropImport_RecordImported(DropImportState* state, ResourceType type, const wchar_t* newPath) {
+    if (!state || !newPath) return;
+    state->importedCount++;
+    if (type == RESOURCE_TYPE_FONT) {
+        wcscpy_s(state->lastFontPath, MAX_PATH, newPath);
+        state->fontCount++;
+    } else if (type == RESOURCE_TYPE_ANIMATION) {
+        wcscpy_s(state->lastAnimPath, MAX_PATH, newPath);
+        state->animCount++;
+    }
+    PostDropImportProgress(state, FALSE);
+}
+
+static void ImportDroppedPath(DropImportState* state, const wchar_t* filePath) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(filePath, GetFileExInfoStandard, &data)) {
+        LOG_WARNING("Failed to query dropped path: %ls (error=%lu)", filePath, GetLastError());
+        return;
+    }
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        DropImport_ProcessDirectoryRecursive(filePath, filePath, state, 0);
+        return;
+    }
+    ResourceType type = DropImport_GetResourceType(filePath);
+    if (type == RESOURCE_TYPE_UNKNOWN) return;
+    ULONGLONG fileSize = ((ULONGLONG)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    wchar_t newPath[MAX_PATH];
+    if (DropImport_ImportResourceFile(filePath, type, fileSize, state, NULL, newPath, MAX_PATH)) {
+        DropImport_RecordImported(state, type, newPath);
+    }
+}
+
+static void FreeDropImportJob(DropImportJob* job) {
+    if (!job) return;
+    DropImport_ReleaseExistingIndex(&job->state);
+    free(job->state.copyBuffer);
+    free(job->paths);
+    free(job);
+}
+
+static void ReleaseDropImportJob(DropImportJob* job) {
+    if (job && InterlockedDecrement(&job->refCount) == 0) {
+        FreeDropImportJob(job);
+    }
+}
+
+static DWORD WINAPI DropImportThread(LPVOID param) {
+    DropImportJob* job = (DropImportJob*)param;
+    DropImportState* state = &job->state;
+    for (UINT i = 0; i < job->pathCount && !state->truncated && !DropImport_IsCanceled(state); i++) {
+        if (state->scannedEntries >= DROP_IMPORT_SCAN_ENTRY_BUDGET) {
+            state->truncated = TRUE;
+            break;
+        }
+        state->scannedEntries++;
+        ImportDroppedPath(state, job->paths[i]);
+    }
+    DropImport_ReleaseExistingIndex(state);
+    if (!DropImport_IsCanceled(state)) {
+        PostDropImportProgress(state, TRUE);
+        PostMessageW(state->notifyHwnd, WM_APP_DROP_IMPORT_COMPLETE, (WPARAM)state->generation, 0);
+    }
+    /* Nothing touches the job after this, so a canceled one frees itself */
+    ReleaseDropImportJob(job);
+    InterlockedDecrement(&g_dropWorkerCount);
+    return 0;
+}
+
+/* Detaches the current job; the caller owns its reference */
+static DropImportJob* TakeDropImportJobLocked(void) {
+    DropImportJob* job = g_dropJob;
+    g_dropJob = NULL;
+    g_dropProgressImported = 0;
+    g_dropProgressScanned = 0;
+    return job;
+}
+
+static BOOL CopyDroppedPaths(DropImportJob* job, HDROP hDrop, UINT fileCount) {
+    UINT capacity = min(fileCount, DROP_IMPORT_SCAN_ENTRY_BUDGET);
+    job->paths = (wchar_t (*)[MAX_PATH])malloc((size_t)capacity * sizeof(*job->paths));
+    if (!job->paths) return FALSE;
+    if (fileCount > capacity) job->state.truncated = TRUE;
+    for (UINT i = 0; i < capacity; i++) {
+        if (!DropImport_QueryFilePathExactW(hDrop, i, job->paths[i], MAX_PATH)) {
+            job->state.truncated = TRUE;
+            break;
+        }
+        job->pathCount++;
+    }
+    return TRUE;
+}
+
+BOOL StartDropImportJob(HWND hwnd, HDROP hDrop) {
+    UINT fileCount = hDrop ? DragQueryFileW(hDrop, 0xFFFFFFFF, NULL, 0) : 0;
+    if (fileCount == 0) return FALSE;
+    if (CancelDropImportJob()) {
+        LOG_INFO("Canceled the previous dropped resource import");
+    }
+
+    DropImportJob* job = (DropImportJob*)calloc(1, sizeof(DropImportJob));
+    if (!job) return FALSE;
+    job->state.copyBuffer = (BYTE*)malloc(DROP_IMPORT_COPY_BUFFER_BYTES);
+    if (!job->state.copyBuffer || !CopyDroppedPaths(job, hDrop, fileCount)) {
+        FreeDropImportJob(job);
+        return FALSE;
+    }
+    DropImport_InitializeTargetRoots(&job->state);
+    job->state.notifyHwnd = hwnd;
+    job->state.canceled = &job->canceled;
+    job->state.lastProgressTick = GetTickCount();
+    /* One reference for the UI thread, one for the worker */
+    job->refCount = 2;
+
+    AcquireSRWLockExclusive(&g_dropJobLock);
+    job->state.generation = InterlockedIncrement(&g_dropJobGeneration);
+    InterlockedIncrement(&g_dropWorkerCount);
+    HANDLE thread = CreateThread(NULL, 0, DropImportThread, job, 0, NULL);
+    if (thread) {
+        g_dropJob = job;
+    } else {
+        InterlockedDecrement(&g_dropWorkerCount);
+    }
+    ReleaseSRWLockExclusive(&g_dropJobLock);
+
+    if (!thread) {
+        LOG_WARNING("Failed to start dropped resource import thread (error=%lu)", GetLastError());
+        FreeDropImportJob(job);
+        return FALSE;
+    }
+    CloseHandle(thread);
+    return TRUE;
+}
+
+BOOL CancelDropImportJob(void) {
+    AcquireSRWLockExclusive(&g_dropJobLock);
+    DropImportJob* job = TakeDropImportJobLocked();
+    ReleaseSRWLockExclusive(&g_dropJobLock);
+    if (!job) return FALSE;
+
+    /* The worker notices between 1 MB chunks, removes its temporary file
+     * and frees the job once it drops the last reference */
+    InterlockedExchange(&job->canceled, 1);
+    ReleaseDropImportJob(job);
+    return TRUE;
+}
+
+void ShutdownDropImportJobs(void) {
+    CancelDropImportJob();
+    /* Give canceled copies a moment to remove their temporary files */
+    DWORD start = GetTickCount();
+    while (InterlockedCompareExchange(&g_dropWorkerCount, 0, 0) > 0) {
+        if (GetTickCount() - start >= DROP_IMPORT_SHUTDOWN_WAIT_MS) {
+            LOG_WARNING("Dropped resource import did not stop before shutdown");
+            return;
+        }
+        Sleep(DROP_IMPORT_SHUTDOWN_POLL_MS);
+    }
+}
+
+BOOL IsDropImportJobRunning(void) {
+    AcquireSRWLockShared(&g_dropJobLock);
+    BOOL running = g_dropJob != NULL;
+    ReleaseSRWLockShared(&g_dropJobLock);
+    return running;
+}
+
+BOOL GetDropImportProgress(int* imported, DWORD* scanned) {
+    if (!IsDropImportJobRunning()) return FALSE;
+    if (imported) *imported = g_dropProgressImported;
+    if (scanned) *scanned = g_dropProgressScanned;
+    return TRUE;
+}
+
+LRESULT HandleDropImportProgress(HWND hwnd, WPARAM wp, LPARAM lp) {
+    (void)hwnd;
+    if ((LONG)wp != InterlockedCompareExchange(&g_dropJobGeneration, 0, 0)) return 0;
+    g_dropProgressImported = (int)LOWORD(lp);
+    g_dropProgressScanned = (DWORD)HIWORD(lp);
+    LOG_DEBUG("Dropped resource import: %u imported, %u entries scanned",
+              (unsigned)LOWORD(lp), (unsigned)HIWORD(lp));
+    return 0;
+}
+
+LRESULT HandleDropImportComplete(HWND hwnd, WPARAM wp, LPARAM lp) {
+    (void)lp;
+    DropImportJob* job = NULL;
+    AcquireSRWLockExclusive(&g_dropJobLock);
+    /* A canceled or superseded job may still have its completion queued */
+    if (g_dropJob && g_dropJob->state.generation == (LONG)wp) {
+        job = TakeDropImportJobLocked();
+    }
+    ReleaseSRWLockExclusive(&g_dropJobLock);
+    if (!job) return 0;
+
+    /* The worker stops writing the state before it posts completion */
+    if (job->state.dedupedCount > 0) {
+        LOG_INFO("Dropped resource import reused %d existing file(s)", job->state.dedupedCount);
+    }
+    DropImportResult result = DropImport_ApplyResult(hwnd, &job->state);
+    ReleaseDropImportJob(job);
+    OleDropTarget_CompleteImport(&result);
+    return 0;
+}
@@ -7,6 +7,7 @@
 
 void DropImport_ProcessDirectoryRecursive(const wchar_t* dirPath, const wchar_t* rootDropPath, DropImportState* state, unsigned depth) {
     if (!dirPath || !rootDropPath || !state || state->truncated) return;
+    if (DropImport_IsCanceled(state)) return;
     if (DropImport_IsTargetSubtree(dirPath, rootDropPath, state)) return;
     if (depth >= DROP_IMPORT_SCAN_DEPTH_LIMIT) {
         state->truncated = TRUE;
@@ -73,19 +74,14 @@ void DropImport_ProcessDirectoryRecursive(const wchar_t* dirPath, const wchar_t*
                         }
                     }
                 }
+                /* The listing already has the size; no per-file stat */
+                ULONGLONG fileSize = ((ULONGLONG)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
                 wchar_t newPath[MAX_PATH];
-                if (DropImport_ImportResourceFile(fullPath, type, state, relativeDir, newPath, MAX_PATH)) {
-                    state->importedCount++;
-                    if (type == RESOURCE_TYPE_FONT) {
-                        wcscpy_s(state->lastFontPath, MAX_PATH, newPath);
-                        state->fontCount++;
-                    } else if (type == RESOURCE_TYPE_ANIMATION) {
-                        wcscpy_s(state->lastAnimPath, MAX_PATH, newPath);
-                        state->animCount++;
-                    }
+                if (DropImport_ImportResourceFile(fullPath, type, fileSize, state, relativeDir, newPath, MAX_PATH)) {
+                    DropImport_RecordImported(state, type, newPath);
                 }
             }
         }
-    } while (!state->truncated && FindNextFileW(hFind, &findData));
+    } while (!state->truncated && !DropImport_IsCanceled(state) && FindNextFileW(hFind, &findData));
     FindClose(hFind);
 }
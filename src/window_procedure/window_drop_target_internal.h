@@ -30,6 +30,16 @@ extern char CLOCK_STARTUP_MODE[20];
 #define DROP_IMPORT_SCAN_DEPTH_LIMIT 16u
 #define DROP_IMPORT_MAX_FONT_BYTES (64ull * 1024ull * 1024ull)
 #define DROP_IMPORT_MAX_ANIMATION_BYTES (128ull * 1024ull * 1024ull)
+#define DROP_IMPORT_COPY_BUFFER_BYTES (1024u * 1024u)
+#define DROP_IMPORT_PROGRESS_INTERVAL_MS 100u
+
+/** A file already in a target folder, hashed only when a size matches */
+typedef struct {
+    ULONGLONG size;
+    ULONGLONG hash;
+    BOOL hashed;
+    wchar_t name[MAX_PATH];
+} DropImportExistingFile;
 
 typedef struct {
     wchar_t lastFontPath[MAX_PATH];
@@ -39,8 +49,20 @@ typedef struct {
     int fontCount;
     int animCount;
     int importedCount;
+    int dedupedCount;
     DWORD scannedEntries;
     BOOL truncated;
+    /* Worker-side job plumbing */
+    HWND notifyHwnd;
+    LONG generation;
+    volatile LONG* canceled;
+    DWORD lastProgressTick;
+    BYTE* copyBuffer;
+    /* Files of the last target folder, for content dedupe */
+    wchar_t existingDir[MAX_PATH];
+    DropImportExistingFile* existing;
+    int existingCount;
+    int existingCapacity;
 } DropImportState;
 
 ResourceType DropImport_GetResourceType(const wchar_t* filename);
@@ -53,7 +75,8 @@ BOOL DropImport_IsTargetSubtree(const wchar_t* dirPath,
                                 const wchar_t* rootDropPath,
                                 const DropImportState* state);
 BOOL DropImport_ImportResourceFile(const wchar_t* srcPath, ResourceType type,
-                                   const DropImportState* state,
+                                   ULONGLONG fileSize,
+                                   DropImportState* state,
                                    const wchar_t* relativeDir,
                                    wchar_t* outNewPath, size_t size);
 void DropImport_ProcessDirectoryRecursive(const wchar_t* dirPath,
@@ -61,4 +84,22 @@ void DropImport_ProcessDirectoryRecursive(const wchar_t* dirPath,
                                           DropImportState* state,
                                           unsigned depth);
 
+/* window_drop_copy.c */
+BOOL DropImport_FindExistingCopy(DropImportState* state, const wchar_t* srcPath,
+                                 ULONGLONG fileSize, const wchar_t* targetDir,
+                                 wchar_t* outPath, size_t size);
+void DropImport_RememberImportedFile(DropImportState* state,
+                                     const wchar_t* destPath, ULONGLONG fileSize);
+BOOL DropImport_TransferFile(const wchar_t* srcPath, const wchar_t* targetDir,
+                             const wchar_t* destPath, DropImportState* state);
+void DropImport_ReleaseExistingIndex(DropImportState* state);
+
+/* window_drop_job.c */
+BOOL DropImport_IsCanceled(const DropImportState* state);
+void DropImport_RecordImported(DropImportState* state, ResourceType type,
+                               const wchar_t* newPath);
+
+/* window_drop_target.c */
+DropImportResult DropImport_ApplyResult(HWND hwnd, const DropImportState* state);
+
 #endif /* CATIME_WINDOW_DROP_TARGET_INTERNAL_H */
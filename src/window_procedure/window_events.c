@@ -66,6 +66,9 @@ void HandleWindowDestroy(HWND hwnd) {
     SaveWindowSettings(hwnd);
     CancelScheduledConfigSave(hwnd);
     
+    /* Stop a running drop import before its target window goes away */
+    ShutdownDropImportJobs();
+
     /* Cleanup OLE drag and drop */
     CleanupOleDropTarget(hwnd);
 
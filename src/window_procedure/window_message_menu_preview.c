@@ -9,6 +9,7 @@
 #include "menu_preview.h"
 #include "preview_display.h"
 #include "text_effect.h"
+#include "tray/tray_menu_cache.h"
 #include "tray/tray_menu_font.h"
 #include "tray/tray_menu_submenus.h"
 #include "window_procedure/window_menus.h"
@@ -200,6 +201,9 @@ LRESULT HandleInitMenuPopup(HWND hwnd, WPARAM wp, LPARAM lp) {
         return 0;
     }
 
+    if (TrayMenuCache_OnInitMenuPopup((HMENU)wp)) {
+        return 0;
+    }
     UpdateHelpSubmenuSupportFace((HMENU)wp);
     return 0;
 }
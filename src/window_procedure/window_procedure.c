@@ -145,6 +145,8 @@ static const MessageDispatchEntry MESSAGE_DISPATCH_TABLE[] = {
     {WM_POWERBROADCAST, HandlePowerBroadcast},
     {WM_APP_QUICK_COUNTDOWN_INDEX, HandleQuickCountdownIndex},
     {WM_APP_SHOW_CLI_HELP, HandleShowCliHelp},
+    {WM_APP_DROP_IMPORT_PROGRESS, HandleDropImportProgress},
+    {WM_APP_DROP_IMPORT_COMPLETE, HandleDropImportComplete},
     {WM_USER + 100, HandleTrayUpdateIcon},
     {WM_APP + 1, HandleAppReregisterHotkeys},
     {CLOCK_WM_ANIMATION_PREVIEW_LOADED, HandleAnimationPreviewLoaded},
@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 volatile LONG g_audioPlaybackGeneration = 0;
+volatile LONG g_audioPreviewGeneration = 0;
 volatile LONG g_audioDesiredVolume = -1;
 volatile LONG g_audioDesiredPaused = 0;
 SRWLOCK g_audioStateLock = SRWLOCK_INIT;
@@ -21,6 +22,8 @@ void CleanupAudioResourcesLocked(void) {
     InterlockedIncrement(&g_cleanupCount);
 }
 
+void StopPreviewVoicesLocked(void) {}
+
 static DWORD WINAPI HoldAudioLock(LPVOID parameter) {
     (void)parameter;
     AcquireSRWLockExclusive(&g_audioStateLock);
@@ -0,0 +1,171 @@
+#include "audio_player_internal.h"
+#include "config/config_published.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+void WriteLog(LogLevel level, const char* format, ...) {
+    (void)level;
+    (void)format;
+}
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static BOOL WriteToneWav(const wchar_t* path, DWORD frameCount) {
+    const DWORD sampleRate = 48000;
+    DWORD dataBytes = frameCount * sizeof(short);
+    BYTE header[44] = {0};
+    DWORD riffSize = 36 + dataBytes;
+    DWORD fmtSize = 16;
+    WORD formatTag = 1;
+    WORD channels = 1;
+    DWORD byteRate = sampleRate * sizeof(short);
+    WORD blockAlign = sizeof(short);
+    WORD bitsPerSample = 16;
+    memcpy(header, "RIFF", 4);
+    memcpy(header + 4, &riffSize, 4);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    memcpy(header + 16, &fmtSize, 4);
+    memcpy(header + 20, &formatTag, 2);
+    memcpy(header + 22, &channels, 2);
+    memcpy(header + 24, &sampleRate, 4);
+    memcpy(header + 28, &byteRate, 4);
+    memcpy(header + 32, &blockAlign, 2);
+    memcpy(header + 34, &bitsPerSample, 2);
+    memcpy(header + 36, "data", 4);
+    memcpy(header + 40, &dataBytes, 4);
+
+    FILE* file = _wfopen(path, L"wb");
+    if (!file) return FALSE;
+    BOOL ok = fwrite(header, sizeof(header), 1, file) == 1;
+    for (DWORD i = 0; ok && i < frameCount; ++i) {
+        short sample = (short)((i % 96u) < 48u ? 4000 : -4000);
+        ok = fwrite(&sample, sizeof(sample), 1, file) == 1;
+    }
+    return fclose(file) == 0 && ok;
+}
+
+static void UseToneFile(ConfigSnapshot* config, const void* context) {
+    strncpy_s(config->notificationSoundFile, sizeof(config->notificationSoundFile),
+              (const char*)context, _TRUNCATE);
+    config->notificationSoundVolume = 0;
+}
+
+static void PumpMessages(void) {
+    MSG message;
+    while (PeekMessageW(&message, NULL, 0, 0, PM_REMOVE)) {
+        DispatchMessageW(&message);
+    }
+}
+
+static LONG WaitForStartLatency(void) {
+    ULONGLONG deadline = GetTickCount64() + 3000;
+    LONG latency = -1;
+    while ((latency = InterlockedCompareExchange(
+                &g_audioLastStartLatencyUs, 0, 0)) < 0 &&
+           GetTickCount64() < deadline) {
+        PumpMessages();
+        Sleep(1);
+    }
+    return latency;
+}
+
+static int ActiveVoices(void) {
+    AcquireSRWLockExclusive(&g_audioStateLock);
+    int count = AudioMixer_GetActiveVoiceCount();
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+    return count;
+}
+
+static BOOL WaitForVoices(int expected) {
+    ULONGLONG deadline = GetTickCount64() + 3000;
+    while (ActiveVoices() != expected) {
+        if (GetTickCount64() >= deadline) return FALSE;
+        PumpMessages();
+        Sleep(1);
+    }
+    return TRUE;
+}
+
+static LONG PlayAndMeasure(HWND hwnd, const char* path) {
+    InterlockedExchange(&g_audioLastStartLatencyUs, -1);
+    if (!PlayNotificationSoundFile(hwnd, path)) return -1;
+    return WaitForStartLatency();
+}
+
+static void StopAndSettle(void) {
+    StopNotificationSound();
+    AcquireSRWLockExclusive(&g_audioStateLock);
+    ReleaseSRWLockExclusive(&g_audioStateLock);
+}
+
+int main(void) {
+    wchar_t tempDir[MAX_PATH];
+    wchar_t widePath[MAX_PATH];
+    if (!GetTempPathW(MAX_PATH, tempDir) ||
+        !GetTempFileNameW(tempDir, L"cat", 0, widePath)) {
+        return 1;
+    }
+    char path[MAX_PATH];
+    WideCharToMultiByte(CP_UTF8, 0, widePath, -1, path, sizeof(path), NULL, NULL);
+    PublishedConfig_Publish(NULL, UseToneFile, path);
+    char configured[MAX_PATH];
+    Expect(GetConfiguredSoundFile(configured, sizeof(configured)) &&
+               strcmp(configured, path) == 0,
+           "the configured sound should come from the published snapshot");
+
+    HWND hwnd = CreateWindowExW(0, L"STATIC", L"", 0, 0, 0, 0, 0,
+                                HWND_MESSAGE, NULL, NULL, NULL);
+    Expect(hwnd != NULL, "message window should be created");
+    Expect(WriteToneWav(widePath, 9600), "tone should be written");
+
+    LONG coldUs = PlayAndMeasure(hwnd, path);
+    Expect(coldUs >= 0 && coldUs < 1000000,
+           "cold playback should reach the device within a second");
+    Expect(AudioPcmCache_GetTotalBytes() ==
+               9600u * AUDIO_MIXER_CHANNELS * sizeof(ma_int16),
+           "the decoded tone should be cached in the mixer format");
+    StopAndSettle();
+    Expect(g_deviceInitialized, "stopping a sound should keep the device open");
+
+    LONG warmUs = PlayAndMeasure(hwnd, path);
+    Expect(warmUs >= 0 && warmUs < 1000000,
+           "warm playback should reach the device within a second");
+    printf("deadline to first sample: cold %ld us, warm %ld us\n", coldUs, warmUs);
+    StopAndSettle();
+
+    /* Overlapping alerts and a preview share the device */
+    Expect(WriteToneWav(widePath, 96000), "long tone should be written");
+    Expect(PlayNotificationSoundFile(hwnd, path), "first alert should queue");
+    Expect(PlayNotificationSoundFile(hwnd, path), "second alert should queue");
+    Expect(PreviewNotificationSoundFile(hwnd, path), "preview should queue");
+    Expect(WaitForVoices(3), "alerts and the preview should play together");
+    StopPreviewNotificationSound();
+    Expect(WaitForVoices(2), "stopping the preview should leave both alerts");
+    StopAndSettle();
+    Expect(WaitForVoices(0), "stopping should fade out every voice");
+
+    /* A rewritten file must be decoded again rather than served stale */
+    Expect(WriteToneWav(widePath, 4800), "shorter tone should be written");
+    Expect(PlayAndMeasure(hwnd, path) >= 0, "rewritten tone should play");
+    Expect(AudioPcmCache_GetTotalBytes() ==
+               4800u * AUDIO_MIXER_CHANNELS * sizeof(ma_int16),
+           "a modified file should replace its cached clip");
+
+    ShutdownAudioPlayer();
+    Expect(!g_deviceInitialized && AudioPcmCache_GetTotalBytes() == 0,
+           "shutdown should close the device and drop every clip");
+    if (hwnd) DestroyWindow(hwnd);
+    DeleteFileW(widePath);
+
+    if (g_failures) {
+        fprintf(stderr, "%d audio latency test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file bench_alloc.c
+ * @brief Counting wrappers behind bench_alloc.h.
+ *
+ * Effect tile workers allocate too, so the counters are updated atomically.
+ */
+
+#define CATIME_BENCH_ALLOC_IMPLEMENTATION
+#include "bench_alloc.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BENCH_ATOMIC_ADD(target, value) \
+    _InterlockedExchangeAdd64((volatile long long*)(target), (long long)(value))
+#else
+#define BENCH_ATOMIC_ADD(target, value) __atomic_fetch_add((target), (value), __ATOMIC_RELAXED)
+#endif
+
+static BenchAllocStats g_stats;
+
+void* BenchAlloc_Malloc(size_t size) {
+    BENCH_ATOMIC_ADD(&g_stats.allocations, 1ULL);
+    BENCH_ATOMIC_ADD(&g_stats.bytes, (unsigned long long)size);
+    return malloc(size);
+}
+
+void* BenchAlloc_Calloc(size_t count, size_t size) {
+    BENCH_ATOMIC_ADD(&g_stats.allocations, 1ULL);
+    BENCH_ATOMIC_ADD(&g_stats.bytes, (unsigned long long)(count * size));
+    return calloc(count, size);
+}
+
+void* BenchAlloc_Realloc(void* ptr, size_t size) {
+    BENCH_ATOMIC_ADD(&g_stats.allocations, 1ULL);
+    BENCH_ATOMIC_ADD(&g_stats.bytes, (unsigned long long)size);
+    return realloc(ptr, size);
+}
+
+void BenchAlloc_Free(void* ptr) {
+    if (ptr) BENCH_ATOMIC_ADD(&g_stats.frees, 1ULL);
+    free(ptr);
+}
+
+char* BenchAlloc_Strdup(const char* text) {
+    size_t size = strlen(text) + 1;
+    char* copy = (char*)BenchAlloc_Malloc(size);
+    if (copy) memcpy(copy, text, size);
+    return copy;
+}
+
+wchar_t* BenchAlloc_Wcsdup(const wchar_t* text) {
+    size_t size = (wcslen(text) + 1) * sizeof(wchar_t);
+    wchar_t* copy = (wchar_t*)BenchAlloc_Malloc(size);
+    if (copy) memcpy(copy, text, size);
+    return copy;
+}
+
+void BenchAlloc_Reset(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+BenchAllocStats BenchAlloc_Snapshot(void) {
+    return g_stats;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file bench_alloc.h
+ * @brief Heap call counting for the render benchmark.
+ *
+ * Force-included into every production source the benchmark links, so the
+ * CRT allocation calls there (including stb_truetype's) go through counting
+ * wrappers. The benchmark's own sources are compiled without it.
+ */
+
+#ifndef CATIME_BENCH_ALLOC_H
+#define CATIME_BENCH_ALLOC_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+typedef struct {
+    unsigned long long allocations;
+    unsigned long long frees;
+    unsigned long long bytes;
+} BenchAllocStats;
+
+void* BenchAlloc_Malloc(size_t size);
+void* BenchAlloc_Calloc(size_t count, size_t size);
+void* BenchAlloc_Realloc(void* ptr, size_t size);
+void BenchAlloc_Free(void* ptr);
+char* BenchAlloc_Strdup(const char* text);
+wchar_t* BenchAlloc_Wcsdup(const wchar_t* text);
+
+void BenchAlloc_Reset(void);
+BenchAllocStats BenchAlloc_Snapshot(void);
+
+#ifndef CATIME_BENCH_ALLOC_IMPLEMENTATION
+#define malloc(size) BenchAlloc_Malloc(size)
+#define calloc(count, size) BenchAlloc_Calloc((count), (size))
+#define realloc(ptr, size) BenchAlloc_Realloc((ptr), (size))
+#define free(ptr) BenchAlloc_Free(ptr)
+#define _strdup(text) BenchAlloc_Strdup(text)
+#define _wcsdup(text) BenchAlloc_Wcsdup(text)
+#endif
+
+#endif /* CATIME_BENCH_ALLOC_H */
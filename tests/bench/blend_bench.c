@@ -0,0 +1,187 @@
+/**
+ * @file blend_bench.c
+ * @brief Throughput of the shared blend kernels against the per-pixel
+ *        division formulas they replaced.
+ *
+ * Each rule blends a synthetic glyph coverage field into a canvas, once with
+ * the old formula and once through the drawing_blend row kernel, and reports
+ * ns/pixel for both. The two canvases must match bit for bit; any difference
+ * fails the run.
+ *
+ *   blend_bench [--iterations N] [--color R,G,B]
+ */
+
+#include <windows.h>
+
+#include "drawing/drawing_blend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLEND_BENCH_WIDTH 512
+#define BLEND_BENCH_HEIGHT 256
+#define BLEND_BENCH_PIXELS (BLEND_BENCH_WIDTH * BLEND_BENCH_HEIGHT)
+#define BLEND_BENCH_DEFAULT_ITERATIONS 200
+#define BLEND_BENCH_R 255
+#define BLEND_BENCH_G 200
+#define BLEND_BENCH_B 80
+
+typedef void (*BlendRowFn)(DWORD* dest, const BYTE* coverage, int count);
+
+/* Settable from the command line, so no formula can fold them to constants */
+static int g_r = BLEND_BENCH_R;
+static int g_g = BLEND_BENCH_G;
+static int g_b = BLEND_BENCH_B;
+static DWORD g_background[BLEND_BENCH_PIXELS];
+static BYTE g_coverage[BLEND_BENCH_PIXELS];
+
+static LONGLONG NowNanoseconds(void) {
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&now);
+    return (LONGLONG)((double)now.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+
+/* Glyph-like coverage: mostly empty, solid strokes, anti-aliased edges */
+static void BuildInputs(void) {
+    unsigned int seed = 12345u;
+    for (int i = 0; i < BLEND_BENCH_PIXELS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int x = i % BLEND_BENCH_WIDTH;
+        int band = (x / 6) % 4;
+        g_coverage[i] = band == 0 ? 0 : band == 1 ? 255 : (BYTE)(seed >> 16);
+        g_background[i] = (seed >> 24) < 96 ? 0 : (seed & 0x7F7F7F7Fu);
+    }
+}
+
+static void ReferencePremultiplyMax(DWORD* dest, const BYTE* coverage, int count) {
+    for (int i = 0; i < count; i++) {
+        DWORD alpha = coverage[i];
+        if (alpha > ((dest[i] >> 24) & 0xFF)) {
+            DWORD finalR = (g_r * alpha) / 255;
+            DWORD finalG = (g_g * alpha) / 255;
+            DWORD finalB = (g_b * alpha) / 255;
+            dest[i] = (alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+        }
+    }
+}
+
+static void ReferenceOver(DWORD* dest, const BYTE* coverage, int count) {
+    for (int i = 0; i < count; i++) {
+        int alpha = coverage[i];
+        if (alpha == 0) continue;
+        DWORD pixel = dest[i];
+        int invAlpha = 255 - alpha;
+        int outA = alpha + (int)((pixel >> 24) & 0xFF) * invAlpha / 255;
+        int outR = (g_r * alpha + (int)((pixel >> 16) & 0xFF) * invAlpha) / 255;
+        int outG = (g_g * alpha + (int)((pixel >> 8) & 0xFF) * invAlpha) / 255;
+        int outB = (g_b * alpha + (int)(pixel & 0xFF) * invAlpha) / 255;
+        dest[i] = ((DWORD)outA << 24) | ((DWORD)outR << 16) | ((DWORD)outG << 8) | (DWORD)outB;
+    }
+}
+
+static void ReferenceAdd(DWORD* dest, const BYTE* coverage, int count) {
+    for (int i = 0; i < count; i++) {
+        int alpha = coverage[i];
+        if (alpha == 0) continue;
+        DWORD pixel = dest[i];
+        int outR = (int)((pixel >> 16) & 0xFF) + (g_r * alpha) / 255;
+        int outG = (int)((pixel >> 8) & 0xFF) + (g_g * alpha) / 255;
+        int outB = (int)(pixel & 0xFF) + (g_b * alpha) / 255;
+        int bgA = (int)((pixel >> 24) & 0xFF);
+        if (outR > 255) outR = 255;
+        if (outG > 255) outG = 255;
+        if (outB > 255) outB = 255;
+        int outA = bgA > alpha ? bgA : alpha;
+        dest[i] = ((DWORD)outA << 24) | ((DWORD)outR << 16) | ((DWORD)outG << 8) | (DWORD)outB;
+    }
+}
+
+static void ReferenceLerp(DWORD* dest, const BYTE* coverage, int count) {
+    for (int i = 0; i < count; i++) {
+        int alpha = coverage[i];
+        if (alpha == 0) continue;
+        DWORD pixel = dest[i];
+        int er = (pixel >> 16) & 0xFF;
+        int eg = (pixel >> 8) & 0xFF;
+        int eb = pixel & 0xFF;
+        int ea = (pixel >> 24) & 0xFF;
+        int nr = er + ((g_r - er) * alpha) / 255;
+        int ng = eg + ((g_g - eg) * alpha) / 255;
+        int nb = eb + ((g_b - eb) * alpha) / 255;
+        int na = ea + ((255 - ea) * alpha) / 255;
+        dest[i] = ((DWORD)na << 24) | ((DWORD)nr << 16) | ((DWORD)ng << 8) | (DWORD)nb;
+    }
+}
+
+static void KernelPremultiplyMax(DWORD* dest, const BYTE* coverage, int count) {
+    DrawingBlend_PremultiplyMaxRow(dest, coverage, count, g_r, g_g, g_b);
+}
+
+static void KernelOver(DWORD* dest, const BYTE* coverage, int count) {
+    DrawingBlend_OverRow(dest, coverage, count, g_r, g_g, g_b);
+}
+
+static void KernelAdd(DWORD* dest, const BYTE* coverage, int count) {
+    DrawingBlend_AddRow(dest, coverage, count, g_r, g_g, g_b);
+}
+
+static void KernelLerp(DWORD* dest, const BYTE* coverage, int count) {
+    DrawingBlend_LerpRow(dest, coverage, count, g_r, g_g, g_b);
+}
+
+/* Rows are blended one at a time, as the glyph compositors call them */
+static double TimeRows(BlendRowFn blend, DWORD* canvas, int iterations) {
+    LONGLONG elapsed = 0;
+    for (int n = 0; n < iterations; n++) {
+        memcpy(canvas, g_background, sizeof(g_background));
+        LONGLONG begin = NowNanoseconds();
+        for (int y = 0; y < BLEND_BENCH_HEIGHT; y++) {
+            size_t offset = (size_t)y * BLEND_BENCH_WIDTH;
+            blend(canvas + offset, g_coverage + offset, BLEND_BENCH_WIDTH);
+        }
+        elapsed += NowNanoseconds() - begin;
+    }
+    return (double)elapsed / ((double)iterations * BLEND_BENCH_PIXELS);
+}
+
+static BOOL RunRule(const char* name, BlendRowFn reference, BlendRowFn kernel,
+                    int iterations) {
+    static DWORD expected[BLEND_BENCH_PIXELS];
+    static DWORD actual[BLEND_BENCH_PIXELS];
+    double referenceNs = TimeRows(reference, expected, iterations);
+    double kernelNs = TimeRows(kernel, actual, iterations);
+    BOOL exact = memcmp(expected, actual, sizeof(actual)) == 0;
+    printf("%-16s %12.3f %12.3f %9.2fx  %s\n", name, referenceNs, kernelNs,
+           kernelNs > 0.0 ? referenceNs / kernelNs : 0.0, exact ? "exact" : "MISMATCH");
+    return exact;
+}
+
+int main(int argc, char** argv) {
+    int iterations = BLEND_BENCH_DEFAULT_ITERATIONS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--color") == 0 && i + 1 < argc &&
+                   sscanf(argv[++i], "%d,%d,%d", &g_r, &g_g, &g_b) == 3) {
+            g_r &= 0xFF;
+            g_g &= 0xFF;
+            g_b &= 0xFF;
+        } else {
+            fprintf(stderr, "usage: blend_bench [--iterations N] [--color R,G,B]\n");
+            return 2;
+        }
+    }
+    if (iterations <= 0) iterations = 1;
+
+    BuildInputs();
+    printf("%-16s %12s %12s %10s\n", "rule", "div ns/px", "kernel ns/px", "speedup");
+    BOOL ok = TRUE;
+    ok &= RunRule("premultiply-max", ReferencePremultiplyMax, KernelPremultiplyMax, iterations);
+    ok &= RunRule("over", ReferenceOver, KernelOver, iterations);
+    ok &= RunRule("add", ReferenceAdd, KernelAdd, iterations);
+    ok &= RunRule("lerp", ReferenceLerp, KernelLerp, iterations);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file render_bench.c
+ * @brief Headless benchmark for glyph compositing, text effects and gradients.
+ *
+ * Every text in render_bench_scenarios.c is rendered with every EffectType,
+ * once in a solid color and once per gradient preset, through the same blend
+ * entry points the main window uses. Frames go into a plain DWORD canvas, so
+ * no window, DC or GPU is involved. Each scenario reports ns/frame, glyphs/s
+ * and heap calls per frame, plus a checksum of a frame at a fixed time.
+ *
+ *   render_bench [--frames N] [--font PATH] [--serial] [--check FILE] [--update-golden FILE]
+ *
+ * Frames go through the banded effect compositor unless --serial is given;
+ * both modes are checked against the same golden file.
+ * --check fails when any checksum differs from FILE; --update-golden rewrites
+ * FILE after an intentional rendering change. Float rounding in effects makes
+ * checksums platform specific, so the golden file is recorded on the Linux CI
+ * runner.
+ */
+
+#include "render_bench_scenarios.h"
+#include "bench_alloc.h"
+#include "color/gradient.h"
+#include "drawing/drawing_effect_tiles.h"
+#include "text_effect.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_FRAMES 20
+#define BENCH_TIME_OFFSET 1234
+#define BENCH_FRAME_MS 33
+#define BENCH_SOLID_R 255
+#define BENCH_SOLID_G 200
+#define BENCH_SOLID_B 80
+#define BENCH_MAX_SCENARIOS 512
+#define BENCH_NAME_CHARS 96
+
+#ifndef CATIME_BENCH_DEFAULT_FONT
+#define CATIME_BENCH_DEFAULT_FONT "asset/font/SIL/Rec Mono Casual Essence.ttf"
+#endif
+
+/* Preset config names are color lists; label scenarios by enum instead */
+static const char* const kGradientLabels[GRADIENT_CUSTOM] = {
+    "SOLID", "CANDY", "BREEZE", "FROST", "SUNSET", "STREAMER"
+};
+
+typedef struct {
+    char name[BENCH_NAME_CHARS];
+    ULONGLONG checksum;
+} BenchResult;
+
+typedef struct {
+    int frames;
+    const char* fontPath;
+    const char* checkPath;
+    const char* updatePath;
+    BOOL serial;
+} BenchOptions;
+
+static BenchResult g_results[BENCH_MAX_SCENARIOS];
+static int g_resultCount = 0;
+static BOOL g_tiled = TRUE;
+
+static LONGLONG NowNanoseconds(void) {
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&now);
+    return (LONGLONG)((double)now.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+
+static unsigned char* ReadFontFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = size > 0 ? (unsigned char*)malloc((size_t)size) : NULL;
+    if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+static void RenderFrame(DWORD* canvas, const BenchLayout* layout,
+                        EffectType effect, const GradientInfo* gradient, int timeMs) {
+    memset(canvas, 0, (size_t)layout->canvasWidth * (size_t)layout->canvasHeight * sizeof(DWORD));
+    BOOL tiled = g_tiled && effect != EFFECT_TYPE_NONE &&
+                 DrawingEffectTiles_Begin(canvas, layout->canvasWidth, layout->canvasHeight);
+    for (int i = 0; i < layout->glyphCount; i++) {
+        const BenchGlyph* glyph = &layout->glyphs[i];
+        if (gradient) {
+            BlendCharBitmapGradientSTBWithInfo(canvas, layout->canvasWidth, layout->canvasHeight,
+                                               glyph->x, glyph->y, glyph->bitmap,
+                                               glyph->width, glyph->height,
+                                               BENCH_CANVAS_PADDING, layout->textWidth,
+                                               gradient, timeMs, effect);
+        } else {
+            BlendCharBitmapSTBWithEffect(canvas, layout->canvasWidth, layout->canvasHeight,
+                                         glyph->x, glyph->y, glyph->bitmap,
+                                         glyph->width, glyph->height,
+                                         BENCH_SOLID_R, BENCH_SOLID_G, BENCH_SOLID_B,
+                                         effect, timeMs);
+        }
+    }
+    if (tiled) DrawingEffectTiles_End();
+}
+
+static void RecordResult(const char* name, ULONGLONG checksum) {
+    if (g_resultCount >= BENCH_MAX_SCENARIOS) return;
+    BenchResult* result = &g_results[g_resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->checksum = checksum;
+}
+
+static void RunScenario(const char* textName, const BenchLayout* layout, DWORD* canvas,
+                        EffectType effect, GradientType gradientType, int frames) {
+    const GradientInfo* gradient = gradientType != GRADIENT_NONE ? GetGradientInfo(gradientType) : NULL;
+    const char* effectName = effect == EFFECT_TYPE_NONE ? "NONE" : TextEffect_ToConfigString(effect);
+    char name[BENCH_NAME_CHARS];
+    snprintf(name, sizeof(name), "%s/%s/%s", textName, effectName, kGradientLabels[gradientType]);
+
+    /* Warm-up frame sizes the shared effect buffers and gradient LUT */
+    RenderFrame(canvas, layout, effect, gradient, BENCH_TIME_OFFSET);
+
+    /* Timed frames advance like the 30 fps animation timer, so time-keyed
+     * caches only hit as often as they would on screen */
+    BenchAlloc_Reset();
+    LONGLONG begin = NowNanoseconds();
+    for (int i = 0; i < frames; i++) {
+        RenderFrame(canvas, layout, effect, gradient, BENCH_TIME_OFFSET + (i + 1) * BENCH_FRAME_MS);
+    }
+    LONGLONG elapsed = NowNanoseconds() - begin;
+    BenchAllocStats allocs = BenchAlloc_Snapshot();
+
+    /* Checksum a fixed-time frame so it does not depend on --frames */
+    RenderFrame(canvas, layout, effect, gradient, BENCH_TIME_OFFSET);
+
+    double nsPerFrame = (double)elapsed / (double)frames;
+    double glyphsPerSecond = nsPerFrame > 0.0 ? layout->glyphCount * 1e9 / nsPerFrame : 0.0;
+    ULONGLONG checksum = BenchChecksum(canvas, (size_t)layout->canvasWidth * (size_t)layout->canvasHeight);
+    printf("%-40s %12.0f %14.0f %10.2f  %016llx\n", name, nsPerFrame, glyphsPerSecond,
+           (double)allocs.allocations / (double)frames, checksum);
+    RecordResult(name, checksum);
+}
+
+static BOOL RunText(const stbtt_fontinfo* font, const BenchText* text, int frames) {
+    BenchAlloc_Reset();
+    LONGLONG begin = NowNanoseconds();
+    wchar_t* resolved = BenchText_Resolve(text);
+    LONGLONG parseNs = NowNanoseconds() - begin;
+    if (!resolved) {
+        fprintf(stderr, "failed to resolve text %s\n", text->name);
+        return FALSE;
+    }
+    if (text->isMarkdown) {
+        printf("%-40s %12lld %14s %10llu\n", text->name, parseNs, "(md parse)",
+               BenchAlloc_Snapshot().allocations);
+    }
+
+    BenchLayout layout;
+    BOOL ok = BenchLayout_Build(font, resolved, &layout);
+    free(resolved);
+    if (!ok) return FALSE;
+
+    DWORD* canvas = (DWORD*)malloc((size_t)layout.canvasWidth * (size_t)layout.canvasHeight * sizeof(DWORD));
+    if (!canvas) {
+        BenchLayout_Free(&layout);
+        return FALSE;
+    }
+
+    for (int effect = EFFECT_TYPE_NONE; effect < TEXT_EFFECT_COUNT; effect++) {
+        for (int gradient = GRADIENT_NONE; gradient < GRADIENT_CUSTOM; gradient++) {
+            RunScenario(text->name, &layout, canvas, (EffectType)effect,
+                        (GradientType)gradient, frames);
+        }
+    }
+
+    free(canvas);
+    BenchLayout_Free(&layout);
+    return TRUE;
+}
+
+static BOOL WriteGolden(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return FALSE;
+    for (int i = 0; i < g_resultCount; i++) {
+        fprintf(file, "%s %016llx\n", g_results[i].name, g_results[i].checksum);
+    }
+    fclose(file);
+    return TRUE;
+}
+
+static int CheckGolden(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "cannot open golden file %s\n", path);
+        return 1;
+    }
+
+    int mismatches = 0;
+    int matched = 0;
+    char name[BENCH_NAME_CHARS];
+    unsigned long long expected = 0;
+    while (fscanf(file, "%95s %llx", name, &expected) == 2) {
+        const BenchResult* result = NULL;
+        for (int i = 0; i < g_resultCount; i++) {
+            if (strcmp(g_results[i].name, name) == 0) result = &g_results[i];
+        }
+        if (!result) {
+            fprintf(stderr, "missing scenario %s\n", name);
+            mismatches++;
+        } else if (result->checksum != expected) {
+            fprintf(stderr, "checksum mismatch %s: expected %016llx, got %016llx\n",
+                    name, expected, result->checksum);
+            mismatches++;
+        } else {
+            matched++;
+        }
+    }
+    fclose(file);
+
+    if (matched + mismatches != g_resultCount) {
+        fprintf(stderr, "golden file covers %d of %d scenario(s)\n",
+                matched + mismatches, g_resultCount);
+        mismatches++;
+    }
+    if (mismatches != 0) {
+        fprintf(stderr, "%d render checksum(s) failed\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
+
+static BOOL ParseOptions(int argc, char** argv, BenchOptions* options) {
+    options->frames = BENCH_DEFAULT_FRAMES;
+    options->fontPath = CATIME_BENCH_DEFAULT_FONT;
+    options->checkPath = NULL;
+    options->updatePath = NULL;
+    options->serial = FALSE;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--serial") == 0) {
+            options->serial = TRUE;
+            continue;
+        } else if (strcmp(argv[i], "--frames") == 0 && value) {
+            options->frames = atoi(value);
+        } else if (strcmp(argv[i], "--font") == 0 && value) {
+            options->fontPath = value;
+        } else if (strcmp(argv[i], "--check") == 0 && value) {
+            options->checkPath = value;
+        } else if (strcmp(argv[i], "--update-golden") == 0 && value) {
+            options->updatePath = value;
+        } else {
+            return FALSE;
+        }
+        i++;
+    }
+    return options->frames > 0;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        fprintf(stderr, "usage: %s [--frames N] [--font PATH] [--serial] [--check FILE] "
+                        "[--update-golden FILE]\n", argv[0]);
+        return 2;
+    }
+    g_tiled = !options.serial;
+
+    unsigned char* fontData = ReadFontFile(options.fontPath);
+    stbtt_fontinfo font;
+    if (!fontData || !stbtt_InitFont(&font, fontData, stbtt_GetFontOffsetForIndex(fontData, 0))) {
+        fprintf(stderr, "cannot load font %s\n", options.fontPath);
+        free(fontData);
+        return 2;
+    }
+
+    printf("%-40s %12s %14s %10s  %s\n", "scenario", "ns/frame", "glyphs/s", "allocs", "checksum");
+    int status = 0;
+    for (int i = 0; i < BenchText_Count(); i++) {
+        if (!RunText(&font, BenchText_Get(i), options.frames)) status = 1;
+    }
+    free(fontData);
+
+    if (status == 0 && options.updatePath && !WriteGolden(options.updatePath)) {
+        fprintf(stderr, "cannot write golden file %s\n", options.updatePath);
+        status = 1;
+    }
+    if (status == 0 && options.checkPath) {
+        status = CheckGolden(options.checkPath);
+    }
+    return status;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file render_bench_scenarios.c
+ * @brief Representative clock strings and Markdown documents, laid out once.
+ *
+ * Layout is a plain advance-plus-kerning walk. It stands in for the
+ * production measure pass, which depends on the font cache and GDI metrics;
+ * the benchmark times what happens after layout: compositing and effects.
+ */
+
+#include "render_bench_scenarios.h"
+#include "markdown/markdown_parser.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const BenchText kTexts[] = {
+    {"clock-hms", L"12:34:56", FALSE},
+    {"countdown-ms", L"00:04:59.750", FALSE},
+    {"pomodoro", L"Focus 24:59", FALSE},
+    {"md-notes",
+     L"# Sprint\n"
+     L"**25:00** until *break*\n"
+     L"- [x] inbox zero\n"
+     L"- [ ] review <color:#FF8800>render</color> PR\n"
+     L"> [!TIP] stand up and stretch",
+     TRUE},
+    {"md-links",
+     L"## Today\n"
+     L"1. [Docs](https://vladelaina.github.io/Catime/)\n"
+     L"2. `ctest --output-on-failure`\n"
+     L"3. ~~old~~ <color:#00C8FF_#FF00C8>new</color> plan",
+     TRUE},
+    /* Large enough for the banded effect compositor to split the frame */
+    {"dashboard",
+     L"CPU  42%  ||||||||....\n"
+     L"MEM  61%  ||||||||||||\n"
+     L"NET  1.2 MB/s  up 88 KB\n"
+     L"DISK 73%  C: 412/565 GB\n"
+     L"Next: standup in 12:30\n"
+     L"Build #1842 passed 4m\n"
+     L"Focus 24:59 / Break 5\n"
+     L"UTC 08:15  Tokyo 17:15",
+     FALSE},
+};
+
+int BenchText_Count(void) {
+    return (int)(sizeof(kTexts) / sizeof(kTexts[0]));
+}
+
+const BenchText* BenchText_Get(int index) {
+    return (index >= 0 && index < BenchText_Count()) ? &kTexts[index] : NULL;
+}
+
+static wchar_t* CopyText(const wchar_t* text) {
+    size_t size = (wcslen(text) + 1) * sizeof(wchar_t);
+    wchar_t* copy = (wchar_t*)malloc(size);
+    if (copy) memcpy(copy, text, size);
+    return copy;
+}
+
+wchar_t* BenchText_Resolve(const BenchText* text) {
+    if (!text) return NULL;
+    if (!text->isMarkdown) return CopyText(text->text);
+
+    wchar_t* displayText = NULL;
+    MarkdownLink* links = NULL;
+    MarkdownHeading* headings = NULL;
+    MarkdownStyle* styles = NULL;
+    MarkdownListItem* listItems = NULL;
+    MarkdownBlockquote* blockquotes = NULL;
+    MarkdownColorTag* colorTags = NULL;
+    MarkdownFontTag* fontTags = NULL;
+    int linkCount = 0, headingCount = 0, styleCount = 0, listItemCount = 0;
+    int blockquoteCount = 0, colorTagCount = 0, fontTagCount = 0;
+
+    if (!ParseMarkdownLinks(text->text, &displayText, &links, &linkCount,
+                            &headings, &headingCount, &styles, &styleCount,
+                            &listItems, &listItemCount, &blockquotes, &blockquoteCount,
+                            &colorTags, &colorTagCount, &fontTags, &fontTagCount)) {
+        return NULL;
+    }
+
+    FreeMarkdownLinks(links, linkCount);
+    free(headings);
+    free(styles);
+    free(listItems);
+    free(blockquotes);
+    free(colorTags);
+    free(fontTags);
+    return displayText;
+}
+
+static int LineWidthLimit(int current, int width) {
+    return width > current ? width : current;
+}
+
+BOOL BenchLayout_Build(const stbtt_fontinfo* font, const wchar_t* text, BenchLayout* layout) {
+    if (!font || !text || !layout) return FALSE;
+    memset(layout, 0, sizeof(*layout));
+
+    size_t length = wcslen(text);
+    layout->glyphs = (BenchGlyph*)calloc(length > 0 ? length : 1, sizeof(BenchGlyph));
+    if (!layout->glyphs) return FALSE;
+
+    float scale = stbtt_ScaleForPixelHeight(font, BENCH_FONT_PIXEL_HEIGHT);
+    int ascent = 0, descent = 0, lineGap = 0;
+    stbtt_GetFontVMetrics(font, &ascent, &descent, &lineGap);
+    int lineHeight = (int)((float)(ascent - descent + lineGap) * scale + 0.5f);
+    int baseline = (int)((float)ascent * scale + 0.5f);
+
+    float penX = 0.0f;
+    int lines = 1;
+    int previousGlyph = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == L'\n') {
+            layout->textWidth = LineWidthLimit(layout->textWidth, (int)(penX + 0.5f));
+            penX = 0.0f;
+            previousGlyph = 0;
+            lines++;
+            continue;
+        }
+
+        int glyph = stbtt_FindGlyphIndex(font, (int)text[i]);
+        if (glyph == 0) glyph = stbtt_FindGlyphIndex(font, '?');
+        if (previousGlyph) {
+            penX += (float)stbtt_GetGlyphKernAdvance(font, previousGlyph, glyph) * scale;
+        }
+
+        int advance = 0, leftBearing = 0;
+        stbtt_GetGlyphHMetrics(font, glyph, &advance, &leftBearing);
+
+        BenchGlyph* out = &layout->glyphs[layout->glyphCount];
+        int xoff = 0, yoff = 0;
+        out->bitmap = stbtt_GetGlyphBitmap(font, scale, scale, glyph,
+                                           &out->width, &out->height, &xoff, &yoff);
+        if (out->bitmap) {
+            out->x = BENCH_CANVAS_PADDING + (int)(penX + 0.5f) + xoff;
+            out->y = BENCH_CANVAS_PADDING + (lines - 1) * lineHeight + baseline + yoff;
+            layout->glyphCount++;
+        }
+
+        penX += (float)advance * scale;
+        previousGlyph = glyph;
+    }
+    layout->textWidth = LineWidthLimit(layout->textWidth, (int)(penX + 0.5f));
+    layout->canvasWidth = layout->textWidth + 2 * BENCH_CANVAS_PADDING;
+    layout->canvasHeight = lines * lineHeight + 2 * BENCH_CANVAS_PADDING;
+    return TRUE;
+}
+
+void BenchLayout_Free(BenchLayout* layout) {
+    if (!layout) return;
+    for (int i = 0; i < layout->glyphCount; i++) {
+        stbtt_FreeBitmap(layout->glyphs[i].bitmap, NULL);
+    }
+    free(layout->glyphs);
+    memset(layout, 0, sizeof(*layout));
+}
+
+ULONGLONG BenchChecksum(const DWORD* pixels, size_t count) {
+    ULONGLONG hash = 14695981039346656037ULL;
+    const unsigned char* bytes = (const unsigned char*)pixels;
+    for (size_t i = 0; i < count * sizeof(DWORD); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file render_bench_scenarios.h
+ * @brief Text inputs, glyph layout and pixel checksums for render_bench.
+ */
+
+#ifndef CATIME_RENDER_BENCH_SCENARIOS_H
+#define CATIME_RENDER_BENCH_SCENARIOS_H
+
+#include <windows.h>
+
+#include "drawing/drawing_text_stb.h"
+
+/** @brief Clock text sizes follow the default window font height */
+#define BENCH_FONT_PIXEL_HEIGHT 48.0f
+/** @brief Room for glow, neon and shadow effects outside the glyph boxes */
+#define BENCH_CANVAS_PADDING 24
+
+typedef struct {
+    const char* name;
+    const wchar_t* text;
+    BOOL isMarkdown;
+} BenchText;
+
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+    unsigned char* bitmap;
+} BenchGlyph;
+
+typedef struct {
+    BenchGlyph* glyphs;
+    int glyphCount;
+    int textWidth;
+    int canvasWidth;
+    int canvasHeight;
+} BenchLayout;
+
+int BenchText_Count(void);
+const BenchText* BenchText_Get(int index);
+
+/**
+ * @brief Markdown inputs are reduced to display text with the production
+ *        parser; plain inputs are copied
+ * @return Heap string for BenchLayout_Build, NULL on parse failure
+ */
+wchar_t* BenchText_Resolve(const BenchText* text);
+
+/** @brief Rasterizes every glyph once; frames only composite */
+BOOL BenchLayout_Build(const stbtt_fontinfo* font, const wchar_t* text, BenchLayout* layout);
+void BenchLayout_Free(BenchLayout* layout);
+
+/** @brief 64-bit FNV-1a over the canvas pixels */
+ULONGLONG BenchChecksum(const DWORD* pixels, size_t count);
+
+#endif /* CATIME_RENDER_BENCH_SCENARIOS_H */
@@ -0,0 +1,22 @@
+/**
+ * @file render_bench_stubs.c
+ * @brief Link stand-ins for app state the benchmarked modules reference.
+ */
+
+#include "drawing/drawing_render_metrics.h"
+#include "text_effect.h"
+
+/* Only reached through BlendCharBitmapSTB; the benchmark passes effects explicitly */
+EffectType GetActiveEffect(void) {
+    return EFFECT_TYPE_NONE;
+}
+
+/* Stage timing is the main window's concern; the benchmark times whole frames */
+LONGLONG RenderMetrics_StageBegin(void) {
+    return 0;
+}
+
+void RenderMetrics_StageEnd(RenderMetricStage stage, LONGLONG begin) {
+    (void)stage;
+    (void)begin;
+}
@@ -0,0 +1,14 @@
+/**
+ * @file config.h
+ * @brief Stand-in for include/config.h in the benchmark's POSIX build.
+ *
+ * The real header pulls in the tray, window and startup APIs. The glyph
+ * compositing modules include it but use none of its declarations.
+ */
+
+#ifndef CATIME_BENCH_CONFIG_SHIM_H
+#define CATIME_BENCH_CONFIG_SHIM_H
+
+#include <windows.h>
+
+#endif /* CATIME_BENCH_CONFIG_SHIM_H */
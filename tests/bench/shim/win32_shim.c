@@ -0,0 +1,181 @@
+/**
+ * @file win32_shim.c
+ * @brief POSIX implementations of the Win32 calls declared in shim/windows.h.
+ *
+ * Threads, events, critical sections and interlocked operations live in
+ * win32_shim_thread.c.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <time.h>
+#include <wctype.h>
+
+static DWORD g_lastError;
+
+BOOL PtInRect(const RECT* rect, POINT point) {
+    return point.x >= rect->left && point.x < rect->right &&
+           point.y >= rect->top && point.y < rect->bottom;
+}
+
+HINSTANCE ShellExecuteW(HWND hwnd, LPCWSTR operation, LPCWSTR file, LPCWSTR parameters,
+                        LPCWSTR directory, INT showCommand) {
+    (void)hwnd;
+    (void)operation;
+    (void)file;
+    (void)parameters;
+    (void)directory;
+    (void)showCommand;
+    return NULL;
+}
+
+void InitializeSRWLock(PSRWLOCK lock) { lock->Ptr = NULL; }
+void AcquireSRWLockExclusive(PSRWLOCK lock) { (void)lock; }
+void ReleaseSRWLockExclusive(PSRWLOCK lock) { (void)lock; }
+void AcquireSRWLockShared(PSRWLOCK lock) { (void)lock; }
+void ReleaseSRWLockShared(PSRWLOCK lock) { (void)lock; }
+
+static ULONGLONG MonotonicNanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (ULONGLONG)now.tv_sec * 1000000000ULL + (ULONGLONG)now.tv_nsec;
+}
+
+DWORD GetTickCount(void) { return (DWORD)(MonotonicNanoseconds() / 1000000ULL); }
+ULONGLONG GetTickCount64(void) { return MonotonicNanoseconds() / 1000000ULL; }
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* counter) {
+    counter->QuadPart = (LONGLONG)MonotonicNanoseconds();
+    return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency) {
+    frequency->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+DWORD GetLastError(void) { return g_lastError; }
+void SetLastError(DWORD error) { g_lastError = error; }
+void OutputDebugStringA(const char* text) { (void)text; }
+void OutputDebugStringW(const wchar_t* text) { (void)text; }
+
+int _snprintf_s(char* buffer, size_t size, size_t count, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = _vsnprintf_s(buffer, size, count, format, args);
+    va_end(args);
+    return written;
+}
+
+int _vsnprintf_s(char* buffer, size_t size, size_t count, const char* format, va_list args) {
+    (void)count;
+    if (!buffer || size == 0) return -1;
+    int written = vsnprintf(buffer, size, format, args);
+    return (written < 0 || (size_t)written >= size) ? -1 : written;
+}
+
+int _snwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, ...) {
+    (void)count;
+    if (!buffer || size == 0) return -1;
+    va_list args;
+    va_start(args, format);
+    int written = vswprintf(buffer, size, format, args);
+    va_end(args);
+    if (written < 0) buffer[size - 1] = L'\0';
+    return written;
+}
+
+int strcpy_s(char* dest, size_t size, const char* src) {
+    return strncpy_s(dest, size, src, (size_t)-1);
+}
+
+int strncpy_s(char* dest, size_t size, const char* src, size_t count) {
+    if (!dest || size == 0) return 22;
+    size_t length = strlen(src);
+    if (length > count) length = count;
+    if (length >= size) length = size - 1;
+    memcpy(dest, src, length);
+    dest[length] = '\0';
+    return 0;
+}
+
+int wcscpy_s(wchar_t* dest, size_t size, const wchar_t* src) {
+    return wcsncpy_s(dest, size, src, (size_t)-1);
+}
+
+int wcsncpy_s(wchar_t* dest, size_t size, const wchar_t* src, size_t count) {
+    if (!dest || size == 0) return 22;
+    size_t length = wcslen(src);
+    if (length > count) length = count;
+    if (length >= size) length = size - 1;
+    wmemcpy(dest, src, length);
+    dest[length] = L'\0';
+    return 0;
+}
+
+int wcscat_s(wchar_t* dest, size_t size, const wchar_t* src) {
+    size_t used = wcslen(dest);
+    if (used >= size) return 22;
+    return wcsncpy_s(dest + used, size - used, src, (size_t)-1);
+}
+
+wchar_t* _wcsdup(const wchar_t* text) {
+    size_t size = (wcslen(text) + 1) * sizeof(wchar_t);
+    wchar_t* copy = (wchar_t*)malloc(size);
+    if (copy) memcpy(copy, text, size);
+    return copy;
+}
+
+char* strtok_s(char* str, const char* delimiters, char** context) {
+    return strtok_r(str, delimiters, context);
+}
+
+wchar_t* wcstok_s(wchar_t* str, const wchar_t* delimiters, wchar_t** context) {
+    return wcstok(str, delimiters, context);
+}
+
+int _stricmp(const char* a, const char* b) { return strcasecmp(a, b); }
+int _strnicmp(const char* a, const char* b, size_t count) { return strncasecmp(a, b, count); }
+
+int _wcsnicmp(const wchar_t* a, const wchar_t* b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        wint_t ca = towlower((wint_t)a[i]);
+        wint_t cb = towlower((wint_t)b[i]);
+        if (ca != cb) return ca < cb ? -1 : 1;
+        if (ca == 0) return 0;
+    }
+    return 0;
+}
+
+int _wcsicmp(const wchar_t* a, const wchar_t* b) {
+    return _wcsnicmp(a, b, (size_t)-1);
+}
+
+int MultiByteToWideChar(UINT codePage, DWORD flags, const char* src, int srcLen,
+                        wchar_t* dest, int destLen) {
+    (void)codePage;
+    (void)flags;
+    size_t length = srcLen < 0 ? strlen(src) + 1 : (size_t)srcLen;
+    if (destLen == 0) return (int)length;
+    if ((size_t)destLen < length) return 0;
+    for (size_t i = 0; i < length; i++) dest[i] = (unsigned char)src[i];
+    return (int)length;
+}
+
+int WideCharToMultiByte(UINT codePage, DWORD flags, const wchar_t* src, int srcLen,
+                        char* dest, int destLen, const char* defaultChar, BOOL* usedDefault) {
+    (void)codePage;
+    (void)flags;
+    (void)defaultChar;
+    if (usedDefault) *usedDefault = FALSE;
+    size_t length = srcLen < 0 ? wcslen(src) + 1 : (size_t)srcLen;
+    if (destLen == 0) return (int)length;
+    if ((size_t)destLen < length) return 0;
+    for (size_t i = 0; i < length; i++) dest[i] = src[i] < 0x80 ? (char)src[i] : '?';
+    return (int)length;
+}
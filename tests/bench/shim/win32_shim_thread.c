@@ -0,0 +1,205 @@
+/**
+ * @file win32_shim_thread.c
+ * @brief pthread-backed threads, events and locks for the benchmark shim.
+ *
+ * Effect tiles run on real worker threads, so the benchmark exercises the
+ * same hand-offs as the Windows build. Only what the tile scheduler needs is
+ * modelled: auto- and manual-reset events, joinable threads, recursive
+ * critical sections and waits without timeouts.
+ */
+
+#define _GNU_SOURCE
+
+#include <windows.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Single-core hosts still report enough cores to take the banded path */
+#define SHIM_MIN_PROCESSORS 4
+
+typedef enum { SHIM_HANDLE_EVENT, SHIM_HANDLE_THREAD } ShimHandleKind;
+
+typedef struct {
+    ShimHandleKind kind;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    BOOL signaled;
+    BOOL manualReset;
+    pthread_t thread;
+    BOOL joined;
+} ShimHandle;
+
+/* Owned by the new thread, so closing its handle early is safe */
+typedef struct {
+    LPTHREAD_START_ROUTINE start;
+    LPVOID parameter;
+} ShimThreadStart;
+
+static pthread_mutex_t g_initOnceMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static volatile LONG g_nextThreadId = 0;
+static _Thread_local DWORD t_threadId = 0;
+
+BOOL InitOnceExecuteOnce(PINIT_ONCE once, PINIT_ONCE_FN fn, PVOID parameter, PVOID* context) {
+    if (__atomic_load_n(&once->Ptr, __ATOMIC_ACQUIRE)) return TRUE;
+    pthread_mutex_lock(&g_initOnceMutex);
+    BOOL ok = TRUE;
+    if (!once->Ptr) {
+        ok = fn(once, parameter, context);
+        if (ok) __atomic_store_n(&once->Ptr, (void*)1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&g_initOnceMutex);
+    return ok;
+}
+
+void InitializeCriticalSection(CRITICAL_SECTION* cs) {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cs->mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+}
+
+void DeleteCriticalSection(CRITICAL_SECTION* cs) { pthread_mutex_destroy(&cs->mutex); }
+void EnterCriticalSection(CRITICAL_SECTION* cs) { pthread_mutex_lock(&cs->mutex); }
+void LeaveCriticalSection(CRITICAL_SECTION* cs) { pthread_mutex_unlock(&cs->mutex); }
+
+LONG InterlockedIncrement(volatile LONG* value) {
+    return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+}
+
+LONG InterlockedDecrement(volatile LONG* value) {
+    return __atomic_sub_fetch(value, 1, __ATOMIC_SEQ_CST);
+}
+
+LONG InterlockedExchange(volatile LONG* target, LONG value) {
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+LONG InterlockedCompareExchange(volatile LONG* target, LONG exchange, LONG comparand) {
+    __atomic_compare_exchange_n(target, &comparand, exchange, FALSE,
+                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return comparand;
+}
+
+LONG InterlockedExchangeAdd(volatile LONG* target, LONG value) {
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+}
+
+PVOID InterlockedExchangePointer(PVOID volatile* target, PVOID value) {
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+PVOID InterlockedCompareExchangePointer(PVOID volatile* target, PVOID exchange, PVOID comparand) {
+    __atomic_compare_exchange_n(target, &comparand, exchange, FALSE,
+                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return comparand;
+}
+
+DWORD GetCurrentThreadId(void) {
+    if (t_threadId == 0) t_threadId = (DWORD)InterlockedIncrement(&g_nextThreadId);
+    return t_threadId;
+}
+
+void GetSystemInfo(SYSTEM_INFO* info) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    info->dwNumberOfProcessors = online > SHIM_MIN_PROCESSORS ? (DWORD)online : SHIM_MIN_PROCESSORS;
+}
+
+static ShimHandle* NewHandle(ShimHandleKind kind) {
+    ShimHandle* handle = (ShimHandle*)calloc(1, sizeof(ShimHandle));
+    if (!handle) return NULL;
+    handle->kind = kind;
+    pthread_mutex_init(&handle->mutex, NULL);
+    pthread_cond_init(&handle->cond, NULL);
+    return handle;
+}
+
+static void FreeHandle(ShimHandle* handle) {
+    pthread_cond_destroy(&handle->cond);
+    pthread_mutex_destroy(&handle->mutex);
+    free(handle);
+}
+
+HANDLE CreateEventW(void* attributes, BOOL manualReset, BOOL initialState, LPCWSTR name) {
+    (void)attributes;
+    (void)name;
+    ShimHandle* event = NewHandle(SHIM_HANDLE_EVENT);
+    if (!event) return NULL;
+    event->manualReset = manualReset;
+    event->signaled = initialState;
+    return event;
+}
+
+BOOL SetEvent(HANDLE handle) {
+    ShimHandle* event = (ShimHandle*)handle;
+    if (!event || event->kind != SHIM_HANDLE_EVENT) return FALSE;
+    pthread_mutex_lock(&event->mutex);
+    event->signaled = TRUE;
+    pthread_cond_broadcast(&event->cond);
+    pthread_mutex_unlock(&event->mutex);
+    return TRUE;
+}
+
+static void* ShimThreadMain(void* parameter) {
+    ShimThreadStart launch = *(ShimThreadStart*)parameter;
+    free(parameter);
+    launch.start(launch.parameter);
+    return NULL;
+}
+
+HANDLE CreateThread(void* attributes, SIZE_T stackSize, LPTHREAD_START_ROUTINE start,
+                    LPVOID parameter, DWORD flags, LPDWORD threadId) {
+    (void)attributes;
+    (void)stackSize;
+    (void)flags;
+    ShimHandle* thread = NewHandle(SHIM_HANDLE_THREAD);
+    ShimThreadStart* launch = (ShimThreadStart*)malloc(sizeof(ShimThreadStart));
+    if (!thread || !launch) {
+        if (thread) FreeHandle(thread);
+        free(launch);
+        return NULL;
+    }
+    launch->start = start;
+    launch->parameter = parameter;
+    if (pthread_create(&thread->thread, NULL, ShimThreadMain, launch) != 0) {
+        FreeHandle(thread);
+        free(launch);
+        return NULL;
+    }
+    if (threadId) *threadId = 0;
+    return thread;
+}
+
+/* Timeouts are not modelled; every caller in the tree waits INFINITE */
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds) {
+    (void)milliseconds;
+    ShimHandle* object = (ShimHandle*)handle;
+    if (!object) return WAIT_FAILED;
+    if (object->kind == SHIM_HANDLE_THREAD) {
+        if (!object->joined && pthread_join(object->thread, NULL) != 0) return WAIT_FAILED;
+        object->joined = TRUE;
+        return WAIT_OBJECT_0;
+    }
+    pthread_mutex_lock(&object->mutex);
+    while (!object->signaled) pthread_cond_wait(&object->cond, &object->mutex);
+    if (!object->manualReset) object->signaled = FALSE;
+    pthread_mutex_unlock(&object->mutex);
+    return WAIT_OBJECT_0;
+}
+
+DWORD WaitForMultipleObjects(DWORD count, const HANDLE* handles, BOOL waitAll, DWORD milliseconds) {
+    if (!waitAll || !handles) return WAIT_FAILED;
+    for (DWORD i = 0; i < count; i++) {
+        if (WaitForSingleObject(handles[i], milliseconds) == WAIT_FAILED) return WAIT_FAILED;
+    }
+    return WAIT_OBJECT_0;
+}
+
+BOOL CloseHandle(HANDLE handle) {
+    ShimHandle* object = (ShimHandle*)handle;
+    if (!object) return FALSE;
+    if (object->kind == SHIM_HANDLE_THREAD && !object->joined) pthread_detach(object->thread);
+    FreeHandle(object);
+    return TRUE;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file windows.h
+ * @brief Minimal Win32 surface for building the render benchmark off Windows.
+ *
+ * Declares only what the pixel-buffer text, effect, gradient and Markdown
+ * modules reference; win32_shim.c and win32_shim_thread.c implement it on
+ * POSIX. Never on the include path of Windows builds.
+ */
+
+#ifndef CATIME_BENCH_WINDOWS_SHIM_H
+#define CATIME_BENCH_WINDOWS_SHIM_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <wchar.h>
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef uint32_t DWORD;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef unsigned int UINT;
+typedef int INT;
+typedef short SHORT;
+typedef unsigned short USHORT;
+typedef float FLOAT;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef long long INT64;
+typedef unsigned long long UINT64;
+typedef int32_t INT32;
+typedef uint32_t UINT32;
+typedef size_t SIZE_T;
+typedef intptr_t INT_PTR;
+typedef uintptr_t UINT_PTR;
+typedef intptr_t LONG_PTR;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef intptr_t LRESULT;
+typedef int32_t HRESULT;
+typedef DWORD COLORREF;
+typedef void* PVOID;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef void* HANDLE;
+typedef char* LPSTR;
+typedef const char* LPCSTR;
+typedef wchar_t* LPWSTR;
+typedef const wchar_t* LPCWSTR;
+typedef DWORD* LPDWORD;
+typedef BYTE* LPBYTE;
+
+#define DECLARE_SHIM_HANDLE(name) typedef struct name##__* name
+DECLARE_SHIM_HANDLE(HWND);
+DECLARE_SHIM_HANDLE(HDC);
+DECLARE_SHIM_HANDLE(HBITMAP);
+DECLARE_SHIM_HANDLE(HICON);
+DECLARE_SHIM_HANDLE(HMENU);
+DECLARE_SHIM_HANDLE(HFONT);
+DECLARE_SHIM_HANDLE(HBRUSH);
+DECLARE_SHIM_HANDLE(HPEN);
+DECLARE_SHIM_HANDLE(HRGN);
+DECLARE_SHIM_HANDLE(HMONITOR);
+DECLARE_SHIM_HANDLE(HINSTANCE);
+DECLARE_SHIM_HANDLE(HKEY);
+typedef HINSTANCE HMODULE;
+typedef HICON HCURSOR;
+typedef void* HGDIOBJ;
+
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define MAXDWORD 0xffffffffu
+#define INFINITE 0xffffffffu
+#define WINAPI
+#define CALLBACK
+#define APIENTRY
+#define CONST const
+#define _TRUNCATE ((size_t)-1)
+#define CP_UTF8 65001
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define S_OK ((HRESULT)0)
+#define SUCCEEDED(hr) ((HRESULT)(hr) >= 0)
+#define FAILED(hr) ((HRESULT)(hr) < 0)
+
+#define RGB(r, g, b) ((COLORREF)(((BYTE)(r) | ((WORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+#define GetRValue(rgb) ((BYTE)(rgb))
+#define GetGValue(rgb) ((BYTE)(((WORD)(rgb)) >> 8))
+#define GetBValue(rgb) ((BYTE)((rgb) >> 16))
+#define MAKELONG(a, b) ((LONG)(((WORD)(a)) | ((DWORD)((WORD)(b))) << 16))
+#define LOWORD(l) ((WORD)((DWORD_PTR_SHIM)(l) & 0xffff))
+#define HIWORD(l) ((WORD)(((DWORD_PTR_SHIM)(l) >> 16) & 0xffff))
+typedef uintptr_t DWORD_PTR_SHIM;
+
+#define ZeroMemory(p, n) memset((p), 0, (n))
+#define CopyMemory(d, s, n) memcpy((d), (s), (n))
+#define FillMemory(d, n, v) memset((d), (v), (n))
+#define UNREFERENCED_PARAMETER(x) (void)(x)
+#define _countof(a) (sizeof(a) / sizeof((a)[0]))
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+typedef struct { LONG left, top, right, bottom; } RECT;
+typedef struct { LONG x, y; } POINT;
+typedef struct { LONG cx, cy; } SIZE;
+typedef struct { DWORD dwLowDateTime, dwHighDateTime; } FILETIME;
+typedef union {
+    struct { DWORD LowPart; LONG HighPart; };
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+typedef union {
+    struct { DWORD LowPart; DWORD HighPart; };
+    ULONGLONG QuadPart;
+} ULARGE_INTEGER;
+
+typedef struct { void* Ptr; } SRWLOCK;
+typedef struct { void* Ptr; } INIT_ONCE;
+typedef struct { void* Ptr; } CONDITION_VARIABLE;
+typedef struct { pthread_mutex_t mutex; } CRITICAL_SECTION;
+typedef INIT_ONCE* PINIT_ONCE;
+typedef SRWLOCK* PSRWLOCK;
+#define SRWLOCK_INIT {0}
+#define INIT_ONCE_STATIC_INIT {0}
+#define CONDITION_VARIABLE_INIT {0}
+typedef BOOL (CALLBACK* PINIT_ONCE_FN)(PINIT_ONCE, PVOID, PVOID*);
+
+typedef struct {
+    DWORD biSize; LONG biWidth; LONG biHeight; WORD biPlanes; WORD biBitCount;
+    DWORD biCompression; DWORD biSizeImage; LONG biXPelsPerMeter; LONG biYPelsPerMeter;
+    DWORD biClrUsed; DWORD biClrImportant;
+} BITMAPINFOHEADER;
+typedef struct { BYTE rgbBlue, rgbGreen, rgbRed, rgbReserved; } RGBQUAD;
+typedef struct { BITMAPINFOHEADER bmiHeader; RGBQUAD bmiColors[1]; } BITMAPINFO;
+#define BI_RGB 0
+#define DIB_RGB_COLORS 0
+
+#define SW_SHOWNORMAL 1
+
+typedef DWORD (WINAPI* LPTHREAD_START_ROUTINE)(LPVOID parameter);
+typedef struct { DWORD dwNumberOfProcessors; } SYSTEM_INFO;
+#define WAIT_OBJECT_0 0u
+#define WAIT_FAILED 0xffffffffu
+#define CreateEvent(attributes, manualReset, initialState, name) \
+    CreateEventW((attributes), (manualReset), (initialState), (name))
+
+/* Windowing: link handling code is linked but never reached */
+BOOL PtInRect(const RECT* rect, POINT point);
+HINSTANCE ShellExecuteW(HWND hwnd, LPCWSTR operation, LPCWSTR file, LPCWSTR parameters,
+                        LPCWSTR directory, INT showCommand);
+
+/* Synchronization and threads, backed by pthreads (win32_shim_thread.c);
+ * slim reader/writer locks stay no-ops because only the bench thread
+ * takes them. */
+BOOL InitOnceExecuteOnce(PINIT_ONCE once, PINIT_ONCE_FN fn, PVOID parameter, PVOID* context);
+void InitializeSRWLock(PSRWLOCK lock);
+void AcquireSRWLockExclusive(PSRWLOCK lock);
+void ReleaseSRWLockExclusive(PSRWLOCK lock);
+void AcquireSRWLockShared(PSRWLOCK lock);
+void ReleaseSRWLockShared(PSRWLOCK lock);
+void InitializeCriticalSection(CRITICAL_SECTION* cs);
+void DeleteCriticalSection(CRITICAL_SECTION* cs);
+void EnterCriticalSection(CRITICAL_SECTION* cs);
+void LeaveCriticalSection(CRITICAL_SECTION* cs);
+LONG InterlockedIncrement(volatile LONG* value);
+LONG InterlockedDecrement(volatile LONG* value);
+LONG InterlockedExchange(volatile LONG* target, LONG value);
+LONG InterlockedCompareExchange(volatile LONG* target, LONG exchange, LONG comparand);
+LONG InterlockedExchangeAdd(volatile LONG* target, LONG value);
+PVOID InterlockedExchangePointer(PVOID volatile* target, PVOID value);
+PVOID InterlockedCompareExchangePointer(PVOID volatile* target, PVOID exchange, PVOID comparand);
+HANDLE CreateThread(void* attributes, SIZE_T stackSize, LPTHREAD_START_ROUTINE start,
+                    LPVOID parameter, DWORD flags, LPDWORD threadId);
+HANDLE CreateEventW(void* attributes, BOOL manualReset, BOOL initialState, LPCWSTR name);
+BOOL SetEvent(HANDLE event);
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds);
+DWORD WaitForMultipleObjects(DWORD count, const HANDLE* handles, BOOL waitAll, DWORD milliseconds);
+BOOL CloseHandle(HANDLE handle);
+void GetSystemInfo(SYSTEM_INFO* info);
+
+/* Time */
+DWORD GetTickCount(void);
+ULONGLONG GetTickCount64(void);
+BOOL QueryPerformanceCounter(LARGE_INTEGER* counter);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency);
+DWORD GetCurrentThreadId(void);
+DWORD GetLastError(void);
+void SetLastError(DWORD error);
+void OutputDebugStringA(const char* text);
+void OutputDebugStringW(const wchar_t* text);
+
+/* CRT secure variants */
+int _snprintf_s(char* buffer, size_t size, size_t count, const char* format, ...);
+int _snwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, ...);
+int _vsnprintf_s(char* buffer, size_t size, size_t count, const char* format, va_list args);
+int strcpy_s(char* dest, size_t size, const char* src);
+int strncpy_s(char* dest, size_t size, const char* src, size_t count);
+int wcscpy_s(wchar_t* dest, size_t size, const wchar_t* src);
+int wcsncpy_s(wchar_t* dest, size_t size, const wchar_t* src, size_t count);
+int wcscat_s(wchar_t* dest, size_t size, const wchar_t* src);
+wchar_t* wcstok_s(wchar_t* str, const wchar_t* delimiters, wchar_t** context);
+wchar_t* _wcsdup(const wchar_t* text);
+char* strtok_s(char* str, const char* delimiters, char** context);
+int _stricmp(const char* a, const char* b);
+int _strnicmp(const char* a, const char* b, size_t count);
+int _wcsicmp(const wchar_t* a, const wchar_t* b);
+int _wcsnicmp(const wchar_t* a, const wchar_t* b, size_t count);
+int MultiByteToWideChar(UINT codePage, DWORD flags, const char* src, int srcLen,
+                        wchar_t* dest, int destLen);
+int WideCharToMultiByte(UINT codePage, DWORD flags, const wchar_t* src, int srcLen,
+                        char* dest, int destLen, const char* defaultChar, BOOL* usedDefault);
+
+#endif /* CATIME_BENCH_WINDOWS_SHIM_H */
@@ -0,0 +1,101 @@
+#include "config/config_published.h"
+
+#include <stdio.h>
+
+#define READER_THREADS 3
+#define WRITER_PUBLISHES 2000
+
+static int g_failures = 0;
+static volatile LONG g_stopReaders = 0;
+static volatile LONG g_tornReads = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static void SetPair(ConfigSnapshot* config, const void* context) {
+    int value = *(const int*)context;
+    config->baseFontSize = value;
+    config->windowOpacity = value;
+    config->notificationSoundVolume = value;
+}
+
+static void TestVersionsAndEdits(void) {
+    Expect(PublishedConfig_GetVersion() == 0, "nothing should be published yet");
+
+    ConfigSnapshot base;
+    ZeroMemory(&base, sizeof(base));
+    strcpy_s(base.language, sizeof(base.language), "English");
+    int value = 7;
+    Expect(PublishedConfig_Publish(&base, SetPair, &value) == 1,
+           "the first publish should be version 1");
+
+    value = 9;
+    Expect(PublishedConfig_Publish(NULL, SetPair, &value) == 2,
+           "versions should increase by one");
+    const PublishedConfig* published = PublishedConfig_Acquire();
+    Expect(published->version == 2 && published->config.baseFontSize == 9 &&
+               strcmp(published->config.language, "English") == 0,
+           "a NULL base should start from the current snapshot");
+
+    value = 11;
+    PublishedConfig_Publish(NULL, SetPair, &value);
+    value = 13;
+    PublishedConfig_Publish(NULL, SetPair, &value);
+    Expect(published->version == 2 && published->config.baseFontSize == 9,
+           "a pinned snapshot must not be recycled by later publishes");
+    PublishedConfig_Release(published);
+
+    published = PublishedConfig_Acquire();
+    Expect(published->version == 4 && published->config.windowOpacity == 13,
+           "readers should see the newest snapshot");
+    PublishedConfig_Release(published);
+}
+
+static DWORD WINAPI ReaderThread(LPVOID param) {
+    (void)param;
+    while (InterlockedCompareExchange(&g_stopReaders, 0, 0) == 0) {
+        const PublishedConfig* published = PublishedConfig_Acquire();
+        int size = published->config.baseFontSize;
+        if (published->config.windowOpacity != size ||
+            published->config.notificationSoundVolume != size) {
+            InterlockedIncrement(&g_tornReads);
+        }
+        PublishedConfig_Release(published);
+    }
+    return 0;
+}
+
+static void TestConcurrentReaders(void) {
+    HANDLE readers[READER_THREADS];
+    for (int i = 0; i < READER_THREADS; ++i) {
+        readers[i] = CreateThread(NULL, 0, ReaderThread, NULL, 0, NULL);
+        Expect(readers[i] != NULL, "reader thread should start");
+    }
+    LONG64 before = PublishedConfig_GetVersion();
+    for (int i = 0; i < WRITER_PUBLISHES; ++i) {
+        PublishedConfig_Publish(NULL, SetPair, &i);
+    }
+    InterlockedExchange(&g_stopReaders, 1);
+    for (int i = 0; i < READER_THREADS; ++i) {
+        if (!readers[i]) continue;
+        WaitForSingleObject(readers[i], INFINITE);
+        CloseHandle(readers[i]);
+    }
+    Expect(g_tornReads == 0, "readers must never see a half-written snapshot");
+    Expect(PublishedConfig_GetVersion() == before + WRITER_PUBLISHES,
+           "every publish should produce a version");
+}
+
+int main(void) {
+    TestVersionsAndEdits();
+    TestConcurrentReaders();
+
+    if (g_failures) {
+        fprintf(stderr, "%d config snapshot test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "drawing/drawing_dib_pool.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static DibPoolStats Stats(void) {
+    DibPoolStats stats;
+    DibPool_GetStats(&stats);
+    return stats;
+}
+
+static void TestReleasedSurfaceIsReused(void) {
+    DibSurface surface;
+    Expect(DibPool_Acquire(100, 50, 0, &surface), "a small surface should be created");
+    Expect(surface.dc && surface.bitmap && surface.bits, "a lease should carry a DC and bits");
+    Expect(surface.width >= 100 && surface.height >= 50, "a lease should cover the request");
+    void* bits = surface.bits;
+    DibPool_Release(&surface);
+    Expect(!surface.entry && !surface.dc, "release should clear the handle");
+
+    DibPoolStats before = Stats();
+    Expect(DibPool_Acquire(90, 40, 0, &surface), "a nearby size should be served");
+    DibPoolStats after = Stats();
+    Expect(after.reused == before.reused + 1, "a nearby size should reuse the idle surface");
+    Expect(surface.bits == bits, "the most recently released surface should come back");
+    Expect(after.leasedSurfaces == before.leasedSurfaces + 1, "the lease should be counted");
+    DibPool_Release(&surface);
+    DibPool_Trim(0);
+}
+
+static void TestExactWidthAndShrinkThreshold(void) {
+    DibSurface surface;
+    Expect(DibPool_Acquire(100, 50, DIB_POOL_EXACT_WIDTH, &surface),
+           "an exact width surface should be created");
+    Expect(surface.width == 100 && surface.height >= 50, "the width should not be rounded");
+    DibPool_Release(&surface);
+
+    Expect(DibPool_Acquire(96, 50, DIB_POOL_EXACT_WIDTH, &surface),
+           "a different exact width should be served");
+    Expect(surface.width == 96, "a wider idle surface must not satisfy an exact width");
+    DibPool_Release(&surface);
+
+    Expect(DibPool_Acquire(512, 512, 0, &surface), "a large surface should be created");
+    DibPool_Release(&surface);
+    DibPoolStats before = Stats();
+    Expect(DibPool_Acquire(16, 16, 0, &surface), "a tiny surface should be served");
+    Expect(Stats().created == before.created + 1,
+           "a far larger idle surface should not be handed out for a tiny request");
+    DibPool_Release(&surface);
+    DibPool_Trim(0);
+    Expect(Stats().idleSurfaces == 0, "trimming with zero age should empty the pool");
+}
+
+static void TestReleaseResetsDcState(void) {
+    DibSurface surface;
+    Expect(DibPool_Acquire(32, 32, DIB_POOL_EXACT, &surface), "a surface should be created");
+    int original = GetBkMode(surface.dc);
+    SetBkMode(surface.dc, original == TRANSPARENT ? OPAQUE : TRANSPARENT);
+    DibPool_Release(&surface);
+
+    Expect(DibPool_Acquire(32, 32, DIB_POOL_EXACT, &surface), "the surface should be reused");
+    Expect(GetBkMode(surface.dc) == original, "release should undo the lessee's DC changes");
+    DibPool_Release(&surface);
+    DibPool_Trim(0);
+}
+
+static void TestIdleSurfacesStayWithinLimits(void) {
+    DibSurface surfaces[DIB_POOL_MAX_IDLE_SURFACES + 8];
+    int count = (int)(sizeof(surfaces) / sizeof(surfaces[0]));
+    for (int i = 0; i < count; i++) {
+        Expect(DibPool_Acquire(64 + i * 32, 512, 0, &surfaces[i]), "a surface should be created");
+    }
+    for (int i = 0; i < count; i++) DibPool_Release(&surfaces[i]);
+
+    DibPoolStats stats = Stats();
+    Expect(stats.leasedSurfaces == 0 && stats.leasedBytes == 0, "every lease should be returned");
+    Expect(stats.idleSurfaces <= DIB_POOL_MAX_IDLE_SURFACES, "the idle count should be capped");
+    Expect(stats.idleBytes <= DIB_POOL_BUDGET_BYTES, "idle bytes should stay within the budget");
+    DibPool_Trim(0);
+}
+
+static void TestShutdownStopsPooling(void) {
+    DibSurface surface;
+    Expect(DibPool_Acquire(64, 64, 0, &surface), "a surface should be created");
+    DibPool_Shutdown();
+    DibPool_Release(&surface);
+    Expect(Stats().idleSurfaces == 0, "a release after shutdown should destroy the surface");
+}
+
+int main(void) {
+    TestReleasedSurfaceIsReused();
+    TestExactWidthAndShrinkThreshold();
+    TestReleaseResetsDcState();
+    TestIdleSurfacesStayWithinLimits();
+    TestShutdownStopsPooling();
+
+    if (g_failures) {
+        fprintf(stderr, "%d DIB pool test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include "log.h"
+#include "utils/directory_index.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    int added;
+    int changed;
+    int removed;
+    int visited;
+    BOOL cancel;
+} IndexObserver;
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+void WriteLog(LogLevel level, const char* format, ...) {
+    (void)level;
+    (void)format;
+}
+
+static BOOL AcceptFontLikeFile(const WIN32_FIND_DATAW* data, BYTE* metadata,
+                               void* context) {
+    (void)context;
+    const wchar_t* ext = wcsrchr(data->cFileName, L'.');
+    if (!ext || _wcsicmp(ext, L".ttf") != 0) return FALSE;
+    metadata[0] = (BYTE)wcslen(data->cFileName);
+    return TRUE;
+}
+
+static BOOL IsCanceled(void* context) {
+    return ((IndexObserver*)context)->cancel;
+}
+
+static void OnDelta(DirectoryIndexChange change,
+                    const DirectoryIndexEntry* entry, void* context) {
+    IndexObserver* observer = (IndexObserver*)context;
+    Expect(entry->metadata[0] == wcslen(DirectoryIndex_EntryFileName(entry)),
+           "metadata was not derived from the accepted file");
+    if (change == DIRECTORY_INDEX_ADDED) observer->added++;
+    else if (change == DIRECTORY_INDEX_CHANGED) observer->changed++;
+    else observer->removed++;
+}
+
+static BOOL OnEntry(const DirectoryIndexEntry* entry, void* context) {
+    (void)entry;
+    ((IndexObserver*)context)->visited++;
+    return TRUE;
+}
+
+static BOOL WriteTestFile(const wchar_t* root, const wchar_t* name,
+                          const char* content) {
+    wchar_t path[MAX_PATH];
+    if (_snwprintf_s(path, MAX_PATH, _TRUNCATE, L"%ls\\%ls", root, name) < 0) {
+        return FALSE;
+    }
+    HANDLE file = CreateFileW(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return FALSE;
+    DWORD written = 0;
+    BOOL ok = WriteFile(file, content, (DWORD)strlen(content), &written, NULL);
+    CloseHandle(file);
+    return ok;
+}
+
+static void DeleteTestPath(const wchar_t* root, const wchar_t* name,
+                           BOOL directory) {
+    wchar_t path[MAX_PATH];
+    if (_snwprintf_s(path, MAX_PATH, _TRUNCATE, L"%ls\\%ls", root, name) < 0) {
+        return;
+    }
+    if (directory) RemoveDirectoryW(path);
+    else DeleteFileW(path);
+}
+
+static int Refresh(DirectoryIndex* index, const wchar_t* root,
+                   IndexObserver* observer) {
+    IndexObserver reset = {0};
+    reset.cancel = observer->cancel;
+    *observer = reset;
+    DirectoryIndexCallbacks callbacks = { IsCanceled, OnDelta, OnEntry, observer };
+    return DirectoryIndex_Refresh(index, root, &callbacks);
+}
+
+#define WIDE_TREE_FOLDERS 40
+#define WIDE_TREE_FILES 25
+
+/* A wide tree exercises the hashed lookups and per-folder file lists */
+static void TestWideTreeStaysIncremental(const wchar_t* root) {
+    wchar_t folder[MAX_PATH];
+    wchar_t name[MAX_PATH];
+    BOOL written = TRUE;
+    for (int f = 0; f < WIDE_TREE_FOLDERS; f++) {
+        _snwprintf_s(folder, MAX_PATH, _TRUNCATE, L"%ls\\wide%02d", root, f);
+        written &= CreateDirectoryW(folder, NULL);
+        for (int i = 0; i < WIDE_TREE_FILES; i++) {
+            _snwprintf_s(name, MAX_PATH, _TRUNCATE, L"Font%02d.ttf", i);
+            written &= WriteTestFile(folder, name, "w");
+        }
+    }
+    Expect(written, "failed to write the wide tree");
+
+    DirectoryIndex index = {0};
+    IndexObserver observer = {0};
+    const int total = WIDE_TREE_FOLDERS * WIDE_TREE_FILES;
+    DirectoryIndex_Init(&index, 4, 5000, 10000, AcceptFontLikeFile, NULL);
+    Expect(Refresh(&index, root, &observer) == total && observer.added == total,
+           "wide tree should index every font once");
+    Expect(Refresh(&index, root, &observer) == total && observer.added == 0 &&
+           index.enumeratedFolders == 0 &&
+           index.reusedFolders == WIDE_TREE_FOLDERS + 1,
+           "unchanged wide tree should reuse every folder");
+
+    _snwprintf_s(folder, MAX_PATH, _TRUNCATE, L"%ls\\wide17", root);
+    Expect(WriteTestFile(folder, L"extra.TTF", "x"), "failed to write extra.TTF");
+    Expect(Refresh(&index, root, &observer) == total + 1 &&
+           observer.added == 1 && observer.removed == 0 &&
+           index.enumeratedFolders == 1,
+           "one new file should enumerate only its folder");
+    DeleteTestPath(folder, L"extra.TTF", FALSE);
+    DirectoryIndex_Free(&index);
+
+    for (int f = 0; f < WIDE_TREE_FOLDERS; f++) {
+        _snwprintf_s(folder, MAX_PATH, _TRUNCATE, L"%ls\\wide%02d", root, f);
+        for (int i = 0; i < WIDE_TREE_FILES; i++) {
+            _snwprintf_s(name, MAX_PATH, _TRUNCATE, L"Font%02d.ttf", i);
+            DeleteTestPath(folder, name, FALSE);
+        }
+        RemoveDirectoryW(folder);
+    }
+}
+
+int main(void) {
+    wchar_t tempDirectory[MAX_PATH] = {0};
+    wchar_t root[MAX_PATH] = {0};
+    wchar_t sub[MAX_PATH] = {0};
+    DWORD tempLength = GetTempPathW(MAX_PATH, tempDirectory);
+    if (tempLength == 0 || tempLength >= MAX_PATH ||
+        _snwprintf_s(root, MAX_PATH, _TRUNCATE, L"%lsCatimeDirectoryIndexTest-%lu",
+                     tempDirectory, GetCurrentProcessId()) < 0 ||
+        _snwprintf_s(sub, MAX_PATH, _TRUNCATE, L"%ls\\sub", root) < 0 ||
+        !CreateDirectoryW(root, NULL) || !CreateDirectoryW(sub, NULL)) {
+        fputs("failed to create test folders\n", stderr);
+        return 1;
+    }
+
+    Expect(WriteTestFile(root, L"a.ttf", "a"), "failed to write a.ttf");
+    Expect(WriteTestFile(root, L"notes.txt", "n"), "failed to write notes.txt");
+    Expect(WriteTestFile(sub, L"c.ttf", "c"), "failed to write sub\\c.ttf");
+
+    DirectoryIndex index = {0};
+    IndexObserver observer = {0};
+    DirectoryIndex_Init(&index, 4, 100, 1000, AcceptFontLikeFile, NULL);
+
+    Expect(Refresh(&index, root, &observer) == 2, "first refresh should index two fonts");
+    Expect(observer.added == 2 && observer.removed == 0,
+           "first refresh should report every file as added");
+    Expect(observer.visited == 2, "visit callback should see every entry");
+
+    Expect(Refresh(&index, root, &observer) == 2, "unchanged refresh should keep entries");
+    Expect(observer.added == 0 && observer.changed == 0 && observer.removed == 0,
+           "unchanged refresh should report no delta");
+    Expect(index.enumeratedFolders == 0 && index.reusedFolders == 2,
+           "unchanged folders should not be enumerated again");
+
+    DeleteTestPath(root, L"a.ttf", FALSE);
+    Expect(WriteTestFile(sub, L"d.ttf", "d"), "failed to write sub\\d.ttf");
+    Expect(Refresh(&index, root, &observer) == 2, "delta refresh should index two fonts");
+    Expect(observer.added == 1 && observer.removed == 1,
+           "delta refresh should report one add and one removal");
+
+    observer.cancel = TRUE;
+    DirectoryIndex_Invalidate(&index);
+    Expect(Refresh(&index, root, &observer) == DIRECTORY_INDEX_FAILED,
+           "canceled refresh should fail");
+    Expect(observer.added == 0 && observer.removed == 0,
+           "canceled refresh should not report deltas");
+    observer.cancel = FALSE;
+    Expect(Refresh(&index, root, &observer) == 2 && observer.added == 0,
+           "refresh after cancel should resume without duplicate adds");
+
+    DirectoryIndex_Free(&index);
+    DeleteTestPath(sub, L"c.ttf", FALSE);
+    DeleteTestPath(sub, L"d.ttf", FALSE);
+    DeleteTestPath(root, L"notes.txt", FALSE);
+    DeleteTestPath(root, L"sub", TRUE);
+
+    TestWideTreeStaysIncremental(root);
+    RemoveDirectoryW(root);
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d directory index test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
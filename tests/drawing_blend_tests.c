@@ -0,0 +1,195 @@
+#include "drawing/drawing_blend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROW_PIXELS 4096
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static DWORD Pixel(int a, int r, int g, int b) {
+    return ((DWORD)a << 24) | ((DWORD)r << 16) | ((DWORD)g << 8) | (DWORD)b;
+}
+
+/* The formulas below are the per-pixel blends the library replaced */
+
+static DWORD ReferencePremultiply(int r, int g, int b, int alpha) {
+    DWORD finalR = (r * alpha) / 255;
+    DWORD finalG = (g * alpha) / 255;
+    DWORD finalB = (b * alpha) / 255;
+    return ((DWORD)alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+}
+
+static DWORD ReferencePremultiplyRounded(DWORD pixel, int alpha) {
+    if (alpha == 0) return 0;
+    DWORD finalR = (((pixel >> 16) & 0xFF) * alpha + 127) / 255;
+    DWORD finalG = (((pixel >> 8) & 0xFF) * alpha + 127) / 255;
+    DWORD finalB = ((pixel & 0xFF) * alpha + 127) / 255;
+    return ((DWORD)alpha << 24) | (finalR << 16) | (finalG << 8) | finalB;
+}
+
+static DWORD ReferenceOver(DWORD pixel, int r, int g, int b, int alpha) {
+    int invAlpha = 255 - alpha;
+    int outA = alpha + (int)((pixel >> 24) & 0xFF) * invAlpha / 255;
+    int outR = (r * alpha + (int)((pixel >> 16) & 0xFF) * invAlpha) / 255;
+    int outG = (g * alpha + (int)((pixel >> 8) & 0xFF) * invAlpha) / 255;
+    int outB = (b * alpha + (int)(pixel & 0xFF) * invAlpha) / 255;
+    return ((DWORD)outA << 24) | ((DWORD)outR << 16) | ((DWORD)outG << 8) | (DWORD)outB;
+}
+
+static DWORD ReferenceAdd(DWORD pixel, int r, int g, int b, int alpha) {
+    int outR = (int)((pixel >> 16) & 0xFF) + (r * alpha) / 255;
+    int outG = (int)((pixel >> 8) & 0xFF) + (g * alpha) / 255;
+    int outB = (int)(pixel & 0xFF) + (b * alpha) / 255;
+    int bgA = (int)((pixel >> 24) & 0xFF);
+    if (outR > 255) outR = 255;
+    if (outG > 255) outG = 255;
+    if (outB > 255) outB = 255;
+    int outA = bgA > alpha ? bgA : alpha;
+    return ((DWORD)outA << 24) | ((DWORD)outR << 16) | ((DWORD)outG << 8) | (DWORD)outB;
+}
+
+static DWORD ReferenceLerp(DWORD pixel, int r, int g, int b, int alpha) {
+    int er = (pixel >> 16) & 0xFF;
+    int eg = (pixel >> 8) & 0xFF;
+    int eb = pixel & 0xFF;
+    int ea = (pixel >> 24) & 0xFF;
+    int nr = er + ((r - er) * alpha) / 255;
+    int ng = eg + ((g - eg) * alpha) / 255;
+    int nb = eb + ((b - eb) * alpha) / 255;
+    int na = ea + ((255 - ea) * alpha) / 255;
+    return ((DWORD)na << 24) | ((DWORD)nr << 16) | ((DWORD)ng << 8) | (DWORD)nb;
+}
+
+static void TestDiv255IsExact(void) {
+    int mismatches = 0;
+    for (DWORD v = 0; v <= 65534u; v++) {
+        if (DrawingBlend_Div255(v) != v / 255u) mismatches++;
+    }
+    Expect(mismatches == 0, "Div255 should match division over its whole range");
+}
+
+static void TestLanesRoundTrip(void) {
+    int mismatches = 0;
+    for (DWORD i = 0; i < 65536u; i++) {
+        DWORD pixel = (i * 2654435761u) ^ (i << 7);
+        if (DrawingBlend_Pack(DrawingBlend_Expand(pixel)) != pixel) mismatches++;
+    }
+    Expect(DrawingBlend_Expand(0xAABBCCDDu) == 0x00AA00BB00CC00DDull,
+           "Expand should put one channel in each 16-bit lane");
+    Expect(mismatches == 0, "Pack should undo Expand");
+}
+
+/*
+ * Exhaustive over alpha, color and destination channel. Every channel of
+ * the destination differs so a lane carrying into its neighbour shows up.
+ */
+static void TestPixelKernelsMatchReferences(void) {
+    int premultiply = 0, rounded = 0, mix = 0, over = 0, add = 0, lerp = 0;
+    for (int alpha = 0; alpha < 256; alpha++) {
+        BYTE a = (BYTE)alpha;
+        for (int c = 0; c < 256; c++) {
+            int r = c, g = 255 - c, b = (c * 7) & 0xFF;
+            ULONGLONG color = DrawingBlend_ColorLanes(r, g, b);
+            if (DrawingBlend_Premultiply(color, a) != ReferencePremultiply(r, g, b, alpha)) {
+                premultiply++;
+            }
+            for (int e = 0; e < 256; e++) {
+                DWORD pixel = Pixel(255 - e, e, (e * 13) & 0xFF, 255 - ((e * 5) & 0xFF));
+                if (DrawingBlend_PremultiplyRounded(pixel, a) !=
+                    ReferencePremultiplyRounded(pixel, alpha)) rounded++;
+                if (DrawingBlend_MixByte(c, e, a) !=
+                    (BYTE)((c * alpha + e * (255 - alpha)) / 255)) mix++;
+                if (DrawingBlend_Over(pixel, color, a) != ReferenceOver(pixel, r, g, b, alpha)) over++;
+                if (DrawingBlend_Add(pixel, r, g, b, a) != ReferenceAdd(pixel, r, g, b, alpha)) add++;
+                if (DrawingBlend_Lerp(pixel, r, g, b, a) != ReferenceLerp(pixel, r, g, b, alpha)) lerp++;
+            }
+        }
+    }
+    Expect(premultiply == 0, "premultiply should match the truncating division");
+    Expect(rounded == 0, "PremultiplyRounded should match the notification layer alpha");
+    Expect(mix == 0, "MixByte should match the notification blend");
+    Expect(over == 0, "Over should match the retro shadow blend");
+    Expect(add == 0, "Add should match the glow blend");
+    Expect(lerp == 0, "Lerp should match the italic Markdown blend");
+}
+
+static void TestRowKernelsMatchReferences(void) {
+    static DWORD source[ROW_PIXELS];
+    static DWORD actual[ROW_PIXELS];
+    static BYTE coverage[ROW_PIXELS];
+    static COLORREF colors[ROW_PIXELS];
+    srand(7);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD a = (DWORD)(rand() & 0xFF);
+        source[i] = (a << 24) | ((((DWORD)rand() << 8) ^ (DWORD)rand()) & 0xFFFFFFu);
+        coverage[i] = (BYTE)(i % 5 == 0 ? 0 : rand() & 0xFF);
+        colors[i] = RGB(rand() & 0xFF, rand() & 0xFF, rand() & 0xFF);
+    }
+    const int r = 250, g = 128, b = 3;
+    int maxRow = 0, colorsRow = 0, overRow = 0, addRow = 0, lerpRow = 0;
+
+    for (int i = 0; i < ROW_PIXELS; i++) actual[i] = source[i];
+    DrawingBlend_PremultiplyMaxRow(actual, coverage, ROW_PIXELS, r, g, b);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD expected = coverage[i] > (source[i] >> 24)
+            ? ReferencePremultiply(r, g, b, coverage[i]) : source[i];
+        if (actual[i] != expected) maxRow++;
+    }
+
+    for (int i = 0; i < ROW_PIXELS; i++) actual[i] = source[i];
+    DrawingBlend_PremultiplyMaxColorsRow(actual, coverage, colors, ROW_PIXELS);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD expected = coverage[i] > (source[i] >> 24)
+            ? ReferencePremultiply(GetRValue(colors[i]), GetGValue(colors[i]),
+                                   GetBValue(colors[i]), coverage[i])
+            : source[i];
+        if (actual[i] != expected) colorsRow++;
+    }
+
+    for (int i = 0; i < ROW_PIXELS; i++) actual[i] = source[i];
+    DrawingBlend_OverRow(actual, coverage, ROW_PIXELS, r, g, b);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD expected = coverage[i] ? ReferenceOver(source[i], r, g, b, coverage[i]) : source[i];
+        if (actual[i] != expected) overRow++;
+    }
+
+    for (int i = 0; i < ROW_PIXELS; i++) actual[i] = source[i];
+    DrawingBlend_AddRow(actual, coverage, ROW_PIXELS, r, g, b);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD expected = coverage[i] ? ReferenceAdd(source[i], r, g, b, coverage[i]) : source[i];
+        if (actual[i] != expected) addRow++;
+    }
+
+    for (int i = 0; i < ROW_PIXELS; i++) actual[i] = source[i];
+    DrawingBlend_LerpRow(actual, coverage, ROW_PIXELS, r, g, b);
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        DWORD expected = coverage[i] ? ReferenceLerp(source[i], r, g, b, coverage[i]) : source[i];
+        if (actual[i] != expected) lerpRow++;
+    }
+
+    Expect(maxRow == 0, "PremultiplyMaxRow should keep the more opaque pixel");
+    Expect(colorsRow == 0, "PremultiplyMaxColorsRow should use each pixel's color");
+    Expect(overRow == 0, "OverRow should match the per-pixel blend and skip zero coverage");
+    Expect(addRow == 0, "AddRow should match the per-pixel blend and skip zero coverage");
+    Expect(lerpRow == 0, "LerpRow should match the per-pixel blend and skip zero coverage");
+}
+
+int main(void) {
+    TestDiv255IsExact();
+    TestLanesRoundTrip();
+    TestPixelKernelsMatchReferences();
+    TestRowKernelsMatchReferences();
+
+    if (g_failures) {
+        fprintf(stderr, "%d blend test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
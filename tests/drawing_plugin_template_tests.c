@@ -0,0 +1,77 @@
+#include "drawing/drawing_plugin_template.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(const char* name, int value) {
+    if (!value) {
+        fprintf(stderr, "%s\n", name);
+        g_failures++;
+    }
+}
+
+/* Template for L"A<catime></catime>B![](x.png)C<catime></catime>D![](y.png)"
+ * after the placeholders and images are stripped: slots at 1 and 3, one
+ * image ahead of the second slot, images recorded at 2 and 4. */
+static const wchar_t kTemplate[] = L"ABCD";
+static const int kSlotOffsets[] = {1, 3};
+static const int kSlotImagesBefore[] = {0, 1};
+static const int kImagePositions[] = {2, 4};
+
+static int ImageAt(int index, size_t timerLen, size_t outLen) {
+    return PluginTemplate_ImagePosition(kImagePositions[index], index,
+                                        kSlotImagesBefore, 2, timerLen, outLen);
+}
+
+int main(void) {
+    wchar_t out[64];
+
+    /* Shorter than the 17-character placeholder */
+    size_t len = PluginTemplate_Splice(kTemplate, 4, kSlotOffsets, 2, L"9:38", out, 64);
+    Expect("short timer should be spliced at both slots",
+           len == 12 && wcscmp(out, L"A9:38BC9:38D") == 0);
+    Expect("image after the first slot should shift by one timer",
+           ImageAt(0, 4, len) == 6);
+    Expect("image after both slots should shift by two timers",
+           ImageAt(1, 4, len) == 12);
+
+    /* Longer than the placeholder */
+    const wchar_t* longTimer = L"01:02:03 of 05:00:00";
+    size_t longLen = wcslen(longTimer);
+    len = PluginTemplate_Splice(kTemplate, 4, kSlotOffsets, 2, longTimer, out, 64);
+    Expect("long timer should be spliced at both slots",
+           len == 4 + 2 * longLen && wcsncmp(out + 1, longTimer, longLen) == 0 &&
+           out[1 + longLen] == L'B' && out[len - 1] == L'D');
+    Expect("long timer should move the first image past it",
+           ImageAt(0, longLen, len) == (int)(2 + longLen) && out[ImageAt(0, longLen, len) - 1] == L'B');
+    Expect("long timer should move the second image to the end",
+           ImageAt(1, longLen, len) == (int)len);
+
+    /* Empty timer leaves the template as compiled */
+    len = PluginTemplate_Splice(kTemplate, 4, kSlotOffsets, 2, L"", out, 64);
+    Expect("empty timer should leave the template text",
+           len == 4 && wcscmp(out, kTemplate) == 0 && ImageAt(0, 0, len) == 2);
+
+    /* Truncated output clamps positions to the text that was written */
+    len = PluginTemplate_Splice(kTemplate, 4, kSlotOffsets, 2, L"12345", out, 9);
+    Expect("output should stop at the buffer size",
+           len == 8 && wcscmp(out, L"A12345BC") == 0);
+    Expect("image beyond truncated text should clamp to its end",
+           ImageAt(1, 5, len) == 8);
+
+    /* Slots before the first image, with no text between them */
+    static const int adjacentSlots[] = {0, 0};
+    static const int noImagesBefore[] = {0, 0};
+    len = PluginTemplate_Splice(L"X", 1, adjacentSlots, 2, L"ab", out, 64);
+    Expect("adjacent slots should both receive the timer",
+           len == 5 && wcscmp(out, L"ababX") == 0);
+    Expect("image after adjacent slots should shift by both",
+           PluginTemplate_ImagePosition(0, 0, noImagesBefore, 2, 2, len) == 4);
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d plugin template test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "drawing/drawing_text_stb_internal.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static void PutU16(unsigned char* p, unsigned int value) {
+    p[0] = (unsigned char)(value >> 8);
+    p[1] = (unsigned char)value;
+}
+
+static void PutU32(unsigned char* p, unsigned int value) {
+    PutU16(p, value >> 16);
+    PutU16(p + 2, value & 0xFFFF);
+}
+
+/* Every BMP code point must agree with the lookup the renderer uses */
+static int CountMismatches(const stbtt_fontinfo* info, const FontCoverage* coverage) {
+    int mismatches = 0;
+    for (unsigned int c = 0; c <= 0xFFFF; c++) {
+        BOOL expected = stbtt_FindGlyphIndex(info, (int)c) != 0;
+        if (FontCoverageContains(coverage, (wchar_t)c) != expected) mismatches++;
+    }
+    return mismatches;
+}
+
+static void TestFormat4Segments(void) {
+    /* Segments: 0x41-0x43 by delta, a full page 0x2500-0x25FF, 0x4E00-0x4E02
+     * through glyphIdArray with a hole, and the 0xFFFF terminator. The table
+     * sits past a gap because index_map 0 means "no cmap". */
+    unsigned char data[16 + 128] = {0};
+    unsigned char* table = data + 16;
+    unsigned int segCount = 4;
+    unsigned char* ends = table + 14;
+    unsigned char* starts = ends + segCount * 2 + 2;
+    unsigned char* deltas = starts + segCount * 2;
+    unsigned char* offsets = deltas + segCount * 2;
+    unsigned char* glyphIds = offsets + segCount * 2;
+
+    PutU16(table, 4);
+    PutU16(table + 6, segCount * 2);
+    PutU16(table + 8, 8);
+    PutU16(table + 10, 2);
+    PutU16(table + 12, 0);
+    PutU16(ends + 0, 0x43);   PutU16(starts + 0, 0x41);   PutU16(deltas + 0, 0x10000 - 0x40);
+    PutU16(ends + 2, 0x25FF); PutU16(starts + 2, 0x2500); PutU16(deltas + 2, 0x100);
+    PutU16(ends + 4, 0x4E02); PutU16(starts + 4, 0x4E00);
+    PutU16(offsets + 4, (unsigned int)(glyphIds - (offsets + 4)));
+    PutU16(glyphIds + 0, 7);
+    PutU16(glyphIds + 2, 0);
+    PutU16(glyphIds + 4, 9);
+    PutU16(ends + 6, 0xFFFF); PutU16(starts + 6, 0xFFFF); PutU16(deltas + 6, 1);
+
+    stbtt_fontinfo info;
+    ZeroMemory(&info, sizeof(info));
+    info.data = data;
+    info.index_map = 16;
+
+    FontCoverage coverage;
+    ZeroMemory(&coverage, sizeof(coverage));
+    Expect(BuildFontCoverage(&info, &coverage), "format 4 coverage should build");
+    Expect(CountMismatches(&info, &coverage) == 0,
+           "format 4 coverage should match stbtt_FindGlyphIndex");
+    Expect(FontCoverageContains(&coverage, 0x4E00) &&
+               !FontCoverageContains(&coverage, 0x4E01),
+           "a zero glyphIdArray entry should not count as covered");
+    Expect(coverage.pages[0x25] == FONT_COVERAGE_FULL_PAGE,
+           "a fully mapped page should not need a block");
+    Expect(coverage.pages[0x30] == FONT_COVERAGE_EMPTY_PAGE,
+           "an unmapped page should not need a block");
+    FreeFontCoverage(&coverage);
+}
+
+static void TestFormat12Groups(void) {
+    unsigned char data[16 + 16 + 3 * 12] = {0};
+    unsigned char* table = data + 16;
+    PutU16(table, 12);
+    PutU32(table + 12, 3);
+    /* Two identical partial pages share a block; the third group leaves the BMP */
+    PutU32(table + 16, 0x0300); PutU32(table + 20, 0x0310); PutU32(table + 24, 5);
+    PutU32(table + 28, 0x0700); PutU32(table + 32, 0x0710); PutU32(table + 36, 50);
+    PutU32(table + 40, 0xFFF0); PutU32(table + 44, 0x1F600); PutU32(table + 48, 100);
+
+    stbtt_fontinfo info;
+    ZeroMemory(&info, sizeof(info));
+    info.data = data;
+    info.index_map = 16;
+
+    FontCoverage coverage;
+    ZeroMemory(&coverage, sizeof(coverage));
+    Expect(BuildFontCoverage(&info, &coverage), "format 12 coverage should build");
+    Expect(CountMismatches(&info, &coverage) == 0,
+           "format 12 coverage should match stbtt_FindGlyphIndex");
+    Expect(coverage.blockCount == 2,
+           "identical partial pages should share one block");
+    FreeFontCoverage(&coverage);
+    Expect(FontCoverageContains(&coverage, 0x4E00),
+           "a freed index should answer yes so callers probe the font");
+}
+
+static void TestBundledFont(void) {
+    FILE* file = fopen(CATIME_TEST_FONT_PATH, "rb");
+    Expect(file != NULL, "bundled test font should open");
+    if (!file) return;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* buffer = (unsigned char*)malloc((size_t)size);
+    size_t read = buffer ? fread(buffer, 1, (size_t)size, file) : 0;
+    fclose(file);
+
+    stbtt_fontinfo info;
+    if (read == (size_t)size && stbtt_InitFont(&info, buffer, 0)) {
+        FontCoverage coverage;
+        ZeroMemory(&coverage, sizeof(coverage));
+        Expect(BuildFontCoverage(&info, &coverage), "bundled font coverage should build");
+        Expect(CountMismatches(&info, &coverage) == 0,
+               "bundled font coverage should match stbtt_FindGlyphIndex");
+        /* The bundled faces are trimmed to the clock glyphs */
+        Expect(FontCoverageContains(&coverage, L'0') && !FontCoverageContains(&coverage, L'A'),
+               "bundled font should cover digits but not letters");
+        FreeFontCoverage(&coverage);
+    } else {
+        Expect(0, "bundled test font should parse");
+    }
+    free(buffer);
+}
+
+int main(void) {
+    TestFormat4Segments();
+    TestFormat12Groups();
+    TestBundledFont();
+
+    if (g_failures) {
+        fprintf(stderr, "%d font coverage test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
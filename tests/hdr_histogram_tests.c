@@ -0,0 +1,79 @@
+#include "utils/hdr_histogram.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static void TestBucketsAreContiguousAndBounded(void) {
+    Expect(HdrHistogram_BucketIndex(0) == 0, "zero should use the first bucket");
+    Expect(HdrHistogram_BucketIndex(31) == 31, "small values should be exact");
+    Expect(HdrHistogram_BucketIndex(32) == 32, "first shifted bucket should follow exact range");
+    Expect(HdrHistogram_BucketIndex(MAXDWORD) == HDR_HISTOGRAM_BUCKETS - 1,
+           "largest value should use the last bucket");
+
+    int previous = -1;
+    for (DWORD value = 0; value < 100000; value++) {
+        int index = HdrHistogram_BucketIndex(value);
+        if (index != previous && index != previous + 1) {
+            Expect(FALSE, "bucket indexes should never skip");
+            break;
+        }
+        previous = index;
+        DWORD highest = HdrHistogram_BucketHighestValue(index);
+        if (highest < value || (double)(highest - value) > (double)value * 0.0625 + 0.5) {
+            Expect(FALSE, "bucket upper bound should stay within 6.25%");
+            break;
+        }
+    }
+}
+
+static void TestPercentiles(void) {
+    HdrHistogram histogram;
+    HdrHistogram_Reset(&histogram);
+    Expect(HdrHistogram_ValueAtPercentile(&histogram, 50.0) == 0,
+           "empty histogram should report zero");
+
+    for (DWORD value = 1; value <= 1000; value++) {
+        HdrHistogram_Record(&histogram, value);
+    }
+    DWORD p50 = HdrHistogram_ValueAtPercentile(&histogram, 50.0);
+    DWORD p99 = HdrHistogram_ValueAtPercentile(&histogram, 99.0);
+    Expect(histogram.totalCount == 1000 && histogram.min == 1 && histogram.max == 1000,
+           "count, min and max should be exact");
+    Expect(p50 >= 500 && p50 <= 532, "p50 should be within bucket precision");
+    Expect(p99 >= 990 && p99 <= 1000, "p99 should be clamped to the maximum");
+    Expect(HdrHistogram_ValueAtPercentile(&histogram, 100.0) == 1000,
+           "p100 should equal the maximum");
+    Expect(HdrHistogram_Mean(&histogram) == 500, "mean should be exact");
+}
+
+static void TestOutlierDoesNotMoveMedian(void) {
+    HdrHistogram histogram;
+    HdrHistogram_Reset(&histogram);
+    for (int i = 0; i < 99; i++) {
+        HdrHistogram_Record(&histogram, 200);
+    }
+    HdrHistogram_Record(&histogram, 5000000);
+    Expect(HdrHistogram_ValueAtPercentile(&histogram, 50.0) <= 207,
+           "median should stay in the common bucket");
+    Expect(HdrHistogram_ValueAtPercentile(&histogram, 100.0) == 5000000,
+           "maximum should keep the outlier");
+}
+
+int main(void) {
+    TestBucketsAreContiguousAndBounded();
+    TestPercentiles();
+    TestOutlierDoesNotMoveMedian();
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d HDR histogram test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
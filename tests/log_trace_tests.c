@@ -0,0 +1,147 @@
+#include "log/log_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static char* ReadWholeFile(const wchar_t* path) {
+    FILE* file = NULL;
+    if (_wfopen_s(&file, path, L"rb") != 0 || !file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = (char*)calloc((size_t)size + 1, 1);
+    if (text && fread(text, 1, (size_t)size, file) != (size_t)size) {
+        free(text);
+        text = NULL;
+    }
+    fclose(file);
+    return text;
+}
+
+static BOOL GetTracePath(wchar_t* path, DWORD pathSize) {
+    wchar_t directory[MAX_PATH];
+    DWORD length = GetTempPathW(MAX_PATH, directory);
+    return length > 0 && length < MAX_PATH &&
+           _snwprintf_s(path, pathSize, _TRUNCATE, L"%slog_trace_test_%lu.json",
+                        directory, GetCurrentProcessId()) > 0;
+}
+
+static DWORD WINAPI WorkerThread(LPVOID parameter) {
+    (void)parameter;
+    TraceSpan_NameThread("worker");
+    TRACE_SPAN_BEGIN(span, "Worker.Scan");
+    Sleep(1);
+    TRACE_SPAN_END(span);
+    return 0;
+}
+
+static void TestDisabledIsNoOp(void) {
+    Expect(!TraceSpan_IsEnabled(), "tracing should start disabled");
+    Expect(TraceSpan_Begin("Ignored") == -1, "disabled begin should not record");
+    TraceSpan_End(-1);
+}
+
+static void TestExportsSpansFromFinishedThreads(void) {
+    Expect(TraceSpan_Enable(), "tracing should enable");
+    TraceSpan_NameThread("main");
+    TRACE_SPAN_BEGIN(outer, "Outer \"quoted\"");
+    TRACE_SPAN_BEGIN(open, "StillOpen");
+    (void)open;
+
+    HANDLE worker = CreateThread(NULL, 0, WorkerThread, NULL, 0, NULL);
+    Expect(worker != NULL, "worker thread should start");
+    if (worker) {
+        WaitForSingleObject(worker, INFINITE);
+        CloseHandle(worker);
+    }
+    TraceSpan_Instant("FirstFrame");
+    TRACE_SPAN_END(outer);
+
+    wchar_t path[MAX_PATH];
+    Expect(GetTracePath(path, MAX_PATH), "temp path should resolve");
+    Expect(TraceSpan_WriteChromeTrace(path), "trace should be written");
+
+    char* json = ReadWholeFile(path);
+    Expect(json != NULL, "trace should be readable");
+    if (json) {
+        Expect(strncmp(json, "{\"traceEvents\":[", 16) == 0, "trace should open with traceEvents");
+        Expect(strstr(json, "\"Outer \\\"quoted\\\"\",\"ph\":\"X\"") != NULL,
+               "closed span should be exported with an escaped name");
+        Expect(strstr(json, "\"Worker.Scan\",\"ph\":\"X\"") != NULL,
+               "span from a finished thread should survive");
+        Expect(strstr(json, "\"FirstFrame\",\"ph\":\"i\"") != NULL,
+               "instant marker should be exported");
+        Expect(strstr(json, "StillOpen") == NULL, "open span should be skipped");
+        Expect(strstr(json, "{\"name\":\"worker\"}") != NULL,
+               "thread name metadata should be exported");
+        Expect(strstr(json, "\"droppedSpans\":0") != NULL, "no span should be dropped");
+        free(json);
+    }
+    DeleteFileW(path);
+}
+
+static void TestOverflowIsCounted(void) {
+    for (int i = 0; i <= TRACE_SPAN_MAX_EVENTS_PER_THREAD; i++) {
+        TraceSpan_End(TraceSpan_Begin("Fill"));
+    }
+    Expect(TraceSpan_Begin("Overflow") == -1, "full buffer should refuse spans");
+
+    wchar_t path[MAX_PATH];
+    Expect(GetTracePath(path, MAX_PATH), "temp path should resolve");
+    Expect(TraceSpan_WriteChromeTrace(path), "full trace should be written");
+    char* json = ReadWholeFile(path);
+    Expect(json && strstr(json, "\"droppedSpans\":0") == NULL,
+           "dropped spans should be reported");
+    free(json);
+    DeleteFileW(path);
+}
+
+static volatile LONG g_keepRecording = 1;
+
+static DWORD WINAPI BusyWorkerThread(LPVOID parameter) {
+    (void)parameter;
+    while (g_keepRecording) {
+        TRACE_SPAN_BEGIN(span, "Worker.Busy");
+        TRACE_SPAN_END(span);
+    }
+    return 0;
+}
+
+/* A scan worker can outlive the shutdown wait and keep recording */
+static void TestShutdownWhileRecording(void) {
+    HANDLE worker = CreateThread(NULL, 0, BusyWorkerThread, NULL, 0, NULL);
+    Expect(worker != NULL, "busy worker thread should start");
+    Sleep(5);
+    TraceSpan_Shutdown();
+    Expect(!TraceSpan_IsEnabled(), "shutdown should disable tracing");
+    Expect(TraceSpan_Begin("AfterShutdown") == -1, "shutdown should stop recording");
+    Expect(!TraceSpan_Enable(), "tracing should stay off after shutdown");
+    Sleep(5);
+    InterlockedExchange(&g_keepRecording, 0);
+    if (worker) {
+        WaitForSingleObject(worker, INFINITE);
+        CloseHandle(worker);
+    }
+}
+
+int main(void) {
+    TestDisabledIsNoOp();
+    TestExportsSpansFromFinishedThreads();
+    TestOverflowIsCounted();
+    TestShutdownWhileRecording();
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d log trace test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
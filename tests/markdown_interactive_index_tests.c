@@ -0,0 +1,122 @@
+#include "markdown/markdown_interactive_internal.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static ClickableRegion MakeRegion(int left, int top, int right, int bottom, int checkbox) {
+    ClickableRegion region;
+    ZeroMemory(&region, sizeof(region));
+    region.type = checkbox >= 0 ? CLICK_TYPE_CHECKBOX : CLICK_TYPE_LINK;
+    region.rect.left = left;
+    region.rect.top = top;
+    region.rect.right = right;
+    region.rect.bottom = bottom;
+    region.checkboxIndex = checkbox;
+    return region;
+}
+
+/* The first region in list order containing the point, as the old scan did */
+static int LinearHit(const ClickableRegion* regions, int count, POINT pt) {
+    for (int i = 0; i < count; i++) {
+        const RECT* r = &regions[i].rect;
+        if (pt.x >= r->left && pt.x < r->right && pt.y >= r->top && pt.y < r->bottom) return i;
+    }
+    return -1;
+}
+
+static int CountMismatches(const ClickableRegionIndex* index, const ClickableRegion* regions,
+                           int count, int minX, int minY, int maxX, int maxY) {
+    int mismatches = 0;
+    for (int y = minY; y < maxY; y++) {
+        for (int x = minX; x < maxX; x++) {
+            POINT pt = {x, y};
+            const ClickableRegion* hit = MarkdownInteractive_FindRegion(index, pt);
+            int got = hit ? (int)(hit - index->regions) : -1;
+            if (got != LinearHit(regions, count, pt)) mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static void TestOverlapsKeepListOrder(void) {
+    ClickableRegion regions[4];
+    regions[0] = MakeRegion(10, 10, 90, 30, 0);
+    regions[1] = MakeRegion(0, 0, 200, 100, -1);
+    regions[2] = MakeRegion(-40, 50, -10, 70, 1);
+    regions[3] = MakeRegion(60, 60, 60, 80, 2);
+    ClickableRegionIndex* index = MarkdownInteractive_BuildIndex(regions, 4);
+    Expect(index != NULL, "index should build");
+    if (!index) return;
+    Expect(CountMismatches(index, regions, 4, -60, -20, 220, 120) == 0,
+           "grid hits should match the linear scan, including overlaps");
+    POINT inside = {20, 20};
+    const ClickableRegion* hit = MarkdownInteractive_FindRegion(index, inside);
+    Expect(hit && hit->checkboxIndex == 0, "the earlier region should win an overlap");
+    MarkdownInteractive_FreeIndex(index);
+}
+
+static void TestDenseChecklistGrowsCells(void) {
+    ClickableRegion regions[MAX_CLICKABLE_REGIONS];
+    for (int i = 0; i < MAX_CLICKABLE_REGIONS; i++) {
+        int y = i * 300;
+        regions[i] = MakeRegion(i % 7 * 11, y, i % 7 * 11 + 18, y + 18, i);
+    }
+    ClickableRegionIndex* index = MarkdownInteractive_BuildIndex(regions, MAX_CLICKABLE_REGIONS);
+    Expect(index != NULL, "tall index should build");
+    if (!index) return;
+    Expect(index->cols * index->rows <= CLICKABLE_INDEX_MAX_CELLS,
+           "a tall layout should widen cells instead of exceeding the cell budget");
+    Expect(CountMismatches(index, regions, MAX_CLICKABLE_REGIONS, -5, -5, 100, 300 * 4) == 0,
+           "tall layout hits should match the linear scan");
+    POINT last = {63 % 7 * 11 + 1, 63 * 300 + 1};
+    const ClickableRegion* hit = MarkdownInteractive_FindRegion(index, last);
+    Expect(hit && hit->checkboxIndex == 63, "the last region should be reachable");
+    MarkdownInteractive_FreeIndex(index);
+}
+
+static void TestMatchesDetectsChanges(void) {
+    wchar_t urlA[] = L"https://example.com/a";
+    wchar_t urlB[] = L"https://example.com/b";
+    ClickableRegion regions[2];
+    regions[0] = MakeRegion(0, 0, 50, 20, -1);
+    regions[0].url = urlA;
+    regions[1] = MakeRegion(0, 30, 20, 50, 0);
+    ClickableRegionIndex* index = MarkdownInteractive_BuildIndex(regions, 2);
+    Expect(index != NULL, "index should build");
+    if (!index) return;
+    Expect(index->regions[0].url != urlA, "the index should own its URL copies");
+    Expect(MarkdownInteractive_IndexMatches(index, regions, 2), "an identical layout should match");
+
+    regions[0].url = urlB;
+    Expect(!MarkdownInteractive_IndexMatches(index, regions, 2), "a new URL should not match");
+    regions[0].url = urlA;
+    regions[1].isChecked = TRUE;
+    Expect(!MarkdownInteractive_IndexMatches(index, regions, 2), "a toggled checkbox should not match");
+    regions[1].isChecked = FALSE;
+    regions[1].rect.right++;
+    Expect(!MarkdownInteractive_IndexMatches(index, regions, 2), "moved geometry should not match");
+    Expect(!MarkdownInteractive_IndexMatches(index, regions, 1), "a shorter list should not match");
+    MarkdownInteractive_FreeIndex(index);
+
+    Expect(MarkdownInteractive_BuildIndex(regions, 0) == NULL, "no regions should publish no index");
+    Expect(MarkdownInteractive_IndexMatches(NULL, regions, 0), "no index should match an empty list");
+}
+
+int main(void) {
+    TestOverlapsKeepListOrder();
+    TestDenseChecklistGrowsCells();
+    TestMatchesDetectsChanges();
+
+    if (g_failures) {
+        fprintf(stderr, "%d markdown interactive index test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "utils/metric_history.h"
+#include "drawing/drawing_sparkline.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static BOOL Near(float actual, float expected) {
+    float delta = actual - expected;
+    return delta > -0.001f && delta < 0.001f;
+}
+
+static void TestDownsamplesOnInsert(MetricHistory* history) {
+    MetricHistory_Reset(history);
+    const ULONGLONG base = 10ULL * 60ULL * 60ULL * 1000ULL;
+    MetricHistory_Insert(history, base + 100, 10.0f);
+    MetricHistory_Insert(history, base + 400, 30.0f);
+    MetricHistory_Insert(history, base + 1200, 50.0f);
+
+    MetricHistoryPoint points[2];
+    Expect(MetricHistory_Query(history, base, base + 2000, points, 2) == 2,
+           "two seconds of samples should fill two columns");
+    Expect(points[0].count == 2 && Near(points[0].min, 10.0f) &&
+               Near(points[0].max, 30.0f) && Near(points[0].average, 20.0f),
+           "first second should fold into min/max/avg");
+    Expect(points[1].count == 1 && Near(points[1].average, 50.0f),
+           "second second should hold its single sample");
+
+    MetricHistoryPoint merged;
+    Expect(MetricHistory_Query(history, base, base + 2000, &merged, 1) == 1,
+           "one column should merge the whole range");
+    Expect(merged.count == 3 && Near(merged.min, 10.0f) &&
+               Near(merged.max, 50.0f) && Near(merged.average, 30.0f),
+           "merged column should weight averages by sample count");
+
+    MetricHistoryPoint wide[8];
+    Expect(MetricHistory_Query(history, base, base + 1000, wide, 8) == 8,
+           "a bucket wider than a column should feed every column it covers");
+
+    MetricHistory_Insert(history, base + 1500, INFINITY);
+    MetricHistory_Query(history, base + 1000, base + 2000, &merged, 1);
+    Expect(merged.count == 1, "non-finite samples should be dropped");
+}
+
+static void TestTiersAndRetention(MetricHistory* history) {
+    MetricHistory_Reset(history);
+    const ULONGLONG base = 1000ULL;
+    for (int second = 0; second < 2 * 60 * 60; ++second) {
+        MetricHistory_Insert(history, base + (ULONGLONG)second * 1000ULL,
+                             (float)(second % 100));
+    }
+    ULONGLONG now = history->latestTick;
+
+    Expect(MetricHistory_SelectTier(history, now - 60000ULL) == 0,
+           "the last minute should come from 1 s buckets");
+    Expect(MetricHistory_SelectTier(history, now - 30ULL * 60000ULL) == 1,
+           "the last half hour should come from 10 s buckets");
+    Expect(MetricHistory_SelectTier(history, base) == 2,
+           "two hours back should come from 1 min buckets");
+    Expect(MetricHistory_TierResolutionMs(1) == 10000u,
+           "middle tier should use 10 s buckets");
+
+    MetricHistoryPoint points[10];
+    Expect(MetricHistory_Query(history, now - 10000ULL + 1, now + 1, points, 10) == 10,
+           "the last ten seconds should be fully populated");
+    Expect(MetricHistory_Query(history, base, now + 1, points, 10) == 10,
+           "the coarse tier should cover the whole two hours");
+
+    DWORD total = 0;
+    for (int i = 0; i < 10; ++i) total += points[i].count;
+    Expect(total == 2u * 60u * 60u, "coarse columns should count every sample once");
+
+    MetricHistory_Insert(history, base, 99.0f);
+    MetricHistory_Query(history, now, now + 1, points, 1);
+    Expect(points[0].count == 1, "a stale sample must not disturb recent buckets");
+}
+
+static void TestGapsExpireOldLaps(MetricHistory* history) {
+    MetricHistory_Reset(history);
+    MetricHistory_Insert(history, 5000ULL, 42.0f);
+    /* 301 s later the 1 s ring has wrapped onto the same slot once */
+    MetricHistory_Insert(history, 5000ULL + 300000ULL, 7.0f);
+
+    MetricHistoryPoint point;
+    Expect(MetricHistory_Query(history, 5000ULL, 6000ULL, &point, 1) == 1 &&
+               point.count == 1 && Near(point.average, 42.0f),
+           "a lapped second should still be served from a coarser tier");
+
+    MetricHistoryPoint recent[5];
+    int filled = MetricHistory_Query(history, 5000ULL + 296000ULL,
+                                     5000ULL + 301000ULL, recent, 5);
+    Expect(filled == 1 && recent[4].count == 1 && Near(recent[4].average, 7.0f),
+           "gaps should read as empty columns, not as the previous lap");
+}
+
+static void TestSparklines(void) {
+    MetricHistoryPoint points[4] = {0};
+    points[0].count = 1;
+    points[0].min = points[0].max = points[0].average = 0.0f;
+    points[2].count = 1;
+    points[2].min = 25.0f;
+    points[2].max = 100.0f;
+    points[2].average = 50.0f;
+    points[3].count = 1;
+    points[3].min = points[3].max = points[3].average = 100.0f;
+
+    wchar_t text[8];
+    Expect(Sparkline_FormatText(points, 4, 100.0f, text, _countof(text)) == 4,
+           "one character should be written per column");
+    Expect(text[0] == 0x2581 && text[1] == L' ' && text[2] == 0x2585 &&
+               text[3] == 0x2588,
+           "block characters should follow the averages");
+    Expect(Sparkline_FormatText(points, 4, 100.0f, text, 3) == 2 && text[2] == L'\0',
+           "text sparklines should truncate to the buffer");
+
+    BYTE coverage[4 * 8];
+    Sparkline_RasterizeCoverage(coverage, 4, 8, points, 4, 0.0f);
+    Expect(coverage[7 * 4 + 0] == 0, "a zero column should stay empty");
+    Expect(coverage[7 * 4 + 1] == 0, "a missing column should stay empty");
+    Expect(coverage[4 * 4 + 2] == 255 && coverage[7 * 4 + 2] == SPARKLINE_FILL_COVERAGE,
+           "the average should be a full line over a lighter fill");
+    Expect(coverage[0 * 4 + 2] == SPARKLINE_BAND_COVERAGE,
+           "the band should reach the column maximum");
+    Expect(coverage[0 * 4 + 3] == 255, "auto scale should use the largest sample");
+}
+
+int main(void) {
+    MetricHistory* history = (MetricHistory*)malloc(sizeof(MetricHistory));
+    if (!history) return 1;
+    TestDownsamplesOnInsert(history);
+    TestTiersAndRetention(history);
+    TestGapsExpireOldLaps(history);
+    TestSparklines();
+    free(history);
+
+    if (g_failures) {
+        fprintf(stderr, "%d metric history test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "utils/pcm_mix.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static void TestConstantGains(void) {
+    int16_t source[4] = {1000, -1000, 32767, -32768};
+    int32_t accum[4] = {0};
+
+    PcmMix_Accumulate(accum, source, 2, 2, PCM_MIX_UNITY_GAIN, PCM_MIX_UNITY_GAIN);
+    Expect(accum[0] == 1000 && accum[1] == -1000 && accum[2] == 32767 &&
+               accum[3] == -32768,
+           "unity gain should add samples unchanged");
+
+    PcmMix_Accumulate(accum, source, 2, 2, 0, 0);
+    Expect(accum[0] == 1000, "zero gain should leave the accumulator alone");
+
+    PcmMix_Accumulate(accum, source, 2, 2, PCM_MIX_UNITY_GAIN / 2,
+                      PCM_MIX_UNITY_GAIN / 2);
+    Expect(accum[0] == 1500 && accum[1] == -1500,
+           "half gain should add half of each sample");
+}
+
+static void TestRampAndSaturation(void) {
+    int16_t source[8] = {16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384};
+    int32_t accum[8] = {0};
+    PcmMix_Accumulate(accum, source, 4, 2, 0, PCM_MIX_UNITY_GAIN);
+    Expect(accum[0] == 0 && accum[1] == 0, "a ramp should start at its first gain");
+    Expect(accum[2] == accum[3] && accum[2] < accum[4] && accum[4] < accum[6],
+           "a ramp should rise per frame and match across channels");
+    Expect(accum[6] < 16384, "a ramp should stop short of its target gain");
+
+    int32_t loud[3] = {40000, -40000, 1234};
+    int16_t output[3];
+    PcmMix_Resolve(output, loud, 3);
+    Expect(output[0] == 32767 && output[1] == -32768 && output[2] == 1234,
+           "resolving should saturate instead of wrapping");
+}
+
+static void TestGainSteps(void) {
+    Expect(PcmMix_StepGain(0, PCM_MIX_UNITY_GAIN, 100) == 100,
+           "a rising gain should move by the step");
+    Expect(PcmMix_StepGain(50, 0, 100) == 0, "a step should not overshoot");
+    Expect(PcmMix_StepGain(7, 7, 100) == 7, "a settled gain should not move");
+    Expect(PcmMix_FadeDelta(48, 480) == PCM_MIX_UNITY_GAIN / 10,
+           "a tenth of the fade should cover a tenth of full scale");
+    Expect(PcmMix_FadeDelta(1, 1000000) == 1, "a fade should always progress");
+    Expect(PcmMix_FadeDelta(512, 256) == PCM_MIX_UNITY_GAIN,
+           "a buffer longer than the fade should finish it");
+}
+
+int main(void) {
+    TestConstantGains();
+    TestRampAndSaturation();
+    TestGainSteps();
+
+    if (g_failures) {
+        fprintf(stderr, "%d pcm mix test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "plugin/plugin_channel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LATENCY_SAMPLES 2000
+#define ACK_WAIT_MS 1000
+
+typedef struct {
+    PluginChannelBuffer* buffer;
+    HANDLE readyEvent;
+    HANDLE ackEvent;
+    LONGLONG latencies[LATENCY_SAMPLES];
+    int received;
+    BOOL sequencesIncreased;
+} ConsumerState;
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static LONGLONG Now(void) {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+static void TestRingProtocol(void) {
+    PluginChannelBuffer* buffer = (PluginChannelBuffer*)malloc(sizeof(*buffer));
+    Expect(buffer != NULL, "failed to allocate channel buffer");
+    if (!buffer) return;
+    PluginChannel_InitBuffer(buffer);
+    Expect(PluginChannel_IsCompatible(buffer), "initialized buffer should be compatible");
+
+    char data[PLUGIN_CHANNEL_SLOT_BYTES];
+    DWORD length = 0;
+    ULONG sequence = 0;
+    Expect(PluginChannel_ReadLatest(buffer, 0, data, &length, &sequence) ==
+               PLUGIN_CHANNEL_READ_NONE,
+           "empty channel should have nothing to read");
+
+    Expect(PluginChannel_Write(buffer, "first", 5) == 1, "first record should be 1");
+    Expect(PluginChannel_ReadLatest(buffer, 0, data, &length, &sequence) ==
+               PLUGIN_CHANNEL_READ_OK && sequence == 1 && length == 5 &&
+               memcmp(data, "first", 5) == 0,
+           "first record should round-trip");
+    Expect(PluginChannel_ReadLatest(buffer, 1, data, &length, &sequence) ==
+               PLUGIN_CHANNEL_READ_NONE,
+           "an already-read record should not be returned again");
+
+    char text[16];
+    for (int i = 0; i < 20; i++) {
+        int written = snprintf(text, sizeof(text), "r%d", i);
+        PluginChannel_Write(buffer, text, (DWORD)written);
+    }
+    Expect(PluginChannel_ReadLatest(buffer, 1, data, &length, &sequence) ==
+               PLUGIN_CHANNEL_READ_OK && sequence == 21 && length == 3 &&
+               memcmp(data, "r19", 3) == 0,
+           "reader should skip straight to the newest record after a wrap");
+
+    Expect(PluginChannel_Write(buffer, data, PLUGIN_CHANNEL_SLOT_BYTES + 1) == 0,
+           "oversized records should be rejected");
+    Expect(PluginChannel_Write(buffer, NULL, 0) == 22, "empty records are allowed");
+
+    /* A producer stalled mid-write leaves the newest slot odd. */
+    PluginChannelSlot* slot = &buffer->slots[23 % PLUGIN_CHANNEL_SLOT_COUNT];
+    slot->sequence = 23 * 2 - 1;
+    buffer->publishedSequence = 23;
+    Expect(PluginChannel_ReadLatest(buffer, 22, data, &length, &sequence) ==
+               PLUGIN_CHANNEL_READ_BUSY,
+           "a slot still being written should not be returned");
+
+    free(buffer);
+}
+
+static DWORD WINAPI ConsumerThread(LPVOID param) {
+    ConsumerState* state = (ConsumerState*)param;
+    char data[PLUGIN_CHANNEL_SLOT_BYTES + 1];
+    ULONG lastSequence = 0;
+    state->sequencesIncreased = TRUE;
+
+    while (state->received < LATENCY_SAMPLES) {
+        if (WaitForSingleObject(state->readyEvent, ACK_WAIT_MS) != WAIT_OBJECT_0) {
+            break;
+        }
+        DWORD length = 0;
+        ULONG sequence = 0;
+        if (PluginChannel_ReadLatest(state->buffer, lastSequence, data, &length,
+                                     &sequence) != PLUGIN_CHANNEL_READ_OK) {
+            continue;
+        }
+        LONGLONG receivedAt = Now();
+        if (sequence <= lastSequence) state->sequencesIncreased = FALSE;
+        lastSequence = sequence;
+
+        data[length] = '\0';
+        long long sentAt = 0;
+        if (sscanf(data, "<catime>%lld</catime>", &sentAt) == 1) {
+            state->latencies[state->received++] = receivedAt - (LONGLONG)sentAt;
+        }
+        SetEvent(state->ackEvent);
+    }
+    return 0;
+}
+
+static int CompareLatency(const void* a, const void* b) {
+    LONGLONG left = *(const LONGLONG*)a;
+    LONGLONG right = *(const LONGLONG*)b;
+    return (left > right) - (left < right);
+}
+
+static void TestProducerLatency(void) {
+    wchar_t name[PLUGIN_CHANNEL_NAME_CHARS];
+    wchar_t eventName[PLUGIN_CHANNEL_NAME_CHARS];
+    _snwprintf_s(name, PLUGIN_CHANNEL_NAME_CHARS, _TRUNCATE,
+                 L"Local\\CatimePluginChannelTest-%lu", GetCurrentProcessId());
+    _snwprintf_s(eventName, PLUGIN_CHANNEL_NAME_CHARS, _TRUNCATE,
+                 L"%ls%ls", name, PLUGIN_CHANNEL_EVENT_SUFFIX);
+
+    static ConsumerState state;
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                        0, (DWORD)sizeof(PluginChannelBuffer), name);
+    state.buffer = mapping ? (PluginChannelBuffer*)MapViewOfFile(
+        mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, sizeof(PluginChannelBuffer)) : NULL;
+    state.readyEvent = CreateEventW(NULL, FALSE, FALSE, eventName);
+    state.ackEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+    Expect(state.buffer && state.readyEvent && state.ackEvent,
+           "failed to create host channel objects");
+    if (!state.buffer || !state.readyEvent || !state.ackEvent) return;
+    PluginChannel_InitBuffer(state.buffer);
+
+    PluginChannelProducer producer;
+    Expect(PluginChannelProducer_Open(&producer, name), "producer failed to open channel");
+    HANDLE consumer = CreateThread(NULL, 0, ConsumerThread, &state, 0, NULL);
+    Expect(consumer != NULL, "failed to start consumer thread");
+
+    char text[64];
+    for (int i = 0; consumer && i < LATENCY_SAMPLES; i++) {
+        int written = snprintf(text, sizeof(text), "<catime>%lld</catime>",
+                               (long long)Now());
+        if (!PluginChannelProducer_Publish(&producer, text, (DWORD)written) ||
+            WaitForSingleObject(state.ackEvent, ACK_WAIT_MS) != WAIT_OBJECT_0) {
+            break;
+        }
+    }
+
+    if (consumer) {
+        WaitForSingleObject(consumer, INFINITE);
+        CloseHandle(consumer);
+    }
+    Expect(state.received == LATENCY_SAMPLES, "consumer missed acknowledged records");
+    Expect(state.sequencesIncreased, "consumer saw a sequence go backwards");
+    Expect(state.buffer->producerPid == (LONG)GetCurrentProcessId(),
+           "producer should stamp its process id");
+
+    if (state.received > 0) {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        qsort(state.latencies, (size_t)state.received, sizeof(LONGLONG), CompareLatency);
+        double toMicros = 1000000.0 / (double)frequency.QuadPart;
+        printf("plugin channel latency over %d records: p50 %.1f us, p99 %.1f us\n",
+               state.received,
+               (double)state.latencies[state.received / 2] * toMicros,
+               (double)state.latencies[state.received * 99 / 100] * toMicros);
+    }
+
+    PluginChannelProducer_Close(&producer);
+    UnmapViewOfFile(state.buffer);
+    CloseHandle(state.readyEvent);
+    CloseHandle(state.ackEvent);
+    CloseHandle(mapping);
+}
+
+int main(void) {
+    TestRingProtocol();
+    TestProducerLatency();
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d plugin channel test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "plugin/plugin_log_frame.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int g_failures = 0;
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static PluginLogFrameResult Decode(const char* text, size_t length,
+                                   PluginLogFrame* frame, size_t* consumed) {
+    ZeroMemory(frame, sizeof(*frame));
+    return PluginLogFrame_Next(text, length, frame, consumed);
+}
+
+static void TestCompleteFrames(void) {
+    const char stream[] = "#5\nhello\n#0\n\n#5\r\nab\ncd\r\n";
+    size_t length = sizeof(stream) - 1;
+    PluginLogFrame frame;
+    size_t consumed = 0;
+
+    Expect(Decode(stream, length, &frame, &consumed) == PLUGIN_LOG_FRAME_OK &&
+               frame.length == 5 && memcmp(frame.payload, "hello", 5) == 0 &&
+               consumed == 9,
+           "first frame should decode");
+    size_t offset = consumed;
+    Expect(Decode(stream + offset, length - offset, &frame, &consumed) ==
+               PLUGIN_LOG_FRAME_OK && frame.length == 0 && consumed == 4,
+           "empty frame should decode");
+    offset += consumed;
+    Expect(Decode(stream + offset, length - offset, &frame, &consumed) ==
+               PLUGIN_LOG_FRAME_OK && frame.length == 5 &&
+               memcmp(frame.payload, "ab\ncd", 5) == 0 &&
+               offset + consumed == length,
+           "CRLF frame with an embedded newline should decode");
+}
+
+static void TestPartialFrames(void) {
+    const char frame5[] = "#5\nhello\n";
+    PluginLogFrame frame;
+    size_t consumed = 1;
+
+    for (size_t cut = 0; cut < sizeof(frame5) - 1; cut++) {
+        Expect(Decode(frame5, cut, &frame, &consumed) == PLUGIN_LOG_FRAME_INCOMPLETE &&
+                   consumed == 0,
+               "every prefix of a frame should wait for more data");
+    }
+    Expect(Decode("#5\r", 3, &frame, &consumed) == PLUGIN_LOG_FRAME_INCOMPLETE,
+           "a split CRLF header should wait for more data");
+}
+
+static void TestMalformedFrames(void) {
+    PluginLogFrame frame;
+    size_t consumed = 0;
+
+    Expect(Decode("garbage\n#1\nx\n", 13, &frame, &consumed) ==
+               PLUGIN_LOG_FRAME_MALFORMED && consumed == 8,
+           "a non-frame line should be skipped up to the next line");
+    Expect(Decode("#3\nhello\n", 9, &frame, &consumed) ==
+               PLUGIN_LOG_FRAME_MALFORMED && consumed == 3,
+           "a wrong length should drop only the header");
+    Expect(Decode("#99999\n", 7, &frame, &consumed) == PLUGIN_LOG_FRAME_MALFORMED,
+           "lengths beyond the frame limit should be rejected");
+    Expect(Decode("#1234567\n", 9, &frame, &consumed) == PLUGIN_LOG_FRAME_MALFORMED,
+           "overlong length fields should be rejected");
+    Expect(Decode("#\n\n", 3, &frame, &consumed) == PLUGIN_LOG_FRAME_MALFORMED,
+           "a header without digits should be rejected");
+}
+
+int main(void) {
+    TestCompleteFrames();
+    TestPartialFrames();
+    TestMalformedFrames();
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d plugin log frame test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "drawing/drawing_render_present_damage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FRAME_WIDTH 100
+#define FRAME_HEIGHT 70
+
+static int g_failures = 0;
+
+static void Expect(int condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static BOOL SameRect(const RECT* rect, LONG left, LONG top, LONG right, LONG bottom) {
+    return rect->left == left && rect->top == top &&
+           rect->right == right && rect->bottom == bottom;
+}
+
+static void FillFrame(DWORD* pixels, DWORD color) {
+    for (int i = 0; i < FRAME_WIDTH * FRAME_HEIGHT; i++) pixels[i] = color;
+}
+
+static void TestFirstFrameIsFull(void) {
+    static DWORD pixels[FRAME_WIDTH * FRAME_HEIGHT];
+    PresentDamageTracker tracker = {0};
+    RECT dirty;
+    FillFrame(pixels, 0x01020304);
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty),
+           "the first frame should be presented");
+    Expect(SameRect(&dirty, 0, 0, FRAME_WIDTH, FRAME_HEIGHT),
+           "the first frame should cover the whole surface");
+    PresentDamage_Commit(&tracker);
+
+    Expect(!PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty),
+           "an identical frame should be skipped");
+    Expect(IsRectEmpty(&dirty), "a skipped frame should report no damage");
+    PresentDamage_Release(&tracker);
+}
+
+static void TestChangedTilesBoundDirtyRect(void) {
+    static DWORD pixels[FRAME_WIDTH * FRAME_HEIGHT];
+    PresentDamageTracker tracker = {0};
+    RECT dirty;
+    FillFrame(pixels, 0);
+    PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty);
+    PresentDamage_Commit(&tracker);
+
+    pixels[40 * FRAME_WIDTH + 33] = 0xFF112233;
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty),
+           "a changed pixel should be presented");
+    Expect(SameRect(&dirty, 32, 32, 64, 64), "one pixel should dirty only its tile");
+    PresentDamage_Commit(&tracker);
+
+    pixels[40 * FRAME_WIDTH + 33] = 0;
+    pixels[69 * FRAME_WIDTH + 99] = 0x80000000;
+    pixels[5 * FRAME_WIDTH + 1] = 0x80000000;
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty),
+           "edge tiles should be presented");
+    Expect(SameRect(&dirty, 0, 0, FRAME_WIDTH, FRAME_HEIGHT),
+           "the dirty rect should bound every changed tile and clip to the frame");
+    PresentDamage_Commit(&tracker);
+    PresentDamage_Release(&tracker);
+}
+
+static void TestResizeAndInvalidateForceFull(void) {
+    static DWORD pixels[FRAME_WIDTH * FRAME_HEIGHT];
+    PresentDamageTracker tracker = {0};
+    RECT dirty;
+    FillFrame(pixels, 0x05000000);
+    PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT, &dirty);
+    PresentDamage_Commit(&tracker);
+
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT - 1, &dirty),
+           "a resized frame should be presented");
+    Expect(SameRect(&dirty, 0, 0, FRAME_WIDTH, FRAME_HEIGHT - 1),
+           "a resized frame should cover the whole surface");
+    PresentDamage_Commit(&tracker);
+
+    PresentDamage_Invalidate(&tracker);
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT - 1, &dirty),
+           "an invalidated surface should be presented");
+    Expect(SameRect(&dirty, 0, 0, FRAME_WIDTH, FRAME_HEIGHT - 1),
+           "an invalidated surface should be uploaded in full");
+
+    /* A failed present leaves the previous frame on screen */
+    pixels[0] = 0;
+    Expect(PresentDamage_Compute(&tracker, pixels, FRAME_WIDTH, FRAME_HEIGHT - 1, &dirty),
+           "an uncommitted surface should still be presented in full");
+    Expect(SameRect(&dirty, 0, 0, FRAME_WIDTH, FRAME_HEIGHT - 1),
+           "nothing was committed, so the upload should stay full");
+    PresentDamage_Release(&tracker);
+}
+
+int main(void) {
+    TestFirstFrameIsFull();
+    TestChangedTilesBoundDirtyRect();
+    TestResizeAndInvalidateForceFull();
+
+    if (g_failures) {
+        fprintf(stderr, "%d render present damage test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -20,6 +20,16 @@ void WriteLog(LogLevel level, const char* format, ...) {
     (void)format;
 }
 
+int SystemMonitor_QueryHistory(SystemMonitorMetric metric,
+                               ULONGLONG fromTick, ULONGLONG toTick,
+                               MetricHistoryPoint* points, int pointCount) {
+    (void)metric;
+    (void)fromTick;
+    (void)toTick;
+    ZeroMemory(points, (size_t)pointCount * sizeof(*points));
+    return 0;
+}
+
 int TaskbarMonitor_ScaleForDpi(int value, UINT dpi) {
     if (dpi == 0) dpi = 96;
     return MulDiv(value, (int)dpi, 96);
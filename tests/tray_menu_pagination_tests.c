@@ -14,7 +14,7 @@ static void AppendCommand(HMENU menu, UINT id, BOOL checked) {
 static MENUITEMINFOW GetItemInfo(HMENU menu, int position) {
     MENUITEMINFOW item = {0};
     item.cbSize = sizeof(item);
-    item.fMask = MIIM_FTYPE | MIIM_ID | MIIM_STATE | MIIM_SUBMENU;
+    item.fMask = MIIM_DATA | MIIM_FTYPE | MIIM_ID | MIIM_STATE | MIIM_SUBMENU;
     assert(GetMenuItemInfoW(menu, (UINT)position, TRUE, &item));
     return item;
 }
@@ -29,6 +29,7 @@ static HMENU AssertCheckedMore(HMENU menu, int position) {
     MENUITEMINFOW item = GetItemInfo(menu, position);
     assert(item.hSubMenu != NULL);
     assert(item.fState & MFS_CHECKED);
+    assert(TrayMenuPagination_IsContinuationItem(&item));
 
     wchar_t label[16] = {0};
     MENUITEMINFOW textItem = {0};
@@ -192,6 +193,8 @@ static void TestExistingChildMenuIsPaginated(void) {
     assert(TrayMenuPagination_ApplyRange(
         menu, &range, 5, L"More"));
     assert(GetMenuItemCount(menu) == 1);
+    MENUITEMINFOW folderItem = GetItemInfo(menu, 0);
+    assert(!TrayMenuPagination_IsContinuationItem(&folderItem));
     assert(GetMenuItemCount(folder) == 5);
     HMENU secondPage = AssertCheckedMore(folder, 4);
     assert(GetMenuItemCount(secondPage) == 5);
@@ -0,0 +1,105 @@
+#include "tray/tray_animation_percent_internal.h"
+
+#include <stdio.h>
+
+static int g_failures = 0;
+
+COLORREF GetSystemMetricTextColor(void) {
+    return RGB(255, 255, 255);
+}
+
+static void Expect(BOOL condition, const char* message) {
+    if (condition) return;
+    fprintf(stderr, "%s\n", message);
+    ++g_failures;
+}
+
+static BOOL GetCoverageColumns(const BYTE* coverage, int cx, int cy,
+                               int* left, int* right) {
+    *left = cx;
+    *right = -1;
+    for (int y = 0; y < cy; ++y) {
+        for (int x = 0; x < cx; ++x) {
+            if (coverage[y * cx + x] == 0) continue;
+            if (x < *left) *left = x;
+            if (x > *right) *right = x;
+        }
+    }
+    return *right >= 0;
+}
+
+static void CheckComposedDigits(void) {
+    PercentIconAtlas atlas;
+    Expect(BuildPercentIconAtlas(16, 16, &atlas), "failed to build the percent atlas");
+    if (!atlas.valid) return;
+
+    BYTE coverage[16 * 16];
+    int previousWidth = 0;
+    const int values[] = {7, 42, 100};
+    for (int i = 0; i < (int)_countof(values); ++i) {
+        Expect(ComposePercentCoverageLocked(&atlas, values[i], 16, 16, coverage),
+               "failed to compose a percent from the atlas");
+        int left = 0;
+        int right = 0;
+        if (!GetCoverageColumns(coverage, 16, 16, &left, &right)) {
+            Expect(FALSE, "composed percent had no coverage");
+            continue;
+        }
+        int width = right - left + 1;
+        Expect(width > previousWidth, "more digits should cover more columns");
+        int slack = left - (15 - right);
+        Expect(slack >= -2 && slack <= 2, "composed digits were not centered");
+        previousWidth = width;
+    }
+
+    Expect(!ComposePercentCoverageLocked(&atlas, 42, 20, 20, coverage),
+           "an atlas must not compose for a different icon size");
+    FreePercentIconAtlas(&atlas);
+    Expect(!atlas.valid && atlas.coverage == NULL, "freed atlas kept its coverage");
+}
+
+static int CountCachedIcons(int percent) {
+    int count = 0;
+    for (int i = 0; i < (int)_countof(g_percentIconCache); ++i) {
+        if (!g_percentIconCache[i].valid) continue;
+        if (percent < 0 || g_percentIconCache[i].percent == percent) ++count;
+    }
+    return count;
+}
+
+static void CheckRecentIconCache(void) {
+    SetPercentIconColors(RGB(255, 255, 255), RGB(20, 40, 60));
+    for (int percent = 0; percent <= 20; ++percent) {
+        HICON icon = CreatePercentIcon16(percent);
+        Expect(icon != NULL, "failed to create a percent icon");
+        if (icon) DestroyIcon(icon);
+        if (percent == 2) {
+            HICON again = CreatePercentIcon16(0);
+            if (again) DestroyIcon(again);
+        }
+    }
+    Expect(CountCachedIcons(-1) == GENERATED_PERCENT_ICON_CACHE_SIZE,
+           "the percent icon cache should stay at its capacity");
+    Expect(CountCachedIcons(20) == 1, "the newest percent icon was not cached");
+    Expect(CountCachedIcons(0) == 0, "the least recently used icon was not evicted");
+
+    HICON cached = CreatePercentIcon16(20);
+    Expect(cached != NULL, "failed to reuse a cached percent icon");
+    if (cached) DestroyIcon(cached);
+    Expect(g_percentIconAtlas.valid, "the percent atlas was not retained");
+
+    SetPercentIconColors(RGB(0, 0, 0), RGB(255, 255, 255));
+    Expect(CountCachedIcons(-1) == 0, "changing colors kept stale percent icons");
+    CleanupPercentIconCache();
+}
+
+int main(void) {
+    CheckComposedDigits();
+    CheckRecentIconCache();
+
+    if (g_failures) {
+        fprintf(stderr, "%d tray percent atlas test(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}